@@ -144,6 +144,8 @@ CMOOSApp::CMOOSApp()
     m_bQuiet = false;
     m_bUseMOOSComms = true;
     m_dfLastRunTime = -1;
+    m_bVirtualTime = false;
+    m_dfLastVirtualRunTime = -1;
     m_bCommandMessageFiltering = false;
     m_dfLastStatusTime = -1;
     m_bSortMailByTime = true;
@@ -372,6 +374,23 @@ bool CMOOSApp::Run( const std::string & sName,
         //give iostream time to write comms start details up to screen..this is not really necessary
         //as the code is thread safe...it is aesthetic only
         MOOSPause(500);
+
+        //in virtual time nothing makes sense until we have heard the
+        //DB clock (which is sent to us as soon as we register for it)
+        if(m_bVirtualTime)
+        {
+            t = 0;
+            while(!WaitForMOOSVirtualTime(0.0, dT))
+            {
+                t+=dT;
+                if(t>5000)
+                {
+                    std::cerr<<"WARNING: no MOOS_VIRTUAL_TIME from the DB. Is it running with MOOSVirtualTime=true?\n";
+                    break;
+                }
+            }
+            m_dfAppStartTime = MOOSTime();
+        }
     }
 
 
@@ -519,6 +538,16 @@ bool CMOOSApp::Configure()
 		SetMOOSTimeWarp(dfTimeWarp);
 	}
 
+    //is time driven by a virtual clock published by the DB? If so
+    //warp is meaningless - we run as fast as everyone can keep up
+    bool bVirtualTime = false;
+    if(GetFlagFromCommandLineOrConfigurationFile("moos_virtual_time") ||
+            (m_MissionReader.GetValue("MOOSVirtualTime", bVirtualTime) && bVirtualTime))
+    {
+        m_bVirtualTime = true;
+        SetMOOSVirtualTime(true);
+    }
+
     double dfTimeWarpCommsFactor = 0.0;
     if(GetParameterFromCommandLineOrConfigurationFile("moos_tw_delay_factor",dfTimeWarpCommsFactor))
     {
@@ -672,7 +701,9 @@ void CMOOSApp::DoBanner()
 		MOOSTrace(" |\t Baseline CommsTick @ %d Hz\n",m_nCommsFreq);
 	}
 
-	if(GetMOOSTimeWarp()!=1.0)
+	if(m_bVirtualTime)
+		MOOSTrace("\t|-Virtual Time (clock driven by MOOSDB)\n");
+	else if(GetMOOSTimeWarp()!=1.0)
 		MOOSTrace("\t|-Time Warp @ %.1f \n",GetMOOSTimeWarp());
 	if(m_Comms.GetCommsControlTimeWarpScaleFactor()>0.0  && GetMOOSTimeWarp()>1.0)
 	    MOOSTrace("\t|-Time Warp delay @ %.1f ms \n",m_Comms.GetCommsControlTimeWarpScaleFactor()*GetMOOSTimeWarp());
@@ -802,6 +833,13 @@ void CMOOSApp::SleepAsRequired(bool &  bIterateShouldRun)
 
 	bIterateShouldRun = true;
 
+	//in virtual time the DB clock, not the wall clock, paces us
+	if(m_bVirtualTime && m_bUseMOOSComms)
+	{
+		SleepUntilVirtualTime();
+		return;
+	}
+
 	//do we need to sleep at all?
 	if(m_dfFreq<=0.0)
 	{
@@ -891,6 +929,33 @@ void CMOOSApp::SleepAsRequired(bool &  bIterateShouldRun)
 }
 
 
+void CMOOSApp::SleepUntilVirtualTime()
+{
+	//when asked to go flat out we still have to give the clock a
+	//period to step by
+	double dfPeriod = m_dfFreq>0.0 ? 1.0/m_dfFreq : MIN_VIRTUAL_PERIOD;
+
+	double dfNow = MOOSTime();
+	double dfWake = dfNow;
+	if(m_dfLastVirtualRunTime>=0.0 && m_dfLastVirtualRunTime+dfPeriod>dfNow)
+		dfWake = m_dfLastVirtualRunTime+dfPeriod;
+
+	//tell the DB when we next need to run. It will not move the clock
+	//past this time until we ask again
+	if(m_Comms.IsConnected())
+		m_Comms.Notify("MOOS_VIRTUAL_WAKE",dfWake);
+
+	while(!WaitForMOOSVirtualTime(dfWake,100))
+	{
+		//don't hang on a DB which has gone away or if we are asked to quit
+		if(m_bQuitRequested || !m_Comms.IsConnected())
+			break;
+	}
+
+	m_dfLastVirtualRunTime = dfWake;
+}
+
+
 bool CMOOSApp::AddMessageRouteToActiveQueue(const std::string & sQueueName,
                     const std::string & sMsgName)
 {
@@ -1520,6 +1585,11 @@ void CMOOSApp::OnDisconnectToServerPrivate()
 //called just before calling a derived classes OnConnectToServer()
 void CMOOSApp::OnConnectToServerPrivate()
 {
+    if(m_bVirtualTime)
+    {
+        m_Comms.Register("MOOS_VIRTUAL_TIME",0);
+    }
+
     if(m_bCommandMessageFiltering)
     {
         m_Comms.Register(GetCommandKey(),0);
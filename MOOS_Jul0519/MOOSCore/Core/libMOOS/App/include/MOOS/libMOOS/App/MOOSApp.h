@@ -52,6 +52,7 @@
 #define MOOS_MAX_COMMS_FREQ 200
 
 #define STATUS_PERIOD 2
+#define MIN_VIRTUAL_PERIOD 0.01
 
 typedef std::map<std::string,CMOOSVariable> MOOSVARMAP;
 
@@ -616,6 +617,12 @@ protected:
     /** Time at which the Run loop last ran (called Iterate)**/
     double m_dfLastRunTime;
 
+    /** true if time is driven by a MOOSDB virtual clock (MOOSVirtualTime=true)*/
+    bool m_bVirtualTime;
+
+    /** virtual time at which Iterate was last scheduled to run */
+    double m_dfLastVirtualRunTime;
+
     
     /**should mail be handed to the user sorted by increasing time*/
     bool m_bSortMailByTime;
@@ -723,6 +730,10 @@ private:
 
     /** controls the rate at which application runs */
     void SleepAsRequired(bool & bIterateShouldRun);
+
+    /** in virtual time tell the DB when we next want to run and block
+    until the DB clock gets there */
+    void SleepUntilVirtualTime();
 	
 	/** ::Run continues forever or until this variable is false*/
 	bool m_bQuitRequested;
@@ -408,6 +408,8 @@ bool MOOSAsyncCommClient::DoReading()
 
 		double dfLocalRxTime =MOOSLocalTime();
 
+		double dfVirtualTime = -1.0;
+
 		m_InLock.Lock();
 		{
 			if(m_InBox.size()>m_nInPendingLimit)
@@ -487,6 +489,9 @@ bool MOOSAsyncCommClient::DoReading()
                 }
             }
 
+			//look for a virtual clock tick before active queues take mail
+			dfVirtualTime = FindVirtualTime(m_InBox);
+
 			DispatchInBoxToActiveThreads();
 
 			m_bMailPresent = !m_InBox.empty();
@@ -495,6 +500,11 @@ bool MOOSAsyncCommClient::DoReading()
 		}
 		m_InLock.UnLock();
 
+		//only now is all mail in this packet visible to the application
+		//so only now may anyone waiting on the clock be woken
+		if(dfVirtualTime>=0.0)
+			AdvanceMOOSVirtualTime(dfVirtualTime);
+
 		//and here we can optionally give users an indication
 		//that mail has arrived...
 		if(m_pfnMailCallBack!=NULL && m_bMailPresent)
@@ -707,6 +707,8 @@ bool CMOOSCommClient::DoClientWork()
 
 		//quick! grab this time
 		double dfLocalPktRxTime = MOOSLocalTime();
+
+		double dfVirtualTime = -1.0;
         
         if(m_bVerboseDebug)
         {
@@ -746,6 +748,9 @@ bool CMOOSCommClient::DoClientWork()
             }
 
 
+			//look for a virtual clock tick before active queues take mail
+			dfVirtualTime = FindVirtualTime(m_InBox);
+
 			//here we dispatch to special call backs managed by threads
 			DispatchInBoxToActiveThreads();
             
@@ -754,6 +759,11 @@ bool CMOOSCommClient::DoClientWork()
 		}
 		m_InLock.UnLock();
 
+		//only now is all mail in this packet visible to the application
+		//so only now may anyone waiting on the clock be woken
+		if(dfVirtualTime>=0.0)
+			AdvanceMOOSVirtualTime(dfVirtualTime);
+
         if(m_pfnMailCallBack!=NULL && m_bMailPresent)
         {
             bool bUserResult = (*m_pfnMailCallBack)(m_pMailCallBackParam);
@@ -1689,6 +1699,24 @@ bool CMOOSCommClient::Flush()
 }
 
 
+double CMOOSCommClient::FindVirtualTime(const MOOSMSG_LIST & Mail)
+{
+	double dfTime = -1.0;
+	if(!IsMOOSVirtualTime())
+		return dfTime;
+
+	MOOSMSG_LIST::const_iterator q;
+	for(q=Mail.begin();q!=Mail.end();++q)
+	{
+		if(q->IsType(MOOS_NOTIFY) && q->IsDouble() &&
+				q->GetKey()=="MOOS_VIRTUAL_TIME" && q->GetDouble()>dfTime)
+		{
+			dfTime = q->GetDouble();
+		}
+	}
+	return dfTime;
+}
+
 //std::auto_ptr<std::ofstream> SkewLog(NULL);
 
 bool CMOOSCommClient::UpdateMOOSSkew(double dfRqTime, double dfTxTime, double dfRxTime)
@@ -297,7 +297,9 @@ bool ThreadedCommServer::ProcessClient(ClientThreadSharedData &SDFromClient,MOOS
             {
             	if(q->IsType(MOOS_NOTIFY))
             	{
-            		if(dfTNow-q->GetTime()>dfLargeDelay)
+            		//under virtual time messages are stamped with the
+            		//virtual clock which has nothing to do with the wall clock
+            		if(!IsMOOSVirtualTime() && dfTNow-q->GetTime()>dfLargeDelay)
             		{
             			std::cout<<"WARNING : Message "<<q->GetKey()<<" from "<<q->GetSource()<<" is "<<(dfTNow-q->GetTime())*1000<<" ms delayed\n";
             		}
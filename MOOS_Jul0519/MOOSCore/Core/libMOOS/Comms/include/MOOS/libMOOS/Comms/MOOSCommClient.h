@@ -538,6 +538,11 @@ protected:
     bool  m_bMailPresent;
 
     bool UpdateMOOSSkew(double dfRQTime, double dfTXTime,double dfRXTime);
+
+    /** if the DB is running a virtual clock (MOOSVirtualTime=true) look
+    through newly arrived mail for MOOS_VIRTUAL_TIME and return the latest
+    time found, or -1 if there is none */
+    double FindVirtualTime(const MOOSMSG_LIST & Mail);
     
     /*thread to handle communications with a server object*/
     CMOOSThread m_ClientThread;
@@ -99,6 +99,7 @@ CMOOSDB::CMOOSDB()
     m_nPort = DEFAULT_MOOS_SERVER_PORT;
     
     m_bQuiet = false;
+    m_bVirtualTime = false;
 
     //make our own variable called DB_TIME
     {
@@ -298,6 +299,24 @@ bool CMOOSDB::Run(int argc,  char * argv[] )
     if(dfWarp>0.0)
         SetMOOSTimeWarp(dfWarp);
 
+    ///////////////////////////////////////////////////////////
+    //or are we to run a virtual clock which only moves forward when
+    //every participating client has asked it to?
+    m_MissionReader.GetValue("MOOSVirtualTime",m_bVirtualTime);
+    if(P.GetFlag("--moos_virtual_time"))
+        m_bVirtualTime = true;
+    if(m_bVirtualTime)
+    {
+        //start the clock at the wall clock time so times look sensible
+        AdvanceMOOSVirtualTime(MOOSLocalTime(false));
+        SetMOOSVirtualTime(true);
+
+        CMOOSMsg DBVT(MOOS_NOTIFY,"MOOS_VIRTUAL_TIME",MOOSTime());
+        DBVT.m_sOriginatingCommunity = m_sCommunityName;
+        DBVT.m_sSrc = m_sDBName;
+        OnNotify(DBVT);
+    }
+
 
     ///////////////////////////////////////////////////////////
     //is there a network - default  - true
@@ -581,6 +600,54 @@ void CMOOSDB::UpdateDBTimeVars()
 
 }
 
+void CMOOSDB::OnVirtualWake(CMOOSMsg & Msg)
+{
+    if(!Msg.IsDouble())
+        return;
+
+    //first request from a client makes it a participant
+    m_VirtualWakeMap[Msg.GetSource()] = Msg.GetDouble();
+
+    AdvanceVirtualTime();
+}
+
+void CMOOSDB::AdvanceVirtualTime()
+{
+    if(m_VirtualWakeMap.empty())
+        return;
+
+    //barrier: nobody may still be running
+    double dfNext = -1;
+    std::map<std::string,double>::iterator p;
+    for(p=m_VirtualWakeMap.begin();p!=m_VirtualWakeMap.end();++p)
+    {
+        if(p->second<0.0)
+            return;
+        if(dfNext<0.0 || p->second<dfNext)
+            dfNext = p->second;
+    }
+
+    //wake everyone whose time has come - they are running again until
+    //they next tell us when they want to wake
+    double dfNow = MOOSTime();
+    if(dfNext<dfNow)
+        dfNext = dfNow;
+    for(p=m_VirtualWakeMap.begin();p!=m_VirtualWakeMap.end();++p)
+    {
+        if(p->second<=dfNext)
+            p->second = -1;
+    }
+
+    //clients asking for a time already past don't need a new tick
+    if(!AdvanceMOOSVirtualTime(dfNext))
+        return;
+
+    CMOOSMsg DBVT(MOOS_NOTIFY,"MOOS_VIRTUAL_TIME",dfNext);
+    DBVT.m_sOriginatingCommunity = m_sCommunityName;
+    DBVT.m_sSrc = m_sDBName;
+    OnNotify(DBVT);
+}
+
 /**this will be called each time a new packet is recieved*/
 bool CMOOSDB::OnRxPkt(const std::string & sClient,MOOSMSG_LIST & MsgListRx,MOOSMSG_LIST & MsgListTx)
 {
@@ -679,6 +746,12 @@ bool CMOOSDB::ProcessMsg(CMOOSMsg &MsgRx,MOOSMSG_LIST & MsgListTx)
     switch(MsgRx.m_cMsgType)
     {
     case MOOS_NOTIFY:    //NOTIFICATION
+        if(m_bVirtualTime && MsgRx.GetKey()=="MOOS_VIRTUAL_WAKE")
+        {
+            bool bOK = OnNotify(MsgRx);
+            OnVirtualWake(MsgRx);
+            return bOK;
+        }
         return OnNotify(MsgRx);
         break;
     case MOOS_WILDCARD_UNREGISTER:
@@ -1129,6 +1202,10 @@ bool CMOOSDB::OnDisconnect(string &sClient)
     }
     
     m_HeldMailMap.erase(sClient);
+
+    //a departing client can no longer hold up the virtual clock
+    if(m_bVirtualTime && m_VirtualWakeMap.erase(sClient))
+        AdvanceVirtualTime();
     
     if(!m_bQuiet)
         std::cout<<MOOS::ConsoleColours::Green()<<"[OK]\n"<<MOOS::ConsoleColours::reset();
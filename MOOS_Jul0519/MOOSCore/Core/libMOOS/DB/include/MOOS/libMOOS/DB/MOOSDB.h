@@ -123,6 +123,13 @@ protected:
     void UpdateQoSVar();
     void UpdateReadWriteSummaryVar();
 
+    /** virtual time: a client tells us the time it next needs to run at*/
+    void OnVirtualWake(CMOOSMsg & Msg);
+
+    /** virtual time: move the clock to the earliest requested wake time
+    once every participating client is waiting */
+    void AdvanceVirtualTime();
+
     bool DoServerRequest(CMOOSMsg & Msg, MOOSMSG_LIST & MsgTxList);
     CMOOSDBVar & GetOrMakeVar(CMOOSMsg & Msg);
     bool OnRegister(CMOOSMsg & Msg);
@@ -141,6 +148,13 @@ private:
     bool m_bQuiet;
     double m_dfSummaryTime;
 
+    /** true if the DB is publishing a virtual clock (MOOSVirtualTime=true)*/
+    bool m_bVirtualTime;
+
+    /** virtual time: client name to the time it has asked to be woken
+    at. A negative value means it is running and has not asked yet */
+    std::map<std::string,double> m_VirtualWakeMap;
+
 
     /**a map of client name to a list of Msgs that will be sent
     the next time a client calls in*/
@@ -41,6 +41,7 @@ using namespace std;
 AppCast::AppCast()
 {
 	m_iteration = 0;
+	m_version = 0;
 	m_cnt_run_warnings = 0;
 	m_max_events = 8;
 	m_max_run_warnings = 10;
@@ -142,6 +143,10 @@ string AppCast::getAppCastString() const
 	if (m_node_name != "")
 		ss << "node=" << m_node_name << osep;
 
+	// Only appcasts serving as keyframes of a delta stream are versioned
+	if (m_version != 0)
+		ss << "acver=" << m_version << osep;
+
 	ss << "iter=" << m_iteration << osep;
 
 	// Add the messages (the free-form content of the appcast)
@@ -154,48 +159,264 @@ string AppCast::getAppCastString() const
 	ss << osep;
 
 	// Add the messages (the free-form content of the appcast)
-	const unsigned int vsize = m_config_warnings.size();
-	if (vsize != 0)
-	{
-		ss << "config_warnings=";
-		for (unsigned int i = 0; i < vsize - 1; i++)
-		{
-			ss << m_config_warnings[i] << isep;
-		}
-		ss << m_config_warnings[vsize - 1];
-	}
+	if (m_config_warnings.size() != 0)
+		ss << "config_warnings=" << getCfgWarningsString();
 	ss << osep;
 
 	// Add the events
 	ss << "events_total=" << m_events.size() << osep;
 	if (m_events.size() > 0)
+		ss << "events=" << getEventsString();
+	ss << osep;
+
+	ss << "run_warning_total=" << m_cnt_run_warnings << osep;
+	if (m_map_run_warnings.size() != 0)
+		ss << "run_warnings=" << getRunWarningsString();
+
+	return (ss.str());
+}
+
+//----------------------------------------------------------------
+// Procedure: getAppCastDeltaString
+//   Purpose: Encode this appcast relative to the given keyframe. Only
+//            message lines differing from the keyframe are sent, along
+//            with the warning and event sections that have changed.
+//   Example: str = "acbase=12!@#proc=uProc!@#node=henry!@#iter=130!@#
+//                   msg_lines=24!@#msg_diff=7:Speed: 1.2!@19:Done"
+
+string AppCast::getAppCastDeltaString(const AppCast& keyframe) const
+{
+	string osep = "!@#"; // outer separator
+	string isep = "!@"; // inner separator
+
+	stringstream ss;
+	ss << "acbase=" << keyframe.getVersion() << osep;
+	ss << "proc=" << m_proc_name << osep;
+	ss << "node=" << m_node_name << osep;
+	ss << "iter=" << m_iteration << osep;
+
+	// Part 1: Message lines, by index, that differ from the keyframe
+	vector<string> kf_lines;
+	string kf_copy = keyframe.m_messages;
+	while (kf_copy != "")
+		kf_lines.push_back(MOOSChomp(kf_copy, "\n"));
+
+	unsigned int index = 0;
+	string diffs;
+	string messages_copy = m_messages;
+	while (messages_copy != "")
 	{
-		ss << "events=";
-		list<string>::const_iterator p;
-		for (p = m_events.begin(); p != m_events.end(); ++p)
+		string line = MOOSChomp(messages_copy, "\n");
+		if ((index >= kf_lines.size()) || (line != kf_lines[index]))
 		{
-			ss << *p;
-			if (p != --m_events.end())
-				ss << isep;
+			stringstream ds;
+			ds << index << ":" << line << isep;
+			diffs += ds.str();
 		}
+		index++;
 	}
-	ss << osep;
+	ss << "msg_lines=" << index << osep;
+	ss << "msg_diff=" << diffs << osep;
 
-	ss << "run_warning_total=" << m_cnt_run_warnings << osep;
-	if (m_map_run_warnings.size() != 0)
+	// Part 2: The remaining sections are sent whole, only if changed
+	if (m_config_warnings != keyframe.m_config_warnings)
 	{
-		ss << "run_warnings=";
-		map<string, unsigned int>::const_iterator p;
-		for (p = m_map_run_warnings.begin(); p != m_map_run_warnings.end(); ++p)
+		ss << "config_warnings_total=" << m_config_warnings.size() << osep;
+		ss << "config_warnings=" << getCfgWarningsString() << osep;
+	}
+
+	if (m_events != keyframe.m_events)
+	{
+		ss << "events_total=" << m_events.size() << osep;
+		ss << "events=" << getEventsString() << osep;
+	}
+
+	if ((m_cnt_run_warnings != keyframe.m_cnt_run_warnings)
+			|| (m_map_run_warnings != keyframe.m_map_run_warnings))
+	{
+		ss << "run_warning_total=" << m_cnt_run_warnings << osep;
+		ss << "run_warnings=" << getRunWarningsString();
+	}
+
+	return (ss.str());
+}
+
+//----------------------------------------------------------------
+// Procedure: applyAppCastDelta
+//   Purpose: Apply a delta string, as made by getAppCastDeltaString,
+//            to this appcast, presumed to be a copy of the keyframe.
+//   Returns: false if the delta was made against a different keyframe
+
+bool AppCast::applyAppCastDelta(const std::string& str)
+{
+	string osep = "!@#"; // outer separator
+	string isep = "!@"; // inner separator
+
+	unsigned int msg_lines = 0;
+	string msg_diff;
+
+	bool cfg_changed = false;
+	bool events_changed = false;
+	bool run_changed = false;
+	string cfg_str, events_str, run_str;
+
+	string ac_str = str;
+	while (ac_str != "")
+	{
+		string pair = MOOSChomp(ac_str, osep);
+		string param = MOOSChomp(pair, "=");
+		string value = pair;
+		MOOSTrimWhiteSpace(param);
+
+		if (param == "acbase")
+		{
+			if ((m_version == 0)
+					|| ((unsigned int) (atoi(value.c_str())) != m_version))
+				return (false);
+		}
+		else if (param == "iter")
+			m_iteration = (unsigned int) (atoi(value.c_str()));
+		else if (param == "msg_lines")
+			msg_lines = (unsigned int) (atoi(value.c_str()));
+		else if (param == "msg_diff")
+			msg_diff = value;
+		else if (param == "config_warnings_total")
+			cfg_changed = true;
+		else if (param == "config_warnings")
+			cfg_str = value;
+		else if (param == "events_total")
+			events_changed = true;
+		else if (param == "events")
+			events_str = value;
+		else if (param == "run_warning_total")
 		{
-			string warning = p->first;
-			unsigned int wcount = p->second;
-			ss << wcount << ":" << warning;
-			if (p != --m_map_run_warnings.end())
-				ss << isep;
+			run_changed = true;
+			m_cnt_run_warnings = (unsigned int) (atoi(value.c_str()));
+		}
+		else if (param == "run_warnings")
+			run_str = value;
+	}
+
+	// Part 1: Rebuild the message lines from the keyframe and the diffs
+	vector<string> lines;
+	string messages_copy = m_messages;
+	while (messages_copy != "")
+		lines.push_back(MOOSChomp(messages_copy, "\n"));
+	lines.resize(msg_lines);
+
+	while (msg_diff != "")
+	{
+		string entry = MOOSChomp(msg_diff, isep);
+		string index = MOOSChomp(entry, ":");
+		unsigned int ix = (unsigned int) (atoi(index.c_str()));
+		if (ix < lines.size())
+			lines[ix] = entry;
+	}
+
+	// Trim the rebuilt lines as string2AppCast trims the messages of
+	// a full appcast, so that both render the same.
+	string value;
+	for (unsigned int i = 0; i < lines.size(); i++)
+		value += lines[i] + isep;
+	MOOSTrimWhiteSpace(value);
+
+	stringstream ss;
+	while (value != "")
+		ss << MOOSChomp(value, isep) << endl;
+	m_messages = ss.str();
+
+	// Part 2: Replace whole sections that have changed
+	if (cfg_changed)
+	{
+		m_config_warnings.clear();
+		while (cfg_str != "")
+		{
+			string config_warning = MOOSChomp(cfg_str, isep);
+			MOOSTrimWhiteSpace(config_warning);
+			m_config_warnings.push_back(config_warning);
 		}
 	}
 
+	if (events_changed)
+	{
+		m_events.clear();
+		while (events_str != "")
+		{
+			string event = MOOSChomp(events_str, isep);
+			MOOSTrimWhiteSpace(event);
+			m_events.push_back(event);
+		}
+	}
+
+	if (run_changed)
+	{
+		m_map_run_warnings.clear();
+		while (run_str != "")
+		{
+			string full_warning = MOOSChomp(run_str, isep);
+			MOOSTrimWhiteSpace(full_warning);
+			string count = MOOSChomp(full_warning, ":");
+			MOOSTrimWhiteSpace(count);
+			MOOSTrimWhiteSpace(full_warning);
+			int warning_cnt = atoi(count.c_str());
+			warning_cnt = (warning_cnt < 0) ? 0 : warning_cnt;
+			m_map_run_warnings[full_warning] = (unsigned int) (warning_cnt);
+		}
+	}
+
+	return (true);
+}
+
+//----------------------------------------------------------------
+// Procedure: getCfgWarningsString
+
+string AppCast::getCfgWarningsString() const
+{
+	string isep = "!@"; // inner separator
+
+	string str;
+	for (unsigned int i = 0; i < m_config_warnings.size(); i++)
+	{
+		if (i > 0)
+			str += isep;
+		str += m_config_warnings[i];
+	}
+	return (str);
+}
+
+//----------------------------------------------------------------
+// Procedure: getEventsString
+
+string AppCast::getEventsString() const
+{
+	string isep = "!@"; // inner separator
+
+	string str;
+	list<string>::const_iterator p;
+	for (p = m_events.begin(); p != m_events.end(); ++p)
+	{
+		if (p != m_events.begin())
+			str += isep;
+		str += *p;
+	}
+	return (str);
+}
+
+//----------------------------------------------------------------
+// Procedure: getRunWarningsString
+
+string AppCast::getRunWarningsString() const
+{
+	string isep = "!@"; // inner separator
+
+	stringstream ss;
+	map<string, unsigned int>::const_iterator p;
+	for (p = m_map_run_warnings.begin(); p != m_map_run_warnings.end(); ++p)
+	{
+		if (p != m_map_run_warnings.begin())
+			ss << isep;
+		ss << p->second << ":" << p->first;
+	}
 	return (ss.str());
 }
 
@@ -322,6 +543,10 @@ AppCast string2AppCast(const std::string& str)
 		{
 			ac.setNodeName(value);
 		}
+		else if (param == "acver")
+		{
+			ac.setVersion((unsigned int) (atoi(value.c_str())));
+		}
 		else if (param == "messages")
 		{
 			stringstream ss;
@@ -371,3 +596,13 @@ AppCast string2AppCast(const std::string& str)
 
 	return (ac);
 }
+
+//----------------------------------------------------------------
+// Procedure: isAppCastDelta
+//      Note: Delta appcasts always lead with the keyframe version
+//            they were made against.
+
+bool isAppCastDelta(const std::string& str)
+{
+	return (str.compare(0, 7, "acbase=") == 0);
+}
@@ -59,6 +59,13 @@ AppCastingMOOSApp::AppCastingMOOSApp()
 
   m_comms_policy = "open";
   m_comms_policy_config = "open";
+
+  m_appcast_delta             = false;
+  m_appcast_keyframe_interval = 10;
+  m_appcast_version           = 0;
+  m_appcasts_since_keyframe   = 0;
+  m_appcast_keyframe_pending  = true;
+  m_ac_keyframe_len           = 0;
 }
 
 //----------------------------------------------------------------
@@ -201,8 +208,46 @@ void AppCastingMOOSApp::PostReport(const string& directive)
     m_new_run_warning = false;
     m_new_cfg_warning = false;
     m_last_report_time_appcast = m_curr_time;
-    m_Comms.Notify("APPCAST", m_ac.getAppCastString());
+    m_Comms.Notify("APPCAST", getAppCastPosting());
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: getAppCastPosting()
+//      Note: With delta appcasting enabled, and all current requestors
+//            able to rebuild deltas, only changes against the most
+//            recent keyframe are sent. A fresh keyframe is sent every
+//            m_appcast_keyframe_interval postings, when a new requestor
+//            shows up, or when the delta is no longer much smaller.
+
+string AppCastingMOOSApp::getAppCastPosting()
+{
+  if(!m_appcast_delta)
+    return(m_ac.getAppCastString());
+
+  bool keyframe = m_appcast_keyframe_pending || (m_appcast_version == 0);
+  if(m_appcasts_since_keyframe >= m_appcast_keyframe_interval)
+    keyframe = true;
+  if(!appcastDeltaOK())
+    keyframe = true;
+
+  if(!keyframe) {
+    string delta = m_ac.getAppCastDeltaString(m_ac_keyframe);
+    if((2 * delta.size()) < m_ac_keyframe_len) {
+      m_appcasts_since_keyframe++;
+      return(delta);
+    }
   }
+
+  m_appcast_version++;
+  m_ac.setVersion(m_appcast_version);
+  string str = m_ac.getAppCastString();
+
+  m_ac_keyframe = m_ac;
+  m_ac_keyframe_len = str.size();
+  m_appcasts_since_keyframe = 0;
+  m_appcast_keyframe_pending = false;
+  return(str);
 }
 
 //----------------------------------------------------------------
@@ -344,13 +389,23 @@ bool AppCastingMOOSApp::OnStartUpDirectives(string directives)
       reportConfigWarning("Invalid value for TERM_REPORTING: " + term_reporting);
   }
   
-  // #3 Allow certain appcasting defaults to be overridden
+  // #3 Global Config Variable: Determining if appcasts may be deltas.
+  // Set before reading the app config block so the block may override.
+  string appcast_delta;
+  if(m_MissionReader.GetValue("APPCAST_DELTA", appcast_delta)) {
+    if(MOOSStrCmp(appcast_delta, "true"))
+      m_appcast_delta = true;
+    else if(!MOOSStrCmp(appcast_delta, "false"))
+      reportConfigWarning("Invalid value for APPCAST_DELTA: " + appcast_delta);
+  }
+
+  // #4 Allow certain appcasting defaults to be overridden
   STRING_LIST sParams;
   string config_block = GetAppName();
   if(alt_config_block_name != "")
     config_block = alt_config_block_name;
 
-  // #4 Check if there is a config block and if config block is mandatory
+  // #5 Check if there is a config block and if config block is mandatory
   if(!m_MissionReader.GetConfiguration(config_block, sParams)) {
     if(must_have_moosblock) {
       reportConfigWarning("No mission config block found for " + config_block);
@@ -395,6 +450,24 @@ bool AppCastingMOOSApp::OnStartUpDirectives(string directives)
 	cout << "+++++++++++++++++++++++++++++++++++++++++++++++++" << endl;      
       }
     }
+    else if(param == "APPCAST_DELTA") {
+      if(MOOSStrCmp(value, "true"))
+	m_appcast_delta = true;
+      else if(MOOSStrCmp(value, "false"))
+	m_appcast_delta = false;
+      else
+	reportConfigWarning("Invalid APPCAST_DELTA: " + value);
+    }
+    else if(param == "APPCAST_KEYFRAME_INTERVAL") {
+      if(!MOOSIsNumeric(value))
+	reportConfigWarning("Invalid APPCAST_KEYFRAME_INTERVAL: " + value);
+      else {
+	int interval = atoi(value.c_str());
+	interval = (interval < 1)   ?   1 : interval;
+	interval = (interval > 100) ? 100 : interval;
+	m_appcast_keyframe_interval = (unsigned int)(interval);
+      }
+    }
     else if(param == "MAX_APPCAST_RUN_WARNINGS") {
       if(!MOOSIsNumeric(value))
 	reportConfigWarning("Invalid MAX_APPCAST_EVENTS: " + value);
@@ -408,16 +481,16 @@ bool AppCastingMOOSApp::OnStartUpDirectives(string directives)
     }
   }    
 
-  // #5 Initialize the AppCast Instance
+  // #6 Initialize the AppCast Instance
   m_ac.setNodeName(m_host_community);
   m_ac.setProcName(GetAppName());
 
-  // #6 Set key member variables base on basic MOOS calls
+  // #7 Set key member variables base on basic MOOS calls
   m_curr_time  = MOOSTime();
   m_start_time = MOOSTime();
   m_time_warp  = GetMOOSTimeWarp();
   
-  // #7 A negative or zero time warp is insane. Report this as a warning
+  // #8 A negative or zero time warp is insane. Report this as a warning
   // and set to something that won't produce a NaN when dividing by 
   // time_warp to convert from moos_elapsed_time to real_elapsed_time.
   if(m_time_warp <= 0) {
@@ -496,6 +569,7 @@ void AppCastingMOOSApp::handleMailAppCastRequest(const string& str)
   string s_key;
   string s_duration;
   string s_thresh = "any";
+  bool   b_delta  = false;
 
   string request = str;
   while(request != "") {
@@ -517,6 +591,8 @@ void AppCastingMOOSApp::handleMailAppCastRequest(const string& str)
       s_duration = value;
     else if(param == "THRESH")
       s_thresh = value;
+    else if(param == "DELTA")
+      b_delta = MOOSStrCmp(value, "true");
     else if(param == "KEY") {
       s_key = value;
     }
@@ -529,9 +605,16 @@ void AppCastingMOOSApp::handleMailAppCastRequest(const string& str)
   d_duration = (d_duration < 0) ? 0 : d_duration;
   d_duration = (d_duration > 30) ? 30 : d_duration;
 
+  // A requestor new to us, or returning after its request expired, may
+  // hold no keyframe. Make sure the next appcast posted is a keyframe.
+  if((m_map_bcast_duration.count(s_key) == 0) ||
+     ((m_curr_time - m_map_bcast_tstart[s_key]) >= m_map_bcast_duration[s_key]))
+    m_appcast_keyframe_pending = true;
+
   m_map_bcast_duration[s_key] = d_duration;
   m_map_bcast_tstart[s_key]   = m_curr_time;
   m_map_bcast_thresh[s_key]   = s_thresh;
+  m_map_bcast_delta[s_key]    = b_delta;
 }
 
 //----------------------------------------------------------------
@@ -545,18 +628,26 @@ bool AppCastingMOOSApp::appcastRequested()
   bool requested = false;
 
   map<string,double>::iterator p;
-  for(p=m_map_bcast_duration.begin(); p!=m_map_bcast_duration.end(); ++p) {
+  for(p=m_map_bcast_duration.begin(); p!=m_map_bcast_duration.end();) {
     string key      = p->first;
     double duration = p->second;
     double elapsed  = m_curr_time - m_map_bcast_tstart[key];
 
-    // Found an un-expired subscription for appcasts from a client.
-    if(elapsed < duration) {
-      if(m_map_bcast_thresh[key] == "any")
-	requested = true;
-      else if((m_map_bcast_thresh[key] == "run_warning") && m_new_run_warning)
-	requested = true;
+    // Drop expired subscriptions so stale clients are not consulted
+    if(elapsed >= duration) {
+      m_map_bcast_tstart.erase(key);
+      m_map_bcast_thresh.erase(key);
+      m_map_bcast_delta.erase(key);
+      m_map_bcast_duration.erase(p++);
+      continue;
     }
+
+    // Found an un-expired subscription for appcasts from a client.
+    if(m_map_bcast_thresh[key] == "any")
+      requested = true;
+    else if((m_map_bcast_thresh[key] == "run_warning") && m_new_run_warning)
+      requested = true;
+    ++p;
   }
   if(m_new_cfg_warning)
     requested = true;
@@ -565,6 +656,24 @@ bool AppCastingMOOSApp::appcastRequested()
   return(requested);
 }
 
+//----------------------------------------------------------------
+// Procedure: appcastDeltaOK
+//      Note: Deltas are only useful if every current requestor is able
+//            to rebuild them. One older client means full appcasts.
+
+bool AppCastingMOOSApp::appcastDeltaOK() const
+{
+  if(m_map_bcast_delta.size() == 0)
+    return(false);
+
+  map<string,bool>::const_iterator p;
+  for(p=m_map_bcast_delta.begin(); p!=m_map_bcast_delta.end(); ++p) {
+    if(!p->second)
+      return(false);
+  }
+  return(true);
+}
+
 //----------------------------------------------------------------
 // Procedure: reportEvent
 
@@ -600,7 +709,8 @@ void AppCastingMOOSApp::reportUnhandledConfigWarning(const string& orig)
   if((param == "APPTICK")    || (param == "APP_LOGGING")          ||
      (param == "MAXAPPTICK") || (param == "TERM_REPORT_INTERVAL") ||
      (param == "COMMSTICK")  || (param == "MAX_APPCAST_EVENTS")   ||
-     (param == "DEPRECATED_OK"))
+     (param == "DEPRECATED_OK") || (param == "APPCAST_DELTA")     ||
+     (param == "APPCAST_KEYFRAME_INTERVAL"))
     return;
 
   reportConfigWarning("Unhandled config line: " + orig);
@@ -51,6 +51,7 @@ class AppCast
   void  setIteration(unsigned int v)         {m_iteration=v;};
   void  setMaxEvents(unsigned int v)         {m_max_events=v;};
   void  setMaxRunWarnings(unsigned int v)    {m_max_run_warnings=v;};
+  void  setVersion(unsigned int v)           {m_version=v;};
 
   std::string::size_type size() const { return (m_messages.size()); };
   std::string::size_type getCfgWarningCount() const {
@@ -62,13 +63,21 @@ class AppCast
   unsigned int getMaxEvents() const          {return(m_max_events);};
   std::string  getProcName() const           {return(m_proc_name);};
   std::string  getNodeName() const           {return(m_node_name);};
+  unsigned int getVersion() const            {return(m_version);};
 
   std::string  getAppCastString() const;
+  std::string  getAppCastDeltaString(const AppCast& keyframe) const;
   std::string  getFormattedString(bool with_header=true) const;
 
  public: // Used for rebuilding an AppCast from String
   void  setRunWarnings(const std::string&, unsigned int);
   void  setRunWarningCount(unsigned int v)  {m_cnt_run_warnings=v;};
+  bool  applyAppCastDelta(const std::string&);
+
+ protected:
+  std::string getCfgWarningsString() const;
+  std::string getEventsString() const;
+  std::string getRunWarningsString() const;
 
  protected: // Configuration vars
   std::string              m_proc_name;
@@ -80,6 +89,9 @@ class AppCast
  protected: // State vars
   unsigned int             m_iteration;
 
+  // Keyframe version. Zero if the appcast is not part of a delta stream.
+  unsigned int             m_version;
+
   // AppCast holds all (unlimited) messages, and config warnings
   std::string              m_messages;
   std::vector<std::string> m_config_warnings;
@@ -94,5 +106,6 @@ class AppCast
 };
 
 AppCast string2AppCast(const std::string&);
+bool    isAppCastDelta(const std::string&);
 
 #endif
@@ -67,6 +67,8 @@ public:
   void         handleMailAppCastRequest(const std::string&);
   bool         handleMailCommsPolicy(const std::string&);
   bool         appcastRequested();
+  bool         appcastDeltaOK() const;
+  std::string  getAppCastPosting();
 
 protected:
   unsigned int m_iteration;
@@ -103,5 +105,15 @@ protected:
   std::map<std::string, double>       m_map_bcast_duration;
   std::map<std::string, double>       m_map_bcast_tstart;
   std::map<std::string, std::string>  m_map_bcast_thresh;  
+  std::map<std::string, bool>         m_map_bcast_delta;
+
+  // Delta appcasting: changes are sent against the last keyframe
+  bool         m_appcast_delta;
+  unsigned int m_appcast_keyframe_interval;
+  unsigned int m_appcast_version;
+  unsigned int m_appcasts_since_keyframe;
+  bool         m_appcast_keyframe_pending;
+  AppCast      m_ac_keyframe;
+  std::string::size_type m_ac_keyframe_len;
 };
 #endif
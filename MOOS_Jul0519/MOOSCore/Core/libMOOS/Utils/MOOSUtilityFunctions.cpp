@@ -102,6 +102,18 @@ typedef std::map<pthread_t,bool> THREAD2TRACE_MAP;
 double gdfMOOSTimeWarp = 1.0;
 double gdfMOOSSkew =0.0;
 
+//virtual time - when enabled MOOSTime() reads this clock which is
+//only ever moved forward by AdvanceMOOSVirtualTime()
+bool gbMOOSVirtualTime = false;
+bool gbMOOSVirtualTimeSet = false;
+double gdfMOOSVirtualTime = 0.0;
+#ifndef _WIN32
+pthread_mutex_t gVirtualTimeMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t gVirtualTimeCond = PTHREAD_COND_INITIALIZER;
+#else
+CMOOSLock gVirtualTimeLock;
+#endif
+
 //NB new V10 functions will be namespaced....
 namespace MOOS
 {
@@ -314,9 +326,113 @@ double HPMOOSTime(bool bApplyTimeWarping)
 
 double MOOSTime(bool bApplyTimeWarping)
 {
+    if(gbMOOSVirtualTime)
+    {
+        double dfT = 0.0;
+        bool bSet = false;
+#ifndef _WIN32
+        pthread_mutex_lock(&gVirtualTimeMutex);
+        dfT = gdfMOOSVirtualTime;
+        bSet = gbMOOSVirtualTimeSet;
+        pthread_mutex_unlock(&gVirtualTimeMutex);
+#else
+        gVirtualTimeLock.Lock();
+        dfT = gdfMOOSVirtualTime;
+        bSet = gbMOOSVirtualTimeSet;
+        gVirtualTimeLock.UnLock();
+#endif
+        //until the clock has been set we fall through to local time
+        if(bSet)
+            return dfT;
+    }
     return MOOSLocalTime(bApplyTimeWarping)+gdfMOOSSkew;
 }
 
+void SetMOOSVirtualTime(bool bEnable)
+{
+    gbMOOSVirtualTime = bEnable;
+}
+
+bool IsMOOSVirtualTime()
+{
+    return gbMOOSVirtualTime;
+}
+
+bool IsMOOSVirtualTimeSet()
+{
+    bool bSet = false;
+#ifndef _WIN32
+    pthread_mutex_lock(&gVirtualTimeMutex);
+    bSet = gbMOOSVirtualTimeSet;
+    pthread_mutex_unlock(&gVirtualTimeMutex);
+#else
+    gVirtualTimeLock.Lock();
+    bSet = gbMOOSVirtualTimeSet;
+    gVirtualTimeLock.UnLock();
+#endif
+    return bSet;
+}
+
+bool AdvanceMOOSVirtualTime(double dfTime)
+{
+    bool bMoved = false;
+#ifndef _WIN32
+    pthread_mutex_lock(&gVirtualTimeMutex);
+#else
+    gVirtualTimeLock.Lock();
+#endif
+    //time only ever moves forward
+    if(!gbMOOSVirtualTimeSet || dfTime>gdfMOOSVirtualTime)
+    {
+        gdfMOOSVirtualTime = dfTime;
+        gbMOOSVirtualTimeSet = true;
+        bMoved = true;
+    }
+#ifndef _WIN32
+    if(bMoved)
+        pthread_cond_broadcast(&gVirtualTimeCond);
+    pthread_mutex_unlock(&gVirtualTimeMutex);
+#else
+    gVirtualTimeLock.UnLock();
+#endif
+    return bMoved;
+}
+
+bool WaitForMOOSVirtualTime(double dfTime, int nTimeOutMS)
+{
+#ifndef _WIN32
+    struct timeval Now;
+    gettimeofday(&Now,NULL);
+    long long nNS = (long long)Now.tv_usec*1000 + (long long)nTimeOutMS*1000000;
+    timespec Deadline;
+    Deadline.tv_sec = Now.tv_sec + (time_t)(nNS/1000000000);
+    Deadline.tv_nsec = (long)(nNS%1000000000);
+
+    bool bReached = true;
+    pthread_mutex_lock(&gVirtualTimeMutex);
+    while(!gbMOOSVirtualTimeSet || gdfMOOSVirtualTime<dfTime)
+    {
+        if(pthread_cond_timedwait(&gVirtualTimeCond,&gVirtualTimeMutex,&Deadline)==ETIMEDOUT)
+        {
+            bReached = gbMOOSVirtualTimeSet && gdfMOOSVirtualTime>=dfTime;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&gVirtualTimeMutex);
+    return bReached;
+#else
+    //no condition variables here so we poll
+    double dfGiveUp = MOOSLocalTime(false)+nTimeOutMS/1000.0;
+    while(MOOSLocalTime(false)<dfGiveUp)
+    {
+        if(IsMOOSVirtualTimeSet() && MOOSTime()>=dfTime)
+            return true;
+        MOOSPause(1,false);
+    }
+    return IsMOOSVirtualTimeSet() && MOOSTime()>=dfTime;
+#endif
+}
+
 double GetMOOSTimeWarp()
 {
     return gdfMOOSTimeWarp;
@@ -0,0 +1,432 @@
+/**
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This software was written by Paul Newman at MIT 2001-2002 and 
+//   the University of Oxford 2003-2013 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+**/
+
+
+
+// ProcessConfigCache.cpp: implementation of the CProcessConfigCache class.
+//
+//////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#pragma warning(disable : 4786)
+#endif
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include "MOOS/libMOOS/Utils/ProcessConfigReader.h"
+#include "MOOS/libMOOS/Utils/ProcessConfigCache.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+
+#define CONFIG_CACHE_MAGIC "MOOSCONFIGCACHE"
+#define CONFIG_CACHE_VERSION 1
+
+namespace
+{
+    //strings are written as "<length>:<bytes>\n" so any content survives
+    void WriteString(std::ostream & os, const std::string & s)
+    {
+        os<<s.size()<<':';
+        os.write(s.data(), s.size());
+        os<<'\n';
+    }
+
+    bool ReadString(std::istream & is, std::string & s)
+    {
+        size_t nLen = 0;
+        char c = 0;
+        if(!(is>>nLen) || !is.get(c) || c!=':')
+            return false;
+        s.resize(nLen);
+        if(nLen>0 && !is.read(&s[0], nLen))
+            return false;
+        return is.get(c) && c=='\n';
+    }
+
+    void WriteList(std::ostream & os, const std::list<std::string> & L)
+    {
+        os<<L.size()<<'\n';
+        std::list<std::string>::const_iterator q;
+        for(q=L.begin();q!=L.end();++q)
+            WriteString(os, *q);
+    }
+
+    bool ReadList(std::istream & is, std::list<std::string> & L)
+    {
+        size_t nSize = 0;
+        if(!(is>>nSize))
+            return false;
+        L.clear();
+        for(size_t i=0;i<nSize;i++)
+        {
+            std::string s;
+            if(!ReadString(is, s))
+                return false;
+            L.push_back(s);
+        }
+        return true;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CProcessConfigCache::CProcessConfigCache()
+{
+    m_bValid = false;
+}
+
+CProcessConfigCache::~CProcessConfigCache()
+{
+}
+
+void CProcessConfigCache::Clear()
+{
+    m_bValid = false;
+    m_Stamp = FileStamp();
+    m_Blocks.clear();
+    m_Values.clear();
+    m_Environment.clear();
+}
+
+bool CProcessConfigCache::FileStamp::operator==(const FileStamp & S) const
+{
+    return nSize==S.nSize && nModTime==S.nModTime &&
+           nDevice==S.nDevice && nInode==S.nInode;
+}
+
+bool CProcessConfigCache::StampFile(const std::string & sFile, FileStamp & Stamp)
+{
+    struct stat S;
+    if(stat(sFile.c_str(), &S)!=0)
+        return false;
+
+    Stamp.nSize = (long long)S.st_size;
+    Stamp.nModTime = (long long)S.st_mtime;
+#ifdef _WIN32
+    //no inodes here, size and time must do
+    Stamp.nDevice = 0;
+    Stamp.nInode = 0;
+#else
+    Stamp.nDevice = (long long)S.st_dev;
+    Stamp.nInode = (long long)S.st_ino;
+#endif
+    return true;
+}
+
+std::string CProcessConfigCache::Upper(std::string s)
+{
+    MOOSToUpper(s);
+    return s;
+}
+
+///                               BUILDING
+
+bool CProcessConfigCache::Build(const std::string & sMissionFile)
+{
+    Clear();
+
+    //a plain text reader - it must not itself look for a cache
+    CProcessConfigReader Reader;
+    Reader.EnableCache(false);
+    if(!Reader.SetFile(sMissionFile))
+        return false;
+
+    if(!StampFile(sMissionFile, m_Stamp))
+        return false;
+
+    //one pass over the valid lines, exactly as GetValue() and GoTo() see them,
+    //collects the first value of every name and the name of every block
+    std::list<std::string> BlockNames;
+    Reader.Reset();
+    while(!Reader.eof())
+    {
+        std::string sLine = Reader.GetNextValidLine();
+
+        std::string sTok,sVal;
+        if(CMOOSFileReader::GetTokenValPair(sLine, sTok, sVal))
+        {
+            std::string sKey = Upper(sTok);
+            if(m_Values.find(sKey)==m_Values.end())
+                m_Values[sKey] = sVal;
+        }
+
+        MOOSRemoveChars(sLine," \t\r");
+        if(MOOSStrCmp(sLine.substr(0,14), "PROCESSCONFIG="))
+        {
+            std::string sName = sLine.substr(14);
+            if(m_Blocks.find(Upper(sName))==m_Blocks.end())
+            {
+                m_Blocks[Upper(sName)] = Block();
+                BlockNames.push_back(sName);
+            }
+        }
+    }
+
+    //now each block as the reader would return it
+    std::list<std::string>::iterator p;
+    for(p=BlockNames.begin();p!=BlockNames.end();++p)
+    {
+        Block & B = m_Blocks[Upper(*p)];
+        B.bFound = Reader.GetConfiguration(*p, B.Params);
+        B.bFoundPreserved = Reader.GetConfigurationAndPreserveSpace(*p, B.PreservedParams);
+        BuildIndex(B);
+    }
+
+    //record every ${VAR} in the file with its value here, since expansion
+    //falls back to the environment of the process doing the reading
+    std::ifstream File(sMissionFile.c_str());
+    std::string sRaw;
+    while(std::getline(File, sRaw))
+    {
+        while(true)
+        {
+            MOOSChomp(sRaw, "${");
+            if(sRaw.empty())
+                break;
+            std::string sVar = MOOSChomp(sRaw, "}");
+            if(sVar.empty())
+                break;
+            char * pVal = getenv(sVar.c_str());
+            m_Environment[sVar] = std::make_pair(pVal!=NULL, std::string(pVal ? pVal : ""));
+        }
+    }
+
+    m_bValid = true;
+    return true;
+}
+
+void CProcessConfigCache::BuildIndex(Block & B)
+{
+    //the same walk as CProcessConfigReader::GetConfigurationParam() which
+    //takes the first match and gives up at the first entry without a value
+    B.Index.clear();
+    if(!B.bFoundPreserved)
+        return;
+
+    std::list<std::string>::iterator p;
+    for(p=B.PreservedParams.begin();p!=B.PreservedParams.end();++p)
+    {
+        std::string sTmp = *p;
+        std::string sTok = MOOSChomp(sTmp,"=");
+        MOOSTrimWhiteSpace(sTok);
+
+        if(sTmp.empty())
+            break;
+
+        std::string sKey = Upper(sTok);
+        if(B.Index.find(sKey)==B.Index.end())
+        {
+            MOOSTrimWhiteSpace(sTmp);
+            B.Index[sKey] = sTmp;
+        }
+    }
+}
+
+///                               FILE I/O
+
+bool CProcessConfigCache::Write(const std::string & sCacheFile) const
+{
+    if(!m_bValid)
+        return false;
+
+    std::ofstream os(sCacheFile.c_str(), std::ios::out | std::ios::binary);
+    if(!os.is_open())
+        return false;
+
+    os<<CONFIG_CACHE_MAGIC<<' '<<CONFIG_CACHE_VERSION<<'\n';
+    os<<m_Stamp.nSize<<' '<<m_Stamp.nModTime<<' '<<m_Stamp.nDevice<<' '<<m_Stamp.nInode<<'\n';
+
+    os<<m_Environment.size()<<'\n';
+    std::map<std::string, std::pair<bool, std::string> >::const_iterator e;
+    for(e=m_Environment.begin();e!=m_Environment.end();++e)
+    {
+        WriteString(os, e->first);
+        os<<(e->second.first ? 1 : 0)<<'\n';
+        WriteString(os, e->second.second);
+    }
+
+    os<<m_Values.size()<<'\n';
+    std::map<std::string, std::string>::const_iterator v;
+    for(v=m_Values.begin();v!=m_Values.end();++v)
+    {
+        WriteString(os, v->first);
+        WriteString(os, v->second);
+    }
+
+    os<<m_Blocks.size()<<'\n';
+    std::map<std::string, Block>::const_iterator b;
+    for(b=m_Blocks.begin();b!=m_Blocks.end();++b)
+    {
+        WriteString(os, b->first);
+        os<<(b->second.bFound ? 1 : 0)<<' '<<(b->second.bFoundPreserved ? 1 : 0)<<'\n';
+        WriteList(os, b->second.Params);
+        WriteList(os, b->second.PreservedParams);
+    }
+
+    os.close();
+    return !os.fail();
+}
+
+bool CProcessConfigCache::Read(const std::string & sCacheFile, const std::string & sMissionFile)
+{
+    Clear();
+
+    std::ifstream is(sCacheFile.c_str(), std::ios::in | std::ios::binary);
+    if(!is.is_open())
+        return false;
+
+    if(!ReadStream(is, sMissionFile))
+    {
+        Clear();
+        return false;
+    }
+
+    m_bValid = true;
+    return true;
+}
+
+bool CProcessConfigCache::ReadStream(std::istream & is, const std::string & sMissionFile)
+{
+    std::string sMagic;
+    int nVersion = 0;
+    if(!(is>>sMagic>>nVersion) || sMagic!=CONFIG_CACHE_MAGIC || nVersion!=CONFIG_CACHE_VERSION)
+        return false;
+
+    FileStamp Stamp;
+    if(!(is>>m_Stamp.nSize>>m_Stamp.nModTime>>m_Stamp.nDevice>>m_Stamp.nInode))
+        return false;
+
+    //is this the mission file we are being asked about, unchanged?
+    if(!StampFile(sMissionFile, Stamp) || !(Stamp==m_Stamp))
+        return false;
+
+    size_t nEnv = 0;
+    if(!(is>>nEnv))
+        return false;
+    for(size_t i=0;i<nEnv;i++)
+    {
+        std::string sVar,sVal;
+        int nSet = 0;
+        if(!ReadString(is, sVar) || !(is>>nSet) || !ReadString(is, sVal))
+            return false;
+
+        //expansions must come out as they would here
+        char * pVal = getenv(sVar.c_str());
+        if((pVal!=NULL)!=(nSet!=0) || (pVal!=NULL && sVal!=pVal))
+            return false;
+        m_Environment[sVar] = std::make_pair(nSet!=0, sVal);
+    }
+
+    size_t nValues = 0;
+    if(!(is>>nValues))
+        return false;
+    for(size_t i=0;i<nValues;i++)
+    {
+        std::string sKey,sVal;
+        if(!ReadString(is, sKey) || !ReadString(is, sVal))
+            return false;
+        m_Values[sKey] = sVal;
+    }
+
+    size_t nBlocks = 0;
+    if(!(is>>nBlocks))
+        return false;
+    for(size_t i=0;i<nBlocks;i++)
+    {
+        std::string sKey;
+        int nFound = 0, nFoundPreserved = 0;
+        if(!ReadString(is, sKey) || !(is>>nFound>>nFoundPreserved))
+            return false;
+
+        Block & B = m_Blocks[sKey];
+        B.bFound = nFound!=0;
+        B.bFoundPreserved = nFoundPreserved!=0;
+        if(!ReadList(is, B.Params) || !ReadList(is, B.PreservedParams))
+            return false;
+        BuildIndex(B);
+    }
+    return true;
+}
+
+///                               LOOKUPS
+
+const CProcessConfigCache::Block * CProcessConfigCache::FindBlock(const std::string & sAppName) const
+{
+    //GoTo() compares whole lines with white space removed, case insensitively
+    std::string sKey = sAppName;
+    MOOSRemoveChars(sKey," \t\r");
+
+    std::map<std::string, Block>::const_iterator q = m_Blocks.find(Upper(sKey));
+    if(q==m_Blocks.end())
+        return NULL;
+    return &(q->second);
+}
+
+bool CProcessConfigCache::GetConfiguration(const std::string & sAppName, std::list<std::string> & Params) const
+{
+    Params.clear();
+    const Block * pBlock = FindBlock(sAppName);
+    if(pBlock==NULL)
+        return false;
+
+    Params = pBlock->Params;
+    return pBlock->bFound;
+}
+
+bool CProcessConfigCache::GetConfigurationAndPreserveSpace(const std::string & sAppName, std::list<std::string> & Params) const
+{
+    Params.clear();
+    const Block * pBlock = FindBlock(sAppName);
+    if(pBlock==NULL)
+        return false;
+
+    Params = pBlock->PreservedParams;
+    return pBlock->bFoundPreserved;
+}
+
+bool CProcessConfigCache::GetConfigurationParam(const std::string & sAppName, const std::string & sParam, std::string & sVal) const
+{
+    const Block * pBlock = FindBlock(sAppName);
+    if(pBlock==NULL)
+        return false;
+
+    std::map<std::string, std::string>::const_iterator q = pBlock->Index.find(Upper(sParam));
+    if(q==pBlock->Index.end())
+        return false;
+
+    sVal = q->second;
+    return true;
+}
+
+bool CProcessConfigCache::GetValue(const std::string & sName, std::string & sVal) const
+{
+    std::map<std::string, std::string>::const_iterator q = m_Values.find(Upper(sName));
+    if(q==m_Values.end())
+        return false;
+
+    sVal = q->second;
+    return true;
+}
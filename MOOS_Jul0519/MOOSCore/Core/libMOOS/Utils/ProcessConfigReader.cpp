@@ -33,7 +33,9 @@
 #endif
 #include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
 #include "MOOS/libMOOS/Utils/ProcessConfigReader.h"
+#include "MOOS/libMOOS/Utils/MOOSLock.h"
 #include <iostream>
+#include <cstdlib>
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -41,11 +43,77 @@
 
 CProcessConfigReader::CProcessConfigReader()
 {
-    
+    m_pCache = NULL;
+    m_bCacheEnabled = true;
+    m_bCacheChecked = false;
 }
 
 CProcessConfigReader::~CProcessConfigReader()
 {
+    delete m_pCache;
+    m_pCache = NULL;
+}
+
+///                               PRE-PARSED CACHE
+
+void CProcessConfigReader::EnableCache(bool bEnable)
+{
+    m_pLock->Lock();
+    m_bCacheEnabled = bEnable;
+    m_bCacheChecked = false;
+    delete m_pCache;
+    m_pCache = NULL;
+    m_pLock->UnLock();
+}
+
+bool CProcessConfigReader::UsingCache()
+{
+    return GetCache()!=NULL;
+}
+
+CProcessConfigCache * CProcessConfigReader::GetCache()
+{
+    m_pLock->Lock();
+
+    //look again if we are now reading a different file
+    if(m_bCacheChecked && m_sCacheCheckedFor!=m_sFileName)
+    {
+        m_bCacheChecked = false;
+        delete m_pCache;
+        m_pCache = NULL;
+    }
+
+    if(!m_bCacheChecked && m_bCacheEnabled && !m_sFileName.empty())
+    {
+        m_bCacheChecked = true;
+        m_sCacheCheckedFor = m_sFileName;
+
+        //a launcher may have left us an index of this very file - if not, or if
+        //the file has changed since, we just read the text as ever
+        char * pCacheFile = getenv(CProcessConfigCache::EnvironmentVariable());
+        if(pCacheFile!=NULL && pCacheFile[0]!='\0')
+        {
+            CProcessConfigCache * pCache = new CProcessConfigCache;
+            if(pCache->Read(pCacheFile, m_sFileName))
+                m_pCache = pCache;
+            else
+                delete pCache;
+        }
+    }
+
+    CProcessConfigCache * pAnswer = m_bCacheEnabled ? m_pCache : NULL;
+    m_pLock->UnLock();
+
+    return pAnswer;
+}
+
+bool CProcessConfigReader::GetValue(std::string sName, std::string & sResult)
+{
+    CProcessConfigCache * pCache = GetCache();
+    if(pCache!=NULL)
+        return pCache->GetValue(sName, sResult);
+
+    return CMOOSFileReader::GetValue(sName, sResult);
 }
 
 
@@ -70,6 +138,10 @@ std::string CProcessConfigReader::GetFileName()
 
 bool CProcessConfigReader::GetConfigurationAndPreserveSpace(std::string sAppName, STRING_LIST &Params)
 {
+	CProcessConfigCache * pCache = GetCache();
+	if(pCache!=NULL)
+		return pCache->GetConfigurationAndPreserveSpace(sAppName, Params);
+
 	Params.clear();
 
 	Reset();
@@ -129,6 +201,9 @@ bool CProcessConfigReader::GetConfigurationAndPreserveSpace(std::string sAppName
 
 bool CProcessConfigReader::GetConfiguration(std::string sAppName, STRING_LIST &Params)
 {
+    CProcessConfigCache * pCache = GetCache();
+    if(pCache!=NULL)
+        return pCache->GetConfiguration(sAppName, Params);
     
     Params.clear();
     
@@ -304,6 +379,10 @@ bool CProcessConfigReader::GetConfigurationParam(std::string sAppName,std::strin
     MOOSToLower(sl);
     m_Audit[sAppName].insert(sl);
 
+    CProcessConfigCache * pCache = GetCache();
+    if(pCache!=NULL)
+        return pCache->GetConfigurationParam(sAppName, sParam, sVal);
+
     STRING_LIST sParams;
     
     if(GetConfigurationAndPreserveSpace( sAppName, sParams))
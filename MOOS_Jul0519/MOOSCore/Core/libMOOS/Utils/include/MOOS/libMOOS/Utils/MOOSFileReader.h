@@ -70,7 +70,7 @@ public:
     bool Reset();
 
     /** looks for a line "sName = Val" in whole file, fills in result with Val */
-    bool GetValue(std::string  sName,std::string & sResult);
+    virtual bool GetValue(std::string  sName,std::string & sResult);
     /** looks for a line "sName = Val" in whole file, fills in result with Val */
     bool GetValue(std::string sName,double  & dfResult);
     /** looks for a line "sName = Val" in whole file, fills in result with Val */
@@ -178,6 +178,27 @@ double MOOSTime(bool bApplyTimeWarping=true);
 calls to MOOSTime()*/
 bool SetWin32HighPrecisionTiming(bool bEnable);
 
+/** switch MOOSTime() over to a virtual clock which only moves when
+ AdvanceMOOSVirtualTime() is called (typically as a result of mail from a
+ MOOSDB running with MOOSVirtualTime=true). Warp and skew are ignored
+ once the virtual clock has been set. MOOSLocalTime() is unaffected */
+void SetMOOSVirtualTime(bool bEnable);
+
+/** returns true if MOOSTime() is using a virtual clock */
+bool IsMOOSVirtualTime();
+
+/** returns true once the virtual clock has been given a time */
+bool IsMOOSVirtualTimeSet();
+
+/** move the virtual clock forward to dfTime and wake anyone blocked in
+ WaitForMOOSVirtualTime(). Returns false (and does nothing) if dfTime is
+ not ahead of the current virtual time */
+bool AdvanceMOOSVirtualTime(double dfTime);
+
+/** block until the virtual clock reaches dfTime or until nTimeOutMS of
+ wall clock time has passed. Returns true if dfTime was reached */
+bool WaitForMOOSVirtualTime(double dfTime, int nTimeOutMS);
+
 /**return high precision timestamp - time since unix in seconds only has high precision in win32*/
 double HPMOOSTime(bool bApplyTimeWarping = true);
 
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//    
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt
+//          
+//   This program is distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+// ProcessConfigCache.h: interface for the CProcessConfigCache class.
+//
+//////////////////////////////////////////////////////////////////////
+/*! \file ProcessConfigCache.h */
+
+#if !defined(PROCESSCONFIGCACHEH)
+#define PROCESSCONFIGCACHEH
+
+#include <string>
+#include <istream>
+#include <map>
+#include <list>
+#include <utility>
+
+//! A pre-parsed index of a mission file
+/**
+ * Every CProcessConfigReader lookup is a scan of the mission file text. This
+ * class does those scans once, for every configuration block and every
+ * "name = value" line, and keeps the answers. It is built by pAntler, written
+ * to a file and named in the MOOS_CONFIG_CACHE environment variable, so that
+ * each launched process can read the index instead of scanning the mission
+ * file again for every parameter.
+ *
+ * The answers are those the text scan gives, quirks included. A cache is only
+ * used if the mission file has not changed since it was built (size, time and
+ * inode) and any ${VAR} shell variables named in the file have the same value
+ * in the reading process. Otherwise the reader falls back to the text scan.
+ */
+class CProcessConfigCache
+{
+public:
+    CProcessConfigCache();
+    virtual ~CProcessConfigCache();
+
+    /** scan the named mission file and build the index*/
+    bool Build(const std::string & sMissionFile);
+
+    /** write the index to a cache file*/
+    bool Write(const std::string & sCacheFile) const;
+
+    /** read an index from a cache file, failing if it was not built from sMissionFile as it is now*/
+    bool Read(const std::string & sCacheFile, const std::string & sMissionFile);
+
+    /** true if the index holds a built or read mission file*/
+    bool IsValid() const {return m_bValid;}
+
+    /** number of configuration blocks in the index*/
+    unsigned int GetNumBlocks() const {return (unsigned int)m_Blocks.size();}
+
+    /** as CProcessConfigReader::GetConfiguration()*/
+    bool GetConfiguration(const std::string & sAppName, std::list<std::string> & Params) const;
+
+    /** as CProcessConfigReader::GetConfigurationAndPreserveSpace()*/
+    bool GetConfigurationAndPreserveSpace(const std::string & sAppName, std::list<std::string> & Params) const;
+
+    /** as CProcessConfigReader::GetConfigurationParam() for a string*/
+    bool GetConfigurationParam(const std::string & sAppName, const std::string & sParam, std::string & sVal) const;
+
+    /** as CMOOSFileReader::GetValue() for a string*/
+    bool GetValue(const std::string & sName, std::string & sVal) const;
+
+    /** name of the environment variable naming the cache file of a launch*/
+    static const char * EnvironmentVariable() {return "MOOS_CONFIG_CACHE";}
+
+protected:
+    /** identity of a mission file at the time the index was built */
+    struct FileStamp
+    {
+        FileStamp() : nSize(0), nModTime(0), nDevice(0), nInode(0) {}
+        bool operator==(const FileStamp & S) const;
+        long long nSize;
+        long long nModTime;
+        long long nDevice;
+        long long nInode;
+    };
+
+    /** results for one "ProcessConfig = Name" block */
+    struct Block
+    {
+        Block() : bFound(false), bFoundPreserved(false) {}
+        bool bFound;
+        std::list<std::string> Params;
+        bool bFoundPreserved;
+        std::list<std::string> PreservedParams;
+
+        //upper case parameter name -> value, as searched by GetConfigurationParam()
+        std::map<std::string, std::string> Index;
+    };
+
+    void Clear();
+    void BuildIndex(Block & B);
+    bool ReadStream(std::istream & is, const std::string & sMissionFile);
+    const Block * FindBlock(const std::string & sAppName) const;
+
+    static bool StampFile(const std::string & sFile, FileStamp & Stamp);
+    static std::string Upper(std::string s);
+
+    bool m_bValid;
+    FileStamp m_Stamp;
+
+    //upper case block name -> block
+    std::map<std::string, Block> m_Blocks;
+
+    //upper case name -> value of the first "name = value" line in the file
+    std::map<std::string, std::string> m_Values;
+
+    //${VAR} names in the file -> (set?, value) in the environment
+    std::map<std::string, std::pair<bool, std::string> > m_Environment;
+};
+
+#endif // !defined(PROCESSCONFIGCACHEH)
@@ -30,6 +30,7 @@
 
 
 #include "MOOS/libMOOS/Utils/MOOSFileReader.h"
+#include "MOOS/libMOOS/Utils/ProcessConfigCache.h"
 
 #include <string>
 #include <map>
@@ -108,6 +109,17 @@ public:
 
     std::list<std::string> GetSearchedParameters(const std::string & sAppName);
 
+    /** looks for a line "sName = Val" in whole file, fills in result with Val (uses the cache if there is one)*/
+    virtual bool GetValue(std::string sName,std::string & sResult);
+    using CMOOSFileReader::GetValue;
+
+    /** allow (default) or prevent use of a pre-parsed cache named by MOOS_CONFIG_CACHE. The
+        environment is looked at again at the next lookup.*/
+    void EnableCache(bool bEnable=true);
+
+    /** true if lookups are being answered from a pre-parsed cache*/
+    bool UsingCache();
+
 
 
     /** the name of process an instance this class will handle unless told otherwise */ 
@@ -116,6 +128,15 @@ public:
     //a collection of parameters searched for on a per application basis....
     std::map<std::string, std::set<std::string>  > m_Audit;
 
+protected:
+    /** the cache for the current file, loaded on first use, or NULL if there is none*/
+    CProcessConfigCache * GetCache();
+
+    CProcessConfigCache * m_pCache;
+    bool m_bCacheEnabled;
+    bool m_bCacheChecked;
+    std::string m_sCacheCheckedFor;
+
 };
 
 #endif // !defined(AFX_PROCESSCONFIGREADER_H__CA9A3D99_64A5_4BDC_B89A_301324D37330__INCLUDED_)
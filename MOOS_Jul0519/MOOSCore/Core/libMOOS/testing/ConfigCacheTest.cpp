@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of 
+//   Applications and Libraries for Mobile Robotics Research 
+//   Copyright (C) Paul Newman
+//    
+//   This software was written by Paul Newman at MIT 2001-2002 and 
+//   the University of Oxford 2003-2013 
+//   
+//   email: pnewman@robots.ox.ac.uk. 
+//              
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful, 
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of 
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. 
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+
+/*
+ * ConfigCacheTest.cpp
+ *
+ *  Checks that a CProcessConfigReader answering from a pre-parsed
+ *  CProcessConfigCache gives exactly the answers of the text scan, for every
+ *  block and parameter name found in the given mission files, and reports
+ *  the time taken by each.
+ */
+#include "MOOS/libMOOS/Utils/ProcessConfigReader.h"
+#include "MOOS/libMOOS/Utils/ProcessConfigCache.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include <iostream>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace
+{
+    //every token of every valid line, as names to ask about
+    void CollectNames(const std::string & sFile, std::set<std::string> & Blocks, std::set<std::string> & Names)
+    {
+        CProcessConfigReader Reader;
+        Reader.EnableCache(false);
+        Reader.SetFile(sFile);
+        Reader.Reset();
+        while(!Reader.eof())
+        {
+            std::string sLine = Reader.GetNextValidLine();
+            std::string sTok,sVal;
+            if(CMOOSFileReader::GetTokenValPair(sLine, sTok, sVal, true))
+            {
+                MOOSTrimWhiteSpace(sTok);
+                MOOSTrimWhiteSpace(sVal);
+                Names.insert(sTok);
+                MOOSToLower(sTok);
+                Names.insert(sTok);
+                if(MOOSStrCmp(sTok, "PROCESSCONFIG"))
+                {
+                    Blocks.insert(sVal);
+                    Blocks.insert(" "+sVal+" ");
+                    MOOSToLower(sVal);
+                    Blocks.insert(sVal);
+                }
+            }
+        }
+        Blocks.insert("NoSuchProcess");
+        Names.insert("NoSuchParameter");
+        Names.insert("");
+    }
+
+    bool Same(const std::string & sWhat, bool b1, bool b2, const std::string & s1, const std::string & s2)
+    {
+        if(b1==b2 && (!b1 || s1==s2))
+            return true;
+        std::cerr<<"MISMATCH "<<sWhat<<" text:"<<b1<<"["<<s1<<"] cache:"<<b2<<"["<<s2<<"]\n";
+        return false;
+    }
+
+    std::string Join(const STRING_LIST & L)
+    {
+        std::string s;
+        STRING_LIST::const_iterator q;
+        for(q=L.begin();q!=L.end();++q)
+            s+=*q+"\n";
+        return s;
+    }
+
+    //ask both readers every question, returns number of mismatches
+    int Compare(CProcessConfigReader & Text, CProcessConfigReader & Cached,
+                const std::set<std::string> & Blocks, const std::set<std::string> & Names,
+                double & dfTextTime, double & dfCacheTime, int & nLookups)
+    {
+        int nBad = 0;
+        std::set<std::string>::const_iterator b,n;
+        for(b=Blocks.begin();b!=Blocks.end();++b)
+        {
+            STRING_LIST L1,L2;
+            double dfT0 = MOOSLocalTime();
+            bool b1 = Text.GetConfiguration(*b, L1);
+            bool b1p = Text.GetConfigurationAndPreserveSpace(*b, L1);
+            double dfT1 = MOOSLocalTime();
+            bool b2 = Cached.GetConfiguration(*b, L2);
+            bool b2p = Cached.GetConfigurationAndPreserveSpace(*b, L2);
+            double dfT2 = MOOSLocalTime();
+            dfTextTime += dfT1-dfT0;
+            dfCacheTime += dfT2-dfT1;
+
+            STRING_LIST M1,M2;
+            Text.GetConfiguration(*b, M1);
+            Cached.GetConfiguration(*b, M2);
+            nBad += !Same("GetConfiguration("+*b+")", b1, b2, Join(M1), Join(M2));
+            nBad += !Same("GetConfigurationAndPreserveSpace("+*b+")", b1p, b2p, Join(L1), Join(L2));
+
+            for(n=Names.begin();n!=Names.end();++n)
+            {
+                std::string s1,s2;
+                dfT0 = MOOSLocalTime();
+                b1 = Text.GetConfigurationParam(*b, *n, s1);
+                dfT1 = MOOSLocalTime();
+                b2 = Cached.GetConfigurationParam(*b, *n, s2);
+                dfT2 = MOOSLocalTime();
+                dfTextTime += dfT1-dfT0;
+                dfCacheTime += dfT2-dfT1;
+                nLookups++;
+                nBad += !Same("GetConfigurationParam("+*b+","+*n+")", b1, b2, s1, s2);
+            }
+        }
+
+        for(n=Names.begin();n!=Names.end();++n)
+        {
+            std::string s1,s2;
+            bool b1 = Text.GetValue(*n, s1);
+            bool b2 = Cached.GetValue(*n, s2);
+            nBad += !Same("GetValue("+*n+")", b1, b2, s1, s2);
+            double d1=0,d2=0;
+            b1 = Text.GetValue(*n, d1);
+            b2 = Cached.GetValue(*n, d2);
+            nBad += !Same("GetValue(double "+*n+")", b1, b2, MOOSFormat("%g",d1), MOOSFormat("%g",d2));
+        }
+        return nBad;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    if(argc<2)
+    {
+        std::cerr<<"usage: config_cache_test mission_file [mission_file...]\n";
+        return 1;
+    }
+
+    std::string sCacheFile = "config_cache_test.cache";
+    int nFailures = 0;
+
+    for(int i=1;i<argc;i++)
+    {
+        std::string sMission = argv[i];
+
+        CProcessConfigCache Cache;
+        if(!Cache.Build(sMission) || !Cache.Write(sCacheFile))
+        {
+            std::cerr<<sMission<<": cannot build cache\n";
+            nFailures++;
+            continue;
+        }
+
+        std::set<std::string> Blocks,Names;
+        CollectNames(sMission, Blocks, Names);
+
+        CProcessConfigReader Text;
+        Text.EnableCache(false);
+        Text.SetFile(sMission);
+
+        //the cached reader finds the cache as a launched process would
+#ifdef _WIN32
+        _putenv_s(CProcessConfigCache::EnvironmentVariable(), sCacheFile.c_str());
+#else
+        setenv(CProcessConfigCache::EnvironmentVariable(), sCacheFile.c_str(), 1);
+#endif
+        CProcessConfigReader Cached;
+        Cached.SetFile(sMission);
+        if(!Cached.UsingCache())
+        {
+            std::cerr<<sMission<<": cache not used\n";
+            nFailures++;
+            continue;
+        }
+
+        double dfTextTime=0, dfCacheTime=0;
+        int nLookups = 0;
+        int nBad = Compare(Text, Cached, Blocks, Names, dfTextTime, dfCacheTime, nLookups);
+        nFailures += nBad;
+
+        std::cout<<sMission<<": "<<Cache.GetNumBlocks()<<" blocks, "<<nLookups<<" lookups, "
+                 <<(nBad==0 ? "identical" : "MISMATCHED")
+                 <<MOOSFormat(", text %.1f us, cache %.2f us per lookup\n",
+                              1e6*dfTextTime/nLookups, 1e6*dfCacheTime/nLookups);
+    }
+
+    //a cache for some other file must not be used
+    if(argc>2)
+    {
+        CProcessConfigReader Other;
+        Other.SetFile(argv[1]);
+        if(Other.UsingCache())
+        {
+            std::cerr<<"cache for "<<argv[argc-1]<<" used for "<<argv[1]<<"\n";
+            nFailures++;
+        }
+    }
+
+#ifndef _WIN32
+    unlink(sCacheFile.c_str());
+#endif
+
+    std::cout<<(nFailures==0 ? "PASS" : "FAIL")<<std::endl;
+    return nFailures==0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////
+//
+//   This file is part of the MOOS project
+//
+//   MOOS : Mission Oriented Operating Suite A suit of
+//   Applications and Libraries for Mobile Robotics Research
+//   Copyright (C) Paul Newman
+//
+//   This software was written by Paul Newman at MIT 2001-2002 and
+//   the University of Oxford 2003-2013
+//
+//   email: pnewman@robots.ox.ac.uk.
+//
+//   This source code and the accompanying materials
+//   are made available under the terms of the GNU Lesser Public License v2.1
+//   which accompanies this distribution, and is available at
+//   http://www.gnu.org/licenses/lgpl.txt distributed in the hope that it will be useful,
+//   but WITHOUT ANY WARRANTY; without even the implied warranty of
+//   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+//
+////////////////////////////////////////////////////////////////////////////
+
+
+
+
+
+/*
+ * VirtualTimeTest.cpp
+ *
+ *  Checks the virtual clock (AdvanceMOOSVirtualTime and
+ *  WaitForMOOSVirtualTime) and the barrier a MOOSDB running with
+ *  --moos_virtual_time keeps over its clients. Clients are played by
+ *  handing packets straight to the DB, so the order in which they wait
+ *  and the mail each one would collect are exactly known.
+ */
+#include "MOOS/libMOOS/DB/MOOSDB.h"
+#include "MOOS/libMOOS/Utils/MOOSThread.h"
+#include "MOOS/libMOOS/Utils/CommandLineParser.h"
+#include "MOOS/libMOOS/Utils/MOOSUtilityFunctions.h"
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    int gnFailures = 0;
+
+    void Check(bool bOK, const std::string & sWhat)
+    {
+        if(!bOK)
+        {
+            std::cerr<<"FAILED "<<sWhat<<"\n";
+            gnFailures++;
+        }
+    }
+
+    //a client sends one packet to the DB and collects its mail
+    MOOSMSG_LIST Send(CMOOSDB & DB, const std::string & sClient, MOOSMSG_LIST Rx)
+    {
+        MOOSMSG_LIST::iterator q;
+        for(q=Rx.begin();q!=Rx.end();++q)
+            q->m_sSrc = sClient;
+        MOOSMSG_LIST Tx;
+        DB.OnRxPkt(sClient,Rx,Tx);
+        return Tx;
+    }
+
+    MOOSMSG_LIST Register(CMOOSDB & DB, const std::string & sClient, const std::string & sVar)
+    {
+        MOOSMSG_LIST Rx;
+        Rx.push_back(CMOOSMsg(MOOS_REGISTER,sVar,0.0));
+        return Send(DB,sClient,Rx);
+    }
+
+    MOOSMSG_LIST Wake(CMOOSDB & DB, const std::string & sClient, double dfWake)
+    {
+        MOOSMSG_LIST Rx;
+        Rx.push_back(CMOOSMsg(MOOS_NOTIFY,"MOOS_VIRTUAL_WAKE",dfWake));
+        return Send(DB,sClient,Rx);
+    }
+
+    //mail held for a client between its packets, added to what it has
+    void Fetch(CMOOSDB & DB, const std::string & sClient, MOOSMSG_LIST & Mail)
+    {
+        MOOSMSG_LIST Tx;
+        DB.OnFetchAllMail(sClient,Tx);
+        Mail.splice(Mail.end(),Tx);
+    }
+
+    //the keys and values of the notifications in some mail, in order
+    std::string Describe(const MOOSMSG_LIST & Mail)
+    {
+        std::string s;
+        MOOSMSG_LIST::const_iterator q;
+        for(q=Mail.begin();q!=Mail.end();++q)
+        {
+            if(!q->IsType(MOOS_NOTIFY))
+                continue;
+            if(q->IsDouble())
+                s+=MOOSFormat("%s=%.1f;",q->GetKey().c_str(),q->GetDouble());
+            else
+                s+=q->GetKey()+"="+q->GetString()+";";
+        }
+        return s;
+    }
+
+    bool AdvanceLater(void * pParam)
+    {
+        MOOSPause(100,false);
+        AdvanceMOOSVirtualTime(*static_cast<double*>(pParam));
+        return true;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    MOOS::CommandLineParser P(argc,argv);
+    if(P.GetFlag("-h","--help"))
+    {
+        std::cerr<<"usage: virtual_time_test [--moos_port=9777]\n";
+        return 0;
+    }
+    int nPort = 9777;
+    P.GetVariable("--moos_port",nPort);
+
+    ///////////////////////////////////////////////////////////
+    // Part 1: the DB starts the clock at the wall clock time
+    std::vector<std::string> Args;
+    Args.push_back("virtual_time_test");
+    Args.push_back("--moos_virtual_time");
+    Args.push_back("--moos_no_colour");
+    Args.push_back("--moos_suicide_disable");
+    Args.push_back(MOOSFormat("--moos_port=%d",nPort));
+    Args.push_back(MOOSFormat("--audit_port=%d",nPort+1));
+    std::vector<char*> Argv;
+    for(unsigned int i=0;i<Args.size();i++)
+        Argv.push_back(&Args[i][0]);
+
+    CMOOSDB DB;
+    DB.SetQuiet(true);
+    if(!DB.Run((int)Argv.size(),&Argv[0]))
+    {
+        std::cerr<<"cannot run the DB\n";
+        return 1;
+    }
+
+    Check(IsMOOSVirtualTime() && IsMOOSVirtualTimeSet(), "clock set by DB");
+    double dfT0 = MOOSTime();
+    Check(dfT0>0 && MOOSTime()==dfT0, "clock stands still");
+
+    ///////////////////////////////////////////////////////////
+    // Part 2: the barrier. Times are given relative to dfT0.
+    Register(DB,"a","MOOS_VIRTUAL_TIME");
+    Register(DB,"b","MOOS_VIRTUAL_TIME");
+
+    //a is the only participant so far so it is not held up. Every
+    //packet b sends collects its mail, which is kept in MailB
+    Wake(DB,"a",dfT0+1);
+    Check(MOOSTime()==dfT0+1, "sole participant runs");
+
+    //b waits while a is still running - nothing moves
+    MOOSMSG_LIST MailB = Wake(DB,"b",dfT0+3);
+    Check(MOOSTime()==dfT0+1, "held while a runs");
+
+    //a posts before waiting again: b must see that post before the tick
+    MailB.splice(MailB.end(),Register(DB,"b","DEPLOY"));
+    MOOSMSG_LIST Rx;
+    Rx.push_back(CMOOSMsg(MOOS_NOTIFY,"DEPLOY","true"));
+    Rx.push_back(CMOOSMsg(MOOS_NOTIFY,"MOOS_VIRTUAL_WAKE",dfT0+2));
+    Send(DB,"a",Rx);
+    Check(MOOSTime()==dfT0+2, "earliest wake chosen");
+
+    //b is still waiting for dfT0+3 so is next when a waits at dfT0+5
+    Wake(DB,"a",dfT0+5);
+    Check(MOOSTime()==dfT0+3, "b woken next");
+    Fetch(DB,"b",MailB);
+    std::string sExpected = MOOSFormat("MOOS_VIRTUAL_TIME=%.1f;",dfT0+1);
+    sExpected += MOOSFormat("DEPLOY=true;MOOS_VIRTUAL_TIME=%.1f;",dfT0+2);
+    sExpected += MOOSFormat("MOOS_VIRTUAL_TIME=%.1f;",dfT0+3);
+    Check(Describe(MailB)==sExpected, "mail order "+Describe(MailB));
+
+    //b asks for a time already past: it runs on but there is no tick
+    MailB = Wake(DB,"b",dfT0+2.5);
+    Fetch(DB,"b",MailB);
+    Check(MOOSTime()==dfT0+3, "no going back");
+    Check(Describe(MailB)=="", "no tick for the past");
+
+    //b is running again and leaves, so a is no longer held up by it
+    std::string sB = "b";
+    DB.OnDisconnect(sB);
+    Check(MOOSTime()==dfT0+5, "departed client releases the barrier");
+
+    ///////////////////////////////////////////////////////////
+    // Part 3: blocking for the clock
+    double dfT = MOOSTime();
+    Check(!AdvanceMOOSVirtualTime(dfT), "same time is not a move");
+    Check(WaitForMOOSVirtualTime(dfT,0), "time reached needs no wait");
+
+    double dfStart = MOOSLocalTime(false);
+    Check(!WaitForMOOSVirtualTime(dfT+1,200), "wait times out");
+    Check(MOOSLocalTime(false)-dfStart>=0.15, "timeout is on the wall clock");
+
+    double dfLater = dfT+10;
+    CMOOSThread Advancer(AdvanceLater,&dfLater);
+    Advancer.Start();
+    Check(WaitForMOOSVirtualTime(dfT+5,5000), "woken by a later advance");
+    Check(MOOSTime()==dfLater, "woken at the new time");
+    Advancer.Stop();
+
+    std::cout<<(gnFailures==0 ? "PASS" : "FAIL")<<std::endl;
+    return gnFailures==0 ? 0 : 1;
+}
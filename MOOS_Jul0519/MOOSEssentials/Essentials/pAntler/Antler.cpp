@@ -7,6 +7,8 @@ using namespace std;
 #include <string>
 #include <iterator>
 #include <algorithm>
+#include <cstdlib>
+#include <cstdio>
 
 
 
@@ -383,6 +385,13 @@ bool CAntler::Spawn(const std::string &  sMissionFile, bool bHeadless)
     if(!m_MissionReader.GetConfiguration(  m_MissionReader.GetAppName(),sParams))
         return MOOSFail("error reading antler config block from mission file\n");
     
+    //parse the mission file once here rather than once in every child
+    RemoveConfigCache();
+    bool bConfigCache = true;
+    m_MissionReader.GetConfigurationParam("ConfigCache",bConfigCache);
+    if(bConfigCache)
+        MakeConfigCache(sMissionFile);
+    
     
     //fetch all the lines in teg Antler configuration block
     STRING_LIST::iterator p;
@@ -473,7 +482,10 @@ bool CAntler::Spawn(const std::string &  sMissionFile, bool bHeadless)
             
             
             if(!ConfigureMOOSComms())
+            {
+                RemoveConfigCache();
                 return MOOSFail("failed to start MOOS comms");
+            }
             
         }
     }
@@ -558,13 +570,71 @@ bool CAntler::Spawn(const std::string &  sMissionFile, bool bHeadless)
               
     }
     
-
+    RemoveConfigCache();
     
     return 0;
     
 }
 
 
+bool CAntler::MakeConfigCache(const std::string & sMissionFile)
+{
+    CProcessConfigCache Cache;
+    if(!Cache.Build(sMissionFile))
+        return false;
+    
+#ifdef _WIN32
+    char sPath[MAX_PATH];
+    char sName[MAX_PATH];
+    if(GetTempPathA(MAX_PATH,sPath)==0 || GetTempFileNameA(sPath,"moo",0,sName)==0)
+        return MOOSFail("   cannot make configuration cache file - children will parse the mission file\n");
+    std::string sCacheFile = sName;
+#else
+    char sName[] = "/tmp/moos_config_XXXXXX";
+    int fd = mkstemp(sName);
+    if(fd<0)
+        return MOOSFail("   cannot make configuration cache file - children will parse the mission file\n");
+    close(fd);
+    std::string sCacheFile = sName;
+#endif
+    
+    if(!Cache.Write(sCacheFile))
+    {
+        remove(sCacheFile.c_str());
+        return MOOSFail("   cannot write configuration cache file - children will parse the mission file\n");
+    }
+    
+    //children inherit our environment and so find the cache
+#ifdef _WIN32
+    _putenv_s(CProcessConfigCache::EnvironmentVariable(),sCacheFile.c_str());
+#else
+    setenv(CProcessConfigCache::EnvironmentVariable(),sCacheFile.c_str(),1);
+#endif
+    m_sConfigCacheFile = sCacheFile;
+    m_MissionReader.EnableCache(true);
+    
+    MOOSTrace("   %d configuration blocks pre-parsed into %s\n",Cache.GetNumBlocks(),m_sConfigCacheFile.c_str());
+    
+    return true;
+}
+
+
+void CAntler::RemoveConfigCache()
+{
+    if(m_sConfigCacheFile.empty())
+        return;
+    
+#ifdef _WIN32
+    _putenv_s(CProcessConfigCache::EnvironmentVariable(),"");
+#else
+    unsetenv(CProcessConfigCache::EnvironmentVariable());
+#endif
+    remove(m_sConfigCacheFile.c_str());
+    m_sConfigCacheFile.clear();
+    m_MissionReader.EnableCache(false);
+}
+
+
 
 
 bool CAntler::MakeExtraExecutableParameters(std::string sParam,STRING_LIST & ExtraCommandLineParameters,std::string sProcName,std::string sMOOSName)
@@ -848,6 +918,8 @@ bool CAntler::ShutDown()
 
 	 }
 	
+	RemoveConfigCache();
+
 	MOOSTrace("\n\n   All spawned processes shutdown.\n\n   That was the MOOS \n\n");
 	 
 	 
@@ -147,6 +147,11 @@ class CAntler
 		
 		/** Kill a process gently */
 		bool KillNicely(MOOSProc* pProc);
+
+        /** parse the mission file once and hand the result to every child via the environment*/
+        bool MakeConfigCache(const std::string & sMissionFile);
+        /** remove any cache made by MakeConfigCache and stop advertising it*/
+        void RemoveConfigCache();
         
         CMOOSLock m_JobLock;
         std::string m_sMissionFile;
@@ -162,6 +167,9 @@ class CAntler
         std::string m_sDBHost;
         int m_nDBPort;
         
+        //pre-parsed mission file shared with launched processes (empty if none)
+        std::string m_sConfigCacheFile;
+        
 		VERBOSITY_LEVEL m_eVerbosity;
 
 
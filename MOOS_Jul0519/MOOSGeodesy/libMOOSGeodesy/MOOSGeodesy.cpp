@@ -72,6 +72,13 @@ CMOOSGeodesy::CMOOSGeodesy()
     SetOriginLatitude(0.0);
     m_iRefEllipsoid    = 23;
 
+    m_bSTEP_AFTER_INIT   = true;
+    m_bTangentPlaneMode  = false;
+    m_bTangentPlaneValid = false;
+    m_dfTangentRange     = 10000;
+    m_dfTangentMaxError  = 0.1;
+    m_dfTangentError     = 0;
+    InitTangentPlane();
 }
 
 CMOOSGeodesy::~CMOOSGeodesy()
@@ -120,6 +127,11 @@ bool CMOOSGeodesy::Initialise(double lat, double lon)
     //traveled is with respect to the origin coordinates.
     m_bSTEP_AFTER_INIT = true;
 
+    //The tangent plane is always fitted about the new origin, so it is
+    //available on request, but only used in place of the UTM path if
+    //tangent plane mode is on
+    m_bTangentPlaneValid = InitTangentPlane();
+
     return true;
 }
 
@@ -158,6 +170,27 @@ double CMOOSGeodesy::GetMetersEast()
 bool CMOOSGeodesy::LLtoUTM(int ReferenceEllipsoid, const double Lat, 
                             const double Long, double &UTMNorthing, 
                             double &UTMEasting, char *UTMZone)
+{
+    int ZoneNumber = LLtoUTMNoZone(ReferenceEllipsoid, Lat, Long,
+                                   UTMNorthing, UTMEasting);
+
+    //compute the UTM Zone from the latitude and longitude
+    sprintf(UTMZone, "%d%c", ZoneNumber, UTMLetterDesignator(Lat));
+
+    return true;
+}
+
+/**
+ *The UTM conversion proper, without formatting the zone string, which
+ *is a good part of the cost per point. Used directly by the batch
+ *conversions.
+ *
+ *@return the UTM zone number
+ */
+
+int CMOOSGeodesy::LLtoUTMNoZone(int ReferenceEllipsoid, const double Lat, 
+                                const double Long, double &UTMNorthing, 
+                                double &UTMEasting)
 {
     //converts lat/long to UTM coords.  Equations from USGS Bulletin 1532 
     //East Longitudes are positive, West longitudes are negative. 
@@ -197,9 +230,6 @@ bool CMOOSGeodesy::LLtoUTM(int ReferenceEllipsoid, const double Lat,
     LongOrigin = (ZoneNumber - 1)*6 - 180 + 3;  //+3 puts origin in middle of zone
     LongOriginRad = LongOrigin * deg2rad;
 
-    //compute the UTM Zone from the latitude and longitude
-    sprintf(UTMZone, "%d%c", ZoneNumber, UTMLetterDesignator(Lat));
-
     eccPrimeSquared = (eccSquared)/(1-eccSquared);
 
     N = a/sqrt(1-eccSquared*sin(LatRad)*sin(LatRad));
@@ -221,7 +251,7 @@ bool CMOOSGeodesy::LLtoUTM(int ReferenceEllipsoid, const double Lat,
     if(Lat < 0)
         UTMNorthing += 10000000.0; //10000000 meter offset for southern hemisphere
 
-    return true;
+    return ZoneNumber;
 }
 
 
@@ -331,7 +361,17 @@ bool CMOOSGeodesy::LatLong2LocalUTM(double lat,
     double dN = 0.0, dE = 0.0; 
     char tmpUTM[4];
 
-    
+    //in tangent plane mode, points within range skip the UTM series
+    if(m_bTangentPlaneMode && m_bTangentPlaneValid &&
+       LatLong2LocalTangent(lat, lon, tmpNorth, tmpEast))
+    {
+        SetMetersNorth(tmpNorth);
+        SetMetersEast(tmpEast);
+        m_bSTEP_AFTER_INIT = false;
+        MetersNorth = tmpNorth;
+        MetersEast = tmpEast;
+        return true;
+    }
 
     LLtoUTM(m_iRefEllipsoid,lat,lon,tmpNorth,tmpEast,tmpUTM);
 
@@ -485,6 +525,16 @@ bool CMOOSGeodesy::LocalGrid2LatLong(double dfEast, double dfNorth, double &dfLa
 
 
 bool CMOOSGeodesy::UTM2LatLong(double dfX, double dfY, double& dfLat, double& dfLong)
+{
+    //in tangent plane mode, points within range skip the iteration
+    if(m_bTangentPlaneMode && m_bTangentPlaneValid &&
+       LocalTangent2LatLong(dfX, dfY, dfLat, dfLong))
+        return true;
+
+    return UTM2LatLongExact(dfX, dfY, dfLat, dfLong);
+}
+
+bool CMOOSGeodesy::UTM2LatLongExact(double dfX, double dfY, double& dfLat, double& dfLong)
 {
     //written by Henrik Schmidt henrik@mit.edu
     
@@ -492,21 +542,27 @@ bool CMOOSGeodesy::UTM2LatLong(double dfX, double dfY, double& dfLat, double& df
     double dfx=dfX;
     double dfy=dfY;
     double eps = 1.0; // accuracy in m
+    int    iterations = 0;
     
     while (err > eps)
     {
         double dflat, dflon, dfnew_x, dfnew_y ;
 
+        //give up rather than loop forever if not converging
+        if(++iterations > 100)
+            return(false);
+
         // first guess geodesic
         if (!LocalGrid2LatLong(dfx,dfy,dflat,dflon))
             return(false);
         
-        // now convert latlong to UTM
-        if (!LatLong2LocalUTM(dflat,dflon,dfnew_y,dfnew_x))
-	  return(false);
+        // now convert latlong to local UTM
+        LLtoUTMNoZone(m_iRefEllipsoid,dflat,dflon,dfnew_y,dfnew_x);
+        dfnew_y -= GetOriginNorthing();
+        dfnew_x -= GetOriginEasting();
         
 	// fix to segfault issue if you get diverging values
-	if(isnan(dflat) || isnan(dflon))
+	if(isnan(dfnew_x) || isnan(dfnew_y))
 	  {
 	    dflat = 91;
 	    dflon = 181;
@@ -533,3 +589,407 @@ bool CMOOSGeodesy::UTM2LatLong(double dfX, double dfY, double& dfLat, double& df
     return true;
 }
 
+
+//////////////////////////////////////////////////////////////////////
+// Batch conversions
+//////////////////////////////////////////////////////////////////////
+
+/**
+ *Batch version of LatLong2LocalUTM(). Points are converted as with
+ *the single point call, including tangent plane mode, but without the
+ *per call overhead. GetMetersNorth()/GetMetersEast() afterwards refer
+ *to the last point.
+ *
+ *@param pLat, pLon arrays of n latitudes and longitudes
+ *@param pNorth, pEast arrays of n, filled in with the local grid position
+ *@return false if any array is NULL while n > 0
+ */
+
+bool CMOOSGeodesy::LatLong2LocalUTM(const double* pLat, const double* pLon,
+                                    double* pNorth, double* pEast,
+                                    unsigned int n)
+{
+    if(n == 0)
+        return true;
+    if(!pLat || !pLon || !pNorth || !pEast)
+        return false;
+
+    bool bTangent = m_bTangentPlaneMode && m_bTangentPlaneValid;
+    double dfOriginNorthing = GetOriginNorthing();
+    double dfOriginEasting  = GetOriginEasting();
+
+    for(unsigned int i=0; i<n; i++)
+    {
+        if(bTangent && LatLong2LocalTangent(pLat[i], pLon[i], pNorth[i], pEast[i]))
+            continue;
+
+        LLtoUTMNoZone(m_iRefEllipsoid, pLat[i], pLon[i], pNorth[i], pEast[i]);
+        pNorth[i] -= dfOriginNorthing;
+        pEast[i]  -= dfOriginEasting;
+    }
+
+    SetMetersNorth(pNorth[n-1]);
+    SetMetersEast(pEast[n-1]);
+    m_bSTEP_AFTER_INIT = false;
+
+    return true;
+}
+
+/**
+ *Batch version of LatLong2LocalGrid().
+ *
+ *@param pLat, pLon arrays of n latitudes and longitudes
+ *@param pNorth, pEast arrays of n, filled in with the local grid position
+ *@return false if any array is NULL while n > 0
+ */
+
+bool CMOOSGeodesy::LatLong2LocalGrid(const double* pLat, const double* pLon,
+                                     double* pNorth, double* pEast,
+                                     unsigned int n)
+{
+    if(n == 0)
+        return true;
+    if(!pLat || !pLon || !pNorth || !pEast)
+        return false;
+
+    //(semimajor axis)
+    double dfa  = 6378137;
+    // (semiminor axis)
+    double dfb = 6356752;
+    double dfb2a2 = pow(dfb,2)/pow(dfa,2);
+
+    double dfOriginLat = GetOriginLatitude();
+    double dfOriginLon = GetOriginLongitude();
+
+    for(unsigned int i=0; i<n; i++)
+    {
+        double dftanlat2 = pow(tan(pLat[i]*deg2rad),2);
+        double dfRadius = dfb*sqrt(1+dftanlat2) / sqrt(dfb2a2+dftanlat2);
+
+        double dXArcDeg  = (pLon[i] - dfOriginLon) * deg2rad;
+        pEast[i] = dfRadius * sin(dXArcDeg)*cos(pLat[i]*deg2rad);
+
+        double dYArcDeg  = (pLat[i] - dfOriginLat) * deg2rad;
+        pNorth[i] = dfRadius * sin(dYArcDeg);
+    }
+
+    SetLocalGridX(pEast[n-1]);
+    SetLocalGridY(pNorth[n-1]);
+
+    return true;
+}
+
+/**
+ *Batch version of LocalGrid2LatLong(). The terms depending only on
+ *the origin are computed once for all points.
+ *
+ *@param pEast, pNorth arrays of n local grid positions
+ *@param pLat, pLon arrays of n, filled in with the latitude and longitude
+ *@return false if any conversion fails (that point is set to 0,0 as
+ *        with the single point call), or any array is NULL while n > 0
+ */
+
+bool CMOOSGeodesy::LocalGrid2LatLong(const double* pEast, const double* pNorth,
+                                     double* pLat, double* pLon,
+                                     unsigned int n)
+{
+    if(n == 0)
+        return true;
+    if(!pEast || !pNorth || !pLat || !pLon)
+        return false;
+
+    //(semimajor axis)
+    double dfa  = 6378137;
+    // (semiminor axis)
+    double dfb = 6356752;
+
+    double dfOriginLat = GetOriginLatitude();
+    double dfOriginLon = GetOriginLongitude();
+
+    double dftanlat2 = pow( tan( dfOriginLat*deg2rad ), 2 );
+    double dfRadius = dfb*sqrt( 1+dftanlat2 ) / sqrt( ( pow(dfb,2)/pow(dfa,2) )+dftanlat2 );
+    double dfRadiusX = dfRadius*cos( dfOriginLat*deg2rad );
+
+    bool bOK = true;
+    for(unsigned int i=0; i<n; i++)
+    {
+        pLat[i] = asin( pNorth[i]/dfRadius ) * rad2deg + dfOriginLat;
+        pLon[i] = asin( pEast[i]/dfRadiusX ) * rad2deg + dfOriginLon;
+
+        if(isnan(pLat[i]) || isnan(pLon[i])) {
+            pLat[i] = 0;
+            pLon[i] = 0;
+            bOK = false;
+        }
+    }
+
+    return bOK;
+}
+
+/**
+ *Batch version of UTM2LatLong(), including tangent plane mode.
+ *
+ *@param pX, pY arrays of n local UTM grid positions
+ *@param pLat, pLon arrays of n, filled in with the latitude and longitude
+ *@return false if any conversion fails, or any array is NULL while n > 0
+ */
+
+bool CMOOSGeodesy::UTM2LatLong(const double* pX, const double* pY,
+                               double* pLat, double* pLon,
+                               unsigned int n)
+{
+    if(n == 0)
+        return true;
+    if(!pX || !pY || !pLat || !pLon)
+        return false;
+
+    bool bTangent = m_bTangentPlaneMode && m_bTangentPlaneValid;
+    bool bOK = true;
+
+    for(unsigned int i=0; i<n; i++)
+    {
+        if(bTangent && LocalTangent2LatLong(pX[i], pY[i], pLat[i], pLon[i]))
+            continue;
+        if(!UTM2LatLongExact(pX[i], pY[i], pLat[i], pLon[i]))
+            bOK = false;
+    }
+
+    return bOK;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// Local tangent plane approximation
+//////////////////////////////////////////////////////////////////////
+
+/**
+ *Turn tangent plane mode on or off. When on, LatLong2LocalUTM() and
+ *UTM2LatLong(), single and batch, use a second order expansion of the
+ *local UTM grid about the origin for points within dfMaxRange meters
+ *of the origin, and the full UTM conversion beyond. The expansion is
+ *fitted at Initialise(), and its worst error within range measured
+ *against the full conversion. If that exceeds dfMaxError meters, e.g.,
+ *for an origin on a UTM zone boundary, the mode is not engaged.
+ *A range or error of zero keeps the current value, initially 10000m
+ *and 0.1m.
+ *
+ *@return true if the mode is now as requested
+ */
+
+bool CMOOSGeodesy::SetTangentPlaneMode(bool bOn, double dfMaxRange, double dfMaxError)
+{
+    m_bTangentPlaneMode = bOn;
+    if(dfMaxRange > 0)
+        m_dfTangentRange = dfMaxRange;
+    if(dfMaxError > 0)
+        m_dfTangentMaxError = dfMaxError;
+
+    m_bTangentPlaneValid = InitTangentPlane();
+
+    return(!bOn || m_bTangentPlaneValid);
+}
+
+bool CMOOSGeodesy::GetTangentPlaneMode()
+{
+    return(m_bTangentPlaneMode && m_bTangentPlaneValid);
+}
+
+double CMOOSGeodesy::GetTangentPlaneRange()
+{
+    return m_dfTangentRange;
+}
+
+/**
+ *@return the worst position error in meters, against the full UTM
+ *        conversion, found within range of the origin at the last fit
+ */
+
+double CMOOSGeodesy::GetTangentPlaneErrorBound()
+{
+    return m_dfTangentError;
+}
+
+/**
+ *Evaluate the tangent plane expansion, no range check
+ *
+ *@param dLat, dLon offset in degrees from the origin
+ */
+
+void CMOOSGeodesy::LocalTangentUTM(double dLat, double dLon,
+                                   double &MetersNorth, double &MetersEast)
+{
+    double dLat2 = dLat*dLat;
+    double dLatLon = dLat*dLon;
+    double dLon2 = dLon*dLon;
+
+    MetersEast  = m_dfTangentE[0]*dLat + m_dfTangentE[1]*dLon
+        + m_dfTangentE[2]*dLat2 + m_dfTangentE[3]*dLatLon + m_dfTangentE[4]*dLon2;
+    MetersNorth = m_dfTangentN[0]*dLat + m_dfTangentN[1]*dLon
+        + m_dfTangentN[2]*dLat2 + m_dfTangentN[3]*dLatLon + m_dfTangentN[4]*dLon2;
+}
+
+/**
+ *Convert to the local UTM grid with the tangent plane expansion. Does
+ *not depend on tangent plane mode being on.
+ *
+ *@return false if the point is beyond the tangent plane range, in which
+ *        case the full conversion should be used
+ */
+
+bool CMOOSGeodesy::LatLong2LocalTangent(double lat, double lon,
+                                        double &MetersNorth, double &MetersEast)
+{
+    double dLat = lat - GetOriginLatitude();
+    double dLon = lon - GetOriginLongitude();
+    if(dLon >= 180)
+        dLon -= 360;
+    else if(dLon < -180)
+        dLon += 360;
+
+    double dfNorth, dfEast;
+    LocalTangentUTM(dLat, dLon, dfNorth, dfEast);
+    if(hypot(dfNorth, dfEast) > m_dfTangentRange)
+        return false;
+
+    MetersNorth = dfNorth;
+    MetersEast = dfEast;
+    return true;
+}
+
+/**
+ *Convert from the local UTM grid with the tangent plane expansion. The
+ *expansion is inverted by fixed point iteration on its linear part,
+ *which converges to well below a millimeter within a few steps.
+ *
+ *@return false if the point is beyond the tangent plane range
+ */
+
+bool CMOOSGeodesy::LocalTangent2LatLong(double dfEast, double dfNorth,
+                                        double &dfLat, double &dfLon)
+{
+    if(hypot(dfNorth, dfEast) > m_dfTangentRange)
+        return false;
+
+    double dLat = m_dfTangentInv[2]*dfEast + m_dfTangentInv[3]*dfNorth;
+    double dLon = m_dfTangentInv[0]*dfEast + m_dfTangentInv[1]*dfNorth;
+    for(int i=0; i<4; i++)
+    {
+        double dfN, dfE;
+        LocalTangentUTM(dLat, dLon, dfN, dfE);
+        double dfErrE = dfEast - dfE;
+        double dfErrN = dfNorth - dfN;
+        dLat += m_dfTangentInv[2]*dfErrE + m_dfTangentInv[3]*dfErrN;
+        dLon += m_dfTangentInv[0]*dfErrE + m_dfTangentInv[1]*dfErrN;
+    }
+
+    dfLat = GetOriginLatitude() + dLat;
+    dfLon = GetOriginLongitude() + dLon;
+    if(dfLon >= 180)
+        dfLon -= 360;
+    else if(dfLon < -180)
+        dfLon += 360;
+
+    return true;
+}
+
+/**
+ *Fit the tangent plane expansion about the origin by central
+ *differences of the full UTM conversion, then measure its error.
+ *
+ *@return true if the error within range is acceptable
+ */
+
+bool CMOOSGeodesy::InitTangentPlane()
+{
+    double dfOriginLat = GetOriginLatitude();
+    double dfOriginLon = GetOriginLongitude();
+    double dfOriginN, dfOriginE;
+    LLtoUTMNoZone(m_iRefEllipsoid, dfOriginLat, dfOriginLon, dfOriginN, dfOriginE);
+
+    //steps of about a quarter of the range, in degrees
+    double dfCosLat = cos(dfOriginLat*deg2rad);
+    if(dfCosLat < 0.01)
+        dfCosLat = 0.01;
+    double hLat = (m_dfTangentRange / 4) / 111000;
+    double hLon = hLat / dfCosLat;
+
+    double N[3][3], E[3][3];
+    for(int i=0; i<3; i++)
+    {
+        for(int j=0; j<3; j++)
+        {
+            double lat = dfOriginLat + (i-1)*hLat;
+            double lon = dfOriginLon + (j-1)*hLon;
+            LLtoUTMNoZone(m_iRefEllipsoid, lat, lon, N[i][j], E[i][j]);
+            N[i][j] -= dfOriginN;
+            E[i][j] -= dfOriginE;
+        }
+    }
+
+    double (*F[2])[3] = {E, N};
+    double *C[2] = {m_dfTangentE, m_dfTangentN};
+    for(int k=0; k<2; k++)
+    {
+        double (*f)[3] = F[k];
+        C[k][0] = (f[2][1] - f[0][1]) / (2*hLat);
+        C[k][1] = (f[1][2] - f[1][0]) / (2*hLon);
+        C[k][2] = (f[2][1] - 2*f[1][1] + f[0][1]) / (2*hLat*hLat);
+        C[k][3] = (f[2][2] - f[2][0] - f[0][2] + f[0][0]) / (4*hLat*hLon);
+        C[k][4] = (f[1][2] - 2*f[1][1] + f[1][0]) / (2*hLon*hLon);
+    }
+
+    //inverse of the linear part, (E,N) to (dLon,dLat)
+    double det = m_dfTangentE[1]*m_dfTangentN[0] - m_dfTangentE[0]*m_dfTangentN[1];
+    if(fabs(det) < 1e-9)
+    {
+        m_dfTangentError = 1e20;
+        return false;
+    }
+    m_dfTangentInv[0] =  m_dfTangentN[0] / det;
+    m_dfTangentInv[1] = -m_dfTangentE[0] / det;
+    m_dfTangentInv[2] = -m_dfTangentN[1] / det;
+    m_dfTangentInv[3] =  m_dfTangentE[1] / det;
+
+    //the error grows with range, so sampling the outer ring and one
+    //inside it finds the worst case
+    m_dfTangentError = TangentPlaneError(m_dfTangentRange * 0.999, dfOriginN, dfOriginE);
+    double dfInnerError = TangentPlaneError(m_dfTangentRange * 0.5, dfOriginN, dfOriginE);
+    if(dfInnerError > m_dfTangentError)
+        m_dfTangentError = dfInnerError;
+
+    return(m_dfTangentError <= m_dfTangentMaxError);
+}
+
+/**
+ *Each sample point is found with the tangent plane inverse, and then
+ *converted with the full UTM series. Since the inverse is exact to
+ *the expansion, the distance back to the sample point is the forward
+ *error there, and also the inverse error.
+ *
+ *@return the worst error on a ring of the given range about the origin
+ */
+
+double CMOOSGeodesy::TangentPlaneError(double dfRange, double dfOriginN, double dfOriginE)
+{
+    double dfWorst = 0;
+    for(int i=0; i<72; i++)
+    {
+        double dfAngle = i * 5 * deg2rad;
+        double dfEast  = dfRange * sin(dfAngle);
+        double dfNorth = dfRange * cos(dfAngle);
+
+        double dfLat, dfLon;
+        if(!LocalTangent2LatLong(dfEast, dfNorth, dfLat, dfLon))
+            return 1e20;
+
+        double dfExactN, dfExactE;
+        LLtoUTMNoZone(m_iRefEllipsoid, dfLat, dfLon, dfExactN, dfExactE);
+        dfExactN -= dfOriginN;
+        dfExactE -= dfOriginE;
+
+        double dfError = hypot(dfExactN - dfNorth, dfExactE - dfEast);
+        if(!(dfError <= dfWorst))
+            dfWorst = dfError;
+    }
+    return dfWorst;
+}
@@ -70,6 +70,20 @@ public:
     double 	GetOriginLongitude();
     bool 	Initialise(double lat, double lon);
 
+    //batch versions of the single point conversions, over arrays of n points
+    bool 	LatLong2LocalUTM(const double* pLat, const double* pLon, double* pNorth, double* pEast, unsigned int n);
+    bool 	LatLong2LocalGrid(const double* pLat, const double* pLon, double* pNorth, double* pEast, unsigned int n);
+    bool 	LocalGrid2LatLong(const double* pEast, const double* pNorth, double* pLat, double* pLon, unsigned int n);
+    bool 	UTM2LatLong(const double* pX, const double* pY, double* pLat, double* pLon, unsigned int n);
+
+    //local tangent plane approximation of the local UTM grid
+    bool 	SetTangentPlaneMode(bool bOn, double dfMaxRange=0, double dfMaxError=0);
+    bool 	GetTangentPlaneMode();
+    double 	GetTangentPlaneRange();
+    double 	GetTangentPlaneErrorBound();
+    bool 	LatLong2LocalTangent(double lat, double lon, double & MetersNorth, double & MetersEast);
+    bool 	LocalTangent2LatLong(double dfEast, double dfNorth, double &dfLat, double &dfLon);
+
 private:
     bool m_bSTEP_AFTER_INIT;
     char m_sUTMZone[4];
@@ -83,12 +97,28 @@ private:
     double m_dLocalGridX;
     double m_dLocalGridY;
 
+    //tangent plane mode: second order expansion of the local UTM
+    //grid about the origin, in degrees from the origin
+    bool   m_bTangentPlaneMode;
+    bool   m_bTangentPlaneValid;
+    double m_dfTangentRange;
+    double m_dfTangentMaxError;
+    double m_dfTangentError;
+    double m_dfTangentE[5];
+    double m_dfTangentN[5];
+    double m_dfTangentInv[4];
+
     void SetUTMZone(const char * utmZone);
     void SetRefEllipsoid(int refEllipsoid);
     void SetOriginEasting(double East);
 
     void SetOriginNorthing(double North);
     bool LLtoUTM(int ReferenceEllipsoid, const double Lat, const double Long, double &UTMNorthing, double &UTMEasting, char* UTMZone);
+    int  LLtoUTMNoZone(int ReferenceEllipsoid, const double Lat, const double Long, double &UTMNorthing, double &UTMEasting);
+    void LocalTangentUTM(double dLat, double dLon, double &MetersNorth, double &MetersEast);
+    bool UTM2LatLongExact(double dfX, double dfY, double& dfLat, double& dfLong);
+    bool InitTangentPlane();
+    double TangentPlaneError(double dfRange, double dfOriginN, double dfOriginE);
     void SetMetersEast(double East);
     void SetMetersNorth(double North);
     char UTMLetterDesignator(double Lat);
@@ -40,6 +40,7 @@ HelmReporter::HelmReporter()
   m_report_life_events  = false;
   m_report_mode_changes = false;
   m_report_bhv_changes  = false;
+  m_report_profiles     = false;
 
   m_use_color = true;
   m_var_trunc = true;
@@ -103,6 +104,10 @@ bool HelmReporter::handle(const string& alogfile)
 	string tstamp = getTimeStamp(line_raw);
 	handleNewHelmSummary(data, tstamp);
       }
+      if(m_report_profiles && (varname == "IVPHELM_PROFILE")) {
+	string tstamp = getTimeStamp(line_raw);
+	handleNewHelmProfile(data, tstamp);
+      }
       if((m_report_mode_changes || m_report_bhv_changes) && 
 	 (varname == "IVPHELM_MODESET")) {
 	m_mode_var = biteString(data, '#');
@@ -135,6 +140,25 @@ bool HelmReporter::handle(const string& alogfile)
   return(true);
 }
 
+//--------------------------------------------------------
+// Procedure: handleNewHelmProfile()
+//   Example: iter=480,win=100 # stage=total,n=100,p50=1.21,p90=2.05,
+//            max=3.3 # bhv=avd_henry,n=100,p50=0.43,p90=0.61,
+//            max=0.9,pcs=120
+
+void HelmReporter::handleNewHelmProfile(string profile, string tstamp)
+{
+  vector<string> svector = parseString(profile, '#');
+  if(svector.size() == 0)
+    return;
+
+  cout << "====================================================" << endl;
+  cout << tstamp << " Profile: " << stripBlankEnds(svector[0]);
+  cout << "  (times in ms)" << endl;
+  for(unsigned int i=1; i<svector.size(); i++)
+    cout << "    " << stripBlankEnds(svector[i]) << endl;
+}
+
 //--------------------------------------------------------
 // Procedure: handleNewHelmSummary()
 
@@ -42,6 +42,7 @@ class HelmReporter
   void reportLifeEvents(bool v=true)      {m_report_life_events=v;}
   void reportBehaviorChanges(bool v=true) {m_report_bhv_changes=v;}
   void reportModeChanges(bool v=true)     {m_report_mode_changes=v;}
+  void reportProfiles(bool v=true)        {m_report_profiles=v;}
   void setWatchBehavior(std::string s)    {m_watch_behavior=s;}
   void setUseColor(bool v=true)           {m_use_color=v;}
   void setColorActive(bool v)             {m_life_events.setColorActive(v);}
@@ -51,6 +52,7 @@ class HelmReporter
   
  protected: // Utility Functions
   void handleNewHelmSummary(std::string, std::string);
+  void handleNewHelmProfile(std::string, std::string);
 
  protected: // State Variables
   LifeEventHistory m_life_events;
@@ -66,6 +68,7 @@ class HelmReporter
   bool             m_report_life_events;
   bool             m_report_mode_changes;
   bool             m_report_bhv_changes;
+  bool             m_report_profiles;
   bool             m_use_color;
   bool             m_var_trunc;
 
@@ -59,6 +59,7 @@ int main(int argc, char *argv[])
     cout << "  -l,--life     Show report on IvP Helm Life Events        " << endl;
     cout << "  -b,--bhvs     Show helm behavior state changes           " << endl;
     cout << "  -m,--modes    Show helm mode changes                     " << endl;
+    cout << "  -p,--profile  Show helm stage/behavior timing profiles   " << endl;
     cout << "  --watch=bhv   Watch a particular behavior for state change" << endl;
     cout << "  --nocolor     Turn off use of color coding               " << endl;
     cout << "  --notrunc     Don't truncate MOOSVAR output (on by default)" << endl;
@@ -84,6 +85,7 @@ int main(int argc, char *argv[])
   bool report_bhv_changes  = false;
   bool report_life_events  = false;
   bool report_mode_changes = false;
+  bool report_profiles     = false;
 
   bool use_colors = true;
   bool var_trunc  = true;
@@ -96,6 +98,8 @@ int main(int argc, char *argv[])
       report_mode_changes = true;
     else if((argi == "-l") || (argi == "--life"))
       report_life_events = true;
+    else if((argi == "-p") || (argi == "--profile"))
+      report_profiles = true;
     else if((argi == "-l") || (argi == "--notrunc"))
       var_trunc = false;
     else if(strBegins(argi, "--watch="))
@@ -120,6 +124,8 @@ int main(int argc, char *argv[])
     hreporter.reportModeChanges();
   if(report_bhv_changes)
     hreporter.reportBehaviorChanges();
+  if(report_profiles)
+    hreporter.reportProfiles();
   if(watch_behavior != "")
     hreporter.setWatchBehavior(watch_behavior);
 
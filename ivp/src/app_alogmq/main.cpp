@@ -0,0 +1,115 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include "MBUtils.h"
+#include "ReleaseInfo.h"
+#include "ALogQueryEngine.h"
+
+using namespace std;
+
+void showHelpAndExit();
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{
+  ALogQueryEngine engine;
+
+  for(int i=1; i<argc; i++) {
+    bool handled = true;
+    string argi = argv[i];
+    if((argi=="-h") || (argi == "--help") || (argi=="-help"))
+      showHelpAndExit();
+    else if((argi=="-v") || (argi=="--version") || (argi=="-version")) {
+      showReleaseInfo("alogmq", "gpl");
+      return(0);
+    }
+    else if((argi == "-f") || (argi == "--force"))
+      engine.setFileOverWrite(true);
+    else if(argi == "--verbose")
+      engine.setVerbose(true);
+    else if(strBegins(argi, "--query="))
+      handled = engine.addQuery(argi.substr(8));
+    else if(strBegins(argi, "--qfile="))
+      handled = engine.addQueryFile(argi.substr(8));
+    else if(strEnds(argi, ".alog"))
+      handled = engine.setALogFile(argi);
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Unhandled command line argument: " << argi << endl;
+      cout << "Use --help for usage. Exiting.   " << endl;
+      exit(1);
+    }
+  }
+
+  bool ok = engine.handle();
+  if(ok)
+    return(0);
+  else
+    return(1);
+}
+
+//------------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{
+  cout << "Usage: " << endl;
+  cout << "  alogmq in.alog [OPTIONS]                                 " << endl;
+  cout << "                                                           " << endl;
+  cout << "Synopsis:                                                  " << endl;
+  cout << "  Serve several extraction queries from one pass over an   " << endl;
+  cout << "  alog file. Each query writes to its own output file.     " << endl;
+  cout << "  Useful for scripts that would otherwise invoke aloggrep, " << endl;
+  cout << "  alogpick, alogavg etc. many times on the same log.       " << endl;
+  cout << "                                                           " << endl;
+  cout << "Query Types:                                               " << endl;
+  cout << "  type=grep, keys=NAV_X:NAV_Y:pHelm*, file=nav.alog        " << endl;
+  cout << "    Raw alog lines matching any key (var or source).       " << endl;
+  cout << "    A key ending in * is a partial match, as in aloggrep.  " << endl;
+  cout << "  type=pick, var=NODE_REPORT, fields=X:Y:SPD, file=pos.txt " << endl;
+  cout << "    Lines of: time X Y SPD. A missing field is shown as -. " << endl;
+  cout << "  type=binavg, var=NAV_SPEED, bin=10, file=spd.txt         " << endl;
+  cout << "    Lines of: bin_center avg min max count. An optional    " << endl;
+  cout << "    fields=SPD picks the value from a param=value posting. " << endl;
+  cout << "                                                           " << endl;
+  cout << "Options:                                                   " << endl;
+  cout << "  -h,--help         Displays this help message             " << endl;
+  cout << "  -v,--version      Displays the current release version   " << endl;
+  cout << "  -f,--force        Overwrite existing output files        " << endl;
+  cout << "  --verbose         Report lines written per query         " << endl;
+  cout << "  --query=<spec>    Add a query, e.g., as above            " << endl;
+  cout << "  --qfile=<file>    Add queries from file, one per line    " << endl;
+  cout << "                                                           " << endl;
+  cout << "Example:                                                   " << endl;
+  cout << "  $ alogmq abe.alog --query=type=grep,keys=NAV_*,file=n.alog" << endl;
+  cout << "      --query=type=binavg,var=NAV_SPEED,bin=5,file=s.txt   " << endl;
+  cout << endl;
+  exit(0);
+}
@@ -607,6 +607,7 @@ void NavPlotViewer::drawVPlugPlot(unsigned int index)
 
   vector<XYPolygon>    polys   = geo_shapes.getPolygons();
   vector<XYGrid>       grids   = geo_shapes.getGrids();
+  vector<XYConvexGrid> cgrids  = geo_shapes.getConvexGrids();
   vector<XYRangePulse> rpulses = geo_shapes.getRangePulses();
   vector<XYCommsPulse> cpulses = geo_shapes.getCommsPulses();
   const map<string, XYSegList>&  segls = geo_shapes.getSegLists();
@@ -630,6 +631,7 @@ void NavPlotViewer::drawVPlugPlot(unsigned int index)
   drawSeglrs(seglrs);
 
   drawGrids(grids);
+  drawConvexGrids(cgrids);
 }
 
 //-------------------------------------------------------------
@@ -0,0 +1,355 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <iostream>
+#include "MBUtils.h"
+#include "XYVector.h"
+#include "CurrentField.h"
+#include "CurrentGrid.h"
+
+using namespace std;
+
+void showHelpAndExit();
+
+//--------------------------------------------------------
+// Procedure: axisIndex()
+//   Purpose: Map each of the sorted unique values to its index on a
+//            regular axis. False if the values are not evenly spaced.
+
+bool axisIndex(const map<double, unsigned int>& vals, double& v0,
+	       double& step, map<double, unsigned int>& index)
+{
+  if(vals.size() < 2)
+    return(false);
+  v0 = vals.begin()->first;
+  double v1 = vals.rbegin()->first;
+  step = (v1 - v0) / (vals.size() - 1);
+
+  unsigned int ix = 0;
+  map<double, unsigned int>::const_iterator p;
+  for(p=vals.begin(); p!=vals.end(); p++, ix++) {
+    if(fabs(p->first - (v0 + (ix * step))) > (step * 0.001))
+      return(false);
+    index[p->first] = ix;
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: readCSV()
+//   Purpose: Build a grid from lines of time,x,y,u,v. The x and y
+//            values must form a regular grid. Nodes absent from a
+//            frame, or given as nan, are marked missing.
+
+bool readCSV(string filename, CurrentGrid& grid)
+{
+  ifstream ifs(filename.c_str());
+  if(!ifs)
+    return(false);
+
+  vector<double> rows;
+  map<double, unsigned int> xvals, yvals, tvals;
+  string line;
+  while(getline(ifs, line)) {
+    if((line.size() == 0) || (line[0] == '#') || strBegins(line, "//"))
+      continue;
+    const char *c = line.c_str();
+    char *end = 0;
+    double vals[5];
+    unsigned int k = 0;
+    for(k=0; k<5; k++) {
+      vals[k] = strtod(c, &end);
+      if(end == c)
+	break;
+      c = end;
+      while((*c == ',') || (*c == ' ') || (*c == '\t'))
+	c++;
+    }
+    if(k < 5)
+      continue;  // Header or malformed line
+    rows.insert(rows.end(), vals, vals+5);
+    tvals[vals[0]] = 0;
+    xvals[vals[1]] = 0;
+    yvals[vals[2]] = 0;
+  }
+
+  double x0, y0, dx, dy;
+  map<double, unsigned int> xindex, yindex;
+  if(!axisIndex(xvals, x0, dx, xindex) || !axisIndex(yvals, y0, dy, yindex)) {
+    cout << "x,y positions do not form a regular grid" << endl;
+    return(false);
+  }
+  unsigned int nx = xindex.size();
+  unsigned int ny = yindex.size();
+  if(!grid.initialize(x0, y0, dx, dy, nx, ny))
+    return(false);
+
+  unsigned int ix = 0;
+  map<double, unsigned int>::iterator p;
+  for(p=tvals.begin(); p!=tvals.end(); p++, ix++)
+    p->second = ix;
+
+  unsigned int nodes = nx * ny;
+  vector<vector<float> > us(tvals.size(), vector<float>(nodes, NAN));
+  vector<vector<float> > vs(tvals.size(), vector<float>(nodes, NAN));
+  for(size_t r=0; r<rows.size(); r+=5) {
+    unsigned int t = tvals[rows[r]];
+    unsigned int node = xindex[rows[r+1]] + (yindex[rows[r+2]] * nx);
+    us[t][node] = (float)(rows[r+3]);
+    vs[t][node] = (float)(rows[r+4]);
+  }
+
+  for(p=tvals.begin(); p!=tvals.end(); p++) {
+    if(!grid.addFrame(p->first, us[p->second], vs[p->second]))
+      return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: sampleField()
+//   Purpose: Sample a vector based CurrentField on a grid of the
+//            given cell size, covering all vectors plus one radius.
+
+bool sampleField(CurrentField& field, double cell, CurrentGrid& grid)
+{
+  vector<XYVector> vectors = field.getVectors();
+  if((vectors.size() == 0) || (cell <= 0))
+    return(false);
+
+  double radius = field.getRadius();
+  double xmin = vectors[0].xpos();
+  double xmax = xmin;
+  double ymin = vectors[0].ypos();
+  double ymax = ymin;
+  for(unsigned int i=1; i<vectors.size(); i++) {
+    xmin = min(xmin, vectors[i].xpos());
+    xmax = max(xmax, vectors[i].xpos());
+    ymin = min(ymin, vectors[i].ypos());
+    ymax = max(ymax, vectors[i].ypos());
+  }
+  xmin -= radius;
+  ymin -= radius;
+  xmax += radius;
+  ymax += radius;
+
+  unsigned int nx = (unsigned int)(ceil((xmax - xmin) / cell)) + 1;
+  unsigned int ny = (unsigned int)(ceil((ymax - ymin) / cell)) + 1;
+  if(!grid.initialize(xmin, ymin, cell, cell, nx, ny))
+    return(false);
+
+  if(!field.indexed())
+    field.buildIndex();
+
+  vector<float> u(nx * ny);
+  vector<float> v(nx * ny);
+  for(unsigned int iy=0; iy<ny; iy++) {
+    for(unsigned int ix=0; ix<nx; ix++) {
+      double fx, fy;
+      field.getLocalForce(xmin + (ix * cell), ymin + (iy * cell), fx, fy);
+      u[ix + (iy * nx)] = (float)(fx);
+      v[ix + (iy * nx)] = (float)(fy);
+    }
+  }
+  return(grid.addFrame(0, u, v));
+}
+
+//--------------------------------------------------------
+// Procedure: nsPerLookup()
+
+double nsPerLookup(clock_t start, unsigned int n)
+{
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+  return((secs * 1e9) / n);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{ 
+  string in_file;
+  string out_file;
+  double cell = 0;
+  bool   bench = false;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i]; 
+    bool handled = true;
+    if((argi == "-h") || (argi == "--help"))
+      showHelpAndExit();
+    else if(strBegins(argi, "--out="))
+      out_file = argi.substr(6);
+    else if(strBegins(argi, "--cell="))
+      handled = setPosDoubleOnString(cell, argi.substr(7));
+    else if(argi == "--bench")
+      bench = true;
+    else if(!strBegins(argi, "-") && (in_file == ""))
+      in_file = argi;
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Bad Arg:[" << argi << "]. Exiting." << endl;
+      exit(1);
+    }    
+  }
+  if(in_file == "") {
+    cout << "No input file given. Exiting." << endl;
+    exit(1);
+  }
+
+  // The input is a binary grid, a CSV grid, or a vector field
+  CurrentGrid  grid;
+  CurrentField field;
+  bool field_set = false;
+
+  clock_t start = clock();
+  if(grid.readBinary(in_file))
+    cout << "Read binary grid: " << in_file << endl;
+  else if(strEnds(in_file, ".csv")) {
+    if(!readCSV(in_file, grid)) {
+      cout << "Unable to read grid from: " << in_file << endl;
+      exit(1);
+    }
+  }
+  else {
+    if(!field.populate(in_file) || (field.size() == 0)) {
+      cout << "Unable to read current field: " << in_file << endl;
+      exit(1);
+    }
+    field_set = true;
+    if(cell <= 0)
+      cell = field.getRadius() / 4;
+    if(!sampleField(field, cell, grid)) {
+      cout << "Unable to sample current field" << endl;
+      exit(1);
+    }
+  }
+  double load_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  cout << "Grid: " << grid.getSummary() << endl;
+  cout << "Load time: " << doubleToString(load_secs, 4) << " secs" << endl;
+
+  if(out_file != "") {
+    if(!grid.writeBinary(out_file)) {
+      cout << "Unable to write: " << out_file << endl;
+      exit(1);
+    }
+    cout << "Wrote binary grid: " << out_file << endl;
+  }
+
+  if(!bench)
+    return(0);
+
+  //===================================================================
+  // Lookup timing at random points over the grid and frame times
+  //===================================================================
+  unsigned int n = 200000;
+  vector<double> xs(n), ys(n), ts(n);
+  double xlen = grid.getDX() * (grid.getNX()-1);
+  double ylen = grid.getDY() * (grid.getNY()-1);
+  double t0 = grid.getFrameTime(0);
+  double t1 = grid.getFrameTime(grid.frames()-1);
+  for(unsigned int i=0; i<n; i++) {
+    xs[i] = grid.getX0() + (xlen * rand() / RAND_MAX);
+    ys[i] = grid.getY0() + (ylen * rand() / RAND_MAX);
+    ts[i] = t0 + ((t1 - t0) * rand() / RAND_MAX);
+  }
+
+  double fx, fy, sum = 0;
+  start = clock();
+  for(unsigned int i=0; i<n; i++) {
+    grid.getLocalForce(xs[i], ys[i], ts[i], fx, fy);
+    sum += fx;
+  }
+  cout << "Grid lookup: " << doubleToString(nsPerLookup(start, n), 1);
+  cout << " ns" << endl;
+
+  if(field_set) {
+    start = clock();
+    for(unsigned int i=0; i<n; i++) {
+      field.getLocalForce(xs[i], ys[i], fx, fy);
+      sum += fx;
+    }
+    cout << "Field lookup (indexed): ";
+    cout << doubleToString(nsPerLookup(start, n), 1) << " ns" << endl;
+
+    // Any change to the field drops its index
+    CurrentField linear = field;
+    linear.setRadius(field.getRadius());
+    unsigned int m = n / 10;
+    start = clock();
+    for(unsigned int i=0; i<m; i++) {
+      linear.getLocalForce(xs[i], ys[i], fx, fy);
+      sum += fx;
+    }
+    cout << "Field lookup (full search): ";
+    cout << doubleToString(nsPerLookup(start, m), 1) << " ns" << endl;
+  }
+  if(sum == 12345.6789)
+    cout << endl;
+
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{ 
+  cout << "Usage:                                              " << endl;
+  cout << "  cgrid file [OPTIONS]                              " << endl;
+  cout << "                                                    " << endl;
+  cout << "Synopsis:                                           " << endl;
+  cout << "  Build a gridded current field and save it in the  " << endl;
+  cout << "  binary form read by CurrentGrid, e.g. by the      " << endl;
+  cout << "  uSimMarineV22 current_grid parameter. The input   " << endl;
+  cout << "  is one of:                                        " << endl;
+  cout << "    - a binary grid, summarized or re-written       " << endl;
+  cout << "    - a .csv file of time,x,y,u,v lines, with x,y   " << endl;
+  cout << "      on a regular grid (nan marks missing nodes)   " << endl;
+  cout << "    - a CurrentField vector file, sampled on a grid " << endl;
+  cout << "                                                    " << endl;
+  cout << "Options:                                            " << endl;
+  cout << "  --help, -h                                        " << endl;
+  cout << "    Display this help message                       " << endl;
+  cout << "  --out=<file>                                      " << endl;
+  cout << "    Write the grid in binary form to the file       " << endl;
+  cout << "  --cell=<m>      (default radius/4)                " << endl;
+  cout << "    Cell size when sampling a CurrentField          " << endl;
+  cout << "  --bench                                           " << endl;
+  cout << "    Report the time per current lookup             " << endl;
+  cout << "                                                    " << endl;
+  cout << "Example:                                            " << endl;
+  cout << "  cgrid model.csv --out=model.cgrid                 " << endl;
+
+  exit(0);
+}
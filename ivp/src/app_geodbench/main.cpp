@@ -0,0 +1,320 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <iostream>
+#include "MBUtils.h"
+#include "MOOS/libMOOSGeodesy/MOOSGeodesy.h"
+
+using namespace std;
+
+void showHelpAndExit();
+
+//--------------------------------------------------------
+// Procedure: randPoints()
+//   Purpose: Random lat/lon points uniform over a disk of the given
+//            radius about the origin, with their exact local UTM
+//            positions.
+
+void randPoints(CMOOSGeodesy& geodesy, double radius, unsigned int n,
+		vector<double>& lat, vector<double>& lon,
+		vector<double>& north, vector<double>& east)
+{
+  double olat = geodesy.GetOriginLatitude();
+  double olon = geodesy.GetOriginLongitude();
+  double mlat = 111000;
+  double mlon = 111000 * cos(olat * M_PI / 180);
+
+  lat.resize(n);
+  lon.resize(n);
+  for(unsigned int i=0; i<n; i++) {
+    double r = radius * sqrt((double)(rand()) / RAND_MAX);
+    double a = 2 * M_PI * (double)(rand()) / RAND_MAX;
+    lat[i] = olat + (r * cos(a)) / mlat;
+    lon[i] = olon + (r * sin(a)) / mlon;
+  }
+
+  bool mode = geodesy.GetTangentPlaneMode();
+  geodesy.SetTangentPlaneMode(false);
+  north.resize(n);
+  east.resize(n);
+  geodesy.LatLong2LocalUTM(&lat[0], &lon[0], &north[0], &east[0], n);
+  if(mode)
+    geodesy.SetTangentPlaneMode(true);
+}
+
+//--------------------------------------------------------
+// Procedure: invError()
+//   Purpose: Error in meters of computed lat/lon positions, measured
+//            by mapping them back with the exact forward conversion.
+
+void invError(CMOOSGeodesy& geodesy, const vector<double>& lat,
+	      const vector<double>& lon, const vector<double>& north,
+	      const vector<double>& east, double& max_err, double& avg_err)
+{
+  unsigned int n = lat.size();
+  vector<double> n2(n), e2(n);
+  bool mode = geodesy.GetTangentPlaneMode();
+  geodesy.SetTangentPlaneMode(false);
+  geodesy.LatLong2LocalUTM(&lat[0], &lon[0], &n2[0], &e2[0], n);
+  if(mode)
+    geodesy.SetTangentPlaneMode(true);
+
+  max_err = 0;
+  avg_err = 0;
+  for(unsigned int i=0; i<n; i++) {
+    double err = hypot(n2[i]-north[i], e2[i]-east[i]);
+    if(err > max_err)
+      max_err = err;
+    avg_err += err;
+  }
+  if(n > 0)
+    avg_err /= n;
+}
+
+//--------------------------------------------------------
+// Procedure: nsPerPoint()
+
+double nsPerPoint(clock_t start, unsigned int n)
+{
+  double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+  return((secs * 1e9) / n);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{ 
+  double olat   = 42.358436;
+  double olon   = -71.087448;
+  double range  = 10000;
+  double maxerr = 0.1;
+  unsigned int points = 200000;
+  unsigned int seed = 1;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i]; 
+    bool handled = true;
+    if((argi == "-h") || (argi == "--help"))
+      showHelpAndExit();
+    else if(strBegins(argi, "--lat="))
+      handled = setDoubleOnString(olat, argi.substr(6));
+    else if(strBegins(argi, "--lon="))
+      handled = setDoubleOnString(olon, argi.substr(6));
+    else if(strBegins(argi, "--range="))
+      handled = setPosDoubleOnString(range, argi.substr(8));
+    else if(strBegins(argi, "--maxerr="))
+      handled = setPosDoubleOnString(maxerr, argi.substr(9));
+    else if(strBegins(argi, "--points="))
+      handled = setUIntOnString(points, argi.substr(9));
+    else if(strBegins(argi, "--seed="))
+      handled = setUIntOnString(seed, argi.substr(7));
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Bad Arg:[" << argi << "]. Exiting." << endl;
+      exit(1);
+    }    
+  }
+  if(points == 0)
+    points = 1;
+  srand(seed);
+
+  CMOOSGeodesy geodesy;
+  geodesy.Initialise(olat, olon);
+  bool tangent_ok = geodesy.SetTangentPlaneMode(true, range, maxerr);
+  geodesy.SetTangentPlaneMode(false, range, maxerr);
+
+  cout << "Origin: lat=" << doubleToStringX(olat, 6);
+  cout << ", lon=" << doubleToStringX(olon, 6);
+  cout << ", zone=" << geodesy.GetUTMZone() << endl;
+  cout << "Tangent plane: range=" << doubleToStringX(range) << "m";
+  cout << ", error bound=" << doubleToStringX(geodesy.GetTangentPlaneErrorBound(), 6);
+  cout << "m, usable=" << boolToString(tangent_ok) << endl << endl;
+
+  //===================================================================
+  // Part 1: Accuracy against the full UTM series, over disks of
+  // increasing radius. Inverse conversions are checked by mapping the
+  // result back through the full forward conversion.
+  //===================================================================
+  cout << "Accuracy (meters, max/avg over " << points << " points)" << endl;
+  cout << "  radius   tangent fwd        tangent inv        UTM2LatLong" << endl;
+  double radii[] = {0.1, 0.2, 0.5, 1.0};
+  for(unsigned int r=0; r<4; r++) {
+    double radius = range * radii[r];
+    vector<double> lat, lon, north, east;
+    randPoints(geodesy, radius, points, lat, lon, north, east);
+
+    double fmax = 0;
+    double favg = 0;
+    for(unsigned int i=0; i<points; i++) {
+      // Beyond range, tangent plane mode uses the full conversion
+      double tn = north[i];
+      double te = east[i];
+      geodesy.LatLong2LocalTangent(lat[i], lon[i], tn, te);
+      double err = hypot(tn-north[i], te-east[i]);
+      if(err > fmax)
+	fmax = err;
+      favg += err;
+    }
+    favg /= points;
+
+    vector<double> ilat(lat), ilon(lon);
+    for(unsigned int i=0; i<points; i++)
+      geodesy.LocalTangent2LatLong(east[i], north[i], ilat[i], ilon[i]);
+    double tmax, tavg;
+    invError(geodesy, ilat, ilon, north, east, tmax, tavg);
+
+    geodesy.UTM2LatLong(&east[0], &north[0], &ilat[0], &ilon[0], points);
+    double umax, uavg;
+    invError(geodesy, ilat, ilon, north, east, umax, uavg);
+
+    cout << "  " << padString(doubleToStringX(radius,0), 6, true);
+    cout << "   " << padString(doubleToString(fmax,4) + "/" + doubleToString(favg,4), 17, false);
+    cout << "  " << padString(doubleToString(tmax,4) + "/" + doubleToString(tavg,4), 17, false);
+    cout << "  " << doubleToString(umax,4) + "/" + doubleToString(uavg,4) << endl;
+  }
+
+  //===================================================================
+  // Part 2: Batch results are the same as single point results
+  //===================================================================
+  vector<double> lat, lon, north, east;
+  randPoints(geodesy, range, points, lat, lon, north, east);
+  vector<double> bn(points), be(points), blat(points), blon(points);
+
+  double fwd_diff = 0;
+  for(unsigned int i=0; i<points; i++) {
+    double sn, se;
+    geodesy.LatLong2LocalUTM(lat[i], lon[i], sn, se);
+    fwd_diff = max(fwd_diff, hypot(sn-north[i], se-east[i]));
+  }
+  double grid_diff = 0;
+  geodesy.LocalGrid2LatLong(&east[0], &north[0], &blat[0], &blon[0], points);
+  for(unsigned int i=0; i<points; i++) {
+    double slat, slon;
+    geodesy.LocalGrid2LatLong(east[i], north[i], slat, slon);
+    grid_diff = max(grid_diff, max(fabs(slat-blat[i]), fabs(slon-blon[i])));
+  }
+  cout << endl << "Batch vs single: UTM fwd max diff=" << fwd_diff;
+  cout << "m, LocalGrid2LatLong max diff=" << grid_diff << "deg" << endl;
+
+  //===================================================================
+  // Part 3: Timing, nanoseconds per point
+  //===================================================================
+  cout << endl << "Timing (ns per point, " << points << " points)" << endl;
+  clock_t start;
+  double sn, se, slat, slon;
+
+  start = clock();
+  for(unsigned int i=0; i<points; i++)
+    geodesy.LatLong2LocalUTM(lat[i], lon[i], sn, se);
+  double t_fwd_single = nsPerPoint(start, points);
+
+  start = clock();
+  geodesy.LatLong2LocalUTM(&lat[0], &lon[0], &bn[0], &be[0], points);
+  double t_fwd_batch = nsPerPoint(start, points);
+
+  start = clock();
+  for(unsigned int i=0; i<points; i++)
+    geodesy.UTM2LatLong(east[i], north[i], slat, slon);
+  double t_inv_single = nsPerPoint(start, points);
+
+  start = clock();
+  geodesy.UTM2LatLong(&east[0], &north[0], &blat[0], &blon[0], points);
+  double t_inv_batch = nsPerPoint(start, points);
+
+  start = clock();
+  for(unsigned int i=0; i<points; i++)
+    geodesy.LocalGrid2LatLong(east[i], north[i], slat, slon);
+  double t_grid_single = nsPerPoint(start, points);
+
+  start = clock();
+  geodesy.LocalGrid2LatLong(&east[0], &north[0], &blat[0], &blon[0], points);
+  double t_grid_batch = nsPerPoint(start, points);
+
+  double t_fwd_tangent = 0;
+  double t_inv_tangent = 0;
+  if(tangent_ok) {
+    geodesy.SetTangentPlaneMode(true, range, maxerr);
+    start = clock();
+    geodesy.LatLong2LocalUTM(&lat[0], &lon[0], &bn[0], &be[0], points);
+    t_fwd_tangent = nsPerPoint(start, points);
+
+    start = clock();
+    geodesy.UTM2LatLong(&east[0], &north[0], &blat[0], &blon[0], points);
+    t_inv_tangent = nsPerPoint(start, points);
+    geodesy.SetTangentPlaneMode(false, range, maxerr);
+  }
+
+  cout << "                     single    batch  tangent batch" << endl;
+  cout << "  LatLong2LocalUTM " << padString(doubleToString(t_fwd_single,0), 8);
+  cout << " " << padString(doubleToString(t_fwd_batch,0), 8);
+  cout << " " << padString(doubleToString(t_fwd_tangent,0), 14) << endl;
+  cout << "  UTM2LatLong      " << padString(doubleToString(t_inv_single,0), 8);
+  cout << " " << padString(doubleToString(t_inv_batch,0), 8);
+  cout << " " << padString(doubleToString(t_inv_tangent,0), 14) << endl;
+  cout << "  LocalGrid2LatLong" << padString(doubleToString(t_grid_single,0), 8);
+  cout << " " << padString(doubleToString(t_grid_batch,0), 8) << endl;
+
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{ 
+  cout << "Usage:                                              " << endl;
+  cout << "  geodbench [OPTIONS]                               " << endl;
+  cout << "                                                    " << endl;
+  cout << "Synopsis:                                           " << endl;
+  cout << "  Report the accuracy and speed of the CMOOSGeodesy " << endl;
+  cout << "  batch and tangent plane conversions, against the  " << endl;
+  cout << "  single point UTM conversions, for an op area of   " << endl;
+  cout << "  the given radius about the given origin.          " << endl;
+  cout << "                                                    " << endl;
+  cout << "Options:                                            " << endl;
+  cout << "  --help, -h                                        " << endl;
+  cout << "    Display this help message                       " << endl;
+  cout << "  --lat=<deg>     (default 42.358436)               " << endl;
+  cout << "  --lon=<deg>     (default -71.087448)              " << endl;
+  cout << "    Origin of the local grid                        " << endl;
+  cout << "  --range=<m>     (default 10000)                   " << endl;
+  cout << "    Radius of the op area, and tangent plane range  " << endl;
+  cout << "  --maxerr=<m>    (default 0.1)                     " << endl;
+  cout << "    Tangent plane error allowed within range        " << endl;
+  cout << "  --points=<n>    (default 200000)                  " << endl;
+  cout << "    Number of random points per test                " << endl;
+  cout << "  --seed=<n>      (default 1)                       " << endl;
+  cout << "                                                    " << endl;
+  cout << "Example:                                            " << endl;
+  cout << "  geodbench --lat=43.8 --lon=-70.3 --range=5000     " << endl;
+
+  exit(0);
+}
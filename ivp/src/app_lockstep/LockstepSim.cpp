@@ -0,0 +1,524 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: LockstepSim.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <cmath>
+#include <sys/time.h>
+#include "MOOS/libMOOS/Utils/ProcessConfigReader.h"
+#include "MBUtils.h"
+#include "LockstepSim.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: getWallTime()
+
+static double getWallTime()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return((double)(tv.tv_sec) + ((double)(tv.tv_usec) / 1000000.0));
+}
+
+//-----------------------------------------------------------
+// Procedure: Constructor
+
+LockstepSim::LockstepSim()
+{
+  m_time_step = 0.25;
+  m_duration  = 600;
+  m_threads   = 1;
+  m_runs      = 1;
+  m_seed      = 1;
+  m_jitter    = 0;
+  m_verbose   = false;
+
+  m_min_range      = -1;
+  m_min_range_time = 0;
+
+  m_generation = 0;
+  m_pending    = 0;
+  m_step_time  = 0;
+  m_shutdown   = false;
+}
+
+//-----------------------------------------------------------
+// Procedure: Destructor
+
+LockstepSim::~LockstepSim()
+{
+  stopThreads();
+  clearVehicles();
+}
+
+//-----------------------------------------------------------
+// Procedure: addMissionFile()
+//   Purpose: Read the config blocks for one vehicle from a .moos
+//            file, typically a targ_*.moos file made by nsplug.
+
+bool LockstepSim::addMissionFile(string file)
+{
+  if(!okFileToRead(file)) {
+    cout << "Unable to read mission file: " << file << endl;
+    return(false);
+  }
+
+  CProcessConfigReader reader;
+  reader.SetFile(file);
+
+  LockstepVehicleConfig config;
+  config.moos_file  = file;
+  config.vtype      = "kayak";
+  config.lat_origin = 0;
+  config.lon_origin = 0;
+
+  if(!reader.GetValue("Community", config.vname)) {
+    cout << "No Community name found in " << file << endl;
+    return(false);
+  }
+
+  config.geo_ok = (reader.GetValue("LatOrigin", config.lat_origin) &&
+		   reader.GetValue("LongOrigin", config.lon_origin));
+
+  size_t pos = file.find_last_of('/');
+  if(pos != string::npos)
+    config.bhv_dir = file.substr(0, pos);
+
+  // Part 1: The helm, required
+  reader.EnableVerbatimQuoting(false);
+  if(!reader.GetConfiguration("pHelmIvP", config.helm_params)) {
+    cout << "No pHelmIvP config block found in " << file << endl;
+    return(false);
+  }
+
+  // Part 2: The simulator, required
+  if(!reader.GetConfiguration("uSimMarineV22", config.sim_params) &&
+     !reader.GetConfiguration("uSimMarine", config.sim_params)) {
+    cout << "No uSimMarineV22 config block found in " << file << endl;
+    return(false);
+  }
+
+  // Part 3: The PID, optional if the PID is embedded in the sim
+  if(!reader.GetConfiguration("pMarinePIDV22", config.pid_params) &&
+     !reader.GetConfiguration("pMarinePID", config.pid_params))
+    config.pid_params = config.sim_params;
+
+  // Part 4: The platform type, from the node reporter if present
+  list<string> nrep_params;
+  reader.GetConfiguration("pNodeReporter", nrep_params);
+  list<string>::iterator p;
+  for(p=nrep_params.begin(); p!=nrep_params.end(); p++) {
+    string line  = *p;
+    string param = tolower(biteStringX(line, '='));
+    if((param == "platform_type") || (param == "vessel_type"))
+      config.vtype = line;
+  }
+
+  // Config lines come back in reverse order of the file
+  config.helm_params.reverse();
+  config.sim_params.reverse();
+  config.pid_params.reverse();
+
+  m_configs.push_back(config);
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: setTimeStep()
+
+bool LockstepSim::setTimeStep(string str)
+{
+  return(setPosDoubleOnString(m_time_step, str));
+}
+
+//-----------------------------------------------------------
+// Procedure: setDuration()
+
+bool LockstepSim::setDuration(string str)
+{
+  return(setPosDoubleOnString(m_duration, str));
+}
+
+//-----------------------------------------------------------
+// Procedure: setThreads()
+
+bool LockstepSim::setThreads(string str)
+{
+  if(!setPosUIntOnString(m_threads, str))
+    return(false);
+  if(m_threads == 0)
+    m_threads = 1;
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: setRuns()
+
+bool LockstepSim::setRuns(string str)
+{
+  if(!setPosUIntOnString(m_runs, str))
+    return(false);
+  if(m_runs == 0)
+    m_runs = 1;
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: setSeed()
+
+bool LockstepSim::setSeed(string str)
+{
+  return(setPosUIntOnString(m_seed, str));
+}
+
+//-----------------------------------------------------------
+// Procedure: setJitter()
+
+bool LockstepSim::setJitter(string str)
+{
+  return(setNonNegDoubleOnString(m_jitter, str));
+}
+
+//-----------------------------------------------------------
+// Procedure: addPoke()
+//   Example: "DEPLOY=true"
+
+bool LockstepSim::addPoke(string str)
+{
+  string var = biteStringX(str, '=');
+  if((var == "") || strContainsWhite(var))
+    return(false);
+
+  m_pokes.push_back(var + "=" + str);
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: run()
+//   Purpose: Perform all runs. Run i uses seed m_seed+i so any one
+//            run can be reproduced alone with --seed and --runs=1.
+
+bool LockstepSim::run()
+{
+  if(m_configs.size() == 0) {
+    cout << "No mission files given." << endl;
+    return(false);
+  }
+
+  startThreads();
+
+  bool all_ok = true;
+  for(unsigned int i=0; i<m_runs; i++) {
+    if(!runOnce(i))
+      all_ok = false;
+  }
+
+  stopThreads();
+  return(all_ok);
+}
+
+//-----------------------------------------------------------
+// Procedure: runOnce()
+
+bool LockstepSim::runOnce(unsigned int run_ix)
+{
+  srand(m_seed + run_ix);
+  if(!buildVehicles(run_ix))
+    return(false);
+
+  m_min_range      = -1;
+  m_min_range_time = 0;
+  m_min_range_pair = "";
+
+  double start_wall = getWallTime();
+
+  // Each vehicle knows of the others before its first helm iteration
+  routeMail(0);
+
+  unsigned int steps = 0;
+  double curr_time = 0;
+  while(curr_time < m_duration) {
+    steps++;
+    curr_time = (double)(steps) * m_time_step;
+    stepVehicles(curr_time);
+    routeMail(curr_time);
+  }
+
+  reportRun(run_ix, steps, getWallTime() - start_wall);
+  clearVehicles();
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: buildVehicles()
+//      Note: The jitter is drawn here, serially and in vehicle
+//            order, so it only depends on the seed.
+
+bool LockstepSim::buildVehicles(unsigned int run_ix)
+{
+  clearVehicles();
+
+  bool all_ok = true;
+  for(unsigned int i=0; i<m_configs.size(); i++) {
+    const LockstepVehicleConfig& config = m_configs[i];
+
+    LockstepVehicle *vehicle = new LockstepVehicle;
+    vehicle->setName(config.vname);
+    vehicle->setPlatformType(config.vtype);
+    vehicle->setBehaviorDir(config.bhv_dir);
+    if(config.geo_ok)
+      vehicle->setGeodesy(config.lat_origin, config.lon_origin);
+
+    list<string>::const_iterator p;
+    for(p=config.sim_params.begin(); p!=config.sim_params.end(); p++) {
+      string line  = *p;
+      string param = biteStringX(line, '=');
+      if(!vehicle->setSimParam(param, line) && m_verbose && (run_ix==0))
+	cout << config.vname << ": Unhandled sim param: " << *p << endl;
+    }
+    for(p=config.helm_params.begin(); p!=config.helm_params.end(); p++) {
+      string line  = *p;
+      string param = biteStringX(line, '=');
+      if(!vehicle->setHelmParam(param, line))
+	cout << config.vname << ": Bad helm param: " << *p << endl;
+    }
+    vehicle->setPIDParams(config.pid_params);
+
+    if(m_jitter > 0) {
+      double dx = ((double)(rand() % 10001) / 5000.0 - 1) * m_jitter;
+      double dy = ((double)(rand() % 10001) / 5000.0 - 1) * m_jitter;
+      vehicle->jitterStart(dx, dy);
+    }
+
+    for(unsigned int j=0; j<m_pokes.size(); j++) {
+      string value = m_pokes[j];
+      string var = biteStringX(value, '=');
+      if(isNumber(value))
+	vehicle->addMail(var, atof(value.c_str()));
+      else
+	vehicle->addMail(var, value);
+    }
+
+    // The behavior populator reports verbosely on cout. Unless in
+    // verbose mode, mute it and rely on the collected warnings.
+    ostringstream muted;
+    streambuf *cout_buf = cout.rdbuf();
+    if(!m_verbose)
+      cout.rdbuf(muted.rdbuf());
+    bool ok_init = vehicle->initialize(0);
+    cout.rdbuf(cout_buf);
+
+    if(!ok_init) {
+      vector<string> warnings = vehicle->getConfigWarnings();
+      for(unsigned int j=0; j<warnings.size(); j++)
+	cout << "Warning: " << warnings[j] << endl;
+      all_ok = false;
+    }
+    m_vehicles.push_back(vehicle);
+  }
+
+  return(all_ok);
+}
+
+//-----------------------------------------------------------
+// Procedure: clearVehicles()
+
+void LockstepSim::clearVehicles()
+{
+  for(unsigned int i=0; i<m_vehicles.size(); i++)
+    delete(m_vehicles[i]);
+  m_vehicles.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: stepVehicles()
+//   Purpose: Step all vehicles to the given time and return when
+//            all are done. With one thread this is a plain loop.
+
+void LockstepSim::stepVehicles(double curr_time)
+{
+  if(m_workers.size() == 0) {
+    for(unsigned int i=0; i<m_vehicles.size(); i++)
+      m_vehicles[i]->step(curr_time);
+    return;
+  }
+
+  unique_lock<mutex> lock(m_mutex);
+  m_step_time = curr_time;
+  m_pending   = m_workers.size();
+  m_generation++;
+  m_cond.notify_all();
+  m_done_cond.wait(lock, [this]{return(m_pending == 0);});
+}
+
+//-----------------------------------------------------------
+// Procedure: routeMail()
+//   Purpose: Deliver each vehicle's node report to every other
+//            vehicle. Done serially in vehicle order so that the
+//            inbox order, and hence the result, is deterministic.
+
+void LockstepSim::routeMail(double curr_time)
+{
+  unsigned int i, j, vsize = m_vehicles.size();
+  for(i=0; i<vsize; i++) {
+    NodeRecord record = m_vehicles[i]->getNodeRecord();
+    for(j=0; j<vsize; j++) {
+      if(i != j)
+	m_vehicles[j]->addNodeReport(record);
+    }
+  }
+  updateMinRange(curr_time);
+}
+
+//-----------------------------------------------------------
+// Procedure: updateMinRange()
+
+void LockstepSim::updateMinRange(double curr_time)
+{
+  unsigned int i, j, vsize = m_vehicles.size();
+  for(i=0; i<vsize; i++) {
+    NodeRecord irec = m_vehicles[i]->getNodeRecord();
+    for(j=i+1; j<vsize; j++) {
+      NodeRecord jrec = m_vehicles[j]->getNodeRecord();
+      double range = hypot(irec.getX() - jrec.getX(),
+			   irec.getY() - jrec.getY());
+      if((m_min_range < 0) || (range < m_min_range)) {
+	m_min_range      = range;
+	m_min_range_time = curr_time;
+	m_min_range_pair = irec.getName() + ":" + jrec.getName();
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: startThreads()
+//      Note: Vehicles are split statically by index, i % threads,
+//            so each vehicle is always stepped by the same worker.
+
+void LockstepSim::startThreads()
+{
+  if((m_threads <= 1) || (m_workers.size() > 0))
+    return;
+
+  m_shutdown   = false;
+  m_generation = 0;
+  for(unsigned int i=0; i<m_threads; i++)
+    m_workers.push_back(thread(&LockstepSim::workerLoop, this, i));
+}
+
+//-----------------------------------------------------------
+// Procedure: stopThreads()
+
+void LockstepSim::stopThreads()
+{
+  if(m_workers.size() == 0)
+    return;
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_cond.notify_all();
+
+  for(unsigned int i=0; i<m_workers.size(); i++)
+    m_workers[i].join();
+  m_workers.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: workerLoop()
+
+void LockstepSim::workerLoop(unsigned int worker_ix)
+{
+  unsigned int seen_generation = 0;
+  while(1) {
+    double curr_time = 0;
+    {
+      unique_lock<mutex> lock(m_mutex);
+      m_cond.wait(lock, [&]{return(m_shutdown ||
+				   (m_generation != seen_generation));});
+      if(m_shutdown)
+	return;
+      seen_generation = m_generation;
+      curr_time = m_step_time;
+    }
+
+    unsigned int nthreads = m_threads;
+    for(unsigned int i=worker_ix; i<m_vehicles.size(); i+=nthreads)
+      m_vehicles[i]->step(curr_time);
+
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_pending--;
+      if(m_pending == 0)
+	m_done_cond.notify_one();
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: reportRun()
+
+void LockstepSim::reportRun(unsigned int run_ix, unsigned int steps,
+			    double elapsed)
+{
+  double sim_time = (double)(steps) * m_time_step;
+  double warp = 0;
+  if(elapsed > 0)
+    warp = sim_time / elapsed;
+
+  cout << "run=" << run_ix;
+  cout << ",seed=" << (m_seed + run_ix);
+  cout << ",steps=" << steps;
+  cout << ",sim_time=" << doubleToStringX(sim_time, 2);
+  cout << ",wall_time=" << doubleToStringX(elapsed, 3);
+  cout << ",warp=" << doubleToStringX(warp, 1);
+  if(m_vehicles.size() > 1) {
+    cout << ",min_range=" << doubleToStringX(m_min_range, 2);
+    cout << ",min_range_time=" << doubleToStringX(m_min_range_time, 2);
+    cout << ",pair=" << m_min_range_pair;
+  }
+  cout << endl;
+
+  if(!m_verbose)
+    return;
+
+  for(unsigned int i=0; i<m_vehicles.size(); i++) {
+    LockstepVehicle *vehicle = m_vehicles[i];
+    NodeRecord record = vehicle->getNodeRecord();
+    cout << "  vname=" << vehicle->getName();
+    cout << ",x=" << doubleToStringX(record.getX(), 2);
+    cout << ",y=" << doubleToStringX(record.getY(), 2);
+    cout << ",hdg=" << doubleToStringX(record.getHeading(), 2);
+    cout << ",spd=" << doubleToStringX(record.getSpeed(), 2);
+    cout << ",odo=" << doubleToStringX(vehicle->getOdometry(), 1);
+    cout << ",iters=" << vehicle->getHelmIterations();
+    cout << ",allstops=" << vehicle->getAllStops();
+    if(vehicle->getHaltMsg() != "")
+      cout << ",halt=" << vehicle->getHaltMsg();
+    cout << endl;
+  }
+}
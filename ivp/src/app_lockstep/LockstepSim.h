@@ -0,0 +1,127 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: LockstepSim.h                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+ 
+#ifndef LOCKSTEP_SIM_HEADER
+#define LOCKSTEP_SIM_HEADER
+
+#include <string>
+#include <vector>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "LockstepVehicle.h"
+
+//-------------------------------------------------------------------
+// LockstepVehicleConfig: The parts of one vehicle's .moos file that
+// a LockstepVehicle needs. Parsed once and cached so that repeated
+// runs rebuild vehicles without touching the file system again.
+
+struct LockstepVehicleConfig
+{
+  std::string moos_file;
+  std::string vname;
+  std::string vtype;
+  std::string bhv_dir;
+  double      lat_origin;
+  double      lon_origin;
+  bool        geo_ok;
+
+  std::list<std::string> helm_params;
+  std::list<std::string> sim_params;
+  std::list<std::string> pid_params;
+};
+
+//-------------------------------------------------------------------
+// LockstepSim: Steps N vehicles on one discrete clock. On each tick
+// every vehicle is stepped (possibly in parallel, since a vehicle
+// only touches its own state), then mail is routed serially in a
+// fixed vehicle order. Given a seed, results do not depend on the
+// number of threads or on wall-clock timing.
+
+class LockstepSim {
+public:
+  LockstepSim();
+  ~LockstepSim();
+
+  bool addMissionFile(std::string);
+  bool setTimeStep(std::string);
+  bool setDuration(std::string);
+  bool setThreads(std::string);
+  bool setRuns(std::string);
+  bool setSeed(std::string);
+  bool setJitter(std::string);
+  bool addPoke(std::string);
+  void setVerbose(bool v) {m_verbose=v;}
+
+  bool run();
+
+protected:
+  bool   runOnce(unsigned int run_ix);
+  bool   buildVehicles(unsigned int run_ix);
+  void   clearVehicles();
+
+  void   stepVehicles(double curr_time);
+  void   routeMail(double curr_time);
+  void   updateMinRange(double curr_time);
+
+  void   startThreads();
+  void   stopThreads();
+  void   workerLoop(unsigned int worker_ix);
+
+  void   reportRun(unsigned int run_ix, unsigned int steps,
+		   double elapsed);
+
+private: // Configuration variables
+  std::vector<LockstepVehicleConfig> m_configs;
+  std::vector<std::string> m_pokes;
+
+  double       m_time_step;
+  double       m_duration;
+  unsigned int m_threads;
+  unsigned int m_runs;
+  unsigned int m_seed;
+  double       m_jitter;
+  bool         m_verbose;
+
+private: // State variables
+  std::vector<LockstepVehicle*> m_vehicles;
+
+  double       m_min_range;
+  double       m_min_range_time;
+  std::string  m_min_range_pair;
+
+  // Worker pool. Workers wait on m_cond for m_generation to change,
+  // step their share of the vehicles, then count down m_pending.
+  std::vector<std::thread> m_workers;
+  std::mutex               m_mutex;
+  std::condition_variable  m_cond;
+  std::condition_variable  m_done_cond;
+  unsigned int             m_generation;
+  unsigned int             m_pending;
+  double                   m_step_time;
+  bool                     m_shutdown;
+};
+
+#endif
@@ -0,0 +1,552 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: LockstepVehicle.cpp                                  */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "AngleUtils.h"
+#include "LockstepVehicle.h"
+#include "Populator_BehaviorSet.h"
+#include "HelmReport.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: Constructor
+
+LockstepVehicle::LockstepVehicle()
+{
+  m_vtype     = "kayak";
+  m_max_speed = 5;
+
+  m_info_buffer = 0;
+  m_bhv_set     = 0;
+  m_hengine     = 0;
+
+  m_allstop   = true;
+  m_allstops  = 0;
+  m_helm_iterations = 0;
+  m_odometry  = 0;
+}
+
+//-----------------------------------------------------------
+// Procedure: Destructor
+
+LockstepVehicle::~LockstepVehicle()
+{
+  if(m_hengine)
+    delete(m_hengine);
+  if(m_bhv_set)
+    delete(m_bhv_set);
+  if(m_info_buffer)
+    delete(m_info_buffer);
+}
+
+//-----------------------------------------------------------
+// Procedure: setSimParam()
+//   Purpose: Handle a uSimMarineV22 config param. Params that only
+//            concern MOOS postings (prefix, post_des_thrust, etc.)
+//            are accepted and ignored.
+
+bool LockstepVehicle::setSimParam(string param, string value)
+{
+  param = tolower(param);
+  double dval = atof(value.c_str());
+  bool   dnum = isNumber(value);
+
+  if(((param == "start_x") || (param == "start_y") ||
+      (param == "start_heading") || (param == "start_speed") ||
+      (param == "start_depth") || (param == "buoyancy_rate") ||
+      (param == "turn_rate") || (param == "rotate_speed") ||
+      (param == "max_acceleration") || (param == "max_deceleration") ||
+      (param == "max_depth_rate") || (param == "max_depth_rate_speed"))
+     && dnum)
+    return(m_model.setParam(param, dval));
+  else if((param == "default_water_depth") && dnum)
+    return(m_model.setParam("water_depth", dval));
+  else if(param == "start_pos")
+    return(m_model.initPosition(value));
+  else if((param == "drift_x") && dnum)
+    return(m_model.setDriftX(dval, ""));
+  else if((param == "drift_y") && dnum)
+    return(m_model.setDriftY(dval, ""));
+  else if(param == "drift_vector")
+    return(m_model.setDriftVector(value, ""));
+  else if((param == "max_rudder_degs_per_sec") && dnum)
+    return(m_model.setMaxRudderDegreesPerSec(dval));
+  else if(param == "thrust_map")
+    return(m_model.handleFullThrustMapping(value));
+  else if(param == "thrust_reflect")
+    return(m_model.setThrustReflect(value));
+  else if(param == "thrust_mode_reverse") {
+    m_model.setThrustModeReverse(value);
+    return(true);
+  }
+  else if((param == "thrust_factor") && dnum) {
+    m_model.setThrustFactor(dval);
+    return(true);
+  }
+  else if(param == "turn_spd_map_full_speed")
+    return(m_model.setTSMapFullSpeed(value));
+  else if(param == "turn_spd_map_null_speed")
+    return(m_model.setTSMapNullSpeed(value));
+  else if(param == "turn_spd_map_full_rate")
+    return(m_model.setTSMapFullRate(value));
+  else if(param == "turn_spd_map_null_rate")
+    return(m_model.setTSMapNullRate(value));
+  else if((param == "turn_spd_loss") && dnum)
+    return(m_model.setTurnSpdLoss(dval));
+  else if((param == "max_speed") && dnum)
+    return(setPosDoubleOnString(m_max_speed, value));
+  else if((param == "prefix") || (param == "post_des_thrust") ||
+	  (param == "post_des_rudder") || (param == "apptick") ||
+	  (param == "commstick") || (param == "sim_pause"))
+    return(true);
+  else if(param == "dual_state")
+    return(m_model.setDualState(value));
+  else if(param == "thrust_mode_diff")
+    return(m_model.setThrustModeDiff(value));
+
+  return(false);
+}
+
+//-----------------------------------------------------------
+// Procedure: setHelmParam()
+//   Purpose: Handle a pHelmIvP config param. Params that only
+//            concern the MOOS app (verbose, hold_on_apps, etc.)
+//            are accepted and ignored.
+
+bool LockstepVehicle::setHelmParam(string param, string value)
+{
+  param = toupper(param);
+  if(param == "BEHAVIORS") {
+    if(!strBegins(value, "/") && (m_bhv_dir != ""))
+      value = m_bhv_dir + "/" + value;
+    m_bhv_files.insert(value);
+    return(true);
+  }
+  else if(param == "DOMAIN")
+    return(handleDomain(value));
+  else if(param == "PMGEN")
+    return(m_pmgen.setParams(value));
+  else if((param == "IVP_BEHAVIOR_DIR") || (param == "IVP_BEHAVIOR_DIRS")) {
+    m_behavior_dirs.push_back(value);
+    return(true);
+  }
+
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: setPIDParams()
+
+void LockstepVehicle::setPIDParams(list<string> params)
+{
+  m_pid_params = params;
+}
+
+//-----------------------------------------------------------
+// Procedure: setGeodesy()
+
+void LockstepVehicle::setGeodesy(double lat, double lon)
+{
+  CMOOSGeodesy geodesy;
+  if(geodesy.Initialise(lat, lon))
+    m_model.setGeodesy(geodesy);
+}
+
+//-----------------------------------------------------------
+// Procedure: initialize()
+//   Purpose: Build the helm and PID from the given configuration,
+//            in the same order pHelmIvP and pMarinePIDV22 do in
+//            their OnStartUp(). Returns false on a config error.
+
+bool LockstepVehicle::initialize(double start_time)
+{
+  m_model.cacheStartingInfo();
+  m_model.resetTime(start_time);
+  m_record = m_model.getNodeRecord();
+
+  // Part 1: The PID engine
+  m_pengine.setStartTime(start_time);
+  m_pengine.updateTime(start_time);
+  m_pengine.setConfigParams(m_pid_params);
+  bool ok_yaw = m_pengine.handleYawSettings();
+  bool ok_spd = m_pengine.handleSpeedSettings();
+  bool ok_dep = m_pengine.handleDepthSettings();
+  if(!ok_yaw || !ok_spd || !ok_dep)
+    m_warnings.push_back(m_vname + ": Improper PID Setting");
+
+  // The helm is engaged from the start, as if MOOS_MANUAL_OVERRIDE
+  // had been posted false before the first iteration.
+  m_pengine.setPIDOverride(string("false"));
+  m_pengine.clearPostings();
+
+  // Part 2: The helm
+  if(m_ivp_domain.size() == 0) {
+    m_ivp_domain.addDomain("course", 0, 359, 360);
+    m_ivp_domain.addDomain("speed", 0, 4, 41);
+  }
+
+  m_info_buffer = new InfoBuffer;
+  m_info_buffer->setCurrTime(start_time);
+  m_info_buffer->setStartTime(start_time);
+
+  m_hengine = new HelmEngine(m_ivp_domain, m_info_buffer);
+
+  Populator_BehaviorSet p_bset(m_ivp_domain, m_info_buffer);
+  p_bset.setOwnship(m_vname);
+  for(unsigned int k=0; k<m_behavior_dirs.size(); k++)
+    p_bset.addBehaviorDir(m_behavior_dirs[k]);
+  
+  m_bhv_set = p_bset.populate(m_bhv_files);
+
+  vector<string> config_warnings = p_bset.getConfigWarnings();
+  for(unsigned int k=0; k<config_warnings.size(); k++) 
+    m_warnings.push_back(m_vname + ": " + config_warnings[k]);
+
+  if(!m_bhv_set) {
+    m_warnings.push_back(m_vname + ": NULL Behavior Set");
+    return(false);
+  }
+
+  unsigned int i, bsize = m_bhv_set->size();
+  for(i=0; i<bsize; i++) {
+    m_bhv_set->getBehavior(i)->IvPBehavior::setParam("us", m_vname);
+    m_bhv_set->getBehavior(i)->onSetParamComplete();
+  }
+
+  // Part 3: Ownship nav info is known to the helm from the start
+  stepSim(start_time);
+  handleInitialVariables();
+
+  return(m_warnings.size() == 0);
+}
+
+//-----------------------------------------------------------
+// Procedure: jitterStart()
+
+void LockstepVehicle::jitterStart(double dx, double dy)
+{
+  NodeRecord record = m_model.getNodeRecord();
+  m_model.informX(record.getX() + dx);
+  m_model.informY(record.getY() + dy);
+}
+
+//-----------------------------------------------------------
+// Procedure: addMail()
+
+void LockstepVehicle::addMail(const string& var, const string& val)
+{
+  m_inbox.push_back(VarDataPair(var, val));
+}
+
+void LockstepVehicle::addMail(const string& var, double val)
+{
+  m_inbox.push_back(VarDataPair(var, val));
+}
+
+//-----------------------------------------------------------
+// Procedure: addNodeReport()
+//      Note: Node reports are kept as records rather than strings
+//            since there are N*(N-1) of them on every step.
+
+void LockstepVehicle::addNodeReport(const NodeRecord& record)
+{
+  m_inbox_nodes.push_back(record);
+}
+
+//-----------------------------------------------------------
+// Procedure: step()
+//   Purpose: One lockstep iteration: mail, helm, PID, then the
+//            simulator, mirroring the MOOS pipeline where each app
+//            sees what the others posted on the previous tick.
+
+void LockstepVehicle::step(double curr_time)
+{
+  if(!m_bhv_set)
+    return;
+
+  m_pengine.updateTime(curr_time);
+
+  deliverMail(curr_time);
+  stepHelm(curr_time);
+  stepPID(curr_time);
+  stepSim(curr_time);
+}
+
+//-----------------------------------------------------------
+// Procedure: deliverMail()
+
+void LockstepVehicle::deliverMail(double curr_time)
+{
+  m_info_buffer->setCurrTime(curr_time);
+
+  for(unsigned int i=0; i<m_inbox.size(); i++) {
+    const VarDataPair& mail = m_inbox[i];
+    if(mail.is_string())
+      m_info_buffer->setValue(mail.get_var(), mail.get_sdata(), curr_time);
+    else
+      m_info_buffer->setValue(mail.get_var(), mail.get_ddata(), curr_time);
+  }
+  m_inbox.clear();
+
+  for(unsigned int i=0; i<m_inbox_nodes.size(); i++)
+    processNodeReport(m_inbox_nodes[i]);
+  m_inbox_nodes.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: stepHelm()
+
+void LockstepVehicle::stepHelm(double curr_time)
+{
+  bool ok1, ok2, ok3, ok4;
+  double osx = m_info_buffer->dQuery("NAV_X", ok1);
+  double osy = m_info_buffer->dQuery("NAV_Y", ok2);
+  double osh = m_info_buffer->dQuery("NAV_HEADING", ok3);
+  double osv = m_info_buffer->dQuery("NAV_SPEED", ok4);
+  if(ok1 && ok2 && ok3 && ok4) {
+    m_pmgen.setCurrTime(curr_time);
+    m_hengine->setPlatModel(m_pmgen.generate(osx, osy, osh, osv));
+  }
+
+  HelmReport report = m_hengine->determineNextDecision(m_bhv_set, curr_time);
+  m_helm_iterations++;
+
+  handleBehaviorMessages();
+  m_info_buffer->clearDeltaVectors();
+
+  m_allstop = true;
+  if(report.getHalted())
+    m_halt_msg = report.getHaltMsg();
+  else if(report.hasDecision("course") && report.hasDecision("speed")) {
+    m_pengine.setDesHeading(report.getDecision("course"));
+    m_pengine.setDesSpeed(report.getDecision("speed"));
+    if(report.hasDecision("depth"))
+      m_pengine.setDesDepth(report.getDecision("depth"));
+    m_allstop = false;
+  }
+  if(m_allstop)
+    m_allstops++;
+}
+
+//-----------------------------------------------------------
+// Procedure: stepPID()
+
+void LockstepVehicle::stepPID(double curr_time)
+{
+  m_pengine.setCurrHeading(m_record.getHeading());
+  m_pengine.setCurrSpeed(m_record.getSpeed());
+  if(m_pengine.hasDepthControl()) {
+    m_pengine.setCurrDepth(m_record.getDepth());
+    m_pengine.setCurrPitch(m_record.getPitch());
+  }
+  m_pengine.setDesiredValues();
+  m_pengine.clearPostings();
+
+  if(m_allstop || !m_pengine.hasControl()) {
+    m_model.setRudder(0, curr_time);
+    m_model.setThrust(0);
+    m_model.setElevator(0);
+    return;
+  }
+
+  m_model.setRudder(m_pengine.getDesiredRudder(), curr_time);
+  m_model.setThrust(m_pengine.getDesiredThrust());
+  if(m_pengine.hasDepthControl())
+    m_model.setElevator(m_pengine.getDesiredElevator());
+}
+
+//-----------------------------------------------------------
+// Procedure: stepSim()
+//   Purpose: Propagate the model and post ownship nav to the helm,
+//            as uSimMarineV22 would via NAV_* mail.
+
+void LockstepVehicle::stepSim(double curr_time)
+{
+  double prev_x = m_record.getX();
+  double prev_y = m_record.getY();
+
+  m_model.propagate(curr_time);
+  m_record = m_model.getNodeRecord();
+  m_record.setName(m_vname);
+  m_record.setType(m_vtype);
+  m_record.setTimeStamp(curr_time);
+
+  m_odometry += hypot(m_record.getX() - prev_x, m_record.getY() - prev_y);
+
+  if(!m_info_buffer)
+    return;
+  m_info_buffer->setValue("NAV_X", m_record.getX(), curr_time);
+  m_info_buffer->setValue("NAV_Y", m_record.getY(), curr_time);
+  m_info_buffer->setValue("NAV_HEADING", m_record.getHeading(), curr_time);
+  double nav_speed = snapToStep(m_record.getSpeed(), 0.01);
+  if(nav_speed > m_max_speed)
+    nav_speed = m_max_speed;
+  m_info_buffer->setValue("NAV_SPEED", nav_speed, curr_time);
+  m_info_buffer->setValue("NAV_DEPTH", m_record.getDepth(), curr_time);
+  if(m_model.geoOK()) {
+    m_info_buffer->setValue("NAV_LAT", m_record.getLat(), curr_time);
+    m_info_buffer->setValue("NAV_LONG", m_record.getLon(), curr_time);
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: handleBehaviorMessages()
+//   Purpose: Behavior postings loop back into the info buffer, as
+//            they would after a round trip through the MOOSDB. Then
+//            default variables are applied for any variable not
+//            written by a behavior on this iteration.
+
+void LockstepVehicle::handleBehaviorMessages()
+{
+  set<string> message_vars;
+
+  unsigned int i, bhv_cnt = m_bhv_set->size();
+  for(i=0; i<bhv_cnt; i++) {
+    vector<VarDataPair> mvector = m_bhv_set->getMessages(i);
+    for(unsigned int j=0; j<mvector.size(); j++) {
+      VarDataPair msg = mvector[j];
+      string var = msg.get_var();
+      message_vars.insert(var);
+      if(var == "BHV_IPF")
+	continue;
+      if(msg.is_string())
+	m_info_buffer->setValue(var, msg.get_sdata());
+      else
+	m_info_buffer->setValue(var, msg.get_ddata());
+    }
+  }
+
+  vector<VarDataPair> dvector = m_bhv_set->getDefaultVariables();
+  for(unsigned int j=0; j<dvector.size(); j++) {
+    VarDataPair msg = dvector[j];
+    if(message_vars.count(msg.get_var()))
+      continue;
+    if(msg.is_string())
+      m_info_buffer->setValue(msg.get_var(), msg.get_sdata());
+    else
+      m_info_buffer->setValue(msg.get_var(), msg.get_ddata());
+  }
+
+  m_bhv_set->clearWarnings();
+  m_bhv_set->updateStateSpaceVars();
+  m_bhv_set->removeCompletedBehaviors();
+}
+
+//-----------------------------------------------------------
+// Procedure: handleInitialVariables()
+//   Purpose: Apply the initialize statements of the behavior files.
+//            Mail added before initialize() lands between the two
+//            passes, so it overrides a deferred init but not a
+//            posted one, as with an early poke into a MOOSDB.
+
+void LockstepVehicle::handleInitialVariables()
+{
+  vector<VarDataPair> mvector = m_bhv_set->getInitialVariables();
+  for(unsigned int pass=0; pass<2; pass++) {
+    for(unsigned int j=0; j<mvector.size(); j++) {
+      VarDataPair msg = mvector[j];
+      string var   = stripBlankEnds(msg.get_var());
+      string sdata = stripBlankEnds(msg.get_sdata());
+      double ddata = msg.get_ddata();
+      string key   = tolower(msg.get_key());
+      if(strContainsWhite(var))
+	continue;
+      if((pass == 0) && (key != "post"))
+	continue;
+      if((pass == 1) && ((key != "defer") || m_info_buffer->isKnown(var)))
+	continue;
+      if(sdata != "")
+	m_info_buffer->setValue(var, sdata);
+      else
+	m_info_buffer->setValue(var, ddata);
+    }
+
+    if(pass == 0) {
+      for(unsigned int i=0; i<m_inbox.size(); i++) {
+	const VarDataPair& mail = m_inbox[i];
+	if(mail.is_string())
+	  m_info_buffer->setValue(mail.get_var(), mail.get_sdata());
+	else
+	  m_info_buffer->setValue(mail.get_var(), mail.get_ddata());
+      }
+      m_inbox.clear();
+    }
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: processNodeReport()
+//   Purpose: Same handling as pHelmIvP for a NODE_REPORT, but the
+//            record is passed in memory rather than serialized.
+
+void LockstepVehicle::processNodeReport(const NodeRecord& record)
+{
+  string vname = toupper(record.getName());
+  if(vname == toupper(m_vname))
+    return;
+
+  m_info_buffer->setValue(vname+"_NAV_X", record.getX());
+  m_info_buffer->setValue(vname+"_NAV_Y", record.getY());
+  m_info_buffer->setValue(vname+"_NAV_SPEED", record.getSpeed());
+  m_info_buffer->setValue(vname+"_NAV_HEADING", record.getHeading());
+  m_info_buffer->setValue(vname+"_NAV_DEPTH", record.getDepth());
+  m_info_buffer->setValue(vname+"_NAV_LAT", record.getLat());
+  m_info_buffer->setValue(vname+"_NAV_LONG", record.getLon());
+  m_info_buffer->setValue(vname+"_NAV_GROUP", record.getGroup());
+  m_info_buffer->setValue(vname+"_NAV_TYPE", record.getType());
+  m_info_buffer->setValue(vname+"_NAV_UTC", record.getTimeStamp());
+}
+
+//-----------------------------------------------------------
+// Procedure: handleDomain()
+//   Example: "speed:0:4:21" or "speed:0:4:delta=0.1"
+
+bool LockstepVehicle::handleDomain(string entry)
+{
+  entry = findReplace(stripBlankEnds(entry), ',', ':');
+
+  vector<string> svector = parseString(entry, ':');
+  unsigned int vsize = svector.size();
+  if((vsize < 4) || (vsize > 5))
+    return(false);
+
+  string dname = svector[0];
+  double dlow  = atof(svector[1].c_str());
+  double dhgh  = atof(svector[2].c_str());
+  int    dcnt  = atoi(svector[3].c_str());
+  double dom_range = dhgh - dlow;
+  if((dhgh < dlow) || ((dom_range == 0) && (dcnt != 1)))
+    return(false);
+
+  if(strBegins(svector[3], "delta=") && (dom_range > 0)) {
+    double delta = atof(rbiteString(svector[3], '=').c_str());
+    if((delta > 0) && (delta <= dom_range))
+      dcnt = (int)((dom_range / delta) + 1);
+  }
+
+  return(m_ivp_domain.addDomain(dname.c_str(), dlow, dhgh, dcnt));
+}
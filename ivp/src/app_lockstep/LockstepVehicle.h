@@ -0,0 +1,125 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: LockstepVehicle.h                                    */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef LOCKSTEP_VEHICLE_HEADER
+#define LOCKSTEP_VEHICLE_HEADER
+
+#include <string>
+#include <vector>
+#include <set>
+#include <list>
+#include "IvPDomain.h"
+#include "InfoBuffer.h"
+#include "BehaviorSet.h"
+#include "HelmEngine.h"
+#include "PIDEngine.h"
+#include "PlatModelGenerator.h"
+#include "USM_Model.h"
+#include "NodeRecord.h"
+#include "VarDataPair.h"
+
+//-------------------------------------------------------------------
+// LockstepVehicle: One simulated vehicle with the same stack a MOOS
+// community would run (uSimMarineV22 model, pHelmIvP engine and
+// behavior set, pMarinePIDV22 engine), but with no MOOSDB. Time is
+// handed in by the caller on each step and mail arrives through an
+// in-memory inbox. A vehicle touches no state outside itself during
+// step(), so different vehicles may be stepped on different threads.
+
+class LockstepVehicle {
+public:
+  LockstepVehicle();
+  ~LockstepVehicle();
+
+  // Configuration, from the blocks of a (nsplug-expanded) .moos file
+  bool   setSimParam(std::string param, std::string value);
+  bool   setHelmParam(std::string param, std::string value);
+  void   setPIDParams(std::list<std::string> params);
+  void   setName(std::string s)       {m_vname=s;}
+  void   setPlatformType(std::string s) {m_vtype=s;}
+  void   setGeodesy(double lat, double lon);
+  void   setBehaviorDir(std::string s) {m_bhv_dir=s;}
+
+  bool   initialize(double start_time);
+  void   jitterStart(double dx, double dy);
+
+  // Mail delivered before the next step
+  void   addMail(const std::string& var, const std::string& val);
+  void   addMail(const std::string& var, double val);
+  void   addNodeReport(const NodeRecord& record);
+
+  void   step(double curr_time);
+
+  // Getters
+  std::string  getName() const         {return(m_vname);}
+  NodeRecord   getNodeRecord() const   {return(m_record);}
+  double       getOdometry() const     {return(m_odometry);}
+  unsigned int getHelmIterations() const {return(m_helm_iterations);}
+  unsigned int getAllStops() const     {return(m_allstops);}
+  std::string  getHaltMsg() const      {return(m_halt_msg);}
+  std::vector<std::string> getConfigWarnings() const {return(m_warnings);}
+
+protected:
+  void   deliverMail(double curr_time);
+  void   stepHelm(double curr_time);
+  void   stepPID(double curr_time);
+  void   stepSim(double curr_time);
+
+  void   handleBehaviorMessages();
+  void   handleInitialVariables();
+  void   processNodeReport(const NodeRecord&);
+  bool   handleDomain(std::string);
+
+private: // Configuration variables
+  std::string   m_vname;
+  std::string   m_vtype;
+  std::string   m_bhv_dir;
+  std::set<std::string>    m_bhv_files;
+  std::vector<std::string> m_behavior_dirs;
+  std::list<std::string>   m_pid_params;
+  IvPDomain     m_ivp_domain;
+  double        m_max_speed;
+
+private: // State variables
+  InfoBuffer   *m_info_buffer;
+  BehaviorSet  *m_bhv_set;
+  HelmEngine   *m_hengine;
+
+  PlatModelGenerator m_pmgen;
+  PIDEngine    m_pengine;
+  USM_Model    m_model;
+  NodeRecord   m_record;
+
+  std::vector<VarDataPair> m_inbox;
+  std::vector<NodeRecord>  m_inbox_nodes;
+
+  bool          m_allstop;
+  unsigned int  m_allstops;
+  unsigned int  m_helm_iterations;
+  double        m_odometry;
+  std::string   m_halt_msg;
+
+  std::vector<std::string> m_warnings;
+};
+
+#endif
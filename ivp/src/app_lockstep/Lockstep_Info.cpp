@@ -0,0 +1,108 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: Lockstep_Info.cpp                                    */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cstdlib> 
+#include <iostream>
+#include "ColorParse.h"
+#include "ReleaseInfo.h"
+#include "Lockstep_Info.h"
+
+using namespace std;
+
+//----------------------------------------------------------------
+// Procedure: showSynopsis
+
+void showSynopsis()
+{
+  blk("SYNOPSIS:                                                       ");
+  blk("------------------------------------                            ");
+  blk("  lockstep runs one or more simulated vehicles in one process,  ");
+  blk("  with no MOOSDB, on a discrete simulation clock. Each vehicle  ");
+  blk("  is built from the pHelmIvP, uSimMarineV22 and pMarinePIDV22   ");
+  blk("  blocks of its (nsplug-expanded) .moos file. On each tick all  ");
+  blk("  vehicles step (helm, PID, then sim) and node reports are      ");
+  blk("  routed between them in memory. Runs go as fast as the CPU     ");
+  blk("  allows and, for a given seed, produce the same result every   ");
+  blk("  time. Intended for batch and Monte Carlo runs of missions.    ");
+}
+
+//----------------------------------------------------------------
+// Procedure: showHelpAndExit
+
+void showHelpAndExit()
+{
+  cout << "=====================================================" << endl;
+  cout << "Usage: lockstep file.moos [file.moos ...] [OPTIONS]  " << endl;
+  cout << "=====================================================" << endl;
+  cout << "                                                     " << endl;
+  showSynopsis();
+  cout << "                                                     " << endl;
+  cout << "Options:                                             " << endl;
+  cout << "  --help, -h                                         " << endl;
+  cout << "     Display this help message.                      " << endl;
+  cout << "  --version,-v                                       " << endl;
+  cout << "     Display the release version of lockstep.        " << endl;
+  cout << "  --verbose                                          " << endl;
+  cout << "     Report final state of each vehicle after a run. " << endl;
+  cout << "  --dt=<secs>                                        " << endl;
+  cout << "     Simulation time step (default 0.25).            " << endl;
+  cout << "  --duration=<secs>                                  " << endl;
+  cout << "     Simulated time of each run (default 600).       " << endl;
+  cout << "  --threads=<num>                                    " << endl;
+  cout << "     Number of threads stepping vehicles (default 1)." << endl;
+  cout << "  --runs=<num>                                       " << endl;
+  cout << "     Number of runs (default 1).                     " << endl;
+  cout << "  --seed=<num>                                       " << endl;
+  cout << "     Random seed of the first run (default 1). Run i " << endl;
+  cout << "     uses seed+i.                                    " << endl;
+  cout << "  --jitter=<meters>                                  " << endl;
+  cout << "     Perturb each start position by a random amount  " << endl;
+  cout << "     up to the given distance in x and y (default 0)." << endl;
+  cout << "  --poke=<VAR=VAL>                                   " << endl;
+  cout << "     Post VAR=VAL to all vehicles at time zero, e.g. " << endl;
+  cout << "     --poke=DEPLOY=true. May be given more than once." << endl;
+  cout << "                                                     " << endl;
+  cout << "Examples:                                            " << endl;
+  cout << "  $ lockstep targ_abe.moos targ_ben.moos --poke=DEPLOY=true" << endl;
+  cout << "  $ lockstep targ_*.moos --runs=100 --jitter=20 --threads=4" << endl;
+  cout << "                                                     " << endl;
+  cout << "Notes:                                               " << endl;
+  cout << "  (1) Vehicles see each other only via node reports. " << endl;
+  cout << "      Contact manager alerts, shoreside apps and     " << endl;
+  cout << "      inter-vehicle messages are not simulated.      " << endl;
+  cout << "  (2) Behaviors calling rand() are repeatable only   " << endl;
+  cout << "      with --threads=1.                              " << endl;
+  cout << "  (3) Behavior files are found relative to the dir   " << endl;
+  cout << "      of the .moos file that names them.             " << endl;
+  exit(0);
+}
+
+//----------------------------------------------------------------
+// Procedure: showReleaseInfoAndExit
+
+void showReleaseInfoAndExit()
+{
+  showReleaseInfo("lockstep", "gpl");
+  exit(0);
+}
@@ -1,8 +1,8 @@
 /*****************************************************************/
 /*    NAME: Michael Benjamin                                     */
 /*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
-/*    FILE: RangeMark.h                                          */
-/*    DATE: July 19th, 2020                                      */
+/*    FILE: Lockstep_Info.h                                      */
+/*    DATE: October 19th, 2026                                   */
 /*                                                               */
 /* This file is part of MOOS-IvP                                 */
 /*                                                               */
@@ -21,32 +21,12 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
-#ifndef RANGE_MARK_HEADER
-#define RANGE_MARK_HEADER
+ 
+#ifndef LOCKSTEP_INFO_HEADER
+#define LOCKSTEP_INFO_HEADER
 
-#include <string>
-
-class RangeMark
-{
- public:
-  RangeMark() {m_range=0;}
-  RangeMark(std::string, double);
-  virtual ~RangeMark() {}
-
- public: // Setters
-  void setRangeMark(std::string, double);
-
- public: // Getters
-  double      getRange()   const {return(m_range);}
-  std::string getContact() const {return(m_contact);}
-
- private:
-  double      m_range;
-  std::string m_contact;
-};
-
-bool operator< (const RangeMark& one, const RangeMark& two);
-bool operator== (const RangeMark& one, const RangeMark& two);
-
-#endif 
+void showSynopsis();
+void showHelpAndExit();
+void showReleaseInfoAndExit();
 
+#endif
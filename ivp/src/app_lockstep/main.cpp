@@ -0,0 +1,78 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <iostream>
+#include "MBUtils.h"
+#include "LockstepSim.h"
+#include "Lockstep_Info.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  LockstepSim sim;
+
+  if(argc == 1)
+    showHelpAndExit();
+  
+  for(int i=1; i<argc; i++) {
+    bool   handled = false;
+    string argi = argv[i];
+
+    if((argi=="-v") || (argi=="--version") || (argi=="-version"))
+      showReleaseInfoAndExit();
+    else if((argi=="-h") || (argi == "--help") || (argi=="-help"))
+      showHelpAndExit();
+    else if(argi=="--verbose") {
+      sim.setVerbose(true);
+      handled = true;
+    }
+    else if(strBegins(argi, "--dt="))
+      handled = sim.setTimeStep(argi.substr(5));
+    else if(strBegins(argi, "--duration="))
+      handled = sim.setDuration(argi.substr(11));
+    else if(strBegins(argi, "--threads="))
+      handled = sim.setThreads(argi.substr(10));
+    else if(strBegins(argi, "--runs="))
+      handled = sim.setRuns(argi.substr(7));
+    else if(strBegins(argi, "--seed="))
+      handled = sim.setSeed(argi.substr(7));
+    else if(strBegins(argi, "--jitter="))
+      handled = sim.setJitter(argi.substr(9));
+    else if(strBegins(argi, "--poke="))
+      handled = sim.addPoke(argi.substr(7));
+    else if(strEnds(argi, ".moos") || strEnds(argi, ".moos++"))
+      handled = sim.addMissionFile(argi);
+      
+    if(!handled) {
+      cout << "Unhandled arg: " << argi << endl;
+      return(1);
+    }
+  }
+
+  if(!sim.run())
+    return(1);
+
+  return(0);
+}
@@ -0,0 +1,114 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ExpandCache.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cstdio>
+#include "MBUtils.h"
+#include "FileBuffer.h"
+#include "ExpandCache.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor()
+
+ExpandCache::ExpandCache()
+{
+  m_file_reads = 0;
+  m_file_hits  = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: getLines()
+//   Purpose: Return the parsed lines of the given file, reading it
+//            on first use. The returned reference stays valid for
+//            the life of the cache.
+
+const vector<ExpandLine>& ExpandCache::getLines(const string& filename)
+{
+  map<string, vector<ExpandLine> >::iterator p = m_files.find(filename);
+  if(p != m_files.end()) {
+    m_file_hits++;
+    return(p->second);
+  }
+
+  m_file_reads++;
+  vector<ExpandLine>& lines = m_files[filename];
+
+  vector<string> fvector = fileBuffer(filename);
+  lines.resize(fvector.size());
+  for(unsigned int i=0; i<fvector.size(); i++) {
+    ExpandLine& eline = lines[i];
+    eline.raw  = fvector[i];
+    eline.orig = stripBlankEnds(findReplace(fvector[i], '\t', ' '));
+
+    string line = eline.orig;
+    eline.left = biteStringX(line, ' ');
+    eline.rest = line;
+  }
+  return(lines);
+}
+
+//--------------------------------------------------------
+// Procedure: findFile()
+//      Note: Same search as Expander::findFileInPath. An empty
+//            path means the filename is used as given.
+
+string ExpandCache::findFile(const string& filename,
+			     const vector<string>& path)
+{
+  if(path.size() == 0)
+    return(filename);
+
+  map<string, string>::iterator p = m_found.find(filename);
+  if(p != m_found.end())
+    return(p->second);
+
+  string found;
+  for(unsigned int i=0; (i<path.size()) && (found == ""); i++) {
+    string full_name = (path[i] + "/" + filename);
+    if(readable(full_name))
+      found = full_name;
+  }
+  m_found[filename] = found;
+  return(found);
+}
+
+//--------------------------------------------------------
+// Procedure: readable()
+
+bool ExpandCache::readable(const string& filename)
+{
+  map<string, bool>::iterator p = m_readable.find(filename);
+  if(p != m_readable.end())
+    return(p->second);
+
+  bool ok = false;
+  FILE *f = fopen(filename.c_str(), "r");
+  if(f) {
+    fclose(f);
+    ok = true;
+  }
+  m_readable[filename] = ok;
+  return(ok);
+}
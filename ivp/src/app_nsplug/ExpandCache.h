@@ -0,0 +1,73 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ExpandCache.h                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+ 
+#ifndef EXPAND_CACHE_HEADER
+#define EXPAND_CACHE_HEADER
+
+#include <vector>
+#include <string>
+#include <map>
+
+// A line of an input or #include file, split once into the parts
+// the Expander looks at. The raw line is kept since plain lines are
+// macro expanded and written in their original form.
+
+struct ExpandLine
+{
+  std::string raw;    // Line as read from the file
+  std::string orig;   // Tabs to spaces, blank ends stripped
+  std::string left;   // First word of orig, e.g. "#include"
+  std::string rest;   // Remainder of orig after the first word
+};
+
+// Files read and parsed by the Expander, kept so that a file
+// included many times, or by many variants of the same mission, is
+// only read and split once. Path lookups are cached by name, so a
+// cache should only be shared by Expanders with the same path.
+
+class ExpandCache
+{
+ public:
+  ExpandCache();
+  ~ExpandCache() {}
+
+  const std::vector<ExpandLine>& getLines(const std::string& filename);
+
+  std::string findFile(const std::string& filename,
+		       const std::vector<std::string>& path);
+  bool        readable(const std::string& filename);
+
+  unsigned int getFileReads() const  {return(m_file_reads);}
+  unsigned int getFileHits() const   {return(m_file_hits);}
+
+ private:
+  std::map<std::string, std::vector<ExpandLine> > m_files;
+  std::map<std::string, std::string>              m_found;
+  std::map<std::string, bool>                     m_readable;
+
+  unsigned int m_file_reads;
+  unsigned int m_file_hits;
+};
+
+#endif 
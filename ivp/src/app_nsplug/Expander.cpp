@@ -53,6 +53,8 @@ Expander::Expander(string given_infile, string given_outfile)
 
   m_interactive = false;
   m_impatient = false;
+
+  m_cache = shared_ptr<ExpandCache>(new ExpandCache());
 }
 
 //--------------------------------------------------------
@@ -84,6 +86,8 @@ bool Expander::expand()
 //      Note: inctag added Sep 20th, 2020 to support lines like
 //            #include filename <inctag> which will only include
 //            part of the named file
+//      Note: Files are read and split into words once, through
+//            the ExpandCache, however many times they are included.
 
 vector<string> Expander::expandFile(string filename, 
 				    map<string, string>& macros, 
@@ -93,7 +97,7 @@ vector<string> Expander::expandFile(string filename,
   vector<string> return_vector;
   vector<string> empty_vector;
 
-  vector<string> fvector = fileBuffer(filename);
+  const vector<ExpandLine>& fvector = m_cache->getLines(filename);
 
   unsigned int i, vsize = fvector.size();
   if(vsize == 0) {
@@ -108,10 +112,9 @@ vector<string> Expander::expandFile(string filename,
   
   for(i=0; i<vsize; i++) {
 
-    string line = stripBlankEnds(findReplace(fvector[i], '\t', ' '));
-    string line_orig = line;
-    string left = biteStringX(line, ' ');
-    string rest = line;
+    const string& line_orig = fvector[i].orig;
+    const string& left = fvector[i].left;
+    string rest = fvector[i].rest;
 
     // Begin tag support, added Sep 2020
     if(strBegins(line_orig, "<tag>")) {
@@ -214,7 +217,7 @@ vector<string> Expander::expandFile(string filename,
 	file_str = stripQuotes(file_str);
       string full_file_str = findFileInPath(file_str);
 
-      if(!verifyInfile(full_file_str)) {
+      if(!m_cache->readable(full_file_str)) {
 	cout << "#  Error in file " << filename << " line:" << i+1 << endl;
 	cout << "#  The #include file \"" << file_str << "\" not found." << endl;
 	result = false;
@@ -270,12 +273,13 @@ vector<string> Expander::expandFile(string filename,
       }
     }
     else if(!skipLines()) {
-      applyMacrosToLine(fvector[i], macros, i+1);
-      return_vector.push_back(fvector[i]);
+      string raw = fvector[i].raw;
+      applyMacrosToLine(raw, macros, i+1);
+      return_vector.push_back(raw);
     }   
 
 #if 0 // BEGIN DEBUGGING OUTPUT BLOCK
-    string pline = fvector[i];
+    string pline = fvector[i].raw;
     if(pline.length() > 0)
       pline.at(pline.length()-1) = '\0';
 
@@ -337,6 +341,32 @@ bool Expander::writeOutput()
     return(true);
   }
   
+  if(!checkOutput())
+    return(false);
+
+  // Fourth abort condition: Output file cannot be written to
+  // created or overwritten. Tests: !fopen(w), 
+
+  if(!writeLines()) {
+    cout << "Aborted: The file [" << m_outfile;
+    cout << "] cannot be written to" << endl;
+    return(false);
+  }
+
+  if (!m_force)
+      cout << "...successfully completed" << endl;
+  
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: checkOutput()
+//   Purpose: Check that the output file may be written, asking
+//            the user before replacing an existing file unless
+//            forced. Nothing is written here.
+
+bool Expander::checkOutput()
+{
   //  Abort condition: Output file exists but cannot
   //  be overwritten. tests:  fopen(r), !fopen(r+)
 
@@ -378,25 +408,25 @@ bool Expander::writeOutput()
       }
     }
   }
+  return(true);
+}
 
-  // Fourth abort condition: Output file cannot be written to
-  // created or overwritten. Tests: !fopen(w), 
+//--------------------------------------------------------
+// Procedure: writeLines()
+//   Purpose: Write the expanded lines to the output file. Nothing
+//            is printed, so that several Expanders may write their
+//            files from separate threads.
 
-  f = fopen(m_outfile.c_str(), "w");
-  if(!f) {
-    cout << "Aborted: The file [" << m_outfile;
-    cout << "] cannot be written to" << endl;
+bool Expander::writeLines() const
+{
+  FILE *f = fopen(m_outfile.c_str(), "w");
+  if(!f)
     return(false);
-  }
 
   for(unsigned int i=0; i<m_newlines.size(); i++)
     fprintf(f, "%s\n", m_newlines[i].c_str());
 
   fclose(f);
-
-  if (!m_force)
-      cout << "...successfully completed" << endl;
-  
   return(true);
 }
 
@@ -417,10 +447,10 @@ void Expander::addPath(string str)
 // Procedure: applyMacrosToLine()
 
 bool Expander::applyMacrosToLine(string& line, 
-				 map<string, string> macros,
+				 const map<string, string>& macros,
 				 unsigned int line_num)
 {
-  map<string, string>::iterator p;
+  map<string, string>::const_iterator p;
 
   if(stripBlankEnds(line) == "")
     return(true);
@@ -518,19 +548,7 @@ string Expander::containsMacro(string line)
 
 string Expander::findFileInPath(string filename)
 {
-  unsigned int i, vsize = m_path.size();
-  if(vsize == 0)
-    return(filename);
-
-  for(i=0; i<vsize; i++) {
-    string full_name = (m_path[i] + "/" + filename);
-    FILE *f = fopen(full_name.c_str(), "r");
-    if(f) {
-      fclose(f);
-      return(full_name);
-    }
-  }
-  return("");
+  return(m_cache->findFile(filename, m_path));
 }
 
 //--------------------------------------------------------
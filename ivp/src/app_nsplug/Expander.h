@@ -27,7 +27,9 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
 #include "MacroUtils.h"
+#include "ExpandCache.h"
 
 class Expander
 {
@@ -44,6 +46,8 @@ class Expander
   bool verifyInfile();
   bool verifyInfile(const std::string& filename);
   bool writeOutput();
+  bool checkOutput();
+  bool writeLines() const;
   void addMacro(std::string, std::string, bool=false);
   void setForce(bool v)      {m_force=v;}
   void setStrict(bool v)     {m_strict=v;}
@@ -53,6 +57,13 @@ class Expander
   void setImpatient(bool v)   {m_impatient=v;}
   void addPath(std::string);
 
+  void setCache(std::shared_ptr<ExpandCache> cache) {m_cache=cache;}
+  std::shared_ptr<ExpandCache> getCache() const {return(m_cache);}
+
+  std::string getOutFile() const {return(m_outfile);}
+  bool        getTerminal() const {return(m_terminal);}
+  bool        getForce() const    {return(m_force);}
+
  protected:
   std::vector<std::string> 
     expandFile(std::string filename,
@@ -61,7 +72,7 @@ class Expander
 	       std::string inctag, bool& result);
   
   bool applyMacrosToLine(std::string&, 
-			 std::map<std::string, std::string>,
+			 const std::map<std::string, std::string>&,
 			 unsigned int line_num);
 
   std::string containsMacro(std::string);
@@ -108,6 +119,10 @@ class Expander
 
   bool m_interactive;
   bool m_impatient;
+
+  // Parsed files and path lookups, shared by the Expanders of
+  // one multi-variant run
+  std::shared_ptr<ExpandCache> m_cache;
 };
 
 #endif 
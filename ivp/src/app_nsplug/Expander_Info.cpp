@@ -84,12 +84,23 @@ void showHelpAndExit()
   blk("      Multiple files may be provided.                           ");
   blk("      IMPORTANT NOTE: Macros defined in earlier files will be   ");
   blk("            expanded if referenced in later files.              ");
+  mag("  --variants","=<file>                                             ");
+  blk("      Generate many output files from the one input file. Each  ");
+  blk("      line of the given file names an output file followed by   ");
+  blk("      macros for that file, e.g. targ_abe.moos VNAME=abe MODEM. ");
+  blk("      These are applied after macros given on the command line. ");
+  blk("      Included files are read once for all variants. No output  ");
+  blk("      file is given on the command line in this mode.           ");
+  mag("  --jobs","=<num>                                                  ");
+  blk("      Number of threads used to write variant files. The        ");
+  blk("      default is the number of available cores.                 ");
   blk("  MACRO=VAL                                                     ");
   blk("      Apply the given macro to be expanded in the output.       ");
   blk("                                                                ");
   blk("Note: Input file is expected as the first argument, argv[1]     ");
   blk("      Output file is expected as the second argument, argv[2].  ");
-  blk("      An input file and output file both must be provided.      ");
+  blk("      An input file and output file both must be provided,      ");
+  blk("      unless the output files are given with --variants.        ");
   blk("                                                                ");
   exit(0);
 }
@@ -146,8 +157,22 @@ void showManualAndExit()
   cout << "--macros=<file>                                                   " << endl;
   cout << "   Add macros in given file, one per line. Multiple macro files   " << endl;
   cout << "   may be provided.                                               " << endl;
-  cout << "                                                                  " << endl;
-  cout << "MACRO=VALUE                                                       " << endl;
+  cout << "--variants=<file>                                                 " << endl;
+  cout << "   Generate many output files from the one input file in a single " << endl;
+  cout << "   run. Each line of the file names an output file followed by    " << endl;
+  cout << "   the macros for that file, given as on the command line:        " << endl;
+  cout << "                                                                  " << endl;
+  cout << "     targ_abe.moos  VNAME=abe  START_POS=0,0   MODEM              " << endl;
+  cout << "     targ_ben.moos  VNAME=ben  START_POS=20,0  COLOR=\"dark blue\"  " << endl;
+  cout << "                                                                  " << endl;
+  cout << "   Each output is the same as that of a separate run with the     " << endl;
+  cout << "   variant macros added to the end of the command line. Included  " << endl;
+  cout << "   files are read once for all variants.                          " << endl;
+  cout << "--jobs=<num>                                                      " << endl;
+  cout << "   Number of threads used to write variant files. The default is  " << endl;
+  cout << "   the number of available cores.                                 " << endl;
+  cout << "                                                                  " << endl;
+  cout << "MACRO=VALUE                                                     " << endl;
   cout << "   Define the given macro with the given value and apply it to    " << endl;
   cout << "   all instances in the file expansion.                           " << endl;
   cout << "                                                                  " << endl;
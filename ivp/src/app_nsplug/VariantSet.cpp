@@ -0,0 +1,243 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: VariantSet.cpp                                       */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <iostream>
+#include <thread>
+#include "MBUtils.h"
+#include "FileBuffer.h"
+#include "VariantSet.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor()
+
+VariantSet::VariantSet(const Expander& base) : m_base(base)
+{
+  m_jobs = thread::hardware_concurrency();
+  if(m_jobs == 0)
+    m_jobs = 1;
+}
+
+//--------------------------------------------------------
+// Procedure: readTable()
+//   Purpose: Read the variants table, one variant per line. Blank
+//            lines and lines beginning with // or # are ignored.
+
+bool VariantSet::readTable(string filename)
+{
+  if(!okFileToRead(filename)) {
+    cout << "Aborted: The variants file " << filename;
+    cout << " cannot be read." << endl;
+    return(false);
+  }
+
+  vector<string> lines = fileBuffer(filename);
+  for(unsigned int i=0; i<lines.size(); i++) {
+    string line = stripBlankEnds(lines[i]);
+    if((line == "") || strBegins(line, "//") || strBegins(line, "#"))
+      continue;
+    if(!handleLine(line, i+1))
+      return(false);
+  }
+
+  if(m_expanders.size() == 0) {
+    cout << "Aborted: No variants found in " << filename << endl;
+    return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handleLine()
+//   Purpose: Parse one variant: an output file followed by macros
+//            given as on the command line, MACRO=VAL or MACRO.
+//            Values with spaces may be double-quoted.
+
+bool VariantSet::handleLine(string line, unsigned int line_num)
+{
+  vector<string> svector;
+  if(!splitLine(line, svector) || (svector.size() == 0)) {
+    cout << "Aborted: Unbalanced quotes in variants line ";
+    cout << line_num << endl;
+    return(false);
+  }
+
+  string outfile = svector[0];
+  if(vectorContains(m_outfiles, outfile)) {
+    cout << "Aborted: Output file " << outfile << " named twice in ";
+    cout << "variants, line " << line_num << endl;
+    return(false);
+  }
+
+  // A copy shares the base cache, so each file is read only once
+  Expander expander = m_base;
+  expander.setOutFile(outfile);
+  for(unsigned int i=1; i<svector.size(); i++) {
+    string arg = svector[i];
+    if(strContains(arg, '=')) {
+      string left  = biteStringX(arg, '=');
+      string right = arg;
+      expander.addMacro(left, right);
+    }
+    else
+      expander.addMacro(arg, "<defined>");
+  }
+
+  m_expanders.push_back(expander);
+  m_outfiles.push_back(outfile);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: splitLine()
+//   Purpose: Split a variants line into words as the shell would
+//            split a command line: on blanks outside double quotes.
+//            Quoted text is kept as is, without the quotes, so that
+//            MSG="x  y" gives the same macro as it would if given
+//            on the command line. Returns false on unbalanced quotes.
+
+bool VariantSet::splitLine(const string& line, vector<string>& words) const
+{
+  string word;
+  bool   in_word   = false;
+  bool   in_quotes = false;
+  for(unsigned int i=0; i<line.length(); i++) {
+    char c = line[i];
+    if(c == '"') {
+      in_quotes = !in_quotes;
+      in_word = true;
+    }
+    else if(!in_quotes && ((c == ' ') || (c == '\t'))) {
+      if(in_word)
+	words.push_back(word);
+      word = "";
+      in_word = false;
+    }
+    else {
+      word += c;
+      in_word = true;
+    }
+  }
+  if(in_quotes)
+    return(false);
+  if(in_word)
+    words.push_back(word);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: expand()
+//   Purpose: Expand each variant in table order. Returns false if
+//            any variant failed, after trying all of them.
+
+bool VariantSet::expand()
+{
+  bool all_ok = true;
+  m_expanded.clear();
+  for(unsigned int i=0; i<m_expanders.size(); i++) {
+    bool ok = m_expanders[i].expand();
+    if(!ok)
+      cout << "#  (Variant " << m_outfiles[i] << ")" << endl;
+    m_expanded.push_back(ok);
+    all_ok = all_ok && ok;
+  }
+  return(all_ok);
+}
+
+//--------------------------------------------------------
+// Procedure: writeOutput()
+//   Purpose: Write all successfully expanded variants. Checks for
+//            existing files, and any prompts, are done in table
+//            order before the files are written in parallel.
+
+bool VariantSet::writeOutput()
+{
+  unsigned int vsize = m_expanders.size();
+  m_to_write = vector<bool>(vsize, false);
+  m_write_ok = vector<int>(vsize, 0);
+
+  bool all_ok = true;
+  for(unsigned int i=0; i<vsize; i++) {
+    if(!m_expanded[i])
+      all_ok = false;
+    else if(m_expanders[i].getTerminal())
+      m_expanders[i].writeOutput();
+    else if(m_expanders[i].checkOutput())
+      m_to_write[i] = true;
+    else
+      all_ok = false;
+  }
+
+  unsigned int jobs = m_jobs;
+  if(jobs > vsize)
+    jobs = vsize;
+  if(jobs <= 1)
+    writeLoop(0);
+  else {
+    vector<thread> workers;
+    for(unsigned int i=0; i<jobs; i++)
+      workers.push_back(thread(&VariantSet::writeLoop, this, i));
+    for(unsigned int i=0; i<workers.size(); i++)
+      workers[i].join();
+  }
+
+  unsigned int written = 0;
+  for(unsigned int i=0; i<vsize; i++) {
+    if(!m_to_write[i])
+      continue;
+    if(m_write_ok[i])
+      written++;
+    else {
+      cout << "Aborted: The file [" << m_outfiles[i];
+      cout << "] cannot be written to" << endl;
+      all_ok = false;
+    }
+  }
+
+  if(!m_base.getForce() || !all_ok) {
+    cout << "...wrote " << written << " of " << vsize;
+    cout << " variant files" << endl;
+  }
+  return(all_ok);
+}
+
+//--------------------------------------------------------
+// Procedure: writeLoop()
+//      Note: Variants are split statically, i % jobs, so no two
+//            workers touch the same entry of m_write_ok.
+
+void VariantSet::writeLoop(unsigned int worker_ix)
+{
+  unsigned int jobs = m_jobs;
+  if(jobs > m_expanders.size())
+    jobs = m_expanders.size();
+  if(jobs == 0)
+    jobs = 1;
+
+  for(unsigned int i=worker_ix; i<m_expanders.size(); i+=jobs) {
+    if(m_to_write[i])
+      m_write_ok[i] = m_expanders[i].writeLines() ? 1 : 0;
+  }
+}
@@ -0,0 +1,81 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: VariantSet.h                                         */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+ 
+#ifndef VARIANT_SET_HEADER
+#define VARIANT_SET_HEADER
+
+#include <vector>
+#include <string>
+#include "Expander.h"
+
+// Expands one input file into many outputs, one per line of a
+// variants table:
+//
+//   // outfile     macros
+//   targ_abe.moos  VNAME=abe  START_POS=0,0   MODEM
+//   targ_ben.moos  VNAME=ben  START_POS=20,0  COLOR="dark blue"
+//
+// Each variant is a copy of a base Expander, configured from the
+// command line, with the variant macros added last. An output is
+// thus the same as that of "nsplug infile outfile <args> <macros>".
+// All variants share one ExpandCache. Expansion is done in table
+// order so that warnings read as they would from separate runs.
+// The files are then written by a pool of threads, each taking
+// every jobs-th variant.
+
+class VariantSet
+{
+ public:
+  VariantSet(const Expander& base);
+  ~VariantSet() {}
+
+  bool readTable(std::string filename);
+  void setJobs(unsigned int v) {m_jobs=v;}
+
+  bool expand();
+  bool writeOutput();
+
+  unsigned int size() const {return(m_expanders.size());}
+
+ protected:
+  bool handleLine(std::string line, unsigned int line_num);
+  bool splitLine(const std::string& line,
+		 std::vector<std::string>& words) const;
+  void writeLoop(unsigned int worker_ix);
+
+ private:
+  Expander                  m_base;
+  std::vector<Expander>     m_expanders;
+  std::vector<std::string>  m_outfiles;
+
+  // Per variant status. m_write_ok is an int per variant rather
+  // than vector<bool> since the writer threads set it concurrently.
+  std::vector<bool>         m_expanded;
+  std::vector<bool>         m_to_write;
+  std::vector<int>          m_write_ok;
+
+  unsigned int m_jobs;
+};
+
+#endif 
@@ -29,6 +29,7 @@
 #include "ColorParse.h"
 #include "Expander.h"
 #include "Expander_Info.h"
+#include "VariantSet.h"
 #include "MBUtils.h"
 #include "ReleaseInfo.h"
 
@@ -45,6 +46,9 @@ int main(int argc, char *argv[])
 
   bool input_file_provided  = false;
   bool output_file_provided = false;
+
+  string variants_file;
+  unsigned int jobs = 0;
   
   for(int i=1; i<argc; i++) {
     string arg = argv[i];
@@ -76,6 +80,14 @@ int main(int argc, char *argv[])
 
     else if(strBegins(arg, "--macros="))
       expander.addMacroFile(arg.substr(9));
+    else if(strBegins(arg, "--variants="))
+      variants_file = arg.substr(11);
+    else if(strBegins(arg, "--jobs=")) {
+      if(!setPosUIntOnString(jobs, arg.substr(7))) {
+	cout << "Aborted: Bad jobs value: " << arg << endl;
+	exit(EXIT_FAILURE);
+      }
+    }
  
     else if(((arg=="-t") || (arg=="--terminal")))
       expander.setTerminal(true);
@@ -103,6 +115,29 @@ int main(int argc, char *argv[])
     exit(EXIT_FAILURE);
   }
 
+  // Multi-variant mode: output files and macros come from the table
+  if(variants_file != "") {
+    if(!expander.verifyInfile()) {
+      cout << "Aborted: " << argv[1] << " cannot be opened. " << endl;
+      exit(EXIT_FAILURE);
+    }
+    if(output_file_provided) {
+      cout << "Aborted: An output file may not be given with ";
+      cout << "--variants" << endl;
+      exit(EXIT_FAILURE);
+    }
+    VariantSet variants(expander);
+    if(jobs > 0)
+      variants.setJobs(jobs);
+    if(!variants.readTable(variants_file))
+      exit(EXIT_FAILURE);
+    bool ok = variants.expand();
+    ok = variants.writeOutput() && ok;
+    if(!ok)
+      exit(EXIT_FAILURE);
+    return(0);
+  }
+
   if(!output_file_provided) {
     cout << "Aborted: An output file must be provided" << endl;
     exit(EXIT_FAILURE);
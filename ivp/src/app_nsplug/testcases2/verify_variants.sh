@@ -0,0 +1,102 @@
+#!/bin/bash
+#-------------------------------------------------------------- 
+#   Script: verify_variants.sh    
+#   Author: Michael Benjamin   
+#   LastEd: October 2026
+#-------------------------------------------------------------- 
+#  Part 1: Define a convenience function for producing terminal
+#          debugging/status output depending on the verbosity.
+#-------------------------------------------------------------- 
+vecho() { if [ "$VERBOSE" != "" ]; then echo "$ME: $1"; fi }
+
+#-------------------------------------------------------------- 
+#  Part 2: Set Global variables
+#-------------------------------------------------------------- 
+ME=`basename "$0"`
+VERBOSE=""
+META_FILE="variants_meta.txt"
+TABLE_FILE="variants_table.txt"
+ALL_OK="yes"
+
+#-------------------------------------------------------
+#  Part 3: Check for and handle command-line arguments
+#-------------------------------------------------------
+for ARGI; do
+    if [ "${ARGI}" = "--help" -o "${ARGI}" = "-h" ]; then
+	echo "$ME: [OPTIONS]                                      "
+	echo "                                                    "
+	echo "Expands $META_FILE once with --variants=$TABLE_FILE "
+	echo "and once per line of the table with the macros on   "
+	echo "the command line. Each pair of outputs must be      "
+	echo "byte-identical.                                     "
+	echo "                                                    "
+	echo "Options:                                            "
+        echo "  --help, -h                                        "
+        echo "    Display this help message                       "
+        echo "  --verbose, -v                                     "
+        echo "    Display verbose output                          "
+	exit 0;
+    elif [ "${ARGI}" = "--verbose" -o "${ARGI}" = "-v" ]; then
+	VERBOSE="--verbose"
+    else 
+	echo "$ME: Bad Arg: $ARGI. Exit Code 1."
+	exit 1
+    fi
+done
+
+#-------------------------------------------------------
+#  Part 4: Work in a temp dir with copies of the inputs
+#-------------------------------------------------------
+HERE=`pwd`
+TMP_DIR=`mktemp -d`
+cp $META_FILE variants_inc.txt $TABLE_FILE $TMP_DIR
+cd $TMP_DIR
+mkdir single
+
+#-------------------------------------------------------
+#  Part 5: Expand all variants in one run, on two threads
+#-------------------------------------------------------
+vecho "nsplug $META_FILE --variants=$TABLE_FILE --jobs=2 -f"
+nsplug $META_FILE --variants=$TABLE_FILE --jobs=2 -f > variants_out.txt
+if [ $? != 0 ]; then
+    echo "[FAIL] nsplug --variants"
+    ALL_OK="no"
+fi
+
+#-------------------------------------------------------
+#  Part 6: Expand each variant in its own run. The table line
+#          is split by the shell, as a command line would be.
+#-------------------------------------------------------
+while read -r line;
+do
+    if [[ -z "${line//[[:space:]]}" ]]; then
+	continue
+    elif [ "${line:0:2}" = "//" -o "${line:0:1}" = "#" ]; then
+	continue
+    fi
+
+    eval "set -- $line"
+    OUT_FILE=$1
+    shift
+    echo -n "Testing variant:[$OUT_FILE]"
+    
+    vecho "nsplug $META_FILE single/$OUT_FILE $@ -f"
+    nsplug $META_FILE single/$OUT_FILE "$@" -f > /dev/null
+
+    if cmp -s $OUT_FILE single/$OUT_FILE; then
+	echo "[Success]"
+    else
+	echo "[FAIL]"
+	ALL_OK="no"
+	diff $OUT_FILE single/$OUT_FILE
+    fi
+done < $TABLE_FILE
+
+cd $HERE
+rm -rf $TMP_DIR
+
+if [ "${ALL_OK}" = "no" ]; then
+    exit 1
+fi
+
+exit 0
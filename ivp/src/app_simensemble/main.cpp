@@ -0,0 +1,468 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: main.cpp                                             */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <iostream>
+#include "MBUtils.h"
+#include "AngleUtils.h"
+#include "SimEngine.h"
+#include "SimEnsemble.h"
+#include "CurrentField.h"
+#include "CurrentGrid.h"
+
+using namespace std;
+
+void showHelpAndExit();
+
+//--------------------------------------------------------
+// Per-run settings shared by the ensemble and the per-record path
+
+struct RunConfig
+{
+  double delta_time;
+  double turn_rate;
+  double rotate_speed;
+  double max_accel;
+  double max_decel;
+  double buoyancy_rate;
+  double max_depth_rate;
+  double max_depth_rate_speed;
+  bool   diff_mode;
+  bool   reverse;
+};
+
+//--------------------------------------------------------
+// Procedure: randVal()
+
+double randVal(double low, double high)
+{
+  return(low + ((high - low) * (double)(rand()) / RAND_MAX));
+}
+
+//--------------------------------------------------------
+// Procedure: propagateRecord()
+//   Purpose: One step of a single record, done the way
+//            USM_Model::propagateNodeRecord() does it with
+//            external forces applied.
+
+void propagateRecord(SimEngine& engine, NodeRecord& record,
+		     const ThrustMap& tmap, const RunConfig& cfg,
+		     double thrust, double rudder, double elevator,
+		     double thrust_lft, double thrust_rgt,
+		     double drift_x, double drift_y,
+		     const CurrentField *field, const CurrentGrid *grid)
+{
+  double dt = cfg.delta_time;
+  double prior_spd = record.getSpeed();
+  double prior_hdg = record.getHeading();
+
+  engine.setThrustModeReverse(cfg.reverse);
+  if(cfg.diff_mode) {
+    engine.propagateSpeedDiffMode(record, tmap, dt, thrust_lft, thrust_rgt,
+				  cfg.max_accel, cfg.max_decel);
+    engine.propagateHeadingDiffMode(record, dt, thrust_lft, thrust_rgt,
+				    cfg.turn_rate, cfg.rotate_speed);
+  }
+  else {
+    engine.propagateSpeed(record, tmap, dt, thrust, rudder,
+			  cfg.max_accel, cfg.max_decel);
+    engine.propagateHeading(record, dt, rudder, thrust,
+			    cfg.turn_rate, cfg.rotate_speed);
+  }
+  engine.propagateDepth(record, dt, elevator, cfg.buoyancy_rate,
+			cfg.max_depth_rate, cfg.max_depth_rate_speed);
+
+  if(cfg.reverse) {
+    record.setHeading(angle360(record.getHeading()+180));
+    record.setHeadingOG(angle360(record.getHeadingOG()+180));
+    double pi = 3.1415926;
+    double new_yaw = record.getYaw() + pi;
+    if(new_yaw > (2* pi))
+      new_yaw = new_yaw - (2 * pi);
+    record.setYaw(new_yaw);
+  }
+
+  if(field) {
+    double fx, fy;
+    field->getLocalForce(record.getX(), record.getY(), fx, fy);
+    drift_x = drift_x + fx;
+    drift_y = drift_y + fy;
+  }
+  if(grid) {
+    double fx, fy;
+    grid->getLocalForce(record.getX(), record.getY(),
+			record.getTimeStamp(), fx, fy);
+    drift_x = drift_x + fx;
+    drift_y = drift_y + fy;
+  }
+  engine.propagate(record, dt, prior_hdg, prior_spd, drift_x, drift_y);
+}
+
+//--------------------------------------------------------
+// Procedure: recordDiff()
+//   Purpose: Largest absolute difference over the propagated fields
+
+double recordDiff(const NodeRecord& a, const NodeRecord& b)
+{
+  double vals[10];
+  vals[0] = a.getX() - b.getX();
+  vals[1] = a.getY() - b.getY();
+  vals[2] = a.getHeading() - b.getHeading();
+  vals[3] = a.getSpeed() - b.getSpeed();
+  vals[4] = a.getDepth() - b.getDepth();
+  vals[5] = a.getPitch() - b.getPitch();
+  vals[6] = a.getYaw() - b.getYaw();
+  vals[7] = a.getSpeedOG() - b.getSpeedOG();
+  vals[8] = a.getHeadingOG() - b.getHeadingOG();
+  vals[9] = a.getTimeStamp() - b.getTimeStamp();
+
+  double max_diff = 0;
+  for(unsigned int i=0; i<10; i++) {
+    if(fabs(vals[i]) > max_diff)
+      max_diff = fabs(vals[i]);
+  }
+  return(max_diff);
+}
+
+//--------------------------------------------------------
+// Procedure: eddyField()
+//   Purpose: A synthetic field of vectors circling the origin on a
+//            grid, for runs without a current field file.
+
+CurrentField eddyField(double strength)
+{
+  CurrentField field;
+  field.setRadius(60);
+  for(double x=-200; x<=200; x+=40) {
+    for(double y=-200; y<=200; y+=40) {
+      double dist = hypot(x, y);
+      if(dist == 0)
+	continue;
+      double mag = strength * exp(-dist / 200);
+      XYVector vect(x, y);
+      vect.setVectorXY(-mag * y / dist, mag * x / dist);
+      field.addVector(vect);
+    }
+  }
+  field.buildIndex();
+  return(field);
+}
+
+//--------------------------------------------------------
+// Procedure: main
+
+int main(int argc, char *argv[])
+{ 
+  RunConfig cfg;
+  cfg.delta_time   = 0.1;
+  cfg.turn_rate    = 70;
+  cfg.rotate_speed = 0;
+  cfg.max_accel    = 0;
+  cfg.max_decel    = 0.5;
+  cfg.buoyancy_rate  = 0.025;
+  cfg.max_depth_rate = 0.5;
+  cfg.max_depth_rate_speed = 2.0;
+  cfg.diff_mode    = false;
+  cfg.reverse      = false;
+
+  unsigned int members = 1000;
+  unsigned int steps   = 600;
+  unsigned int seed    = 1;
+  double thrust   = 50;
+  double rudder   = 10;
+  double elevator = 0;
+  double spread   = 10;
+  double drift_x  = 0;
+  double drift_y  = 0;
+  double drift_spread = 0;
+  double eddy     = 0;
+  string current_file;
+  string grid_file;
+  bool   verify   = true;
+  bool   csv      = false;
+
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i]; 
+    bool handled = true;
+    if((argi == "-h") || (argi == "--help"))
+      showHelpAndExit();
+    else if(strBegins(argi, "--members="))
+      handled = setUIntOnString(members, argi.substr(10));
+    else if(strBegins(argi, "--steps="))
+      handled = setUIntOnString(steps, argi.substr(8));
+    else if(strBegins(argi, "--dt="))
+      handled = setPosDoubleOnString(cfg.delta_time, argi.substr(5));
+    else if(strBegins(argi, "--thrust="))
+      handled = setDoubleOnString(thrust, argi.substr(9));
+    else if(strBegins(argi, "--rudder="))
+      handled = setDoubleOnString(rudder, argi.substr(9));
+    else if(strBegins(argi, "--elevator="))
+      handled = setDoubleOnString(elevator, argi.substr(11));
+    else if(strBegins(argi, "--spread="))
+      handled = setNonNegDoubleOnString(spread, argi.substr(9));
+    else if(strBegins(argi, "--drift_x="))
+      handled = setDoubleOnString(drift_x, argi.substr(10));
+    else if(strBegins(argi, "--drift_y="))
+      handled = setDoubleOnString(drift_y, argi.substr(10));
+    else if(strBegins(argi, "--drift_spread="))
+      handled = setNonNegDoubleOnString(drift_spread, argi.substr(15));
+    else if(strBegins(argi, "--current="))
+      current_file = argi.substr(10);
+    else if(strBegins(argi, "--grid="))
+      grid_file = argi.substr(7);
+    else if(strBegins(argi, "--eddy="))
+      handled = setNonNegDoubleOnString(eddy, argi.substr(7));
+    else if(strBegins(argi, "--turn_rate="))
+      handled = setNonNegDoubleOnString(cfg.turn_rate, argi.substr(12));
+    else if(strBegins(argi, "--seed="))
+      handled = setUIntOnString(seed, argi.substr(7));
+    else if(argi == "--diff")
+      cfg.diff_mode = true;
+    else if(argi == "--reverse")
+      cfg.reverse = true;
+    else if(argi == "--noverify")
+      verify = false;
+    else if(argi == "--csv")
+      csv = true;
+    else
+      handled = false;
+
+    if(!handled) {
+      cout << "Bad Arg:[" << argi << "]. Exiting." << endl;
+      exit(1);
+    }    
+  }
+  if(members == 0)
+    members = 1;
+  srand(seed);
+
+  CurrentField field;
+  bool field_set = false;
+  if(current_file != "") {
+    if(!field.populate(current_file)) {
+      cout << "Unable to read current file: " << current_file << endl;
+      exit(1);
+    }
+    field_set = true;
+  }
+  else if(eddy > 0) {
+    field = eddyField(eddy);
+    field_set = true;
+  }
+
+  CurrentGrid grid;
+  if(grid_file != "") {
+    if(!grid.readBinary(grid_file)) {
+      cout << "Unable to read current grid: " << grid_file << endl;
+      exit(1);
+    }
+  }
+  bool grid_set = (grid.frames() > 0);
+
+  ThrustMap tmap;
+  tmap.setThrustFactor(20);
+
+  //===================================================================
+  // Part 1: Perturbed initial states and inputs
+  //===================================================================
+  vector<NodeRecord> records(members);
+  vector<double> thrusts(members), rudders(members), elevators(members);
+  vector<double> lfts(members), rgts(members);
+  vector<double> dxs(members), dys(members);
+  for(unsigned int i=0; i<members; i++) {
+    NodeRecord record;
+    record.setX(randVal(-100, 100));
+    record.setY(randVal(-100, 100));
+    record.setHeading(randVal(0, 360));
+    record.setSpeed(randVal(0, 3));
+    record.setDepth(randVal(0, 5));
+    record.setPitch(0);
+    record.setYaw(0);
+    record.setSpeedOG(0);
+    record.setHeadingOG(0);
+    record.setTimeStamp(0);
+    records[i] = record;
+
+    thrusts[i]   = thrust + randVal(-spread, spread);
+    rudders[i]   = rudder + randVal(-spread, spread);
+    elevators[i] = elevator + randVal(-spread, spread);
+    lfts[i] = thrusts[i] + rudders[i];
+    rgts[i] = thrusts[i] - rudders[i];
+    dxs[i]  = drift_x + randVal(-drift_spread, drift_spread);
+    dys[i]  = drift_y + randVal(-drift_spread, drift_spread);
+  }
+
+  SimEnsemble ensemble;
+  ensemble.resize(members);
+  ensemble.setThrustMap(tmap);
+  ensemble.setThrustModeDiff(cfg.diff_mode);
+  ensemble.setThrustModeReverse(cfg.reverse);
+  ensemble.setTurnRate(cfg.turn_rate);
+  ensemble.setRotateSpeed(cfg.rotate_speed);
+  ensemble.setMaxAcceleration(cfg.max_accel);
+  ensemble.setMaxDeceleration(cfg.max_decel);
+  ensemble.setBuoyancyRate(cfg.buoyancy_rate);
+  ensemble.setMaxDepthRate(cfg.max_depth_rate);
+  ensemble.setMaxDepthRateSpeed(cfg.max_depth_rate_speed);
+  if(field_set)
+    ensemble.setCurrentField(field);
+  if(grid_set)
+    ensemble.setCurrentGrid(grid);
+  for(unsigned int i=0; i<members; i++) {
+    ensemble.setMember(i, records[i]);
+    ensemble.setThrust(i, thrusts[i]);
+    ensemble.setRudder(i, rudders[i]);
+    ensemble.setElevator(i, elevators[i]);
+    ensemble.setThrustLeft(i, lfts[i]);
+    ensemble.setThrustRight(i, rgts[i]);
+    ensemble.setDrift(i, dxs[i], dys[i]);
+  }
+
+  //===================================================================
+  // Part 2: Propagate the ensemble
+  //===================================================================
+  clock_t start = clock();
+  for(unsigned int s=0; s<steps; s++)
+    ensemble.propagate(cfg.delta_time);
+  double secs_batch = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  cout << "Members: " << members << ", steps: " << steps;
+  cout << ", dt: " << doubleToStringX(cfg.delta_time) << endl;
+  cout << "Current field: " << boolToString(field_set);
+  cout << ", current grid: " << boolToString(grid_set) << endl;
+  cout << "Ensemble time: " << doubleToString(secs_batch, 4) << " secs (";
+  cout << doubleToString((secs_batch*1e9) / ((double)(members)*steps), 1);
+  cout << " ns per member step)" << endl;
+
+  //===================================================================
+  // Part 3: Propagate each record separately and compare
+  //===================================================================
+  if(verify) {
+    SimEngine engine;
+    const CurrentField *fptr = field_set ? &field : 0;
+    const CurrentGrid  *gptr = grid_set ? &grid : 0;
+    start = clock();
+    for(unsigned int s=0; s<steps; s++) {
+      for(unsigned int i=0; i<members; i++)
+	propagateRecord(engine, records[i], tmap, cfg, thrusts[i],
+			rudders[i], elevators[i], lfts[i], rgts[i],
+			dxs[i], dys[i], fptr, gptr);
+    }
+    double secs_single = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    double max_diff = 0;
+    for(unsigned int i=0; i<members; i++)
+      max_diff = max(max_diff, recordDiff(ensemble.getMember(i), records[i]));
+
+    cout << "Per-record time: " << doubleToString(secs_single, 4) << " secs (";
+    cout << doubleToString((secs_single*1e9) / ((double)(members)*steps), 1);
+    cout << " ns per member step)" << endl;
+    cout << "Max difference: " << max_diff;
+    cout << ", identical: " << boolToString(max_diff == 0) << endl;
+  }
+
+  //===================================================================
+  // Part 4: Ensemble spread of the final positions
+  //===================================================================
+  const vector<double>& x = ensemble.getX();
+  const vector<double>& y = ensemble.getY();
+  double mx = 0;
+  double my = 0;
+  for(unsigned int i=0; i<members; i++) {
+    mx += x[i];
+    my += y[i];
+  }
+  mx /= members;
+  my /= members;
+  double var = 0;
+  for(unsigned int i=0; i<members; i++)
+    var += ((x[i]-mx)*(x[i]-mx)) + ((y[i]-my)*(y[i]-my));
+  var /= members;
+  cout << "Final mean position: " << doubleToString(mx, 2) << ",";
+  cout << doubleToString(my, 2) << "  radial std dev: ";
+  cout << doubleToString(sqrt(var), 2) << endl;
+
+  if(csv) {
+    cout << "member,x,y,heading,speed,depth" << endl;
+    for(unsigned int i=0; i<members; i++) {
+      cout << i << "," << doubleToString(x[i], 4) << ",";
+      cout << doubleToString(y[i], 4) << ",";
+      cout << doubleToString(ensemble.getHeading()[i], 4) << ",";
+      cout << doubleToString(ensemble.getSpeed()[i], 4) << ",";
+      cout << doubleToString(ensemble.getDepth()[i], 4) << endl;
+    }
+  }
+
+  return(0);
+}
+
+//--------------------------------------------------------
+// Procedure: showHelpAndExit()
+
+void showHelpAndExit()
+{ 
+  cout << "Usage:                                              " << endl;
+  cout << "  simensemble [OPTIONS]                             " << endl;
+  cout << "                                                    " << endl;
+  cout << "Synopsis:                                           " << endl;
+  cout << "  Propagate an ensemble of perturbed vehicle states " << endl;
+  cout << "  with the uSimMarineV22 physics, as one batch, and " << endl;
+  cout << "  check the result against propagating each record " << endl;
+  cout << "  separately with the SimEngine.                    " << endl;
+  cout << "                                                    " << endl;
+  cout << "Options:                                            " << endl;
+  cout << "  --help, -h                                        " << endl;
+  cout << "    Display this help message                       " << endl;
+  cout << "  --members=<n>   (default 1000)                    " << endl;
+  cout << "  --steps=<n>     (default 600)                     " << endl;
+  cout << "  --dt=<secs>     (default 0.1)                     " << endl;
+  cout << "  --thrust=<val>  (default 50)                      " << endl;
+  cout << "  --rudder=<val>  (default 10)                      " << endl;
+  cout << "  --elevator=<val> (default 0)                      " << endl;
+  cout << "  --spread=<val>  (default 10)                      " << endl;
+  cout << "    Uniform +/- perturbation of each member's       " << endl;
+  cout << "    thrust, rudder and elevator                     " << endl;
+  cout << "  --drift_x=<mps>, --drift_y=<mps> (default 0)      " << endl;
+  cout << "  --drift_spread=<mps> (default 0)                  " << endl;
+  cout << "  --current=<file>                                  " << endl;
+  cout << "    Apply a current field read from file            " << endl;
+  cout << "  --eddy=<mps>                                      " << endl;
+  cout << "    Apply a synthetic eddy current of this strength " << endl;
+  cout << "  --grid=<file>                                     " << endl;
+  cout << "    Apply a binary current grid (see cgrid)         " << endl;
+  cout << "  --turn_rate=<val> (default 70)                    " << endl;
+  cout << "  --diff          Differential thrust mode          " << endl;
+  cout << "  --reverse       Thrust mode reverse               " << endl;
+  cout << "  --noverify      Skip the per-record comparison    " << endl;
+  cout << "  --csv           Print the final member states     " << endl;
+  cout << "  --seed=<n>      (default 1)                       " << endl;
+  cout << "                                                    " << endl;
+  cout << "Example:                                            " << endl;
+  cout << "  simensemble --members=5000 --eddy=0.5             " << endl;
+
+  exit(0);
+}
@@ -55,10 +55,21 @@ bool AppCastRepo::addAppCast(const string& appcast_str)
     str = findReplace(str, "\33[0m", "");
   }
 
-  AppCast appcast = string2AppCast(str);
+  AppCast appcast;
+  if(!m_appcast_tree.decodeAppCast(str, appcast))
+    return(false);
   return(addAppCast(appcast));
 }
 
+//---------------------------------------------------------
+// Procedure: decodeAppCast
+//   Returns: false if given a delta appcast with no known keyframe
+
+bool AppCastRepo::decodeAppCast(const string& str, AppCast& appcast)
+{
+  return(m_appcast_tree.decodeAppCast(str, appcast));
+}
+
 //---------------------------------------------------------
 // Procedure: addAppCast
 //   Returns: true if first time hearing from this node
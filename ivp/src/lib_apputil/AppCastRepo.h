@@ -37,6 +37,7 @@ class AppCastRepo
   // Return true if first time heard from this node
   bool addAppCast(const std::string&);
   bool addAppCast(const AppCast&);
+  bool decodeAppCast(const std::string&, AppCast&);
   bool removeNode(const std::string& node);
 
   bool setCurrentNode(const std::string& node);
@@ -34,6 +34,7 @@ AppCastTree::AppCastTree()
 {
   m_total_appcast_count = 0;
   m_node_id_count = 0;
+  m_dropped_delta_count = 0;
 }
 
 //---------------------------------------------------------
@@ -42,10 +43,58 @@ AppCastTree::AppCastTree()
 
 bool AppCastTree::addAppCast(const string& str)
 {
-  AppCast appcast = string2AppCast(str);
+  AppCast appcast;
+  if(!decodeAppCast(str, appcast))
+    return(false);
   return(addAppCast(appcast));
 }
 
+//---------------------------------------------------------
+// Procedure: decodeAppCast
+//   Returns: false if the string is a delta with no matching keyframe.
+//      Note: Versioned full appcasts are keyframes and are retained. A
+//            delta leads with acbase=N, followed by the proc and node.
+
+bool AppCastTree::decodeAppCast(const string& str, AppCast& appcast)
+{
+  if(!isAppCastDelta(str)) {
+    appcast = string2AppCast(str);
+    if(appcast.getVersion() != 0) {
+      string key = appcast.getNodeName() + ":" + appcast.getProcName();
+      m_map_keyframes[key] = appcast;
+    }
+    return(true);
+  }
+
+  // Pull the proc and node from the head of the delta
+  string proc, node;
+  string::size_type pos = 0;
+  for(unsigned int i=0; (i<3) && (pos != string::npos); i++) {
+    string::size_type next = str.find("!@#", pos);
+    string pair  = str.substr(pos, (next == string::npos) ? next : next-pos);
+    string param = biteStringX(pair, '=');
+    if(param == "proc")
+      proc = pair;
+    else if(param == "node")
+      node = pair;
+    pos = (next == string::npos) ? next : next+3;
+  }
+
+  string key = node + ":" + proc;
+  map<string, AppCast>::const_iterator p = m_map_keyframes.find(key);
+  if(p == m_map_keyframes.end()) {
+    m_dropped_delta_count++;
+    return(false);
+  }
+
+  appcast = p->second;
+  if(!appcast.applyAppCastDelta(str)) {
+    m_dropped_delta_count++;
+    return(false);
+  }
+  return(true);
+}
+
 //---------------------------------------------------------
 // Procedure: addAppCast
 //   Returns: true. May add some error checking in the future
@@ -39,10 +39,15 @@ class AppCastTree
   bool addAppCast(const std::string&);
   bool addAppCast(const AppCast&);
 
+  // Rebuild an appcast from a full or delta appcast string. Returns
+  // false if a delta arrives before the keyframe it was made against.
+  bool decodeAppCast(const std::string&, AppCast&);
+
   bool removeNode(const std::string&);
 
   // Global getters (Queries requiring no key)
   unsigned int getTreeAppCastCount() const   {return(m_total_appcast_count);}
+  unsigned int getDroppedDeltaCount() const  {return(m_dropped_delta_count);}
   unsigned int getTreeNodeCount() const      {return(m_map_appcast_sets.size());}
   unsigned int getTreeProcCount() const;
   std::vector<std::string> getNodes() const  {return(m_nodes);}
@@ -79,6 +84,10 @@ class AppCastTree
   unsigned int m_node_id_count;
   unsigned int m_total_appcast_count;
 
+  // Most recent keyframe per node:proc, against which deltas are applied
+  std::map<std::string, AppCast> m_map_keyframes;
+  unsigned int m_dropped_delta_count;
+
   // Keep a separate vector of node names so that when node name vector is
   // retrieved by caller, the earlier items stay in the same order. The 
   // alternative, iterating through the map, means order may shift as map grows.
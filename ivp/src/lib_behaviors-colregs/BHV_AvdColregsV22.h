@@ -49,6 +49,7 @@ class BHV_AvdColregsV22 : public IvPContactBehavior {
   std::string  getInfo(std::string);
   double       getDoubleInfo(std::string);
   bool         isConstraint() {return(true);}
+  IvPBehavior* clone() const {return(new BHV_AvdColregsV22(*this));}
 
  protected:
   void         updateAvoidMode();
@@ -165,9 +165,9 @@ IvPFunction *BHV_AbortToPoint::onRunState()
 bool BHV_AbortToPoint::updateInfoIn()
 {
   bool ok1, ok2, ok3;
-  m_osx = getBufferDoubleVal("NAV_X",     ok1);
-  m_osy = getBufferDoubleVal("NAV_Y",     ok2);
-  m_osv = getBufferDoubleVal("NAV_SPEED", ok3);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  m_osv = getBufferDoubleVal(m_nav_v_slot, ok3);
 
   // Must get ownship position from InfoBuffer
   if(!ok1 || !ok2) {
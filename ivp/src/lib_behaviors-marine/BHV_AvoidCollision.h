@@ -38,6 +38,7 @@ public:
   void         onIdleState();
   void         onInactiveState();
   bool         isConstraint() {return(true);}
+  IvPBehavior* clone() const {return(new BHV_AvoidCollision(*this));}
 
   std::string  getInfo(std::string);
   
@@ -0,0 +1,341 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: BHV_AvoidCollisionMulti.cpp                          */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#include <cmath>
+#include <cstdlib>
+#include <set>
+#include "BHV_AvoidCollisionMulti.h"
+#include "AOF_AvoidCollisionMulti.h"
+#include "OF_Reflector.h"
+#include "BuildUtils.h"
+#include "MBUtils.h"
+#include "AngleUtils.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: Constructor
+//      Note: One instance of this behavior handles all contacts
+//            named in the contacts_var list, producing a single
+//            objective function. It is meant as an alternative to
+//            spawning one BHV_AvoidCollision per contact.
+
+BHV_AvoidCollisionMulti::BHV_AvoidCollisionMulti(IvPDomain gdomain) : 
+  IvPBehavior(gdomain)
+{
+  this->setParam("descriptor", "avoid_collision_multi");
+  this->setParam("build_info", "uniform_piece = discrete @ course:3,speed:3");
+  this->setParam("build_info", "uniform_grid  = discrete @ course:9,speed:6");
+  
+  m_domain = subDomain(m_domain, "course,speed");
+  
+  m_contacts_var      = "CONTACTS_LIST";
+  m_pwt_outer_dist    = 200;
+  m_pwt_inner_dist    = 50;
+  m_min_util_cpa_dist = 10; 
+  m_max_util_cpa_dist = 75; 
+  m_pwt_grade         = "quasi";
+  m_time_on_leg       = 120;
+  m_extrapolate       = true;
+
+  m_ledger.setDecay(15, 30);
+  
+  // Initialize state variables
+  m_osx = 0;
+  m_osy = 0;
+  m_total_evals   = 0;
+  m_contacts_used = 0;
+
+  addInfoVars("NAV_X, NAV_Y");
+  addInfoVars(m_contacts_var);
+}
+
+//-----------------------------------------------------------
+// Procedure: setParam
+
+bool BHV_AvoidCollisionMulti::setParam(string param, string param_val) 
+{
+  if(IvPBehavior::setParam(param, param_val))
+    return(true);
+
+  if(param == "contacts_var") {
+    if(!isAlphaNum(param_val, "_"))
+      return(false);
+    m_contacts_var = toupper(param_val);
+    addInfoVars(m_contacts_var);
+    return(true);
+  }
+  else if(param == "pwt_inner_dist") {
+    return(setMinPartOfPairOnString(m_pwt_inner_dist,
+				    m_pwt_outer_dist, param_val));
+  }  
+  else if(param == "pwt_outer_dist") { 
+    return(setMaxPartOfPairOnString(m_pwt_inner_dist,
+				    m_pwt_outer_dist, param_val));
+  }
+  else if(param == "min_util_cpa_dist") {
+    return(setMinPartOfPairOnString(m_min_util_cpa_dist,
+				    m_max_util_cpa_dist, param_val));
+  }    
+  else if(param == "max_util_cpa_dist") {
+    return(setMaxPartOfPairOnString(m_min_util_cpa_dist,
+				    m_max_util_cpa_dist, param_val));
+  }
+  else if(param == "pwt_grade") {
+    param_val = tolower(param_val);
+    if((param_val!="linear") && (param_val!="quadratic") && 
+       (param_val!="quasi"))
+      return(false);
+    m_pwt_grade = param_val;
+    return(true);
+  }  
+  else if(param == "time_on_leg") {
+    double dval = atof(param_val.c_str());
+    if(!isNumber(param_val) || (dval <= 0))
+      return(false);
+    m_time_on_leg = dval;
+    return(true);
+  }
+  else if(param == "extrapolate")
+    return(setBooleanOnString(m_extrapolate, param_val));
+  else if(param == "decay") {
+    string left  = biteStringX(param_val, ',');
+    string right = param_val;
+    if(!isNumber(left) || !isNumber(right))
+      return(false);
+    double start = atof(left.c_str());
+    double end   = atof(right.c_str());
+    if((start < 0) || (start > end))
+      return(false);
+    m_ledger.setDecay(start, end);
+    return(true);
+  }
+  else if(param == "match_name")
+    return(m_filter_set.addMatchName(param_val));
+  else if(param == "ignore_name")
+    return(m_filter_set.addIgnoreName(param_val));
+  else if(param == "match_group")
+    return(m_filter_set.addMatchGroup(param_val));
+  else if(param == "ignore_group")
+    return(m_filter_set.addIgnoreGroup(param_val));
+  else if(param == "match_type")
+    return(m_filter_set.addMatchType(param_val));
+  else if(param == "ignore_type")
+    return(m_filter_set.addIgnoreType(param_val));
+  else if(param == "match_region")
+    return(m_filter_set.addMatchRegion(param_val));
+  else if(param == "ignore_region")
+    return(m_filter_set.addIgnoreRegion(param_val));
+  else if(param == "strict_ignore")
+    return(m_filter_set.setStrictIgnore(param_val));
+
+  return(false);
+}
+
+//-----------------------------------------------------------
+// Procedure: getInfo()
+
+string BHV_AvoidCollisionMulti::getInfo(string str) 
+{
+  if(str == "debug1")
+    return(uintToString(m_total_evals));
+  else if(str == "contacts")
+    return(uintToString(m_contacts_used));
+
+  return("");
+}
+
+//-----------------------------------------------------------
+// Procedure: onRunState()
+
+IvPFunction *BHV_AvoidCollisionMulti::onRunState() 
+{
+  m_total_evals   = 0;
+  m_contacts_used = 0;
+  if(!updatePlatformInfo() || !updateContacts())
+    return(0);
+
+  // ===========================================================
+  // Part 1: Add each relevant contact to the one AOF
+  // ===========================================================
+  AOF_AvoidCollisionMulti aof(m_domain);
+  aof.setOwnshipParams(m_osx, m_osy);
+  aof.setParam("tol", m_time_on_leg);
+
+  for(unsigned int id=0; id<m_ledger.getRows(); id++) {
+    if(!m_ledger.isActiveID(id))
+      continue;
+    double range = m_ledger.getRangeExtByID(id);
+    double relevance = getRelevance(range);
+    if(relevance <= 0)
+      continue;
+
+    double min_util_cpa_dist = m_min_util_cpa_dist;
+    if(range <= m_min_util_cpa_dist)
+      min_util_cpa_dist = (range / 2);
+
+    double cnx = m_ledger.getExtXByID(id);
+    double cny = m_ledger.getExtYByID(id);
+    double cnh = m_ledger.getHeadingByID(id);
+    double cnv = m_ledger.getSpeedByID(id);
+    if(!m_extrapolate) {
+      cnx = m_ledger.getXByID(id);
+      cny = m_ledger.getYByID(id);
+    }
+    aof.addContact(cnx, cny, cnh, cnv, relevance, min_util_cpa_dist,
+		   m_max_util_cpa_dist);
+  }
+
+  m_contacts_used = aof.size();
+  postIntMessage("AVOID_MULTI_COUNT", m_contacts_used);
+  if(m_contacts_used == 0)
+    return(0);
+  
+  if(!aof.initialize()) {
+    postEMessage("Unable to init AOF_AvoidCollisionMulti.");
+    return(0);
+  }    
+  
+  // ===========================================================
+  // Part 2: Build the one IvP Function for all contacts
+  // ===========================================================
+  OF_Reflector reflector(&aof, 1);
+  reflector.create(m_build_info);
+  IvPFunction *ipf = reflector.extractIvPFunction();
+  m_total_evals = reflector.getTotalEvals();
+  
+  string warnings = reflector.getWarnings();
+  if(warnings != "")
+    postMessage("AVD_DEBUG", warnings);
+
+  // The function is the weighted mean of the per-contact functions
+  // and is not normalized, so with the summed weight below, the
+  // solver sees the same tradeoff as it would with one function
+  // per contact.
+  if(ipf) 
+    ipf->setPWT(aof.getTotalWeight() * m_priority_wt);
+
+  return(ipf);
+}
+
+//-----------------------------------------------------------
+// Procedure: updatePlatformInfo()
+
+bool BHV_AvoidCollisionMulti::updatePlatformInfo()
+{
+  bool ok = true;
+  m_osx = getBufferDoubleVal("NAV_X", ok);
+  if(ok)
+    m_osy = getBufferDoubleVal("NAV_Y", ok);
+  if(!ok) {
+    postEMessage("ownship x,y info not found.");
+    return(false);
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: updateContacts()
+//   Purpose: Refresh the contact ledger from the info buffer for
+//            each contact in the contacts list. Contacts no longer
+//            in the list, or failing the filter, are dropped. Then
+//            all contacts are extrapolated and ranged in one pass.
+
+bool BHV_AvoidCollisionMulti::updateContacts()
+{
+  bool ok = true;
+  string contacts = getBufferStringVal(m_contacts_var, ok);
+  if(!ok)
+    return(false);
+
+  set<string> names;
+  vector<string> svector = parseString(contacts, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string vname = toupper(stripBlankEnds(svector[i]));
+    if((vname == "") || (vname == toupper(m_us_name)))
+      continue;
+
+    bool cn_ok = true;
+    NodeRecord record(vname);
+    double cnx = getBufferDoubleVal(vname+"_NAV_X", cn_ok);
+    double cny = 0, cnh = 0, cnv = 0, cnutc = 0;
+    if(cn_ok) cny = getBufferDoubleVal(vname+"_NAV_Y", cn_ok);
+    if(cn_ok) cnh = getBufferDoubleVal(vname+"_NAV_HEADING", cn_ok);
+    if(cn_ok) cnv = getBufferDoubleVal(vname+"_NAV_SPEED", cn_ok);
+    if(cn_ok) cnutc = getBufferDoubleVal(vname+"_NAV_UTC", cn_ok);
+    if(!cn_ok)
+      continue;
+
+    record.setX(cnx);
+    record.setY(cny);
+    record.setHeading(angle360(cnh));
+    record.setSpeed(cnv);
+    record.setTimeStamp(cnutc);
+    record.setGroup(getBufferStringVal(vname+"_NAV_GROUP"));
+    record.setType(getBufferStringVal(vname+"_NAV_TYPE"));
+    if(!m_filter_set.filterCheck(record, m_osx, m_osy))
+      continue;
+    
+    names.insert(vname);
+    m_ledger.processRecord(record, false);
+  }
+
+  for(unsigned int id=0; id<m_ledger.getRows(); id++) {
+    if(!m_ledger.isActiveID(id))
+      continue;
+    string vname = m_ledger.getVNameByID(id);
+    if(names.count(toupper(vname)) == 0)
+      m_ledger.removeVName(vname);
+  }
+
+  m_ledger.setCurrTimeUTC(getBufferCurrTime());
+  m_ledger.extrapolateAll();
+  m_ledger.updateRanges(m_osx, m_osy);
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: getRelevance
+//   Purpose: Calculate the relevance of a contact at the given
+//            range, as BHV_AvoidCollision does for its contact.
+
+double BHV_AvoidCollisionMulti::getRelevance(double range) const
+{
+  if(range >= m_pwt_outer_dist)
+    return(0);
+  if(range <= m_pwt_inner_dist)
+    return(1);
+
+  double drange = (m_pwt_outer_dist - m_pwt_inner_dist);
+  double dpct = (m_pwt_outer_dist - range) / drange;
+  
+  // Apply the grade scale to the raw distance
+  double mod_dpct = dpct; // linear case
+  if(m_pwt_grade == "quadratic")
+    mod_dpct = dpct * dpct;
+  else if(m_pwt_grade == "quasi")
+    mod_dpct = pow(dpct, 1.5);
+
+  return(mod_dpct);  
+}
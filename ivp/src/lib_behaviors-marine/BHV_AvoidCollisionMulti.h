@@ -1,8 +1,8 @@
 /*****************************************************************/
 /*    NAME: Michael Benjamin                                     */
 /*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
-/*    FILE: RangeMark.cpp                                        */
-/*    DATE: July 19 2020                                         */
+/*    FILE: BHV_AvoidCollisionMulti.h                            */
+/*    DATE: October 19th, 2026                                   */
 /*                                                               */
 /* This file is part of MOOS-IvP                                 */
 /*                                                               */
@@ -21,47 +21,53 @@
 /* <http://www.gnu.org/licenses/>.                               */
 /*****************************************************************/
 
-#include "RangeMark.h"
+ 
+#ifndef BHV_AVOID_COLLISION_MULTI_HEADER
+#define BHV_AVOID_COLLISION_MULTI_HEADER
 
-using namespace std;
+#include <string>
+#include "IvPBehavior.h"
+#include "ContactLedger.h"
+#include "ExFilterSet.h"
 
+class IvPDomain;
+class BHV_AvoidCollisionMulti : public IvPBehavior {
+public:
+  BHV_AvoidCollisionMulti(IvPDomain);
+  ~BHV_AvoidCollisionMulti() {}
 
-//--------------------------------------------------------
-// Constructor
+  IvPFunction* onRunState();
+  bool         setParam(std::string, std::string);
+  bool         isConstraint() {return(true);}
+  IvPBehavior* clone() const {return(new BHV_AvoidCollisionMulti(*this));}
 
-RangeMark::RangeMark(string contact, double range)
-{
-  m_contact = contact;
-  m_range   = range;
-}
+  std::string  getInfo(std::string);
+  
+ protected:
+  bool   updatePlatformInfo();
+  bool   updateContacts();
+  double getRelevance(double range) const;
 
-//--------------------------------------------------------
-// Procedure: setRangeMark()
+ private: // Configuration Parameters
+  std::string m_contacts_var;
+  std::string m_pwt_grade;
 
-void RangeMark::setRangeMark(string contact, double range)
-{
-  m_contact = contact;
-  m_range   = range;
-}
+  double m_pwt_outer_dist;
+  double m_pwt_inner_dist;
+  double m_min_util_cpa_dist;
+  double m_max_util_cpa_dist;
+  double m_time_on_leg;
+  bool   m_extrapolate;
 
+  ExFilterSet m_filter_set;
 
-//--------------------------------------------------------
-// Procedure: overloaded less than operator
-
-bool operator< (const RangeMark& one, const RangeMark& two)
-{
-  if(one.getRange() < two.getRange())
-    return(true);
-  else
-    return(false);
-}
-
-//--------------------------------------------------------
-// Procedure: overload equals operator
-
-bool operator== (const RangeMark& one, const RangeMark& two)
-{
-  return(one.getRange() == two.getRange());
-}
+ private:  // State Variables
+  double m_osx;
+  double m_osy;
 
+  ContactLedger m_ledger;
 
+  unsigned int m_total_evals;
+  unsigned int m_contacts_used;
+};
+#endif
@@ -412,7 +412,14 @@ IvPFunction *BHV_AvoidObstacleV24::onRunState()
 
 IvPFunction *BHV_AvoidObstacleV24::buildOF()
 {
-  // Part 1: Set and init the AOF
+  // Part 1: Set and init the AOF. The heading table is built once
+  //         here and shared by the AOF and refinery model copies.
+  int crs_ix = m_domain.getIndex("course");
+  if(crs_ix >= 0)
+    m_obship_model.buildHdgTable(m_domain.getVarLow(crs_ix),
+				 m_domain.getVarDelta(crs_ix),
+				 m_domain.getVarPoints(crs_ix));
+
   AOF_AvoidObstacleV24  aof_avoid(m_domain);
   aof_avoid.setObShipModel(m_obship_model);
   bool ok_init = aof_avoid.initialize();
@@ -581,10 +588,10 @@ void BHV_AvoidObstacleV24::postErasablePolygons()
 bool BHV_AvoidObstacleV24::updatePlatformInfo()
 {
   bool ok1, ok2, ok3, ok4;
-  m_osx = getBufferDoubleVal("NAV_X", ok1);
-  m_osy = getBufferDoubleVal("NAV_Y", ok2);
-  m_osh = getBufferDoubleVal("NAV_HEADING", ok3);
-  m_osv = getBufferDoubleVal("NAV_SPEED", ok4);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  m_osh = getBufferDoubleVal(m_nav_h_slot, ok3);
+  m_osv = getBufferDoubleVal(m_nav_v_slot, ok4);
 
   string warning_msg;
   if(!ok1 || !ok2)
@@ -51,6 +51,7 @@ public:
   void         postConfigStatus();
   double       getDoubleInfo(std::string);
   bool         isConstraint() {return(true);}
+  IvPBehavior* clone() const {return(new BHV_AvoidObstacleV24(*this));}
   std::string  expandMacros(std::string);
   
  protected: 
@@ -97,8 +97,8 @@ IvPFunction *BHV_BearingLine::onRunState()
   bool ok1, ok2;
   double nav_x, nav_y;
  
-  nav_x = getBufferDoubleVal("NAV_X", ok1);
-  nav_y = getBufferDoubleVal("NAV_Y", ok2);
+  nav_x = getBufferDoubleVal(m_nav_x_slot, ok1);
+  nav_y = getBufferDoubleVal(m_nav_y_slot, ok2);
 
   if(!ok1)
     postWMessage("No NAV_X info in the info_buffer");
@@ -157,7 +157,7 @@ IvPFunction *BHV_ConstantHeading::onRunState()
 bool BHV_ConstantHeading::updateInfoIn()
 {
   bool ok;
-  m_os_heading = getBufferDoubleVal("NAV_HEADING", ok);
+  m_os_heading = getBufferDoubleVal(m_nav_h_slot, ok);
 
   // Should get ownship information from the InfoBuffer
   if(!ok) {
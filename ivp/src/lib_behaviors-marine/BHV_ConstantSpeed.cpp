@@ -132,7 +132,7 @@ IvPFunction *BHV_ConstantSpeed::onRunState()
 bool BHV_ConstantSpeed::updateInfoIn()
 {
   bool ok;
-  m_os_speed = getBufferDoubleVal("NAV_SPEED", ok);
+  m_os_speed = getBufferDoubleVal(m_nav_v_slot, ok);
 
   // Should get ownship information from the InfoBuffer
   if(!ok) {
@@ -268,8 +268,8 @@ bool BHV_FullStop::updateOSPos(string fail_action)
 {
   bool   ok_osx = true;
   bool   ok_osy = true;
-  double new_osx = getBufferDoubleVal("NAV_X", ok_osx);
-  double new_osy = getBufferDoubleVal("NAV_Y", ok_osy);
+  double new_osx = getBufferDoubleVal(m_nav_x_slot, ok_osx);
+  double new_osy = getBufferDoubleVal(m_nav_y_slot, ok_osy);
   double age_osx = getBufferTimeVal("NAV_X");
   double age_osy = getBufferTimeVal("NAV_Y");
 
@@ -302,7 +302,7 @@ bool BHV_FullStop::updateOSPos(string fail_action)
 bool BHV_FullStop::updateOSHdg(string fail_action) 
 {
   bool   ok_osh = true;
-  double new_osh = getBufferDoubleVal("NAV_HEADING", ok_osh);
+  double new_osh = getBufferDoubleVal(m_nav_h_slot, ok_osh);
   double age_osh = getBufferTimeVal("NAV_HEADING");
 
   if(!ok_osh || (age_osh > m_stale_nav_thresh)) {
@@ -325,7 +325,7 @@ bool BHV_FullStop::updateOSHdg(string fail_action)
 bool BHV_FullStop::updateOSSpd(string fail_action) 
 {
   bool   ok_osv  = true;
-  double new_osv = getBufferDoubleVal("NAV_SPEED", ok_osv);
+  double new_osv = getBufferDoubleVal(m_nav_v_slot, ok_osv);
   double age_osv = getBufferTimeVal("NAV_SPEED");
   
   if(!ok_osv || (age_osv > m_stale_nav_thresh)) {
@@ -82,8 +82,8 @@ IvPFunction *BHV_HSLine::onRunState()
  
   des_hdg = getBufferDoubleVal("DESIRED_HEADING",  ok1);
   des_spd = getBufferDoubleVal("DESIRED_SPEED",    ok2);
-  nav_x   = getBufferDoubleVal("NAV_X",            ok3);
-  nav_y   = getBufferDoubleVal("NAV_Y",            ok4);
+  nav_x   = getBufferDoubleVal(m_nav_x_slot, ok3);
+  nav_y   = getBufferDoubleVal(m_nav_y_slot, ok4);
 
   if(!ok1)
     postWMessage("No DESIRED_HEADING info in the info_buffer");
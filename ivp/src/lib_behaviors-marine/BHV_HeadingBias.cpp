@@ -107,7 +107,7 @@ IvPFunction *BHV_HeadingBias::onRunState()
 bool BHV_HeadingBias::updateInfoIn()
 {
   bool ok;
-  m_os_heading = getBufferDoubleVal("NAV_HEADING", ok);
+  m_os_heading = getBufferDoubleVal(m_nav_h_slot, ok);
   
   // Must get ownship heading from InfoBuffer
   if(!ok) {
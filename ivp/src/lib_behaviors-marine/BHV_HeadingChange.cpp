@@ -112,11 +112,11 @@ IvPFunction *BHV_HeadingChange::onRunState()
 {
   bool ok1, ok2, ok3, ok4, ok5;
   m_curr_time      = getBufferCurrTime();
-  m_curr_heading   = getBufferDoubleVal("NAV_HEADING", ok1);
-  m_curr_speed     = getBufferDoubleVal("NAV_SPEED", ok2);
+  m_curr_heading   = getBufferDoubleVal(m_nav_h_slot, ok1);
+  m_curr_speed     = getBufferDoubleVal(m_nav_v_slot, ok2);
   m_curr_des_speed = getBufferDoubleVal("DESIRED_SPEED", ok3);
-  m_curr_xpos      = getBufferDoubleVal("NAV_X", ok4);
-  m_curr_ypos      = getBufferDoubleVal("NAV_Y", ok5);
+  m_curr_xpos      = getBufferDoubleVal(m_nav_x_slot, ok4);
+  m_curr_ypos      = getBufferDoubleVal(m_nav_y_slot, ok5);
   
   if(!ok1 || !ok2 || !ok3 || !ok4 || !ok5) {
     postWMessage("Problem retrieving info from info_buffer.");
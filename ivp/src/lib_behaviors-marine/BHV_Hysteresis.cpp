@@ -175,8 +175,8 @@ string BHV_Hysteresis::updateHeadingAvg()
     return("Variable turn_range not specified");
 
   bool ok, ok2;
-  m_current_heading = getBufferDoubleVal("NAV_HEADING", ok);
-  m_current_speed   = getBufferDoubleVal("NAV_SPEED", ok2); 
+  m_current_heading = getBufferDoubleVal(m_nav_h_slot, ok);
+  m_current_speed   = getBufferDoubleVal(m_nav_v_slot, ok2); 
   
   m_current_heading = angle360(m_current_heading);
 
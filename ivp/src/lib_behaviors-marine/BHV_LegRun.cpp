@@ -575,10 +575,10 @@ bool BHV_LegRun::updateInfoIn()
   // Part 1: Update Ownship position and speed from the buffer
   // ==========================================================
   bool ok1, ok2, ok3, ok4;
-  m_osx = getBufferDoubleVal("NAV_X", ok1);
-  m_osy = getBufferDoubleVal("NAV_Y", ok2);
-  m_osv = getBufferDoubleVal("NAV_SPEED", ok3);
-  m_osh = getBufferDoubleVal("NAV_HEADING", ok4);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  m_osv = getBufferDoubleVal(m_nav_v_slot, ok3);
+  m_osh = getBufferDoubleVal(m_nav_h_slot, ok4);
 
   m_odometer.updateDistance(m_osx, m_osy);
   m_wrap_detector.updatePosition(m_osx, m_osy);
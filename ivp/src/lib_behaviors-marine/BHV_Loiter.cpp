@@ -374,10 +374,10 @@ bool BHV_Loiter::updateInfoIn()
 
   bool ok1, ok2, ok3, ok4;
   // ownship position in meters from some 0,0 reference point.
-  m_osx = getBufferDoubleVal("NAV_X", ok1);
-  m_osy = getBufferDoubleVal("NAV_Y", ok2);
-  m_osh = getBufferDoubleVal("NAV_HEADING", ok3);
-  m_osv = getBufferDoubleVal("NAV_SPEED", ok4);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  m_osh = getBufferDoubleVal(m_nav_h_slot, ok3);
+  m_osv = getBufferDoubleVal(m_nav_v_slot, ok4);
 
   // Must get ownship information from the InfoBuffer
   if(!ok1 || !ok2)
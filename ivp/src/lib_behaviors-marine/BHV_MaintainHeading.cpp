@@ -127,7 +127,7 @@ void BHV_MaintainHeading::onIdleState()
 IvPFunction *BHV_MaintainHeading::onRunState() 
 {
   bool ok;
-  double current_heading = getBufferDoubleVal("NAV_HEADING", ok);
+  double current_heading = getBufferDoubleVal(m_nav_h_slot, ok);
   if(!ok) {
     postWMessage("No Ownship NAV_HEADING in info_buffer");
     return(0);
@@ -117,7 +117,7 @@ IvPFunction *BHV_MaxSpeed::onRunState()
 bool BHV_MaxSpeed::updateInfoIn()
 {
   bool ok;
-  m_osv = getBufferDoubleVal("NAV_SPEED", ok);
+  m_osv = getBufferDoubleVal(m_nav_v_slot, ok);
 
   // Should get ownship information from the InfoBuffer
   if(!ok) {
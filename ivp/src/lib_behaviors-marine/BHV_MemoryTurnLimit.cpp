@@ -105,8 +105,8 @@ IvPFunction *BHV_MemoryTurnLimit::onRunState()
     
 
   bool ok,ok2;
-  double heading = getBufferDoubleVal("NAV_HEADING", ok);
-  double speed   = getBufferDoubleVal("NAV_SPEED", ok2); //dpe
+  double heading = getBufferDoubleVal(m_nav_h_slot, ok);
+  double speed   = getBufferDoubleVal(m_nav_v_slot, ok2); //dpe
 
   if(!ok) {
     postEMessage("No Ownship NAV_HEADING in info_buffer");
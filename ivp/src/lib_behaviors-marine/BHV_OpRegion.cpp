@@ -243,8 +243,8 @@ void BHV_OpRegion::polygonVerify()
     return;
 
   bool ok1, ok2;
-  double osX = getBufferDoubleVal("NAV_X", ok1);
-  double osY = getBufferDoubleVal("NAV_Y", ok2);
+  double osX = getBufferDoubleVal(m_nav_x_slot, ok1);
+  double osY = getBufferDoubleVal(m_nav_y_slot, ok2);
 
   // Must get ownship position from InfoBuffer
   if(!ok1 || !ok2) {
@@ -367,10 +367,10 @@ void BHV_OpRegion::polygonVerify()
 void BHV_OpRegion::postPolyStatus()
 {
   bool ok1, ok2, ok3, ok4;
-  double osX   = getBufferDoubleVal("NAV_X", ok1);
-  double osY   = getBufferDoubleVal("NAV_Y", ok2);
-  double osSPD = getBufferDoubleVal("NAV_SPEED", ok3);
-  double osHDG = getBufferDoubleVal("NAV_HEADING", ok4);
+  double osX   = getBufferDoubleVal(m_nav_x_slot, ok1);
+  double osY   = getBufferDoubleVal(m_nav_y_slot, ok2);
+  double osSPD = getBufferDoubleVal(m_nav_v_slot, ok3);
+  double osHDG = getBufferDoubleVal(m_nav_h_slot, ok4);
 
   string msg;
   if(!ok1) 
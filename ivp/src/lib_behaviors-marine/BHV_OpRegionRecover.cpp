@@ -369,10 +369,10 @@ bool BHV_OpRegionRecover::polygonVerify()
 bool BHV_OpRegionRecover::updateInfoIn()
 {
   bool ok1, ok2, ok3, ok4;
-  double osx = getBufferDoubleVal("NAV_X", ok1);
-  double osy = getBufferDoubleVal("NAV_Y", ok2);
-  double osv = getBufferDoubleVal("NAV_SPEED", ok3);
-  double osh = getBufferDoubleVal("NAV_HEADING", ok4);
+  double osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  double osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  double osv = getBufferDoubleVal(m_nav_v_slot, ok3);
+  double osh = getBufferDoubleVal(m_nav_h_slot, ok4);
 
   string msg;
   if(!ok1) 
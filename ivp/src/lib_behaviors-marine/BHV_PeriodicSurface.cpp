@@ -324,7 +324,7 @@ bool BHV_PeriodicSurface::updateInfoIn()
 {  
   bool ok1, ok2;
   m_curr_depth = getBufferDoubleVal("NAV_DEPTH", ok1);
-  m_curr_speed = getBufferDoubleVal("NAV_SPEED", ok2);
+  m_curr_speed = getBufferDoubleVal(m_nav_v_slot, ok2);
   m_curr_time  = getBufferCurrTime();
   
   if(!ok1 || !ok2) {
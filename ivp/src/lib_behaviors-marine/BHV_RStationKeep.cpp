@@ -179,8 +179,8 @@ IvPFunction *BHV_RStationKeep::onRunState()
   IvPFunction *ipf = 0;
 
   bool ok1, ok2;
-  double nav_x = getBufferDoubleVal("NAV_X", ok1);
-  double nav_y = getBufferDoubleVal("NAV_Y", ok2);
+  double nav_x = getBufferDoubleVal(m_nav_x_slot, ok1);
+  double nav_y = getBufferDoubleVal(m_nav_y_slot, ok2);
 
   // If no ownship position from info_buffer, return null
   if(!ok1 || !ok2) {
@@ -252,8 +252,8 @@ bool BHV_RStationKeep::updateInfoIn()
 {
   bool ok1, ok2, ok3, ok4, ok5, ok6;
   // ownship position in meters from some 0,0 reference point.
-  m_osx = getBufferDoubleVal("NAV_X", ok1);
-  m_osy = getBufferDoubleVal("NAV_Y", ok2);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
 
   // Must get ownship position from InfoBuffer
   if(!ok1 || !ok2) {
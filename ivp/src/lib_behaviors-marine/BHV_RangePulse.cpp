@@ -84,8 +84,8 @@ IvPFunction *BHV_RangePulse::onRunState()
   bool okx, oky;
   double nav_x, nav_y;
  
-  nav_x = getBufferDoubleVal("NAV_X", okx);
-  nav_y = getBufferDoubleVal("NAV_Y", oky);
+  nav_x = getBufferDoubleVal(m_nav_x_slot, okx);
+  nav_y = getBufferDoubleVal(m_nav_y_slot, oky);
 
   if(!okx)
     postWMessage("No NAV_X info in the info_buffer");
@@ -325,9 +325,9 @@ bool BHV_StationKeep::updateInfoIn()
   bool ok1, ok2, ok3;
   // ownship position in meters from some 0,0 reference point.
   m_currtime = getBufferCurrTime();
-  m_osx = getBufferDoubleVal("NAV_X", ok1);
-  m_osy = getBufferDoubleVal("NAV_Y", ok2);
-  m_osh = getBufferDoubleVal("NAV_HEADING", ok3);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  m_osh = getBufferDoubleVal(m_nav_h_slot, ok3);
 
   // If previous state was idle (mark_time=-1), note the time entered
   // into the running state.
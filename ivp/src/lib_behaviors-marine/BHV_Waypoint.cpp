@@ -612,10 +612,10 @@ void BHV_Waypoint::onIdleState()
 bool BHV_Waypoint::updateInfoIn()
 {
   bool ok1, ok2, ok3, ok4;
-  m_osx = getBufferDoubleVal("NAV_X",       ok1);
-  m_osy = getBufferDoubleVal("NAV_Y",       ok2);
-  m_osh = getBufferDoubleVal("NAV_HEADING", ok3);
-  m_osv = getBufferDoubleVal("NAV_SPEED",   ok4);
+  m_osx = getBufferDoubleVal(m_nav_x_slot, ok1);
+  m_osy = getBufferDoubleVal(m_nav_y_slot, ok2);
+  m_osh = getBufferDoubleVal(m_nav_h_slot, ok3);
+  m_osv = getBufferDoubleVal(m_nav_v_slot, ok4);
 
   // Must get ownship position from InfoBuffer
   if(!ok1 || !ok2) {
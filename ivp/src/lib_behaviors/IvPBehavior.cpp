@@ -49,6 +49,10 @@ IvPBehavior::IvPBehavior(IvPDomain g_domain)
 {
   m_domain       = g_domain;
   m_info_buffer  = 0;
+  m_nav_x_slot   = INFO_BUFFER_NO_SLOT;
+  m_nav_y_slot   = INFO_BUFFER_NO_SLOT;
+  m_nav_h_slot   = INFO_BUFFER_NO_SLOT;
+  m_nav_v_slot   = INFO_BUFFER_NO_SLOT;
   m_priority_wt  = 100.0;  // Default Priority Weight
   m_descriptor   = "???";  // Default descriptor
   m_bhv_state_ok = true;
@@ -373,6 +377,11 @@ void IvPBehavior::setInfoBuffer(const InfoBuffer *ib)
 {
   m_info_buffer = ib;
   m_time_of_creation = getBufferCurrTime();
+
+  m_nav_x_slot = getBufferSlot("NAV_X");
+  m_nav_y_slot = getBufferSlot("NAV_Y");
+  m_nav_h_slot = getBufferSlot("NAV_HEADING");
+  m_nav_v_slot = getBufferSlot("NAV_SPEED");
 }
 
 //-----------------------------------------------------------
@@ -859,33 +868,13 @@ bool IvPBehavior::checkConditions()
   if(!m_info_buffer) 
     return(false);
 
-  unsigned int i, j, vsize, csize;
+  // Phase 1: bring each condition up to date with the info_buffer.
+  // Only variables posted since the last check are re-read.
+  unsigned int i, csize = m_logic_conditions.size();
+  for(i=0; i<csize; i++)
+    m_logic_conditions[i].updateFromBuffer(m_info_buffer);
 
-  // Phase 1: get all the variable names from all present conditions.
-  vector<string> all_vars;
-  csize = m_logic_conditions.size();
-  for(i=0; i<csize; i++) {
-    vector<string> svector = m_logic_conditions[i].getVarNames();
-    all_vars = mergeVectors(all_vars, svector);
-  }
-  all_vars = removeDuplicates(all_vars);
-
-  // Phase 2: get values of all variables from the info_buffer and 
-  // propogate these values down to all the logic conditions.
-  vsize = all_vars.size();
-  for(i=0; i<vsize; i++) {
-    string varname = all_vars[i];
-    bool   ok_s, ok_d;
-    string s_result = m_info_buffer->sQuery(varname, ok_s);
-    double d_result = m_info_buffer->dQuery(varname, ok_d);
-
-    for(j=0; (j<csize)&&(ok_s); j++)
-      m_logic_conditions[j].setVarVal(varname, s_result);
-    for(j=0; (j<csize)&&(ok_d); j++)
-      m_logic_conditions[j].setVarVal(varname, d_result);
-  }
-
-  // Phase 3: evaluate all logic conditions. Return true only if all
+  // Phase 2: evaluate all logic conditions. Return true only if all
   // conditions evaluate to be true.
   for(i=0; i<csize; i++) {
     bool satisfied = m_logic_conditions[i].eval();
@@ -1405,21 +1394,8 @@ void IvPBehavior::postFlag(const VarDataPair& flag, bool repeatable)
     LogicCondition condition;
     bool ok_cond = condition.setCondition(condition_str);
     if(ok_cond) {
-      vector<string> all_vars = condition.getVarNames();
-      all_vars = removeDuplicates(all_vars);
-
-      // Phase: get values of all variables from the info_buffer and 
-      // propogate these values down to all the logic conditions.
-      for(unsigned int i=0; i<all_vars.size(); i++) {
-	string varname = all_vars[i];
-	bool   ok_s, ok_d;
-	string s_result = m_info_buffer->sQuery(varname, ok_s);
-	double d_result = m_info_buffer->dQuery(varname, ok_d);
-	if(ok_s)
-	  condition.setVarVal(varname, s_result);
-	if(ok_d)
-	  condition.setVarVal(varname, d_result);
-      }
+      // Get values of all variables from the info_buffer
+      condition.updateFromBuffer(m_info_buffer);
 
       // Eval logic condition
       bool satisfied = condition.eval();
@@ -1680,6 +1656,103 @@ string IvPBehavior::getBufferStringVal(string varname)
 }
 
 
+//-----------------------------------------------------------
+// Procedure: getBufferSlot()
+//   Purpose: Resolve a variable to its info buffer slot, for use
+//            with the slot versions of the getBuffer functions.
+//            Best done once, e.g., on setInfoBuffer() or on the
+//            first iteration, rather than on every iteration.
+//   Returns: INFO_BUFFER_NO_SLOT if there is no info buffer yet. All
+//            slot queries fail on it rather than read another var.
+
+unsigned int IvPBehavior::getBufferSlot(const string& varname) const
+{
+  if(!m_info_buffer)
+    return(INFO_BUFFER_NO_SLOT);
+  return(m_info_buffer->getSlot(varname));
+}
+
+//-----------------------------------------------------------
+// Procedure: getBufferTimeVal()
+//      Note: Slot version of getBufferTimeVal(string)
+
+double IvPBehavior::getBufferTimeVal(unsigned int slot) const
+{
+  if(!m_info_buffer)
+    return(0);
+  return(m_info_buffer->tQuery(slot));
+}
+
+//-----------------------------------------------------------
+// Procedure: getBufferDoubleVal()
+//      Note: Slot version of getBufferDoubleVal(string)
+
+double IvPBehavior::getBufferDoubleVal(unsigned int slot)
+{
+  bool ok_not_used = true;
+  return(getBufferDoubleVal(slot, ok_not_used));
+}
+
+//-----------------------------------------------------------
+// Procedure: getBufferDoubleVal()
+//      Note: Slot version of getBufferDoubleVal(string, bool&)
+
+double IvPBehavior::getBufferDoubleVal(unsigned int slot, bool& ok)
+{
+  if(!m_info_buffer) {
+    ok = false;
+    return(0);
+  }
+
+  double value = m_info_buffer->dQuery(slot, ok);
+  if(!ok) {
+    bool result;
+    string sval = m_info_buffer->sQuery(slot, result);
+    if(result && isNumber(sval)) {
+      value = atof(sval.c_str());
+      ok = true;
+    }
+  }
+  if(!ok) {
+    string varname = m_info_buffer->getSlotVar(slot);
+    if(varname == "")
+      postWMessage("dbl info requested on an unresolved buffer slot");
+    else if(!vectorContains(m_info_vars_no_warning, varname))
+      postWMessage(varname + " dbl info not found in helm info_buffer");
+  }
+  return(value);
+}
+
+//-----------------------------------------------------------
+// Procedure: getBufferStringVal()
+//      Note: Slot version of getBufferStringVal(string, bool&)
+
+string IvPBehavior::getBufferStringVal(unsigned int slot, bool& ok)
+{
+  if(!m_info_buffer) {
+    ok = false;
+    return("");
+  }
+
+  string value = m_info_buffer->sQuery(slot, ok);
+  if(!ok) {
+    bool result;
+    double dval = m_info_buffer->dQuery(slot, result);
+    if(result) {
+      value = doubleToString(dval, 6);
+      ok = true;
+    }
+  }
+  if(!ok) {
+    string varname = m_info_buffer->getSlotVar(slot);
+    if(varname == "")
+      postWMessage("str info requested on an unresolved buffer slot");
+    else if(!vectorContains(m_info_vars_no_warning, varname))
+      postWMessage(varname + " str info not found in helm info_buffer");
+  }
+  return(value);
+}
+
 //-----------------------------------------------------------
 // Procedure: getBufferDoubleVector()
 
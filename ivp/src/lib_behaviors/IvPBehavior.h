@@ -69,6 +69,11 @@ public:
   virtual double getMemSize() {return(0);}
   virtual bool isConstraint() {return(false);}
   virtual std::string isDeprecated() {return("");}
+
+  // Behaviors safe to copy may return a copy of themselves. The
+  // helm then spawns new instances from a configured prototype
+  // rather than re-applying the full behavior spec each time.
+  virtual IvPBehavior* clone() const {return(0);}
   
   bool   setParamCommon(std::string, std::string);
   void   setInfoBuffer(const InfoBuffer*);
@@ -183,6 +188,12 @@ public:
   double                   getBufferDoubleVal(std::string, bool&);
   std::string              getBufferStringVal(std::string);
   std::string              getBufferStringVal(std::string, bool&);
+
+  unsigned int             getBufferSlot(const std::string&) const;
+  double                   getBufferTimeVal(unsigned int) const;
+  double                   getBufferDoubleVal(unsigned int);
+  double                   getBufferDoubleVal(unsigned int, bool&);
+  std::string              getBufferStringVal(unsigned int, bool&);
   std::vector<double>      getBufferDoubleVector(std::string, bool&);
   std::vector<std::string> getBufferStringVector(std::string, bool&);
   std::vector<std::string> getStateSpaceVars();
@@ -215,6 +226,13 @@ protected:
   double m_osv;   // Current ownship speed (meters) 
 
   std::string m_contact; // Name for contact in InfoBuffer
+
+  // InfoBuffer slots of the ownship nav variables, resolved once
+  // when the info buffer is set
+  unsigned int m_nav_x_slot;
+  unsigned int m_nav_y_slot;
+  unsigned int m_nav_h_slot;
+  unsigned int m_nav_v_slot;
   std::string m_behavior_type;
   std::string m_duration_status;
   bool        m_duration_reset_pending;
@@ -456,10 +456,10 @@ bool IvPContactBehavior::updatePlatformInfo()
   //==============================================================
   // Part 1: Update ownship and contact positions
   // Part 1A: Ascertain the current ownship position and trajectory.
-  if(ok) m_osx = getBufferDoubleVal("NAV_X", ok);
-  if(ok) m_osy = getBufferDoubleVal("NAV_Y", ok);
-  if(ok) m_osh = getBufferDoubleVal("NAV_HEADING", ok);
-  if(ok) m_osv = getBufferDoubleVal("NAV_SPEED", ok);
+  if(ok) m_osx = getBufferDoubleVal(m_nav_x_slot, ok);
+  if(ok) m_osy = getBufferDoubleVal(m_nav_y_slot, ok);
+  if(ok) m_osh = getBufferDoubleVal(m_nav_h_slot, ok);
+  if(ok) m_osv = getBufferDoubleVal(m_nav_v_slot, ok);
   if(!ok) {
     postEMessage("ownship x,y,heading, or speed info not found.");
     return(false);
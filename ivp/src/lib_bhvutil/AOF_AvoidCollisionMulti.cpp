@@ -0,0 +1,223 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: AOF_AvoidCollisionMulti.cpp                          */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath> 
+#include "AOF_AvoidCollisionMulti.h"
+#include "IvPDomain.h"
+
+using namespace std;
+
+//----------------------------------------------------------
+// Procedure: Constructor
+
+AOF_AvoidCollisionMulti::AOF_AvoidCollisionMulti(IvPDomain gdomain) 
+  : AOF(gdomain)
+{
+  m_crs_ix = gdomain.getIndex("course");
+  m_spd_ix = gdomain.getIndex("speed");
+
+  m_osx = 0;
+  m_osy = 0;
+  m_tol = 0;
+  m_osx_set = false;
+  m_osy_set = false;
+
+  m_total_wt = 0;
+  m_min_util = 0;
+  m_max_util = 100;
+  m_spd_pts  = 0;
+}
+
+//----------------------------------------------------------------
+// Procedure: setParam
+
+bool AOF_AvoidCollisionMulti::setParam(const string& param,
+				       double param_val)
+{
+  if(param == "tol") {
+    if(param_val <= 0)
+      return(false);
+    m_tol = param_val;
+    return(true);
+  }
+  else if(param == "osx") {
+    m_osx = param_val;
+    m_osx_set = true;
+    return(true);
+  }
+  else if(param == "osy") {
+    m_osy = param_val;
+    m_osy_set = true;
+    return(true);
+  }
+  return(false);
+}
+
+//----------------------------------------------------------------
+// Procedure: setOwnshipParams
+
+void AOF_AvoidCollisionMulti::setOwnshipParams(double osx, double osy)
+{
+  setParam("osx", osx);
+  setParam("osy", osy);
+}
+
+//----------------------------------------------------------------
+// Procedure: addContact
+//      Note: The weight is the priority this contact would have had
+//            if handled by its own behavior, e.g., the relevance
+//            times the priority weight of BHV_AvoidCollision.
+
+void AOF_AvoidCollisionMulti::addContact(double cnx, double cny,
+					 double cnh, double cnv,
+					 double weight,
+					 double collision_dist,
+					 double all_clear_dist)
+{
+  if(weight <= 0)
+    return;
+  
+  m_cnx.push_back(cnx);
+  m_cny.push_back(cny);
+  m_cnh.push_back(cnh);
+  m_cnv.push_back(cnv);
+  m_weight.push_back(weight);
+  m_collision_dist.push_back(collision_dist);
+  m_all_clear_dist.push_back(all_clear_dist);
+}
+
+//----------------------------------------------------------------
+// Procedure: initialize
+//   Purpose: Evaluate the utility for all contacts over the whole
+//            course/speed grid in one pass, and sum the contacts
+//            into one utility grid, weighted by contact priority.
+//      Note: Each contact grid is normalized to [0,100] before it
+//            is weighted, just as each BHV_AvoidCollision function
+//            is normalized before handed to the solver. The result
+//            is the weighted mean, so the returned function with a
+//            priority of getTotalWeight() ranks decisions the same
+//            as the sum of the per-contact functions.
+
+bool AOF_AvoidCollisionMulti::initialize()
+{
+  if((m_crs_ix==-1) || (m_spd_ix==-1))
+    return(false);
+  if(!m_osx_set || !m_osy_set || (m_tol <= 0))
+    return(false);
+  if(m_cnx.size() == 0)
+    return(false);
+
+  // Part 1: Get the course and speed values of the domain
+  unsigned int crs_pts = m_domain.getVarPoints(m_crs_ix);
+  m_spd_pts = m_domain.getVarPoints(m_spd_ix);
+  vector<double> hdgs(crs_pts, 0);
+  vector<double> spds(m_spd_pts, 0);
+  for(unsigned int i=0; i<crs_pts; i++)
+    m_domain.getVal(m_crs_ix, i, hdgs[i]);
+  for(unsigned int j=0; j<m_spd_pts; j++)
+    m_domain.getVal(m_spd_ix, j, spds[j]);
+
+  unsigned int total = crs_pts * m_spd_pts;
+  m_grid_util.assign(total, 0);
+  m_total_wt = 0;
+
+  // Part 2: Evaluate each contact over the grid, and accumulate
+  CPAEngine cpa_engine;
+  vector<double> cpas;
+  vector<double> utils(total, 0);
+  for(unsigned int c=0; c<m_cnx.size(); c++) {
+    cpa_engine.reset(m_cny[c], m_cnx[c], m_cnh[c], m_cnv[c], m_osy, m_osx);
+    cpa_engine.evalCPAGrid(hdgs, spds, m_tol, cpas);
+
+    double min_dist = m_collision_dist[c];
+    double max_dist = m_all_clear_dist[c];
+    double umin = 100;
+    double umax = 0;
+    for(unsigned int k=0; k<total; k++) {
+      double util = metric(cpas[k], min_dist, max_dist);
+      utils[k] = util;
+      if(util < umin)
+	umin = util;
+      if(util > umax)
+	umax = util;
+    }
+
+    double wt = m_weight[c];
+    double urange = umax - umin;
+    if(urange > 0) {
+      double scale = 100.0 / urange;
+      for(unsigned int k=0; k<total; k++)
+	m_grid_util[k] += wt * ((utils[k] - umin) * scale);
+    }
+    else {
+      for(unsigned int k=0; k<total; k++)
+	m_grid_util[k] += wt * utils[k];
+    }
+    m_total_wt += wt;
+  }
+
+  // Part 3: Convert the weighted sum to the weighted mean
+  m_min_util = 100;
+  m_max_util = 0;
+  for(unsigned int k=0; k<total; k++) {
+    m_grid_util[k] /= m_total_wt;
+    if(m_grid_util[k] < m_min_util)
+      m_min_util = m_grid_util[k];
+    if(m_grid_util[k] > m_max_util)
+      m_max_util = m_grid_util[k];
+  }
+  
+  return(true);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalBox
+//   Purpose: Evaluates a given <Course, Speed> tuple given by a 2D
+//            ptBox (b), by lookup into the grid built on initialize.
+
+double AOF_AvoidCollisionMulti::evalBox(const IvPBox *b) const
+{
+  unsigned int crs_ix = (unsigned int)(b->pt(m_crs_ix));
+  unsigned int spd_ix = (unsigned int)(b->pt(m_spd_ix));
+  unsigned int ix = (crs_ix * m_spd_pts) + spd_ix;
+  if(ix >= m_grid_util.size())
+    return(0);
+  
+  return(m_grid_util[ix]);
+}
+
+//----------------------------------------------------------------
+// Procedure: metric
+//      Note: Same as the AOF_AvoidCollision metric
+
+double AOF_AvoidCollisionMulti::metric(double eval_dist, double min,
+				       double max) const
+{
+  if(eval_dist < min) return(0);
+  if(eval_dist > max) return(100);
+
+  double tween = 25.0 + 75.0 * (eval_dist - min) / (max-min);
+  return(tween);
+}
@@ -0,0 +1,89 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: AOF_AvoidCollisionMulti.h                            */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef AOF_AVOID_COLLISION_MULTI_HEADER
+#define AOF_AVOID_COLLISION_MULTI_HEADER
+
+#include <vector>
+#include "AOF.h"
+#include "CPAEngine.h"
+
+class IvPDomain;
+class AOF_AvoidCollisionMulti: public AOF {
+ public:
+  AOF_AvoidCollisionMulti(IvPDomain);
+  ~AOF_AvoidCollisionMulti() {}
+
+ public: // virtuals defined
+  double evalBox(const IvPBox*) const;   
+  bool   setParam(const std::string&, double);
+  bool   initialize();
+
+ public: // More virtuals defined Declare a known min/max eval range
+  bool   minMaxKnown() const {return(true);}
+  double getKnownMin() const {return(m_min_util);}
+  double getKnownMax() const {return(m_max_util);}
+
+ public: 
+  void   setOwnshipParams(double osx, double osy);
+  void   addContact(double cnx, double cny, double cnh, double cnv,
+		    double weight, double collision_dist,
+		    double all_clear_dist);
+
+  unsigned int size() const   {return(m_cnx.size());}
+  double getTotalWeight() const {return(m_total_wt);}
+
+ protected:
+  double metric(double, double min, double max) const;
+  
+ protected:
+  int    m_crs_ix;  // Index of "course" variable in IvPDomain
+  int    m_spd_ix;  // Index of "speed" variable in IvPDomain
+
+  double m_osx;
+  double m_osy;
+  double m_tol;
+  bool   m_osx_set;
+  bool   m_osy_set;
+  
+  // Per-contact parameters, one entry per contact
+  std::vector<double> m_cnx;
+  std::vector<double> m_cny;
+  std::vector<double> m_cnh;
+  std::vector<double> m_cnv;
+  std::vector<double> m_weight;
+  std::vector<double> m_collision_dist;
+  std::vector<double> m_all_clear_dist;
+
+  double m_total_wt;
+  double m_min_util;
+  double m_max_util;
+
+  // Aggregate utility over the course/speed grid, course-major
+  std::vector<double> m_grid_util;
+  unsigned int        m_spd_pts;
+};
+
+#endif
@@ -86,6 +86,15 @@ bool AOF_AvoidObstacleV24::initialize()
   if(m_obship_model.ownshipInGutPoly())
     return(postMsgAOF("m_obstacle contains osx,osy"));
 
+  // Part 2: Unless already provided, build the heading table so
+  //         each evalBox() is a lookup rather than a CPA calc.
+  if(!m_obship_model.hasHdgTable()) {
+    double crs_low   = m_domain.getVarLow(m_crs_ix);
+    double crs_delta = m_domain.getVarDelta(m_crs_ix);
+    unsigned int crs_pts = m_domain.getVarPoints(m_crs_ix);
+    m_obship_model.buildHdgTable(crs_low, crs_delta, crs_pts);
+  }
+
   return(true);
 }
 
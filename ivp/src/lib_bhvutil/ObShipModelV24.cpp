@@ -90,6 +90,9 @@ ObShipModelV24::ObShipModelV24(double osx, double osy,
   m_rim_bng_min_dist_to_poly = 0;
   m_rim_bng_max_dist_to_poly = 0;
 
+  m_hdg_table_low   = 0;
+  m_hdg_table_delta = 1;
+
   m_turn_cache_enabled = true;
   m_pause_update_dynamic = false;
 }
@@ -117,6 +120,7 @@ bool ObShipModelV24::setPoseOSX(double osx)
 {
   m_plat_model.setOSX(osx);
   m_stale_cache = true;
+  clearHdgTable();
   return(true);
 }
 
@@ -127,6 +131,7 @@ bool ObShipModelV24::setPoseOSY(double osy)
 {
   m_plat_model.setOSY(osy);
   m_stale_cache = true;
+  clearHdgTable();
   return(true);
 }
 
@@ -137,6 +142,7 @@ bool ObShipModelV24::setPoseOSH(double osh)
 {
   m_plat_model.setOSH(osh);
   m_stale_cache = true;
+  clearHdgTable();
   return(true);
 }
 
@@ -147,6 +153,7 @@ bool ObShipModelV24::setPoseOSV(double osv)
 {
   m_plat_model.setOSV(osv);
   m_stale_cache = true;
+  clearHdgTable();
   return(true);
 }
 
@@ -157,6 +164,7 @@ void ObShipModelV24::setPlatModel(PlatModel plat_model)
 {
   m_plat_model = plat_model;
   m_stale_cache = true;
+  clearHdgTable();
 }
 
 // ----------------------------------------------------------
@@ -257,6 +265,7 @@ string ObShipModelV24::setGutPoly(XYPolygon new_gut_poly)
   //updateDynamic();
   
   m_stale_cache = true;
+  clearHdgTable();
   return("");
 }
 
@@ -689,9 +698,8 @@ double ObShipModelV24::evalHdgSpd(double hdg, double spd,
   double max_util_cpa = vpct * m_max_util_cpa;
 
     
-  double ix,iy; // ToDo reason about TTC with ix,iy 
-  double stemdist;
-  double cpa = seglrCPA(hdg, ix,iy, stemdist, verbose);
+  double stemdist; // ToDo reason about TTC with stemdist
+  double cpa = hdgCPA(hdg, stemdist, verbose);
 
   if(cpa >= m_max_util_cpa)
     return(m_max_util);
@@ -717,6 +725,64 @@ double ObShipModelV24::evalHdgSpd(double hdg, double spd,
 }
 
 
+// ----------------------------------------------------------
+// Procedure: buildHdgTable()
+//   Purpose: Calculate the seglr CPA to the gut poly for each of
+//            the given headings, typically each course choice in
+//            the decision domain. Subsequent evaluations at these
+//            headings, by the AOF or refinery, are a table lookup.
+
+void ObShipModelV24::buildHdgTable(double hdg_low, double hdg_delta,
+				   unsigned int hdg_pts)
+{
+  clearHdgTable();
+  if((hdg_delta <= 0) || !m_gut_poly.is_convex())
+    return;
+
+  m_hdg_table_low   = hdg_low;
+  m_hdg_table_delta = hdg_delta;
+
+  double ix, iy, stemdist;
+  for(unsigned int i=0; i<hdg_pts; i++) {
+    double hdg = hdg_low + ((double)(i) * hdg_delta);
+    double cpa = seglrCPA(hdg, ix, iy, stemdist);
+    m_hdg_table_cpa.push_back(cpa);
+    m_hdg_table_stem.push_back(stemdist);
+  }
+}
+
+// ----------------------------------------------------------
+// Procedure: clearHdgTable()
+
+void ObShipModelV24::clearHdgTable()
+{
+  m_hdg_table_cpa.clear();
+  m_hdg_table_stem.clear();
+}
+
+// ----------------------------------------------------------
+// Procedure: hdgCPA()
+//   Purpose: Get the seglr CPA to the gut poly for the given hdg
+//            from the heading table if the hdg is one of its
+//            entries. Otherwise calculate it directly.
+
+double ObShipModelV24::hdgCPA(double hdg, double& stemdist,
+			      bool verbose) const
+{
+  if(!verbose && (m_hdg_table_cpa.size() > 0)) {
+    double dix = (hdg - m_hdg_table_low) / m_hdg_table_delta;
+    int ix = (int)(floor(dix + 0.5));
+    if((ix >= 0) && (ix < (int)(m_hdg_table_cpa.size())) &&
+       (fabs(dix - (double)(ix)) < 0.000001)) {
+      stemdist = m_hdg_table_stem[ix];
+      return(m_hdg_table_cpa[ix]);
+    }
+  }
+
+  double rx, ry;
+  return(seglrCPA(hdg, rx, ry, stemdist, verbose));
+}
+
 // ----------------------------------------------------------
 // Procedure: setCachedVals()
 
@@ -1014,11 +1080,11 @@ bool ObShipModelV24::setBngMinMaxToGutPoly()
   vector<double> gut_cpa_dist;
   vector<double> gut_stem_dist;
 
-  double ix, iy, stem_dist;
+  // Use the heading table where built, e.g., by the behavior
+  // prior to building the objective function
+  double stem_dist;
   for(unsigned int ang=0; ang<360; ang++) {
-    XYSeglr seglr = m_plat_model.getTurnSeglr((double)(ang));
-    double cpa_dist = distSeglrToPoly(seglr, m_gut_poly,
-				      ix, iy, stem_dist);
+    double cpa_dist = hdgCPA((double)(ang), stem_dist);
 
     gut_cpa_dist.push_back(cpa_dist);
     gut_stem_dist.push_back(stem_dist);
@@ -139,6 +139,12 @@ class ObShipModelV24
 
   double evalHdgSpd(double hdg, double spd, bool verbose=false) const;
 
+  void   buildHdgTable(double hdg_low, double hdg_delta,
+		       unsigned int hdg_pts);
+  void   clearHdgTable();
+  bool   hasHdgTable() const {return(m_hdg_table_cpa.size() > 0);}
+  double hdgCPA(double hdg, double& stemdist, bool verbose=false) const;
+
   void   setCachedVals(bool force=false);
 
   void   updateBngExtremes();
@@ -214,6 +220,14 @@ private:
   double m_rim_bng_min_dist_to_poly;
   double m_rim_bng_max_dist_to_poly;
 
+  // Seglr CPA and stem dist to the gut poly for each heading in
+  // the decision domain. Built once per iteration and cleared on
+  // any change to the pose, platform model or gut poly.
+  std::vector<double> m_hdg_table_cpa;
+  std::vector<double> m_hdg_table_stem;
+  double m_hdg_table_low;
+  double m_hdg_table_delta;
+
   // ToDo improvements:
   
   // 1) calc and cache the seglr for each hdg angle. Use in
@@ -22,9 +22,12 @@
 /*****************************************************************/
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 #include "ContactLedger.h"
-#include "LinearExtrapolator.h"
 #include "NodeRecordUtils.h"
+#include "AngleUtils.h"
+#include "CPAEngine.h"
 #include "MBUtils.h"
 
 using namespace std;
@@ -35,49 +38,115 @@ using namespace std;
 ContactLedger::ContactLedger()
 {
   m_curr_time_utc = 0;
+  m_decay_start   = 0;
+  m_decay_end     = 0;
 }
 
 //---------------------------------------------------------------
-// Procedure: extrapolate()
+// Procedure: setDecay()
+//   Purpose: Set the extrapolation decay, as in LinearExtrapolator.
+//            Speed is held until decay start, then decays linearly
+//            to zero at decay end.
 
-void ContactLedger::extrapolate()
+void ContactLedger::setDecay(double start, double end)
 {
-  map<string,NodeRecord>::iterator p;
-  for(p=m_map_records_rep.begin(); p!=m_map_records_rep.end(); p++) {
-    string vname = p->first;
-    extrapolate(vname);
-  }
+  m_decay_start = start;
+  m_decay_end   = end;
 }
 
 //---------------------------------------------------------------
 // Procedure: extrapolate()
+//   Purpose: Extrapolate all contacts and update the extrapolated
+//            records used by getX() and getY().
 
-void ContactLedger::extrapolate(string vname)
+void ContactLedger::extrapolate()
 {
-  if(!hasVName(vname))
-    return;
-  
-  NodeRecord record_rep = m_map_records_rep[vname];
-  double x = record_rep.getX();
-  double y = record_rep.getY();
-  double hdg = record_rep.getHeading();
-  double spd = record_rep.getSpeed();
-  double utc = record_rep.getSpeed();
-  
-  LinearExtrapolator extrapolator;
-  
-  extrapolator.setPosition(x, y, spd, hdg, utc);
+  extrapolateAll();
 
-  double new_x, new_y;
-  bool ok = extrapolator.getPosition(new_x, new_y, m_curr_time_utc);
+  map<string,unsigned int>::iterator p;
+  for(p=m_map_ids.begin(); p!=m_map_ids.end(); p++) {
+    m_map_records_ext[p->first].setX(m_col_ext_x[p->second]);
+    m_map_records_ext[p->first].setY(m_col_ext_y[p->second]);
+  }
+}
 
-  if(!ok) {
-    string failure_reason = extrapolator.getFailureReason();
-    cout << "Extrap Fail: " << failure_reason << endl;
+//---------------------------------------------------------------
+// Procedure: extrapolateAll()
+//   Purpose: Extrapolate the position of every contact to the
+//            current time in one pass over the columnar store.
+//      Note: Results match LinearExtrapolator. In its error cases,
+//            clock skew or a bad decay config, the last reported
+//            position is used.
+
+void ContactLedger::extrapolateAll()
+{
+  double decay_range = m_decay_end - m_decay_start;
+  bool   decay_bad   = (m_decay_end < m_decay_start);
+  
+  unsigned int rows = m_col_vname.size();
+  for(unsigned int i=0; i<rows; i++) {
+    if(!m_col_active[i])
+      continue;
+    
+    double delta_time = m_curr_time_utc - m_col_utc[i];
+    if(decay_bad || (delta_time < -0.1) || (delta_time == 0)) {
+      m_col_ext_x[i] = m_col_x[i];
+      m_col_ext_y[i] = m_col_y[i];
+      continue;
+    }
+
+    double spd = m_col_spd[i];
+    double distance = 0;
+    if(delta_time <= m_decay_start)
+      distance = spd * delta_time;
+    else if(decay_range <= 0)
+      distance = spd * m_decay_start;
+    else if(delta_time <= m_decay_end) {
+      double decay_rate = (spd / decay_range);
+      double decay_time = delta_time - m_decay_start;
+      double curr_speed = spd - (decay_rate * decay_time);
+      double avg_speed  = (spd + curr_speed) / 2.0;
+      distance = (spd * m_decay_start) + (avg_speed * decay_time);
+    }
+    else
+      distance = (spd * m_decay_start) + ((spd/2.0) * decay_range);
+
+    m_col_ext_x[i] = m_col_x[i] + (m_col_ux[i] * distance);
+    m_col_ext_y[i] = m_col_y[i] + (m_col_uy[i] * distance);
   }
-  else {
-    m_map_records_ext[vname].setX(new_x);
-    m_map_records_ext[vname].setY(new_y);
+}
+
+//---------------------------------------------------------------
+// Procedure: updateRanges()
+//   Purpose: Update the range and bearing from ownship to the last
+//            reported position of each contact, and the range to
+//            the extrapolated position. If cpa_time is positive,
+//            also update the CPA range from the extrapolated
+//            position with ownship at the given heading and speed.
+//      Note: Ranges to the extrapolated position are as of the
+//            latest call to extrapolateAll().
+
+void ContactLedger::updateRanges(double osx, double osy, double osh,
+				 double osv, double cpa_time)
+{
+  unsigned int rows = m_col_vname.size();
+  for(unsigned int i=0; i<rows; i++) {
+    if(!m_col_active[i])
+      continue;
+
+    double cnx = m_col_x[i];
+    double cny = m_col_y[i];
+    double ext_x = m_col_ext_x[i];
+    double ext_y = m_col_ext_y[i];
+    
+    m_col_range[i] = hypot((osx - cnx), (osy - cny));
+    m_col_range_ext[i] = hypot((osx - ext_x), (osy - ext_y));
+    m_col_bng[i] = relAng(osx, osy, cnx, cny);
+
+    if(cpa_time > 0) {
+      CPAEngine engine(ext_y, ext_x, m_col_hdg[i], m_col_spd[i], osy, osx);
+      m_col_range_cpa[i] = engine.evalCPA(osh, osv, cpa_time);
+    }
   }
 }
 
@@ -87,44 +156,187 @@ void ContactLedger::extrapolate(string vname)
 bool ContactLedger::processReport(string report)
 {
   NodeRecord new_record = string2NodeRecord(report);
+  return(processRecord(new_record));
+}
 
-  if(!new_record.valid("name,x,y,time"))
-    return(false);
+//---------------------------------------------------------------
+// Procedure: processRecord()
 
-  string raw_vname = new_record.getName();
-  string vname = toupper(raw_vname);
+bool ContactLedger::processRecord(NodeRecord new_record,
+				  bool require_valid)
+{
+  if(require_valid && !new_record.valid("name,x,y,time"))
+    return(false);
+  
+  string vname = new_record.getName();
   
   m_map_records_rep[vname] = new_record;
   m_map_records_ext[vname] = new_record;
 
+  // Update the contact's row in the columnar store
+  unsigned int id = 0;
+  map<string,unsigned int>::iterator p = m_map_ids.find(vname);
+  if(p != m_map_ids.end())
+    id = p->second;
+  else
+    id = addRow(vname);
+
+  double hdg = new_record.getHeading();
+  if((hdg < 0) || (hdg >= 360))
+    hdg = angle360(hdg);
+  
+  m_col_x[id]   = new_record.getX();
+  m_col_y[id]   = new_record.getY();
+  m_col_hdg[id] = new_record.getHeading();
+  m_col_spd[id] = new_record.getSpeed();
+  m_col_utc[id] = new_record.getTimeStamp();
+  m_col_ext_x[id] = m_col_x[id];
+  m_col_ext_y[id] = m_col_y[id];
+
+  // Unit vectors as in projectPoint(), exact on the axes
+  double ux = 0;
+  double uy = 0;
+  if(hdg == 0)
+    uy = 1;
+  else if(hdg == 90)
+    ux = 1;
+  else if(hdg == 180)
+    uy = -1;
+  else if(hdg == 270)
+    ux = -1;
+  else {
+    double radang = degToRadians(hdg);
+    ux = sin(radang);
+    uy = cos(radang);
+  }
+  m_col_ux[id] = ux;
+  m_col_uy[id] = uy;
+
   return(true);
 }
 
 //---------------------------------------------------------------
-// Procedure: processRecord()
+// Procedure: removeVName()
 
-bool ContactLedger::processRecord(NodeRecord new_record)
+bool ContactLedger::removeVName(string vname)
 {
-  if(!new_record.valid("name,x,y,time"))
+  map<string,unsigned int>::iterator p = m_map_ids.find(vname);
+  if(p == m_map_ids.end())
     return(false);
+
+  unsigned int id = p->second;
+  m_col_active[id] = false;
+  m_col_vname[id]  = "";
+  m_free_ids.push_back(id);
   
-  string raw_vname = new_record.getName();
-  string vname = toupper(raw_vname);
+  m_map_ids.erase(p);
+  m_map_records_rep.erase(vname);
+  m_map_records_ext.erase(vname);
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: addRow()
+//   Purpose: Get a row for a new contact, reusing a free row if
+//            one exists.
+
+unsigned int ContactLedger::addRow(string vname)
+{
+  unsigned int id = m_col_vname.size();
+  if(m_free_ids.size() > 0) {
+    id = m_free_ids.back();
+    m_free_ids.pop_back();
+  }
+  else {
+    m_col_vname.push_back("");
+    m_col_active.push_back(false);
+    m_col_x.push_back(0);
+    m_col_y.push_back(0);
+    m_col_hdg.push_back(0);
+    m_col_spd.push_back(0);
+    m_col_utc.push_back(0);
+    m_col_ux.push_back(0);
+    m_col_uy.push_back(0);
+    m_col_ext_x.push_back(0);
+    m_col_ext_y.push_back(0);
+    m_col_range.push_back(0);
+    m_col_range_ext.push_back(0);
+    m_col_range_cpa.push_back(0);
+    m_col_bng.push_back(0);
+  }
+
+  m_col_vname[id]  = vname;
+  m_col_active[id] = true;
+  m_col_range[id]     = 0;
+  m_col_range_ext[id] = 0;
+  m_col_range_cpa[id] = 0;
+  m_col_bng[id]       = 0;
   
-  m_map_records_rep[vname] = new_record;
-  m_map_records_ext[vname] = new_record;
+  m_map_ids[vname] = id;
+  return(id);
+}
 
-  return(true);
+//---------------------------------------------------------------
+// Procedure: getID()
+//   Returns: The row of the given contact, or -1 if unknown.
+
+int ContactLedger::getID(string vname) const
+{
+  map<string,unsigned int>::const_iterator p = m_map_ids.find(vname);
+  if(p == m_map_ids.end())
+    return(-1);
+  return((int)(p->second));
 }
 
+//---------------------------------------------------------------
+// Procedure: isActiveID()
+
+bool ContactLedger::isActiveID(unsigned int id) const
+{
+  if(id >= m_col_active.size())
+    return(false);
+  return(m_col_active[id]);
+}
+
+//---------------------------------------------------------------
+// Procedure: getRangeOrderedIDs()
+//   Purpose: Get the ids of all contacts, sorted by range to the
+//            last reported position, closest first. Ties are
+//            broken by contact name.
+
+class RangeOrder
+{
+public:
+  RangeOrder(const vector<double>& ranges,
+	     const vector<string>& vnames) :
+    m_ranges(ranges), m_vnames(vnames) {}
+
+  bool operator()(unsigned int a, unsigned int b) const {
+    if(m_ranges[a] != m_ranges[b])
+      return(m_ranges[a] < m_ranges[b]);
+    return(m_vnames[a] < m_vnames[b]);
+  }
+  
+  const vector<double>& m_ranges;
+  const vector<string>& m_vnames;
+};
+
+vector<unsigned int> ContactLedger::getRangeOrderedIDs() const
+{
+  vector<unsigned int> ids;
+  map<string,unsigned int>::const_iterator p;
+  for(p=m_map_ids.begin(); p!=m_map_ids.end(); p++)
+    ids.push_back(p->second);
+
+  sort(ids.begin(), ids.end(), RangeOrder(m_col_range, m_col_vname));
+  return(ids);
+}
 
 //---------------------------------------------------------------
 // Procedure: hasVName()
 
 bool ContactLedger::hasVName(string vname) const
 {
-  vname = toupper(vname);
-  
   if(m_map_records_rep.count(vname) == 0)
     return(false);
 
@@ -226,7 +438,7 @@ double ContactLedger::getLon(string vname) const
 string ContactLedger::getGroup(string vname) const
 {
   if(!hasVName(vname))
-    return(0);
+    return("");
 
   NodeRecord record = getRecord(vname, false);
   return(record.getGroup());
@@ -238,20 +450,64 @@ string ContactLedger::getGroup(string vname) const
 string ContactLedger::getType(string vname) const
 {
   if(!hasVName(vname))
-    return(0);
+    return("");
 
   NodeRecord record = getRecord(vname, false);
   return(record.getType());
 }
 
 
+//---------------------------------------------------------------
+// Procedure: getRange()
+//      Note: Range to the last reported position as of the latest
+//            call to updateRanges().
+
+double ContactLedger::getRange(string vname) const
+{
+  int id = getID(vname);
+  if(id < 0)
+    return(0);
+  return(m_col_range[id]);
+}
+
+//---------------------------------------------------------------
+// Procedure: getRangeExt()
+
+double ContactLedger::getRangeExt(string vname) const
+{
+  int id = getID(vname);
+  if(id < 0)
+    return(0);
+  return(m_col_range_ext[id]);
+}
+
+//---------------------------------------------------------------
+// Procedure: getRangeCPA()
+
+double ContactLedger::getRangeCPA(string vname) const
+{
+  int id = getID(vname);
+  if(id < 0)
+    return(0);
+  return(m_col_range_cpa[id]);
+}
+
+//---------------------------------------------------------------
+// Procedure: getBearing()
+
+double ContactLedger::getBearing(string vname) const
+{
+  int id = getID(vname);
+  if(id < 0)
+    return(0);
+  return(m_col_bng[id]);
+}
+
 //---------------------------------------------------------------
 // Procedure: getRecord()
 
 NodeRecord ContactLedger::getRecord(string vname, bool extrap) const
 {
-  vname = toupper(vname);
-  
   if(extrap) {
     map<string,NodeRecord>::const_iterator q=m_map_records_ext.find(vname);
     if(q!=m_map_records_ext.end())
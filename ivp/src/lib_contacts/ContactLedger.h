@@ -25,6 +25,8 @@
 #define CONTACT_LEDGER_HEADER
 
 #include <string>
+#include <vector>
+#include <map>
 #include "NodeRecord.h"
 
 class ContactLedger
@@ -34,10 +36,15 @@ public:
   ~ContactLedger() {};
 
   void setCurrTimeUTC(double utc) {m_curr_time_utc=utc;}
+  void setDecay(double start, double end);
   void extrapolate();
+  void extrapolateAll();
+  void updateRanges(double osx, double osy, double osh=0,
+		    double osv=0, double cpa_time=0);
   
   bool processReport(std::string report);
-  bool processRecord(NodeRecord record);
+  bool processRecord(NodeRecord record, bool require_valid=true);
+  bool removeVName(std::string vname);
 
   bool   hasVName(std::string) const;
 
@@ -50,18 +57,72 @@ public:
   double getLon(std::string vname) const;
   std::string getGroup(std::string vname) const;
   std::string getType(std::string vname) const;
-  
+
+  double getRange(std::string vname) const;
+  double getRangeExt(std::string vname) const;
+  double getRangeCPA(std::string vname) const;
+  double getBearing(std::string vname) const;
+
+public: // Columnar store access, rows indexed by contact id
+  int          getID(std::string vname) const;
+  unsigned int size() const    {return(m_map_ids.size());}
+  unsigned int getRows() const {return(m_col_vname.size());}
+  bool         isActiveID(unsigned int id) const;
+
+  std::string getVNameByID(unsigned int id) const {return(m_col_vname[id]);}
+
+  double getXByID(unsigned int id) const      {return(m_col_x[id]);}
+  double getYByID(unsigned int id) const      {return(m_col_y[id]);}
+  double getExtXByID(unsigned int id) const   {return(m_col_ext_x[id]);}
+  double getExtYByID(unsigned int id) const   {return(m_col_ext_y[id]);}
+  double getHeadingByID(unsigned int id) const {return(m_col_hdg[id]);}
+  double getSpeedByID(unsigned int id) const  {return(m_col_spd[id]);}
+  double getUTCByID(unsigned int id) const    {return(m_col_utc[id]);}
+
+  double getRangeByID(unsigned int id) const    {return(m_col_range[id]);}
+  double getRangeExtByID(unsigned int id) const {return(m_col_range_ext[id]);}
+  double getRangeCPAByID(unsigned int id) const {return(m_col_range_cpa[id]);}
+  double getBearingByID(unsigned int id) const  {return(m_col_bng[id]);}
+
+  std::vector<unsigned int> getRangeOrderedIDs() const;
 
 protected:
   NodeRecord getRecord(std::string vname, bool extrap=true) const;
-  void       extrapolate(std::string vname);
+  unsigned int addRow(std::string vname);
   
  protected: 
   std::map<std::string, NodeRecord> m_map_records_rep;
   std::map<std::string, NodeRecord> m_map_records_ext;
 
   double m_curr_time_utc;
-};
+  double m_decay_start;
+  double m_decay_end;
+
+ protected: // Columnar store. Rows are keyed on the name exactly as
+            // reported, as in the apps using the ledger, so names
+            // differing only in case are distinct. A row is reused
+            // once its contact is removed. Unit vectors are set from
+            // the heading when a record arrives, for extrapolation.
+  std::map<std::string, unsigned int> m_map_ids;
+  std::vector<unsigned int>           m_free_ids;
 
-#endif 
+  std::vector<std::string> m_col_vname;
+  std::vector<bool>        m_col_active;
+  std::vector<double>      m_col_x;
+  std::vector<double>      m_col_y;
+  std::vector<double>      m_col_hdg;
+  std::vector<double>      m_col_spd;
+  std::vector<double>      m_col_utc;
+  std::vector<double>      m_col_ux;
+  std::vector<double>      m_col_uy;
+
+  // Derived on each call to extrapolateAll() and updateRanges()
+  std::vector<double>      m_col_ext_x;
+  std::vector<double>      m_col_ext_y;
+  std::vector<double>      m_col_range;
+  std::vector<double>      m_col_range_ext;
+  std::vector<double>      m_col_range_cpa;
+  std::vector<double>      m_col_bng;
+};
 
+#endif
@@ -109,6 +109,9 @@ class NodeRecord
   bool   valid(std::string check, std::string& why) const;
   std::string getProperty(std::string) const;
 
+  const std::map<std::string, std::string>& getProperties() const
+  {return(m_properties);}
+
   std::string getName(std::string s="") const;
   std::string getGroup(std::string s="") const;
   std::string getType(std::string s="") const;
@@ -24,6 +24,9 @@
 #include <iostream>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <stdint.h>
 #include "NodeRecordUtils.h"
 #include "MBUtils.h"
 #include "LinearExtrapolator.h"
@@ -78,86 +81,664 @@ NodeRecord extrapolateRecord(const NodeRecord& record, double curr_time,
   return(record);
 }
 
+//---------------------------------------------------------
+// Node report field identifiers used by the single-pass parser
+
+enum NodeReportField {NRF_NONE, NRF_NAME, NRF_TYPE, NRF_MODE, NRF_ALLSTOP,
+		      NRF_INDEX, NRF_TIME, NRF_X, NRF_Y, NRF_LAT, NRF_LON,
+		      NRF_SPEED, NRF_HEADING, NRF_DEPTH, NRF_LENGTH,
+		      NRF_YAW, NRF_ALTITUDE, NRF_HDG_OG, NRF_SPD_OG,
+		      NRF_TRANSPARENCY, NRF_COLOR, NRF_GROUP,
+		      NRF_LOAD_WARNING, NRF_THRUST_REVERSE, NRF_TRAJECTORY};
+
+//---------------------------------------------------------
+// Procedure: nodeReportField()
+//   Purpose: Map a (case-insensitive) node report key to a field id.
+//            Dispatch is on key length first so at most a few short
+//            compares are made per key, with no allocation.
+
+static NodeReportField nodeReportField(const char *key, unsigned int len)
+{
+  // Longest known key is THRUST_MODE_REVERSE (19 chars)
+  if((len == 0) || (len > 19))
+    return(NRF_NONE);
+
+  char ukey[20];
+  for(unsigned int i=0; i<len; i++)
+    ukey[i] = toupper(key[i]);
+  ukey[len] = '\0';
+
+  switch(len) {
+  case 1:
+    if(ukey[0] == 'X')  return(NRF_X);
+    if(ukey[0] == 'Y')  return(NRF_Y);
+    break;
+  case 3:
+    if(!strcmp(ukey, "LAT"))  return(NRF_LAT);
+    if(!strcmp(ukey, "LON"))  return(NRF_LON);
+    if(!strcmp(ukey, "SPD"))  return(NRF_SPEED);
+    if(!strcmp(ukey, "HDG"))  return(NRF_HEADING);
+    if(!strcmp(ukey, "DEP"))  return(NRF_DEPTH);
+    if(!strcmp(ukey, "LEN"))  return(NRF_LENGTH);
+    if(!strcmp(ukey, "YAW"))  return(NRF_YAW);
+    if(!strcmp(ukey, "ALT"))  return(NRF_ALTITUDE);
+    break;
+  case 4:
+    if(!strcmp(ukey, "NAME"))  return(NRF_NAME);
+    if(!strcmp(ukey, "TYPE"))  return(NRF_TYPE);
+    if(!strcmp(ukey, "MODE"))  return(NRF_MODE);
+    if(!strcmp(ukey, "TIME"))  return(NRF_TIME);
+    break;
+  case 5:
+    if(!strcmp(ukey, "INDEX"))  return(NRF_INDEX);
+    if(!strcmp(ukey, "SPEED"))  return(NRF_SPEED);
+    if(!strcmp(ukey, "DEPTH"))  return(NRF_DEPTH);
+    if(!strcmp(ukey, "COLOR"))  return(NRF_COLOR);
+    if(!strcmp(ukey, "GROUP"))  return(NRF_GROUP);
+    break;
+  case 6:
+    if(!strcmp(ukey, "LENGTH"))  return(NRF_LENGTH);
+    if(!strcmp(ukey, "HDG_OG"))  return(NRF_HDG_OG);
+    if(!strcmp(ukey, "SPD_OG"))  return(NRF_SPD_OG);
+    break;
+  case 7:
+    if(!strcmp(ukey, "ALLSTOP"))  return(NRF_ALLSTOP);
+    if(!strcmp(ukey, "HEADING"))  return(NRF_HEADING);
+    break;
+  case 8:
+    if(!strcmp(ukey, "UTC_TIME"))  return(NRF_TIME);
+    if(!strcmp(ukey, "ALTITUDE"))  return(NRF_ALTITUDE);
+    break;
+  case 10:
+    if(!strcmp(ukey, "TRAJECTORY"))  return(NRF_TRAJECTORY);
+    break;
+  case 12:
+    if(!strcmp(ukey, "TRANSPARENCY"))  return(NRF_TRANSPARENCY);
+    if(!strcmp(ukey, "LOAD_WARNING"))  return(NRF_LOAD_WARNING);
+    break;
+  case 19:
+    if(!strcmp(ukey, "THRUST_MODE_REVERSE"))  return(NRF_THRUST_REVERSE);
+    break;
+  }
+  return(NRF_NONE);
+}
+
+//---------------------------------------------------------
+// Procedure: isNumberSpan()
+//   Purpose: Same test as MBUtils isNumber() applied to a span of
+//            characters already stripped of blank ends.
+
+static bool isNumberSpan(const char *str, unsigned int len)
+{
+  if(len == 0)
+    return(false);
+  if((len > 1) && (str[0] == '+')) {
+    str++;
+    len--;
+  }
+
+  bool digits_found = false;
+  bool decimal_found = false;
+  for(unsigned int i=0; i<len; i++) {
+    char c = str[i];
+    if((c >= '0') && (c <= '9'))
+      digits_found = true;
+    else if(c == '.') {
+      if(decimal_found)
+	return(false);
+      decimal_found = true;
+    }
+    else if(c == '-') {
+      if(digits_found || decimal_found)
+	return(false);
+    }
+    else
+      return(false);
+  }
+  return(digits_found);
+}
+
+//---------------------------------------------------------
+// Procedure: atofSpan()
+//   Purpose: Equivalent of atof() on a span that is not null
+//            terminated. Short spans are copied to a stack buffer.
+
+static double atofSpan(const char *str, unsigned int len)
+{
+  char buff[64];
+  if(len < sizeof(buff)) {
+    memcpy(buff, str, len);
+    buff[len] = '\0';
+    return(strtod(buff, 0));
+  }
+  string sval(str, len);
+  return(strtod(sval.c_str(), 0));
+}
+
+//---------------------------------------------------------
+// Procedure: handleNodeReportField()
+//   Purpose: Apply one param=value component to the given record.
+//            NAME, TYPE, MODE, ALLSTOP and INDEX are always applied,
+//            numeric fields only if the value is a number, and the
+//            remaining string fields only if the value is not a number.
+
+static void handleNodeReportField(NodeRecord& record,
+				  const char *part, unsigned int len)
+{
+  // Split on the first '=' and strip blank ends of both halves
+  unsigned int eq = 0;
+  while((eq < len) && (part[eq] != '='))
+    eq++;
+
+  const char *key = part;
+  unsigned int klen = eq;
+  const char *val = part + len;
+  unsigned int vlen = 0;
+  if(eq < len) {
+    val  = part + eq + 1;
+    vlen = len - eq - 1;
+  }
+
+  while((klen > 0) && ((key[0] == ' ') || (key[0] == '\t'))) {
+    key++;
+    klen--;
+  }
+  while((klen > 0) && ((key[klen-1] == ' ') || (key[klen-1] == '\t')))
+    klen--;
+  while((vlen > 0) && ((val[0] == ' ') || (val[0] == '\t'))) {
+    val++;
+    vlen--;
+  }
+  while((vlen > 0) && ((val[vlen-1] == ' ') || (val[vlen-1] == '\t')))
+    vlen--;
+
+  NodeReportField field = nodeReportField(key, klen);
+  if(field == NRF_NONE)
+    return;
+
+  switch(field) {
+  case NRF_NAME:
+    record.setName(string(val, vlen));
+    return;
+  case NRF_TYPE:
+    record.setType(string(val, vlen));
+    return;
+  case NRF_MODE:
+    record.setMode(string(val, vlen));
+    return;
+  case NRF_ALLSTOP:
+    record.setAllStop(string(val, vlen));
+    return;
+  case NRF_INDEX:
+    record.setIndex(atofSpan(val, vlen));
+    return;
+  default:
+    break;
+  }
+
+  bool is_number = isNumberSpan(val, vlen);
+  switch(field) {
+  case NRF_TIME:
+    if(is_number) record.setTimeStamp(atofSpan(val, vlen));
+    break;
+  case NRF_X:
+    if(is_number) record.setX(atofSpan(val, vlen));
+    break;
+  case NRF_Y:
+    if(is_number) record.setY(atofSpan(val, vlen));
+    break;
+  case NRF_LAT:
+    if(is_number) record.setLat(atofSpan(val, vlen));
+    break;
+  case NRF_LON:
+    if(is_number) record.setLon(atofSpan(val, vlen));
+    break;
+  case NRF_SPEED:
+    if(is_number) record.setSpeed(atofSpan(val, vlen));
+    break;
+  case NRF_HEADING:
+    if(is_number) record.setHeading(atofSpan(val, vlen));
+    break;
+  case NRF_DEPTH:
+    if(is_number) record.setDepth(atofSpan(val, vlen));
+    break;
+  case NRF_LENGTH:
+    if(is_number) record.setLength(atofSpan(val, vlen));
+    break;
+  case NRF_YAW:
+    if(is_number) record.setYaw(atofSpan(val, vlen));
+    break;
+  case NRF_ALTITUDE:
+    if(is_number) record.setAltitude(atofSpan(val, vlen));
+    break;
+  case NRF_HDG_OG:
+    if(is_number) record.setHeadingOG(atofSpan(val, vlen));
+    break;
+  case NRF_SPD_OG:
+    if(is_number) record.setSpeedOG(atofSpan(val, vlen));
+    break;
+  case NRF_TRANSPARENCY:
+    if(is_number) record.setTransparency(atofSpan(val, vlen));
+    break;
+  case NRF_COLOR:
+    if(!is_number) record.setColor(string(val, vlen));
+    break;
+  case NRF_GROUP:
+    if(!is_number) record.setGroup(string(val, vlen));
+    break;
+  case NRF_LOAD_WARNING:
+    if(!is_number) record.setLoadWarning(string(val, vlen));
+    break;
+  case NRF_THRUST_REVERSE:
+    if(!is_number && (vlen == 4) && (tolower(val[0]) == 't') &&
+       (tolower(val[1]) == 'r') && (tolower(val[2]) == 'u') &&
+       (tolower(val[3]) == 'e'))
+      record.setThrustModeReverse(true);
+    break;
+  case NRF_TRAJECTORY:
+    if(!is_number) record.setTrajectory(stripBraces(string(val, vlen)));
+    break;
+  default:
+    break;
+  }
+}
+
+//---------------------------------------------------------
+// Binary node report layout (all integers little-endian):
+//
+//   [4]  Header: 0xB1 'N' 'R' <version>
+//   [4]  Field mask, one bit per numeric field (NRB_* below), plus
+//        bits for thrust_mode_reverse and trajectory
+//   [4]  Index (signed)
+//   [8]  One IEEE double per numeric field set in the mask, in
+//        NRB_* bit order
+//   Strings: name, type, group, color, mode, mode_aux, allstop,
+//        load_warning, then trajectory if its mask bit is set
+//   [2]  Number of properties, then a key and value string each
+//
+// Each string starts with a code byte: 0 is the empty string,
+// 1-127 is the length of the literal bytes that follow, 128 means a
+// 2-byte length follows, and 129 and above index the interned token
+// table of the report's version. Strings longer than 0xFFFF bytes
+// cannot be encoded.
+
+#define NRB_VERSION 1
+
+enum {NRB_X=0, NRB_Y, NRB_LAT, NRB_LON, NRB_SPEED, NRB_HEADING,
+      NRB_DEPTH, NRB_LENGTH, NRB_TIME, NRB_YAW, NRB_ALTITUDE,
+      NRB_HDG_OG, NRB_SPD_OG, NRB_TRANSPARENCY, NRB_PITCH,
+      NRB_NUMERIC_FIELDS, NRB_THRUST_REVERSE=NRB_NUMERIC_FIELDS,
+      NRB_TRAJECTORY};
+
+// Token table of version 1: vehicle types, colors, helm modes and
+// booleans. A table is part of its version's wire format and never
+// changes. Any change to the table needs a new NRB_VERSION.
+static const char *nrb_tokens_v1[] = {
+  "auv", "kayak", "uuv", "usv", "glider", "asv", "ship", "mokai",
+  "longship", "buoy", "heron", "swimmer", "cray", "bcray", "crayx",
+  "wamv", "bcrayx", "AUV", "KAYAK", "UUV", "USV", "GLIDER", "SHIP",
+  "red", "blue", "green", "yellow", "white", "black", "orange",
+  "purple", "gray", "dodger_blue", "MODE@ACTIVE", "PARK", "DRIVE",
+  "MANUAL", "MANUAL_OVERIDE", "DISABLED", "STANDBY", "clear",
+  "true", "false"};
+
+struct NRBTokenTable {
+  const char   **tokens;
+  unsigned int   count;
+};
+
+//---------------------------------------------------------
+// Procedure: nrbTokenTable()
+//   Purpose: Get the token table of the given wire format version.
+//            Returns false for a version this build does not know.
+
+static bool nrbTokenTable(unsigned int version, NRBTokenTable& table)
+{
+  if(version == 1) {
+    table.tokens = nrb_tokens_v1;
+    table.count  = sizeof(nrb_tokens_v1) / sizeof(nrb_tokens_v1[0]);
+    return(true);
+  }
+  return(false);
+}
+
+//---------------------------------------------------------
+// Procedure: nrbPutUInt(), nrbPutDouble(), nrbPutString()
+
+static void nrbPutUInt(string& buff, unsigned long long val,
+		       unsigned int bytes)
+{
+  for(unsigned int i=0; i<bytes; i++)
+    buff.push_back((char)((val >> (8*i)) & 0xFF));
+}
+
+static void nrbPutDouble(string& buff, double dval)
+{
+  uint64_t ival;
+  memcpy(&ival, &dval, sizeof(ival));
+  nrbPutUInt(buff, ival, 8);
+}
+
+static bool nrbPutString(string& buff, const string& str,
+			 const NRBTokenTable& table)
+{
+  unsigned int len = str.length();
+  if(len == 0) {
+    buff.push_back((char)0);
+    return(true);
+  }
+  for(unsigned int i=0; i<table.count; i++) {
+    if(str == table.tokens[i]) {
+      buff.push_back((char)(129 + i));
+      return(true);
+    }
+  }
+  if(len > 0xFFFF)
+    return(false);
+  if(len < 128)
+    buff.push_back((char)len);
+  else {
+    buff.push_back((char)128);
+    nrbPutUInt(buff, len, 2);
+  }
+  buff.append(str);
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: nrbGetUInt(), nrbGetDouble(), nrbGetString()
+//      Note: Each advances ix and returns false if the buffer is
+//            too short or the content is malformed.
+
+static bool nrbGetUInt(const string& buff, unsigned int& ix,
+		       unsigned long long& val, unsigned int bytes)
+{
+  if((ix + bytes) > buff.length())
+    return(false);
+  val = 0;
+  for(unsigned int i=0; i<bytes; i++) {
+    unsigned long long byte = (unsigned char)(buff[ix+i]);
+    val |= (byte << (8*i));
+  }
+  ix += bytes;
+  return(true);
+}
+
+static bool nrbGetDouble(const string& buff, unsigned int& ix,
+			 double& dval)
+{
+  unsigned long long val;
+  if(!nrbGetUInt(buff, ix, val, 8))
+    return(false);
+  uint64_t ival = val;
+  memcpy(&dval, &ival, sizeof(dval));
+  return(true);
+}
+
+static bool nrbGetString(const string& buff, unsigned int& ix,
+			 string& str, const NRBTokenTable& table)
+{
+  unsigned long long code;
+  if(!nrbGetUInt(buff, ix, code, 1))
+    return(false);
+
+  unsigned long long len = code;
+  if(code > 128) {
+    if((code - 129) >= table.count)
+      return(false);
+    str = table.tokens[code-129];
+    return(true);
+  }
+  if((code == 128) && !nrbGetUInt(buff, ix, len, 2))
+    return(false);
+  if((ix + len) > buff.length())
+    return(false);
+  str = buff.substr(ix, len);
+  ix += len;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: isBinaryNodeReport()
+
+bool isBinaryNodeReport(const string& str)
+{
+  if(str.length() < 4)
+    return(false);
+  return(((unsigned char)(str[0]) == 0xB1) &&
+	 (str[1] == 'N') && (str[2] == 'R'));
+}
+
+//---------------------------------------------------------
+// Procedure: nodeRecord2Binary()
+//   Purpose: Produce the compact binary form of the node record.
+//            If terse, depth, lat/lon and yaw are left out, as with
+//            NodeRecord::getSpec(true). Properties are included.
+//            Returns false, leaving the given buffer unchanged, if
+//            the record has a string longer than 0xFFFF bytes or
+//            more than 0xFFFF properties.
+
+bool nodeRecord2Binary(const NodeRecord& record, string& given_buff,
+		       bool terse)
+{
+  double vals[NRB_NUMERIC_FIELDS];
+  bool   sets[NRB_NUMERIC_FIELDS];
+
+  vals[NRB_X] = record.getX();          sets[NRB_X] = record.isSetX();
+  vals[NRB_Y] = record.getY();          sets[NRB_Y] = record.isSetY();
+  vals[NRB_LAT] = record.getLat();
+  sets[NRB_LAT] = record.isSetLatitude() && !terse;
+  vals[NRB_LON] = record.getLon();
+  sets[NRB_LON] = record.isSetLongitude() && !terse;
+  vals[NRB_SPEED] = record.getSpeed();  
+  sets[NRB_SPEED] = record.isSetSpeed();
+  vals[NRB_HEADING] = record.getHeading();
+  sets[NRB_HEADING] = record.isSetHeading();
+  vals[NRB_DEPTH] = record.getDepth();
+  sets[NRB_DEPTH] = record.isSetDepth() && !terse;
+  vals[NRB_LENGTH] = record.getLength();
+  sets[NRB_LENGTH] = record.isSetLength();
+  vals[NRB_TIME] = record.getTimeStamp();
+  sets[NRB_TIME] = record.isSetTimeStamp();
+  vals[NRB_YAW] = record.getYaw();
+  sets[NRB_YAW] = record.isSetYaw() && !terse;
+  vals[NRB_ALTITUDE] = record.getAltitude();
+  sets[NRB_ALTITUDE] = record.isSetAltitude();
+  vals[NRB_HDG_OG] = record.getHeadingOG();
+  sets[NRB_HDG_OG] = record.isSetHeadingOG();
+  vals[NRB_SPD_OG] = record.getSpeedOG();
+  sets[NRB_SPD_OG] = record.isSetSpeedOG();
+  vals[NRB_TRANSPARENCY] = record.getTransparency();
+  sets[NRB_TRANSPARENCY] = record.isSetTransparency();
+  vals[NRB_PITCH] = record.getPitch();
+  sets[NRB_PITCH] = record.isSetPitch();
+
+  unsigned long long mask = 0;
+  for(unsigned int i=0; i<NRB_NUMERIC_FIELDS; i++) {
+    if(sets[i])
+      mask |= (1ULL << i);
+  }
+  if(record.getThrustModeReverse())
+    mask |= (1ULL << NRB_THRUST_REVERSE);
+  if(record.isSetTrajectory())
+    mask |= (1ULL << NRB_TRAJECTORY);
+
+  string buff;
+  buff.reserve(128);
+  buff.push_back((char)0xB1);
+  buff.push_back('N');
+  buff.push_back('R');
+  buff.push_back((char)NRB_VERSION);
+  nrbPutUInt(buff, mask, 4);
+  nrbPutUInt(buff, (unsigned int)(record.getIndex()), 4);
+
+  for(unsigned int i=0; i<NRB_NUMERIC_FIELDS; i++) {
+    if(sets[i])
+      nrbPutDouble(buff, vals[i]);
+  }
+
+  NRBTokenTable table;
+  nrbTokenTable(NRB_VERSION, table);
+
+  bool ok = true;
+  ok = ok && nrbPutString(buff, record.getName(), table);
+  ok = ok && nrbPutString(buff, record.getType(), table);
+  ok = ok && nrbPutString(buff, record.getGroup(), table);
+  ok = ok && nrbPutString(buff, record.getColor(), table);
+  ok = ok && nrbPutString(buff, record.getMode(), table);
+  ok = ok && nrbPutString(buff, record.getModeAux(), table);
+  ok = ok && nrbPutString(buff, record.getAllStop(), table);
+  ok = ok && nrbPutString(buff, record.getLoadWarning(), table);
+  if(record.isSetTrajectory())
+    ok = ok && nrbPutString(buff, record.getTrajectory(), table);
+
+  const map<string, string>& props = record.getProperties();
+  if(props.size() > 0xFFFF)
+    return(false);
+  nrbPutUInt(buff, props.size(), 2);
+  map<string, string>::const_iterator p;
+  for(p=props.begin(); ok && (p!=props.end()); p++) {
+    ok = ok && nrbPutString(buff, p->first, table);
+    ok = ok && nrbPutString(buff, p->second, table);
+  }
+  if(!ok)
+    return(false);
+
+  given_buff = buff;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: binary2NodeRecord()
+//   Purpose: Decode a report made by nodeRecord2Binary(). Returns
+//            false, leaving the given record unchanged, if the
+//            buffer is not a well formed binary node report. Reports
+//            of a version with no known token table are rejected.
+
+bool binary2NodeRecord(const string& buff, NodeRecord& given_record)
+{
+  if(!isBinaryNodeReport(buff))
+    return(false);
+  NRBTokenTable table;
+  if(!nrbTokenTable((unsigned char)(buff[3]), table))
+    return(false);
+
+  unsigned int ix = 4;
+  unsigned long long mask, index;
+  if(!nrbGetUInt(buff, ix, mask, 4) || !nrbGetUInt(buff, ix, index, 4))
+    return(false);
+
+  NodeRecord record;
+  record.setIndex((int)(unsigned int)(index));
+
+  for(unsigned int i=0; i<NRB_NUMERIC_FIELDS; i++) {
+    if(!(mask & (1ULL << i)))
+      continue;
+    double dval;
+    if(!nrbGetDouble(buff, ix, dval))
+      return(false);
+    switch(i) {
+    case NRB_X:         record.setX(dval);  break;
+    case NRB_Y:         record.setY(dval);  break;
+    case NRB_LAT:       record.setLat(dval);  break;
+    case NRB_LON:       record.setLon(dval);  break;
+    case NRB_SPEED:     record.setSpeed(dval);  break;
+    case NRB_HEADING:   record.setHeading(dval);  break;
+    case NRB_DEPTH:     record.setDepth(dval);  break;
+    case NRB_LENGTH:    record.setLength(dval);  break;
+    case NRB_TIME:      record.setTimeStamp(dval);  break;
+    case NRB_YAW:       record.setYaw(dval);  break;
+    case NRB_ALTITUDE:  record.setAltitude(dval);  break;
+    case NRB_HDG_OG:    record.setHeadingOG(dval);  break;
+    case NRB_SPD_OG:    record.setSpeedOG(dval);  break;
+    case NRB_TRANSPARENCY: record.setTransparency(dval);  break;
+    case NRB_PITCH:     record.setPitch(dval);  break;
+    }
+  }
+  if(mask & (1ULL << NRB_THRUST_REVERSE))
+    record.setThrustModeReverse(true);
+
+  string name, type, group, color, mode, mode_aux, allstop, warning;
+  if(!nrbGetString(buff, ix, name, table)  ||
+     !nrbGetString(buff, ix, type, table)  ||
+     !nrbGetString(buff, ix, group, table) ||
+     !nrbGetString(buff, ix, color, table) ||
+     !nrbGetString(buff, ix, mode, table)  ||
+     !nrbGetString(buff, ix, mode_aux, table) ||
+     !nrbGetString(buff, ix, allstop, table)  ||
+     !nrbGetString(buff, ix, warning, table))
+    return(false);
+
+  record.setName(name);
+  record.setType(type);
+  record.setGroup(group);
+  record.setColor(color);
+  record.setMode(mode);
+  record.setModeAux(mode_aux);
+  record.setAllStop(allstop);
+  record.setLoadWarning(warning);
+
+  if(mask & (1ULL << NRB_TRAJECTORY)) {
+    string trajectory;
+    if(!nrbGetString(buff, ix, trajectory, table))
+      return(false);
+    record.setTrajectory(trajectory);
+  }
+
+  unsigned long long psize;
+  if(!nrbGetUInt(buff, ix, psize, 2))
+    return(false);
+  for(unsigned int i=0; i<psize; i++) {
+    string key, value;
+    if(!nrbGetString(buff, ix, key, table) ||
+       !nrbGetString(buff, ix, value, table))
+      return(false);
+    record.setProperty(key, value);
+  }
+
+  given_record = record;
+  return(true);
+}
+
 //---------------------------------------------------------
 // Procedure: string2NodeRecord()
 //   Example: NAME=alpha,TYPE=KAYAK,UTC_TIME=1267294386.51,
 //            X=29.66,Y=-23.49,LAT=43.825089, LON=-70.330030, 
 //            SPD=2.00, HDG=119.06,YAW=119.05677,DEPTH=0.00,     
 //            LENGTH=4.0,MODE=DRIVE,GROUP=A
+//      Note: Single pass over the report. Components are split on
+//            commas not enclosed in braces, as parseStringZ(str, ',',
+//            "{") would, but without building intermediate strings.
+//            Only string-valued fields allocate. Binary encoded
+//            reports are recognized and handed to binary2NodeRecord().
 
-NodeRecord string2NodeRecord(const string& node_rep_string, bool returnPartialResult)
+NodeRecord string2NodeRecord(const string& node_rep_string,
+			     bool returnPartialResult)
 {
-  NodeRecord empty_record;
   NodeRecord new_record;
+  if(isBinaryNodeReport(node_rep_string)) {
+    binary2NodeRecord(node_rep_string, new_record);
+    return(new_record);
+  }
 
-  vector<string> svector = parseStringZ(node_rep_string, ',', "{");
-  unsigned int i, vsize = svector.size();
-  for(i=0; i<vsize; i++) {
-    string param = toupper(biteStringX(svector[i], '='));
-    string value = svector[i];
-
-    if(param == "NAME")
-      new_record.setName(value);
-    else if(param == "TYPE")
-      new_record.setType(value);
-    else if(param == "MODE")
-      new_record.setMode(value);
-    else if(param == "ALLSTOP")
-      new_record.setAllStop(value);
-    else if(param == "INDEX")
-      new_record.setIndex(atof(value.c_str()));
-    else if(isNumber(value)) {
-      if((param == "TIME") || (param == "UTC_TIME"))
-	new_record.setTimeStamp(atof(value.c_str()));
-      else if(param == "X")
-	new_record.setX(atof(value.c_str()));
-      else if(param == "Y")
-	new_record.setY(atof(value.c_str()));
-      else if(param == "LAT")
-	new_record.setLat(atof(value.c_str()));
-      else if(param == "LON")
-	new_record.setLon(atof(value.c_str()));
-
-      else if((param == "SPD") || (param == "SPEED"))
-	new_record.setSpeed(atof(value.c_str()));
-      else if((param == "HDG") || (param == "HEADING"))
-	new_record.setHeading(atof(value.c_str()));
-
-      else if((param == "DEP") || (param == "DEPTH"))
-	new_record.setDepth(atof(value.c_str()));
-      else if((param == "LENGTH") || (param == "LEN"))
-	new_record.setLength(atof(value.c_str()));
-      else if(param == "YAW")
-	new_record.setYaw(atof(value.c_str()));
-      else if((param == "ALT") || (param == "ALTITUDE"))
-	new_record.setAltitude(atof(value.c_str()));
-      else if(param == "HDG_OG")
-	new_record.setHeadingOG(atof(value.c_str()));
-      else if(param == "SPD_OG")
-	new_record.setSpeedOG(atof(value.c_str()));
-      else if(param == "TRANSPARENCY")
-	new_record.setTransparency(atof(value.c_str()));
+  const char *str = node_rep_string.c_str();
+  unsigned int start = 0;
+  while(str[start] != '\0') {
+    unsigned int ix = start;
+    unsigned int brace_count = 0;
+    while((str[ix] != '\0') && ((str[ix] != ',') || (brace_count > 0))) {
+      if(str[ix] == '{')
+	brace_count++;
+      else if((str[ix] == '}') && (brace_count > 0))
+	brace_count--;
+      ix++;
     }
-    else if(param == "COLOR")
-      new_record.setColor(value);
-    else if(param == "GROUP")
-      new_record.setGroup(value);
-    else if(param == "LOAD_WARNING")
-      new_record.setLoadWarning(value);
-    else if((param == "THRUST_MODE_REVERSE") && (tolower(value) == "true")) 
-      new_record.setThrustModeReverse(true);
-    else if(param == "TRAJECTORY")
-      new_record.setTrajectory(stripBraces(value));
-
+    handleNodeReportField(new_record, str+start, ix-start);
+    start = ix;
+    if(str[start] == ',')
+      start++;
   }
-  
-  //  if(!new_record.valid()&&(!returnPartialResult))
-  //  return(empty_record);
 
   return(new_record);
 }
 
-
-
-
-
@@ -28,6 +28,11 @@
 
 NodeRecord string2NodeRecord(const std::string&, bool retPartialResult=false);
 
+// Compact binary encoding, posted as a MOOS_BINARY_STRING
+bool nodeRecord2Binary(const NodeRecord&, std::string&, bool terse=false);
+bool binary2NodeRecord(const std::string&, NodeRecord&);
+bool isBinaryNodeReport(const std::string&);
+
 NodeRecord extrapolateRecord(const NodeRecord&, double curr_time,
 			     double max_delta=3600);
 
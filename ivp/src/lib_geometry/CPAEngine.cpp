@@ -305,6 +305,157 @@ double CPAEngine::evalRangeRateOverRange(double osh, double osv, double time) co
   return(0);
 }
 
+//----------------------------------------------------------------
+// Procedure: evalCPAGrid
+//   Purpose: Evaluate the CPA distance for each heading and speed
+//            combination of the given grid, in one call. Results are
+//            identical to calling evalCPA() for each pair.
+
+void CPAEngine::evalCPAGrid(const vector<double>& hdgs,
+			    const vector<double>& spds, double ostol,
+			    vector<double>& cpa) const
+{
+  unsigned int spd_pts = spds.size();
+  cpa.resize(hdgs.size() * spd_pts);
+  if(cpa.size() == 0)
+    return;
+  
+  for(unsigned int i=0; i<hdgs.size(); i++)
+    evalGridHeading(hdgs[i], spds, ostol, &cpa[i*spd_pts], 0, 0, 0, i);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalCPAGrid
+//   Purpose: Evaluate the CPA distance, time to CPA, and whether
+//            ownship crosses the contact bow or stern, for each heading
+//            and speed combination of the given grid, in one call.
+//            Results are identical to calling evalCPA(), evalTimeCPA(),
+//            crossesBow() and crossesStern() for each pair.
+
+void CPAEngine::evalCPAGrid(const vector<double>& hdgs,
+			    const vector<double>& spds, double ostol,
+			    vector<double>& cpa, vector<double>& tcpa,
+			    vector<bool>& xbow, vector<bool>& xstern) const
+{
+  unsigned int spd_pts = spds.size();
+  unsigned int total   = hdgs.size() * spd_pts;
+  cpa.resize(total);
+  tcpa.resize(total);
+  xbow.assign(total, false);
+  xstern.assign(total, false);
+  if(total == 0)
+    return;
+  
+  for(unsigned int i=0; i<hdgs.size(); i++)
+    evalGridHeading(hdgs[i], spds, ostol, &cpa[i*spd_pts],
+		    &tcpa[i*spd_pts], &xbow, &xstern, i);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalGridHeading
+//   Purpose: Evaluate one heading row of a heading/speed grid. The
+//            per-heading cache lookups are done once, then the inner
+//            loop over speeds is straight arithmetic.
+//      Note: The tcpa, xbow and xstern args may be null if not wanted.
+//            The ix arg is the heading row index into xbow and xstern.
+
+void CPAEngine::evalGridHeading(double osh, const vector<double>& spds,
+				double ostol, double *cpa, double *tcpa,
+				vector<bool> *xbow, vector<bool> *xstern,
+				unsigned int ix) const
+{
+  if((osh >= 360) || (osh < 0))
+    osh = angle360(osh);
+  unsigned int hix = (unsigned int)(osh);
+
+  double vthresh = m_os_vthresh_cache_360[hix];
+  double k2_hdg  = m_k2_cache[hix];
+  double k1_hdg  = m_k1_cache[hix];
+  double k2_stat = m_stat_k2;
+  double k1_stat = m_stat_k1;
+  double k0_stat = m_stat_k0;
+  double range   = m_stat_range;
+  bool   closing = m_stat_cn_to_os_closing;
+  double cn_spd  = m_stat_cn_to_os_spd;
+
+  unsigned int spd_pts = spds.size();
+  for(unsigned int j=0; j<spd_pts; j++) {
+    double osv = spds[j];
+
+    // Part 1: Check for ownship already at CPA, as in evalCPA()
+    bool at_cpa = false;
+    bool at_tcpa = false;
+    if(closing) {
+      at_tcpa = (osv >= vthresh);
+      at_cpa  = at_tcpa && (osv > cn_spd);
+    }
+    else {
+      at_tcpa = (osv <= vthresh);
+      at_cpa  = at_tcpa;
+    }
+
+    double k2 = k2_stat + ((k2_hdg + osv) * osv);
+    double k1 = k1_stat + (k1_hdg * osv);
+    double minT = 0;
+    if(k2 != 0)
+      minT = k1 / (-2.0 * k2);
+    
+    // Part 2: CPA distance
+    double cpa_val = range;
+    if(!at_cpa && (k2 >= 0) && (minT > 0)) {
+      double cpa_t = minT;
+      if(cpa_t >= ostol)
+	cpa_t = ostol;
+      double dist_squared = cpa_t * ((k2 * cpa_t) + k1) + k0_stat;
+      cpa_val = 0;
+      if(dist_squared > 0)
+	cpa_val = sqrt(dist_squared);
+    }
+    cpa[j] = cpa_val;
+    
+    // Part 3: Time to CPA, as in evalTimeCPA()
+    if(tcpa) {
+      double tcpa_val = 0;
+      if(!at_tcpa && (k2 >= 0) && (minT > 0))
+	tcpa_val = minT;
+      tcpa[j] = tcpa_val;
+    }
+  }
+
+  if(!xbow || !xstern)
+    return;
+
+  // Part 4: Crossing flags, as in crossesBow() and crossesStern()
+  unsigned int base = ix * spd_pts;
+  if(m_stat_os_on_sternline) {
+    for(unsigned int j=0; j<spd_pts; j++) {
+      (*xbow)[base+j]   = true;
+      (*xstern)[base+j] = true;
+    }
+    return;
+  }
+
+  if(m_os_gam_cos_cache[hix] <= 0)
+    return;
+
+  double tn_cos = m_os_tn_cos_cache[hix];
+  for(unsigned int j=0; j<spd_pts; j++) {
+    double osv = spds[j];
+    if(osv <= 0)
+      continue;
+    double bng_rate = ((tn_cos * -osv) + m_stat_spd_cn_at_tangent);
+    bng_rate *= m_stat_tn_constant;
+    if(m_stat_os_port_of_cn) {
+      (*xbow)[base+j]   = (bng_rate >= 0);
+      (*xstern)[base+j] = (bng_rate <= 0);
+    }
+    else {
+      (*xbow)[base+j]   = (bng_rate <= 0);
+      (*xstern)[base+j] = (bng_rate >= 0);
+    }
+  }
+}
+
 //----------------------------------------------------------------
 // Procedure: minMaxROC
 //   Purpose: Determine max Rate-Of-Closure for a given number of  
@@ -49,6 +49,20 @@ public:
 
   double evalRangeRateOverRange(double osh, double osv, double time) const;
 
+  // ----------------------------------------------------------
+  // Batch evaluation over a grid of ownship headings and speeds.
+  // Results are heading-major: ix = (hdg_ix * spds.size()) + spd_ix
+  // ----------------------------------------------------------
+  void   evalCPAGrid(const std::vector<double>& hdgs,
+		     const std::vector<double>& spds, double ostol,
+		     std::vector<double>& cpa) const;
+  void   evalCPAGrid(const std::vector<double>& hdgs,
+		     const std::vector<double>& spds, double ostol,
+		     std::vector<double>& cpa,
+		     std::vector<double>& tcpa,
+		     std::vector<bool>& xbow,
+		     std::vector<bool>& xstern) const;
+
   // ----------------------------------------------------------
   // Checks for Crossing Stern and/or Bow
   // ----------------------------------------------------------
@@ -113,6 +127,11 @@ public:
   void   setStatic();
   double smallAngle(double, double) const;
 
+  void   evalGridHeading(double osh, const std::vector<double>& spds,
+			 double ostol, double *cpa, double *tcpa,
+			 std::vector<bool> *xbow, std::vector<bool> *xstern,
+			 unsigned int ix) const;
+
   void   initTrigCache();
   void   initRateCache();
   void   initK1Cache();
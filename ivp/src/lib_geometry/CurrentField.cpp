@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 #include "CurrentField.h"
 #include "GeomUtils.h"
 #include "AngleUtils.h"
@@ -44,6 +45,13 @@ CurrentField::CurrentField()
   m_active_ix  = 0;
   m_field_name = "generic_cfield";
   m_active_vertex = false;
+
+  m_index_valid = false;
+  m_index_x0    = 0;
+  m_index_y0    = 0;
+  m_index_cell  = 0;
+  m_index_nx    = 0;
+  m_index_ny    = 0;
 }
 
 //-------------------------------------------------------------------
@@ -74,6 +82,7 @@ bool CurrentField::populate(string filename)
   }
 
   applyRenderHints();
+  buildIndex();
 
   cout << "Done Populating Current Field." << endl;
   cout << "  OK Entries: " << lines_ok << endl;
@@ -90,11 +99,18 @@ void CurrentField::addVector(const XYVector& new_vector, bool marked)
 {
   m_vectors.push_back(new_vector);
   m_vmarked.push_back(marked);
+  m_index_valid = false;
 }
 
 //-------------------------------------------------------------------
 // Procedure: getLocalForce
-//   Purpose: 
+//   Purpose: Average of the vectors within the radius of the given
+//            point, each weighted by the square of its relative
+//            closeness. If the index is valid, only the vectors in
+//            the cells around the point are considered. The cells
+//            are merged on the fly so the vectors are visited in
+//            vector order, and the result is the same as a search
+//            over all vectors.
 
 void CurrentField::getLocalForce(double x, double y, 
 				 double& return_force_x, 
@@ -104,10 +120,35 @@ void CurrentField::getLocalForce(double x, double y,
   double total_force_y = 0;
   unsigned int count = 0;
 
-  unsigned int i, vsize = m_vectors.size();
-  for(i=0; i<vsize; i++) {
-    double xpos = m_vectors[i].xpos();
-    double ypos = m_vectors[i].ypos();
+  unsigned int next[CF_INDEX_MAX_CELLS];
+  unsigned int stop[CF_INDEX_MAX_CELLS];
+  unsigned int cells = 0;
+  bool use_index = m_index_valid;
+  if(use_index)
+    cells = getIndexCells(x, y, next, stop);
+
+  unsigned int i = 0, vsize = m_vectors.size();
+  while(true) {
+    unsigned int ix = i;
+    if(use_index) {
+      // Take the lowest vector id at the head of any cell
+      unsigned int best = cells;
+      for(unsigned int c=0; c<cells; c++) {
+	if((next[c] < stop[c]) && ((best == cells) ||
+	   (m_index_ids[next[c]] < m_index_ids[next[best]])))
+	  best = c;
+      }
+      if(best == cells)
+	break;
+      ix = m_index_ids[next[best]];
+      next[best]++;
+    }
+    else if(i >= vsize)
+      break;
+    i++;
+
+    double xpos = m_vectors[ix].xpos();
+    double ypos = m_vectors[ix].ypos();
     double dist = distPointToPoint(x, y, xpos, ypos);
     if(dist < m_radius) {
       count++;
@@ -119,8 +160,8 @@ void CurrentField::getLocalForce(double x, double y,
       double pct = (1 - (dist / m_radius));
       pct = pct * pct;
       
-      double xdot = pct * m_vectors[i].xdot();
-      double ydot = pct * m_vectors[i].ydot();
+      double xdot = pct * m_vectors[ix].xdot();
+      double ydot = pct * m_vectors[ix].ydot();
 
       total_force_x += xdot;
       total_force_y += ydot;
@@ -136,6 +177,108 @@ void CurrentField::getLocalForce(double x, double y,
   return_force_y = total_force_y / (double)(count); 
 }
 
+//-------------------------------------------------------------------
+// Procedure: buildIndex
+//   Purpose: Bucket the vectors on square cells the size of the
+//            radius, so a lookup need only visit the cells within
+//            one radius of the query point.
+
+void CurrentField::buildIndex()
+{
+  m_index_valid = false;
+  m_index_start.clear();
+  m_index_ids.clear();
+
+  unsigned int i, vsize = m_vectors.size();
+  if((vsize == 0) || (m_radius <= 0))
+    return;
+
+  double xmin = m_vectors[0].xpos();
+  double xmax = xmin;
+  double ymin = m_vectors[0].ypos();
+  double ymax = ymin;
+  for(i=1; i<vsize; i++) {
+    xmin = min(xmin, m_vectors[i].xpos());
+    xmax = max(xmax, m_vectors[i].xpos());
+    ymin = min(ymin, m_vectors[i].ypos());
+    ymax = max(ymax, m_vectors[i].ypos());
+  }
+
+  // Guard against a tiny radius over a huge extent
+  double cell = m_radius;
+  double max_cells = 4.0 * vsize + 1024;
+  while((((xmax-xmin)/cell)+1) * (((ymax-ymin)/cell)+1) > max_cells)
+    cell *= 2;
+
+  m_index_x0   = xmin;
+  m_index_y0   = ymin;
+  m_index_cell = cell;
+  m_index_nx   = (unsigned int)((xmax-xmin)/cell) + 1;
+  m_index_ny   = (unsigned int)((ymax-ymin)/cell) + 1;
+
+  unsigned int cells = m_index_nx * m_index_ny;
+  vector<unsigned int> cell_of(vsize);
+  m_index_start.assign(cells+1, 0);
+  for(i=0; i<vsize; i++) {
+    unsigned int cx = (unsigned int)((m_vectors[i].xpos()-xmin)/cell);
+    unsigned int cy = (unsigned int)((m_vectors[i].ypos()-ymin)/cell);
+    cx = min(cx, m_index_nx-1);
+    cy = min(cy, m_index_ny-1);
+    cell_of[i] = cx + (cy * m_index_nx);
+    m_index_start[cell_of[i]+1]++;
+  }
+  for(i=0; i<cells; i++)
+    m_index_start[i+1] += m_index_start[i];
+
+  vector<unsigned int> fill(m_index_start.begin(), m_index_start.end()-1);
+  m_index_ids.resize(vsize);
+  for(i=0; i<vsize; i++)
+    m_index_ids[fill[cell_of[i]]++] = i;
+
+  m_index_valid = true;
+}
+
+//-------------------------------------------------------------------
+// Procedure: getIndexCells
+//   Purpose: Ranges into m_index_ids of the non-empty cells within
+//            one radius of the given point. Cells are no smaller
+//            than the radius so there are at most 3x3 of them, plus
+//            a margin for rounding. Returns the number of ranges.
+
+unsigned int CurrentField::getIndexCells(double x, double y,
+					 unsigned int *start,
+					 unsigned int *stop) const
+{
+  double cxlow  = floor((x - m_radius - m_index_x0) / m_index_cell);
+  double cxhigh = floor((x + m_radius - m_index_x0) / m_index_cell);
+  double cylow  = floor((y - m_radius - m_index_y0) / m_index_cell);
+  double cyhigh = floor((y + m_radius - m_index_y0) / m_index_cell);
+
+  if((cxhigh < 0) || (cyhigh < 0) ||
+     (cxlow >= m_index_nx) || (cylow >= m_index_ny))
+    return(0);
+
+  unsigned int cx0 = (unsigned int)(max(cxlow, 0.0));
+  unsigned int cy0 = (unsigned int)(max(cylow, 0.0));
+  unsigned int cx1 = (unsigned int)(min(cxhigh, (double)(m_index_nx-1)));
+  unsigned int cy1 = (unsigned int)(min(cyhigh, (double)(m_index_ny-1)));
+  cx1 = min(cx1, cx0 + CF_INDEX_MAX_SPAN - 1);
+  cy1 = min(cy1, cy0 + CF_INDEX_MAX_SPAN - 1);
+
+  unsigned int cells = 0;
+  for(unsigned int cy=cy0; cy<=cy1; cy++) {
+    for(unsigned int cx=cx0; cx<=cx1; cx++) {
+      unsigned int c = cx + (cy * m_index_nx);
+      if(m_index_start[c+1] > m_index_start[c]) {
+	start[cells] = m_index_start[c];
+	stop[cells]  = m_index_start[c+1];
+	cells++;
+      }
+    }
+  }
+  return(cells);
+}
+
 //-------------------------------------------------------------------
 // Procedure: setRadius
 //   Purpose: 
@@ -145,6 +288,7 @@ void CurrentField::setRadius(double radius)
   if(radius < 1)
     radius = 1;
   m_radius = radius;
+  m_index_valid = false;
 }
 
 //-------------------------------------------------------------------
@@ -262,6 +406,7 @@ bool CurrentField::deleteVector(unsigned int ix)
 
   m_vectors = new_vectors;
   m_vmarked = new_vmarked;
+  m_index_valid = false;
   return(true);
 }
 
@@ -298,6 +443,7 @@ void CurrentField::deleteMarkedVectors()
 
   m_vectors = new_vectors;
   m_vmarked = new_vmarked;
+  m_index_valid = false;
 }
 
 //-------------------------------------------------------------------
@@ -314,6 +460,7 @@ void CurrentField::modVector(unsigned int ix, string param, double value)
     m_vectors[ix].shift_horz(value);
   else if(param == "aug_y")
     m_vectors[ix].shift_vert(value);
+  m_index_valid = false;
 }
 
 //-------------------------------------------------------------------
@@ -374,6 +521,7 @@ void CurrentField::applySnap(double snapval)
   unsigned int i, vsize = m_vectors.size();
   for(i=0; i<vsize; i++)
     m_vectors[i].applySnap(snapval);
+  m_index_valid = false;
 }
 
 //-------------------------------------------------------------------
@@ -565,9 +713,7 @@ bool CurrentField::handleLine(string line)
   }
     
   XYVector new_vector = string2Vector(line);
-  if(new_vector.valid())
-    addVector(new_vector);
-  else
+  if(!new_vector.valid())
     return(false);
 
 #if 0
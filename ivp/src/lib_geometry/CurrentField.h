@@ -31,6 +31,12 @@
 #include "XYVector.h"
 #include "MOOS/libMOOSGeodesy/MOOSGeodesy.h"
 
+// Most index cells within one radius of a point, per axis and in
+// all. Cells are no smaller than the radius, so 3 per axis suffice
+// and one more covers rounding.
+#define CF_INDEX_MAX_SPAN   4
+#define CF_INDEX_MAX_CELLS 16
+
 class CurrentField
 {
 public:
@@ -41,6 +47,8 @@ public:
   void addVector(const XYVector&, bool marked=false);
   void getLocalForce(double x, double y, double& fx, double& fy) const;
   void setRadius(double radius);
+  void buildIndex();
+  bool indexed() const {return(m_index_valid);}
   bool initGeodesy(double datum_lat, double datum_lon);
   void print();
 
@@ -83,6 +91,8 @@ public:
   bool   handleLine(std::string);
   void   applyRenderHints();
   void   applyRenderHint(std::string, std::string);
+  unsigned int getIndexCells(double x, double y, unsigned int *start,
+			     unsigned int *stop) const;
 
 protected:
   std::vector<XYVector> m_vectors;
@@ -95,6 +105,19 @@ protected:
 
   std::vector<std::string> m_render_hints;
 
+  // Bucket index of the vectors, on square cells the size of the
+  // radius. Cell c holds m_index_ids[m_index_start[c]] up to but
+  // not including m_index_ids[m_index_start[c+1]], in vector order.
+  // Any change to the vectors or the radius invalidates the index.
+  bool   m_index_valid;
+  double m_index_x0;
+  double m_index_y0;
+  double m_index_cell;
+  unsigned int m_index_nx;
+  unsigned int m_index_ny;
+  std::vector<unsigned int> m_index_start;
+  std::vector<unsigned int> m_index_ids;
+
 };
 
 #endif 
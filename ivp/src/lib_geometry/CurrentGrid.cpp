@@ -0,0 +1,454 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CurrentGrid.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "CurrentGrid.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//------------------------------------------------------------------
+// Binary file layout, in native byte order:
+//
+//   0  char[4]   "CGRD"
+//   4  uint32    version (1)
+//   8  uint32    nx
+//  12  uint32    ny
+//  16  uint32    frame count
+//  20  uint32    reserved (0)
+//  24  double    x0, y0, dx, dy
+//  56  double    frame times, one per frame
+//      float     node data, per frame u[nx*ny] then v[nx*ny]
+
+static const char         CGRID_MAGIC[4]  = {'C','G','R','D'};
+static const unsigned int CGRID_VERSION   = 1;
+static const unsigned int CGRID_HDR_BYTES = 56;
+
+//------------------------------------------------------------------
+// CurrentGridFile is a read-only view of a whole file, mapped into
+// memory where supported and read into a buffer otherwise.
+
+class CurrentGridFile
+{
+public:
+  CurrentGridFile() {m_addr=0; m_size=0;}
+  ~CurrentGridFile();
+
+  bool open(string filename);
+
+  const char* data() const  {return(m_addr);}
+  size_t      size() const  {return(m_size);}
+
+protected:
+  const char* m_addr;
+  size_t      m_size;
+#ifdef _WIN32
+  vector<char> m_buffer;
+#endif
+};
+
+//------------------------------------------------------------------
+// Procedure: open()
+
+bool CurrentGridFile::open(string filename)
+{
+#ifdef _WIN32
+  ifstream ifs(filename.c_str(), ios::binary);
+  if(!ifs)
+    return(false);
+  ifs.seekg(0, ios::end);
+  m_buffer.resize((size_t)(ifs.tellg()));
+  ifs.seekg(0, ios::beg);
+  if(m_buffer.size() > 0)
+    ifs.read(&m_buffer[0], m_buffer.size());
+  if(!ifs || (m_buffer.size() == 0))
+    return(false);
+  m_addr = &m_buffer[0];
+  m_size = m_buffer.size();
+  return(true);
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return(false);
+
+  struct stat info;
+  if((fstat(fd, &info) != 0) || (info.st_size <= 0)) {
+    close(fd);
+    return(false);
+  }
+  size_t size = (size_t)(info.st_size);
+  void *addr = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(addr == MAP_FAILED)
+    return(false);
+
+  m_addr = (const char*)(addr);
+  m_size = size;
+  return(true);
+#endif
+}
+
+//------------------------------------------------------------------
+// Destructor
+
+CurrentGridFile::~CurrentGridFile()
+{
+#ifndef _WIN32
+  if(m_addr)
+    munmap((void*)(m_addr), m_size);
+#endif
+}
+
+//------------------------------------------------------------------
+// Constructor
+
+CurrentGrid::CurrentGrid()
+{
+  m_data = 0;
+  clear();
+}
+
+//------------------------------------------------------------------
+// Procedure: clear()
+
+void CurrentGrid::clear()
+{
+  m_x0 = 0;
+  m_y0 = 0;
+  m_dx = 0;
+  m_dy = 0;
+  m_nx = 0;
+  m_ny = 0;
+
+  m_times.clear();
+  m_owned.reset();
+  m_file.reset();
+  m_data = 0;
+}
+
+//------------------------------------------------------------------
+// Procedure: initialize()
+//   Purpose: Set the grid geometry, with node (ix,iy) at position
+//            (x0 + ix*dx, y0 + iy*dy). Any prior frames are dropped.
+
+bool CurrentGrid::initialize(double x0, double y0, double dx, double dy,
+			     unsigned int nx, unsigned int ny)
+{
+  if((dx <= 0) || (dy <= 0) || (nx < 2) || (ny < 2))
+    return(false);
+
+  clear();
+  m_x0 = x0;
+  m_y0 = y0;
+  m_dx = dx;
+  m_dy = dy;
+  m_nx = nx;
+  m_ny = ny;
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: addFrame()
+//   Purpose: Append a frame of node values. Frame times must be
+//            strictly increasing.
+
+bool CurrentGrid::addFrame(double time, const vector<float>& u,
+			   const vector<float>& v)
+{
+  unsigned int nodes = m_nx * m_ny;
+  if((nodes == 0) || (u.size() != nodes) || (v.size() != nodes))
+    return(false);
+  if((m_times.size() > 0) && (time <= m_times.back()))
+    return(false);
+
+  writableData();
+  m_owned->insert(m_owned->end(), u.begin(), u.end());
+  m_owned->insert(m_owned->end(), v.begin(), v.end());
+  m_data = &((*m_owned)[0]);
+  m_times.push_back(time);
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: writableData()
+//   Purpose: Ensure the node data is owned by this grid alone, and
+//            copy it out of a mapped file or shared buffer if not.
+
+float* CurrentGrid::writableData()
+{
+  if(m_owned && !m_file && (m_owned.use_count() == 1))
+    return(m_owned->empty() ? 0 : &((*m_owned)[0]));
+
+  size_t count = m_times.size() * 2 * (size_t)(m_nx * m_ny);
+  shared_ptr<vector<float> > owned(new vector<float>());
+  if(m_data && (count > 0))
+    owned->assign(m_data, m_data + count);
+
+  m_owned = owned;
+  m_file.reset();
+  m_data = m_owned->empty() ? 0 : &((*m_owned)[0]);
+  return((float*)(m_data));
+}
+
+//------------------------------------------------------------------
+// Procedure: readBinary()
+
+bool CurrentGrid::readBinary(string filename)
+{
+  shared_ptr<CurrentGridFile> file(new CurrentGridFile());
+  if(!file->open(filename))
+    return(false);
+
+  const char* buff = file->data();
+  size_t size = file->size();
+  if((size < CGRID_HDR_BYTES) || (memcmp(buff, CGRID_MAGIC, 4) != 0))
+    return(false);
+
+  unsigned int hdr[4];
+  memcpy(hdr, buff+4, sizeof(hdr));
+  if(hdr[0] != CGRID_VERSION)
+    return(false);
+
+  double geo[4];
+  memcpy(geo, buff+24, sizeof(geo));
+
+  unsigned int nx = hdr[1];
+  unsigned int ny = hdr[2];
+  unsigned int nt = hdr[3];
+  size_t data_offset = CGRID_HDR_BYTES + (nt * sizeof(double));
+  size_t data_bytes  = (size_t)(nt) * 2 * nx * ny * sizeof(float);
+  if((nt == 0) || (size != data_offset + data_bytes))
+    return(false);
+
+  if(!initialize(geo[0], geo[1], geo[2], geo[3], nx, ny))
+    return(false);
+
+  m_times.resize(nt);
+  memcpy(&m_times[0], buff + CGRID_HDR_BYTES, nt * sizeof(double));
+  for(unsigned int i=1; i<nt; i++) {
+    if(m_times[i] <= m_times[i-1]) {
+      clear();
+      return(false);
+    }
+  }
+
+  m_file = file;
+  m_data = (const float*)(buff + data_offset);
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: writeBinary()
+
+bool CurrentGrid::writeBinary(string filename) const
+{
+  if((m_times.size() == 0) || !m_data)
+    return(false);
+
+  FILE *f = fopen(filename.c_str(), "wb");
+  if(!f)
+    return(false);
+
+  char hdr[CGRID_HDR_BYTES];
+  unsigned int vals[5] = {CGRID_VERSION, m_nx, m_ny,
+			  (unsigned int)(m_times.size()), 0};
+  double geo[4] = {m_x0, m_y0, m_dx, m_dy};
+  memcpy(hdr, CGRID_MAGIC, 4);
+  memcpy(hdr+4, vals, sizeof(vals));
+  memcpy(hdr+24, geo, sizeof(geo));
+
+  size_t count = m_times.size() * 2 * (size_t)(m_nx * m_ny);
+  bool ok = (fwrite(hdr, 1, CGRID_HDR_BYTES, f) == CGRID_HDR_BYTES);
+  ok = ok && (fwrite(&m_times[0], sizeof(double), m_times.size(), f) == m_times.size());
+  ok = ok && (fwrite(m_data, sizeof(float), count, f) == count);
+  ok = (fclose(f) == 0) && ok;
+  return(ok);
+}
+
+//------------------------------------------------------------------
+// Procedure: contains()
+
+bool CurrentGrid::contains(double x, double y) const
+{
+  if(m_nx == 0)
+    return(false);
+  double gx = (x - m_x0) / m_dx;
+  double gy = (y - m_y0) / m_dy;
+  return((gx >= 0) && (gy >= 0) && (gx <= m_nx-1) && (gy <= m_ny-1));
+}
+
+//------------------------------------------------------------------
+// Procedure: getFrameTime()
+
+double CurrentGrid::getFrameTime(unsigned int ix) const
+{
+  if(ix >= m_times.size())
+    return(0);
+  return(m_times[ix]);
+}
+
+//------------------------------------------------------------------
+// Procedure: getLocalForce()
+//   Purpose: Current at the given point, from the first frame
+
+void CurrentGrid::getLocalForce(double x, double y,
+				double& fx, double& fy) const
+{
+  fx = 0;
+  fy = 0;
+  if(m_times.size() > 0)
+    sampleFrame(0, x, y, fx, fy);
+}
+
+//------------------------------------------------------------------
+// Procedure: getLocalForce()
+//   Purpose: Current at the given point and time, blended linearly
+//            between the two frames bracketing the time.
+
+void CurrentGrid::getLocalForce(double x, double y, double time,
+				double& fx, double& fy) const
+{
+  fx = 0;
+  fy = 0;
+  unsigned int nt = m_times.size();
+  if(nt == 0)
+    return;
+  if((nt == 1) || (time <= m_times[0])) {
+    sampleFrame(0, x, y, fx, fy);
+    return;
+  }
+  if(time >= m_times[nt-1]) {
+    sampleFrame(nt-1, x, y, fx, fy);
+    return;
+  }
+
+  vector<double>::const_iterator p;
+  p = upper_bound(m_times.begin(), m_times.end(), time);
+  unsigned int k = (unsigned int)(p - m_times.begin()) - 1;
+
+  double fx0, fy0, fx1, fy1;
+  sampleFrame(k, x, y, fx0, fy0);
+  sampleFrame(k+1, x, y, fx1, fy1);
+
+  double pct = (time - m_times[k]) / (m_times[k+1] - m_times[k]);
+  fx = fx0 + (pct * (fx1 - fx0));
+  fy = fy0 + (pct * (fy1 - fy0));
+}
+
+//------------------------------------------------------------------
+// Procedure: sampleFrame()
+//   Purpose: Bilinear interpolation within one frame. Nodes with a
+//            NaN component are left out and the rest re-weighted.
+
+void CurrentGrid::sampleFrame(unsigned int frame, double x, double y,
+			      double& fx, double& fy) const
+{
+  fx = 0;
+  fy = 0;
+
+  double gx = (x - m_x0) / m_dx;
+  double gy = (y - m_y0) / m_dy;
+  if(!(gx >= 0) || !(gy >= 0) || (gx > m_nx-1) || (gy > m_ny-1))
+    return;
+
+  unsigned int ix = (unsigned int)(gx);
+  unsigned int iy = (unsigned int)(gy);
+  if(ix >= m_nx-1)
+    ix = m_nx-2;
+  if(iy >= m_ny-1)
+    iy = m_ny-2;
+  double tx = gx - ix;
+  double ty = gy - iy;
+
+  size_t nodes = (size_t)(m_nx) * m_ny;
+  const float* u = m_data + ((size_t)(frame) * 2 * nodes);
+  const float* v = u + nodes;
+
+  size_t corner[4];
+  corner[0] = ix + ((size_t)(iy) * m_nx);
+  corner[1] = corner[0] + 1;
+  corner[2] = corner[0] + m_nx;
+  corner[3] = corner[2] + 1;
+
+  double weight[4];
+  weight[0] = (1-tx) * (1-ty);
+  weight[1] = tx * (1-ty);
+  weight[2] = (1-tx) * ty;
+  weight[3] = tx * ty;
+
+  double sum_u = 0;
+  double sum_v = 0;
+  double sum_w = 0;
+  bool   missing = false;
+  for(unsigned int i=0; i<4; i++) {
+    float uval = u[corner[i]];
+    float vval = v[corner[i]];
+    if(std::isnan(uval) || std::isnan(vval)) {
+      missing = true;
+      continue;
+    }
+    sum_u += weight[i] * uval;
+    sum_v += weight[i] * vval;
+    sum_w += weight[i];
+  }
+  if(sum_w <= 0)
+    return;
+
+  if(missing) {
+    sum_u /= sum_w;
+    sum_v /= sum_w;
+  }
+  fx = sum_u;
+  fy = sum_v;
+}
+
+//------------------------------------------------------------------
+// Procedure: getSummary()
+
+string CurrentGrid::getSummary() const
+{
+  string str = "nx=" + uintToString(m_nx);
+  str += ",ny=" + uintToString(m_ny);
+  str += ",frames=" + uintToString(m_times.size());
+  str += ",x0=" + doubleToStringX(m_x0, 3);
+  str += ",y0=" + doubleToStringX(m_y0, 3);
+  str += ",dx=" + doubleToStringX(m_dx, 3);
+  str += ",dy=" + doubleToStringX(m_dy, 3);
+  if(m_times.size() > 0) {
+    str += ",t0=" + doubleToStringX(m_times.front(), 3);
+    str += ",t1=" + doubleToStringX(m_times.back(), 3);
+  }
+  str += ",mapped=" + boolToString(isMapped());
+  return(str);
+}
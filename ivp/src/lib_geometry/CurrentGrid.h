@@ -0,0 +1,107 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: CurrentGrid.h                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef CURRENT_GRID_HEADER
+#define CURRENT_GRID_HEADER
+
+#include <string>
+#include <vector>
+#include <memory>
+
+class CurrentGridFile;
+
+//------------------------------------------------------------------
+// CurrentGrid is a current field sampled on a regular grid, with one
+// or more time frames. The current at a point is interpolated
+// bilinearly from the four surrounding nodes, and linearly between
+// the two frames bracketing the query time. A node with a NaN
+// component is treated as missing (e.g. land), and the remaining
+// nodes of the cell are re-weighted. Outside the grid the current
+// is zero. Queries outside the frame times use the first or last
+// frame.
+//
+// Nodes are stored per frame as float arrays, all u (x-component)
+// values in row-major order (ix + iy*nx), followed by all v values.
+// A grid may be saved to, and read back from, a binary file. A grid
+// read from file is memory-mapped where the platform allows, so
+// large model outputs load without parsing or copying. Copies of a
+// grid share the node data.
+
+class CurrentGrid
+{
+public:
+  CurrentGrid();
+  ~CurrentGrid() {}
+
+  bool   initialize(double x0, double y0, double dx, double dy,
+		    unsigned int nx, unsigned int ny);
+  bool   addFrame(double time, const std::vector<float>& u,
+		  const std::vector<float>& v);
+  void   clear();
+
+  bool   readBinary(std::string filename);
+  bool   writeBinary(std::string filename) const;
+
+  void   getLocalForce(double x, double y, double& fx, double& fy) const;
+  void   getLocalForce(double x, double y, double time,
+		       double& fx, double& fy) const;
+
+  bool   contains(double x, double y) const;
+
+  unsigned int size() const    {return(m_nx * m_ny);}
+  unsigned int getNX() const   {return(m_nx);}
+  unsigned int getNY() const   {return(m_ny);}
+  unsigned int frames() const  {return(m_times.size());}
+
+  double getX0() const         {return(m_x0);}
+  double getY0() const         {return(m_y0);}
+  double getDX() const         {return(m_dx);}
+  double getDY() const         {return(m_dy);}
+  double getFrameTime(unsigned int) const;
+  bool   isMapped() const      {return(m_file.get() != 0);}
+
+  std::string getSummary() const;
+
+ protected:
+  void   sampleFrame(unsigned int frame, double x, double y,
+		     double& fx, double& fy) const;
+  float* writableData();
+
+ protected:
+  double       m_x0;
+  double       m_y0;
+  double       m_dx;
+  double       m_dy;
+  unsigned int m_nx;
+  unsigned int m_ny;
+
+  std::vector<double> m_times;
+
+  // Node data is either owned or mapped from file, and in either
+  // case shared by copies of this grid.
+  std::shared_ptr<std::vector<float> > m_owned;
+  std::shared_ptr<CurrentGridFile>     m_file;
+  const float* m_data;
+};
+
+#endif 
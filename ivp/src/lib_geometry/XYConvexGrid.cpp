@@ -28,6 +28,7 @@
 #include <cstdlib>
 #include "XYConvexGrid.h"
 #include "XYGridUpdate.h"
+#include "XYFormatUtilsConvexGrid.h"
 #include "MBUtils.h"
 #include "XYFormatUtilsPoly.h"
 
@@ -40,6 +41,11 @@ XYConvexGrid::XYConvexGrid()
 {
   m_pix_per_mtr_x = -1;
   m_pix_per_mtr_y = -1;
+
+  m_lattice_cols = 0;
+  m_lattice_rows = 0;
+  m_lattice_xlen = 0;
+  m_lattice_ylen = 0;
 }
 
 
@@ -87,7 +93,7 @@ bool XYConvexGrid::initialize(const XYPolygon& poly,
   XYSquare unit_square(cell_size);
 
   // Part One: get bounding box for the polygon and create 
-  //           elements based on that square
+  //           the cell lattice based on that square
   double xlow  = poly.get_vx(0);
   double xhigh = poly.get_vx(0);
   double ylow  = poly.get_vy(0);
@@ -104,40 +110,83 @@ bool XYConvexGrid::initialize(const XYPolygon& poly,
   
   XYSquare outer_square(xlow, xhigh, ylow, yhigh);
 
-  vector<XYSquare> int_elements;
-
   bool ok = initialize(outer_square, unit_square);
   if(!ok)
     return(false);
 
-  unsigned int esize = m_elements.size();
-
-  for(i=0; i<esize; i++) {
-    xlow  = m_elements[i].getVal(0,0);
-    xhigh = m_elements[i].getVal(0,1);
-    ylow  = m_elements[i].getVal(1,0);
-    yhigh = m_elements[i].getVal(1,1);
-    XYPolygon spoly;
-    spoly.add_vertex(xlow,  ylow);
-    spoly.add_vertex(xhigh, ylow);
-    spoly.add_vertex(xhigh, yhigh);
-    spoly.add_vertex(xlow,  yhigh);
-    if(spoly.intersects(poly))
-      int_elements.push_back(m_elements[i]);
+  // Part Two: For each column of the lattice, find the y extent of
+  //           the polygon within the column. Cells of the column
+  //           overlapping this extent intersect the (convex) polygon.
+  //           This is linear in the number of cells rather than a
+  //           polygon intersection test per cell.
+  double unit_x_len = unit_square.getLengthX();
+  double unit_y_len = unit_square.getLengthY();
+  for(unsigned int col=0; col<m_lattice_cols; col++) {
+    double col_xlow  = (col * unit_x_len) + xlow;
+    double col_xhigh = col_xlow + unit_x_len;
+
+    bool   col_hit  = false;
+    double col_ylow = 0;
+    double col_yhigh = 0;
+    for(i=0; i<psize; i++) {
+      unsigned int j = (i+1) % psize;
+      double ax = poly.get_vx(i);
+      double ay = poly.get_vy(i);
+      double bx = poly.get_vx(j);
+      double by = poly.get_vy(j);
+      if((ax < col_xlow) && (bx < col_xlow))
+	continue;
+      if((ax > col_xhigh) && (bx > col_xhigh))
+	continue;
+
+      // Clip the polygon edge to the column
+      double y1 = ay;
+      double y2 = by;
+      if(ax != bx) {
+	double t1 = (col_xlow  - ax) / (bx - ax);
+	double t2 = (col_xhigh - ax) / (bx - ax);
+	if(t1 > t2) {
+	  double tmp = t1;  t1 = t2;  t2 = tmp;
+	}
+	if(t1 < 0)  t1 = 0;
+	if(t2 > 1)  t2 = 1;
+	y1 = ay + (t1 * (by - ay));
+	y2 = ay + (t2 * (by - ay));
+      }
+      if(!col_hit || (y1 < col_ylow))   col_ylow  = y1;
+      if(!col_hit || (y1 > col_yhigh))  col_yhigh = y1;
+      if(y2 < col_ylow)   col_ylow  = y2;
+      if(y2 > col_yhigh)  col_yhigh = y2;
+      col_hit = true;
+    }
+    if(!col_hit)
+      continue;
+
+    for(unsigned int row=0; row<m_lattice_rows; row++) {
+      double row_ylow  = (row * unit_y_len) + ylow;
+      double row_yhigh = row_ylow + unit_y_len;
+      if((row_yhigh < col_ylow) || (row_ylow > col_yhigh))
+	continue;
+
+      unsigned int lattice_ix = (col * m_lattice_rows) + row;
+      m_lattice_ix[lattice_ix] = (int)(m_cell_lattice.size());
+      m_cell_lattice.push_back(lattice_ix);
+    }
   }
 
-  m_elements  = int_elements;
-
   // Store some config information for serializing the grid (get_spec)
   m_config_poly      = poly;
   m_config_cell_size = cell_size;
   
-  for(i=0; i<esize; i++)
-    m_cell_vals.push_back(cell_init_vals);
-
   m_cell_vars      = cell_vars;
   m_cell_init_vals = cell_init_vals;
 
+  unsigned int esize = m_cell_lattice.size();
+  m_cell_vals.reserve(esize * cell_init_vals.size());
+  for(i=0; i<esize; i++)
+    m_cell_vals.insert(m_cell_vals.end(), cell_init_vals.begin(),
+		       cell_init_vals.end());
+
   // Now that we know how many cell_vars, initialize the vectors
   // containing one entry per cell_var.
   unsigned int cix, csize = m_cell_vars.size();
@@ -163,9 +212,12 @@ bool XYConvexGrid::initialize(const XYPolygon& poly,
 
 bool XYConvexGrid::ptIntersect(unsigned int ix, double x, double y) const
 {
-  if(ix >= m_elements.size())
+  if(ix >= m_cell_lattice.size())
     return(false);
-  return(m_elements[ix].containsPoint(x, y));
+
+  double xlow, xhigh, ylow, yhigh;
+  getCellBounds(ix, xlow, xhigh, ylow, yhigh);
+  return((x >= xlow) && (x <= xhigh) && (y >= ylow) && (y <= yhigh));
 }
 
 //-------------------------------------------------------------
@@ -177,9 +229,9 @@ double XYConvexGrid::segIntersect(unsigned int ix,
 				  double x1, double y1,
 				  double x2, double y2)
 {
-  if(ix >= m_elements.size())
+  if(ix >= m_cell_lattice.size())
     return(0);
-  return(m_elements[ix].segIntersectLength(x1,y1,x2,y2));
+  return(getElement(ix).segIntersectLength(x1,y1,x2,y2));
 }
 
 //-------------------------------------------------------------
@@ -189,10 +241,12 @@ XYSquare XYConvexGrid::getElement(unsigned int ix) const
 {
   XYSquare retElement;
 
-  if(ix < m_elements.size())
-    return(m_elements[ix]);
-  else
-    return(retElement);
+  if(ix < m_cell_lattice.size()) {
+    double xlow, xhigh, ylow, yhigh;
+    getCellBounds(ix, xlow, xhigh, ylow, yhigh);
+    retElement.set(xlow, xhigh, ylow, yhigh);
+  }
+  return(retElement);
 }
 
 //-------------------------------------------------------------
@@ -239,7 +293,7 @@ unsigned int XYConvexGrid::getCellVarIX(const string& cell_var) const
 void XYConvexGrid::setVal(unsigned int ix, double val, 
 			  unsigned int cix)
 {
-  if((ix >= m_elements.size()) || (cix >= m_cell_vars.size()))
+  if((ix >= m_cell_lattice.size()) || (cix >= m_cell_vars.size()))
     return;
 
   // Make sure new value is within bounds, if limited
@@ -250,7 +304,7 @@ void XYConvexGrid::setVal(unsigned int ix, double val,
     val = m_cell_min_limit[cix];
     
   // Set the value of the cell IX for cell var CIX
-  m_cell_vals[ix][cix] = val;
+  m_cell_vals[(ix * m_cell_vars.size()) + cix] = val;
 
   
   // Update the minimum value so far noted for cell_var CIX
@@ -271,10 +325,10 @@ void XYConvexGrid::setVal(unsigned int ix, double val,
 void XYConvexGrid::incVal(unsigned int ix, double val,
 			  unsigned int cix)
 {
-  if((ix >= m_elements.size()) || (cix >= m_cell_vars.size()))
+  if((ix >= m_cell_lattice.size()) || (cix >= m_cell_vars.size()))
     return;
   
-  double curr_val = m_cell_vals[ix][cix];
+  double curr_val = m_cell_vals[(ix * m_cell_vars.size()) + cix];
   setVal(ix, curr_val+val, cix);
 }
 
@@ -283,9 +337,9 @@ void XYConvexGrid::incVal(unsigned int ix, double val,
 
 double XYConvexGrid::getVal(unsigned int ix, unsigned int cix) const
 {
-  if((ix >= m_elements.size()) || (cix >= m_cell_vars.size()))
+  if((ix >= m_cell_lattice.size()) || (cix >= m_cell_vars.size()))
     return(0);
-  return(m_cell_vals[ix][cix]);
+  return(m_cell_vals[(ix * m_cell_vars.size()) + cix]);
 }
 
 //-------------------------------------------------------------
@@ -416,11 +470,7 @@ void XYConvexGrid::setMaxLimit(double max_limit, unsigned int cix)
 
 bool XYConvexGrid::ptIntersect(double x, double y) const
 {
-  unsigned int i, vsize = m_elements.size();
-  for(i=0; i<vsize; i++) 
-    if(m_elements[i].containsPoint(x, y))
-      return(true);
-  return(false);
+  return(getCellIX(x, y) >= 0);
 }
 
 //-------------------------------------------------------------
@@ -446,6 +496,9 @@ bool XYConvexGrid::segIntersectBound(double x1, double y1,
 
 //-------------------------------------------------------------
 // Procedure: initialize
+//   Purpose: Set up the regular lattice of unit squares covering the
+//            outer square. Cells are created by the caller, and only
+//            for lattice positions the caller wants in the grid.
 
 bool XYConvexGrid::initialize(const XYSquare& outer_square,
 			      const XYSquare& unit_square)
@@ -472,22 +525,239 @@ bool XYConvexGrid::initialize(const XYSquare& outer_square,
   if(y_extra > 0)
     y_count++;
 
-  XYSquare new_square;
-  for(int i=0; i<x_count; i++) {
-    for(int j=0; j<y_count; j++) {
-      double x_low  = (i * unit_x_len) + outer_square.getVal(0,0);
-      double x_high = x_low + unit_x_len;
-      double y_low  = (j * unit_y_len) + outer_square.getVal(1,0);
-      double y_high = y_low + unit_y_len;
-      new_square.set(x_low, x_high, y_low, y_high);
-      m_elements.push_back(new_square);
-    }
-  }
+  m_cell_lattice.clear();
+  m_cell_vals.clear();
+  m_lattice_cols = (unsigned int)(x_count);
+  m_lattice_rows = (unsigned int)(y_count);
+  m_lattice_ix   = vector<int>(m_lattice_cols * m_lattice_rows, -1);
+  m_lattice_xlen = unit_x_len;
+  m_lattice_ylen = unit_y_len;
 
   m_bounding_square = outer_square;
   return(true);
 }
 
+//-------------------------------------------------------------
+// Procedure: getLatticeIX
+//   Returns: The grid cell index at the given lattice column and
+//            row, or -1 if out of range or not a cell of the grid.
+
+int XYConvexGrid::getLatticeIX(int col, int row) const
+{
+  if((col < 0) || (row < 0))
+    return(-1);
+  if((col >= (int)(m_lattice_cols)) || (row >= (int)(m_lattice_rows)))
+    return(-1);
+  return(m_lattice_ix[(col * m_lattice_rows) + row]);
+}
+
+//-------------------------------------------------------------
+// Procedure: getCellBounds
+//      Note: Computed the same way as the lattice columns and rows
+//            in initialize(), so cell edges agree exactly.
+
+void XYConvexGrid::getCellBounds(unsigned int ix,
+				 double& xlow, double& xhigh,
+				 double& ylow, double& yhigh) const
+{
+  unsigned int lattice_ix = m_cell_lattice[ix];
+  unsigned int col = lattice_ix / m_lattice_rows;
+  unsigned int row = lattice_ix % m_lattice_rows;
+
+  xlow  = (col * m_lattice_xlen) + m_bounding_square.getVal(0,0);
+  xhigh = xlow + m_lattice_xlen;
+  ylow  = (row * m_lattice_ylen) + m_bounding_square.getVal(1,0);
+  yhigh = ylow + m_lattice_ylen;
+}
+
+//-------------------------------------------------------------
+// Procedure: getCellIX
+//   Purpose: Find the grid cell containing the given point in
+//            constant time, using the regular cell layout.
+//   Returns: The cell index, or -1 if the point is in no cell.
+//      Note: A point on an edge shared by two cells is given to the
+//            upper/right cell if it is part of the grid.
+
+int XYConvexGrid::getCellIX(double x, double y) const
+{
+  if(m_lattice_ix.size() == 0)
+    return(-1);
+
+  double dx = (x - m_bounding_square.getVal(0,0)) / m_lattice_xlen;
+  double dy = (y - m_bounding_square.getVal(1,0)) / m_lattice_ylen;
+  if((dx < -1) || (dy < -1))
+    return(-1);
+  if((dx > (m_lattice_cols + 1)) || (dy > (m_lattice_rows + 1)))
+    return(-1);
+
+  int col = (int)(floor(dx));
+  int row = (int)(floor(dy));
+
+  int ix = getLatticeIX(col, row);
+  if((ix >= 0) && ptIntersect((unsigned int)(ix), x, y))
+    return(ix);
+
+  // Points on a lattice line, or subject to rounding at one, may
+  // belong to a neighboring cell instead.
+  for(int dcol=-1; dcol<=1; dcol++) {
+    for(int drow=-1; drow<=1; drow++) {
+      ix = getLatticeIX(col+dcol, row+drow);
+      if((ix >= 0) && ptIntersect((unsigned int)(ix), x, y))
+	return(ix);
+    }
+  }
+  return(-1);
+}
+
+//-------------------------------------------------------------
+// Procedure: getCellsIX
+//   Purpose: Find all cells containing the given point. A point on a
+//            shared cell edge or corner is contained by each of the
+//            two to four cells meeting there.
+//   Returns: The cell indices in ascending order, as found by testing
+//            ptIntersect on every cell.
+
+vector<unsigned int> XYConvexGrid::getCellsIX(double x, double y) const
+{
+  vector<unsigned int> cells;
+
+  int ix = getCellIX(x, y);
+  if(ix < 0)
+    return(cells);
+
+  // Any other containing cell neighbors the one found. Cells are
+  // indexed in lattice column-then-row order, so this visits them
+  // in ascending order.
+  double dx = (x - m_bounding_square.getVal(0,0)) / m_lattice_xlen;
+  double dy = (y - m_bounding_square.getVal(1,0)) / m_lattice_ylen;
+  int col = (int)(floor(dx));
+  int row = (int)(floor(dy));
+  for(int dcol=-1; dcol<=1; dcol++) {
+    for(int drow=-1; drow<=1; drow++) {
+      ix = getLatticeIX(col+dcol, row+drow);
+      if((ix >= 0) && ptIntersect((unsigned int)(ix), x, y))
+	cells.push_back((unsigned int)(ix));
+    }
+  }
+  return(cells);
+}
+
+//-------------------------------------------------------------
+// Procedure: getCellsOnSegment
+//   Purpose: Walk the lattice cells crossed by the given line
+//            segment, in order from (x1,y1) to (x2,y2).
+//   Returns: The indices of the grid cells crossed. Lattice
+//            positions that are not grid cells are skipped.
+
+vector<unsigned int> XYConvexGrid::getCellsOnSegment(double x1, double y1,
+						     double x2, double y2) const
+{
+  vector<unsigned int> cells;
+  if(m_lattice_ix.size() == 0)
+    return(cells);
+
+  // Part 1: Clip the segment to the lattice extent (Liang-Barsky).
+  //         This may reach past the bounding square by a partial cell.
+  double bxlow  = m_bounding_square.getVal(0,0);
+  double bylow  = m_bounding_square.getVal(1,0);
+  double bxhigh = bxlow + (m_lattice_cols * m_lattice_xlen);
+  double byhigh = bylow + (m_lattice_rows * m_lattice_ylen);
+
+  double vx = x2 - x1;
+  double vy = y2 - y1;
+  double t0 = 0;
+  double t1 = 1;
+  double p[4] = {-vx, vx, -vy, vy};
+  double q[4] = {x1-bxlow, bxhigh-x1, y1-bylow, byhigh-y1};
+  for(unsigned int k=0; k<4; k++) {
+    if(p[k] == 0) {
+      if(q[k] < 0)
+	return(cells);
+      continue;
+    }
+    double r = q[k] / p[k];
+    if(p[k] < 0) {
+      if(r > t1)
+	return(cells);
+      if(r > t0)
+	t0 = r;
+    }
+    else {
+      if(r < t0)
+	return(cells);
+      if(r < t1)
+	t1 = r;
+    }
+  }
+
+  double sx = x1 + (t0 * vx);
+  double sy = y1 + (t0 * vy);
+  double ex = x1 + (t1 * vx);
+  double ey = y1 + (t1 * vy);
+
+  // Part 2: Starting and ending lattice positions, clamped to lattice
+  int cols = (int)(m_lattice_cols);
+  int rows = (int)(m_lattice_rows);
+  int col  = (int)(floor((sx - bxlow) / m_lattice_xlen));
+  int row  = (int)(floor((sy - bylow) / m_lattice_ylen));
+  int ecol = (int)(floor((ex - bxlow) / m_lattice_xlen));
+  int erow = (int)(floor((ey - bylow) / m_lattice_ylen));
+  col  = (col  < 0) ? 0 : ((col  >= cols) ? cols-1 : col);
+  row  = (row  < 0) ? 0 : ((row  >= rows) ? rows-1 : row);
+  ecol = (ecol < 0) ? 0 : ((ecol >= cols) ? cols-1 : ecol);
+  erow = (erow < 0) ? 0 : ((erow >= rows) ? rows-1 : erow);
+
+  // Part 3: Step from cell to cell, crossing whichever lattice line,
+  //         vertical or horizontal, the segment reaches first.
+  int step_col = (vx > 0) ? 1 : -1;
+  int step_row = (vy > 0) ? 1 : -1;
+  
+  double inf = 1e300;
+  double tmax_x = inf;
+  double tmax_y = inf;
+  double tdel_x = inf;
+  double tdel_y = inf;
+  if(vx != 0) {
+    double next_x = bxlow + ((col + (vx > 0 ? 1 : 0)) * m_lattice_xlen);
+    tmax_x = (next_x - sx) / vx;
+    tdel_x = m_lattice_xlen / fabs(vx);
+  }
+  if(vy != 0) {
+    double next_y = bylow + ((row + (vy > 0 ? 1 : 0)) * m_lattice_ylen);
+    tmax_y = (next_y - sy) / vy;
+    tdel_y = m_lattice_ylen / fabs(vy);
+  }
+
+  double tspan = t1 - t0;
+  unsigned int max_steps = m_lattice_cols + m_lattice_rows + 2;
+  for(unsigned int k=0; k<=max_steps; k++) {
+    int ix = getLatticeIX(col, row);
+    if(ix >= 0)
+      cells.push_back((unsigned int)(ix));
+    if((col == ecol) && (row == erow))
+      break;
+    if((tmax_x > tspan) && (tmax_y > tspan))
+      break;
+    if(tmax_x < tmax_y) {
+      col += step_col;
+      tmax_x += tdel_x;
+    }
+    else if(tmax_y < tmax_x) {
+      row += step_row;
+      tmax_y += tdel_y;
+    }
+    else {
+      col += step_col;
+      row += step_row;
+      tmax_x += tdel_x;
+      tmax_y += tdel_y;
+    }
+    if((col < 0) || (col >= cols) || (row < 0) || (row >= rows))
+      break;
+  }
+  
+  return(cells);
+}
 
 //-------------------------------------------------------------
 // Procedure: reset
@@ -499,12 +769,12 @@ void XYConvexGrid::reset()
 {
   // For each element (grid cell) and each cell_var, reset to the
   // cell_var's initial value.
-  unsigned int ix,  esize = m_elements.size();
+  unsigned int ix,  esize = m_cell_lattice.size();
   unsigned int cix, csize = m_cell_vars.size();
   for(ix=0; ix<esize; ix++) {
     for(cix=0; cix<csize; cix++) {
       double init_val = m_cell_init_vals[cix];
-      m_cell_vals[ix][cix] = init_val;
+      m_cell_vals[(ix * csize) + cix] = init_val;
     }
   }
 
@@ -528,10 +798,11 @@ void XYConvexGrid::reset(const string& cell_var)
 
   // For each element (grid cell), for the given cell_var, reset 
   // to the cell_var's initial value.
-  unsigned int ix,  esize = m_elements.size();
+  unsigned int ix,  esize = m_cell_lattice.size();
+  unsigned int csize = m_cell_vars.size();
   for(ix=0; ix<esize; ix++) {
     double init_val = m_cell_init_vals[cix];
-    m_cell_vals[ix][cix] = init_val;
+    m_cell_vals[(ix * csize) + cix] = init_val;
   }
 
   // For given cell_var indicate that no values yet noted
@@ -552,13 +823,13 @@ string XYConvexGrid::get_spec() const
   //   cell=ix:var:val:var:val:var:val, or
   //   cell=23:force_angle:180:magnitude:2.3
 
-  unsigned int ix, esize = m_elements.size();
+  unsigned int ix, esize = m_cell_lattice.size();
   for(ix=0; ix<esize; ix++) {
     string cell_spec;
     unsigned int cix, csize = m_cell_vars.size();
     for(cix=0; cix<csize; cix++) {
-      if(m_cell_vals[ix][cix] != m_cell_init_vals[cix]) {
-	double dval = m_cell_vals[ix][cix];
+      if(m_cell_vals[(ix * csize) + cix] != m_cell_init_vals[cix]) {
+	double dval = m_cell_vals[(ix * csize) + cix];
 	//cell_spec += m_cell_vars[cix] + ":" + doubleToStringX(dval);	
 	cell_spec += ":" + m_cell_vars[cix] + ":" + doubleToStringX(dval);
       }
@@ -625,6 +896,7 @@ string XYConvexGrid::getConfigStr() const
 //-------------------------------------------------------------
 // Procedure: processDelta()
 //   Example: label@ix,delta:ix,delta : ... :ix,delta
+//            or the equivalent compact binary form
 
 //   label@cell=ix:var:val:var:val:var:val, or
 //   wind@cell=23:force_angle:180:magnitude:2.3
@@ -632,7 +904,13 @@ string XYConvexGrid::getConfigStr() const
 
 bool XYConvexGrid::processDelta(string str)
 {
-  XYGridUpdate update = stringToGridUpdate(str);
+  XYGridUpdate update;
+  if(isBinaryGridUpdate(str)) {
+    if(!binary2GridUpdate(str, update))
+      return(false);
+  }
+  else
+    update = stringToGridUpdate(str);
   if(!update.valid())
     return(false);
 
@@ -644,7 +922,7 @@ bool XYConvexGrid::processDelta(string str)
   for(unsigned int i=0; i<update.size(); i++) {
     unsigned int grid_ix = update.getCellIX(i);
     string cell_var      = update.getCellVar(i);
-    if(grid_ix >= m_cell_vals.size())
+    if(grid_ix >= m_cell_lattice.size())
       return(false);
     if(!hasCellVar(cell_var))
       return(false);
@@ -655,11 +933,12 @@ bool XYConvexGrid::processDelta(string str)
     string cell_var      = update.getCellVar(i);
     double cell_val      = update.getCellVal(i);
     unsigned int cix     = getCellVarIX(cell_var);
+    unsigned int vix     = (grid_ix * m_cell_vars.size()) + cix;
 
     if(update.isUpdateTypeDelta())
-      m_cell_vals[grid_ix][cix] += cell_val; 
+      m_cell_vals[vix] += cell_val; 
     else if(update.isUpdateTypeReplace())
-      m_cell_vals[grid_ix][cix] = cell_val; 
+      m_cell_vals[vix] = cell_val; 
   }
   
   return(true);
@@ -680,20 +959,22 @@ bool XYConvexGrid::setEdgeCache(double pix_per_mtr_x,
   m_pix_per_mtr_y = pix_per_mtr_y;
   
   vector<vector<double> > new_cache;
-  for(unsigned int i=0; i<m_elements.size(); i++) {
+  for(unsigned int i=0; i<m_cell_lattice.size(); i++) {
     vector<double> element_cache;
+    double xlow, xhigh, ylow, yhigh;
+    getCellBounds(i, xlow, xhigh, ylow, yhigh);
     
-    element_cache.push_back(m_elements[i].getVal(0,0) * pix_per_mtr_x);
-    element_cache.push_back(m_elements[i].getVal(1,0) * pix_per_mtr_y);
+    element_cache.push_back(xlow  * pix_per_mtr_x);
+    element_cache.push_back(ylow  * pix_per_mtr_y);
     
-    element_cache.push_back(m_elements[i].getVal(0,1) * pix_per_mtr_x);
-    element_cache.push_back(m_elements[i].getVal(1,0) * pix_per_mtr_y);
+    element_cache.push_back(xhigh * pix_per_mtr_x);
+    element_cache.push_back(ylow  * pix_per_mtr_y);
     
-    element_cache.push_back(m_elements[i].getVal(0,1) * pix_per_mtr_x);
-    element_cache.push_back(m_elements[i].getVal(1,1) * pix_per_mtr_y);
+    element_cache.push_back(xhigh * pix_per_mtr_x);
+    element_cache.push_back(yhigh * pix_per_mtr_y);
     
-    element_cache.push_back(m_elements[i].getVal(0,0) * pix_per_mtr_x);
-    element_cache.push_back(m_elements[i].getVal(1,1) * pix_per_mtr_y);
+    element_cache.push_back(xlow  * pix_per_mtr_x);
+    element_cache.push_back(yhigh * pix_per_mtr_y);
 
     new_cache.push_back(element_cache);
   }
@@ -709,8 +990,8 @@ bool XYConvexGrid::setEdgeCache(double pix_per_mtr_x,
 
 void XYConvexGrid::print() const
 {
-  unsigned int i, vsize = m_elements.size();
+  unsigned int i, vsize = m_cell_lattice.size();
   for(i=0; i<vsize; i++) 
-    cout << "[" << i << "]: " << m_elements[i].get_spec() << endl;
+    cout << "[" << i << "]: " << getElement(i).get_spec() << endl;
 }
 
@@ -48,7 +48,7 @@ public:
 			 double x1, double y1,
 			 double x2, double y2);
 
-  unsigned int size() const    {return(m_elements.size());}
+  unsigned int size() const    {return(m_cell_lattice.size());}
 
   XYSquare     getElement(unsigned int index) const;
   XYSquare     getSBound() const  {return(m_bounding_square);}
@@ -56,6 +56,11 @@ public:
   bool         ptIntersectBound(double, double) const;
   bool         segIntersectBound(double, double, double, double) const;
 
+  int          getCellIX(double x, double y) const;
+  std::vector<unsigned int> getCellsIX(double x, double y) const;
+  std::vector<unsigned int> getCellsOnSegment(double x1, double y1,
+					      double x2, double y2) const;
+
   bool         hasCellVar(const std::string&) const;
   unsigned int getCellVarIX(const std::string&) const;
   unsigned int getCellVarCnt() const {return(m_cell_vars.size());}
@@ -96,6 +101,9 @@ public:
   
 protected:
   bool    initialize(const XYSquare&, const XYSquare&);
+  int     getLatticeIX(int col, int row) const;
+  void    getCellBounds(unsigned int ix, double& xlow, double& xhigh,
+			double& ylow, double& yhigh) const;
     
  protected: // Config variables
   XYPolygon m_config_poly;
@@ -112,11 +120,22 @@ protected:
 
 
  protected: // State variables
-  std::vector<XYSquare> m_elements;
   XYSquare              m_bounding_square;
+
+  // Regular lattice over the bounding square, column major. Holds the
+  // element index of each lattice position, or -1 if not in the grid.
+  unsigned int          m_lattice_cols;
+  unsigned int          m_lattice_rows;
+  double                m_lattice_xlen;
+  double                m_lattice_ylen;
+  std::vector<int>      m_lattice_ix;
+
+  // Per grid element: its position in the lattice. Cell squares are
+  // derived from this on demand rather than stored.
+  std::vector<unsigned int> m_cell_lattice;
   
-  // Outer IX: per grid element. Inner IX: per cellvar
-  std::vector<std::vector<double> >     m_cell_vals;
+  // Per grid element, one value per cellvar: [(ix * cellvars) + cix]
+  std::vector<double>                   m_cell_vals;
   //std::vector<std::vector<unsigned int> m_cell_vals_cnt;
   
   // Index is per cell variable
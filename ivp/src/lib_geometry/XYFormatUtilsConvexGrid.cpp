@@ -29,7 +29,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <vector>
+#include <map>
 #include <iostream>
+#include <stdint.h>
 #include "XYFormatUtilsConvexGrid.h"
 #include "XYPolygon.h"
 #include "XYSquare.h"
@@ -45,6 +47,8 @@ using namespace std;
 XYConvexGrid string2ConvexGrid(string str)
 {
   //cout << "string2ConvexGrid:" << str << endl;
+  if(isBinaryConvexGrid(str))
+    return(binary2ConvexGrid(str));
 
   XYConvexGrid null_grid;
   XYConvexGrid new_grid;
@@ -252,12 +256,467 @@ XYConvexGrid string2ConvexGrid(string str)
   return(new_grid);
 }
 
+//---------------------------------------------------------------
+// Binary grid format. Both forms begin with the prefix 0xB1 'C'
+// 'G', a version byte, and a type byte: 'S' for a full snapshot
+// or 'D' for a grid update.
+//
+//   Snapshot: [config str][cell cnt][cell var cnt], then for each
+//             cell var: [encoding] and runs [skip][cnt][cnt vals].
+//             Skipped cells hold the cell var initial value.
+//   Update:   [grid name][update type][var cnt][var names]
+//             [entry cnt][encoding], then for each entry:
+//             [cell index step][var index][val]
+//
+// Counts, indices and string lengths are varints, 7 bits per byte,
+// low order first. Fixed width values are little-endian.
+
+static const unsigned char cgb_version = 1;
+
+enum CGBEncoding {CGB_DOUBLE=0, CGB_INT16=1, CGB_INT32=2};
+
+//---------------------------------------------------------
+// Procedure: cgbPutUInt(), cgbPutVarUInt(), cgbPutDouble(),
+//            cgbPutString()
+
+static void cgbPutUInt(string& buff, unsigned long long val,
+		       unsigned int bytes)
+{
+  for(unsigned int i=0; i<bytes; i++)
+    buff.push_back((char)((val >> (8*i)) & 0xFF));
+}
+
+static void cgbPutVarUInt(string& buff, unsigned long long val)
+{
+  while(val >= 0x80) {
+    buff.push_back((char)((val & 0x7F) | 0x80));
+    val >>= 7;
+  }
+  buff.push_back((char)val);
+}
+
+static void cgbPutDouble(string& buff, double dval)
+{
+  uint64_t ival;
+  memcpy(&ival, &dval, sizeof(ival));
+  cgbPutUInt(buff, ival, 8);
+}
+
+static void cgbPutString(string& buff, const string& str)
+{
+  cgbPutVarUInt(buff, str.length());
+  buff += str;
+}
+
+//---------------------------------------------------------
+// Procedure: cgbGetUInt(), cgbGetVarUInt(), cgbGetDouble(),
+//            cgbGetString()
+//      Note: Each advances ix and returns false if the buffer is
+//            too short or the content is malformed.
+
+static bool cgbGetUInt(const string& buff, unsigned int& ix,
+		       unsigned long long& val, unsigned int bytes)
+{
+  if((ix + bytes) > buff.length())
+    return(false);
+  val = 0;
+  for(unsigned int i=0; i<bytes; i++) {
+    unsigned long long byte = (unsigned char)(buff[ix+i]);
+    val |= (byte << (8*i));
+  }
+  ix += bytes;
+  return(true);
+}
+
+static bool cgbGetVarUInt(const string& buff, unsigned int& ix,
+			  unsigned long long& val)
+{
+  val = 0;
+  for(unsigned int shift=0; shift<64; shift+=7) {
+    if(ix >= buff.length())
+      return(false);
+    unsigned long long byte = (unsigned char)(buff[ix++]);
+    val |= ((byte & 0x7F) << shift);
+    if((byte & 0x80) == 0)
+      return(true);
+  }
+  return(false);
+}
+
+static bool cgbGetDouble(const string& buff, unsigned int& ix,
+			 double& dval)
+{
+  unsigned long long val;
+  if(!cgbGetUInt(buff, ix, val, 8))
+    return(false);
+  uint64_t ival = val;
+  memcpy(&dval, &ival, sizeof(dval));
+  return(true);
+}
+
+static bool cgbGetString(const string& buff, unsigned int& ix,
+			 string& str)
+{
+  unsigned long long len;
+  if(!cgbGetVarUInt(buff, ix, len))
+    return(false);
+  if((ix + len) > buff.length())
+    return(false);
+  str = buff.substr(ix, len);
+  ix += len;
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: cgbChooseEncoding()
+//   Purpose: Pick the smallest value encoding for the given values.
+//            With no quantization, integer encodings are used only
+//            if every value is a whole number, so nothing is lost.
+
+static unsigned char cgbChooseEncoding(const vector<double>& vals,
+				       double quant, double& step)
+{
+  step = 1;
+  if(quant > 0)
+    step = quant;
 
+  double maxabs = 0;
+  for(unsigned int i=0; i<vals.size(); i++) {
+    if(!std::isfinite(vals[i]))
+      return(CGB_DOUBLE);
+    double qval = std::round(vals[i] / step);
+    if((quant <= 0) && (qval != vals[i]))
+      return(CGB_DOUBLE);
+    if(fabs(qval) > maxabs)
+      maxabs = fabs(qval);
+  }
 
+  if(maxabs <= 32767)
+    return(CGB_INT16);
+  if(maxabs <= 2147483647.0)
+    return(CGB_INT32);
+  return(CGB_DOUBLE);
+}
 
+//---------------------------------------------------------
+// Procedure: cgbPutEncoding(), cgbPutValue()
 
+static void cgbPutEncoding(string& buff, unsigned char enc, double step)
+{
+  buff.push_back((char)enc);
+  if(enc != CGB_DOUBLE)
+    cgbPutDouble(buff, step);
+}
 
+static void cgbPutValue(string& buff, double dval, unsigned char enc,
+			double step)
+{
+  if(enc == CGB_DOUBLE) {
+    cgbPutDouble(buff, dval);
+    return;
+  }
+  long long qval = std::llround(dval / step);
+  if(enc == CGB_INT16)
+    cgbPutUInt(buff, (uint16_t)((int16_t)qval), 2);
+  else
+    cgbPutUInt(buff, (uint32_t)((int32_t)qval), 4);
+}
 
+//---------------------------------------------------------
+// Procedure: cgbGetEncoding(), cgbGetValue()
 
+static bool cgbGetEncoding(const string& buff, unsigned int& ix,
+			   unsigned char& enc, double& step)
+{
+  unsigned long long val;
+  if(!cgbGetUInt(buff, ix, val, 1) || (val > CGB_INT32))
+    return(false);
+  enc  = (unsigned char)val;
+  step = 1;
+  if((enc != CGB_DOUBLE) && !cgbGetDouble(buff, ix, step))
+    return(false);
+  return(true);
+}
 
+static bool cgbGetValue(const string& buff, unsigned int& ix,
+			double& dval, unsigned char enc, double step)
+{
+  if(enc == CGB_DOUBLE)
+    return(cgbGetDouble(buff, ix, dval));
 
+  unsigned long long val;
+  if(enc == CGB_INT16) {
+    if(!cgbGetUInt(buff, ix, val, 2))
+      return(false);
+    dval = (double)((int16_t)((uint16_t)val)) * step;
+  }
+  else {
+    if(!cgbGetUInt(buff, ix, val, 4))
+      return(false);
+    dval = (double)((int32_t)((uint32_t)val)) * step;
+  }
+  return(true);
+}
+
+//---------------------------------------------------------
+// Procedure: cgbPutHeader(), cgbCheckHeader()
+
+static void cgbPutHeader(string& buff, char type)
+{
+  buff.push_back((char)0xB1);
+  buff.push_back('C');
+  buff.push_back('G');
+  buff.push_back((char)cgb_version);
+  buff.push_back(type);
+}
+
+static bool cgbCheckHeader(const string& str, char type)
+{
+  if(str.length() < 5)
+    return(false);
+  return(((unsigned char)(str[0]) == 0xB1) && (str[1] == 'C') &&
+	 (str[2] == 'G') && (str[4] == type));
+}
+
+//---------------------------------------------------------
+// Procedure: isBinaryConvexGrid(), isBinaryGridUpdate()
+
+bool isBinaryConvexGrid(const string& str)
+{
+  return(cgbCheckHeader(str, 'S'));
+}
+
+bool isBinaryGridUpdate(const string& str)
+{
+  return(cgbCheckHeader(str, 'D'));
+}
+
+//---------------------------------------------------------
+// Procedure: convexGrid2Binary()
+//   Purpose: Produce the compact binary form of the grid. As with
+//            XYConvexGrid::get_spec(), only cell values differing
+//            from the initial value are carried.
+
+string convexGrid2Binary(const XYConvexGrid& grid, double quant)
+{
+  string buff;
+  cgbPutHeader(buff, 'S');
+
+  string config = grid.getConfigStr();
+  string obj_spec = grid.XYObject::get_spec();
+  if(obj_spec != "")
+    config += "," + obj_spec;
+  cgbPutString(buff, config);
+
+  unsigned int esize = grid.size();
+  unsigned int csize = grid.getCellVarCnt();
+  cgbPutVarUInt(buff, esize);
+  cgbPutVarUInt(buff, csize);
+
+  for(unsigned int cix=0; cix<csize; cix++) {
+    double init_val = grid.getInitVal(cix);
+
+    vector<double> vals;
+    for(unsigned int ix=0; ix<esize; ix++) {
+      double dval = grid.getVal(ix, cix);
+      if(dval != init_val)
+	vals.push_back(dval);
+    }
+    double step;
+    unsigned char enc = cgbChooseEncoding(vals, quant, step);
+    cgbPutEncoding(buff, enc, step);
+
+    unsigned int ix = 0;
+    while(ix < esize) {
+      unsigned int skip = 0;
+      while((ix < esize) && (grid.getVal(ix, cix) == init_val)) {
+	skip++;
+	ix++;
+      }
+      unsigned int start = ix;
+      while((ix < esize) && (grid.getVal(ix, cix) != init_val))
+	ix++;
+      cgbPutVarUInt(buff, skip);
+      cgbPutVarUInt(buff, ix - start);
+      for(unsigned int j=start; j<ix; j++)
+	cgbPutValue(buff, grid.getVal(j, cix), enc, step);
+    }
+  }
+
+  return(buff);
+}
+
+//---------------------------------------------------------
+// Procedure: binary2ConvexGrid()
+//   Returns: An empty grid if the buffer is malformed, or its
+//            config does not match the cell data that follows.
+
+XYConvexGrid binary2ConvexGrid(const string& str)
+{
+  XYConvexGrid null_grid;
+  null_grid.set_msg("Invalid binary grid");
+
+  if(!isBinaryConvexGrid(str) || ((unsigned char)(str[3]) != cgb_version))
+    return(null_grid);
+
+  unsigned int ix = 5;
+  string config;
+  if(!cgbGetString(str, ix, config))
+    return(null_grid);
+
+  XYConvexGrid new_grid = string2ConvexGrid(config);
+
+  unsigned long long esize, csize;
+  if(!cgbGetVarUInt(str, ix, esize) || !cgbGetVarUInt(str, ix, csize))
+    return(null_grid);
+  if((esize != new_grid.size()) || (csize != new_grid.getCellVarCnt()))
+    return(null_grid);
+
+  for(unsigned int cix=0; cix<csize; cix++) {
+    unsigned char enc;
+    double step;
+    if(!cgbGetEncoding(str, ix, enc, step))
+      return(null_grid);
+
+    unsigned long long cell = 0;
+    while(cell < esize) {
+      unsigned long long skip, count;
+      if(!cgbGetVarUInt(str, ix, skip) || !cgbGetVarUInt(str, ix, count))
+	return(null_grid);
+      if((cell + skip + count) > esize)
+	return(null_grid);
+      cell += skip;
+      for(unsigned long long j=0; j<count; j++) {
+	double dval;
+	if(!cgbGetValue(str, ix, dval, enc, step))
+	  return(null_grid);
+	new_grid.setVal(cell, dval, cix);
+	cell++;
+      }
+    }
+  }
+
+  return(new_grid);
+}
+
+//---------------------------------------------------------
+// Procedure: gridUpdate2Binary()
+//   Purpose: Produce the compact binary form of the grid update.
+//            Cell var names are sent once, and cell indices as the
+//            step from the previous entry's index.
+
+string gridUpdate2Binary(const XYGridUpdate& update, double quant)
+{
+  if(!update.valid())
+    return("");
+
+  string buff;
+  cgbPutHeader(buff, 'D');
+  cgbPutString(buff, update.getGridName());
+
+  unsigned char update_type = 0;
+  if(update.isUpdateTypeReplace())
+    update_type = 1;
+  else if(update.isUpdateTypeAverage())
+    update_type = 2;
+  buff.push_back((char)update_type);
+
+  vector<string> vars;
+  map<string, unsigned int> var_ix;
+  vector<double> vals;
+  unsigned int i, usize = update.size();
+  for(i=0; i<usize; i++) {
+    string var = update.getCellVar(i);
+    if(var_ix.count(var) == 0) {
+      var_ix[var] = vars.size();
+      vars.push_back(var);
+    }
+    vals.push_back(update.getCellVal(i));
+  }
+
+  cgbPutVarUInt(buff, vars.size());
+  for(i=0; i<vars.size(); i++)
+    cgbPutString(buff, vars[i]);
+
+  cgbPutVarUInt(buff, usize);
+  double step;
+  unsigned char enc = cgbChooseEncoding(vals, quant, step);
+  cgbPutEncoding(buff, enc, step);
+
+  // Index steps may be negative, so are zigzag encoded
+  long long prev_ix = 0;
+  for(i=0; i<usize; i++) {
+    long long cell_ix = update.getCellIX(i);
+    long long diff = cell_ix - prev_ix;
+    unsigned long long zigzag = (diff < 0) ? ((-diff * 2) - 1) : (diff * 2);
+    cgbPutVarUInt(buff, zigzag);
+    cgbPutVarUInt(buff, var_ix[update.getCellVar(i)]);
+    cgbPutValue(buff, vals[i], enc, step);
+    prev_ix = cell_ix;
+  }
+
+  return(buff);
+}
+
+//---------------------------------------------------------
+// Procedure: binary2GridUpdate()
+//   Returns: false if the buffer is malformed
+
+bool binary2GridUpdate(const string& str, XYGridUpdate& update)
+{
+  if(!isBinaryGridUpdate(str) || ((unsigned char)(str[3]) != cgb_version))
+    return(false);
+
+  unsigned int ix = 5;
+  string grid_name;
+  unsigned long long update_type;
+  if(!cgbGetString(str, ix, grid_name) ||
+     !cgbGetUInt(str, ix, update_type, 1))
+    return(false);
+
+  XYGridUpdate new_update(grid_name);
+  if(update_type == 1)
+    new_update.setUpdateTypeReplace();
+  else if(update_type == 2)
+    new_update.setUpdateTypeAverage();
+  else if(update_type != 0)
+    return(false);
+
+  unsigned long long vcnt;
+  if(!cgbGetVarUInt(str, ix, vcnt) || (vcnt > str.length()))
+    return(false);
+  vector<string> vars(vcnt);
+  for(unsigned int i=0; i<vcnt; i++) {
+    if(!cgbGetString(str, ix, vars[i]))
+      return(false);
+  }
+
+  unsigned long long usize;
+  unsigned char enc;
+  double step;
+  if(!cgbGetVarUInt(str, ix, usize) || !cgbGetEncoding(str, ix, enc, step))
+    return(false);
+
+  long long cell_ix = 0;
+  for(unsigned long long i=0; i<usize; i++) {
+    unsigned long long zigzag, vix;
+    double dval;
+    if(!cgbGetVarUInt(str, ix, zigzag) || !cgbGetVarUInt(str, ix, vix))
+      return(false);
+    if((vix >= vars.size()) || !cgbGetValue(str, ix, dval, enc, step))
+      return(false);
+    if(zigzag & 1)
+      cell_ix -= (long long)((zigzag + 1) / 2);
+    else
+      cell_ix += (long long)(zigzag / 2);
+    if(cell_ix < 0)
+      return(false);
+    new_update.addUpdate((unsigned int)cell_ix, vars[vix], dval);
+  }
+
+  if(!new_update.valid())
+    return(false);
+
+  update = new_update;
+  return(true);
+}
@@ -28,12 +28,28 @@
 
 #include <string>
 #include "XYConvexGrid.h"
+#include "XYGridUpdate.h"
 
 //---------------------------------------------------------------
-// Create a convex grid from a string specification. 
+// Create a convex grid from a string specification. The string
+// may also be in the compact binary form below.
 
 XYConvexGrid string2ConvexGrid(std::string);
 
+//---------------------------------------------------------------
+// Compact binary encoding of grid snapshots and grid updates,
+// posted as a MOOS_BINARY_STRING. Cell values are quantized to
+// multiples of quant if quant > 0. Otherwise values are stored
+// losslessly, as small integers when possible.
+
+std::string  convexGrid2Binary(const XYConvexGrid&, double quant=0);
+XYConvexGrid binary2ConvexGrid(const std::string&);
+bool         isBinaryConvexGrid(const std::string&);
+
+std::string  gridUpdate2Binary(const XYGridUpdate&, double quant=0);
+bool         binary2GridUpdate(const std::string&, XYGridUpdate&);
+bool         isBinaryGridUpdate(const std::string&);
+
 #endif
 
 
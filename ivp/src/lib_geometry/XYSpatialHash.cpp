@@ -0,0 +1,237 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: XYSpatialHash.cpp                                    */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "MBUtils.h"
+#include "XYSpatialHash.h"
+
+using namespace std;
+
+//---------------------------------------------------------------
+// Constructor()
+
+XYSpatialHash::XYSpatialHash(double cell_size)
+{
+  m_cell_size = 100;
+  if(cell_size > 0)
+    m_cell_size = cell_size;
+}
+
+//---------------------------------------------------------------
+// Procedure: setCellSize()
+//      Note: All current entries are re-hashed into the new cells.
+
+bool XYSpatialHash::setCellSize(double cell_size)
+{
+  if(cell_size <= 0)
+    return(false);
+  if(cell_size == m_cell_size)
+    return(true);
+
+  m_cell_size = cell_size;
+  m_cells.clear();
+  m_key_cell.clear();
+
+  map<string, double>::iterator p;
+  for(p=m_key_x.begin(); p!=m_key_x.end(); p++) {
+    string key = p->first;
+    pair<int,int> cix = cellIndex(p->second, m_key_y[key]);
+    addToCell(key, cix);
+  }
+  return(true);
+}
+
+//---------------------------------------------------------------
+// Procedure: update()
+//      Note: If the object remains in the same cell, only its
+//            position is updated.
+
+void XYSpatialHash::update(const string& key, double x, double y)
+{
+  pair<int,int> cix = cellIndex(x, y);
+  
+  map<string, pair<int,int> >::iterator p = m_key_cell.find(key);
+  if(p == m_key_cell.end())
+    addToCell(key, cix);
+  else if(p->second != cix) {
+    removeFromCell(key, p->second);
+    addToCell(key, cix);
+  }
+
+  m_key_x[key] = x;
+  m_key_y[key] = y;
+}
+
+//---------------------------------------------------------------
+// Procedure: remove()
+
+void XYSpatialHash::remove(const string& key)
+{
+  map<string, pair<int,int> >::iterator p = m_key_cell.find(key);
+  if(p == m_key_cell.end())
+    return;
+
+  removeFromCell(key, p->second);
+  m_key_x.erase(key);
+  m_key_y.erase(key);
+}
+
+//---------------------------------------------------------------
+// Procedure: clear()
+
+void XYSpatialHash::clear()
+{
+  m_cells.clear();
+  m_key_cell.clear();
+  m_key_x.clear();
+  m_key_y.clear();
+}
+
+//---------------------------------------------------------------
+// Procedure: contains()
+
+bool XYSpatialHash::contains(const string& key) const
+{
+  return(m_key_x.count(key) != 0);
+}
+
+//---------------------------------------------------------------
+// Procedure: getX()
+
+double XYSpatialHash::getX(const string& key) const
+{
+  map<string, double>::const_iterator p = m_key_x.find(key);
+  if(p == m_key_x.end())
+    return(0);
+  return(p->second);
+}
+
+//---------------------------------------------------------------
+// Procedure: getY()
+
+double XYSpatialHash::getY(const string& key) const
+{
+  map<string, double>::const_iterator p = m_key_y.find(key);
+  if(p == m_key_y.end())
+    return(0);
+  return(p->second);
+}
+
+//---------------------------------------------------------------
+// Procedure: getKeysInRange()
+//   Purpose: Return all keys within the given range of the point,
+//            in sorted order. Only cells overlapping the bounding
+//            box of the query circle are visited. If that box holds
+//            more cells than are occupied, the occupied cells are
+//            visited instead.
+
+vector<string> XYSpatialHash::getKeysInRange(double x, double y,
+					     double range) const
+{
+  vector<string> keys;
+  if(range < 0)
+    return(keys);
+  
+  pair<int,int> cmin = cellIndex(x-range, y-range);
+  pair<int,int> cmax = cellIndex(x+range, y+range);
+  
+  double xcells = (double)(cmax.first)  - (double)(cmin.first)  + 1;
+  double ycells = (double)(cmax.second) - (double)(cmin.second) + 1;
+  
+  vector<const set<string>*> cands;
+  if((xcells * ycells) > (double)(m_cells.size())) {
+    map<pair<int,int>, set<string> >::const_iterator p;
+    for(p=m_cells.begin(); p!=m_cells.end(); p++) {
+      int ix = p->first.first;
+      int iy = p->first.second;
+      if((ix >= cmin.first) && (ix <= cmax.first) &&
+	 (iy >= cmin.second) && (iy <= cmax.second))
+	cands.push_back(&(p->second));
+    }
+  }
+  else {
+    for(int ix=cmin.first; ix<=cmax.first; ix++) {
+      for(int iy=cmin.second; iy<=cmax.second; iy++) {
+	map<pair<int,int>, set<string> >::const_iterator p;
+	p = m_cells.find(pair<int,int>(ix,iy));
+	if(p != m_cells.end())
+	  cands.push_back(&(p->second));
+      }
+    }
+  }
+
+  // Exact range check on the objects in the candidate cells
+  double range_sq = range * range;
+  for(unsigned int i=0; i<cands.size(); i++) {
+    set<string>::const_iterator q;
+    for(q=cands[i]->begin(); q!=cands[i]->end(); q++) {
+      double dx = m_key_x.find(*q)->second - x;
+      double dy = m_key_y.find(*q)->second - y;
+      if(((dx*dx) + (dy*dy)) <= range_sq)
+	keys.push_back(*q);
+    }
+  }
+
+  sort(keys.begin(), keys.end());
+  return(keys);
+}
+
+//---------------------------------------------------------------
+// Procedure: cellIndex()
+//      Note: Indices are clipped so that very large query ranges
+//            do not overflow.
+
+pair<int,int> XYSpatialHash::cellIndex(double x, double y) const
+{
+  double dix = floor(x / m_cell_size);
+  double diy = floor(y / m_cell_size);
+  dix = vclip(dix, -1000000000, 1000000000);
+  diy = vclip(diy, -1000000000, 1000000000);
+  return(pair<int,int>((int)(dix), (int)(diy)));
+}
+
+//---------------------------------------------------------------
+// Procedure: addToCell()
+
+void XYSpatialHash::addToCell(const string& key, pair<int,int> cix)
+{
+  m_cells[cix].insert(key);
+  m_key_cell[key] = cix;
+}
+
+//---------------------------------------------------------------
+// Procedure: removeFromCell()
+//      Note: Empty cells are dropped so the cell map only ever
+//            holds occupied cells.
+
+void XYSpatialHash::removeFromCell(const string& key, pair<int,int> cix)
+{
+  map<pair<int,int>, set<string> >::iterator p = m_cells.find(cix);
+  if(p != m_cells.end()) {
+    p->second.erase(key);
+    if(p->second.size() == 0)
+      m_cells.erase(p);
+  }
+  m_key_cell.erase(key);
+}
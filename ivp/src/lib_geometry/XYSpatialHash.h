@@ -0,0 +1,76 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: XYSpatialHash.h                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef XY_SPATIAL_HASH_HEADER
+#define XY_SPATIAL_HASH_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+// A uniform grid over the plane holding the latest position of
+// a set of named objects, e.g., vehicles. Positions are updated
+// incrementally, and range queries visit only the grid cells
+// overlapping the query circle. Cells are created on demand so
+// the grid has no fixed bounds.
+
+class XYSpatialHash
+{
+ public:
+  XYSpatialHash(double cell_size=100);
+  ~XYSpatialHash() {}
+
+  bool setCellSize(double);
+  
+  void update(const std::string& key, double x, double y);
+  void remove(const std::string& key);
+  void clear();
+
+  bool   contains(const std::string& key) const;
+  double getX(const std::string& key) const;
+  double getY(const std::string& key) const;
+  
+  std::vector<std::string> getKeysInRange(double x, double y,
+					  double range) const;
+
+  double       getCellSize() const {return(m_cell_size);}
+  unsigned int size() const        {return(m_key_x.size());}
+  unsigned int cells() const       {return(m_cells.size());}
+  
+ protected:
+  std::pair<int,int> cellIndex(double x, double y) const;
+  void addToCell(const std::string& key, std::pair<int,int>);
+  void removeFromCell(const std::string& key, std::pair<int,int>);
+  
+ protected:
+  double m_cell_size;
+  
+  std::map<std::pair<int,int>, std::set<std::string> > m_cells;
+
+  std::map<std::string, std::pair<int,int> > m_key_cell;
+  std::map<std::string, double>              m_key_x;
+  std::map<std::string, double>              m_key_y;
+};
+
+#endif 
@@ -57,6 +57,7 @@
 #include "BHV_RStationKeep.h"
 #include "BHV_CutRange.h"
 #include "BHV_AvoidCollision.h"
+#include "BHV_AvoidCollisionMulti.h"
 #include "BHV_AvoidObstacle.h"
 #include "BHV_AvoidObstacleX.h"
 #include "BHV_AvoidObstacleV21.h"
@@ -112,6 +113,7 @@ bool BFactoryStatic::isKnownBehavior(string bhv_name) const
      (bhv_name == "BHV_Shadow")          || 
      (bhv_name == "BHV_CutRange")        || 
      (bhv_name == "BHV_AvoidCollision")  || 
+     (bhv_name == "BHV_AvoidCollisionMulti") || 
      (bhv_name == "BHV_AvoidObstacle")   || 
      (bhv_name == "BHV_AvoidObstacleX")  || 
      (bhv_name == "BHV_AvoidObstacleV21")|| 
@@ -200,6 +202,8 @@ IvPBehavior* BFactoryStatic::newBehavior(string bhv_name) const
     bhv = new BHV_CutRange(m_domain);
   else if(bhv_name == "BHV_AvoidCollision") 
     bhv = new BHV_AvoidCollision(m_domain);
+  else if(bhv_name == "BHV_AvoidCollisionMulti") 
+    bhv = new BHV_AvoidCollisionMulti(m_domain);
   else if(bhv_name == "BHV_AvoidObstacle") 
     bhv = new BHV_AvoidObstacle(m_domain);
   else if(bhv_name == "BHV_AvoidObstacleX") 
@@ -38,11 +38,13 @@ BehaviorSet::BehaviorSet()
 {
   m_report_ipf = true;
   m_curr_time  = -1;
+  m_profiler   = 0;
   m_bfactory_dynamic.loadEnvVarDirectories("IVP_BEHAVIOR_DIRS");
 
   m_total_behaviors_ever = 0;
   m_bhv_entry.reserve(1000);
   m_completed_pending = false;
+  m_spawn_prototypes  = true;
 }
 
 //------------------------------------------------------------
@@ -51,6 +53,10 @@ BehaviorSet::BehaviorSet()
 BehaviorSet::~BehaviorSet()
 {
   clearBehaviors();
+
+  map<unsigned int, SpecBuild>::iterator p;
+  for(p=m_prototypes.begin(); p!=m_prototypes.end(); p++)
+    p->second.deleteBehavior();
 }
 
 //------------------------------------------------------------
@@ -327,7 +333,41 @@ SpecBuild BehaviorSet::buildBehaviorFromSpec(BehaviorSpec spec,
   
   // Then apply all the behavior specs from an UPDATES string which may
   // possibly be empty.
-  // NOTE: If the update_str is non-empty we can assume this is a spawning
+  bool updates_valid = applySpawnUpdates(bhv, update_str, sbuild);
+  specs_valid = specs_valid && updates_valid;
+
+  if(specs_valid) {
+    sbuild.setIvPBehavior(bhv);
+    // Added Oct 1313 mikerb - allow template behaviors to make an
+    // initial posting on helm startup, even if no instance made on
+    // startup (or ever).
+    if(on_startup) {
+      cout << bhv->getDescriptor() << endl;
+      bhv->onHelmStart();
+    }
+    // The behavior may now have some messages (var-data pairs) ready
+    // for retrieval
+  }
+  else {
+    delete(bhv);
+  }
+
+  return(sbuild);
+}
+
+
+//------------------------------------------------------------
+// Procedure: applySpawnUpdates()
+//   Purpose: Apply the params of a spawning UPDATES string to the
+//            given behavior. All bad params are noted, not just the
+//            first. Returns false if any were bad.
+//      Note: If the update_str is non-empty we can assume this is
+//            a spawning
+
+bool BehaviorSet::applySpawnUpdates(IvPBehavior *bhv, string update_str,
+				    SpecBuild& sbuild)
+{
+  bool all_valid = true;
   vector<string> jvector = parseStringQ(update_str, '#');
   unsigned int j, jsize = jvector.size();
   for(j=0; j<jsize; j++) {
@@ -351,29 +391,63 @@ SpecBuild BehaviorSet::buildBehaviorFromSpec(BehaviorSpec spec,
       addWarning(msg);
     }
 
-    specs_valid = specs_valid && valid;
+    all_valid = all_valid && valid;
   }
+  return(all_valid);
+}
 
-  if(specs_valid) {
-    sbuild.setIvPBehavior(bhv);
-    // Added Oct 1313 mikerb - allow template behaviors to make an
-    // initial posting on helm startup, even if no instance made on
-    // startup (or ever).
-    if(on_startup) {
-      cout << bhv->getDescriptor() << endl;
-      bhv->onHelmStart();
+//------------------------------------------------------------
+// Procedure: spawnBehaviorFromSpec()
+//   Purpose: Build a new behavior for the templated spec at the
+//            given index, for the given spawning UPDATES string.
+//      Note: On the first spawning from a spec, the spec is built
+//            once, without updates, as a prototype. Later spawnings
+//            clone the prototype and apply only the updates. Specs
+//            for behaviors that do not support clone() are built
+//            in full on each spawning, as are all specs if spawn
+//            prototypes are disabled.
+
+SpecBuild BehaviorSet::spawnBehaviorFromSpec(unsigned int spec_ix,
+					     string update_str)
+{
+  if(spec_ix >= m_behavior_specs.size())
+    return(SpecBuild());
+  
+  BehaviorSpec& spec = m_behavior_specs[spec_ix];
+  if(!m_spawn_prototypes)
+    return(buildBehaviorFromSpec(spec, update_str));
+
+  // Part 1: Build the prototype if not yet attempted
+  if(m_prototypes.count(spec_ix) == 0) {
+    SpecBuild pbuild = buildBehaviorFromSpec(spec);
+    if(pbuild.valid()) {
+      IvPBehavior *test = pbuild.getIvPBehavior()->clone();
+      if(test)
+	delete(test);
+      else
+	pbuild.deleteBehavior();
     }
-    // The behavior may now have some messages (var-data pairs) ready
-    // for retrieval
+    m_prototypes[spec_ix] = pbuild;
   }
-  else {
+
+  SpecBuild& pbuild = m_prototypes[spec_ix];
+  if(!pbuild.valid())
+    return(buildBehaviorFromSpec(spec, update_str));
+
+  // Part 2: Clone the prototype and apply just the updates
+  SpecBuild sbuild;
+  sbuild.setBehaviorKind(pbuild.getBehaviorKind(), pbuild.getKindLine());
+  sbuild.setKindResult(pbuild.getKindResult());
+
+  IvPBehavior *bhv = pbuild.getIvPBehavior()->clone();
+  if(applySpawnUpdates(bhv, update_str, sbuild))
+    sbuild.setIvPBehavior(bhv);
+  else
     delete(bhv);
-  }
 
   return(sbuild);
 }
 
-
 //------------------------------------------------------------
 // Procedure: handlePossibleSpawnings()
 //   Purpose: Called typically once on each iteration of the helm
@@ -410,7 +484,7 @@ bool BehaviorSet::handlePossibleSpawnings()
       // name=blue would be applied to the previously spawned behavior.
 
       if((m_bhv_names.count(fullname)==0) && (m_bhv_names.count(update_name)==0)) {
-	SpecBuild sbuild = buildBehaviorFromSpec(m_behavior_specs[i], update_str);
+	SpecBuild sbuild = spawnBehaviorFromSpec(i, update_str);
 	m_behavior_specs[i].spawnTried();
 	//sbuild.print();
 
@@ -564,7 +638,10 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
   bhv->checkForUpdatedCommsPolicy();
   
   // Possible vals: "completed", "idle", "running"
-  new_activity_state = bhv->isRunnable();
+  {
+    HelmProfileTimer ptimer(m_profiler, "cond");
+    new_activity_state = bhv->isRunnable();
+  }
   
   // Invoke the onEveryState() function applicable in all situations
   bhv->onEveryState(new_activity_state);
@@ -592,7 +669,10 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
     }
     if((old_activity_state == "running") || (old_activity_state == "active"))
       bhv->onRunToIdleState();
-    bhv->onIdleState();
+    {
+      HelmProfileTimer ptimer(m_profiler, "idlestate");
+      bhv->onIdleState();
+    }
     bhv->updateStateDurations("idle");
   }
   
@@ -617,33 +697,39 @@ IvPFunction* BehaviorSet::produceOF(unsigned int ix,
     ipf_reuse = !need_to_run;
     bhv->noteLastRunCheck(need_to_run, getCurrTime());
 
-    if(need_to_run)
+    if(need_to_run) {
+      HelmProfileTimer ptimer(m_profiler, "runstate");
       ipf = bhv->onRunState();
-
-    // Step 2: If IvP function contains NaN components, report and abort
-    if(ipf && !ipf->freeOfNan()) {
-      bhv->postEMessage("NaN detected in IvP Function");
-      delete(ipf);
-      ipf = 0;
     }
-    // Step 3: If IvP function has non-positive priority, abort
-    if(ipf) {
-      pwt = ipf->getPWT();
-      pcs = ipf->getPDMap()->size();
-      if(pwt <= 0) {
+
+    // Steps 2-4 check, size and optionally serialize the new function
+    {
+      HelmProfileTimer ptimer(m_profiler, "build");
+      // Step 2: If IvP function contains NaN components, report and abort
+      if(ipf && !ipf->freeOfNan()) {
+	bhv->postEMessage("NaN detected in IvP Function");
 	delete(ipf);
 	ipf = 0;
-	pcs = 0;
       }
-    }
-    // Step 4: If we're serializing and posting IvP functions, do here
-    if(ipf && m_report_ipf) {
-      string desc_str = bhv->getDescriptor();
-      string iter_str = uintToString(iteration);
-      string ctxt_str = iter_str + ":" + desc_str;
-      ipf->setContextStr(ctxt_str);
-      string ipf_str = IvPFunctionToString(ipf);
-      bhv->postMessage("BHV_IPF", ipf_str);
+      // Step 3: If IvP function has non-positive priority, abort
+      if(ipf) {
+	pwt = ipf->getPWT();
+	pcs = ipf->getPDMap()->size();
+	if(pwt <= 0) {
+	  delete(ipf);
+	  ipf = 0;
+	  pcs = 0;
+	}
+      }
+      // Step 4: If we're serializing and posting IvP functions, do here
+      if(ipf && m_report_ipf) {
+	string desc_str = bhv->getDescriptor();
+	string iter_str = uintToString(iteration);
+	string ctxt_str = iter_str + ":" + desc_str;
+	ipf->setContextStr(ctxt_str);
+	string ipf_str = IvPFunctionToString(ipf);
+	bhv->postMessage("BHV_IPF", ipf_str);
+      }
     }
     // Step 5: Handle normal case of healthy IvP function returned
     if(ipf) {
@@ -27,6 +27,7 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <map>
 #include "IvPBehavior.h"
 #include "IvPDomain.h"
 #include "VarDataPair.h"
@@ -38,6 +39,7 @@
 #include "BFactoryDynamic.h"
 #include "BehaviorSetEntry.h"
 #include "LifeEvent.h"
+#include "HelmProfiler.h"
 
 class IvPFunction;
 class BehaviorSet
@@ -53,6 +55,8 @@ public:
   bool       buildBehaviorsFromSpecs();
   SpecBuild  buildBehaviorFromSpec(BehaviorSpec spec, std::string s="",
 				   bool on_startup=false);
+  SpecBuild  spawnBehaviorFromSpec(unsigned int spec_ix,
+				   std::string update_str);
   bool       handlePossibleSpawnings();
   bool       refreshMapUpdateVars();
   
@@ -65,12 +69,14 @@ public:
   void   setCurrTime(double v)          {m_curr_time = v;}
   double getCurrTime()                  {return(m_curr_time);}
   void   setModeSet(ModeSet v)          {m_mode_set = v;}
+  void   setSpawnPrototypes(bool v)     {m_spawn_prototypes = v;}
 
   unsigned int getTCount()              {return(m_total_behaviors_ever);}
   
   unsigned int size()                   {return(m_bhv_entry.size());}
 
   void         setReportIPF(bool v)     {m_report_ipf=v;}
+  void         setProfiler(HelmProfiler *p) {m_profiler=p;}
   bool         stateOK(unsigned int);
   void         resetStateOK();
   IvPFunction* produceOF(unsigned int ix, unsigned int iter, 
@@ -135,6 +141,10 @@ public:
 
   unsigned long int size() const;
   
+protected:
+  bool       applySpawnUpdates(IvPBehavior*, std::string update_str,
+			       SpecBuild&);
+
 protected:
   std::vector<BehaviorSetEntry> m_bhv_entry;
   std::set<std::string>         m_bhv_names;
@@ -149,6 +159,11 @@ protected:
   std::vector<std::string>      m_warnings;
 
   std::vector<BehaviorSpec>     m_behavior_specs;
+
+  // Prototype builds of templated specs, keyed on spec index. A
+  // build with no behavior means the spec cannot be cloned.
+  std::map<unsigned int, SpecBuild> m_prototypes;
+  bool                          m_spawn_prototypes;
   
   BFactoryStatic                m_bfactory_static;
   BFactoryDynamic               m_bfactory_dynamic;
@@ -163,6 +178,9 @@ protected:
 
   bool    m_report_ipf;
   double  m_curr_time;
+
+  // Optional, owned by the helm engine, for timing produceOF() stages
+  HelmProfiler *m_profiler;
   bool    m_completed_pending;
 
   ModeSet m_mode_set;
@@ -0,0 +1,358 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmProfiler.cpp                                     */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+#include "HelmProfiler.h"
+#include "MBUtils.h"
+
+using namespace std;
+
+//-----------------------------------------------------------
+// Procedure: Constructor
+
+HelmProfiler::HelmProfiler()
+{
+  m_enabled   = false;
+  m_window    = 100;
+  m_iteration = 0;
+}
+
+//-----------------------------------------------------------
+// Procedure: setWindow()
+//   Purpose: Set the number of most recent iterations retained for
+//            each stage and behavior. Existing windows are trimmed.
+
+bool HelmProfiler::setWindow(unsigned int window)
+{
+  if(window == 0)
+    return(false);
+  m_window = window;
+
+  map<string, deque<double> >::iterator p;
+  for(p=m_stage_samples.begin(); p!=m_stage_samples.end(); p++) {
+    while(p->second.size() > m_window)
+      p->second.pop_front();
+  }
+  for(p=m_bhv_samples.begin(); p!=m_bhv_samples.end(); p++) {
+    while(p->second.size() > m_window)
+      p->second.pop_front();
+  }
+  return(true);
+}
+
+//-----------------------------------------------------------
+// Procedure: clear()
+
+void HelmProfiler::clear()
+{
+  m_iteration = 0;
+  m_stage_curr.clear();
+  m_bhv_curr.clear();
+  m_bhv_curr_pcs.clear();
+  m_stage_order.clear();
+  m_stage_samples.clear();
+  m_bhv_samples.clear();
+  m_bhv_pcs.clear();
+  m_bhv_last_iter.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: beginIteration()
+//      Note: Times accumulated since the last endIteration() are
+//            kept. Stages timed by the app after the engine is done,
+//            e.g., posting the decision, are folded in with the next
+//            iteration.
+
+void HelmProfiler::beginIteration(unsigned int iter)
+{
+  m_iteration = iter;
+}
+
+//-----------------------------------------------------------
+// Procedure: addStageTime()
+
+void HelmProfiler::addStageTime(const string& stage, double secs)
+{
+  if(!m_enabled)
+    return;
+
+  if(m_stage_curr.count(stage) == 0) {
+    m_stage_curr[stage] = 0;
+    if(!vectorContains(m_stage_order, stage))
+      m_stage_order.push_back(stage);
+  }
+  m_stage_curr[stage] += secs;
+}
+
+//-----------------------------------------------------------
+// Procedure: addBehaviorTime()
+
+void HelmProfiler::addBehaviorTime(const string& bhv, double secs,
+				   unsigned int pcs)
+{
+  if(!m_enabled)
+    return;
+
+  m_bhv_curr[bhv] += secs;
+  m_bhv_curr_pcs[bhv] += pcs;
+}
+
+//-----------------------------------------------------------
+// Procedure: endIteration()
+//   Purpose: Fold the times accumulated over this iteration into
+//            the sample windows. Behaviors not heard from in a full
+//            window of iterations (e.g., a spawned behavior that has
+//            since died) are dropped.
+
+void HelmProfiler::endIteration()
+{
+  if(!m_enabled)
+    return;
+
+  map<string, double>::iterator p;
+  for(p=m_stage_curr.begin(); p!=m_stage_curr.end(); p++)
+    addSample(m_stage_samples[p->first], p->second);
+
+  for(p=m_bhv_curr.begin(); p!=m_bhv_curr.end(); p++) {
+    string bhv = p->first;
+    addSample(m_bhv_samples[bhv], p->second);
+    m_bhv_pcs[bhv] = m_bhv_curr_pcs[bhv];
+    m_bhv_last_iter[bhv] = m_iteration;
+  }
+
+  vector<string> stale;
+  map<string, unsigned int>::iterator q;
+  for(q=m_bhv_last_iter.begin(); q!=m_bhv_last_iter.end(); q++) {
+    if((m_iteration - q->second) > m_window)
+      stale.push_back(q->first);
+  }
+  for(unsigned int i=0; i<stale.size(); i++) {
+    m_bhv_samples.erase(stale[i]);
+    m_bhv_pcs.erase(stale[i]);
+    m_bhv_last_iter.erase(stale[i]);
+  }
+
+  m_stage_curr.clear();
+  m_bhv_curr.clear();
+  m_bhv_curr_pcs.clear();
+}
+
+//-----------------------------------------------------------
+// Procedure: getStageSamples()
+
+unsigned int HelmProfiler::getStageSamples(const string& stage) const
+{
+  map<string, deque<double> >::const_iterator p;
+  p = m_stage_samples.find(stage);
+  if(p == m_stage_samples.end())
+    return(0);
+  return(p->second.size());
+}
+
+//-----------------------------------------------------------
+// Procedure: getBehaviorSamples()
+
+unsigned int HelmProfiler::getBehaviorSamples(const string& bhv) const
+{
+  map<string, deque<double> >::const_iterator p;
+  p = m_bhv_samples.find(bhv);
+  if(p == m_bhv_samples.end())
+    return(0);
+  return(p->second.size());
+}
+
+//-----------------------------------------------------------
+// Procedure: getStagePercentile()
+
+double HelmProfiler::getStagePercentile(const string& stage,
+					double pct) const
+{
+  map<string, deque<double> >::const_iterator p;
+  p = m_stage_samples.find(stage);
+  if(p == m_stage_samples.end())
+    return(0);
+  vector<double> samples(p->second.begin(), p->second.end());
+  return(getPercentile(samples, pct));
+}
+
+//-----------------------------------------------------------
+// Procedure: getBehaviorPercentile()
+
+double HelmProfiler::getBehaviorPercentile(const string& bhv,
+					   double pct) const
+{
+  map<string, deque<double> >::const_iterator p;
+  p = m_bhv_samples.find(bhv);
+  if(p == m_bhv_samples.end())
+    return(0);
+  vector<double> samples(p->second.begin(), p->second.end());
+  return(getPercentile(samples, pct));
+}
+
+//-----------------------------------------------------------
+// Procedure: getSpec()
+//   Example: iter=480,win=100 # stage=total,n=100,p50=1.21,p90=2.05,
+//            max=3.3 # stage=create,n=100,p50=... # bhv=avd_henry,
+//            n=100,p50=0.43,p90=0.61,max=0.9,pcs=120
+//      Note: Times are in milliseconds. Stages are listed in the
+//            order first seen. Behaviors are listed in order of
+//            decreasing p90.
+
+string HelmProfiler::getSpec() const
+{
+  string spec = "iter=" + uintToString(m_iteration);
+  spec += ",win=" + uintToString(m_window);
+
+  for(unsigned int i=0; i<m_stage_order.size(); i++) {
+    string stage = m_stage_order[i];
+    map<string, deque<double> >::const_iterator p;
+    p = m_stage_samples.find(stage);
+    if(p != m_stage_samples.end())
+      spec += " # stage=" + stage + "," + sampleSpec(p->second);
+  }
+
+  vector<pair<double, string> > bhvs;
+  map<string, deque<double> >::const_iterator p;
+  for(p=m_bhv_samples.begin(); p!=m_bhv_samples.end(); p++)
+    bhvs.push_back(make_pair(-getBehaviorPercentile(p->first, 90),
+			     p->first));
+  sort(bhvs.begin(), bhvs.end());
+
+  for(unsigned int i=0; i<bhvs.size(); i++) {
+    string bhv = bhvs[i].second;
+    unsigned int pcs = 0;
+    map<string, unsigned int>::const_iterator q = m_bhv_pcs.find(bhv);
+    if(q != m_bhv_pcs.end())
+      pcs = q->second;
+    spec += " # bhv=" + bhv + ",";
+    spec += sampleSpec(m_bhv_samples.find(bhv)->second);
+    spec += ",pcs=" + uintToString(pcs);
+  }
+
+  return(spec);
+}
+
+//-----------------------------------------------------------
+// Procedure: getWallTime()
+//   Purpose: Wall time in seconds with sub-millisecond resolution.
+//            The MBTimer clock ticks are too coarse for timing 
+//            individual behaviors.
+
+double HelmProfiler::getWallTime()
+{
+#ifndef _WIN32
+  struct timeval tval;
+  if(gettimeofday(&tval, NULL) != 0)
+    return(0);
+  return((double)(tval.tv_sec) + ((double)(tval.tv_usec) / 1000000.0));
+#else
+  return((double)(clock()) / CLOCKS_PER_SEC);
+#endif
+}
+
+//-----------------------------------------------------------
+// Procedure: getPercentile()
+//   Purpose: Nearest-rank percentile of the given samples. The
+//            0th percentile is the min, the 100th is the max.
+
+double HelmProfiler::getPercentile(vector<double> samples, double pct)
+{
+  if(samples.size() == 0)
+    return(0);
+  if(pct < 0)
+    pct = 0;
+  if(pct > 100)
+    pct = 100;
+
+  unsigned int n = samples.size();
+  unsigned int rank = (unsigned int)(ceil((pct / 100.0) * n));
+  if(rank > 0)
+    rank--;
+  if(rank >= n)
+    rank = n-1;
+
+  nth_element(samples.begin(), samples.begin()+rank, samples.end());
+  return(samples[rank]);
+}
+
+//-----------------------------------------------------------
+// Procedure: addSample()
+
+void HelmProfiler::addSample(deque<double>& samples, double val)
+{
+  samples.push_back(val);
+  while(samples.size() > m_window)
+    samples.pop_front();
+}
+
+//-----------------------------------------------------------
+// Procedure: sampleSpec()
+//   Example: n=100,p50=0.43,p90=0.61,max=0.9   (milliseconds)
+
+string HelmProfiler::sampleSpec(const deque<double>& samples) const
+{
+  vector<double> svals(samples.begin(), samples.end());
+  double p50 = getPercentile(svals, 50) * 1000;
+  double p90 = getPercentile(svals, 90) * 1000;
+  double pmx = getPercentile(svals, 100) * 1000;
+
+  string spec = "n=" + uintToString(svals.size());
+  spec += ",p50=" + doubleToStringX(p50, 3);
+  spec += ",p90=" + doubleToStringX(p90, 3);
+  spec += ",max=" + doubleToStringX(pmx, 3);
+  return(spec);
+}
+
+//-----------------------------------------------------------
+// Procedure: HelmProfileTimer Constructor
+
+HelmProfileTimer::HelmProfileTimer(HelmProfiler *profiler,
+				   const string& stage)
+{
+  m_profiler   = 0;
+  m_start_time = 0;
+  if(profiler && profiler->isEnabled()) {
+    m_profiler   = profiler;
+    m_stage      = stage;
+    // Noted on entry so nested stages are listed after their parent
+    m_profiler->addStageTime(m_stage, 0);
+    m_start_time = HelmProfiler::getWallTime();
+  }
+}
+
+//-----------------------------------------------------------
+// Procedure: HelmProfileTimer Destructor
+
+HelmProfileTimer::~HelmProfileTimer()
+{
+  if(!m_profiler)
+    return;
+  double elapsed = HelmProfiler::getWallTime() - m_start_time;
+  m_profiler->addStageTime(m_stage, elapsed);
+}
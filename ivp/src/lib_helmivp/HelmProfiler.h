@@ -0,0 +1,112 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: HelmProfiler.h                                       */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef HELM_PROFILER_HEADER
+#define HELM_PROFILER_HEADER
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <string>
+
+//-------------------------------------------------------------------
+// HelmProfiler: Wall-clock timing of each helm iteration, broken out
+// by engine stage (spawn, create, solve, ...) and by behavior. The
+// most recent N iterations are retained per key so percentiles can
+// be reported rather than a single (noisy) last-iteration value or
+// an all-time max. Stage times within one iteration are accumulated,
+// since a stage may run twice when filter behaviors are present, and
+// since the cond, runstate, idlestate and build stages within the
+// create stage are timed once per behavior.
+
+class HelmProfiler {
+public:
+  HelmProfiler();
+  ~HelmProfiler() {}
+
+  void   setEnabled(bool v=true) {m_enabled=v;}
+  bool   setWindow(unsigned int);
+  void   clear();
+
+  void   beginIteration(unsigned int iter);
+  void   addStageTime(const std::string& stage, double secs);
+  void   addBehaviorTime(const std::string& bhv, double secs,
+			 unsigned int pcs);
+  void   endIteration();
+
+  bool         isEnabled() const {return(m_enabled);}
+  unsigned int getWindow() const {return(m_window);}
+  unsigned int getIteration() const {return(m_iteration);}
+
+  unsigned int getStageSamples(const std::string&) const;
+  unsigned int getBehaviorSamples(const std::string&) const;
+
+  double getStagePercentile(const std::string&, double pct) const;
+  double getBehaviorPercentile(const std::string&, double pct) const;
+
+  std::string getSpec() const;
+
+  static double getWallTime();
+  static double getPercentile(std::vector<double> samples, double pct);
+
+protected:
+  void addSample(std::deque<double>&, double);
+  std::string sampleSpec(const std::deque<double>&) const;
+
+private: // Configuration variables
+  bool          m_enabled;
+  unsigned int  m_window;
+
+private: // State variables
+  unsigned int  m_iteration;
+
+  // Accumulated times for the iteration in progress
+  std::map<std::string, double>        m_stage_curr;
+  std::map<std::string, double>        m_bhv_curr;
+  std::map<std::string, unsigned int>  m_bhv_curr_pcs;
+
+  // Windows of per-iteration samples, in seconds
+  std::vector<std::string>                    m_stage_order;
+  std::map<std::string, std::deque<double> >  m_stage_samples;
+  std::map<std::string, std::deque<double> >  m_bhv_samples;
+  std::map<std::string, unsigned int>         m_bhv_pcs;
+  std::map<std::string, unsigned int>         m_bhv_last_iter;
+};
+
+//-------------------------------------------------------------------
+// HelmProfileTimer: Scoped timer adding the elapsed wall time of the
+// enclosing block to the given stage of a profiler. A null or
+// disabled profiler makes this a no-op.
+
+class HelmProfileTimer {
+public:
+  HelmProfileTimer(HelmProfiler*, const std::string& stage);
+  ~HelmProfileTimer();
+
+private:
+  HelmProfiler *m_profiler;
+  std::string   m_stage;
+  double        m_start_time;
+};
+
+#endif
@@ -52,6 +52,8 @@ void HelmReport::initialize()
   m_max_create_time = 0;
   m_max_solve_time  = 0;
   m_max_loop_time   = 0;
+  m_spawn_time      = 0;
+  m_max_spawn_time  = 0;
 
   m_total_pcs_formed = 0;
   m_total_pcs_cached = 0;
@@ -479,6 +481,11 @@ string HelmReport::getReportAsString(const HelmReport& prep, bool full) const
   if(full || (m_max_loop_time != prep.getMaxLoopTime()))
     report += (",max_loop_time=" + doubleToString(m_max_loop_time, 2));
 
+  if(full || (m_spawn_time != prep.getSpawnTime()))
+    report += (",spawn_time=" + doubleToString(m_spawn_time, 2));
+  if(full || (m_max_spawn_time != prep.getMaxSpawnTime()))
+    report += (",max_spawn_time=" + doubleToString(m_max_spawn_time, 2));
+
   double loop_time = m_create_time + m_solve_time;
   if(full || (loop_time != prep.getLoopTime()))
     report += (",loop_time=" + doubleToString(loop_time, 2));
@@ -618,6 +625,10 @@ list<string> HelmReport::formattedSummary(double curr_time, bool verbose) const
   str += "   (max=" + doubleToString(m_max_create_time,2) + ")";
   rlist.push_back(str);
 
+  str =  "  SpawnTime:   " + doubleToString(m_spawn_time,2);
+  str += "   (max=" + doubleToString(m_max_spawn_time,2) + ")";
+  rlist.push_back(str);
+
   str =  "  LoopTime:    " + doubleToString(getLoopTime(),2);
   str += "   (max=" + doubleToString(m_max_loop_time,2) + ")";
   rlist.push_back(str);
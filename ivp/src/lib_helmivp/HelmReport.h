@@ -75,6 +75,8 @@ public:
   void  setMaxLoopTime(double t)             {m_max_loop_time=t;}
   void  setMaxCreateTime(double t)           {m_max_create_time=t;}
   void  setMaxSolveTime(double t)            {m_max_solve_time=t;}
+  void  setSpawnTime(double t)               {m_spawn_time=t;}
+  void  setMaxSpawnTime(double t)            {m_max_spawn_time=t;}
 
   void  clearDecisions();
   void  addDecision(const std::string &var, double val);
@@ -94,6 +96,8 @@ public:
   double       getMaxLoopTime() const {return(m_max_loop_time);}
   double       getMaxSolveTime()  const {return(m_max_solve_time);}
   double       getMaxCreateTime() const {return(m_max_create_time);}
+  double       getSpawnTime()     const {return(m_spawn_time);}
+  double       getMaxSpawnTime()  const {return(m_max_spawn_time);}
 
   double       getDecision(const std::string&) const;
   bool         hasDecision(const std::string&) const;
@@ -175,6 +179,10 @@ protected:
   double        m_max_solve_time;
   double        m_max_loop_time;
 
+  // Time spent spawning new behaviors on this iteration
+  double        m_spawn_time;
+  double        m_max_spawn_time;
+
   IvPDomain     m_domain;          // referenced for varbalk info
 };
 
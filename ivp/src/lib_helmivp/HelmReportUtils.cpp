@@ -95,6 +95,10 @@ HelmReport string2HelmReport(const string& str,
       report.setMaxSolveTime(atof(right.c_str()));
     else if(left == "max_loop_time")
       report.setMaxLoopTime(atof(right.c_str()));
+    else if(left == "spawn_time")
+      report.setSpawnTime(atof(right.c_str()));
+    else if(left == "max_spawn_time")
+      report.setMaxSpawnTime(atof(right.c_str()));
 
     else if(left == "utc_time")
       report.setTimeUTC(atof(right.c_str()));
@@ -61,6 +61,18 @@ void ModeEntry::setVarVal(const string& var, double val)
     m_logic_conditions[i].setVarVal(var, val);
 }
 
+//------------------------------------------------------------------
+// Procedure: updateFromBuffer
+//      Note: Each condition pulls its own variables from the buffer,
+//            re-reading only those posted since its last pull.
+
+void ModeEntry::updateFromBuffer(const InfoBuffer* info_buffer)
+{
+  unsigned int i, vsize = m_logic_conditions.size();
+  for(i=0; i<vsize; i++)
+    m_logic_conditions[i].updateFromBuffer(info_buffer);
+}
+
 //------------------------------------------------------------------
 // Procedure: evalConditions
 //      Note: This function will evaluate each of the logic conditions
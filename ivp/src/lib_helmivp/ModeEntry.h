@@ -52,6 +52,7 @@ public:
   void clearConditionVarVals();
   void setVarVal(const std::string&, const std::string&);
   void setVarVal(const std::string&, double);
+  void updateFromBuffer(const InfoBuffer*);
 
   bool evalConditions();
   bool evalModeVarConditions();
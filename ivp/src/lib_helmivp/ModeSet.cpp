@@ -225,24 +225,14 @@ string ModeSet::getStringDescription()
 
 void ModeSet::consultFromInfoBuffer()
 {
-  unsigned int j, esize = m_entries.size();
-
-  vector<string> all_vars = getConditionVars();
-  unsigned int i, vsize = all_vars.size();
-  for(i=0; i<vsize; i++) {
-    string varname = all_vars[i];
-    bool   ok_s, ok_d;
-    string s_result = m_info_buffer->sQuery(varname, ok_s);
-    double d_result = m_info_buffer->dQuery(varname, ok_d);
-
-    for(j=0; ((j<esize) && (ok_s)); j++)
-      m_entries[j].setVarVal(varname, s_result);
-
-    for(j=0; ((j<esize) && (ok_d)); j++)
-      m_entries[j].setVarVal(varname, d_result);    
-  }
+  if(!m_info_buffer)
+    return;
 
+  unsigned int i, esize = m_entries.size();
+  for(i=0; i<esize; i++)
+    m_entries[i].updateFromBuffer(m_info_buffer);
 }
+
 //------------------------------------------------------------------
 // Procedure: updateInfoBuffer
 //      Note: For each of the VarDataPairs stored locally in the member
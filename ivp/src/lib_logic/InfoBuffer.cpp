@@ -28,51 +28,129 @@
 #endif
 
 #include <iostream>
+#include <cstdlib>
 #include "InfoBuffer.h"
 #include "MBUtils.h"
 
 using namespace std;
 
+//-----------------------------------------------------------
+// Procedure: getSlot()
+//   Purpose: Resolve a variable name to its slot index, creating
+//            an (unknown) slot if the variable has not been seen.
+//      Note: Const by choice, with the slot table mutable. See the
+//            note on the slot interface in InfoBuffer.h.
+
+unsigned int InfoBuffer::getSlot(const string& var) const
+{
+  map<string, unsigned int>::const_iterator p = m_slot_map.find(var);
+  if(p != m_slot_map.end())
+    return(p->second);
+
+  unsigned int slot = m_slots.size();
+  m_slots.push_back(InfoBufferSlot());
+  m_slots[slot].var = var;
+  m_slot_map[var] = slot;
+  return(slot);
+}
+
+//-----------------------------------------------------------
+// Procedure: getSlotVar()
+
+string InfoBuffer::getSlotVar(unsigned int slot) const
+{
+  if(slot >= m_slots.size())
+    return("");
+  return(m_slots[slot].var);
+}
+
+//-----------------------------------------------------------
+// Procedure: getSlotWrites()
+//   Purpose: Number of times the slot has been written. A reader
+//            may compare against a previous count to tell if the
+//            variable has been posted since it last looked.
+
+unsigned int InfoBuffer::getSlotWrites(unsigned int slot) const
+{
+  if(slot >= m_slots.size())
+    return(0);
+  return(m_slots[slot].writes);
+}
+
+//-----------------------------------------------------------
+// Procedure: findSlot()
+//   Purpose: Find the slot of a variable without creating one.
+
+bool InfoBuffer::findSlot(const string& var, unsigned int& slot) const
+{
+  map<string, unsigned int>::const_iterator p = m_slot_map.find(var);
+  if(p == m_slot_map.end())
+    return(false);
+  slot = p->second;
+  return(true);
+}
+
 //-----------------------------------------------------------
 // Procedure: dQuery()
 
 double InfoBuffer::dQuery(string var, bool& result) const
 {
-  map<string, double>::const_iterator p2;
-  p2 = dmap.find(var);
-  if(p2 != dmap.end()) {
+  unsigned int slot;
+  if(findSlot(var, slot) && m_slots[slot].dval_set) {
     result = true;
-    return(p2->second);
+    return(m_slots[slot].dval);
   }
+  return(deltaQuery(var, result));
+}
+
+//-----------------------------------------------------------
+// Procedure: dQuery()
+
+double InfoBuffer::dQuery(unsigned int slot, bool& result) const
+{
+  if(slot >= m_slots.size()) {
+    result = false;
+    return(0.0);
+  }
+  if(m_slots[slot].dval_set) {
+    result = true;
+    return(m_slots[slot].dval);
+  }
+  return(deltaQuery(m_slots[slot].var, result));
+}
 
+//-----------------------------------------------------------
+// Procedure: deltaQuery()
+
+double InfoBuffer::deltaQuery(const string& given_var, bool& result) const
+{
   // Added by mikerb Apr 9th, 2021.  For vars ending in _DELTA, for
   // example MARK_DELTA. If MARK_DELTA is not known to the InfoBuffer,
   // then check if MARK is known, and treat it as a UTC
   // timestamp. Then return delta time since that time stamp as the
   // value of MARK_DELTA.
+  string var = given_var;
+  unsigned int slot;
   if(strEnds(var, "_DELTA") && (var.length() > 6)) {
     rbiteString(var, '_');
-    // Handle case if the base variable is of type double
-    map<string, double>::const_iterator p = dmap.find(var);
-    if(p != dmap.end()) {
-      result = true;
-      double var_utc = p->second;
-      double delta = m_curr_time_utc - var_utc;
-      //cout << " delta: " << delta << endl;
-      return(delta);
-    }
-    
-    // Handle case if the base variable is of type string
-    map<string, string>::const_iterator q = smap.find(var);
-    if(q != smap.end()) {
-      string sval = q->second;
-      if(isNumber(sval)) {
-	double var_utc = atof(sval.c_str());
-	double delta = m_curr_time_utc - var_utc;
-	//cout << " delta: " << delta << endl;
+    if(findSlot(var, slot)) {
+      // Handle case if the base variable is of type double
+      if(m_slots[slot].dval_set) {
 	result = true;
+	double var_utc = m_slots[slot].dval;
+	double delta = m_curr_time_utc - var_utc;
 	return(delta);
       }
+      // Handle case if the base variable is of type string
+      if(m_slots[slot].sval_set) {
+	string sval = m_slots[slot].sval;
+	if(isNumber(sval)) {
+	  double var_utc = atof(sval.c_str());
+	  double delta = m_curr_time_utc - var_utc;
+	  result = true;
+	  return(delta);
+	}
+      }
     }
   }
   
@@ -88,16 +166,22 @@ double InfoBuffer::dQuery(string var, bool& result) const
 
 double InfoBuffer::tQuery(string var, bool elapsed) const
 {
-  map<string, double>::const_iterator p2;
-  p2 = tmap.find(var);
-  if(p2 != tmap.end()) {
-    if(elapsed)
-      return(m_curr_time_utc - p2->second);
-    else
-      return(p2->second);
-  }
-  else
+  unsigned int slot;
+  if(!findSlot(var, slot))
     return(-1);
+  return(tQuery(slot, elapsed));
+}
+
+//-----------------------------------------------------------
+// Procedure: tQuery()
+
+double InfoBuffer::tQuery(unsigned int slot, bool elapsed) const
+{
+  if((slot >= m_slots.size()) || !m_slots[slot].known)
+    return(-1);
+  if(elapsed)
+    return(m_curr_time_utc - m_slots[slot].tval);
+  return(m_slots[slot].tval);
 }
 
 //-----------------------------------------------------------
@@ -107,16 +191,22 @@ double InfoBuffer::tQuery(string var, bool elapsed) const
 
 double InfoBuffer::mtQuery(string var, bool elapsed) const
 {
-  map<string, double>::const_iterator p;
-  p = mtmap.find(var);
-  if(p != mtmap.end()) {
-    if(elapsed)
-      return(m_curr_time_utc - p->second);
-    else
-      return(p->second);
-  }
-  else
+  unsigned int slot;
+  if(!findSlot(var, slot))
     return(-1);
+  return(mtQuery(slot, elapsed));
+}
+
+//-----------------------------------------------------------
+// Procedure: mtQuery()
+
+double InfoBuffer::mtQuery(unsigned int slot, bool elapsed) const
+{
+  if((slot >= m_slots.size()) || !m_slots[slot].known)
+    return(-1);
+  if(elapsed)
+    return(m_curr_time_utc - m_slots[slot].mtval);
+  return(m_slots[slot].mtval);
 }
 
 //-----------------------------------------------------------
@@ -124,16 +214,25 @@ double InfoBuffer::mtQuery(string var, bool elapsed) const
 
 string InfoBuffer::sQuery(string var, bool& result) const
 {
-  map<string, string>::const_iterator p2;
-  p2 = smap.find(var);
-  if(p2 != smap.end()) {
-    result = true;
-    return(p2->second);
+  unsigned int slot;
+  if(!findSlot(var, slot)) {
+    result = false;
+    return("");
   }
-  
-  // If all fails, return empty string and indicate failure.
-  result = false;
-  return("");
+  return(sQuery(slot, result));
+}
+
+//-----------------------------------------------------------
+// Procedure: sQuery()
+
+string InfoBuffer::sQuery(unsigned int slot, bool& result) const
+{
+  if((slot >= m_slots.size()) || !m_slots[slot].sval_set) {
+    result = false;
+    return("");
+  }
+  result = true;
+  return(m_slots[slot].sval);
 }
 
 //-----------------------------------------------------------
@@ -141,20 +240,26 @@ string InfoBuffer::sQuery(string var, bool& result) const
 
 vector<string> InfoBuffer::sQueryDeltas(string var, bool& result) const
 {
-  // Have an empty vector handy for returning any kind of failure
-  vector<string> empty_vector;
-  
-  // Find the vector associated with the given variable name
-  map<string, vector<string> >::const_iterator p2;
-  p2 = vsmap.find(var);
-  if(p2 != vsmap.end()) {
-    result = true;
-    return(p2->second);
+  unsigned int slot;
+  if(!findSlot(var, slot)) {
+    result = false;
+    return(vector<string>());
   }
-  
-  // If all fails, return empty vector and indicate failure.
-  result = false;
-  return(empty_vector);
+  return(sQueryDeltas(slot, result));
+}
+
+//-----------------------------------------------------------
+// Procedure: sQueryDeltas()
+
+vector<string> InfoBuffer::sQueryDeltas(unsigned int slot,
+					bool& result) const
+{
+  if((slot >= m_slots.size()) || !m_slots[slot].sdeltas_set) {
+    result = false;
+    return(vector<string>());
+  }
+  result = true;
+  return(m_slots[slot].sdeltas);
 }
 
 //-----------------------------------------------------------
@@ -162,20 +267,26 @@ vector<string> InfoBuffer::sQueryDeltas(string var, bool& result) const
 
 vector<double> InfoBuffer::dQueryDeltas(string var, bool& result) const
 {
-  // Have an empty vector handy for returning any kind of failure
-  vector<double> empty_vector;
-  
-  // Find the vector associated with the given variable name
-  map<string, vector<double> >::const_iterator p2;
-  p2 = vdmap.find(var);
-  if(p2 != vdmap.end()) {
-    result = true;
-    return(p2->second);
+  unsigned int slot;
+  if(!findSlot(var, slot)) {
+    result = false;
+    return(vector<double>());
   }
-  
-  // If all fails, return empty vector and indicate failure.
-  result = false;
-  return(empty_vector);
+  return(dQueryDeltas(slot, result));
+}
+
+//-----------------------------------------------------------
+// Procedure: dQueryDeltas()
+
+vector<double> InfoBuffer::dQueryDeltas(unsigned int slot,
+					bool& result) const
+{
+  if((slot >= m_slots.size()) || !m_slots[slot].ddeltas_set) {
+    result = false;
+    return(vector<double>());
+  }
+  result = true;
+  return(m_slots[slot].ddeltas);
 }
 
 //-----------------------------------------------------------
@@ -187,11 +298,20 @@ vector<double> InfoBuffer::dQueryDeltas(string var, bool& result) const
               
 bool InfoBuffer::isKnown(string varname) const
 {
-  map<string, double>::const_iterator p=tmap.find(varname);
-  if(p != tmap.end())
-    return(true);
+  unsigned int slot;
+  if(!findSlot(varname, slot))
+    return(false);
+  return(m_slots[slot].known);
+}
+
+//-----------------------------------------------------------
+// Procedure: isKnown()
 
-  return(false);
+bool InfoBuffer::isKnown(unsigned int slot) const
+{
+  if(slot >= m_slots.size())
+    return(false);
+  return(m_slots[slot].known);
 }
 
 //-----------------------------------------------------------
@@ -199,23 +319,25 @@ bool InfoBuffer::isKnown(string varname) const
 //   Purpose: Get the total size of the info_buffer
 //      Note: This just counts elements, and not size of elements.
 //            For example, a string counts as "1" regardless of len. 
+//            Each known variable counts twice more for its update
+//            and message time stamps.
 
 unsigned long int InfoBuffer::size() const
 {
   unsigned long int total = 0;
-
-  total += smap.size();
-  total += dmap.size();
-  total += tmap.size();
-  total += mtmap.size();
-
-  map<string, vector<string> >::const_iterator p;
-  for(p=vsmap.begin(); p!= vsmap.end(); p++)
-    total += p->second.size();
-  map<string, vector<double> >::const_iterator q;
-  for(q=vdmap.begin(); q!= vdmap.end(); q++)
-    total += q->second.size();
-
+  for(unsigned int i=0; i<m_slots.size(); i++) {
+    const InfoBufferSlot& islot = m_slots[i];
+    if(islot.sval_set)
+      total++;
+    if(islot.dval_set)
+      total++;
+    if(islot.known)
+      total += 2;
+    if(islot.sdeltas_set)
+      total += islot.sdeltas.size();
+    if(islot.ddeltas_set)
+      total += islot.ddeltas.size();
+  }
   return(total);
 }
 
@@ -227,21 +349,7 @@ unsigned long int InfoBuffer::size() const
 
 unsigned long int InfoBuffer::sizeFull() const
 {
-  unsigned long int total = 0;
-
-  total += smap.size();
-  total += dmap.size();
-  total += tmap.size();
-  total += mtmap.size();
-
-  map<string, vector<string> >::const_iterator p;
-  for(p=vsmap.begin(); p!= vsmap.end(); p++)
-    total += p->second.size();
-  map<string, vector<double> >::const_iterator q;
-  for(q=vdmap.begin(); q!= vdmap.end(); q++)
-    total += q->second.size();
-
-  return(total);
+  return(size());
 }
 
 
@@ -253,8 +361,23 @@ unsigned long int InfoBuffer::sizeFull() const
 
 bool InfoBuffer::setValue(string var, double val, double msg_time)
 {
-  dmap[var] = val;
-  tmap[var] = m_curr_time_utc;
+  return(setValue(getSlot(var), val, msg_time));
+}
+
+//-----------------------------------------------------------
+// Procedure: setValue()
+
+bool InfoBuffer::setValue(unsigned int slot, double val, double msg_time)
+{
+  if(slot >= m_slots.size())
+    return(false);
+
+  InfoBufferSlot& islot = m_slots[slot];
+  islot.writes++;
+  islot.dval  = val;
+  islot.dval_set = true;
+  islot.tval  = m_curr_time_utc;
+  islot.known = true;
 
   // msg_time is the timestamp perhaps embedded in the incoming message, 
   // vs. the buffer update time (the time at which the info_buffer is 
@@ -262,9 +385,12 @@ bool InfoBuffer::setValue(string var, double val, double msg_time)
   // set it to the buffer update time.
   if(msg_time == 0)
     msg_time = m_curr_time_utc;
-  mtmap[var] = msg_time;
+  islot.mtval = msg_time;
 
-  vdmap[var].push_back(val);
+  if(!islot.sdeltas_set && !islot.ddeltas_set)
+    m_delta_slots.push_back(slot);
+  islot.ddeltas.push_back(val);
+  islot.ddeltas_set = true;
 
   return(true);
 }
@@ -274,29 +400,53 @@ bool InfoBuffer::setValue(string var, double val, double msg_time)
 
 bool InfoBuffer::setValue(string var, string val, double msg_time)
 {
-  smap[var] = val;
-  tmap[var] = m_curr_time_utc;
+  return(setValue(getSlot(var), val, msg_time));
+}
 
-  // msg_time is the timestamp perhaps embedded in the incoming message, 
-  // vs. the buffer update time (the time at which the info_buffer is 
-  // undergoing a round of updates. If msg_time is unspecified (0) then 
-  // set it to the buffer update time.
+//-----------------------------------------------------------
+// Procedure: setValue()
+
+bool InfoBuffer::setValue(unsigned int slot, const string& val,
+			  double msg_time)
+{
+  if(slot >= m_slots.size())
+    return(false);
+
+  InfoBufferSlot& islot = m_slots[slot];
+  islot.writes++;
+  islot.sval  = val;
+  islot.sval_set = true;
+  islot.tval  = m_curr_time_utc;
+  islot.known = true;
+
+  // See note above on msg_time
   if(msg_time == 0)
     msg_time = m_curr_time_utc;
-  mtmap[var] = msg_time;
+  islot.mtval = msg_time;
 
-  vsmap[var].push_back(val);
+  if(!islot.sdeltas_set && !islot.ddeltas_set)
+    m_delta_slots.push_back(slot);
+  islot.sdeltas.push_back(val);
+  islot.sdeltas_set = true;
 
   return(true);
 }
 
 //-----------------------------------------------------------
 // Procedure: clearDeltaVectors()
+//      Note: Only the slots posted to since the last clear are
+//            visited.
 
 void InfoBuffer::clearDeltaVectors()
 {
-  vsmap.clear();
-  vdmap.clear();
+  for(unsigned int i=0; i<m_delta_slots.size(); i++) {
+    InfoBufferSlot& islot = m_slots[m_delta_slots[i]];
+    islot.sdeltas.clear();
+    islot.ddeltas.clear();
+    islot.sdeltas_set = false;
+    islot.ddeltas_set = false;
+  }
+  m_delta_slots.clear();
 }
 
 //-----------------------------------------------------------
@@ -314,33 +464,35 @@ void InfoBuffer::print(string vars_str) const
   cout << "InfoBuffer: " << endl;
   cout << " curr_time_utc:" << m_curr_time_utc << endl;
   
+  map<string, unsigned int>::const_iterator p;
   cout << "-----------------------------------------------" << endl; 
   cout << " String Data: " << endl;
-  map<string, string>::const_iterator ps;
-  for(ps=smap.begin(); ps!=smap.end(); ps++) {
-    string var = ps->first;
-    string val = ps->second;
-    if((vars.size() == 0) || vectorContains(vars, var))
-      cout << "  " << var << ": " << val << endl;
+  for(p=m_slot_map.begin(); p!=m_slot_map.end(); p++) {
+    const InfoBufferSlot& islot = m_slots[p->second];
+    if(!islot.sval_set)
+      continue;
+    if((vars.size() == 0) || vectorContains(vars, islot.var))
+      cout << "  " << islot.var << ": " << islot.sval << endl;
   }
   
   cout << "-----------------------------------------------" << endl; 
   cout << " Numerical Data: " << endl;
-  map<string, double>::const_iterator pd;
-  for(pd=dmap.begin(); pd!=dmap.end(); pd++) {
-    string var = pd->first;
-    double val = pd->second;
-    if((vars.size() == 0) || vectorContains(vars, var))
-      cout << "  " << var << ": " << val << endl;
+  for(p=m_slot_map.begin(); p!=m_slot_map.end(); p++) {
+    const InfoBufferSlot& islot = m_slots[p->second];
+    if(!islot.dval_set)
+      continue;
+    if((vars.size() == 0) || vectorContains(vars, islot.var))
+      cout << "  " << islot.var << ": " << islot.dval << endl;
   }
 
   cout << "-----------------------------------------------" << endl; 
   cout << " Time Data: " << endl;
-  map<string, double>::const_iterator pt;
-  for(pt=tmap.begin(); pt!=tmap.end(); pt++) {
-    string var = pt->first;
-    if((vars.size() == 0) || vectorContains(vars, var))
-      cout << "  " << var << ": " << m_curr_time_utc - pt->second << endl;
+  for(p=m_slot_map.begin(); p!=m_slot_map.end(); p++) {
+    const InfoBufferSlot& islot = m_slots[p->second];
+    if(!islot.known)
+      continue;
+    if((vars.size() == 0) || vectorContains(vars, islot.var))
+      cout << "  " << islot.var << ": " << m_curr_time_utc - islot.tval << endl;
   }
 }
 
@@ -348,18 +500,20 @@ void InfoBuffer::print(string vars_str) const
 //-----------------------------------------------------------
 // Procedure: getReport()
 //   Purpose: Get an info_buffer report for all variables known
-//            to the info_buffer. Uses local tmap to get list of
+//            to the info_buffer. Uses the slot map to get list of
 //            known variables and then uses this set of vars to
 //            call the more general getReport() function
 
 vector<string> InfoBuffer::getReport(bool verbose) const
 {
-  // Since all variables, string or double, create a tmap entry,
-  // then use the tmap for an exhaustive list of all vars known.
+  // Slots may exist for vars resolved but never posted, so only
+  // include the known vars.
   vector<string> vars;
-  map<string,double>::const_iterator p;
-  for(p=tmap.begin(); p!=tmap.end(); p++) 
-    vars.push_back(p->first);
+  map<string, unsigned int>::const_iterator p;
+  for(p=m_slot_map.begin(); p!=m_slot_map.end(); p++) {
+    if(m_slots[p->second].known)
+      vars.push_back(p->first);
+  }
 
   return(getReport(vars, verbose));
 }
@@ -384,10 +538,12 @@ vector<string> InfoBuffer::getReport(vector<string> vars, bool verbose) const
     string line, val;
     string var = vars[i];
     line += padString(var, longest_var, true) + "  ";
-    if(dmap.count(var))
-      line += doubleToStringX(dmap.at(var),2);
-    else if(smap.count(var))
-      line += smap.at(var);
+    unsigned int slot;
+    bool found = findSlot(var, slot);
+    if(found && m_slots[slot].dval_set)
+      line += doubleToStringX(m_slots[slot].dval,2);
+    else if(found && m_slots[slot].sval_set)
+      line += m_slots[slot].sval;
     else
       line += "[---]";
     
@@ -396,4 +552,3 @@ vector<string> InfoBuffer::getReport(vector<string> vars, bool verbose) const
   
   return(report_lines);
 }
-
@@ -29,10 +29,44 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <climits>
+
+// Slot index standing for no slot, e.g., as resolved by a behavior
+// with no info buffer. It is rejected by every slot query.
+const unsigned int INFO_BUFFER_NO_SLOT = UINT_MAX;
+
+//-----------------------------------------------------------
+// All information held for one variable. A slot is created the
+// first time a variable is written or resolved with getSlot(),
+// and is never removed, so slot indices stay valid for the life
+// of the buffer.
+
+struct InfoBufferSlot {
+  InfoBufferSlot() {
+    dval=0; tval=0; mtval=0; sval_set=false; dval_set=false;
+    known=false; sdeltas_set=false; ddeltas_set=false; writes=0;
+  }
+  std::string var;
+  std::string sval;
+  double      dval;
+  double      tval;
+  double      mtval;
+  bool        sval_set;
+  bool        dval_set;
+  bool        known;
+
+  std::vector<std::string> sdeltas;
+  std::vector<double>      ddeltas;
+  bool        sdeltas_set;
+  bool        ddeltas_set;
+
+  // Count of all writes, letting readers cheaply detect changes
+  unsigned int writes;
+};
 
 class InfoBuffer {
 public:
-  InfoBuffer()  {m_curr_time_utc=0;}
+  InfoBuffer()  {m_curr_time_utc=0; m_start_time=0;}
   ~InfoBuffer() {}
 
 public:
@@ -52,6 +86,30 @@ public:
   unsigned long int size() const;
   unsigned long int sizeFull() const;
 
+public: // Slot interface. Resolve a variable name once with getSlot()
+        // then read and write through the slot index. getSlot() is
+        // const, though it may add a slot, so that readers holding a
+        // const buffer (behaviors, conditions) can bind to variables
+        // not yet posted. An added slot is unknown and changes no
+        // query, size or report. Not safe across threads.
+  unsigned int getSlot(const std::string&) const;
+  std::string  getSlotVar(unsigned int) const;
+  unsigned int slots() const {return(m_slots.size());}
+  unsigned int getSlotWrites(unsigned int) const;
+
+  std::string sQuery(unsigned int, bool&) const;
+  double dQuery(unsigned int, bool&) const;
+  double tQuery(unsigned int, bool elapsed=true) const;
+  double mtQuery(unsigned int, bool elapsed=true) const;
+
+  std::vector<std::string> sQueryDeltas(unsigned int, bool&) const;
+  std::vector<double>      dQueryDeltas(unsigned int, bool&) const;
+
+  bool   isKnown(unsigned int) const;
+
+  bool   setValue(unsigned int, double, double msg_time=0);
+  bool   setValue(unsigned int, const std::string&, double msg_time=0);
+
 public:
   bool   setValue(std::string, double, double msg_time=0);
   bool   setValue(std::string, std::string, double msg_time=0);
@@ -66,13 +124,18 @@ public:
 				     bool verbose=false) const;
   
 protected:
-  std::map<std::string, std::string> smap;
-  std::map<std::string, double>      dmap;
-  std::map<std::string, double>      tmap;
-  std::map<std::string, double>      mtmap;
+  bool   findSlot(const std::string&, unsigned int&) const;
+  double deltaQuery(const std::string&, bool&) const;
 
-  std::map<std::string, std::vector<std::string> >  vsmap;
-  std::map<std::string, std::vector<double> > vdmap;
+protected:
+  // Slots are created on demand, including from const methods when
+  // a reader resolves a variable not yet posted. Creating a slot
+  // does not change what the buffer reports as known.
+  mutable std::map<std::string, unsigned int> m_slot_map;
+  mutable std::vector<InfoBufferSlot>         m_slots;
+
+  // Slots with delta vectors posted since the last clear
+  std::vector<unsigned int> m_delta_slots;
 
   double m_curr_time_utc;
   double m_start_time;
@@ -25,6 +25,8 @@
 
 #include <iostream>
 #include "LogicCondition.h"
+#include "LogicUtils.h"
+#include "MBUtils.h"
 
 using namespace std;
 
@@ -36,6 +38,10 @@ LogicCondition::LogicCondition()
 {
   m_node = 0;
   m_allow_dblequals = true;
+
+  m_buffer      = 0;
+  m_dirty       = true;
+  m_last_result = false;
 }
 
 //------------------------------------------------------ 
@@ -58,15 +64,40 @@ LogicCondition::LogicCondition(const LogicCondition &b)
   else
     m_node = 0;
   m_allow_dblequals = true;
+
+  m_program     = b.m_program;
+  m_vars        = b.m_vars;
+  m_buffer      = b.m_buffer;
+  m_dirty       = b.m_dirty;
+  m_last_result = b.m_last_result;
 }
 
 //------------------------------------------------------ 
 // Procedure: expandMacro()
+//      Note: Variable names may themselves change with the macro, so
+//            the program is rebuilt. Values already held are carried
+//            over to the variable each old name expands into.
 
 void LogicCondition::expandMacro(string macro, string value)
 {
-  if(m_node)
-    m_node->recursiveExpandMacro(macro, value);
+  if(!m_node)
+    return;
+  m_node->recursiveExpandMacro(macro, value);
+
+  vector<LogicVar> old_vars = m_vars;
+  compile();
+
+  for(unsigned int i=0; i<old_vars.size(); i++) {
+    string new_name = findReplace(old_vars[i].name, macro, value);
+    int ix = varIndex(new_name);
+    if(ix < 0)
+      continue;
+    LogicVar& var = m_vars[ix];
+    var.sval = old_vars[i].sval;
+    var.dval = old_vars[i].dval;
+    var.sset = old_vars[i].sset;
+    var.dset = old_vars[i].dset;
+  }
 }
 
 //----------------------------------------------------------------
@@ -74,11 +105,23 @@ void LogicCondition::expandMacro(string macro, string value)
 
 const LogicCondition &LogicCondition::operator=(const LogicCondition &right)
 {
+  if(this == &right)
+    return(*this);
+
+  if(m_node)
+    delete(m_node);
+
   if(right.m_node)
     m_node = right.m_node->copy();
   else 
     m_node = 0;
 
+  m_program     = right.m_program;
+  m_vars        = right.m_vars;
+  m_buffer      = right.m_buffer;
+  m_dirty       = right.m_dirty;
+  m_last_result = right.m_last_result;
+
   return(*this);
 }
 
@@ -105,6 +148,10 @@ bool LogicCondition::setCondition(const string& str)
     delete(m_node);
     m_node = 0;
   }
+  m_program.clear();
+  m_vars.clear();
+  m_buffer = 0;
+  m_dirty  = true;
 
   m_node = new ParseNode(str);
 
@@ -124,32 +171,398 @@ bool LogicCondition::setCondition(const string& str)
     return(false);
   }
 
+  compile();
   return(true);
 }
 
-
 //----------------------------------------------------------------
-// Procedure: eval
+// Procedure: compile()
+//   Purpose: Flatten the parse tree into a postfix program over an
+//            indexed table of variables. Evaluation then needs no
+//            string compares on relation names or variable names.
 
-bool LogicCondition::eval() const
+void LogicCondition::compile()
 {
+  m_program.clear();
+  m_vars.clear();
+  m_buffer = 0;
+  m_dirty  = true;
+
   if(m_node)
-    return(m_node->recursiveEvaluate());
-  else
-    return(false);
+    compileNode(m_node);
+}
+
+//----------------------------------------------------------------
+// Procedure: compileNode()
+//      Note: Mirrors ParseNode::recursiveEvaluate(). Any shape that
+//            would evaluate to false there compiles to OP_FALSE.
+
+void LogicCondition::compileNode(const ParseNode* node)
+{
+  LogicInstr instr;
+  const string& relation = node->m_relation;
+
+  if(relation == "not") {
+    if(!node->m_left_node)
+      m_program.push_back(instr);
+    else {
+      compileNode(node->m_left_node);
+      instr.op = LogicInstr::OP_NOT;
+      m_program.push_back(instr);
+    }
+    return;
+  }
+
+  const ParseNode* lnode = node->m_left_node;
+  const ParseNode* rnode = node->m_right_node;
+  if(!lnode || !rnode) {
+    m_program.push_back(instr);
+    return;
+  }
+
+  if((relation == "and") || (relation == "or")) {
+    compileNode(lnode);
+    compileNode(rnode);
+    if(relation == "and")
+      instr.op = LogicInstr::OP_AND;
+    else
+      instr.op = LogicInstr::OP_OR;
+    m_program.push_back(instr);
+    return;
+  }
+
+  // Only a variable on the left can ever hold a value
+  int lvar = -1;
+  if(lnode->m_relation == "variable")
+    lvar = varIndex(lnode->m_raw_string);
+  if(lvar < 0) {
+    m_program.push_back(instr);
+    return;
+  }
+
+  if(rnode->m_relation == "string") {
+    instr.rkind = LogicInstr::RK_STRING;
+    instr.rstr  = rnode->m_raw_string;
+    if(isQuoted(instr.rstr))
+      instr.rstr = stripQuotes(instr.rstr);
+    instr.rnum_ok = isNumber(instr.rstr);
+    if(instr.rnum_ok)
+      instr.rnum = atof(instr.rstr.c_str());
+  }
+  else if(rnode->m_relation == "double") {
+    instr.rkind = LogicInstr::RK_DOUBLE;
+    instr.rdbl  = atof(rnode->m_raw_string.c_str());
+  }
+  else if((rnode->m_relation == "variable") &&
+	  (varIndex(rnode->m_raw_string) >= 0)) {
+    instr.rkind = LogicInstr::RK_VAR;
+    instr.rvar  = varIndex(rnode->m_raw_string);
+  }
+  else {
+    m_program.push_back(instr);
+    return;
+  }
+
+  if(relation == "=")       instr.rel = LogicInstr::REL_EQ;
+  else if(relation == "==") instr.rel = LogicInstr::REL_DBLEQ;
+  else if(relation == "!=") instr.rel = LogicInstr::REL_NEQ;
+  else if(relation == "<")  instr.rel = LogicInstr::REL_LT;
+  else if(relation == "<=") instr.rel = LogicInstr::REL_LTE;
+  else if(relation == ">")  instr.rel = LogicInstr::REL_GT;
+  else if(relation == ">=") instr.rel = LogicInstr::REL_GTE;
+
+  instr.op   = LogicInstr::OP_CMP;
+  instr.lvar = (unsigned int)(lvar);
+  m_program.push_back(instr);
+}
+
+//----------------------------------------------------------------
+// Procedure: varIndex()
+//   Purpose: Index of the named variable, added if not yet present.
+//            Returns -1 only for an empty name.
+
+int LogicCondition::varIndex(const string& name)
+{
+  if(name == "")
+    return(-1);
+  for(unsigned int i=0; i<m_vars.size(); i++) {
+    if(m_vars[i].name == name)
+      return((int)(i));
+  }
+
+  LogicVar var;
+  var.name = name;
+  var.is_delta = (strEnds(name, "_DELTA") && (name.length() > 6));
+  m_vars.push_back(var);
+  return((int)(m_vars.size()) - 1);
+}
+
+//----------------------------------------------------------------
+// Procedure: clearVarVals()
+
+void LogicCondition::clearVarVals()
+{
+  for(unsigned int i=0; i<m_vars.size(); i++) {
+    LogicVar& var = m_vars[i];
+    var.sval   = "";
+    var.dval   = 0;
+    var.sset   = false;
+    var.dset   = false;
+    var.pulled = false;
+  }
+  m_dirty = true;
+}
+
+//----------------------------------------------------------------
+// Procedure: setVarVal()
+
+void LogicCondition::setVarVal(const string& varname, const string& val)
+{
+  for(unsigned int i=0; i<m_vars.size(); i++) {
+    if(m_vars[i].name == varname) {
+      applyVal(m_vars[i], val);
+      m_vars[i].pulled = false;
+      return;
+    }
+  }
 }
-	   
 
-	   
+//----------------------------------------------------------------
+// Procedure: setVarVal()
 
+void LogicCondition::setVarVal(const string& varname, double val)
+{
+  for(unsigned int i=0; i<m_vars.size(); i++) {
+    if(m_vars[i].name == varname) {
+      applyVal(m_vars[i], val);
+      m_vars[i].pulled = false;
+      return;
+    }
+  }
+}
 
+//----------------------------------------------------------------
+// Procedure: applyVal()
+//      Note: Ok to overwrite a previous string-value, but cannot
+//            overwrite if previously set with a double value. The
+//            string is held with any surrounding quotes removed.
 
+void LogicCondition::applyVal(LogicVar& var, const string& val)
+{
+  if(var.dset)
+    return;
+
+  if(isQuoted(val)) {
+    string sval = stripQuotes(val);
+    if(var.sset && (var.sval == sval))
+      return;
+    var.sval = sval;
+  }
+  else {
+    if(var.sset && (var.sval == val))
+      return;
+    var.sval = val;
+  }
+  var.sset = true;
+  m_dirty  = true;
+}
 
+//----------------------------------------------------------------
+// Procedure: applyVal()
+//      Note: Ok to overwrite a previous double-value, but cannot
+//            overwrite if previously set with a string value.
 
+void LogicCondition::applyVal(LogicVar& var, double val)
+{
+  if(var.sset)
+    return;
+  if(var.dset && (var.dval == val))
+    return;
+  var.dval = val;
+  var.dset = true;
+  m_dirty  = true;
+}
 
+//----------------------------------------------------------------
+// Procedure: updateFromBuffer()
+//   Purpose: Pull the values of all variables in the condition from
+//            the given buffer. Variables are bound to buffer slots
+//            once, and a variable is re-read only if its slot has
+//            been written since the last pull. Variables ending in
+//            _DELTA are derived from the current time and always
+//            re-read.
+
+void LogicCondition::updateFromBuffer(const InfoBuffer* buffer)
+{
+  if(!buffer)
+    return;
+
+  if(buffer != m_buffer) {
+    for(unsigned int i=0; i<m_vars.size(); i++) {
+      m_vars[i].slot   = buffer->getSlot(m_vars[i].name);
+      m_vars[i].pulled = false;
+    }
+    m_buffer = buffer;
+  }
 
+  for(unsigned int i=0; i<m_vars.size(); i++) {
+    LogicVar& var = m_vars[i];
+    unsigned int writes = buffer->getSlotWrites(var.slot);
+    if(var.pulled && !var.is_delta && (var.writes == writes))
+      continue;
+
+    bool   ok_s, ok_d;
+    string s_result = buffer->sQuery(var.slot, ok_s);
+    double d_result = buffer->dQuery(var.slot, ok_d);
+    if(ok_s)
+      applyVal(var, s_result);
+    if(ok_d)
+      applyVal(var, d_result);
+
+    var.writes = writes;
+    var.pulled = true;
+  }
+}
 
+//----------------------------------------------------------------
+// Procedure: eval()
+//      Note: The result is cached and the program is only re-run
+//            after a variable takes on a new value.
 
+bool LogicCondition::eval() const
+{
+  if(!m_node)
+    return(false);
+  if(!m_dirty)
+    return(m_last_result);
+
+  m_stack.clear();
+  for(unsigned int i=0; i<m_program.size(); i++) {
+    const LogicInstr& instr = m_program[i];
+    switch(instr.op) {
+    case LogicInstr::OP_NOT:
+      m_stack.back() = !m_stack.back();
+      break;
+    case LogicInstr::OP_AND:
+    case LogicInstr::OP_OR: {
+      bool right = m_stack.back();
+      m_stack.pop_back();
+      if(instr.op == LogicInstr::OP_AND)
+	m_stack.back() = m_stack.back() && right;
+      else
+	m_stack.back() = m_stack.back() || right;
+      break;
+    }
+    case LogicInstr::OP_CMP:
+      m_stack.push_back(evalInstr(instr));
+      break;
+    default:
+      m_stack.push_back(false);
+    }
+  }
+
+  m_last_result = false;
+  if(m_stack.size() == 1)
+    m_last_result = m_stack.back();
+  m_dirty = false;
+  return(m_last_result);
+}
+
+//----------------------------------------------------------------
+// Procedure: evalInstr()
+//   Purpose: Evaluate one comparison. An unset variable on either
+//            side makes the comparison false. Mixed string/number
+//            comparisons hold only if the string is a number.
 
+bool LogicCondition::evalInstr(const LogicInstr& instr) const
+{
+  const LogicVar& lvar = m_vars[instr.lvar];
+  if(!lvar.sset && !lvar.dset)
+    return(false);
+
+  const string* rstr = 0;
+  double rdbl = 0;
+  switch(instr.rkind) {
+  case LogicInstr::RK_STRING:
+    rstr = &instr.rstr;
+    break;
+  case LogicInstr::RK_DOUBLE:
+    rdbl = instr.rdbl;
+    break;
+  default: {
+    const LogicVar& rvar = m_vars[instr.rvar];
+    if(rvar.sset)
+      rstr = &rvar.sval;
+    else if(rvar.dset)
+      rdbl = rvar.dval;
+    else
+      return(false);
+  }
+  }
 
+  // Case 1: string against string
+  if(lvar.sset && rstr) {
+    const string& left  = lvar.sval;
+    const string& right = *rstr;
+    switch(instr.rel) {
+    case LogicInstr::REL_EQ:    return(left == right);
+    case LogicInstr::REL_DBLEQ: return(strFieldMatch(left, right));
+    case LogicInstr::REL_NEQ:   return(left != right);
+    case LogicInstr::REL_LT:    return(left <  right);
+    case LogicInstr::REL_LTE:   return(left <= right);
+    case LogicInstr::REL_GT:    return(left >  right);
+    case LogicInstr::REL_GTE:   return(left >= right);
+    default:                    return(false);
+    }
+  }
 
+  // Case 2: at least one side a double. Strings must be numbers.
+  double left = lvar.dval;
+  if(lvar.sset) {
+    if(!isNumber(lvar.sval))
+      return(false);
+    left = atof(lvar.sval.c_str());
+  }
+  double right = rdbl;
+  if(rstr) {
+    if(instr.rkind == LogicInstr::RK_STRING) {
+      if(!instr.rnum_ok)
+	return(false);
+      right = instr.rnum;
+    }
+    else {
+      if(!isNumber(*rstr))
+	return(false);
+      right = atof(rstr->c_str());
+    }
+  }
+
+  switch(instr.rel) {
+  case LogicInstr::REL_EQ:
+  case LogicInstr::REL_DBLEQ: return(left == right);
+  case LogicInstr::REL_NEQ:   return(left != right);
+  case LogicInstr::REL_LT:    return(left <  right);
+  case LogicInstr::REL_LTE:   return(left <= right);
+  case LogicInstr::REL_GT:    return(left >  right);
+  case LogicInstr::REL_GTE:   return(left >= right);
+  default:                    return(false);
+  }
+}
+
+//----------------------------------------------------------------
+// Procedure: print()
+
+void LogicCondition::print() const
+{
+  if(!m_node)
+    return;
+  m_node->print();
+  for(unsigned int i=0; i<m_vars.size(); i++) {
+    cout << "  Var: [" << m_vars[i].name << "] ";
+    if(m_vars[i].sset)
+      cout << "[" << m_vars[i].sval << "]";
+    if(m_vars[i].dset)
+      cout << "[" << m_vars[i].dval << "]";
+    cout << endl;
+  }
+}
@@ -34,6 +34,49 @@
 #include <string>
 #include <vector>
 #include "ParseNode.h"
+#include "InfoBuffer.h"
+
+// One step of a compiled condition. The program is held in postfix
+// order and run against a small stack of booleans.
+struct LogicInstr
+{
+  enum Op   {OP_NOT, OP_AND, OP_OR, OP_CMP, OP_FALSE};
+  enum Rel  {REL_EQ, REL_DBLEQ, REL_NEQ, REL_LT, REL_LTE, REL_GT,
+	     REL_GTE, REL_BAD};
+  enum Kind {RK_VAR, RK_STRING, RK_DOUBLE};
+
+  LogicInstr() {op=OP_FALSE; rel=REL_BAD; lvar=0; rkind=RK_DOUBLE;
+    rvar=0; rdbl=0; rnum_ok=false; rnum=0;}
+
+  Op           op;
+  Rel          rel;
+  unsigned int lvar;
+  Kind         rkind;
+  unsigned int rvar;
+  std::string  rstr;     // String literal, quotes already removed
+  double       rdbl;     // Double literal
+  bool         rnum_ok;  // String literal is also a number
+  double       rnum;     // Numerical value of the string literal
+};
+
+// A variable referenced by a compiled condition, with its current
+// value and its binding to an InfoBuffer slot.
+struct LogicVar
+{
+  LogicVar() {dval=0; sset=false; dset=false; slot=0; writes=0;
+    pulled=false; is_delta=false;}
+
+  std::string  name;
+  std::string  sval;
+  double       dval;
+  bool         sset;
+  bool         dset;
+
+  unsigned int slot;
+  unsigned int writes;   // Slot write count at the last pull
+  bool         pulled;   // Value reflects the buffer at that count
+  bool         is_delta;
+};
 
 class LogicCondition {
 public:
@@ -59,24 +102,40 @@ public:
   
   std::vector<std::string> getVarNames() const;
   
-  void clearVarVals()
-    {if(m_node) m_node->recursiveClearVarVal();}
-  
-  void setVarVal(std::string var, std::string val)
-    {if(m_node) m_node->recursiveSetVarVal(var,val);}
-  
-  void setVarVal(std::string var, double val) 
-    {if(m_node) m_node->recursiveSetVarVal(var,val);}
+  void clearVarVals();
+  void setVarVal(const std::string& var, const std::string& val);
+  void setVarVal(const std::string& var, double val);
+
+  void updateFromBuffer(const InfoBuffer*);
 
   bool eval() const;
   
-  void print() const
-    {if(m_node) m_node->print();}
+  void print() const;
+
+protected:
+  void compile();
+  void compileNode(const ParseNode*);
+  int  varIndex(const std::string&);
+
+  void applyVal(LogicVar&, const std::string&);
+  void applyVal(LogicVar&, double);
+
+  bool evalInstr(const LogicInstr&) const;
 
 protected:
   ParseNode *m_node;
 
   bool  m_allow_dblequals;
+
+  // Compiled form of the parse tree
+  std::vector<LogicInstr> m_program;
+  std::vector<LogicVar>   m_vars;
+
+  const InfoBuffer* m_buffer;
+
+  mutable bool m_dirty;
+  mutable bool m_last_result;
+  mutable std::vector<bool> m_stack;
 };
 
 #endif
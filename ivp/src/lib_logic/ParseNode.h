@@ -29,6 +29,7 @@
 #include <string>
 
 class ParseNode {
+  friend class LogicCondition;
 
 public:
   ParseNode(const std::string& raw_string);
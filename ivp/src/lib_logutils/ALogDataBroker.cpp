@@ -1009,6 +1009,11 @@ VPlugPlot ALogDataBroker::getVPlugPlot(unsigned int aix)
     return(vplot);
   }
 
+  // Binary entries, e.g., VIEW_GRID, refer into the .blog file
+  // alongside the alog file.
+  string alog_dir = m_alog_files[aix];
+  rbiteString(alog_dir, '/');
+
   // ====================================================
   // Part 3: Populate the VPlugPlot
   // ====================================================
@@ -1033,6 +1038,13 @@ VPlugPlot ALogDataBroker::getVPlugPlot(unsigned int aix)
     if(entry.getStatus() == "eof") 
       break;
 
+    string sval = entry.getStringVal();
+    if(isMOOSBinaryEntry(sval)) {
+      string data = readMOOSBinaryEntry(sval, alog_dir);
+      entry.set(entry.getTimeStamp(), entry.getVarName(),
+		entry.getSource(), entry.getSrcAux(), data);
+    }
+
     //populator.populateFromEntry(entry);
     entries.push_back(entry);   // former
 
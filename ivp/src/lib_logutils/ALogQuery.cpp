@@ -0,0 +1,256 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ALogQuery.cpp                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "ALogQuery.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor()
+
+ALogQuery::ALogQuery()
+{
+  m_bin_size  = 1;
+  m_file_out  = 0;
+  m_lines_out = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: setSpec()
+//   Example: type=pick, var=NODE_REPORT, fields=X:Y, file=pos.txt
+
+bool ALogQuery::setSpec(string spec)
+{
+  vector<string> svector = parseString(spec, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string param = tolower(biteStringX(svector[i], '='));
+    string value = svector[i];
+
+    if((param == "type") && ((value == "grep") || (value == "pick") ||
+			     (value == "binavg")))
+      m_type = value;
+    else if((param == "file") && (value != ""))
+      m_filename = value;
+    else if((param == "var") && !strContainsWhite(value))
+      m_var = value;
+    else if(param == "keys") {
+      vector<string> keys = parseString(value, ':');
+      for(unsigned int j=0; j<keys.size(); j++) {
+	string key = stripBlankEnds(keys[j]);
+	bool pmatch = false;
+	if(strEnds(key, "*")) {
+	  pmatch = true;
+	  key = key.substr(0, key.length()-1);
+	}
+	if(key == "")
+	  return(false);
+	m_keys.push_back(key);
+	m_pmatch.push_back(pmatch);
+      }
+    }
+    else if(param == "fields") {
+      vector<string> fields = parseString(value, ':');
+      for(unsigned int j=0; j<fields.size(); j++)
+	m_fields.push_back(stripBlankEnds(fields[j]));
+    }
+    else if(param == "bin") {
+      if(!setPosDoubleOnString(m_bin_size, value))
+	return(false);
+    }
+    else
+      return(false);
+  }
+
+  // Sanity check that each query type has what it needs
+  if(m_filename == "")
+    return(false);
+  if(isGrep() && (m_keys.size() == 0))
+    return(false);
+  if(isPick() && ((m_var == "") || (m_fields.size() == 0)))
+    return(false);
+  if(isBinAvg() && (m_var == ""))
+    return(false);
+  
+  return(m_type != "");
+}
+
+//--------------------------------------------------------
+// Procedure: openOutput()
+
+bool ALogQuery::openOutput(bool overwrite)
+{
+  if(m_file_out)
+    return(true);
+  
+  if(!overwrite) {
+    FILE *f = fopen(m_filename.c_str(), "r");
+    if(f) {
+      fclose(f);
+      cout << m_filename << " already exists. Use --force." << endl;
+      return(false);
+    }
+  }
+  
+  m_file_out = fopen(m_filename.c_str(), "w");
+  if(!m_file_out) {
+    cout << "Unable to open " << m_filename << " for writing" << endl;
+    return(false);
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: closeOutput()
+//      Note: Binned averages are only known after the last line
+//            has been seen, so they are written here.
+
+void ALogQuery::closeOutput()
+{
+  if(!m_file_out)
+    return;
+
+  if(isBinAvg())
+    writeBinAvgs();
+  
+  fclose(m_file_out);
+  m_file_out = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: keyMatch()
+//      Note: Same semantics as aloggrep. A key ending in '*' is a
+//            partial match on either the variable or source.
+
+bool ALogQuery::keyMatch(const string& var, const string& src) const
+{
+  for(unsigned int i=0; i<m_keys.size(); i++) {
+    if((var == m_keys[i]) || (src == m_keys[i]))
+      return(true);
+    if(m_pmatch[i] && (strContains(var, m_keys[i]) ||
+		       strContains(src, m_keys[i])))
+      return(true);
+  }
+  return(false);
+}
+
+//--------------------------------------------------------
+// Procedure: handleEntry()
+//      Note: The engine has already determined that this query is
+//            interested in this line.
+
+void ALogQuery::handleEntry(const string& line, double tstamp,
+			    const string& data)
+{
+  if(!m_file_out)
+    return;
+
+  if(isGrep())
+    handleGrep(line);
+  else if(isPick())
+    handlePick(tstamp, data);
+  else if(isBinAvg())
+    handleBinAvg(tstamp, data);
+}
+
+//--------------------------------------------------------
+// Procedure: handleGrep()
+
+void ALogQuery::handleGrep(const string& line)
+{
+  fprintf(m_file_out, "%s\n", line.c_str());
+  m_lines_out++;
+}
+
+//--------------------------------------------------------
+// Procedure: handlePick()
+
+void ALogQuery::handlePick(double tstamp, const string& data)
+{
+  string out = doubleToStringX(tstamp, 3);
+  for(unsigned int i=0; i<m_fields.size(); i++) {
+    string val = tokStringParse(data, m_fields[i]);
+    if(val == "")
+      val = "-";
+    out += " " + val;
+  }
+  fprintf(m_file_out, "%s\n", out.c_str());
+  m_lines_out++;
+}
+
+//--------------------------------------------------------
+// Procedure: handleBinAvg()
+//      Note: If fields are given, the first field is taken from
+//            the posting, otherwise the posting must be a number.
+
+void ALogQuery::handleBinAvg(double tstamp, const string& data)
+{
+  string sval = data;
+  if(m_fields.size() > 0)
+    sval = tokStringParse(data, m_fields[0]);
+  if(!isNumber(sval))
+    return;
+
+  double dval = atof(sval.c_str());
+  long   bix  = (long)(floor(tstamp / m_bin_size));
+  
+  if(m_bin_count.count(bix) == 0) {
+    m_bin_total[bix] = 0;
+    m_bin_min[bix]   = dval;
+    m_bin_max[bix]   = dval;
+    m_bin_count[bix] = 0;
+  }
+
+  m_bin_total[bix] += dval;
+  m_bin_count[bix]++;
+  if(dval < m_bin_min[bix])
+    m_bin_min[bix] = dval;
+  if(dval > m_bin_max[bix])
+    m_bin_max[bix] = dval;
+}
+
+//--------------------------------------------------------
+// Procedure: writeBinAvgs()
+//    Format: bin_center  avg  min  max  count
+
+void ALogQuery::writeBinAvgs()
+{
+  map<long, unsigned int>::iterator p;
+  for(p=m_bin_count.begin(); p!=m_bin_count.end(); p++) {
+    long   bix   = p->first;
+    double count = (double)(p->second);
+    double bctr  = ((double)(bix) + 0.5) * m_bin_size;
+    double avg   = m_bin_total[bix] / count;
+
+    string out = doubleToStringX(bctr, 3) + " ";
+    out += doubleToStringX(avg, 6) + " ";
+    out += doubleToStringX(m_bin_min[bix], 6) + " ";
+    out += doubleToStringX(m_bin_max[bix], 6) + " ";
+    out += uintToString(p->second);
+    fprintf(m_file_out, "%s\n", out.c_str());
+    m_lines_out++;
+  }
+}
@@ -0,0 +1,97 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ALogQuery.h                                          */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_QUERY_HEADER
+#define ALOG_QUERY_HEADER
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+
+// An ALogQuery is one extraction request served by the
+// ALogQueryEngine. Three types are supported:
+//
+//   grep:   type=grep, keys=NAV_X:NAV_Y:pHelm*, file=nav.alog
+//   pick:   type=pick, var=NODE_REPORT, fields=X:Y:SPD, file=pos.txt
+//   binavg: type=binavg, var=NAV_SPEED, bin=10, file=spd.txt
+//
+// Each query writes to its own output file.
+
+class ALogQuery
+{
+ public:
+  ALogQuery();
+  ~ALogQuery() {}
+
+  bool setSpec(std::string);
+  bool openOutput(bool overwrite=false);
+  void closeOutput();
+
+  void handleEntry(const std::string& line, double tstamp,
+		   const std::string& data);
+  
+  bool isGrep() const    {return(m_type == "grep");}
+  bool isPick() const    {return(m_type == "pick");}
+  bool isBinAvg() const  {return(m_type == "binavg");}
+
+  bool matchesVarOnly() const {return(m_type != "grep");}
+
+  bool keyMatch(const std::string& var, const std::string& src) const;
+
+  std::string  getType() const      {return(m_type);}
+  std::string  getVar() const       {return(m_var);}
+  std::string  getFileName() const  {return(m_filename);}
+  unsigned int getLinesOut() const  {return(m_lines_out);}
+  
+ protected:
+  void handleGrep(const std::string& line);
+  void handlePick(double tstamp, const std::string& data);
+  void handleBinAvg(double tstamp, const std::string& data);
+  void writeBinAvgs();
+  
+ protected: // Config vars
+  std::string m_type;
+  std::string m_filename;
+
+  // grep
+  std::vector<std::string> m_keys;
+  std::vector<bool>        m_pmatch;
+
+  // pick and binavg
+  std::string              m_var;
+  std::vector<std::string> m_fields;
+  double                   m_bin_size;
+
+ protected: // State vars
+  FILE*        m_file_out;
+  unsigned int m_lines_out;
+
+  // binavg: bin index to (total, min, max, count)
+  std::map<long, double>       m_bin_total;
+  std::map<long, double>       m_bin_min;
+  std::map<long, double>       m_bin_max;
+  std::map<long, unsigned int> m_bin_count;
+};
+
+#endif 
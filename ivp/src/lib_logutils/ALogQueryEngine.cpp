@@ -0,0 +1,215 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ALogQueryEngine.cpp                                  */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include "MBUtils.h"
+#include "FileBuffer.h"
+#include "LogUtils.h"
+#include "ALogQueryEngine.h"
+
+using namespace std;
+
+//--------------------------------------------------------
+// Constructor()
+
+ALogQueryEngine::ALogQueryEngine()
+{
+  m_file_overwrite = false;
+  m_verbose        = false;
+  m_file_in        = 0;
+  m_lines_read     = 0;
+}
+
+//--------------------------------------------------------
+// Procedure: setALogFile()
+
+bool ALogQueryEngine::setALogFile(string alogfile)
+{
+  if(m_file_in) {
+    cout << "Only one input alog file may be provided." << endl;
+    return(false);
+  }
+  
+  m_file_in = fopen(alogfile.c_str(), "r");
+  if(!m_file_in) {
+    cout << "Unable to open file for reading: " << alogfile << endl;
+    return(false);
+  }
+  m_filename_in = alogfile;
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: addQuery()
+
+bool ALogQueryEngine::addQuery(string spec)
+{
+  ALogQuery query;
+  if(!query.setSpec(spec))
+    return(false);
+
+  // Two queries writing to the same file would clobber each other
+  for(unsigned int i=0; i<m_queries.size(); i++) {
+    if(m_queries[i].getFileName() == query.getFileName())
+      return(false);
+  }
+  
+  unsigned int ix = m_queries.size();
+  m_queries.push_back(query);
+
+  if(query.matchesVarOnly())
+    m_var_queries[query.getVar()].push_back(ix);
+  else
+    m_grep_queries.push_back(ix);
+  
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: addQueryFile()
+//      Note: One query per line. Blank lines and lines beginning
+//            with // are ignored. A leading "query =" is optional.
+
+bool ALogQueryEngine::addQueryFile(string filename)
+{
+  vector<string> lines = fileBuffer(filename);
+  if(lines.size() == 0) {
+    cout << "Unable to read query file: " << filename << endl;
+    return(false);
+  }
+
+  for(unsigned int i=0; i<lines.size(); i++) {
+    string line = stripBlankEnds(lines[i]);
+    if((line == "") || strBegins(line, "//"))
+      continue;
+    if(strBegins(tolower(line), "query")) {
+      biteStringX(line, '=');
+      line = stripBlankEnds(line);
+    }
+    if(!addQuery(line)) {
+      cout << "Bad query in " << filename << ": " << lines[i] << endl;
+      return(false);
+    }
+  }
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handle()
+
+bool ALogQueryEngine::handle()
+{
+  if(!m_file_in) {
+    cout << "No input alog file given - exiting" << endl;
+    return(false);
+  }
+  if(m_queries.size() == 0) {
+    cout << "No queries given - exiting" << endl;
+    return(false);
+  }
+  
+  // Part 1: Open all output files before reading anything
+  for(unsigned int i=0; i<m_queries.size(); i++) {
+    if(!m_queries[i].openOutput(m_file_overwrite)) {
+      for(unsigned int j=0; j<i; j++)
+	m_queries[j].closeOutput();
+      fclose(m_file_in);
+      m_file_in = 0;
+      return(false);
+    }
+  }
+
+  // Part 2: The single pass over the alog file
+  while(1) {
+    string line_raw = getNextRawLine(m_file_in);
+    if(line_raw == "eof")
+      break;
+    m_lines_read++;
+    handleLine(line_raw);
+  }
+  
+  // Part 3: Flush and close
+  for(unsigned int i=0; i<m_queries.size(); i++)
+    m_queries[i].closeOutput();
+
+  fclose(m_file_in);
+  m_file_in = 0;
+  
+  if(m_verbose)
+    printReport();
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: handleLine()
+//      Note: The line is parsed at most once regardless of the
+//            number of queries interested in it.
+
+void ALogQueryEngine::handleLine(const string& line)
+{
+  if((line.length() == 0) || (line.at(0) == '%'))
+    return;
+  if(!isNumber(line.substr(0,1)))
+    return;
+
+  string var = getVarName(line);
+  string src = getSourceNameNoAux(line);
+
+  // Grep queries may match on source or partial names
+  vector<unsigned int> grep_qixs;
+  for(unsigned int i=0; i<m_grep_queries.size(); i++) {
+    unsigned int ix = m_grep_queries[i];
+    if(m_queries[ix].keyMatch(var, src))
+      grep_qixs.push_back(ix);
+  }
+
+  map<string, vector<unsigned int> >::const_iterator p;
+  p = m_var_queries.find(var);
+  bool var_match = (p != m_var_queries.end());
+  if(!var_match && (grep_qixs.size() == 0))
+    return;
+
+  double tstamp = atof(getTimeStamp(line).c_str());
+  string data   = getDataEntry(line);
+  if(var_match) {
+    const vector<unsigned int>& var_qixs = p->second;
+    for(unsigned int i=0; i<var_qixs.size(); i++)
+      m_queries[var_qixs[i]].handleEntry(line, tstamp, data);
+  }
+  for(unsigned int i=0; i<grep_qixs.size(); i++)
+    m_queries[grep_qixs[i]].handleEntry(line, tstamp, data);
+}
+
+//--------------------------------------------------------
+// Procedure: printReport()
+
+void ALogQueryEngine::printReport() const
+{
+  cout << "Lines read: " << m_lines_read << endl;
+  for(unsigned int i=0; i<m_queries.size(); i++) {
+    cout << "  [" << m_queries[i].getType() << "] ";
+    cout << m_queries[i].getFileName() << ": ";
+    cout << m_queries[i].getLinesOut() << " lines" << endl;
+  }
+}
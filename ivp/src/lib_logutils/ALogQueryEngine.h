@@ -0,0 +1,74 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ALogQueryEngine.h                                    */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#ifndef ALOG_QUERY_ENGINE_HEADER
+#define ALOG_QUERY_ENGINE_HEADER
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include "ALogQuery.h"
+
+// Serves any number of ALogQuery requests from a single streaming
+// pass over the alog file, rather than one full read per tool.
+
+class ALogQueryEngine
+{
+ public:
+  ALogQueryEngine();
+  ~ALogQueryEngine() {}
+
+  bool setALogFile(std::string);
+  bool addQuery(std::string spec);
+  bool addQueryFile(std::string filename);
+  void setFileOverWrite(bool v)  {m_file_overwrite=v;}
+  void setVerbose(bool v)        {m_verbose=v;}
+
+  bool handle();
+  void printReport() const;
+
+  unsigned int size() const {return(m_queries.size());}
+  
+ protected:
+  void handleLine(const std::string& line);
+  
+ protected: // Config vars
+  bool        m_file_overwrite;
+  bool        m_verbose;
+  std::string m_filename_in;
+  FILE*       m_file_in;
+
+  std::vector<ALogQuery> m_queries;
+
+  // Queries keyed on an exact variable name (pick, binavg) are
+  // found by lookup. Grep queries may match on source or partial
+  // names so they are checked on every line.
+  std::map<std::string, std::vector<unsigned int> > m_var_queries;
+  std::vector<unsigned int>                          m_grep_queries;
+
+ protected: // State vars
+  unsigned int m_lines_read;
+};
+
+#endif 
@@ -746,3 +746,62 @@ unsigned int getFileLineCount(const string& filestr)
 }
   
 
+//--------------------------------------------------------
+// Procedure: isMOOSBinaryEntry()
+//   Example: <MOOS_BINARY>File=LOG.blog,Offset=2033,Bytes=52</MOOS_BINARY>
+//      Note: pLogger writes the data of binary messages to a .blog
+//            file beside the .alog, leaving the above in its place.
+
+bool isMOOSBinaryEntry(const string& str)
+{
+  return(strBegins(str, "<MOOS_BINARY>"));
+}
+
+//--------------------------------------------------------
+// Procedure: readMOOSBinaryEntry()
+//   Purpose: Fetch the binary data referenced by an alog entry from
+//            the .blog file in the given directory.
+//   Returns: Empty string if the reference or file is not usable.
+
+string readMOOSBinaryEntry(const string& entry, const string& dir)
+{
+  if(!isMOOSBinaryEntry(entry))
+    return("");
+
+  string str = entry.substr(13);
+  str = biteString(str, '<');
+
+  string file, offset, bytes;
+  vector<string> svector = parseString(str, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string param = biteStringX(svector[i], '=');
+    string value = svector[i];
+    if(param == "File")
+      file = value;
+    else if(param == "Offset")
+      offset = value;
+    else if(param == "Bytes")
+      bytes = value;
+  }
+  if((file == "") || !isNumber(offset) || !isNumber(bytes))
+    return("");
+
+  if(dir != "")
+    file = dir + "/" + file;
+  FILE *f = fopen(file.c_str(), "rb");
+  if(!f)
+    return("");
+
+  long   offset_val = atol(offset.c_str());
+  size_t bytes_val  = (size_t)(atol(bytes.c_str()));
+
+  string data(bytes_val, '\0');
+  bool ok = (fseek(f, offset_val, SEEK_SET) == 0);
+  if(ok && (bytes_val > 0))
+    ok = (fread(&data[0], 1, bytes_val, f) == bytes_val);
+  fclose(f);
+
+  if(!ok)
+    return("");
+  return(data);
+}
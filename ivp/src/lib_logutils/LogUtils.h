@@ -56,6 +56,9 @@ unsigned int getIndexByTime(const std::vector<double>&, double);
 
 unsigned int getFileLineCount(const std::string& filename);
 
+bool        isMOOSBinaryEntry(const std::string&);
+std::string readMOOSBinaryEntry(const std::string&, const std::string& dir);
+
 #endif 
 
 
@@ -62,6 +62,7 @@ void ModelHelmScope::setDataBroker(ALogDataBroker dbroker, string vname)
   unsigned int mix4 = m_dbroker.getMixFromVNameVarName(vname, "BHV_WARNING");
   unsigned int mix5 = m_dbroker.getMixFromVNameVarName(vname, "BHV_ERROR");
   unsigned int mix6 = m_dbroker.getMixFromVNameVarName(vname, "IVPHELM_LIFE_EVENT");
+  unsigned int mix7 = m_dbroker.getMixFromVNameVarName(vname, "IVPHELM_PROFILE");
 
   m_vplot_helm_state   = m_dbroker.getVarPlot(mix1);
   m_vplot_helm_modeset = m_dbroker.getVarPlot(mix2);
@@ -69,6 +70,7 @@ void ModelHelmScope::setDataBroker(ALogDataBroker dbroker, string vname)
   m_vplot_bhv_warning  = m_dbroker.getVarPlot(mix4, true); // true:incSourceInfo
   m_vplot_bhv_error    = m_dbroker.getVarPlot(mix5, true); // true:incSourceInfo
   m_vplot_life_event   = m_dbroker.getVarPlot(mix6);
+  m_vplot_helm_profile = m_dbroker.getVarPlot(mix7);
 }
 
 //-------------------------------------------------------------
@@ -120,6 +122,8 @@ unsigned int ModelHelmScope::getVPlotSize(string ptype) const
     return(m_vplot_helm_modeset.size());
   else if(ptype == "life_event")
     return(m_vplot_life_event.size());
+  else if(ptype == "helm_profile")
+    return(m_vplot_helm_profile.size());
   
   return(0);
 }
@@ -373,6 +377,58 @@ vector<string> ModelHelmScope::getLifeEvents() const
   return(rvector);
 }
 
+//-------------------------------------------------------------
+// Procedure: getProfile()
+//   Purpose: Tabulate the most recent IVPHELM_PROFILE posting at or
+//            before the current time. Times are in milliseconds.
+//  Examples: iter=480,win=100 # stage=total,n=100,p50=1.21,p90=2.05,
+//            max=3.3 # bhv=avd_henry,n=100,p50=0.43,p90=0.61,
+//            max=0.9,pcs=120
+
+vector<string> ModelHelmScope::getProfile() const
+{
+  ACTable actab(7,2);
+  if(m_headers_bhv) {
+    actab << "Type" << "Name" << "N" << "p50(ms)" << "p90(ms)";
+    actab << "max(ms)" << "Pcs";
+    actab.addHeaderLines();
+  }
+
+  vector<string> valvector = m_vplot_helm_profile.getEntriesUpToTime(m_curr_time);
+  if(valvector.size() == 0)
+    return(actab.getTableOutput());
+
+  string val = valvector[valvector.size()-1];
+  vector<string> svector = parseString(val, '#');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string type, name, n, p50, p90, pmax, pcs="-";
+    vector<string> jvector = parseString(svector[i], ',');
+    for(unsigned int j=0; j<jvector.size(); j++) {
+      string param = biteStringX(jvector[j], '=');
+      string value = jvector[j];
+      if((param == "stage") || (param == "bhv")) {
+	type = param;
+	name = value;
+      }
+      else if(param == "n")
+	n = value;
+      else if(param == "p50")
+	p50 = value;
+      else if(param == "p90")
+	p90 = value;
+      else if(param == "max")
+	pmax = value;
+      else if(param == "pcs")
+	pcs = value;
+    }
+    if(type != "")
+      actab << type << name << n << p50 << p90 << pmax << pcs;
+  }
+  
+  vector<string> rvector = actab.getTableOutput();
+  return(rvector);
+}
+
 
 //-------------------------------------------------------------
 // Procedure: convertTimeUTC2TimeElapsed
@@ -198,7 +198,8 @@ bool SplitHandler::handleMakeSplitFiles()
        (varname=="VIEW_SEGLIST") || (varname=="VIEW_CIRCLE")  ||
        (varname=="GRID_INIT")    || (varname=="VIEW_MARKER")  ||
        (varname=="GRID_DELTA")   || (varname=="VIEW_SEGLR")   ||
-       (varname=="VIEW_ARROW")   || 
+       (varname=="VIEW_ARROW")   || (varname=="VIEW_GRID")    ||
+       (varname=="VIEW_GRID_DELTA") ||
        (varname=="VIEW_RANGE_PULSE")  ||
        (varname=="VIEW_COMMS_PULSE"))
       varname = "VISUALS";
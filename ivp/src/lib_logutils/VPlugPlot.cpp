@@ -48,6 +48,8 @@ VPlugPlot::VPlugPlot()
   m_view_arrow_cnt   = 0;
   m_grid_config_cnt  = 0;
   m_grid_delta_cnt   = 0;
+  m_view_grid_cnt    = 0;
+  m_view_grid_delta_cnt = 0;
   m_view_range_pulse_cnt = 0;
   m_view_comms_pulse_cnt = 0;
   m_view_marker_cnt = 0;
@@ -109,6 +111,14 @@ bool VPlugPlot::addEvent(const string& var, const string& val,
     m_vplugs[vsize-1].updateGrid(val);
     m_grid_delta_cnt++;
   }
+  else if(var == "VIEW_GRID") {
+    m_vplugs[vsize-1].addConvexGrid(val);
+    m_view_grid_cnt++;
+  }
+  else if(var == "VIEW_GRID_DELTA") {
+    m_vplugs[vsize-1].updateConvexGrid(val);
+    m_view_grid_delta_cnt++;
+  }
   else if(var == "VIEW_RANGE_PULSE") {
     m_vplugs[vsize-1].addRangePulse(val);
     m_view_range_pulse_cnt++;
@@ -221,6 +231,8 @@ void VPlugPlot::summary(string indent) const
   string str_arrow = uintToCommaString(m_view_arrow_cnt);
   string str_grid_config = uintToCommaString(m_grid_config_cnt);
   string str_grid_delta = uintToCommaString(m_grid_delta_cnt);
+  string str_view_grid = uintToCommaString(m_view_grid_cnt);
+  string str_view_grid_delta = uintToCommaString(m_view_grid_delta_cnt);
   string str_range_pulse = uintToCommaString(m_view_range_pulse_cnt);
   string str_comms_pulse = uintToCommaString(m_view_comms_pulse_cnt);
   string str_marker = uintToCommaString(m_view_marker_cnt);
@@ -239,6 +251,10 @@ void VPlugPlot::summary(string indent) const
     cout << indent << "GRID_CONFIG total: " << str_grid_config << endl;
   if(m_grid_delta_cnt > 0)
     cout << indent << "GRID_DELTA total: " << str_grid_delta << endl;
+  if(m_view_grid_cnt > 0)
+    cout << indent << "VIEW_GRID total: " << str_view_grid << endl;
+  if(m_view_grid_delta_cnt > 0)
+    cout << indent << "VIEW_GRID_DELTA total: " << str_view_grid_delta << endl;
   if(m_view_range_pulse_cnt > 0)
     cout << indent << "RANGE_PULSE total: " << str_range_pulse << endl;
   if(m_view_comms_pulse_cnt > 0)
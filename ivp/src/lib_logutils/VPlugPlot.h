@@ -71,6 +71,8 @@ protected: // state vars
   unsigned int m_view_arrow_cnt;
   unsigned int m_grid_config_cnt;
   unsigned int m_grid_delta_cnt;
+  unsigned int m_view_grid_cnt;
+  unsigned int m_view_grid_delta_cnt;
   unsigned int m_view_range_pulse_cnt;
   unsigned int m_view_comms_pulse_cnt;
   unsigned int m_view_marker_cnt;
@@ -0,0 +1,186 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ExpiryQueue.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include "ExpiryQueue.h"
+
+using namespace std;
+
+//------------------------------------------------------------------
+// Procedure: schedule()
+//      Note: If the key is already scheduled, its deadline is
+//            replaced with the new deadline.
+
+void ExpiryQueue::schedule(const string& key, double deadline)
+{
+  map<string, pair<double, double> >::iterator p = m_deadlines.find(key);
+  if(p != m_deadlines.end()) {
+    p->second.first = deadline;
+    if(deadline >= p->second.second)
+      return;
+    p->second.second = deadline;
+  }
+  else
+    m_deadlines[key] = pair<double, double>(deadline, deadline);
+
+  m_heap.push(Entry(deadline, key));
+
+  if(m_heap.size() > (2 * m_deadlines.size()) + 64)
+    rebuild();
+}
+
+//------------------------------------------------------------------
+// Procedure: cancel()
+
+bool ExpiryQueue::cancel(const string& key)
+{
+  if(m_deadlines.erase(key) == 0)
+    return(false);
+
+  if(m_deadlines.size() == 0)
+    clear();
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: clear()
+
+void ExpiryQueue::clear()
+{
+  m_deadlines.clear();
+  m_heap = priority_queue<Entry, vector<Entry>, greater<Entry> >();
+}
+
+//------------------------------------------------------------------
+// Procedure: peekNext()
+//   Purpose: Get the key with the earliest deadline, without removing
+//            it. Ties are broken by key in alphabetical order.
+
+bool ExpiryQueue::peekNext(string& key, double& deadline)
+{
+  pruneStale();
+  if(m_heap.empty())
+    return(false);
+
+  key = m_heap.top().second;
+  deadline = m_heap.top().first;
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: popNext()
+
+bool ExpiryQueue::popNext(string& key, double& deadline)
+{
+  if(!peekNext(key, deadline))
+    return(false);
+
+  m_heap.pop();
+  m_deadlines.erase(key);
+  return(true);
+}
+
+//------------------------------------------------------------------
+// Procedure: popExpired()
+//   Purpose: Remove and return all keys with a deadline strictly
+//            before the given time, in order of deadline.
+
+vector<string> ExpiryQueue::popExpired(double curr_time)
+{
+  vector<string> expired;
+
+  string key;
+  double deadline;
+  while(peekNext(key, deadline) && (deadline < curr_time)) {
+    m_heap.pop();
+    m_deadlines.erase(key);
+    expired.push_back(key);
+  }
+  return(expired);
+}
+
+//------------------------------------------------------------------
+// Procedure: hasKey()
+
+bool ExpiryQueue::hasKey(const string& key) const
+{
+  return(m_deadlines.count(key) != 0);
+}
+
+//------------------------------------------------------------------
+// Procedure: getDeadline()
+
+double ExpiryQueue::getDeadline(const string& key) const
+{
+  map<string, pair<double, double> >::const_iterator p;
+  p = m_deadlines.find(key);
+  if(p == m_deadlines.end())
+    return(0);
+  return(p->second.first);
+}
+
+//------------------------------------------------------------------
+// Procedure: pruneStale()
+//   Purpose: Settle the top of the heap so that it holds the current
+//            deadline of a live key. Entries of cancelled keys, or
+//            replaced by an earlier entry, are dropped. An entry for
+//            a key whose deadline has since moved later is re-queued
+//            with the later deadline.
+
+void ExpiryQueue::pruneStale()
+{
+  while(!m_heap.empty()) {
+    Entry entry = m_heap.top();
+    map<string, pair<double, double> >::iterator p;
+    p = m_deadlines.find(entry.second);
+    if((p == m_deadlines.end()) || (p->second.second != entry.first)) {
+      m_heap.pop();
+      continue;
+    }
+    if(p->second.first == entry.first)
+      return;
+
+    m_heap.pop();
+    p->second.second = p->second.first;
+    m_heap.push(Entry(p->second.first, entry.second));
+  }
+}
+
+//------------------------------------------------------------------
+// Procedure: rebuild()
+//   Purpose: Rebuild the heap from the live keys only.
+
+void ExpiryQueue::rebuild()
+{
+  vector<Entry> entries;
+  entries.reserve(m_deadlines.size());
+  map<string, pair<double, double> >::iterator p;
+  for(p=m_deadlines.begin(); p!=m_deadlines.end(); p++) {
+    p->second.second = p->second.first;
+    entries.push_back(Entry(p->second.first, p->first));
+  }
+
+  m_heap = priority_queue<Entry, vector<Entry>, greater<Entry> >
+    (greater<Entry>(), entries);
+}
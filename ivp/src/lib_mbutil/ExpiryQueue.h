@@ -0,0 +1,79 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: ExpiryQueue.h                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of IvP Helm Core Libs                       */
+/*                                                               */
+/* IvP Helm Core Libs is free software: you can redistribute it  */
+/* and/or modify it under the terms of the Lesser GNU General    */
+/* Public License as published by the Free Software Foundation,  */
+/* either version 3 of the License, or (at your option) any      */
+/* later version.                                                */
+/*                                                               */
+/* IvP Helm Core Libs is distributed in the hope that it will    */
+/* be useful but WITHOUT ANY WARRANTY; without even the implied  */
+/* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR       */
+/* PURPOSE. See the Lesser GNU General Public License for more   */
+/* details.                                                      */
+/*                                                               */
+/* You should have received a copy of the Lesser GNU General     */
+/* Public License along with MOOS-IvP.  If not, see              */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+ 
+#ifndef EXPIRY_QUEUE_HEADER
+#define EXPIRY_QUEUE_HEADER
+
+#include <string>
+#include <vector>
+#include <map>
+#include <queue>
+#include <utility>
+
+//------------------------------------------------------------------
+// A set of string keys each with a deadline, kept in a min-heap so
+// the next key to expire is found in O(log n), rather than scanning
+// all keys. Moving a deadline later, the common case when a key is
+// refreshed, only updates the map. The heap entry is re-queued with
+// the later deadline once it reaches the top of the heap. Moving a
+// deadline earlier pushes a new heap entry and the old one is
+// skipped when it reaches the top.
+
+class ExpiryQueue {
+ public:
+  ExpiryQueue() {}
+  ~ExpiryQueue() {}
+
+  void schedule(const std::string& key, double deadline);
+  bool cancel(const std::string& key);
+  void clear();
+
+  bool peekNext(std::string& key, double& deadline);
+  bool popNext(std::string& key, double& deadline);
+
+  std::vector<std::string> popExpired(double curr_time);
+
+  bool   hasKey(const std::string& key) const;
+  double getDeadline(const std::string& key) const;
+
+  unsigned int size() const     {return(m_deadlines.size());}
+  unsigned int heapSize() const {return(m_heap.size());}
+
+ protected:
+  void   pruneStale();
+  void   rebuild();
+  
+ protected:
+  typedef std::pair<double, std::string> Entry;
+
+  // Per key: first is the deadline, second is the deadline of the
+  // heap entry for the key. The second is never after the first.
+  std::map<std::string, std::pair<double, double> > m_deadlines;
+
+  std::priority_queue<Entry, std::vector<Entry>,
+		      std::greater<Entry> > m_heap;
+};
+
+#endif 
@@ -23,6 +23,7 @@
 
 #include "MBUtils.h"
 #include "Obstacle.h"
+#include "ConvexHullGenerator.h"
 
 using namespace std;
 
@@ -40,6 +41,13 @@ Obstacle::Obstacle()
   m_changed    = false;
   m_updates_total = 0;
   m_min_range  = -1;
+
+  m_hull_margin  = 0;
+  m_hull_valid   = false;
+  m_hull_pending = false;
+  m_hull_general = false;
+  m_hull_builds_full = 0;
+  m_hull_builds_inc  = 0;
 }
 
 
@@ -48,10 +56,13 @@ Obstacle::Obstacle()
 
 bool Obstacle::addPoint(XYPoint point)
 {
-  m_points.push_front(point);
+  m_points.insert(m_points.begin(), point);
+  hullPointAdded(point);
 
-  if(m_points.size() > m_max_points)
+  while(m_points.size() > m_max_points) {
+    hullPointRemoved(m_points.back());
     m_points.pop_back();
+  }
 
   // Obstacle is point-based. Must have non-empty set of points
   // or it will be considered expired.
@@ -118,20 +129,6 @@ double Obstacle::getTimeToLive(double curr_time) const
 }
 
 
-//---------------------------------------------------------
-// Procedure: getPoints()
-
-vector<XYPoint> Obstacle::getPoints() const
-{
-  vector<XYPoint> rvector;
-  
-  list<XYPoint>::const_iterator p;
-  for(p=m_points.begin(); p!= m_points.end(); p++)
-    rvector.push_back(*p);
-
-  return(rvector);
-}
-
 //---------------------------------------------------------
 // Procedure: isGiven()
 
@@ -188,12 +185,13 @@ bool Obstacle::pruneByAge(double max_age, double curr_time)
   }
   
   // Part 2: Go through all points and prune based on age
-  list<XYPoint>::iterator p;
+  vector<XYPoint>::iterator p;
   for(p=m_points.begin(); p!=m_points.end(); ) {
     XYPoint pt = *p;
     double age = curr_time - pt.get_time();
     if(age > max_age) {
       m_changed = true;
+      hullPointRemoved(*p);
       p = m_points.erase(p);
     }
     else
@@ -206,3 +204,139 @@ bool Obstacle::pruneByAge(double max_age, double curr_time)
   return(false);
 }
 
+
+//---------------------------------------------------------
+// Procedure: getPointHull()
+//   Purpose: Return the convex hull of the current points. The
+//            hull is rebuilt from all points only if a support
+//            point has been dropped since the last call, or if the
+//            hull has outgrown the margin its support was chosen by.
+
+XYPolygon Obstacle::getPointHull()
+{
+  if(m_points.size() == 0) {
+    m_hull_valid = false;
+    return(XYPolygon());
+  }
+
+  if(m_hull_valid && m_hull_pending) {
+    buildHull(m_hull_support, false);
+    m_hull_builds_inc++;
+    if(m_hull_general && (hullMargin() > m_hull_margin))
+      m_hull_valid = false;
+  }
+  if(!m_hull_valid) {
+    buildHull(m_points, true);
+    m_hull_builds_full++;
+  }
+
+  return(m_hull);
+}
+
+//---------------------------------------------------------
+// Procedure: buildHull()
+//      Note: In the general case every hull vertex is one of the
+//            given points. The support is then every point not
+//            deep inside the hull. The hull generator treats points
+//            within 0.1 degrees of each other, as seen from its root
+//            point, as ties and keeps the farthest. So a point near
+//            an edge may or may not be a vertex depending on which
+//            other points are present, and is kept as support.
+//      Note: In the one and two point special cases the hull
+//            vertices are synthesized, so all points are kept as
+//            support and new points are never assumed interior.
+//      Note: A full build sets the margin with room to grow, so
+//            incremental builds need not redo a full one each time
+//            the hull grows a little.
+
+void Obstacle::buildHull(const vector<XYPoint>& pts, bool full)
+{
+  ConvexHullGenerator chgen;
+  for(unsigned int i=0; i<pts.size(); i++)
+    chgen.addPoint(pts[i].x(), pts[i].y(), pts[i].get_label());
+  m_hull = chgen.generateConvexHull();
+
+  unsigned int vertices = 0;
+  for(unsigned int i=0; i<m_hull.size(); i++) {
+    double vx = m_hull.get_vx(i);
+    double vy = m_hull.get_vy(i);
+    for(unsigned int j=0; j<pts.size(); j++) {
+      if((pts[j].x() == vx) && (pts[j].y() == vy)) {
+	vertices++;
+	break;
+      }
+    }
+  }
+
+  m_hull_general = (m_hull.size() > 0) && (vertices == m_hull.size());
+  if(m_hull_general) {
+    if(full)
+      m_hull_margin = 2 * hullMargin();
+    vector<XYPoint> support;
+    for(unsigned int j=0; j<pts.size(); j++) {
+      if(!hullInterior(pts[j]))
+	support.push_back(pts[j]);
+    }
+    m_hull_support = support;
+  }
+  else
+    m_hull_support = pts;
+
+  m_hull_valid   = true;
+  m_hull_pending = false;
+}
+
+//---------------------------------------------------------
+// Procedure: hullMargin()
+//   Purpose: Distance from the hull edges within which a point may
+//            take part in a tie in the hull generator. Ties span
+//            0.1 degrees per point from a root up to twice the max
+//            radius away, allowing for a few chained ties, plus a
+//            small fixed part for its collinearity tolerance.
+
+double Obstacle::hullMargin() const
+{
+  return((0.02 * m_hull.max_radius()) + 0.05);
+}
+
+//---------------------------------------------------------
+// Procedure: hullInterior()
+//   Purpose: True if the point is inside the hull and farther than
+//            the margin from every edge.
+
+bool Obstacle::hullInterior(const XYPoint& pt) const
+{
+  if(!m_hull.contains(pt.x(), pt.y()))
+    return(false);
+  return(m_hull.dist_to_poly(pt.x(), pt.y()) > m_hull_margin);
+}
+
+//---------------------------------------------------------
+// Procedure: hullPointAdded()
+
+void Obstacle::hullPointAdded(const XYPoint& pt)
+{
+  if(!m_hull_valid)
+    return;
+  if(m_hull_general && hullInterior(pt))
+    return;
+
+  m_hull_support.push_back(pt);
+  m_hull_pending = true;
+}
+
+//---------------------------------------------------------
+// Procedure: hullPointRemoved()
+
+void Obstacle::hullPointRemoved(const XYPoint& pt)
+{
+  if(!m_hull_valid)
+    return;
+  for(unsigned int i=0; i<m_hull_support.size(); i++) {
+    if((m_hull_support[i].x() == pt.x()) &&
+       (m_hull_support[i].y() == pt.y())) {
+      m_hull_valid = false;
+      return;
+    }
+  }
+}
@@ -26,7 +26,6 @@
 
 #include "XYPolygon.h"
 #include "XYPoint.h"
-#include <list>
 #include <vector>
 
 class Obstacle
@@ -39,6 +38,8 @@ public:
   bool setPoly(XYPolygon);
 
   bool pruneByAge(double max_time, double curr_time);
+
+  XYPolygon getPointHull();
   
   void setRange(double);
   void setDuration(double v)     {m_duration=v;}
@@ -49,7 +50,7 @@ public:
   
   unsigned int size() const            {return(m_points.size());}
   unsigned int getPtsTotal() const     {return(m_pts_total);}
-  XYPolygon    getPoly() const         {return(m_polygon);}
+  const XYPolygon& getPoly() const     {return(m_polygon);}
   double       getRange() const        {return(m_range);}
   bool         hasChanged() const      {return(m_changed);}
   double       getDuration() const     {return(m_duration);}
@@ -57,6 +58,8 @@ public:
   unsigned int getUpdatesTotal() const {return(m_updates_total);}
   unsigned int getMaxPoints() const    {return(m_max_points);}
   double       getMinRange() const     {return(m_min_range);}
+  unsigned int getHullBuildsFull() const {return(m_hull_builds_full);}
+  unsigned int getHullBuildsInc() const  {return(m_hull_builds_inc);}
   
   double       getTimeToLive(double curr_time) const;
 
@@ -64,15 +67,23 @@ public:
 
   std::string  getInfo(double curr_time=0) const;
   
-  std::vector<XYPoint> getPoints() const;
+  // Newest point first
+  const std::vector<XYPoint>& getPoints() const {return(m_points);}
+
+protected:
+  void hullPointAdded(const XYPoint&);
+  void hullPointRemoved(const XYPoint&);
+  void buildHull(const std::vector<XYPoint>&, bool full);
+  bool hullInterior(const XYPoint&) const;
+  double hullMargin() const;
   
 protected: // set externally
-  std::list<XYPoint> m_points;
-  XYPolygon          m_polygon;
-  double             m_range;
-  double             m_duration;
-  double             m_tstamp;
-  unsigned int       m_max_points;
+  std::vector<XYPoint> m_points;
+  XYPolygon            m_polygon;
+  double               m_range;
+  double               m_duration;
+  double               m_tstamp;
+  unsigned int         m_max_points;
   
 private:  // set internally
   unsigned int   m_pts_total;
@@ -80,6 +91,22 @@ private:  // set internally
   unsigned int   m_updates_total;
   double         m_min_range;
   std::string    m_poly_spec;
+
+  // Incrementally maintained hull of the points. The support points
+  // are all points not deep inside the hull, i.e., the vertices and
+  // any point within m_hull_margin of the hull edges. A new point
+  // deep inside leaves the hull unchanged, and any other new point
+  // only needs a hull of the support points plus itself. A full
+  // rebuild is needed when a support point is dropped, or when the
+  // hull outgrows the margin it was classified with.
+  XYPolygon            m_hull;
+  std::vector<XYPoint> m_hull_support;
+  double               m_hull_margin;
+  bool                 m_hull_valid;
+  bool                 m_hull_pending;
+  bool                 m_hull_general;
+  unsigned int         m_hull_builds_full;
+  unsigned int         m_hull_builds_inc;
 };
 
 #endif 
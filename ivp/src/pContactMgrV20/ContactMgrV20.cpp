@@ -23,16 +23,13 @@
 
 #include <unistd.h>
 #include <cmath>
-#include "LinearExtrapolator.h"
 #include "ContactMgrV20.h"
 #include "MBUtils.h"
 #include "AngleUtils.h"
 #include "ColorParse.h"
-#include "CPAEngine.h"
 #include "NodeRecordUtils.h"
 #include "XYCircle.h"
 #include "ACTable.h"
-#include "RangeMark.h"
 
 using namespace std;
 
@@ -60,6 +57,7 @@ ContactMgrV20::ContactMgrV20()
   m_alert_verbose = false;
   m_decay_start = 15;
   m_decay_end   = 30;
+  m_ledger.setDecay(m_decay_start, m_decay_end);
 
   m_max_retired_hist = 5;
   m_use_geodesy = false;
@@ -324,6 +322,8 @@ void ContactMgrV20::registerVariables()
 //            X=29.66,Y=-23.49, LAT=43.825089,LON=-70.330030, 
 //            SPD=2.00,HDG=119.06,YAW=119.05677,DEPTH=0.00,     
 //            LENGTH=4.0,MODE=DRIVE
+//      Note: The report may also be in the binary encoded form,
+//            which string2NodeRecord() recognizes.
 
 void ContactMgrV20::handleMailNodeReport(string report)
 {
@@ -391,12 +391,11 @@ void ContactMgrV20::handleMailNodeReport(string report)
     newly_known_vehicle = true;
    
   m_map_node_records[vname] = new_node_record;
+  m_ledger.processRecord(new_node_record, false);
+  m_age_expiry.schedule(vname, new_node_record.getTimeStamp() +
+			m_contact_max_age);
   
   if(newly_known_vehicle) {
-    m_map_node_ranges_actual[vname] = 0;
-    m_map_node_ranges_extrap[vname] = 0;
-    m_map_node_ranges_cpa[vname]    = 0;
-
     m_par.addVehicle(vname);
 
     if(m_alert_verbose) 
@@ -491,6 +490,7 @@ void ContactMgrV20::handleMailReportRequest(string str, string src)
     // just update the current time.
     m_map_rep_reqtime[moos_var] = m_curr_time;
     m_map_rep_refresh[moos_var] = refresh;
+    m_rep_expiry.schedule(moos_var, m_curr_time + m_range_report_timeout);
   }
 }
 
@@ -567,6 +567,7 @@ bool ContactMgrV20::handleConfigDecay(string decay_str)
   if((start >= 0) && (start <= end)) {
     m_decay_start = start;
     m_decay_end   = end;
+    m_ledger.setDecay(m_decay_start, m_decay_end);
     return(true);
   }  
   return(false);
@@ -725,26 +726,13 @@ bool ContactMgrV20::handleConfigAlert(string alert_str, string source)
 
 void ContactMgrV20::pruneRangeReports()
 {
-  // Part 1: Identify the oldest report
+  // Part 1: Identify the oldest report, if it has timed out. The
+  // expiry queue holds each report keyed on request time + timeout.
   string oldest_varname;
-  double oldest_age = 0;
-  
-  map<string, double>::iterator p;
-  for(p=m_map_rep_reqtime.begin(); p!=m_map_rep_reqtime.end(); p++) {
-    string varname = p->first;
-    double reqtime = p->second;
-    double age = m_curr_time - reqtime;
-
-    if(age < m_range_report_timeout)
-      continue;
-    
-    if((oldest_varname == "") || (age > oldest_age)) {
-      oldest_varname = varname;
-      oldest_age = age;
-    }
-  }
-
-  if(oldest_varname == "")
+  double deadline = 0;
+  if(!m_rep_expiry.peekNext(oldest_varname, deadline))
+    return;
+  if(deadline > m_curr_time)
     return;
   
   // Part 2: Remove from memory the oldest report
@@ -754,6 +742,7 @@ void ContactMgrV20::pruneRangeReports()
   m_map_rep_vtype.erase(oldest_varname);
   m_map_rep_contacts.erase(oldest_varname);
   m_map_rep_refresh.erase(oldest_varname);
+  m_rep_expiry.cancel(oldest_varname);
 }
 
 
@@ -778,30 +767,27 @@ void ContactMgrV20::postRangeReports()
     // Part 2A: Get the list of contacts for this report
     string contacts;   
     vector<string> vcontacts;
-    map<string, double>::iterator q;
-    for(q=m_map_node_ranges_extrap.begin();
-	q!=m_map_node_ranges_extrap.end(); q++) {
+    map<string, NodeRecord>::iterator q;
+    for(q=m_map_node_records.begin(); q!=m_map_node_records.end(); q++) {
       string vname = q->first;
 
       // Part 2AA: If report specifies group, check contact for match
       bool group_match = true;
       if(m_map_rep_group[varname] != "") { 
-	if(tolower(m_map_rep_group[varname]) !=
-	   tolower(m_map_node_records[vname].getGroup()))
+	if(tolower(m_map_rep_group[varname]) != tolower(q->second.getGroup()))
 	  group_match = false;
       }
 
       // Part 2AB: If report specifies vtype, check contact for match
       bool vtype_match = true;
       if(m_map_rep_vtype[varname] != "") {
-	if(tolower(m_map_rep_vtype[varname]) !=
-	   tolower(m_map_node_records[vname].getType()))
+	if(tolower(m_map_rep_vtype[varname]) != tolower(q->second.getType()))
 	  vtype_match = false;
       }
 
       // Part 2AC: Check if the range is satisfied
       bool range_sat = false;
-      double now_range = q->second;
+      double now_range = m_ledger.getRangeExt(vname);
       if(now_range < rthresh) 
 	range_sat = true;
 
@@ -860,18 +846,23 @@ void ContactMgrV20::postSummaries()
   double closest_relbng = 0;
 
   list<double> ranges;
+
+  // recaps may be configured "off" and the interval would be -1.
+  // The recap string is only built when a recap posting is due.
+  double time_since_last_recap = m_curr_time - m_contacts_recap_posted;
+  bool recap_due = ((m_contacts_recap_interval > 0) &&
+		    (time_since_last_recap > m_contacts_recap_interval));
   
   map<string, NodeRecord>::const_iterator p;
   for(p=m_map_node_records.begin(); p!= m_map_node_records.end(); p++) {
-    string     contact_name = p->first;
-    NodeRecord node_record  = p->second;
+    string contact_name = p->first;
+    const NodeRecord& node_record = p->second;
 
     if(contacts_list != "")
       contacts_list += ",";
     contacts_list += contact_name;
 
-    double age   = m_curr_time - node_record.getTimeStamp();
-    double range = m_map_node_ranges_actual[contact_name];
+    double range = m_ledger.getRange(contact_name);
 
     ranges.push_front(range);
     
@@ -880,16 +871,18 @@ void ContactMgrV20::postSummaries()
       closest_contact = contact_name;
       closest_range   = range;
 
-      double cnx = m_map_node_records[contact_name].getX();
-      double cny = m_map_node_records[contact_name].getY();
-      closest_relbng  = relBearing(m_osx, m_osy, m_osh, cnx, cny);
+      double bng = m_ledger.getBearing(contact_name);
+      closest_relbng  = angle360(bng - m_osh);
+    }
+
+    if(recap_due) {
+      double age = m_curr_time - node_record.getTimeStamp();
+      if(contacts_recap != "")
+	contacts_recap += " # ";
+      contacts_recap += "vname=" + contact_name;
+      contacts_recap += ",range=" + doubleToString(range, 2);
+      contacts_recap += ",age=" + doubleToString(age, 2);
     }
-	
-    if(contacts_recap != "")
-      contacts_recap += " # ";
-    contacts_recap += "vname=" + contact_name;
-    contacts_recap += ",range=" + doubleToString(range, 2);
-    contacts_recap += ",age=" + doubleToString(age, 2);
   }
 
   
@@ -940,11 +933,7 @@ void ContactMgrV20::postSummaries()
     m_prev_contacts_alerted = contacts_alerted;
   }
 
-  double time_since_last_recap = m_curr_time - m_contacts_recap_posted;
-
-  // recaps may be configured "off" and the interval would be -1.
-  if((m_contacts_recap_interval > 0) &&
-     (time_since_last_recap > m_contacts_recap_interval)) {
+  if(recap_due) {
     m_contacts_recap_posted = m_curr_time;
     Notify("CONTACTS_RECAP", contacts_recap);
     m_prev_contacts_recap = contacts_recap;
@@ -981,8 +970,17 @@ void ContactMgrV20::checkForAlerts()
   //==============================================================
   map<string, NodeRecord>::iterator p;
   for(p=m_map_node_records.begin(); p!=m_map_node_records.end(); p++) {
-    string     contact = p->first;
-    NodeRecord record  = p->second;
+    string contact = p->first;
+    const NodeRecord& record = p->second;
+
+    // Ranges are from the snapshot taken in updateRanges()
+    double range_actual = 0;
+    double range_cpa    = 0;
+    int ix = m_ledger.getID(contact);
+    if(ix >= 0) {
+      range_actual = m_ledger.getRangeByID(ix);
+      range_cpa    = m_ledger.getRangeCPAByID(ix);
+    }
     
     //==============================================================
     // For each alert_id, check if alert should be posted for this contact
@@ -991,7 +989,8 @@ void ContactMgrV20::checkForAlerts()
     for(q=m_map_alerts.begin(); q!=m_map_alerts.end(); q++) {
       string id = q->first;
 
-      bool alert_applies = checkAlertApplies(contact, id);
+      bool alert_applies = checkAlertApplies(record, id, range_actual,
+					     range_cpa);
 
       // If alert applies and currently not alerted, handle
       string transition;
@@ -1017,12 +1016,9 @@ void ContactMgrV20::checkForAlerts()
 	mval += ",alert_range=" + doubleToStringX(alert_range,1);
 	mval += ",alert_range_cpa=" + doubleToStringX(alert_range_cpa,1);
 	
-	double range_actual = m_map_node_ranges_actual[contact];
 	mval += ",range_actual=" + doubleToString(range_actual,1);	
-	if(m_par.getAlertedValue(contact,id)) {
-	  double range_cpa = m_map_node_ranges_cpa[contact];
+	if(m_par.getAlertedValue(contact,id))
 	  mval += ",range_cpa=" + doubleToString(range_cpa,1);
-	}
 	
 	Notify(mvar, mval);
       }
@@ -1046,23 +1042,24 @@ void ContactMgrV20::checkForNewRetiredContacts()
   // To-be-retired set starts with the vnames flagged when receiving
   // node reports, that did not survive one of the filter criteria
   set<string> to_be_retired = m_filtered_vnames;
-  map<string, NodeRecord>::iterator p;
-  for(p=m_map_node_records.begin(); p!=m_map_node_records.end(); p++) {
-    string     contact  = p->first;
-    NodeRecord record   = p->second;
-
-    // Possibly drop due to age
-    double age = m_curr_time - record.getTimeStamp();
-    if(age > m_contact_max_age) 
-      to_be_retired.insert(contact);
-
-    // Possibly drop due to reject_range. 
-    else if(m_map_node_ranges_actual.count(contact) && (m_reject_range > 0)) {
-      // Reject range adjusted 5pct higher to avoid thrashing
-      double adjusted_reject_range = m_reject_range * 1.05;
-      if(m_map_node_ranges_actual[contact] > adjusted_reject_range) {
+
+  // Possibly drop due to age. Only contacts whose deadline has passed
+  // are popped from the expiry queue, no need to check all contacts.
+  vector<string> expired = m_age_expiry.popExpired(m_curr_time);
+  for(unsigned int i=0; i<expired.size(); i++)
+    to_be_retired.insert(expired[i]);
+
+  // Possibly drop due to reject_range. 
+  if(m_reject_range > 0) {
+    // Reject range adjusted 5pct higher to avoid thrashing
+    double adjusted_reject_range = m_reject_range * 1.05;
+    map<string, NodeRecord>::iterator p;
+    for(p=m_map_node_records.begin(); p!=m_map_node_records.end(); p++) {
+      string contact = p->first;
+      if(to_be_retired.count(contact))
+	continue;
+      if(m_ledger.getRange(contact) > adjusted_reject_range)
 	to_be_retired.insert(contact);
-      }
     }
   }
 
@@ -1123,10 +1120,9 @@ void ContactMgrV20::checkForNewRetiredContacts()
 
     // (b) Free up any memory associated with this contact
     m_map_node_records.erase(contact);
-    m_map_node_ranges_actual.erase(contact);
-    m_map_node_ranges_extrap.erase(contact);
-    m_map_node_ranges_cpa.erase(contact);
+    m_ledger.removeVName(contact);
     m_par.removeVehicle(contact);
+    m_age_expiry.cancel(contact);
   }
 
   // Part 3: Clear the set of filtered_vnames. This list should start
@@ -1237,50 +1233,14 @@ void ContactMgrV20::updateRanges()
 {
   double alert_range_cpa_time = 36000; // 10 hours
 
-  map<string, NodeRecord>::iterator p;
-  for(p=m_map_node_records.begin(); p!=m_map_node_records.end(); p++) {
-    string     vname = p->first;
-    NodeRecord node_record = p->second;
-
-    // First figure out the raw range to the contact
-    double cnx = node_record.getX();
-    double cny = node_record.getY();
-    double cnh = node_record.getHeading();
-    double cns = node_record.getSpeed();
-    double cnt = node_record.getTimeStamp();
-
-    // #1 Determine and store the actual point-to-point range between
-    // ownship and the last absolute known position of the contact
-    double range_actual = hypot((m_osx - cnx), (m_osy - cny));
-    m_map_node_ranges_actual[vname] = range_actual;
-
-    // #2 Determine and store the extrapolated range between ownship
-    // and the contact position determined by its last known range and
-    // extrapolation.
-    LinearExtrapolator linex;
-    linex.setDecay(m_decay_start, m_decay_end);
-    linex.setPosition(cnx, cny, cns, cnh, cnt);
-
-    double extrap_x = cnx;
-    double extrap_y = cny;
-    double range_extrap = range_actual;
-
-    bool ok = linex.getPosition(extrap_x, extrap_y, m_curr_time);
-    if(ok) {
-      cnx = extrap_x;
-      cny = extrap_y;
-      range_extrap = hypot((m_osx - cnx), (m_osy - cny));
-    }
-    m_map_node_ranges_extrap[vname] = range_extrap;
-
-    // #3 Determine and store the cpa range between ownship and the
-    // contact position determined by the contact's extrapolated position
-    // and it's last known heading and speed.
-    CPAEngine engine(cny, cnx, cnh, cns, m_osy, m_osx);      
-    double range_cpa = engine.evalCPA(m_osh, m_osv,
-				      alert_range_cpa_time);
-    m_map_node_ranges_cpa[vname] = range_cpa;
-  }
+  // In one pass over all contacts: (1) extrapolate the position of
+  // each contact from its last report, with decay, then (2) find
+  // the actual range, extrapolated range and bearing to each, and
+  // the cpa range from the extrapolated position given the contact's
+  // last known heading and speed.
+  m_ledger.setCurrTimeUTC(m_curr_time);
+  m_ledger.extrapolateAll();
+  m_ledger.updateRanges(m_osx, m_osy, m_osh, m_osv, alert_range_cpa_time);
 }
 
 //---------------------------------------------------------
@@ -1348,8 +1308,12 @@ void ContactMgrV20::postRadii(bool active)
 
 //---------------------------------------------------------
 // Procedure: checkAlertApplies()
+//      Note: Ranges are passed in from the snapshot taken in
+//            updateRanges() for this iteration.
 
-bool ContactMgrV20::checkAlertApplies(string contact, string id) 
+bool ContactMgrV20::checkAlertApplies(const NodeRecord& record, string id,
+				      double contact_range_abs,
+				      double contact_range_cpa) 
 {
   //=========================================================
   // Part 1: Sanity checks
@@ -1359,11 +1323,8 @@ bool ContactMgrV20::checkAlertApplies(string contact, string id)
     return(false);
   if(!m_map_alerts.at(id).valid())
     return(false);
-  if(m_map_node_records.count(contact) == 0)
-    return(false);
 
   // Return false immediately if age of node record exceeds max age
-  NodeRecord record = m_map_node_records.at(contact);
   double age = m_curr_time - record.getTimeStamp();
   if(age > m_contact_max_age)
     return(false);
@@ -1384,9 +1345,6 @@ bool ContactMgrV20::checkAlertApplies(string contact, string id)
   // If alert range is not positive, regarded as having the range
   // criteria OFF. Likely this alert depends only on the region.
   if(alert_range > 0) {
-    double contact_range_abs = m_map_node_ranges_actual[contact]; 
-    double contact_range_cpa = m_map_node_ranges_cpa[contact];    
-    
     if(contact_range_abs > alert_range_cpa)
       return(false);
     
@@ -1463,26 +1421,13 @@ vector<VarDataPair> ContactMgrV20::getAlertOffFlags(string alert_id) const
 
 list<string> ContactMgrV20::getRangeOrderedContacts() const
 {
-  list<string> to_be_returned_ordered_list;
-
-  list<RangeMark> working_list;
-  map<string,double>::const_iterator p;
-  for(p=m_map_node_ranges_actual.begin(); p!=m_map_node_ranges_actual.end(); p++) {
-    string vname = p->first;
-    double range = p->second;
-    RangeMark range_mark(vname, range);
-    working_list.push_front(range_mark);
-  }
+  list<string> ordered_list;
 
-  working_list.sort();
-
-  list<RangeMark>::iterator q;
-  for(q=working_list.begin(); q!=working_list.end(); q++) {
-    RangeMark range_mark = *q;
-    to_be_returned_ordered_list.push_back(range_mark.getContact());
-  }
+  vector<unsigned int> ids = m_ledger.getRangeOrderedIDs();
+  for(unsigned int i=0; i<ids.size(); i++)
+    ordered_list.push_back(m_ledger.getVNameByID(ids[i]));
 
-  return(to_be_returned_ordered_list);
+  return(ordered_list);
 }
 
 
@@ -1607,7 +1552,7 @@ bool ContactMgrV20::buildReport()
     contacts_reported++;
     if(contacts_reported < 8) {
       string vname = q->first;
-      string range = doubleToString(m_map_node_ranges_actual[vname], 1);
+      string range = doubleToString(m_ledger.getRange(vname), 1);
       string alerts_total  = uintToString(m_par.getAlertsTotal(vname));
       string alerts_active = uintToString(m_par.getAlertsActive(vname));
       actab << vname << range << alerts_total << alerts_active;
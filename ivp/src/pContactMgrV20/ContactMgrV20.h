@@ -28,10 +28,12 @@
 #include "MOOS/libMOOS/Thirdparty/AppCasting/AppCastingMOOSApp.h"
 #include "MOOS/libMOOSGeodesy/MOOSGeodesy.h"
 #include "NodeRecord.h"
+#include "ContactLedger.h"
 #include "XYPolygon.h"
 #include "PlatformAlertRecord.h"
 #include "CMAlert.h"
 #include "ExFilterSet.h"
+#include "ExpiryQueue.h"
 
 class ContactMgrV20 : public AppCastingMOOSApp
 {
@@ -75,7 +77,8 @@ class ContactMgrV20 : public AppCastingMOOSApp
   void postOffAlerts(NodeRecord, std::string id);
   void postAlert(NodeRecord, VarDataPair);
 
-  bool checkAlertApplies(std::string contact, std::string id);
+  bool checkAlertApplies(const NodeRecord&, std::string id,
+			 double range_abs, double range_cpa);
   bool knownAlert(std::string id) const;
 
   void checkForNewRetiredContacts();
@@ -149,12 +152,19 @@ class ContactMgrV20 : public AppCastingMOOSApp
   std::map<std::string, std::string> m_map_rep_vtype;
   std::map<std::string, std::string> m_map_rep_contacts;
   std::map<std::string, bool>        m_map_rep_refresh;
+
+  // Range report variables keyed on request time plus timeout
+  ExpiryQueue m_rep_expiry;
   
   // Main Record #2: The Vehicles (contacts) and position info
   std::map<std::string, NodeRecord>   m_map_node_records;
-  std::map<std::string, double>       m_map_node_ranges_actual;
-  std::map<std::string, double>       m_map_node_ranges_extrap;
-  std::map<std::string, double>       m_map_node_ranges_cpa;
+
+  // Columnar snapshot of contact positions, extrapolated positions
+  // and ranges, updated once per iteration in updateRanges()
+  ContactLedger m_ledger;
+
+  // Contacts keyed on report timestamp plus contact_max_age
+  ExpiryQueue m_age_expiry;
 
   std::string m_closest_name;
 
@@ -55,6 +55,7 @@ HelmEngine::HelmEngine(IvPDomain g_ivp_domain,
   m_max_loop_time   = 0;
   m_max_solve_time  = 0;
   m_max_create_time = 0;
+  m_max_spawn_time  = 0;
 }
 
 //-----------------------------------------------------------
@@ -101,6 +102,11 @@ HelmReport HelmEngine::determineNextDecision(BehaviorSet *bhv_set,
   
   bool filter_behaviors_present = bhv_set->filterBehaviorsPresent();
 
+  m_profiler.beginIteration(m_iteration);
+  double prof_start = 0;
+  if(m_profiler.isEnabled())
+    prof_start = HelmProfiler::getWallTime();
+
   bool handled = true;
   handled = handled && part1_PreliminaryBehaviorSetHandling();
   handled = handled && part2_GetFunctionsFromBehaviorSet(0);
@@ -116,6 +122,11 @@ HelmReport HelmEngine::determineNextDecision(BehaviorSet *bhv_set,
   handled = handled && part5_FreeMemoryIPFs();
   handled = handled && part6_FinishHelmReport();
 
+  if(m_profiler.isEnabled()) {
+    double prof_time = HelmProfiler::getWallTime() - prof_start;
+    m_profiler.addStageTime("total", prof_time);
+    m_profiler.endIteration();
+  }
 
   return(m_helm_report);
 }
@@ -125,6 +136,8 @@ HelmReport HelmEngine::determineNextDecision(BehaviorSet *bhv_set,
 
 bool HelmEngine::part1_PreliminaryBehaviorSetHandling()
 {
+  HelmProfileTimer ptimer(&m_profiler, "prelim");
+
   m_helm_report.setIvPDomain(m_ivp_domain);
   m_helm_report.setIteration(m_iteration);
   m_helm_report.setTimeUTC(m_curr_time);
@@ -139,10 +152,16 @@ bool HelmEngine::part1_PreliminaryBehaviorSetHandling()
     m_bhv_set->resetStateOK();
 
   m_bhv_set->setCurrTime(m_curr_time);
-
-  bool new_behaviors = m_bhv_set->handlePossibleSpawnings();
-  if(new_behaviors)
-    m_bhv_set->connectInfoBuffer(m_info_buffer);
+  m_bhv_set->setProfiler(&m_profiler);
+
+  m_spawn_timer.start();
+  {
+    HelmProfileTimer ptimer(&m_profiler, "spawn");
+    bool new_behaviors = m_bhv_set->handlePossibleSpawnings();
+    if(new_behaviors)
+      m_bhv_set->connectInfoBuffer(m_info_buffer);
+  }
+  m_spawn_timer.stop();
 
   // Update the PlatModel for each behavior including newly
   // spawned behaviors.
@@ -166,6 +185,8 @@ bool HelmEngine::part1_PreliminaryBehaviorSetHandling()
 
 bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 {
+  HelmProfileTimer ptimer(&m_profiler, "create");
+
   int bhv_ix, bhv_cnt = m_bhv_set->size();
 
   m_bhv_set->clearUpdateResults();
@@ -181,6 +202,9 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
       string bhv_state;
       bool   ipf_reuse = false;
       m_ipf_timer.start();
+      double prof_start = 0;
+      if(m_profiler.isEnabled())
+	prof_start = HelmProfiler::getWallTime();
       IvPFunction *newof = m_bhv_set->produceOF(bhv_ix, m_iteration,
 						bhv_state, ipf_reuse);
 
@@ -210,6 +234,15 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 
       m_ipf_timer.stop();
 
+      if(m_profiler.isEnabled()) {
+	double prof_time = HelmProfiler::getWallTime() - prof_start;
+	unsigned int prof_pcs = 0;
+	if(newof)
+	  prof_pcs = (unsigned int)(newof->size());
+	m_profiler.addBehaviorTime(m_bhv_set->getDescriptor(bhv_ix),
+				   prof_time, prof_pcs);
+      }
+
       // Determine the amt of time the bhv has been in this state
       // double state_elapsed = m_bhv_set->getStateElapsed(bhv_ix);
       double state_time_entered = m_bhv_set->getStateTimeEntered(bhv_ix);
@@ -305,6 +338,8 @@ bool HelmEngine::part2_GetFunctionsFromBehaviorSet(int filter_level)
 
 bool HelmEngine::part3_VerifyFunctionDomains()
 {
+  HelmProfileTimer ptimer(&m_profiler, "verify");
+
 #if 0
   // First build a vector of unique domain names strings from
   // all the objective functions.
@@ -401,6 +436,8 @@ bool HelmEngine::part3_VerifyFunctionDomains()
 
 bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
 {
+  HelmProfileTimer ptimer(&m_profiler, "solve");
+
 #if 0
   unsigned int i, ipfs = m_ivp_functions.size(); 
   m_helm_report.addMsg("Number of IvP Functions: " + intToString(ipfs)); 
@@ -474,6 +511,8 @@ bool HelmEngine::part4_BuildAndSolveIvPProblem(string phase)
 
 bool HelmEngine::part5_FreeMemoryIPFs()
 {
+  HelmProfileTimer ptimer(&m_profiler, "free");
+
   map<string, IvPFunction*>::iterator p;
   for(p=m_map_ipfs_prev.begin(); p!=m_map_ipfs_prev.end(); p++) {
     IvPFunction* ipf = p->second;
@@ -491,6 +530,8 @@ bool HelmEngine::part5_FreeMemoryIPFs()
 
 bool HelmEngine::part6_FinishHelmReport()
 {
+  HelmProfileTimer ptimer(&m_profiler, "report");
+
   // We prefer to base the times on CPU vs Wall time. But if we change
   // our minds, the below two lines should do the trick.
   // double create_time = m_create_timer.get_float_wall_time();
@@ -498,11 +539,14 @@ bool HelmEngine::part6_FinishHelmReport()
 
   double create_time = m_create_timer.get_float_cpu_time();
   double solve_time  = m_solve_timer.get_float_cpu_time();
+  double spawn_time  = m_spawn_timer.get_float_cpu_time();
   double loop_time = create_time + solve_time;
   m_create_timer.reset();
   m_solve_timer.reset();
+  m_spawn_timer.reset();
   m_helm_report.setCreateTime(create_time);
   m_helm_report.setSolveTime(solve_time);
+  m_helm_report.setSpawnTime(spawn_time);
 
   if(create_time > m_max_create_time)
     m_max_create_time = create_time;
@@ -510,10 +554,13 @@ bool HelmEngine::part6_FinishHelmReport()
     m_max_solve_time = solve_time;
   if(loop_time > m_max_loop_time)
     m_max_loop_time = loop_time;
+  if(spawn_time > m_max_spawn_time)
+    m_max_spawn_time = spawn_time;
 
   m_helm_report.setMaxCreateTime(m_max_create_time);
   m_helm_report.setMaxSolveTime(m_max_solve_time);
   m_helm_report.setMaxLoopTime(m_max_loop_time);
+  m_helm_report.setMaxSpawnTime(m_max_spawn_time);
   m_helm_report.setTotalPcsFormed(m_total_pcs_formed);
   m_helm_report.setTotalPcsCached(m_total_pcs_cached);
 
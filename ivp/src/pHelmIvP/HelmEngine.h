@@ -29,6 +29,7 @@
 #include <vector>
 #include "IvPDomain.h"
 #include "HelmReport.h"
+#include "HelmProfiler.h"
 #include "MBTimer.h"
 #include "PlatModelGenerator.h"
 #include "PlatModel.h"
@@ -43,9 +44,14 @@ public:
   ~HelmEngine();
 
   void setPlatModel(const PlatModel& pm) {m_pmodel=pm;}
+  void setProfiling(bool v)               {m_profiler.setEnabled(v);}
+  bool setProfileWindow(unsigned int v)   {return(m_profiler.setWindow(v));}
   HelmReport determineNextDecision(BehaviorSet *bset, double curr_time);
 
   unsigned long int size() const;
+
+  std::string   getProfileSpec() const {return(m_profiler.getSpec());}
+  HelmProfiler* getProfiler()          {return(&m_profiler);}
   
 protected:
   bool   checkOFDomains(std::vector<IvPFunction*>);
@@ -75,6 +81,9 @@ protected:
   double       m_max_create_time;
   double       m_max_solve_time;
   double       m_max_loop_time;
+  double       m_max_spawn_time;
+
+  HelmProfiler m_profiler;
 
   std::map<std::string, IvPFunction*> m_map_ipfs;
   std::map<std::string, IvPFunction*> m_map_ipfs_prev;
@@ -82,6 +91,7 @@ protected:
   MBTimer  m_create_timer;
   MBTimer  m_ipf_timer;
   MBTimer  m_solve_timer;
+  MBTimer  m_spawn_timer;
 };
 
 #endif
@@ -63,6 +63,10 @@ HelmIvP::HelmIvP()
   m_ok_skew        = 60; 
   m_skews_matter   = true;
   m_goals_mandatory = false; 
+  m_profile          = false;
+  m_profile_interval = 5;
+  m_profile_window   = 100;
+  m_profile_last_post = 0;
   m_helm_start_time = 0;
   m_curr_time      = 0;
   m_start_time     = 0;
@@ -81,6 +85,7 @@ HelmIvP::HelmIvP()
 
   m_allow_override  = true;
   m_park_on_allstop = false;
+  m_spawn_prototypes = true;
 
   m_ibuffer_curr_time_updated = false;
 
@@ -137,6 +142,8 @@ void HelmIvP::handlePrepareRestart()
     if(m_info_buffer)
       delete(m_info_buffer);
     m_info_buffer = 0;
+    m_info_slots.clear();
+    m_contact_slots.clear();
   }
 #endif
 
@@ -200,6 +207,7 @@ bool HelmIvP::OnNewMail(MOOSMSG_LIST &NewMail)
     string sval      = msg.GetString();
     string source    = msg.GetSource();
     string community = msg.GetCommunity();
+    unsigned int slot = infoSlot(moosvar);
     
     double skew_time;
     msg.IsSkewed(m_curr_time, &skew_time);
@@ -250,7 +258,7 @@ bool HelmIvP::OnNewMail(MOOSMSG_LIST &NewMail)
 	  helmStatusUpdate();
 	}
       }
-      updateInfoBuffer(msg);
+      updateInfoBuffer(msg, slot);
     }
     else if(moosvar == "IVPHELM_STATE") {
       m_init_vars_ready = true;
@@ -302,20 +310,20 @@ bool HelmIvP::OnNewMail(MOOSMSG_LIST &NewMail)
       bool ok = processNodeReport(sval);
       if(!ok)
 	reportRunWarning("Unhandled NODE_REPORT");
-      updateInfoBuffer(msg);
+      updateInfoBuffer(msg, slot);
     }
     else if(moosvar == m_refresh_var) {
       m_refresh_pending = true;
     }
     else
-      updateInfoBuffer(msg);
+      updateInfoBuffer(msg, slot);
   }
 
   // COMMS_POLICY mail is handled at the AppCastingMOOSApp superclass
   // level. The current state of the comms policy is a member variable
   // of this class (superclass). Pass along this value to the
   // info_buffer.
-  m_info_buffer->setValue("COMMS_POLICY", commsPolicy(), m_curr_time);
+  m_info_buffer->setValue(infoSlot("COMMS_POLICY"), commsPolicy(), m_curr_time);
   
   if(helmStatus() == "STANDBY")
     checkForTakeOver();
@@ -384,6 +392,10 @@ bool HelmIvP::Iterate()
   updatePlatModel();
   m_helm_report = m_hengine->determineNextDecision(m_bhv_set, m_curr_time);
 
+  // Everything from here on posts the results of the decision. It is
+  // profiled as one stage, folded in with the next helm iteration.
+  HelmProfileTimer ptimer(m_hengine->getProfiler(), "post");
+
 #if 0 // mikerb jan 2016 debug
   vector<string> msgs = m_helm_report.getMsgs();
   m_helm_iteration = m_helm_report.getIteration();
@@ -434,6 +446,12 @@ bool HelmIvP::Iterate()
   Notify("IVPHELM_TOTAL_PCS_FORMED", m_helm_report.getTotalPcsFormed());
   Notify("IVPHELM_TOTAL_PCS_CACHED", m_helm_report.getTotalPcsCached());
 
+  if(m_profile &&
+     ((m_curr_time - m_profile_last_post) >= m_profile_interval)) {
+    Notify("IVPHELM_PROFILE", m_hengine->getProfileSpec());
+    m_profile_last_post = m_curr_time;
+  }
+
   string bhvs_active_list = m_helm_report.getActiveBehaviors(false);
   if(m_bhvs_active_list != bhvs_active_list) {
     Notify("IVPHELM_BHV_ACTIVE", bhvs_active_list); 
@@ -505,6 +523,7 @@ bool HelmIvP::Iterate()
   
   Notify("IVPHELM_CREATE_CPU", m_helm_report.getCreateTime());
   Notify("IVPHELM_LOOP_CPU", m_helm_report.getLoopTime());
+  Notify("IVPHELM_SPAWN_CPU", m_helm_report.getSpawnTime());
 
   bool changed_update_vars = m_bhv_set->refreshMapUpdateVars();
   if(changed_update_vars)
@@ -606,7 +625,7 @@ void HelmIvP::postBehaviorMessages()
       // Otherwise just post to the DB directly.
       else {
 	if(msg_is_string) {
-	  m_info_buffer->setValue(var, sdata);
+	  m_info_buffer->setValue(infoSlot(var), sdata);
 	  if(key_change || key_repeat) {
 	    string aux = intToString(m_helm_iteration) + ":" + 
 	      bhv_descriptor;
@@ -621,7 +640,7 @@ void HelmIvP::postBehaviorMessages()
 	  }
 	}
 	else {
-	  m_info_buffer->setValue(var, ddata);
+	  m_info_buffer->setValue(infoSlot(var), ddata);
 	  if(key_change || key_repeat) {
 	    string aux = intToString(m_helm_iteration) + ":" + 
 	      bhv_descriptor;
@@ -818,11 +837,11 @@ void HelmIvP::handleHelmStartMessages()
 
     if(!strContainsWhite(var)) {
       if(sdata != "") {
-	m_info_buffer->setValue(var, sdata);
+	m_info_buffer->setValue(infoSlot(var), sdata);
 	Notify(var, sdata, "HELM_STARTUP_MSG");
       }
       else {
-	m_info_buffer->setValue(var, ddata);
+	m_info_buffer->setValue(infoSlot(var), ddata);
 	Notify(var, ddata, "HELM_STARTUP_MSG");
       }
     }
@@ -859,11 +878,11 @@ void HelmIvP::handleInitialVarsPhase1()
       // info_buffer now.
       if(key == "post") {
 	if(sdata != "") {
-	  m_info_buffer->setValue(var, sdata);
+	  m_info_buffer->setValue(infoSlot(var), sdata);
 	  Notify(var, sdata, "HELM_VAR_INIT");
 	}
 	else {
-	  m_info_buffer->setValue(var, ddata);
+	  m_info_buffer->setValue(infoSlot(var), ddata);
 	  Notify(var, ddata, "HELM_VAR_INIT");
 	}
       }
@@ -899,11 +918,11 @@ void HelmIvP::handleInitialVarsPhase2()
 
     if((key == "defer") && !m_info_buffer->isKnown(var)) {
       if(sdata != "") {
-	m_info_buffer->setValue(var, sdata);
+	m_info_buffer->setValue(infoSlot(var), sdata);
 	Notify(var, sdata, "HELM_VAR_INIT");
       }
       else {
-	m_info_buffer->setValue(var, ddata);
+	m_info_buffer->setValue(infoSlot(var), ddata);
 	Notify(var, ddata, "HELM_VAR_INIT");
       }
     }
@@ -949,12 +968,12 @@ void HelmIvP::postDefaultVariables()
     if(!vectorContains(message_vars, var)) {
       if(msg.is_string()) {
 	string sdata  = msg.get_sdata();
-	m_info_buffer->setValue(var, sdata);
+	m_info_buffer->setValue(infoSlot(var), sdata);
 	Notify(var, sdata);
       }
       else {
 	double ddata  = msg.get_ddata();
-	m_info_buffer->setValue(var, ddata);
+	m_info_buffer->setValue(infoSlot(var), ddata);
 	Notify(var, ddata);
       }
     }
@@ -1054,19 +1073,18 @@ void HelmIvP::postCharStatus()
 //       batch of incoming mail. In this case we want to defer to 
 //       value posted by the other application.
 
-bool HelmIvP::updateInfoBuffer(CMOOSMsg &msg)
+bool HelmIvP::updateInfoBuffer(CMOOSMsg &msg, unsigned int slot)
 {
-  string moosvar  = msg.m_sKey;
   string src_aux  = msg.GetSourceAux();
   double msg_time = msg.GetTime();
   if(src_aux == "HELM_VAR_INIT")
     return(false);
 
   if(msg.IsDouble()) {
-    return(m_info_buffer->setValue(moosvar, msg.GetDouble(), msg_time));
+    return(m_info_buffer->setValue(slot, msg.GetDouble(), msg_time));
   }
   else if(msg.IsString()) {
-    return(m_info_buffer->setValue(moosvar, msg.GetString(), msg_time));
+    return(m_info_buffer->setValue(slot, msg.GetString(), msg_time));
   }
   return(false);
 }
@@ -1132,6 +1150,22 @@ void HelmIvP::registerNewVariables()
   }
 }
 
+//------------------------------------------------------------
+// Procedure: infoSlot()
+//   Purpose: Return the info_buffer slot of the given variable,
+//            resolving it with the info_buffer only on first sight.
+
+unsigned int HelmIvP::infoSlot(const string& var)
+{
+  map<string, unsigned int>::iterator p = m_info_slots.find(var);
+  if(p != m_info_slots.end())
+    return(p->second);
+
+  unsigned int slot = m_info_buffer->getSlot(var);
+  m_info_slots[var] = slot;
+  return(slot);
+}
+
 //------------------------------------------------------------
 // Procedure: registerSingleVariable
 
@@ -1144,6 +1178,8 @@ void HelmIvP::registerSingleVariable(string varname, double frequency)
   Notify("IVPHELM_REGISTER", varname);
   if(m_var_reg_time.count(varname) == 0)
     m_var_reg_time[varname] = m_curr_time;
+  if(m_info_buffer)
+    infoSlot(varname);
 }
 
 
@@ -1235,6 +1271,8 @@ bool HelmIvP::OnStartUp()
       handled = setBooleanOnString(m_allow_override, value);
     else if(param == "PARK_ON_ALLSTOP")
       handled = setBooleanOnString(m_park_on_allstop, value);
+    else if(param == "SPAWN_PROTOTYPES")
+      handled = setBooleanOnString(m_spawn_prototypes, value);
     else if(param == "NODE_SKEW") 
       handled = handleConfigNodeSkew(value);
     else if(param == "HELM_PREFIX") 
@@ -1253,6 +1291,12 @@ bool HelmIvP::OnStartUp()
       handled = handleConfigPMGen(value);
     else if(param == "OTHER_OVERRIDE_VAR") 
       handled = setNonWhiteVarOnString(m_additional_override, value);
+    else if(param == "PROFILE")
+      handled = setBooleanOnString(m_profile, value);
+    else if(param == "PROFILE_INTERVAL")
+      handled = setNonNegDoubleOnString(m_profile_interval, value);
+    else if(param == "PROFILE_WINDOW")
+      handled = setPosUIntOnString(m_profile_window, value);
 
     if(!handled)
       reportUnhandledConfigWarning(orig);
@@ -1269,6 +1313,8 @@ bool HelmIvP::OnStartUp()
   }
 
   m_hengine = new HelmEngine(m_ivp_domain, m_info_buffer);
+  m_hengine->setProfiling(m_profile);
+  m_hengine->setProfileWindow(m_profile_window);
 
   Populator_BehaviorSet *p_bset;
   p_bset = new Populator_BehaviorSet(m_ivp_domain, m_info_buffer);
@@ -1300,6 +1346,7 @@ bool HelmIvP::OnStartUp()
     MOOSTrace("NULL Behavior Set \n");
     return(false);
   }
+  m_bhv_set->setSpawnPrototypes(m_spawn_prototypes);
 
   // Set the "ownship" parameter for all behaviors
   unsigned int i, bsize = m_bhv_set->size();
@@ -1700,15 +1747,30 @@ bool HelmIvP::processNodeReport(const string& report)
   string raw_vname = new_record.getName();
   string vname = toupper(raw_vname);
   
-  m_info_buffer->setValue(vname+"_NAV_X", new_record.getX());
-  m_info_buffer->setValue(vname+"_NAV_Y", new_record.getY());
-  m_info_buffer->setValue(vname+"_NAV_SPEED", new_record.getSpeed());
-  m_info_buffer->setValue(vname+"_NAV_HEADING", new_record.getHeading());
-  m_info_buffer->setValue(vname+"_NAV_DEPTH", new_record.getDepth());
-  m_info_buffer->setValue(vname+"_NAV_LAT", new_record.getLat());
-  m_info_buffer->setValue(vname+"_NAV_LONG", new_record.getLon());
-  m_info_buffer->setValue(vname+"_NAV_GROUP", new_record.getGroup());
-  m_info_buffer->setValue(vname+"_NAV_TYPE", new_record.getType());
+  // Resolve this contact's info_buffer slots on its first report
+  vector<unsigned int>& slots = m_contact_slots[vname];
+  if(slots.empty()) {
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_X"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_Y"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_SPEED"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_HEADING"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_DEPTH"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_LAT"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_LONG"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_GROUP"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_TYPE"));
+    slots.push_back(m_info_buffer->getSlot(vname+"_NAV_UTC"));
+  }
+
+  m_info_buffer->setValue(slots[0], new_record.getX());
+  m_info_buffer->setValue(slots[1], new_record.getY());
+  m_info_buffer->setValue(slots[2], new_record.getSpeed());
+  m_info_buffer->setValue(slots[3], new_record.getHeading());
+  m_info_buffer->setValue(slots[4], new_record.getDepth());
+  m_info_buffer->setValue(slots[5], new_record.getLat());
+  m_info_buffer->setValue(slots[6], new_record.getLon());
+  m_info_buffer->setValue(slots[7], new_record.getGroup());
+  m_info_buffer->setValue(slots[8], new_record.getType());
 
   double timestamp = new_record.getTimeStamp();
   
@@ -1720,7 +1782,7 @@ bool HelmIvP::processNodeReport(const string& report)
     timestamp += p->second;
   // Done applying the skew
 
-  m_info_buffer->setValue(vname+"_NAV_UTC", timestamp);
+  m_info_buffer->setValue(slots[9], timestamp);
 
   return(true);
 }
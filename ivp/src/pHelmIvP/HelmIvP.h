@@ -60,7 +60,8 @@ public:
  protected:
   bool handleHeartBeat(const std::string&);
   void handlePrepareRestart();
-  bool updateInfoBuffer(CMOOSMsg &Msg);
+  bool updateInfoBuffer(CMOOSMsg &Msg, unsigned int slot);
+  unsigned int infoSlot(const std::string& var);
   void postHelmStatus();
   void postCharStatus();
   void postBehaviorMessages();
@@ -99,6 +100,7 @@ protected:
 
   bool          m_allow_override;
   bool          m_park_on_allstop;
+  bool          m_spawn_prototypes;
   std::string   m_allstop_msg;
   IvPDomain     m_ivp_domain;
   BehaviorSet*  m_bhv_set;
@@ -138,6 +140,12 @@ protected:
   double        m_ok_skew;
   bool          m_skews_matter;
   bool          m_goals_mandatory;
+
+  // Optional helm profiling, posted as IVPHELM_PROFILE
+  bool          m_profile;
+  double        m_profile_interval;
+  unsigned int  m_profile_window;
+  double        m_profile_last_post;
   
   unsigned int  m_prev_total_completed;
   std::string   m_prev_compl_pending;
@@ -183,6 +191,12 @@ protected:
   std::map<std::string, std::string>  m_outgoing_bhv;
   std::map<std::string, double>       m_outgoing_repinterval;
   std::map<std::string, double>       m_var_reg_time;
+
+  // The info_buffer slot of each variable the helm writes, resolved
+  // once on first sight. Per contact, the slots of its <VNAME>_NAV_*
+  // variables in the order written by processNodeReport().
+  std::map<std::string, unsigned int>               m_info_slots;
+  std::map<std::string, std::vector<unsigned int> > m_contact_slots;
   
   // A flag maintained on each iteration indicating whether the 
   // info_buffer curr_time has yet to be synched to the app curr_time.
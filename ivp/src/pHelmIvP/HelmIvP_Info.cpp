@@ -124,6 +124,17 @@ void showExampleConfigAndExit()
   blk("  // Insist that at least one non-constraint behavior be active ");
   blk("  goals_mandatory      = true  "," // or {true,FALSE}           ");
   blk("                                                                ");
+  blk("  // Spawn templated behaviors by cloning a prebuilt prototype  ");
+  blk("  spawn_prototypes     = true "," // or {false}                 ");
+  blk("                                                                ");
+  blk("  // Profile helm stage and per-behavior wall times, posted to  ");
+  blk("  // IVPHELM_PROFILE as p50/p90/max over a window of iterations ");
+  blk("  // Stages: prelim, spawn, create (cond, runstate, idlestate,  ");
+  blk("  // build), verify, solve, free, report, total and post.       ");
+  blk("  profile              = false "," // or {true,FALSE}           ");
+  blk("  profile_interval     = 5     "," // secs between postings     ");
+  blk("  profile_window       = 100   "," // iterations per percentile ");
+  blk("                                                                ");
   blk("  // Allow unfound bhv directories to not be a problem.         ");
   blk("  bhv_dir_not_found_ok = true "," // or {true,FALSE}            ");
   blk("                                                                ");
@@ -186,6 +197,7 @@ void showInterfaceAndExit()
   blk("                                                                ");
   blk("  IVPHELM_CREATE_CPU    = CPU time to create IvP functions      ");
   blk("  IVPHELM_LOOP_CPU      = CPU time to create and solve IvP prob ");
+  blk("  IVPHELM_SPAWN_CPU     = CPU time to spawn new behaviors       ");
   blk("                                                                ");
   blk("  IVPHELM_DOMAIN        = speed,0,4,21:course,0,359,36          ");
   blk("  IVPHELM_LIFE_EVENT    = Desc of behavior spawn or death       ");
@@ -195,6 +207,7 @@ void showInterfaceAndExit()
   blk("  IVPHELM_UPDATEVARS    = MOOS vars involved in behavior updates");
   blk("  IVPHELM_UPDATE_RESULT = Report on attempted behavior update   ");
   blk("  IVPHELM_SUMMARY       = A helm snapshot for use in uHelmScope ");
+  blk("  IVPHELM_PROFILE       = Stage and behavior timing percentiles ");
   blk("  IVPHELM_RESTARTED     = true when/if helm is RE-started       ");
   blk("  PLOGGER_CMD           = Request pLogger to copy the bhv file  ");
   blk("                                                                ");
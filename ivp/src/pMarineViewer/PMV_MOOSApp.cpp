@@ -355,6 +355,7 @@ void PMV_MOOSApp::handleNewMail(const MOOS_event & e)
     string   why_not;
 
     // Check for NODE_REPORT, NODE_REPORT_LOCAL, NODE_REPORT_UNC etc
+    // Reports may be strings or binary encoded (MOOS_BINARY_STRING)
     if(vectorContains(m_node_report_vars, key)) {
       m_node_reports_received++;
       if(m_node_report_start < 0)
@@ -411,13 +412,17 @@ void PMV_MOOSApp::handleNewMail(const MOOS_event & e)
 	string source = msg.GetSource();
 	if(msg.IsDouble())
 	  sval = doubleToStringX(msg.GetDouble(), 8);
+	else if(msg.IsBinary() && isBinaryNodeReport(sval))
+	  sval = string2NodeRecord(sval).getSpec();
 	m_gui->mviewer->updateScopeVariable(key, sval, mtime, source);
 	handled_scope = true;
       }
     }
 
     if(!handled && (key == "APPCAST")) {
-      handled = m_appcast_repo->addAppCast(sval);
+      // A delta ahead of its keyframe is dropped, but not unhandled
+      m_appcast_repo->addAppCast(sval);
+      handled = true;
       handled_appcast = true;
     }
 
@@ -1344,6 +1349,7 @@ void PMV_MOOSApp::postAppCastRequest(string channel_node,
   str += ",duration=" + doubleToString(duration, 1);
   str += ",key=" + key;
   str += ",thresh=" + threshold;
+  str += ",delta=true";
 
   Notify("APPCAST_REQ", str);
   Notify("APPCAST_REQ_"+toupper(channel_node), str);
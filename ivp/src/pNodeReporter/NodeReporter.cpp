@@ -59,6 +59,7 @@ NodeReporter::NodeReporter()
   m_helm_allstop_mode = "unknown";
   m_helm_switch_noted = false;
   m_terse_reports     = false;
+  m_binary_reports    = false;
 
   m_blackout_interval = 0;
   m_blackout_baseval  = 0;
@@ -396,6 +397,8 @@ bool NodeReporter::OnStartUp()
 
     else if(param == "terse_reports") 
       handled = setBooleanOnString(m_terse_reports, value);
+    else if(param == "binary_reports") 
+      handled = setBooleanOnString(m_binary_reports, value);
     else if(param == "blackout_interval") 
       handled = setNonNegDoubleOnString(m_blackout_interval, value);
     else if(param == "blackout_variance") 
@@ -613,12 +616,12 @@ bool NodeReporter::Iterate()
       crossFillCoords(m_record, m_nav_xy_updated, m_nav_latlon_updated);
     
     m_record.setIndex(m_reports_posted);
-    string report = assembleNodeReport(m_record);    
+    string report = assembleNodeReport(m_record, m_binary_reports);
 
     if(!m_paused) {
       if(m_reports_posted == 0) 
-	Notify(m_node_report_var+"_FIRST", report);
-      Notify(m_node_report_var, report);
+	postNodeReport(m_node_report_var+"_FIRST", report);
+      postNodeReport(m_node_report_var, report);
       Notify("PNR_POST_GAP", delta_time);
       m_reports_posted++;
       cout << "Posted:" << m_record.getSpec(true) << endl;
@@ -632,9 +635,9 @@ bool NodeReporter::Iterate()
 			m_nav_latlon_updated_gt);
       
       m_record_gt.setIndex(m_reports_posted);
-      string report_gt = assembleNodeReport(m_record_gt);
+      string report_gt = assembleNodeReport(m_record_gt, m_binary_reports);
       if(!m_paused) {
-	Notify(m_node_report_var, report_gt);
+	postNodeReport(m_node_report_var, report_gt);
 	m_reports_posted_alt_nav++;
       }
     }
@@ -794,8 +797,10 @@ string NodeReporter::assemblePlatformReport()
 //------------------------------------------------------------------
 // Procedure: assembleNodeReport
 //   Purpose: Assemble the node report from member variables.
+//      Note: If binary, the report is the compact binary encoding
+//            with rider reports carried as record properties.
 
-string NodeReporter::assembleNodeReport(NodeRecord record)
+string NodeReporter::assembleNodeReport(NodeRecord record, bool binary)
 {
   record.setTimeStamp(m_curr_time); 
 
@@ -832,15 +837,45 @@ string NodeReporter::assembleNodeReport(NodeRecord record)
   record.setMode(mode);
   record.setAllStop(m_helm_allstop_mode);
 
-  string summary = record.getSpec(m_terse_reports);
-
   string rider_reports = m_riderset.getRiderReports(m_curr_time);
+  if(binary) {
+    vector<string> svector = parseStringZ(rider_reports, ',', "{");
+    for(unsigned int i=0; i<svector.size(); i++) {
+      string field = biteStringX(svector[i], '=');
+      if(field != "")
+	record.setProperty(field, svector[i]);
+    }
+    string report;
+    if(nodeRecord2Binary(record, report, m_terse_reports))
+      return(report);
+    // Too long for the binary form. Publish this report in the
+    // string form, which carries the rider reports as properties.
+    return(record.getSpec(m_terse_reports));
+  }
+
+  string summary = record.getSpec(m_terse_reports);
   if(rider_reports != "")
     summary += "," + rider_reports;
 
   return(summary);
 }
 
+//------------------------------------------------------------------
+// Procedure: postNodeReport
+//   Purpose: Post a report made by assembleNodeReport(). Binary
+//            reports are posted as a MOOS_BINARY_STRING. A report
+//            that fell back to the string form is posted as a string.
+
+void NodeReporter::postNodeReport(const string& var, const string& report)
+{
+  if(!m_binary_reports || !isBinaryNodeReport(report)) {
+    Notify(var, report);
+    return;
+  }
+  vector<unsigned char> bytes(report.begin(), report.end());
+  Notify(var, bytes);
+}
+
 //------------------------------------------------------------------
 // Procedure: setCrossFillPolicy
 //      Note: Determines how or whether the local and global coords
@@ -1109,6 +1144,7 @@ bool NodeReporter::buildReport()
   m_msgs << "Node Report Summary:"                 << endl;
   m_msgs << "----------------------------"         << endl;
   m_msgs << "Reports Posted: " << m_reports_posted << endl;
+  m_msgs << "Binary Reports: " << boolToString(m_binary_reports) << endl;
   
   string report = assembleNodeReport(m_record);    
   ACBlock block(" Latest Report: ", report, 50);
@@ -49,7 +49,8 @@ public:
 
  protected:
   void handleLocalHelmSummary(const std::string&);
-  std::string assembleNodeReport(NodeRecord);
+  std::string assembleNodeReport(NodeRecord, bool binary=false);
+  void postNodeReport(const std::string& var, const std::string& report);
   std::string assemblePlatformReport();
   
   void updatePlatformVar(std::string, std::string);
@@ -72,6 +73,7 @@ public:
   double       m_nohelm_thresh;
   std::string  m_group_name;
   bool         m_terse_reports;
+  bool         m_binary_reports;
   bool         m_allow_color_change;
 
   // Sep 01, 2022
@@ -111,6 +111,9 @@ void showExampleConfigAndExit()
   blk("  // Configure the MOOS variable containg the node report       ");
   blu("  node_report_output = NODE_REPORT_LOCAL                        ");
   blk("                                                                ");
+  blk("  // Post compact binary node reports (MOOS_BINARY_STRING)      ");
+  blu("  binary_reports     = false                                    ");
+  blk("                                                                ");
   blk("  // Threshold for conveying an absense of the helm             ");
   blu("  nohelm_threshold   = 5       "," // seconds                   ");
   blk("                                                                ");
@@ -185,6 +188,9 @@ void showInterfaceAndExit()
   blk("                      MODE=MODE@ACTIVE:LOITERING,               ");
   blk("                      THRUST_MODE_REVERSE=true                  ");
   blk("                                                                ");
+  blk("  If binary_reports=true, NODE_REPORT_LOCAL is instead posted as ");
+  blk("  a MOOS_BINARY_STRING in the compact binary node report form.  ");
+  blk("                                                                ");
   blk("  NODE_REPORT_LOCAL_FIRST = posted just once at startup, a copy ");
   blk("                            of NODE_REPORT_LOCAL in case one    ");
   blk("                            wants to not log the regular reports");
@@ -47,6 +47,11 @@ ObstacleManager::ObstacleManager()
   m_max_pts_per_cluster = 20;
   m_max_age_per_point   = 20;
 
+  m_cluster_unlabeled = false;
+  m_cluster_dist      = 5;  // meters
+  m_cluster_hash.setCellSize(m_cluster_dist);
+  m_obstacle_hash.setCellSize(50);
+
   m_poly_label_thresh = 25;
   m_poly_shade_thresh = 100;
   m_poly_vertex_thresh = 150;
@@ -77,6 +82,11 @@ ObstacleManager::ObstacleManager()
   m_obstacles_released = 0;
   m_obstacles_ever = 0;
 
+  m_batches_total   = 0;
+  m_batches_invalid = 0;
+  m_cluster_pts_ever = 0;
+  m_clusters_ever    = 0;
+
   m_given_mail_ever = 0;
   m_given_mail_good = 0;
   m_given_config_ever = 0;
@@ -116,6 +126,8 @@ bool ObstacleManager::OnNewMail(MOOSMSG_LIST &NewMail)
     
     if(key == m_point_var)
       handled = handleMailNewPoint(sval);
+    else if(key == m_points_var)
+      handled = handleMailNewPoints(sval);
     if(key == "NAV_X") {
       m_nav_x = dval;
       handled = true;
@@ -190,6 +202,8 @@ bool ObstacleManager::OnStartUp()
     bool handled = false;
     if((param == "point_var") && (toupper(value) != "GIVEN_OBSTABLE")) 
       handled = setNonWhiteVarOnString(m_point_var, value);
+    else if(param == "points_var")
+      handled = setNonWhiteVarOnString(m_points_var, value);
     else if((param == "given_obstable") || (param == "given_obstacle"))
       handled = handleGivenObstacle(value, "mission");
     else if(param == "alert_range")
@@ -200,6 +214,19 @@ bool ObstacleManager::OnStartUp()
       handled = setUIntOnString(m_max_pts_per_cluster, value);
     else if(param == "max_age_per_point")
       handled = setPosDoubleOnString(m_max_age_per_point, value);
+    else if(param == "cluster_unlabeled")
+      handled = setBooleanOnString(m_cluster_unlabeled, value);
+    else if(param == "cluster_dist") {
+      handled = setPosDoubleOnString(m_cluster_dist, value);
+      if(handled)
+	m_cluster_hash.setCellSize(m_cluster_dist);
+    }
+    else if(param == "grid_cell_size") {
+      double cell_size = 0;
+      handled = setPosDoubleOnString(cell_size, value);
+      if(handled)
+	handled = m_obstacle_hash.setCellSize(cell_size);
+    }
     else if(param == "post_dist_to_polys")
       handled = handleConfigPostDistToPolys(value);
     else if(param == "post_view_polys")
@@ -249,6 +276,8 @@ bool ObstacleManager::OnStartUp()
   // actually need
   if(m_point_var == "")
     m_point_var = "TRACKED_FEATURE";
+  if(m_points_var == "")
+    m_points_var = "TRACKED_FEATURES";
 
   Notify("OBM_CONNECT", "true");
   reportEvent("OBM_CONNECT=true");
@@ -265,6 +294,8 @@ void ObstacleManager::registerVariables()
   AppCastingMOOSApp::RegisterVariables();
   if(m_point_var != "")
     Register(m_point_var, 0);
+  if(m_points_var != "")
+    Register(m_points_var, 0);
 
   Register("NAV_X", 0);
   Register("NAV_Y", 0);
@@ -286,6 +317,8 @@ void ObstacleManager::registerVariables()
 //            currently is consistent with an XYPoint, but we custom parse
 //            here to decouple from the geometry string parsing library.
 //   Example: TRACKED_FEATURE = "x=23,y=99,key=b"
+//      Note: The key may be omitted only if cluster_unlabeled is set,
+//            in which case the obstacle key is found by clustering.
 
 XYPoint ObstacleManager::customStringToPoint(string point_str)
 {
@@ -308,7 +341,9 @@ XYPoint ObstacleManager::customStringToPoint(string point_str)
       obstacle_key_str = value;
   }
 
-  if((x_str == "") || (y_str == "") || (obstacle_key_str == ""))
+  if((x_str == "") || (y_str == ""))
+    return(null_pt);
+  if((obstacle_key_str == "") && !m_cluster_unlabeled)
     return(null_pt);
 
   double x = atof(x_str.c_str());
@@ -378,6 +413,7 @@ bool ObstacleManager::handleGivenObstacle(string poly, string source)
   m_map_obstacles[key].setPoly(new_poly);
   m_map_obstacles[key].setDuration(duration);
   m_map_obstacles[key].setTStamp(m_curr_time);
+  indexObstacle(key);
   onNewObstacle("given");  
   
   reportEvent("new obstacle: " + m_map_obstacles[key].getInfo(m_curr_time)); 
@@ -398,35 +434,198 @@ bool ObstacleManager::handleMailNewPoint(string value)
     return(false);
   }
     
-  // Part 2: Check the range of point to ownship, perhaps ignore it
+  // Part 2: Add the point to its obstacle unless out of range
+  string key = addNewPoint(newpt.x(), newpt.y(), newpt.get_msg());
+  if(key != "")
+    onNewObstacle("points");  
+
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: handleMailNewPoints()
+//   Purpose: Handle a batch of tracked features in one posting, all
+//            belonging to the same obstacle, rather than one posting
+//            per point.
+//   Example: TRACKED_FEATURES = "key=b,pts={23,99:24,98.5:25.2,97}"
+//      Note: As with single points, the key may be omitted only if
+//            cluster_unlabeled is set.
+
+bool ObstacleManager::handleMailNewPoints(string value)
+{
+  m_batches_total++;
+
+  // Part 1: Separate the pts={...} component from the other fields
+  string pts_str;
+  string other_str = value;
+  size_t pos = value.find("pts={");
+  if(pos != string::npos) {
+    size_t end = value.find('}', pos);
+    if(end != string::npos) {
+      pts_str = value.substr(pos+5, end-pos-5);
+      other_str = value.substr(0, pos) + value.substr(end+1);
+    }
+  }
+
+  string key;
+  vector<string> svector = parseString(other_str, ',');
+  for(unsigned int i=0; i<svector.size(); i++) {
+    string param = biteStringX(svector[i], '=');
+    if((param == "key") || (param == "label"))
+      key = svector[i];
+  }
+
+  if((pts_str == "") || ((key == "") && !m_cluster_unlabeled)) {
+    m_batches_invalid++;
+    reportRunWarning("Invalid points:" + value);
+    return(false);
+  }
+
+  // Part 2: Parse the x,y:x,y:... pairs in place. Each pair is
+  //         validated before any point from the batch is applied.
+  vector<double> vx, vy;
+  const char *cstr = pts_str.c_str();
+  while(*cstr != '\0') {
+    char *next = 0;
+    double x = strtod(cstr, &next);
+    if(next == cstr)
+      break;
+    cstr = next;
+    while(*cstr == ' ')
+      cstr++;
+    if(*cstr != ',')
+      break;
+    cstr++;
+    double y = strtod(cstr, &next);
+    if(next == cstr)
+      break;
+    cstr = next;
+    while(*cstr == ' ')
+      cstr++;
+    vx.push_back(x);
+    vy.push_back(y);
+    if(*cstr == ':')
+      cstr++;
+    else if(*cstr != '\0')
+      break;
+  }
+
+  if((*cstr != '\0') || (vx.size() == 0)) {
+    m_batches_invalid++;
+    reportRunWarning("Invalid points:" + value);
+    return(false);
+  }
+
+  // Part 3: Add each point. A batch is treated as one report per
+  //         obstacle, so new obstacle flags are posted once per key
+  set<string> keys;
+  for(unsigned int i=0; i<vx.size(); i++) {
+    string pkey = addNewPoint(vx[i], vy[i], key);
+    if(pkey != "")
+      keys.insert(pkey);
+  }
+  for(unsigned int i=0; i<keys.size(); i++)
+    onNewObstacle("points");  
+
+  return(true);
+}
+
+//------------------------------------------------------------
+// Procedure: addNewPoint()
+//   Purpose: Add a point to the obstacle with the given key. If the
+//            key is empty, the obstacle is found by clustering.
+//   Returns: The key of the obstacle the point was added to, or the
+//            empty string if the point was ignored.
+
+string ObstacleManager::addNewPoint(double x, double y, string key)
+{
+  // Part 1: Check the range of point to ownship, perhaps ignore it
   if(m_ignore_range > 0) {
-    double ptx = newpt.get_vx();
-    double pty = newpt.get_vy();
-    double range = hypot(m_nav_x - ptx, m_nav_y - pty);
+    double range = hypot(m_nav_x - x, m_nav_y - y);
     if(range > m_ignore_range) {
       m_points_ignored++;
-      return(true);
+      return("");
     }
   }
     
   m_points_total++;
-  newpt.set_time(m_curr_time);
   
-  // Part 3: Get the obstacle key. Contained in the msg=key parameter, or
-  //         if no msg=key parameter then in the label=key parameter. 
-  string key = newpt.get_msg();
-  if(key == "")
-    key = newpt.get_label();
-  if(key == "") 
-    key = "generic";
-
-  // Part 4: Add the new point to the points associated with that key
-  m_map_obstacles[key].addPoint(newpt);
-  m_map_obstacles[key].setChanged(true);
-  m_map_obstacles[key].setMaxPts(m_max_pts_per_cluster);
-  onNewObstacle("points");  
+  // Part 2: Get the obstacle key if not provided with the point
+  if(key == "") {
+    if(m_cluster_unlabeled)
+      key = clusterKey(x, y);
+    else
+      key = "generic";
+  }
 
-  return(true);
+  XYPoint newpt(x, y);
+  newpt.set_msg(key);
+  newpt.set_time(m_curr_time);
+
+  // Part 3: Add the new point to the points associated with that key
+  Obstacle& obstacle = m_map_obstacles[key];
+  obstacle.addPoint(newpt);
+  obstacle.setChanged(true);
+  obstacle.setMaxPts(m_max_pts_per_cluster);
+
+  return(key);
+}
+
+//------------------------------------------------------------
+// Procedure: clusterKey()
+//   Purpose: Find the obstacle key for an unlabeled point. The point
+//            joins the obstacle of the nearest recent unlabeled point
+//            within the cluster distance, or starts a new obstacle.
+
+string ObstacleManager::clusterKey(double x, double y)
+{
+  string key;
+  double best_dist = -1;
+
+  vector<string> ids = m_cluster_hash.getKeysInRange(x, y, m_cluster_dist);
+  for(unsigned int i=0; i<ids.size(); i++) {
+    string obs_key = m_cluster_pt_key[ids[i]];
+    if(m_map_obstacles.count(obs_key) == 0)
+      continue;
+    double dist = hypot(m_cluster_hash.getX(ids[i]) - x,
+			m_cluster_hash.getY(ids[i]) - y);
+    if((best_dist < 0) || (dist < best_dist)) {
+      best_dist = dist;
+      key = obs_key;
+    }
+  }
+
+  if(key == "") {
+    m_clusters_ever++;
+    key = "cluster_" + uintToString(m_clusters_ever);
+  }
+
+  m_cluster_pts_ever++;
+  string id = uintToString(m_cluster_pts_ever);
+  m_cluster_hash.update(id, x, y);
+  m_cluster_pt_key[id] = key;
+  m_cluster_pt_times.push_back(make_pair(m_curr_time, id));
+
+  return(key);
+}
+
+//------------------------------------------------------------
+// Procedure: indexObstacle()
+//   Purpose: Note the center and radius of the obstacle's polygon
+//            so obstacles far from ownship may be skipped when
+//            updating ranges.
+
+void ObstacleManager::indexObstacle(const string& key)
+{
+  const XYPolygon& poly = m_map_obstacles[key].getPoly();
+  if(poly.size() == 0) {
+    m_obstacle_hash.remove(key);
+    m_obstacle_radius.erase(key);
+    return;
+  }
+
+  m_obstacle_hash.update(key, poly.get_center_x(), poly.get_center_y());
+  m_obstacle_radius[key] = poly.max_radius();
 }
 
 //------------------------------------------------------------
@@ -459,7 +658,7 @@ bool ObstacleManager::updatePointHulls()
     if(!p->second.hasChanged() && !thresh_crossed)
       continue;
     string key = p->first;
-    vector<XYPoint> points = p->second.getPoints();
+    const vector<XYPoint>& points = p->second.getPoints();
     if(points.size() == 0)
       continue;
     
@@ -468,13 +667,8 @@ bool ObstacleManager::updatePointHulls()
       reportEvent("gen_lasso");
       poly = genPseudoHull(points, m_lasso_radius);
     }
-    else {
-      ConvexHullGenerator chgen;
-      for(unsigned int i=0; i<points.size(); i++) 
-	chgen.addPoint(points[i].x(), points[i].y(), points[i].get_label());
-      
-      poly = chgen.generateConvexHull();
-    }
+    else
+      poly = p->second.getPointHull();
 
     // First check if the polygon is convex. Certain edge cases may result
     // in a non convex polygon even with N>2 points, e.g., 3 colinear pts.
@@ -485,6 +679,7 @@ bool ObstacleManager::updatePointHulls()
     
     poly.set_label("obmgr_" + key);
     p->second.setPoly(poly);
+    indexObstacle(key);
     
     if(m_post_view_polys) {
       if(poly_label_thresh_over)
@@ -623,14 +818,16 @@ void ObstacleManager::postConvexHullUpdates()
   map<string, Obstacle>::iterator p;
   // For all obstacles that have a convex hull
   for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
-    string   key = p->first;
-    Obstacle obs = p->second;
-    XYPolygon poly = obs.getPoly();
+    string    key = p->first;
+    Obstacle& obs = p->second;
 
     // Double check it is convex
-    if(poly.is_convex()) {
-      double dist = poly.dist_to_poly(m_nav_x, m_nav_y);
-      bool close_range = (dist <= m_alert_range);
+    if(obs.getPoly().is_convex()) {
+      // Range was set in updatePolyRanges() unless the obstacle was
+      // found to be beyond all ranges of interest
+      bool   far  = (m_far_keys.count(key) > 0);
+      double dist = obs.getRange();
+      bool close_range = !far && (dist <= m_alert_range);
 
       bool post_this_dist_to_poly = false;
       if(m_post_dist_to_polys == "true")
@@ -646,17 +843,17 @@ void ObstacleManager::postConvexHullUpdates()
       }
 
       // Only post obstacle hull if it has changed.
-      if(m_map_obstacles[key].hasChanged()) {
+      if(obs.hasChanged()) {
 
 	// At this point we're committed to posting an update so go ahead 
 	// and mark this obstacle key as NOT changed.
-	m_map_obstacles[key].setChanged(false);
-	m_map_obstacles[key].incUpdatesTotal();
+	obs.setChanged(false);
+	obs.incUpdatesTotal();
 
 	// Only post hull if ownship is w/in alert range
 	if(close_range)
 	  postConvexHullUpdate(key, m_alert_var, m_alert_name);
-	if((m_alert_var != "") && (dist <= m_gen_alert_range))
+	if((m_alert_var != "") && !far && (dist <= m_gen_alert_range))
 	  postConvexHullUpdate(key, m_gen_alert_var, m_gen_alert_name);
       }      
     }
@@ -693,7 +890,7 @@ XYPolygon ObstacleManager::placeholderConvexHull(string key)
 
   // Part 2: Find the Center Point
 
-  vector<XYPoint> points = m_map_obstacles[key].getPoints();
+  const vector<XYPoint>& points = m_map_obstacles[key].getPoints();
 
   double ctr_x = 0;
   double ctr_y = 0;
@@ -766,11 +963,43 @@ XYPolygon ObstacleManager::genPseudoHull(const vector<XYPoint>& pts,
 
 void ObstacleManager::updatePolyRanges()
 {
+  // Part 1: Unless the range to every obstacle is posted, find the
+  //         obstacles that may be within the largest range of
+  //         interest. The rest are noted as far and skipped.
+  bool all_ranges = (m_post_dist_to_polys == "true") || (m_min_dist_ever < 0);
+
+  set<string> near_keys;
+  if(!all_ranges) {
+    double query_range = m_alert_range;
+    if(m_gen_alert_range > query_range)
+      query_range = m_gen_alert_range;
+    if(m_min_dist_ever > query_range)
+      query_range = m_min_dist_ever;
+
+    double max_radius = 0;
+    map<string,double>::iterator q;
+    for(q=m_obstacle_radius.begin(); q!=m_obstacle_radius.end(); q++) {
+      if(q->second > max_radius)
+	max_radius = q->second;
+    }
+
+    vector<string> keys = m_obstacle_hash.getKeysInRange(m_nav_x, m_nav_y,
+							 query_range + max_radius);
+    near_keys.insert(keys.begin(), keys.end());
+  }
+
+  // Part 2: Update the range to each obstacle not known to be far
   map<string,Obstacle>::iterator p;
   for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
-    string    key   = p->first;
-    XYPolygon poly  = p->second.getPoly();
-    double    range = poly.dist_to_poly(m_nav_x, m_nav_y);
+    string    key      = p->first;
+    Obstacle& obstacle = p->second;
+
+    if(!all_ranges && !near_keys.count(key) && m_obstacle_hash.contains(key)) {
+      m_far_keys.insert(key);
+      continue;
+    }
+
+    double range = obstacle.getPoly().dist_to_poly(m_nav_x, m_nav_y);
 
     // Also keep track of closest range ever to any obstacle
     if((m_min_dist_ever < 0) || (range < m_min_dist_ever)) {
@@ -778,13 +1007,15 @@ void ObstacleManager::updatePolyRanges()
       Notify("OBM_MIN_DIST_EVER", m_min_dist_ever);
     }
      
-    // Compare previous range to newly calculated range
-    if((m_map_obstacles[key].getRange() > m_alert_range) &&
-       (range <= m_alert_range))	
-      m_map_obstacles[key].setChanged();
+    // Compare previous range to newly calculated range. An obstacle
+    // that was far is treated as previously out of range.
+    bool was_out = (obstacle.getRange() > m_alert_range) || m_far_keys.count(key);
+    if(was_out && (range <= m_alert_range))	
+      obstacle.setChanged();
 
     // Update with the newly calculated range
-    m_map_obstacles[key].setRange(range);
+    obstacle.setRange(range);
+    m_far_keys.erase(key);
   }
 }
 
@@ -827,8 +1058,20 @@ void ObstacleManager::manageMemory()
     
     // Update key obstacle manager state
     m_map_obstacles.erase(key);
+    m_obstacle_hash.remove(key);
+    m_obstacle_radius.erase(key);
+    m_far_keys.erase(key);
     m_obstacles_released++;
   }
+
+  // Part 3: Forget unlabeled points used for clustering by age
+  while(!m_cluster_pt_times.empty() &&
+	((m_curr_time - m_cluster_pt_times.front().first) > m_max_age_per_point)) {
+    string id = m_cluster_pt_times.front().second;
+    m_cluster_hash.remove(id);
+    m_cluster_pt_key.erase(id);
+    m_cluster_pt_times.pop_front();
+  }
 }
 
 
@@ -938,6 +1181,10 @@ bool ObstacleManager::buildReport()
   string str_max_pts_per = uintToString(m_max_pts_per_cluster);
   string str_max_age_per = doubleToStringX(m_max_age_per_point);
 
+  string str_cluster_unlab = boolToString(m_cluster_unlabeled);
+  string str_cluster_dist  = doubleToStringX(m_cluster_dist,1);
+  string str_cell_size     = doubleToStringX(m_obstacle_hash.getCellSize(),1);
+
   string str_navx = doubleToStringX(m_nav_x,1);
   string str_navy = doubleToStringX(m_nav_y,1);
   string str_nav = "(" + str_navx + "," + str_navy + ")";
@@ -945,12 +1192,24 @@ bool ObstacleManager::buildReport()
   string str_post_view_polys = boolToString(m_post_view_polys);
 
   string str_min_dist_ever = doubleToStringX(m_min_dist_ever,1);
+
+  unsigned int hull_builds_full = 0;
+  unsigned int hull_builds_inc  = 0;
+  map<string, Obstacle>::iterator p;
+  for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
+    hull_builds_full += p->second.getHullBuildsFull();
+    hull_builds_inc  += p->second.getHullBuildsInc();
+  }
   
   m_msgs << "Configuration (point handling):             " << endl;
   m_msgs << "  point_var:    " << m_point_var              << endl;
+  m_msgs << "  points_var:   " << m_points_var             << endl;
   m_msgs << "  max_pts_per_cluster: " << str_max_pts_per   << endl;
   m_msgs << "  max_age_per_point:   " << str_max_age_per   << endl;
   m_msgs << "  ignore_range:        " << str_ignore_rng    << endl;
+  m_msgs << "  cluster_unlabeled:   " << str_cluster_unlab << endl;
+  m_msgs << "  cluster_dist:        " << str_cluster_dist  << endl;
+  m_msgs << "  grid_cell_size:      " << str_cell_size     << endl;
   m_msgs << "Configuration (given_obstacles):            " << endl;
   m_msgs << "  given_max_duration: " << m_given_max_duration << endl;
   m_msgs << "Configuration (viewing):                    " << endl;
@@ -976,6 +1235,9 @@ bool ObstacleManager::buildReport()
   m_msgs << "  Points Received:   " << m_points_total      << endl;
   m_msgs << "  Points Invalid:    " << m_points_invalid    << endl;
   m_msgs << "  Points Ignored:    " << m_points_ignored    << endl;
+  m_msgs << "  Batches Received:  " << m_batches_total     << endl;
+  m_msgs << "  Batches Invalid:   " << m_batches_invalid   << endl;
+  m_msgs << "  Clusters ever:     " << m_clusters_ever     << endl;
   m_msgs << "State: (given_obstacles):                   " << endl;
   m_msgs << "  Given Obstacles (mail) ever: " << m_given_mail_ever << endl;
   m_msgs << "  Given Obstacles (mail) good: " << m_given_mail_good << endl;
@@ -984,6 +1246,9 @@ bool ObstacleManager::buildReport()
   m_msgs << "  Obstacles:          " << m_map_obstacles.size() << endl;
   m_msgs << "  Obstacles released: " << m_obstacles_released << endl;
   m_msgs << "  Closest range ever: " << str_min_dist_ever << endl;
+  m_msgs << "  Obstacles far:      " << m_far_keys.size() << endl;
+  m_msgs << "  Hull builds (full): " << hull_builds_full << endl;
+  m_msgs << "  Hull builds (inc):  " << hull_builds_inc << endl;
   m_msgs << "State: (alerts):                            " << endl;
   m_msgs << "  Alerts Posted:   " << m_alerts_posted   << endl;
   m_msgs << "  Alerts Resolved: " << m_alerts_resolved << endl;
@@ -995,10 +1260,9 @@ bool ObstacleManager::buildReport()
   actab << "Key | Pts | Verts | Dates | Type | ation | Live  | Dist | Dist";
   actab.addHeaderLines();
 
-  map<string, Obstacle>::iterator p;
   for(p=m_map_obstacles.begin(); p!=m_map_obstacles.end(); p++) {
     string key = p->first;
-    Obstacle obstacle = p->second;
+    const Obstacle& obstacle = p->second;
     string pts_str = uintToString(obstacle.size());
 
     string hull_size_str = uintToString(obstacle.getPoly().size());
@@ -1017,8 +1281,17 @@ bool ObstacleManager::buildReport()
       time_to_live_str = doubleToStringX(time_to_live,1);
     }
 
-    string range_str = doubleToString(obstacle.getRange(),1);
-    string min_rng_str = doubleToString(obstacle.getMinRange(),1);
+    // Ranges of far obstacles are not kept current. Find them here
+    // just for this report.
+    double range = obstacle.getRange();
+    double min_range = obstacle.getMinRange();
+    if(m_far_keys.count(key)) {
+      range = obstacle.getPoly().dist_to_poly(m_nav_x, m_nav_y);
+      if((min_range < 0) || (range < min_range))
+	min_range = range;
+    }
+    string range_str = doubleToString(range,1);
+    string min_rng_str = doubleToString(min_range,1);
     
     actab << key;
     actab << pts_str;
@@ -29,7 +29,9 @@
 #include "Obstacle.h"
 #include "VarDataPair.h"
 #include "MailFlagSet.h"
+#include "XYSpatialHash.h"
 #include <set>
+#include <deque>
 
 class ObstacleManager : public AppCastingMOOSApp
 {
@@ -55,6 +57,7 @@ protected:
   bool handleConfigGeneralAlert(std::string);
 
   bool handleMailNewPoint(std::string);
+  bool handleMailNewPoints(std::string);
   bool handleMailAlertRequest(std::string);
 
   bool handleGivenObstacle(std::string, std::string src="mail");
@@ -69,6 +72,10 @@ protected:
   
   XYPoint customStringToPoint(std::string point_str);
 
+  std::string addNewPoint(double x, double y, std::string key);
+  std::string clusterKey(double x, double y);
+  void        indexObstacle(const std::string& key);
+
   bool updatePointHulls();
   void updatePolyRanges();
   void manageMemory();
@@ -79,6 +86,7 @@ protected:
   
 private: // Configuration variables
   std::string  m_point_var;            // incoming points
+  std::string  m_points_var;           // incoming batches of points
 
   std::string  m_alert_var;
   std::string  m_alert_name;
@@ -102,6 +110,10 @@ private: // Configuration variables
   unsigned int m_max_pts_per_cluster;
   double       m_max_age_per_point;
 
+  // Clustering of points arriving with no obstacle key
+  bool         m_cluster_unlabeled;
+  double       m_cluster_dist;
+
   // Configuring Lasso option
   bool         m_lasso;
   unsigned int m_lasso_points;
@@ -138,6 +150,23 @@ private: // State variables
   unsigned int m_given_config_ever;
 
   unsigned int m_obstacles_ever;
+
+  unsigned int m_batches_total;
+  unsigned int m_batches_invalid;
+
+  // Recent unlabeled points, keyed by point id, for clustering
+  XYSpatialHash m_cluster_hash;
+  std::map<std::string, std::string>          m_cluster_pt_key;
+  std::deque<std::pair<double, std::string> > m_cluster_pt_times;
+  unsigned int m_cluster_pts_ever;
+  unsigned int m_clusters_ever;
+
+  // Obstacle hull centers and radii for range queries. Obstacles
+  // found beyond all ranges of interest on the latest iteration
+  // are noted as far, and their ranges not updated.
+  XYSpatialHash m_obstacle_hash;
+  std::map<std::string, double> m_obstacle_radius;
+  std::set<std::string>         m_far_keys;
   
   std::map<std::string, Obstacle> m_map_obstacles;
 };
@@ -91,6 +91,7 @@ void showExampleConfigAndExit()
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
   blk("  point_var = TRACKED_FEATURE  // default is TRACKED_FEATURE    ");
+  blk("  points_var = TRACKED_FEATURES // default is TRACKED_FEATURES  ");
   blk("                                                                ");
   blk("  given_obstacle = pts={90.2,-80.4:...:85.4,-80.4},label=ob_23  ");
   blk("                                                                ");
@@ -101,6 +102,13 @@ void showExampleConfigAndExit()
   blk("  max_pts_per_cluster = 20   // default is 20                   ");
   blk("  max_age_per_point   = 20   // (secs)  default is 20           ");
   blk("                                                                ");
+  blk("  cluster_unlabeled = false  // Accept pts w/ no key, default   ");
+  blk("                             // is false                        ");
+  blk("  cluster_dist = 5           // (meters) default is 5           ");
+  blk("                                                                ");
+  blk("  // Cell size of the index used to skip far obstacles          ");
+  blk("  grid_cell_size = 50        // (meters) default is 50          ");
+  blk("                                                                ");
   blk("  alert_range  = 20          // (meters) default is 20          ");
   blk("  ignore_range = -1          // (meters) default is -1, (off)   ");
   blk("                                                                ");
@@ -141,6 +149,7 @@ void showInterfaceAndExit()
   blk("SUBSCRIPTIONS:                                                  ");
   blk("------------------------------------                            ");
   blk("  TRACKED_FEATURE = x=5,y=8,label=a,size=4,color=1              ");
+  blk("  TRACKED_FEATURES = label=a,pts={5,8:6,8.5:7.2,9}             ");
   blk("  GIVEN_OBSTACLE  = pts={90.2,-80.4:...:85.4,-80.4},label=ob_23 ");
   blk("                                                                ");
   blk("  NAV_X = 103.0                                                 ");
@@ -22,6 +22,8 @@
 /*****************************************************************/
 
 #include <iterator>
+#include <algorithm>
+#include <cmath>
 #include "SearchGrid.h"
 #include "MBUtils.h"
 #include "NodeRecord.h"
@@ -38,6 +40,10 @@ using namespace std;
 SearchGrid::SearchGrid()
 {
   m_report_deltas = true;
+  m_path_coverage = false;
+  m_path_max_len  = 100;
+  m_binary_grid   = false;
+  m_binary_grid_quant = 0;
   m_grid_label    = "psg";
   m_grid_var_name = "VIEW_GRID";
 }
@@ -133,6 +139,14 @@ bool SearchGrid::OnStartUp()
       }	
       else if(param == "report_deltas") 
 	handled = setBooleanOnString(m_report_deltas, value);
+      else if(param == "path_coverage") 
+	handled = setBooleanOnString(m_path_coverage, value);
+      else if(param == "path_max_len") 
+	handled = setNonNegDoubleOnString(m_path_max_len, value);
+      else if(param == "binary_grid") 
+	handled = setBooleanOnString(m_binary_grid, value);
+      else if(param == "binary_grid_quant") 
+	handled = setNonNegDoubleOnString(m_binary_grid_quant, value);
       else if(param == "ignore_name") 
 	handled = m_filter_set.addIgnoreName(value);
       else if(param == "match_name") 
@@ -182,14 +196,43 @@ void SearchGrid::handleMailNodeReport(string str)
   double posx = record.getX();
   double posy = record.getY();
 
-  for(unsigned int ix=0; ix<m_grid.size(); ix++) {
-    bool contained = m_grid.ptIntersect(ix, posx, posy);
-    if(contained) {
-      m_map_deltas[ix] = m_map_deltas[ix] + 1;
-      m_grid.incVal(ix, 1);
-    }
+  // Part 1: Every cell containing the reported position. A position
+  // on a shared cell edge or corner credits each cell meeting there.
+  vector<unsigned int> curr_cells = m_grid.getCellsIX(posx, posy);
+  for(unsigned int i=0; i<curr_cells.size(); i++) {
+    unsigned int ix = curr_cells[i];
+    m_map_deltas[ix] = m_map_deltas[ix] + 1;
+    m_grid.incVal(ix, 1);
   }
 
+  if(!m_path_coverage)
+    return;
+
+  // Part 2: Cells passed through since the previous report, not
+  // counting cells holding the previous or current position, each
+  // counted once.
+  string vname = record.getName();
+  if(m_map_last_x.count(vname)) {
+    double prevx = m_map_last_x[vname];
+    double prevy = m_map_last_y[vname];
+    double dist  = hypot(posx-prevx, posy-prevy);
+    if(dist <= m_path_max_len) {
+      vector<unsigned int> prev_cells = m_grid.getCellsIX(prevx, prevy);
+      vector<unsigned int> cells;
+      cells = m_grid.getCellsOnSegment(prevx, prevy, posx, posy);
+      for(unsigned int i=0; i<cells.size(); i++) {
+	unsigned int ix = cells[i];
+	if(find(prev_cells.begin(), prev_cells.end(), ix) != prev_cells.end())
+	  continue;
+	if(find(curr_cells.begin(), curr_cells.end(), ix) != curr_cells.end())
+	  continue;
+	m_map_deltas[ix] = m_map_deltas[ix] + 1;
+	m_grid.incVal(ix, 1);
+      }
+    }
+  }
+  m_map_last_x[vname] = posx;
+  m_map_last_y[vname] = posy;
 }
 
 //------------------------------------------------------------
@@ -197,9 +240,15 @@ void SearchGrid::handleMailNodeReport(string str)
 
 void SearchGrid::postGrid()
 {
-  string spec = m_grid.get_spec();
-
   // By default m_grid_var_name="VIEW_GRID"
+  if(m_binary_grid) {
+    string spec = convexGrid2Binary(m_grid, m_binary_grid_quant);
+    vector<unsigned char> bytes(spec.begin(), spec.end());
+    Notify(m_grid_var_name, bytes);
+    return;
+  }
+
+  string spec = m_grid.get_spec();
   Notify(m_grid_var_name, spec);   
 }
 
@@ -219,11 +268,17 @@ void SearchGrid::postGridUpdates()
     double delta = p->second;
     update.addUpdate(ix, "x", delta);
   }
-  string msg = update.get_spec();
-
   m_map_deltas.clear();
   
   // By default m_grid_var_name="VIEW_GRID"
+  if(m_binary_grid) {
+    string msg = gridUpdate2Binary(update, m_binary_grid_quant);
+    vector<unsigned char> bytes(msg.begin(), msg.end());
+    Notify(m_grid_var_name+"_DELTA", bytes);
+    return;
+  }
+
+  string msg = update.get_spec();
   Notify(m_grid_var_name+"_DELTA", msg);
 }
 
@@ -257,7 +312,15 @@ bool SearchGrid::buildReport()
   m_msgs << "Grid characteristics: " << endl;
   m_msgs << "      Cells: " << m_grid.size() << endl;  
   m_msgs << "  Cell size: " << doubleToStringX(cell_sizex) << "x" << 
-    doubleToStringX(cell_sizey,4) << endl << endl;
+    doubleToStringX(cell_sizey,4) << endl;
+  m_msgs << "  Path Coverage: " << boolToString(m_path_coverage);
+  if(m_path_coverage)
+    m_msgs << " (max_len=" << doubleToStringX(m_path_max_len) << ")";
+  m_msgs << endl;
+  m_msgs << "  Binary Grid: " << boolToString(m_binary_grid);
+  if(m_binary_grid && (m_binary_grid_quant > 0))
+    m_msgs << " (quant=" << doubleToStringX(m_binary_grid_quant) << ")";
+  m_msgs << endl << endl;
 
   ACTable actab(6,2);
   actab.setColumnJustify(1, "right");
@@ -49,6 +49,10 @@ class SearchGrid : public AppCastingMOOSApp
   
 protected: // Config vars
   bool        m_report_deltas;
+  bool        m_path_coverage;
+  double      m_path_max_len;
+  bool        m_binary_grid;
+  double      m_binary_grid_quant;
   std::string m_grid_label;
   std::string m_grid_var_name;
 
@@ -60,6 +64,10 @@ protected: // State vars
 
   std::map<unsigned int, double> m_map_deltas;
 
+  // Last reported position per vehicle, for path coverage
+  std::map<std::string, double> m_map_last_x;
+  std::map<std::string, double> m_map_last_y;
+
 };
 
 #endif 
@@ -89,6 +89,15 @@ void showExampleConfigAndExit()
   blk("  CommsTick = 4                                                 ");
   blk("                                                                ");
   blk("  report_deltas = true         // default                       ");
+  blk("  path_coverage = false        // default                       ");
+  blk("  path_max_len  = 100          // default (meters)              ");
+  blk("                                                                ");
+  blk("  // Post VIEW_GRID and VIEW_GRID_DELTA in the compact binary   ");
+  blk("  // form (MOOS_BINARY_STRING). Quant > 0 rounds cell values to ");
+  blk("  // multiples of quant. Otherwise values are kept exactly.     ");
+  blk("  binary_grid       = false    // default                       ");
+  blk("  binary_grid_quant = 0        // default                       ");
+  blk("                                                                ");
   blk("  grid_var_name = VIEW_GRID    // default                       ");
   blk("  grid_label    = psg          // default                       ");
   blk("  match_name    = abe                                           ");
@@ -134,6 +143,10 @@ void showInterfaceAndExit()
   blk("              cell_size=5, cell_vars=x:0:y:0:z:0,cell_min=x:0,  ");
   blk("              cell_max=x:50,cell=211:x:50, cell=212:x:50,       ");
   blk("              cell=237:x:50,cell=238:x:50,label=psg             ");
+  blk("  VIEW_GRID_DELTA = psg@211,x,1:237,x,1                         ");
+  blk("                                                                ");
+  blk("  If binary_grid=true, both are posted as MOOS_BINARY_STRING    ");
+  blk("  in the compact binary grid form.                              ");
   blk("                                                                ");
   exit(0);
 }
@@ -96,6 +96,12 @@ bool CPAMonitor::addIgnoreGroup(string grp_name)
     return(false);
 
   m_ignore_groups.push_back(grp_name);
+
+  // Refresh the ignore flag of vehicles already known
+  map<string, unsigned int>::iterator p;
+  for(p=m_map_vid.begin(); p!=m_map_vid.end(); p++)
+    m_vignore[p->second] = (m_map_vgroup[p->first] == grp_name) ||
+      m_vignore[p->second];
   return(true);
 }
 
@@ -184,81 +190,127 @@ bool CPAMonitor::handleNodeReport(string node_report)
     m_map_vrecords[vname].pop_back();
   m_map_updated[vname] = true;
 
+  // Part 2: Update the ID-indexed position and spatial index
+  unsigned int vid = getVehicleID(vname);
+  m_vx[vid] = record.getX();
+  m_vy[vid] = record.getY();
+  m_vignore[vid] = vectorContains(m_ignore_groups, group);
+  m_vgrid.update(vname, m_vx[vid], m_vy[vid]);
+  
   return(true);
 }
 
+//---------------------------------------------------------
+// Procedure: getVehicleID()
+//      Note: IDs are assigned on first report and never reused.
+
+unsigned int CPAMonitor::getVehicleID(const string& vname)
+{
+  map<string, unsigned int>::iterator p = m_map_vid.find(vname);
+  if(p != m_map_vid.end())
+    return(p->second);
+
+  unsigned int vid = m_vnames.size();
+  m_map_vid[vname] = vid;
+  m_vnames.push_back(vname);
+  m_vx.push_back(0);
+  m_vy.push_back(0);
+  m_vignore.push_back(false);
+  m_pair_partners.push_back(set<unsigned int>());
+  return(vid);
+}
+
 //---------------------------------------------------------
 // Procedure: examineAndReport()
+//      Note: Only pairs within the ignore_range are examined. If no
+//            such pair exists, the closest range is then determined
+//            from all pairs to retain the prior reporting behavior.
 
 bool CPAMonitor::examineAndReport()
 {
   m_closest_range = -1;
 
+  // Spatial index cell size tracks the ignore range so that each
+  // query visits a 3x3 block of cells.
+  if(m_ignore_range > 0)
+    m_vgrid.setCellSize(m_ignore_range);
+  
+  bool any_updated = false;
   map<string, bool>::iterator p;
   for(p=m_map_updated.begin(); p!=m_map_updated.end(); p++) {
-    string vname = p->first;
-    if(m_map_updated[vname]) {
-      examineAndReport(vname);
+    if(p->second) {
+      any_updated = true;
+      examineAndReport(m_map_vid[p->first]);
     }
   }
-      
+
+  if(any_updated && (m_closest_range < 0))
+    updateClosestRangeAllPairs();
+  
   return(true);
 }
 
 //---------------------------------------------------------
-// Procedure: examineAndReport(vname)
+// Procedure: examineAndReport(vid)
 
-bool CPAMonitor::examineAndReport(string vname)
+bool CPAMonitor::examineAndReport(unsigned int vid)
 {
-  map<string, bool>::iterator p;
-  for(p=m_map_updated.begin(); p!=m_map_updated.end(); p++) {
-    string contact = p->first;
-    if(vname != contact) {
-      examineAndReport(vname, contact);
+  string vname = m_vnames[vid];
+
+  // Part 1: Examine all contacts within the ignore range
+  vector<string> contacts;
+  contacts = m_vgrid.getKeysInRange(m_vx[vid], m_vy[vid], m_ignore_range);
+
+  set<unsigned int> near_ids;
+  for(unsigned int i=0; i<contacts.size(); i++) {
+    if(contacts[i] != vname) {
+      unsigned int cid = m_map_vid[contacts[i]];
+      near_ids.insert(cid);
+      examineAndReport(vid, cid);
     }
   }
-      
+
+  // Part 2: Retire pairs that were previously within the ignore
+  // range but are no longer.
+  set<unsigned int> partners = m_pair_partners[vid];
+  set<unsigned int>::iterator q;
+  for(q=partners.begin(); q!=partners.end(); q++) {
+    if(near_ids.count(*q) == 0)
+      retirePair(vid, *q);
+  }
+  
   return(true);
 }
 
 //---------------------------------------------------------
-// Procedure: examineAndReport(vname, contact)
+// Procedure: examineAndReport(vid, cid)
 
-bool CPAMonitor::examineAndReport(string vname, string contact)
+bool CPAMonitor::examineAndReport(unsigned int vid, unsigned int cid)
 {
-  // Part 1: Sanity check
-  if(!m_map_vrecords.count(vname) || !m_map_vrecords.count(contact))
-    return(false);
-
-  // Part 1B: Check ignore groups. If both vehicles have a group on
+  // Part 1: Check ignore groups. If both vehicles have a group on
   // the list of ignore groups, then just consider ourselves done now.  
-  string vname_group   = m_map_vgroup[vname];
-  string contact_group = m_map_vgroup[contact];
-  if(vectorContains(m_ignore_groups, vname_group) &&
-     vectorContains(m_ignore_groups, contact_group))
+  if(m_vignore[vid] && m_vignore[cid])
     return(true);
 
-  
-  // Part 2: Create a unique "pairtag" so an event betweeen two
-  //         vehicles is singular and not treated twice
-  string tag = pairTag(vname, contact);
+  // Part 2: A pair is examined only once per round even if both
+  //         vehicles have been updated.
+  CPAPairState& pstate = m_pairs[pairKey(vid, cid)];
   if(m_verbose) {
-    cout << "Examining: " << vname << " and " << contact <<
-      "(" << tag << ")" << "  [" << m_iteration << "]" << endl;
+    cout << "Examining: " << m_vnames[vid] << " and " << m_vnames[cid] <<
+      "  [" << m_iteration << "]" << endl;
   }
-  if(m_map_pair_examined[tag])
+  if(pstate.examined)
     return(true);
 
-
   // Part 3: Update range and rate
-  double prev_dist    = m_map_pair_dist[tag];
-  bool   prev_closing = m_map_pair_closing[tag];
-  bool   prev_valid   = m_map_pair_valid[tag];
+  double prev_dist    = pstate.dist;
+  bool   prev_closing = pstate.closing;
+  bool   prev_valid   = pstate.valid;
 
-  updatePairRangeAndRate(vname, contact);
+  updatePairRangeAndRate(vid, cid);
 
-  bool now_closing = m_map_pair_closing[tag];
-  bool now_valid   = m_map_pair_valid[tag];
+  bool now_closing = pstate.closing;
+  bool now_valid   = pstate.valid;
 
   if(m_verbose) {
     cout << "  prev_dist:    " << prev_dist << endl;
@@ -275,16 +327,16 @@ bool CPAMonitor::examineAndReport(string vname, string contact)
   if(prev_closing && !now_closing) {
     if(m_verbose)
       cout << " *********** POSTING ************* " << endl;
-    double cpa_dist = m_map_pair_min_dist_running[tag];
+    double cpa_dist = pstate.min_dist_running;
     if(cpa_dist <= m_report_range) {
+      string vname   = m_vnames[vid];
+      string contact = m_vnames[cid];
       CPAEvent event(vname, contact, cpa_dist);
-      double midx = m_map_pair_midx[tag];
-      double midy = m_map_pair_midy[tag];
-      double beta = relBng(vname, contact);
+      double beta  = relBng(vname, contact);
       double alpha = relBng(contact, vname);
 
-      event.setX(midx);
-      event.setY(midy);
+      event.setX(pstate.midx);
+      event.setY(pstate.midy);
       event.setAlpha(alpha);
       event.setBeta(beta);
       m_events.push_back(event);
@@ -295,57 +347,52 @@ bool CPAMonitor::examineAndReport(string vname, string contact)
 }
 
 //---------------------------------------------------------
-// Procedure: updatePairRangeAndRate(vname, contact)
+// Procedure: updatePairRangeAndRate(vid, cid)
 
-bool CPAMonitor::updatePairRangeAndRate(string vname, string contact)
+bool CPAMonitor::updatePairRangeAndRate(unsigned int vid, unsigned int cid)
 {
-  // Sanity check - make sure we have node records for each
-  if(!m_map_vrecords.count(vname) || !m_map_vrecords.count(contact))
-    return(false);
-
   // Part 1: get the vehicle info and calculate range
-  NodeRecord os_record = m_map_vrecords[vname].front();
-  NodeRecord cn_record = m_map_vrecords[contact].front();
-  double osx  = os_record.getX();
-  double osy  = os_record.getY();
-  double cnx  = cn_record.getX();
-  double cny  = cn_record.getY();
+  double osx  = m_vx[vid];
+  double osy  = m_vy[vid];
+  double cnx  = m_vx[cid];
+  double cny  = m_vy[cid];
   double midx = (osx + ((cnx-osx)/2));
   double midy = (osy + ((cny-osy)/2));
   double dist = hypot(osx-cnx, osy-cny);
-  string tag  = pairTag(vname, contact);
 
-  if((m_closest_range < 0) || (dist < m_closest_range))
-    m_closest_range = dist;
-  
-  if((m_closest_range_ever < 0) || (dist < m_closest_range_ever))
-    m_closest_range_ever = dist;
+  noteClosestRange(dist);
   
   // Note that this pair has been examined on this round. This is cleared
-  // for all pairs at the end of a round.
-  m_map_pair_examined[tag] = true; 
+  // for all examined pairs at the end of a round.
+  pair<unsigned int, unsigned int> key = pairKey(vid, cid);
+  CPAPairState& pstate = m_pairs[key];
+  pstate.examined = true;
+  m_pairs_examined.push_back(key);
   
   // If the distance is really large (greater than the ignore_range) then
-  // remove all data for this tag and return. 
+  // remove all data for this pair and return. 
   if(dist > m_ignore_range) {
-    m_map_pair_dist.erase(tag);
-    m_map_pair_closing[tag] = false;
-    m_map_pair_valid[tag] = false;
-    m_map_pair_midx[tag] = 0;
-    m_map_pair_midy[tag] = 0;
-    return(true);
-  }
-  
-  // Handle case where this is the first distance noted for this pair
-  if(m_map_pair_dist.count(tag) == 0) {
-    m_map_pair_dist[tag] = dist;
-    m_map_pair_closing[tag] = false;
-    m_map_pair_valid[tag] = false;
+    pstate.dist     = 0;
+    pstate.closing  = false;
+    pstate.valid    = false;
+    pstate.midx     = 0;
+    pstate.midy     = 0;
+    m_pair_partners[vid].erase(cid);
+    m_pair_partners[cid].erase(vid);
     return(true);
   }
+
+  m_pair_partners[vid].insert(cid);
+  m_pair_partners[cid].insert(vid);
   
-  double dist_prev = m_map_pair_dist[tag];
-  bool   closing_prev = m_map_pair_closing[tag];
+  // Note a pair first noted, or re-entering the ignore range, has a
+  // previous distance of zero and is thus treated as opening. Its
+  // first approach can then register as closing and yield a CPA
+  // event. This is as before: the string-keyed version read the pair
+  // distance via operator[] before updating, so its first-distance
+  // branch was never reached.
+  double dist_prev = pstate.dist;
+  bool   closing_prev = pstate.closing;
   
   // Simple case: If distance hasn't changed, then no updates to the 
   // closing and valid flags either. 
@@ -357,31 +404,82 @@ bool CPAMonitor::updatePairRangeAndRate(string vname, string contact)
     // Handle case where may be transitioning from opening to closing
     if(!closing_prev) {
       // Check if range has "swung" sufficiently to warrant a change
-      if((m_map_pair_max_dist_running[tag] - dist) > m_swing_range) {
-	m_map_pair_closing[tag] = true;
+      if((pstate.max_dist_running - dist) > m_swing_range) {
+	pstate.closing = true;
       }
     }
-    m_map_pair_min_dist_running[tag] = dist;
+    pstate.min_dist_running = dist;
   }
   else {  // Handle case where we are technically opening
     // Handle case where may be transitioning from closing to opening 
     if(closing_prev) {
       // Check if range has "swung" sufficiently to warrant a change
-      if((dist - m_map_pair_min_dist_running[tag]) > m_swing_range) {
-	m_map_pair_closing[tag] = false;
+      if((dist - pstate.min_dist_running) > m_swing_range) {
+	pstate.closing = false;
       }
     }
-    m_map_pair_max_dist_running[tag] = dist;
+    pstate.max_dist_running = dist;
   }    
 
-  m_map_pair_dist[tag] = dist;
-  m_map_pair_valid[tag] = true;
-  m_map_pair_midx[tag] = midx;
-  m_map_pair_midy[tag] = midy;
+  pstate.dist  = dist;
+  pstate.valid = true;
+  pstate.midx  = midx;
+  pstate.midy  = midy;
   
   return(true);
 }
 
+//---------------------------------------------------------
+// Procedure: retirePair(vid, cid)
+//   Purpose: Handle a pair that has moved beyond the ignore range
+//            since last examined. Its range and rate state is reset
+//            exactly as if it were examined at the larger range.
+
+void CPAMonitor::retirePair(unsigned int vid, unsigned int cid)
+{
+  if(m_vignore[vid] && m_vignore[cid])
+    return;
+  if(m_pairs[pairKey(vid, cid)].examined)
+    return;
+  
+  updatePairRangeAndRate(vid, cid);
+}
+
+//---------------------------------------------------------
+// Procedure: updateClosestRangeAllPairs()
+//   Purpose: When no pair involving an updated vehicle is within the
+//            ignore range, the closest range is found by checking
+//            all such pairs on range alone.
+
+void CPAMonitor::updateClosestRangeAllPairs()
+{
+  map<string, bool>::iterator p;
+  for(p=m_map_updated.begin(); p!=m_map_updated.end(); p++) {
+    if(!p->second)
+      continue;
+    unsigned int vid = m_map_vid[p->first];
+    for(unsigned int cid=0; cid<m_vnames.size(); cid++) {
+      if((cid == vid) || !m_vgrid.contains(m_vnames[cid]))
+	continue;
+      if(m_vignore[vid] && m_vignore[cid])
+	continue;
+      noteClosestRange(hypot(m_vx[vid]-m_vx[cid], m_vy[vid]-m_vy[cid]));
+    }
+  }
+}
+
+//---------------------------------------------------------
+// Procedure: noteClosestRange()
+
+void CPAMonitor::noteClosestRange(double dist)
+{
+  if((m_closest_range < 0) || (dist < m_closest_range))
+    m_closest_range = dist;
+  
+  if((m_closest_range_ever < 0) || (dist < m_closest_range_ever))
+    m_closest_range_ever = dist;
+}
+
 //---------------------------------------------------------
 // Procedure: clear()
 //   Purpose: At the end of a round, clear data.
@@ -392,20 +490,22 @@ void CPAMonitor::clear()
   for(p=m_map_updated.begin(); p!=m_map_updated.end(); p++)
     p->second = false;
   
-  for(p=m_map_pair_examined.begin(); p!=m_map_pair_examined.end(); p++)
-    p->second = false;
-
+  for(unsigned int i=0; i<m_pairs_examined.size(); i++)
+    m_pairs[m_pairs_examined[i]].examined = false;
+  m_pairs_examined.clear();
+  
   m_events.clear();
 }
 
 //---------------------------------------------------------
-// Procedure: pairTag()
+// Procedure: pairKey()
 
-string CPAMonitor::pairTag(string a, string b)
+pair<unsigned int, unsigned int> CPAMonitor::pairKey(unsigned int a,
+						     unsigned int b)
 {
   if(a < b)
-    return(a + "#" + b);
-  return(b + "#" + a);
+    return(pair<unsigned int, unsigned int>(a, b));
+  return(pair<unsigned int, unsigned int>(b, a));
 }
 
 
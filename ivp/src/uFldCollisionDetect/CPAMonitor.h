@@ -25,11 +25,30 @@
 #define CPA_MONITOR_HEADER
 
 #include <string>
+#include <vector>
 #include <map>
 #include <list>
 #include <set>
 #include "NodeRecord.h"
 #include "CPAEvent.h"
+#include "XYSpatialHash.h"
+
+// Range and rate state for a single pair of vehicles
+struct CPAPairState
+{
+  CPAPairState() {
+    dist=0; min_dist_running=0; max_dist_running=0; midx=0; midy=0;
+    closing=false; valid=false; examined=false;
+  }
+  double dist;
+  double min_dist_running;
+  double max_dist_running;
+  double midx;
+  double midy;
+  bool   closing;
+  bool   valid;
+  bool   examined;
+};
 
 class CPAMonitor
 {
@@ -67,10 +86,15 @@ class CPAMonitor
   NodeRecord getVRecord(std::string vname);
   
  protected: // Local utility functions
-  std::string pairTag(std::string, std::string);
-  bool        examineAndReport(std::string);
-  bool        examineAndReport(std::string, std::string);
-  bool        updatePairRangeAndRate(std::string, std::string); 
+  unsigned int getVehicleID(const std::string& vname);
+  std::pair<unsigned int, unsigned int> pairKey(unsigned int, unsigned int);
+
+  bool        examineAndReport(unsigned int);
+  bool        examineAndReport(unsigned int, unsigned int);
+  bool        updatePairRangeAndRate(unsigned int, unsigned int); 
+  void        retirePair(unsigned int, unsigned int);
+  void        updateClosestRangeAllPairs();
+  void        noteClosestRange(double);
 
   double      relBng(std::string vname1, std::string vname2);
   
@@ -89,16 +113,23 @@ class CPAMonitor
   std::map<std::string, std::list<NodeRecord> > m_map_vrecords;
   std::map<std::string, bool>                   m_map_updated;
   std::map<std::string, std::string>            m_map_vgroup;
+  std::map<std::string, unsigned int>           m_map_vid;
+
+ protected: // Indexed on vehicle ID
+  std::vector<std::string>  m_vnames;
+  std::vector<double>       m_vx;
+  std::vector<double>       m_vy;
+  std::vector<bool>         m_vignore;
+
+  // Vehicle IDs currently within ignore_range, per vehicle ID
+  std::vector<std::set<unsigned int> > m_pair_partners;
+
+  // Spatial index over latest vehicle positions, keyed on vname
+  XYSpatialHash m_vgrid;
   
- protected: // map keyed on coupled vname#contact, abe#bob
-  std::map<std::string, double>     m_map_pair_dist;
-  std::map<std::string, double>     m_map_pair_min_dist_running;
-  std::map<std::string, double>     m_map_pair_max_dist_running;
-  std::map<std::string, double>     m_map_pair_midx;
-  std::map<std::string, double>     m_map_pair_midy;
-  std::map<std::string, bool>       m_map_pair_closing;
-  std::map<std::string, bool>       m_map_pair_valid;
-  std::map<std::string, bool>       m_map_pair_examined;
+ protected: // Keyed on vehicle ID pair, lower ID first
+  std::map<std::pair<unsigned int, unsigned int>, CPAPairState> m_pairs;
+  std::vector<std::pair<unsigned int, unsigned int> > m_pairs_examined;
   
  protected: // Indexed on event (cpa occurrence)
   std::vector<CPAEvent>    m_events;
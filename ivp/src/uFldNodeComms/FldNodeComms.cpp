@@ -24,6 +24,7 @@
 #include <cmath>
 #include <set>
 #include <iterator>
+#include <algorithm>
 #include "FldNodeComms.h"
 #include "MBUtils.h"
 #include "NodeRecordUtils.h"
@@ -289,6 +290,8 @@ bool FldNodeComms::OnStartUp()
   }
 
 
+  updateNodeGridCellSize();
+
   cout << "OnStartupCompleted" << endl;
   registerVariables();
   return(true);
@@ -322,6 +325,8 @@ void FldNodeComms::clearStaleNodes()
   for(unsigned int i=0; i<stale_vnames.size(); i++) {
     string vname = stale_vnames[i];
     m_map_record.erase(vname);
+    m_node_grid.remove(vname);
+    m_map_binary_rpt.erase(vname);
     m_map_message.erase(vname);
     m_map_newrecord.erase(vname);
     m_map_time_nreport.erase(vname);
@@ -377,7 +382,12 @@ bool FldNodeComms::handleMailNodeReport(const string& str, string& whynot)
   }
   
   m_map_record[upp_name] = new_record;
+  m_map_binary_rpt[upp_name] = isBinaryNodeReport(str);
   m_map_newrecord[upp_name] = true;
+  if(new_record.valid())
+    m_node_grid.update(upp_name, new_record.getX(), new_record.getY());
+  else
+    m_node_grid.remove(upp_name);
   m_map_time_nreport[upp_name] = m_curr_time;
   m_map_vgroup[upp_name]  = grp_name;
 
@@ -518,9 +528,24 @@ bool FldNodeComms::handleStealth(const string& str)
 bool FldNodeComms::handleMailCommsRange(double new_range)
 {
   m_comms_range = new_range;
+  updateNodeGridCellSize();
   return(true);
 }
 
+//------------------------------------------------------------
+// Procedure: updateNodeGridCellSize()
+//      Note: A cell size on the order of the baseline comms range
+//            means a typical neighbor query visits a 3x3 block.
+
+void FldNodeComms::updateNodeGridCellSize()
+{
+  double cell_size = m_comms_range;
+  if(m_critical_range > cell_size)
+    cell_size = m_critical_range;
+  if(cell_size > 0)
+    m_node_grid.setCellSize(cell_size);
+}
+
 //------------------------------------------------------------
 // Procedure: handleEarange()
 //   Example: vname=alpha,earange=0.5
@@ -602,11 +627,11 @@ void FldNodeComms::distributeNodeReportInfo(const string& uname)
     return;
 
   // We'll need the same node report sent out to all vehicles.
-  string node_report = record.getSpec();
+  string node_report = assembleNodeReport(uname);
 
-  map<string, NodeRecord>::iterator p;
-  for(p=m_map_record.begin(); p!=m_map_record.end(); p++) {
-    string vname = p->first;
+  vector<string> rcvrs = getCandidateReceivers(uname);
+  for(unsigned int i=0; i<rcvrs.size(); i++) {
+    string vname = rcvrs[i];
 
     // Criteria #1: vehicles different
     if(vname == uname)
@@ -665,7 +690,7 @@ void FldNodeComms::distributeNodeReportInfo(const string& uname)
 
     if(msg_send) {
       string moos_var = "NODE_REPORT_" + vname;
-      Notify(moos_var, node_report);
+      postNodeReport(moos_var, uname, node_report);
       if(m_view_node_rpt_pulses)
 	postViewCommsPulse(uname, vname);
       m_total_reports_sent++;
@@ -685,6 +710,62 @@ void FldNodeComms::distributeNodeReportInfo(const string& uname)
 }
 
 
+//------------------------------------------------------------
+// Procedure: getCandidateReceivers()
+//   Purpose: Determine the set of vehicles that may possibly hear
+//            the node report of vehicle <uname>. Rather than check
+//            all vehicles, the node grid is queried for vehicles
+//            within the largest range at which any criteria could
+//            be met, i.e., the max of the critical range and the
+//            comms range scaled by stealth and the largest earange.
+//     Notes: The exact per-pair criteria are still applied by the
+//            caller. Returned names are in the same (sorted) order
+//            as a walk through m_map_record.
+
+vector<string> FldNodeComms::getCandidateReceivers(const string& uname)
+{
+  vector<string> rcvrs;
+
+  // A negative comms range means all comms goes through, so no
+  // vehicle may be excluded on the basis of range.
+  if((m_comms_range < 0) || !m_node_grid.contains(uname)) {
+    map<string, NodeRecord>::iterator p;
+    for(p=m_map_record.begin(); p!=m_map_record.end(); p++)
+      rcvrs.push_back(p->first);
+    return(rcvrs);
+  }
+
+  double stealth = 1.0;
+  if(m_map_stealth.count(uname))
+    stealth = m_map_stealth[uname];
+
+  double max_earange = 1.0;
+  map<string, double>::iterator q;
+  for(q=m_map_earange.begin(); q!=m_map_earange.end(); q++) {
+    if(q->second > max_earange)
+      max_earange = q->second;
+  }
+  
+  double range = m_comms_range * stealth * max_earange;
+  if(m_critical_range > range)
+    range = m_critical_range;
+
+  double x = m_node_grid.getX(uname);
+  double y = m_node_grid.getY(uname);
+  rcvrs = m_node_grid.getKeysInRange(x, y, range);
+
+  // A pending full report request must reach its requester
+  // regardless of range.
+  if((m_full_rpt_vname != "") && m_map_record.count(m_full_rpt_vname)) {
+    if(!binary_search(rcvrs.begin(), rcvrs.end(), m_full_rpt_vname)) {
+      rcvrs.push_back(m_full_rpt_vname);
+      sort(rcvrs.begin(), rcvrs.end());
+    }
+  }
+  
+  return(rcvrs);
+}
+
 //------------------------------------------------------------
 // Procedure: localShareNodeReportInfo()
 //   Purpose: Post the node report for vehicle <uname> to a variable 
@@ -713,8 +794,40 @@ void FldNodeComms::localShareNodeReportInfo(const string& uname)
 
   // Post the report and note the time stamp
   m_map_lshare_tstamp[uname] = m_curr_time;
-  string node_report = record.getSpec();
-  Notify("NODE_REPORT_UNC", node_report);
+  string node_report = assembleNodeReport(uname);
+  postNodeReport("NODE_REPORT_UNC", uname, node_report);
+}
+
+//------------------------------------------------------------
+// Procedure: assembleNodeReport()
+//   Purpose: Build the outgoing node report for vehicle <uname> in
+//            the same form it was received, either as a string or
+//            in the compact binary encoding. The string form is used
+//            if the record cannot be binary encoded.
+
+string FldNodeComms::assembleNodeReport(const string& uname)
+{
+  string report;
+  if(m_map_binary_rpt[uname] &&
+     nodeRecord2Binary(m_map_record[uname], report))
+    return(report);
+  return(m_map_record[uname].getSpec());
+}
+
+//------------------------------------------------------------
+// Procedure: postNodeReport()
+//   Purpose: Post a report made by assembleNodeReport(). Binary
+//            reports are posted as a MOOS_BINARY_STRING.
+
+void FldNodeComms::postNodeReport(const string& var, const string& uname,
+				  const string& report)
+{
+  if(!m_map_binary_rpt[uname] || !isBinaryNodeReport(report)) {
+    Notify(var, report);
+    return;
+  }
+  vector<unsigned char> bytes(report.begin(), report.end());
+  Notify(var, bytes);
 }
 
 
@@ -30,6 +30,7 @@
 #include "NodeRecord.h"
 #include "NodeMessage.h"
 #include "AckMessage.h"
+#include "XYSpatialHash.h"
 
 class FldNodeComms : public AppCastingMOOSApp
 {
@@ -59,7 +60,12 @@ class FldNodeComms : public AppCastingMOOSApp
   bool handleEnableSharedNodeReports(std::string);
   
   void distributeNodeReportInfo(const std::string& uname);
+  void updateNodeGridCellSize();
+  std::vector<std::string> getCandidateReceivers(const std::string&);
   void localShareNodeReportInfo(const std::string& uname);
+  std::string assembleNodeReport(const std::string& uname);
+  void postNodeReport(const std::string& var, const std::string& uname,
+		      const std::string& report);
   void distributeNodeMessageInfo(const std::string& uname);
   void distributeNodeMessageInfo(std::string src, NodeMessage msg);
   void distributeAckMessageInfo(const std::string& uname);
@@ -126,6 +132,10 @@ class FldNodeComms : public AppCastingMOOSApp
  protected: // State variables
   // Holds last node report received for vehicle vname
   std::map<std::string, NodeRecord>   m_map_record;     
+  // Spatial index over latest position of each valid record
+  XYSpatialHash                       m_node_grid;
+  // True if vname's last report arrived in binary form
+  std::map<std::string, bool>         m_map_binary_rpt;
   // Holds last time posted local share, if enabled, for each vname
   std::map<std::string, double>       m_map_lshare_tstamp;     
   // Holds last node messsages received for vehicle vname
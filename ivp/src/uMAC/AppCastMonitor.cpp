@@ -210,7 +210,11 @@ void AppCastMonitor::RegisterVariables()
 
 bool AppCastMonitor::handleMailAppCast(const string& str)
 {
-  AppCast appcast   = string2AppCast(str);
+  // Deltas arriving ahead of their keyframe are dropped. The next
+  // keyframe will bring this appcast up to date.
+  AppCast appcast;
+  if(!m_repo.decodeAppCast(str, appcast))
+    return(false);
   string  node_name = appcast.getNodeName();
 
   if(node_name == "")
@@ -406,6 +410,7 @@ void AppCastMonitor::postAppCastRequest(string channel_node,
   str += ",duration=" + doubleToString(duration, 1);
   str += ",key=" + key;
   str += ",thresh=" + threshold;
+  str += ",delta=true";
 
   Notify("APPCAST_REQ", str);
   Notify("APPCAST_REQ_"+toupper(channel_node), str);
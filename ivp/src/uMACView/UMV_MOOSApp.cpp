@@ -451,6 +451,7 @@ void UMV_MOOSApp::postAppCastRequest(string channel_node,
   str += ",duration=" + doubleToString(duration, 1);
   str += ",key=" + key;
   str += ",thresh=" + threshold;
+  str += ",delta=true";
 
   Notify("APPCAST_REQ", str);
   Notify("APPCAST_REQ_"+toupper(channel_node), str);
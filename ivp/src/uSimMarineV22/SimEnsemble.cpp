@@ -0,0 +1,667 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: SimEnsemble.cpp                                      */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+#include <cmath>
+#include "AngleUtils.h"
+#include "SimEnsemble.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------
+// The helpers below are the same operations as vclip(), angle360(),
+// angle180() and degToRadians(), defined here so the member loops
+// carry no out-of-line calls.
+
+static inline double clipv(double var, double low, double high)
+{
+  if(var < low)
+    return(low);
+  if(var > high)
+    return(high);
+  return(var);
+}
+
+static inline double wrap360(double degval)
+{
+  while(degval >= 360.0)
+    degval -= 360.0;
+  while(degval < 0.0)
+    degval += 360.0;
+  return(degval);
+}
+
+static inline double wrap180(double degval)
+{
+  while(degval > 180)
+    degval -= 360.0;
+  while(degval <= -180)
+    degval += 360.0;
+  return(degval);
+}
+
+static inline double toRadians(double degval)
+{
+  return((degval/180.0) * M_PI);
+}
+
+//-----------------------------------------------------------------
+// Constructor()
+
+SimEnsemble::SimEnsemble()
+{
+  m_thrust_mode_reverse = false;
+  m_thrust_mode_diff    = false;
+  m_turn_spd_loss       = 0.85;
+  m_thrust_map.setThrustFactor(20);
+
+  m_max_acceleration     = 0;
+  m_max_deceleration     = 0.5;
+  m_max_sail_spd         = -1;
+  m_turn_rate            = 70;
+  m_rotate_speed         = 0;
+  m_buoyancy_rate        = 0.025;
+  m_max_depth_rate       = 0.5;
+  m_max_depth_rate_speed = 2.0;
+
+  m_current_set    = false;
+  m_current_radius = 0;
+  m_hdg_trig_ok    = false;
+
+  m_current_time_base = 0;
+}
+
+//-----------------------------------------------------------------
+// Procedure: resize()
+//      Note: New members start at rest at the origin with zero
+//            actuator and drift inputs.
+
+void SimEnsemble::resize(unsigned int n)
+{
+  m_x.resize(n, 0);
+  m_y.resize(n, 0);
+  m_hdg.resize(n, 0);
+  m_spd.resize(n, 0);
+  m_dep.resize(n, 0);
+  m_pitch.resize(n, 0);
+  m_yaw.resize(n, 0);
+  m_sog.resize(n, 0);
+  m_hog.resize(n, 0);
+  m_time.resize(n, 0);
+
+  m_thrust.resize(n, 0);
+  m_rudder.resize(n, 0);
+  m_elevator.resize(n, 0);
+  m_thrust_lft.resize(n, 0);
+  m_thrust_rgt.resize(n, 0);
+  m_drift_x.resize(n, 0);
+  m_drift_y.resize(n, 0);
+
+  m_prior_spd.resize(n, 0);
+  m_total_drift_x.resize(n, 0);
+  m_total_drift_y.resize(n, 0);
+  m_cmd_thrust.resize(n, 0);
+  m_cmd_rudder.resize(n, 0);
+  m_next_spd.resize(n, 0);
+  m_cf_count.resize(n, 0);
+  m_sin_hdg.resize(n, 0);
+  m_cos_hdg.resize(n, 0);
+  m_hdg_trig_ok = false;
+}
+
+//-----------------------------------------------------------------
+// Procedure: setMember()
+
+void SimEnsemble::setMember(unsigned int ix, const NodeRecord& record)
+{
+  if(ix >= m_x.size())
+    return;
+
+  m_x[ix]     = record.getX();
+  m_y[ix]     = record.getY();
+  m_hdg[ix]   = record.getHeading();
+  m_spd[ix]   = record.getSpeed();
+  m_dep[ix]   = record.getDepth();
+  m_pitch[ix] = record.getPitch();
+  m_yaw[ix]   = record.getYaw();
+  m_sog[ix]   = record.getSpeedOG();
+  m_hog[ix]   = record.getHeadingOG();
+  m_time[ix]  = record.getTimeStamp();
+  m_hdg_trig_ok = false;
+}
+
+//-----------------------------------------------------------------
+// Procedure: getMember()
+
+NodeRecord SimEnsemble::getMember(unsigned int ix) const
+{
+  NodeRecord record;
+  if(ix >= m_x.size())
+    return(record);
+
+  record.setX(m_x[ix]);
+  record.setY(m_y[ix]);
+  record.setHeading(m_hdg[ix]);
+  record.setSpeed(m_spd[ix]);
+  record.setDepth(m_dep[ix]);
+  record.setPitch(m_pitch[ix]);
+  record.setYaw(m_yaw[ix]);
+  record.setSpeedOG(m_sog[ix]);
+  record.setHeadingOG(m_hog[ix]);
+  record.setTimeStamp(m_time[ix]);
+  if(m_thrust_mode_reverse)
+    record.setThrustModeReverse(true);
+  return(record);
+}
+
+//-----------------------------------------------------------------
+// Procedure: setTurnSpdLoss()
+
+void SimEnsemble::setTurnSpdLoss(double dval)
+{
+  if((dval < 0) || (dval > 1))
+    return;
+  m_turn_spd_loss = dval;
+}
+
+//-----------------------------------------------------------------
+// Procedure: setCurrentField()
+//   Purpose: Unpack the field vectors into flat arrays. The field is
+//            sampled at each member position at the start of each
+//            step and added to the member drift.
+
+void SimEnsemble::setCurrentField(CurrentField field)
+{
+  m_cf_x.clear();
+  m_cf_y.clear();
+  m_cf_xdot.clear();
+  m_cf_ydot.clear();
+
+  vector<XYVector> vectors = field.getVectors();
+  for(unsigned int i=0; i<vectors.size(); i++) {
+    m_cf_x.push_back(vectors[i].xpos());
+    m_cf_y.push_back(vectors[i].ypos());
+    m_cf_xdot.push_back(vectors[i].xdot());
+    m_cf_ydot.push_back(vectors[i].ydot());
+  }
+  m_current_radius = field.getRadius();
+  m_current_set = true;
+}
+
+//-----------------------------------------------------------------
+// Procedure: clearCurrentField()
+
+void SimEnsemble::clearCurrentField()
+{
+  m_cf_x.clear();
+  m_cf_y.clear();
+  m_cf_xdot.clear();
+  m_cf_ydot.clear();
+  m_current_radius = 0;
+  m_current_set = false;
+}
+
+//-----------------------------------------------------------------
+// Procedure: setCurrentGrid()
+//   Purpose: Gridded currents, added to the member drift after any
+//            current field. Copies of a grid share its node data.
+
+void SimEnsemble::setCurrentGrid(const CurrentGrid& grid, double time_base)
+{
+  m_current_grid = grid;
+  m_current_time_base = time_base;
+}
+
+//-----------------------------------------------------------------
+// Procedures: setThrust(), setRudder(), setElevator(),
+//             setThrustLeft(), setThrustRight(), setDrift()
+//    Purpose: Apply the same input to all members.
+
+void SimEnsemble::setThrust(double v)
+{
+  m_thrust.assign(m_thrust.size(), v);
+}
+
+void SimEnsemble::setRudder(double v)
+{
+  m_rudder.assign(m_rudder.size(), v);
+}
+
+void SimEnsemble::setElevator(double v)
+{
+  m_elevator.assign(m_elevator.size(), v);
+}
+
+void SimEnsemble::setThrustLeft(double v)
+{
+  m_thrust_lft.assign(m_thrust_lft.size(), v);
+}
+
+void SimEnsemble::setThrustRight(double v)
+{
+  m_thrust_rgt.assign(m_thrust_rgt.size(), v);
+}
+
+void SimEnsemble::setDrift(double x, double y)
+{
+  m_drift_x.assign(m_drift_x.size(), x);
+  m_drift_y.assign(m_drift_y.size(), y);
+}
+
+void SimEnsemble::setDrift(unsigned int ix, double x, double y)
+{
+  m_drift_x[ix] = x;
+  m_drift_y[ix] = y;
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagate()
+//   Purpose: Advance all members by delta_time. The stages and their
+//            order follow USM_Model::propagateNodeRecord() with
+//            external forces applied. Sailing is reduced to a fixed
+//            max_sail_spd and Lat/Lon and altitude are not updated.
+
+void SimEnsemble::propagate(double delta_time)
+{
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    m_prior_spd[i] = m_spd[i];
+  }
+
+  // The sin/cos of the prior heading are those of the heading left
+  // by the last step, unless a member has been set since.
+  if(!m_hdg_trig_ok) {
+    for(unsigned int i=0; i<n; i++) {
+      m_sin_hdg[i] = sin(toRadians(m_hdg[i]));
+      m_cos_hdg[i] = cos(toRadians(m_hdg[i]));
+    }
+  }
+
+  if(m_thrust_mode_diff) {
+    propagateSpeedDiffMode(delta_time);
+    propagateHeadingDiffMode(delta_time);
+  }
+  else {
+    propagateSpeed(delta_time, m_thrust, m_rudder, m_max_sail_spd);
+    propagateHeading(delta_time);
+  }
+
+  propagateDepth(delta_time);
+
+  if(m_thrust_mode_reverse)
+    propagateReverse();
+
+  sampleCurrents();
+  propagatePosition(delta_time);
+  m_hdg_trig_ok = true;
+}
+
+//-----------------------------------------------------------------
+// Procedure: sampleCurrents()
+//   Purpose: Total drift per member: the member drift, plus the
+//            current field, plus the current grid if set.
+
+void SimEnsemble::sampleCurrents()
+{
+  unsigned int n = m_x.size();
+  if(!m_current_set) {
+    m_total_drift_x = m_drift_x;
+    m_total_drift_y = m_drift_y;
+  }
+  else
+    sampleCurrentField();
+
+  if(m_current_grid.frames() == 0)
+    return;
+
+  for(unsigned int i=0; i<n; i++) {
+    double fx, fy;
+    double ctime = m_time[i] - m_current_time_base;
+    m_current_grid.getLocalForce(m_x[i], m_y[i], ctime, fx, fy);
+    m_total_drift_x[i] = m_total_drift_x[i] + fx;
+    m_total_drift_y[i] = m_total_drift_y[i] + fy;
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: sampleCurrentField()
+//   Purpose: Drift plus field current per member. The field lookup is
+//            the same as CurrentField::getLocalForce(), with the loop
+//            over field vectors outermost. Each member still sums the
+//            vectors in field order so the result matches the
+//            per-member call.
+
+void SimEnsemble::sampleCurrentField()
+{
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    m_total_drift_x[i] = 0;
+    m_total_drift_y[i] = 0;
+    m_cf_count[i] = 0;
+  }
+
+  // Pairs clearly out of range are rejected on the squared distance,
+  // with a margin so that no pair hypot() puts in range is skipped.
+  double radius = m_current_radius;
+  double reject = (radius * radius) * (1 + 1e-9);
+  for(unsigned int k=0; k<m_cf_x.size(); k++) {
+    double xpos = m_cf_x[k];
+    double ypos = m_cf_y[k];
+    double vxdot = m_cf_xdot[k];
+    double vydot = m_cf_ydot[k];
+    for(unsigned int i=0; i<n; i++) {
+      double dx = m_x[i]-xpos;
+      double dy = m_y[i]-ypos;
+      if(((dx*dx) + (dy*dy)) > reject)
+	continue;
+      double dist = hypot(dx, dy);
+      if(dist < radius) {
+	m_cf_count[i]++;
+	double pct = (1 - (dist / radius));
+	pct = pct * pct;
+	m_total_drift_x[i] += pct * vxdot;
+	m_total_drift_y[i] += pct * vydot;
+      }
+    }
+  }
+
+  for(unsigned int i=0; i<n; i++) {
+    double fx = 0;
+    double fy = 0;
+    if(m_cf_count[i] > 0) {
+      fx = m_total_drift_x[i] / (double)(m_cf_count[i]);
+      fy = m_total_drift_y[i] / (double)(m_cf_count[i]);
+    }
+    m_total_drift_x[i] = m_drift_x[i] + fx;
+    m_total_drift_y[i] = m_drift_y[i] + fy;
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagateSpeed()
+//      Note: Same as SimEngine::propagateSpeed(). The thrust map is
+//            only consulted when the thrust differs from the prior
+//            member, so a uniform thrust costs one lookup per step.
+
+void SimEnsemble::propagateSpeed(double delta_time,
+				 const vector<double>& thrust,
+				 const vector<double>& rudder,
+				 double max_sail_spd)
+{
+  if(delta_time <= 0)
+    return;
+
+  unsigned int n = m_x.size();
+  double sign = m_thrust_mode_reverse ? -1 : 1;
+
+  double last_thrust = 0;
+  double last_speed  = 0;
+  for(unsigned int i=0; i<n; i++) {
+    double thr = thrust[i];
+    if(m_thrust_mode_reverse)
+      thr = -thr;
+    if((i == 0) || (thr != last_thrust)) {
+      last_thrust = thr;
+      last_speed  = m_thrust_map.getSpeedValue(thr);
+    }
+    m_next_spd[i] = last_speed;
+  }
+
+  double max_accel = m_max_acceleration;
+  double max_decel = m_max_deceleration;
+  double spd_loss  = m_turn_spd_loss;
+  for(unsigned int i=0; i<n; i++) {
+    double next_speed = m_next_spd[i];
+    double prev_speed = m_spd[i];
+    if((max_sail_spd > 0) && (next_speed > max_sail_spd))
+      next_speed = max_sail_spd;
+
+    double rud = clipv(sign * rudder[i], -100, 100);
+    double vpct = (fabs(rud) / 100) * spd_loss;
+    next_speed *= (1.0 - vpct);
+
+    if(next_speed > prev_speed) {
+      double acceleration = (next_speed - prev_speed) / delta_time;
+      if((max_accel > 0) && (acceleration > max_accel))
+	next_speed = (max_accel * delta_time) + prev_speed;
+    }
+    if(next_speed < prev_speed) {
+      double deceleration = (prev_speed - next_speed) / delta_time;
+      if((max_decel > 0) && (deceleration > max_decel))
+	next_speed = (max_decel * delta_time * -1) + prev_speed;
+    }
+    m_spd[i] = next_speed;
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagateHeading()
+//      Note: Same as SimEngine::propagateHeading(), with the turn
+//            speed map evaluated inline.
+
+void SimEnsemble::propagateHeading(double delta_time)
+{
+  m_turn_speed_map.setFullRate(m_turn_rate);
+  m_turn_speed_map.setFullSpeed(5);
+
+  double full_speed = m_turn_speed_map.getFullSpeed();
+  double null_speed = m_turn_speed_map.getNullSpeed();
+  double full_rate  = m_turn_speed_map.getFullRate();
+  double null_rate  = m_turn_speed_map.getNullRate();
+  double speed_range = full_speed - null_speed;
+  double rate_range  = full_rate  - null_rate;
+  double rotate_speed = m_rotate_speed;
+
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    double speed  = m_spd[i];
+    double rudder = m_rudder[i];
+    double thrust = m_thrust[i];
+    if(speed == 0)
+      rudder = 0;
+    if(m_thrust_mode_reverse) {
+      thrust = -thrust;
+      rudder = -rudder;
+    }
+
+    // Same as TurnSpeedMap::getTurnRate()
+    double turn_rate = 0;
+    if((full_speed < 0) || (full_rate < 0))
+      turn_rate = 0;
+    else if(speed <= null_speed)
+      turn_rate = null_rate;
+    else if(speed >= full_speed)
+      turn_rate = full_rate;
+    else if(speed_range > 0) {
+      double pct = (speed - null_speed) / speed_range;
+      turn_rate = (pct * rate_range) + null_rate;
+    }
+
+    rudder    = clipv(rudder, -100, 100);
+    turn_rate = clipv(turn_rate, 0, 100);
+
+    double delta_deg = rudder * (turn_rate/100) * delta_time;
+    delta_deg = (1 + ((thrust-50)/50)) * delta_deg;
+    delta_deg += (delta_time * rotate_speed);
+
+    double new_heading = wrap360(delta_deg + m_hdg[i]);
+    m_hdg[i] = new_heading;
+    m_yaw[i] = -toRadians(wrap180(new_heading));
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagateSpeedDiffMode()
+
+void SimEnsemble::propagateSpeedDiffMode(double delta_time)
+{
+  if(delta_time <= 0)
+    return;
+
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    m_cmd_thrust[i] = (m_thrust_lft[i] + m_thrust_rgt[i]) / 2.0;
+    m_cmd_rudder[i] = (m_thrust_lft[i] - m_thrust_rgt[i]) / 2;
+  }
+  propagateSpeed(delta_time, m_cmd_thrust, m_cmd_rudder, -1);
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagateHeadingDiffMode()
+
+void SimEnsemble::propagateHeadingDiffMode(double delta_time)
+{
+  if(delta_time <= 0)
+    return;
+
+  double rotate_speed = m_rotate_speed;
+
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    double thrust_lft = m_thrust_lft[i];
+    double thrust_rgt = m_thrust_rgt[i];
+    if(m_thrust_mode_reverse) {
+      double tmp = thrust_lft;
+      thrust_lft = -thrust_rgt;
+      thrust_rgt = tmp;
+    }
+    double turn_mag = (thrust_lft - thrust_rgt) / 200;
+    double degs_per_second = 36 * turn_mag;
+
+    double delta_deg = degs_per_second * delta_time;
+    delta_deg += (delta_time * rotate_speed);
+
+    double new_heading = wrap360(delta_deg + m_hdg[i]);
+    m_hdg[i] = new_heading;
+    m_yaw[i] = -toRadians(wrap180(new_heading));
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagateDepth()
+//      Note: Same as SimEngine::propagateDepth()
+
+void SimEnsemble::propagateDepth(double delta_time)
+{
+  double buoyancy_rate  = m_buoyancy_rate;
+  double max_depth_rate = m_max_depth_rate;
+  double max_depth_rate_speed = m_max_depth_rate_speed;
+
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    double speed = m_spd[i];
+    double prev_depth = m_dep[i];
+    double elevator_angle = clipv(m_elevator[i], -100, 100);
+    if(speed <= 0) {
+      m_dep[i]   = prev_depth + (-1 * buoyancy_rate * delta_time);
+      m_pitch[i] = 0.0;
+    }
+    else {
+      double pct = 1.0;
+      if(max_depth_rate_speed > 0) {
+	pct = (speed / max_depth_rate_speed);
+	if(pct > 1.0)
+	  pct = 1.0;
+      }
+      if(pct < 0)
+	pct = -1 * sqrt(-1 * pct);
+      else
+	pct = sqrt(pct);
+      double depth_rate = pct * max_depth_rate;
+      double pitch_depth_rate = - sin(m_pitch[i])*speed;
+      double actuator_depth_rate = (elevator_angle/100) * depth_rate;
+      double total_depth_rate = (-buoyancy_rate) +  pitch_depth_rate + actuator_depth_rate;
+
+      m_dep[i] = prev_depth + (1 * total_depth_rate * delta_time);
+
+      double pitch = 0;
+      if(speed > 0 && (fabs(pitch_depth_rate+actuator_depth_rate) <= speed))
+	pitch = - asin((pitch_depth_rate+actuator_depth_rate)/speed);
+      m_pitch[i] = pitch;
+    }
+    if(m_dep[i] < 0)
+      m_dep[i] = 0;
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagateReverse()
+//      Note: Same as the thrust_mode_reverse block in
+//            USM_Model::propagateNodeRecord()
+
+void SimEnsemble::propagateReverse()
+{
+  double pi = 3.1415926;
+
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    m_hdg[i] = wrap360(m_hdg[i] + 180);
+    m_hog[i] = wrap360(m_hog[i] + 180);
+
+    double new_yaw = m_yaw[i] + pi;
+    if(new_yaw > (2* pi))
+      new_yaw = new_yaw - (2 * pi);
+    m_yaw[i] = new_yaw;
+  }
+}
+
+//-----------------------------------------------------------------
+// Procedure: propagatePosition()
+//      Note: Same as SimEngine::propagate()
+
+void SimEnsemble::propagatePosition(double delta_time)
+{
+  unsigned int n = m_x.size();
+  for(unsigned int i=0; i<n; i++) {
+    double speed = (m_spd[i] + m_prior_spd[i]) / 2;
+
+    double sin_hdg = sin(toRadians(m_hdg[i]));
+    double cos_hdg = cos(toRadians(m_hdg[i]));
+    double s = m_sin_hdg[i] + sin_hdg;
+    double c = m_cos_hdg[i] + cos_hdg;
+    double hdg_rad = atan2(s, c);
+    m_sin_hdg[i] = sin_hdg;
+    m_cos_hdg[i] = cos_hdg;
+
+    double prev_x = m_x[i];
+    double prev_y = m_y[i];
+    double drift_x = m_total_drift_x[i];
+    double drift_y = m_total_drift_y[i];
+
+    double xdot = (sin(hdg_rad) * speed);
+    double ydot = (cos(hdg_rad) * speed);
+
+    double new_speed = hypot(xdot, ydot);
+    if(speed < 0)
+      new_speed = -new_speed;
+
+    double new_x = prev_x + (xdot * delta_time) + (drift_x * delta_time);
+    double new_y = prev_y + (ydot * delta_time) + (drift_y * delta_time);
+
+    m_spd[i]  = new_speed;
+    m_x[i]    = new_x;
+    m_y[i]    = new_y;
+    m_time[i] = m_time[i] + delta_time;
+    m_sog[i]  = hypot((xdot + drift_x), (ydot + drift_y));
+    m_hog[i]  = relAng(prev_x, prev_y, new_x, new_y);
+  }
+}
@@ -0,0 +1,179 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    ORGN: Dept of Mechanical Engineering, MIT, Cambridge MA    */
+/*    FILE: SimEnsemble.h                                        */
+/*    DATE: October 19th, 2026                                   */
+/*                                                               */
+/* This file is part of MOOS-IvP                                 */
+/*                                                               */
+/* MOOS-IvP is free software: you can redistribute it and/or     */
+/* modify it under the terms of the GNU General Public License   */
+/* as published by the Free Software Foundation, either version  */
+/* 3 of the License, or (at your option) any later version.      */
+/*                                                               */
+/* MOOS-IvP is distributed in the hope that it will be useful,   */
+/* but WITHOUT ANY WARRANTY; without even the implied warranty   */
+/* of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See  */
+/* the GNU General Public License for more details.              */
+/*                                                               */
+/* You should have received a copy of the GNU General Public     */
+/* License along with MOOS-IvP.  If not, see                     */
+/* <http://www.gnu.org/licenses/>.                               */
+/*****************************************************************/
+
+
+#ifndef SIM_ENSEMBLE_HEADER
+#define SIM_ENSEMBLE_HEADER
+
+#include <vector>
+#include "NodeRecord.h"
+#include "ThrustMap.h"
+#include "TurnSpeedMap.h"
+#include "CurrentField.h"
+#include "CurrentGrid.h"
+
+//-----------------------------------------------------------------
+// SimEnsemble is a batch form of the SimEngine. It holds the state
+// of N vehicles (ensemble members) as parallel arrays, one per
+// NodeRecord field, and advances all members with the same physics
+// as USM_Model::propagateNodeRecord() -> SimEngine. Each stage is
+// a flat loop over the members so the compiler may vectorize it,
+// and the floating point operations are done in the same order as
+// the per-record path, so results are identical to it.
+
+class SimEnsemble
+{
+public:
+  SimEnsemble();
+  ~SimEnsemble() {}
+
+public: // Ensemble size and member state
+  void resize(unsigned int);
+  unsigned int size() const {return(m_x.size());}
+
+  void setMember(unsigned int ix, const NodeRecord&);
+  NodeRecord getMember(unsigned int ix) const;
+
+public: // Configuration shared by all members
+  void setThrustMap(const ThrustMap& tmap) {m_thrust_map=tmap;}
+  void setTurnSpeedMap(TurnSpeedMap tsmap) {m_turn_speed_map=tsmap;}
+  void setThrustModeReverse(bool v)        {m_thrust_mode_reverse=v;}
+  void setThrustModeDiff(bool v)           {m_thrust_mode_diff=v;}
+  void setTurnSpdLoss(double);
+
+  void setMaxAcceleration(double v)  {m_max_acceleration=v;}
+  void setMaxDeceleration(double v)  {m_max_deceleration=v;}
+  void setMaxSailSpeed(double v)     {m_max_sail_spd=v;}
+  void setTurnRate(double v)         {m_turn_rate=v;}
+  void setRotateSpeed(double v)      {m_rotate_speed=v;}
+  void setBuoyancyRate(double v)     {m_buoyancy_rate=v;}
+  void setMaxDepthRate(double v)     {m_max_depth_rate=v;}
+  void setMaxDepthRateSpeed(double v){m_max_depth_rate_speed=v;}
+
+  void setCurrentField(CurrentField);
+  void clearCurrentField();
+  void setCurrentGrid(const CurrentGrid&, double time_base=0);
+  void clearCurrentGrid()            {m_current_grid.clear();}
+
+public: // Actuator and drift inputs, either all members or one
+  void setThrust(double);
+  void setRudder(double);
+  void setElevator(double);
+  void setThrustLeft(double);
+  void setThrustRight(double);
+  void setDrift(double x, double y);
+
+  void setThrust(unsigned int ix, double v)      {m_thrust[ix]=v;}
+  void setRudder(unsigned int ix, double v)      {m_rudder[ix]=v;}
+  void setElevator(unsigned int ix, double v)    {m_elevator[ix]=v;}
+  void setThrustLeft(unsigned int ix, double v)  {m_thrust_lft[ix]=v;}
+  void setThrustRight(unsigned int ix, double v) {m_thrust_rgt[ix]=v;}
+  void setDrift(unsigned int ix, double x, double y);
+
+public: // Propagation
+  void propagate(double delta_time);
+
+public: // Read access to the member arrays
+  const std::vector<double>& getX() const       {return(m_x);}
+  const std::vector<double>& getY() const       {return(m_y);}
+  const std::vector<double>& getHeading() const {return(m_hdg);}
+  const std::vector<double>& getSpeed() const   {return(m_spd);}
+  const std::vector<double>& getDepth() const   {return(m_dep);}
+
+protected:
+  void sampleCurrents();
+  void sampleCurrentField();
+  void propagateSpeed(double delta_time, const std::vector<double>& thrust,
+		      const std::vector<double>& rudder, double max_sail_spd);
+  void propagateHeading(double delta_time);
+  void propagateSpeedDiffMode(double delta_time);
+  void propagateHeadingDiffMode(double delta_time);
+  void propagateDepth(double delta_time);
+  void propagateReverse();
+  void propagatePosition(double delta_time);
+
+protected: // Member state, one entry per member
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_hdg;
+  std::vector<double> m_spd;
+  std::vector<double> m_dep;
+  std::vector<double> m_pitch;
+  std::vector<double> m_yaw;
+  std::vector<double> m_sog;
+  std::vector<double> m_hog;
+  std::vector<double> m_time;
+
+  // Per-member inputs
+  std::vector<double> m_thrust;
+  std::vector<double> m_rudder;
+  std::vector<double> m_elevator;
+  std::vector<double> m_thrust_lft;
+  std::vector<double> m_thrust_rgt;
+  std::vector<double> m_drift_x;
+  std::vector<double> m_drift_y;
+
+  // Per-step scratch
+  std::vector<double> m_prior_spd;
+  std::vector<double> m_total_drift_x;
+  std::vector<double> m_total_drift_y;
+  std::vector<double> m_cmd_thrust;
+  std::vector<double> m_cmd_rudder;
+  std::vector<double> m_next_spd;
+  std::vector<unsigned int> m_cf_count;
+
+  // sin/cos of each member heading as of the end of the last step
+  std::vector<double> m_sin_hdg;
+  std::vector<double> m_cos_hdg;
+  bool m_hdg_trig_ok;
+
+protected: // Shared configuration
+  ThrustMap    m_thrust_map;
+  TurnSpeedMap m_turn_speed_map;
+
+  bool   m_thrust_mode_reverse;
+  bool   m_thrust_mode_diff;
+  double m_turn_spd_loss;
+  double m_max_acceleration;
+  double m_max_deceleration;
+  double m_max_sail_spd;
+  double m_turn_rate;
+  double m_rotate_speed;
+  double m_buoyancy_rate;
+  double m_max_depth_rate;
+  double m_max_depth_rate_speed;
+
+  // Current field vectors, unpacked
+  bool   m_current_set;
+  double m_current_radius;
+  std::vector<double> m_cf_x;
+  std::vector<double> m_cf_y;
+  std::vector<double> m_cf_xdot;
+  std::vector<double> m_cf_ydot;
+
+  // Gridded currents, sampled at member time less the time base
+  CurrentGrid m_current_grid;
+  double      m_current_time_base;
+};
+
+#endif
@@ -105,6 +105,10 @@ void showExampleConfigAndExit()
   blk("  drift_y       = 0                                             ");
   blk("  rotate_speed  = 0                                             ");
   blk("  drift_vector  = 0,0     "," // heading, magnitude             ");
+  blk("                                                                ");
+  blk("  current_grid     = currents.cgrid  // Binary gridded currents ");
+  blk("  current_grid_utc = false   // Frame times are UTC, not secs   ");
+  blk("                             // since startup (Default false)   ");
   blk("                                                                ");  
   blk("  turn_spd_map_full_speed = 1    // meters/sec (Default = 1)    ");  
   blk("  turn_spd_map_null_speed = 0    // meters/sec (Default = 0)    ");  
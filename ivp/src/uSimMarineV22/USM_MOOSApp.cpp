@@ -344,6 +344,10 @@ bool USM_MOOSApp::OnStartUp()
       handled = setNonWhiteVarOnString(m_sim_prefix, value);
     else if(param == "drift_vector")
       handled = m_model.setDriftVector(value, "");
+    else if(param == "current_grid")
+      handled = m_model.setCurrentGrid(value);
+    else if(param == "current_grid_utc")
+      handled = m_model.setCurrentGridUTC(value);
     else if(param == "sim_pause")
       handled = m_model.setPaused(value);
     else if(param == "dual_state")
@@ -393,6 +397,9 @@ bool USM_MOOSApp::OnStartUp()
       m_model.setGeodesy(geodesy);
   }
   
+  // Current grid frame times are relative to startup unless utc
+  m_model.setCurrentTimeBase(m_curr_time);
+
   // Note Geodesy best set (as above) before building cache
   m_model.cacheStartingInfo();
  
@@ -934,8 +941,17 @@ bool USM_MOOSApp::buildReport()
     drift_srcs = "n/a";
   actab << "Present" << drift_x << drift_y << drift_mag << drift_ang;
   actab << rotate_spd << drift_srcs;
+  if(m_model.usingCurrentGrid()) {
+    double cx = m_model.getCurrentX();
+    double cy = m_model.getCurrentY();
+    actab << "Current" << doubleToStringX(cx,3) << doubleToStringX(cy,3);
+    actab << doubleToStringX(hypot(cx,cy),4) << "-" << "-" << "current_grid";
+  }
   m_msgs << actab.getFormattedString();
-  m_msgs << endl << endl;
+  m_msgs << endl;
+  if(m_model.usingCurrentGrid())
+    m_msgs << "Current Grid: " << m_model.getCurrentGridSummary() << endl;
+  m_msgs << endl;
 
   // Part 4: Speed/Thrust Info =======================================
   m_msgs << "Velocity Information: " << endl;
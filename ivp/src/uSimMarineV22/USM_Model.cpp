@@ -73,6 +73,11 @@ USM_Model::USM_Model()
 
   m_geo_ok = false;
   m_obstacle_hit = false;
+
+  m_current_utc       = false;
+  m_current_time_base = 0;
+  m_current_x         = 0;
+  m_current_y         = 0;
 }
 
 //------------------------------------------------------------------------
@@ -479,6 +484,39 @@ bool USM_Model::propagate(double g_curr_time)
   return(true);
 }
 
+//--------------------------------------------------------------------
+// Procedure: setCurrentGrid()
+//   Purpose: Load a gridded current field from a binary grid file,
+//            as written by CurrentGrid::writeBinary().
+
+bool USM_Model::setCurrentGrid(string filename)
+{
+  if(!m_current_grid.readBinary(filename))
+    return(false);
+  m_current_grid_file = filename;
+  return(true);
+}
+
+//--------------------------------------------------------------------
+// Procedure: setCurrentGridUTC()
+
+bool USM_Model::setCurrentGridUTC(string value)
+{
+  return(setBooleanOnString(m_current_utc, value));
+}
+
+//--------------------------------------------------------------------
+// Procedure: getCurrentGridSummary()
+
+string USM_Model::getCurrentGridSummary() const
+{
+  if(m_current_grid.frames() == 0)
+    return("");
+  string str = m_current_grid_file + ": " + m_current_grid.getSummary();
+  str += ",utc=" + boolToString(m_current_utc);
+  return(str);
+}
+
 //--------------------------------------------------------------------
 // Procedure: setDriftX()
 //      Note: A null string source indicates a startup condition
@@ -802,6 +840,15 @@ void USM_Model::propagateNodeRecord(NodeRecord& record,
   if(apply_external_forces) {
     total_drift_x = m_drift_x;
     total_drift_y = m_drift_y;
+    if(m_current_grid.frames() > 0) {
+      double ctime = record.getTimeStamp();
+      if(!m_current_utc)
+	ctime -= m_current_time_base;
+      m_current_grid.getLocalForce(record.getX(), record.getY(), ctime,
+				   m_current_x, m_current_y);
+      total_drift_x += m_current_x;
+      total_drift_y += m_current_y;
+    }
   }
 
   m_sim_engine.propagate(record, delta_time, prior_hdg, prior_spd,
@@ -33,6 +33,7 @@
 #include "PolarPlot.h"
 #include "TurnSpeedMap.h"
 #include "ThrustMap.h"
+#include "CurrentGrid.h"
 #include "MOOS/libMOOSGeodesy/MOOSGeodesy.h"
 
 class USM_Model
@@ -80,6 +81,10 @@ public:
   bool   setDriftVector(std::string, std::string, bool add=false);
   void   magDriftVector(double, std::string src);
 
+  bool   setCurrentGrid(std::string filename);
+  bool   setCurrentGridUTC(std::string);
+  void   setCurrentTimeBase(double v) {m_current_time_base=v;}
+
   bool   initPosition(std::string);
   bool   addThrustMapping(double, double);
   bool   handleFullThrustMapping(std::string);
@@ -122,6 +127,11 @@ public:
 
   std::string getDriftSources() const;
 
+  bool        usingCurrentGrid() const {return(m_current_grid.frames() > 0);}
+  std::string getCurrentGridSummary() const;
+  double      getCurrentX() const {return(m_current_x);}
+  double      getCurrentY() const {return(m_current_y);}
+
   bool        sailingEnabled() const;
   std::string getWindArrowSpec() const;
   std::string getWindModelSpec() const;
@@ -181,6 +191,15 @@ public:
   bool       m_drift_fresh;
 
   std::set<std::string> m_drift_sources;
+
+  // Optional gridded current field, added to the external drift.
+  // Frame times are seconds since the time base unless utc is set.
+  CurrentGrid m_current_grid;
+  std::string m_current_grid_file;
+  bool        m_current_utc;
+  double      m_current_time_base;
+  double      m_current_x;
+  double      m_current_y;
   
   bool       m_thrust_mode_reverse;
   unsigned int m_reset_count;
@@ -0,0 +1,188 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testALogQuery)                             */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+#include "MBUtils.h"
+#include "FileBuffer.h"
+#include "LogUtils.h"
+#include "ALogQuery.h"
+#include "ALogQueryEngine.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// The alog served to the queries in run mode. It has a header,
+// aux source names, a non-numeric posting, a near-miss variable
+// name and a node report missing a field.
+
+const char* g_alog[] = {
+  "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%",
+  "%% LOG FILE:       test.alog",
+  "%% LOGSTART        1212385118.5",
+  "%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%",
+  "0.50      NAV_X          uSimMarine       10",
+  "0.50      NAV_Y          uSimMarine       20",
+  "0.75      NAV_SPEED      uSimMarine       1.5",
+  "1.20      NODE_REPORT    uFldNodeBroker   NAME=abe,X=10,Y=20,SPD=1.5",
+  "1.50      NAV_SPEED      uSimMarine       2.5",
+  "2.10      NAV_SPEED      uSimMarine       fast",
+  "2.50      IVPHELM_STATE  pHelmIvP:aux     DRIVE",
+  "3.00      NAV_SPEED_OVER uSimMarine       9",
+  "3.10      NODE_REPORT    uFldNodeBroker   NAME=ben,X=11,SPD=2",
+  "4.40      NAV_SPEED      uSimMarine       3.5",
+  "4.60      BHV_WARNING    pHelmIvP         no waypoints",
+  0};
+
+//--------------------------------------------------------
+// Procedure: collapse()
+//   Purpose: Render output lines as one field for the test results,
+//            with lines joined by '|' and white space runs as '_'.
+//            Grep output lines are shown by their variable name.
+
+string collapse(const vector<string>& lines, bool grep)
+{
+  string result;
+  for(unsigned int i=0; i<lines.size(); i++) {
+    if(i > 0)
+      result += "|";
+    if(grep) {
+      result += getVarName(lines[i]);
+      continue;
+    }
+    string line = stripBlankEnds(lines[i]);
+    bool white = false;
+    for(unsigned int j=0; j<line.length(); j++) {
+      char c = line.at(j);
+      if((c == ' ') || (c == '\t'))
+	white = true;
+      else {
+	if(white)
+	  result += "_";
+	result += c;
+	white = false;
+      }
+    }
+  }
+  return(result);
+}
+
+//--------------------------------------------------------
+// Procedure: runEngine()
+//   Purpose: Serve the queries from one pass over the test alog, in
+//            a scratch directory, reporting the lines written by each
+//            and the output of the last.
+
+bool runEngine(const vector<string>& specs)
+{
+  char dir_template[] = "/tmp/testALogQueryXXXXXX";
+  char* dir = mkdtemp(dir_template);
+  if(!dir || (chdir(dir) != 0))
+    return(false);
+
+  FILE *f = fopen("test.alog", "w");
+  if(!f)
+    return(false);
+  for(unsigned int i=0; g_alog[i]; i++)
+    fprintf(f, "%s\n", g_alog[i]);
+  fclose(f);
+
+  ALogQueryEngine engine;
+  engine.setALogFile("test.alog");
+  bool added = true;
+  for(unsigned int i=0; i<specs.size(); i++)
+    added = engine.addQuery(specs[i]) && added;
+  bool handled = engine.handle();
+
+  // Outputs are named by each query's spec
+  string lines_out;
+  vector<string> last_out;
+  bool last_grep = false;
+  for(unsigned int i=0; i<specs.size(); i++) {
+    ALogQuery query;
+    query.setSpec(specs[i]);
+    vector<string> lines = fileBuffer(query.getFileName());
+    while((lines.size() > 0) && (lines.back() == ""))
+      lines.pop_back();
+    if(i > 0)
+      lines_out += ":";
+    lines_out += uintToString(lines.size());
+    last_out  = lines;
+    last_grep = query.isGrep();
+    unlink(query.getFileName().c_str());
+  }
+  unlink("test.alog");
+  rmdir(dir);
+
+  cout << "added=" << boolToString(added);
+  cout << ",handled=" << boolToString(handled);
+  cout << ",lines=" << lines_out;
+  cout << ",out=" << collapse(last_out, last_grep) << endl;
+  return(true);
+}
+
+int main(int argc, char** argv) 
+{
+  vector<string> specs;
+  string var, src;
+  bool   run = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "spec="))
+      specs.push_back(argi.substr(5));
+    else if(strBegins(argi, "var="))
+      var = argi.substr(4);
+    else if(strBegins(argi, "src="))
+      src = argi.substr(4);
+    else if(argi == "run")
+      run = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testALogQuery: parse an alog query spec, or check a key   " << endl;
+      cout << "match, or with run, serve the given queries from a small  " << endl;
+      cout << "built-in alog and show the output.                        " << endl;
+      cout << "Examples:                                                 " << endl;
+      cout << "$ testALogQuery spec=type=grep,keys=NAV_*,file=a.txt      " << endl;
+      cout << "valid=true,type=grep                                      " << endl;
+      cout << "$ testALogQuery spec=type=grep,keys=NAV_*,file=a.txt \\   " << endl;
+      cout << "     var=NAV_X src=uSimMarine                             " << endl;
+      cout << "valid=true,type=grep,match=true                           " << endl;
+      cout << "$ testALogQuery run spec=type=binavg,var=NAV_SPEED,bin=2,file=a" << endl;
+      cout << "added=true,handled=true,lines=2,out=1_2_1.5_2.5_2|5_3.5_3.5_3.5_1" << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(specs.size() == 0) return(cmdLineErr("spec is not set. Exiting."));
+  
+  if(run) {
+    if(!runEngine(specs))
+      return(cmdLineErr("Unable to set up the test alog. Exiting."));
+    return(0);
+  }
+
+  ALogQuery query;
+  bool valid = query.setSpec(specs[0]);
+  cout << "valid=" << boolToString(valid);
+  if(valid) {
+    cout << ",type=" << query.getType();
+    if((var != "") || (src != ""))
+      cout << ",match=" << boolToString(query.keyMatch(var, src));
+  }
+  cout << endl;
+  return(0);
+}
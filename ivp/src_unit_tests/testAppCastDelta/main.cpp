@@ -0,0 +1,284 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testAppCastDelta)                          */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "AppCastTree.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Class: Sender
+//   Purpose: Post an appcast as an app would in delta mode, either as
+//            a versioned keyframe or as a delta against the last one.
+
+class Sender {
+public:
+  Sender() {m_version=0; m_iter=0;
+    m_ac.setProcName("pFoo"); m_ac.setNodeName("abe");}
+
+  void setLines(const vector<string>& lines) {
+    string msg;
+    for(unsigned int i=0; i<lines.size(); i++)
+      msg += lines[i] + "\n";
+    m_ac.msg(msg);
+  }
+  
+  string keyframe() {
+    m_ac.setIteration(++m_iter);
+    m_ac.setVersion(++m_version);
+    m_keyframe = m_ac;
+    return(m_ac.getAppCastString());
+  }
+  string delta() {
+    m_ac.setIteration(++m_iter);
+    return(m_ac.getAppCastDeltaString(m_keyframe));
+  }
+  
+  // The appcast as a full posting would have rendered it
+  string full() const
+    {return(string2AppCast(m_ac.getAppCastString()).getFormattedString());}
+
+  // An app restart: same proc and node, but no events or warnings
+  void restart() {
+    AppCast ac;
+    ac.setProcName("pFoo");
+    ac.setNodeName("abe");
+    m_ac = ac;
+  }
+
+  AppCast& ac() {return(m_ac);}
+  
+private:
+  AppCast      m_ac;
+  AppCast      m_keyframe;
+  unsigned int m_version;
+  unsigned int m_iter;
+};
+
+//--------------------------------------------------------
+// Procedure: decodeSame()
+//   Purpose: Decode a posting and check that it renders the same as
+//            the sender's appcast sent in full.
+
+bool decodeSame(AppCastTree& tree, Sender& sender, const string& post)
+{
+  AppCast appcast;
+  if(!tree.decodeAppCast(post, appcast))
+    return(false);
+  return(appcast.getFormattedString() == sender.full());
+}
+
+//--------------------------------------------------------
+// Procedure: testRandom()
+//   Purpose: Random line changes, insertions and removals, events,
+//            and run and config warnings, with a keyframe every ten
+//            postings and a delta otherwise.
+
+void testRandom(unsigned int iters)
+{
+  Sender      sender;
+  AppCastTree tree;
+  unsigned int diffs  = 0;
+  unsigned int deltas = 0;
+
+  vector<string> lines;
+  for(unsigned int i=0; i<20; i++)
+    lines.push_back("line " + uintToString(i) + "   x");
+  
+  for(unsigned int i=0; i<iters; i++) {
+    string line = "chg " + uintToString(rand() % 100) + "  : a:b";
+    if(rand() % 4 == 0)
+      line = "   " + line;
+    lines[rand() % lines.size()] = line;
+    if(rand() % 10 == 0)
+      lines.insert(lines.begin() + (rand() % lines.size()), "new");
+    if((rand() % 12 == 0) && (lines.size() > 3))
+      lines.erase(lines.begin() + (rand() % lines.size()));
+    if(rand() % 20 == 0)
+      sender.ac().event("ev " + uintToString(i), i);
+    if(rand() % 30 == 0)
+      sender.ac().runWarning("rw " + uintToString(rand() % 3));
+    if(rand() % 40 == 0)
+      sender.ac().retractRunWarning("rw 1");
+    if(rand() % 60 == 0)
+      sender.ac().cfgWarning("cfg " + uintToString(i));
+    sender.setLines(lines);
+
+    string post;
+    if((i % 10) == 0)
+      post = sender.keyframe();
+    else {
+      post = sender.delta();
+      deltas++;
+    }
+    if(!decodeSame(tree, sender, post))
+      diffs++;
+  }
+
+  cout << "match=" << boolToString(diffs == 0);
+  cout << ",deltas=" << deltas;
+  cout << ",dropped=" << tree.getDroppedDeltaCount() << endl;
+}
+
+//--------------------------------------------------------
+// Procedure: testCase()
+//   Purpose: Send a keyframe, change the appcast as named by the
+//            case, and decode the delta.
+
+void testCase(const string& test_case)
+{
+  Sender      sender;
+  AppCastTree tree;
+
+  vector<string> lines;
+  lines.push_back("Speed: 1.2");
+  lines.push_back("Heading: 90");
+  lines.push_back("Depth: 0");
+  sender.setLines(lines);
+  sender.ac().event("started", 1);
+  sender.ac().runWarning("low battery");
+  sender.ac().cfgWarning("unhandled param: foo");
+
+  bool ok = decodeSame(tree, sender, sender.keyframe());
+
+  if(test_case == "insert") {
+    lines.insert(lines.begin()+1, "Mode: SURVEY");
+    lines.push_back("Done: false");
+  }
+  else if(test_case == "remove")
+    lines.erase(lines.begin());
+  else if(test_case == "indent")
+    lines[0] = "  Speed: 1.4";
+  else if(test_case == "events")
+    sender.ac().event("waypoint 1", 2);
+  else if(test_case == "warnings") {
+    sender.ac().runWarning("low battery");
+    sender.ac().runWarning("no nav");
+    sender.ac().cfgWarning("unhandled param: bar");
+  }
+  else if(test_case == "retract")
+    sender.ac().retractRunWarning("low battery");
+  else if(test_case == "cleared")
+    sender.restart();
+  sender.setLines(lines);
+
+  ok = ok && decodeSame(tree, sender, sender.delta());
+  cout << "match=" << boolToString(ok);
+  cout << ",dropped=" << tree.getDroppedDeltaCount() << endl;
+}
+
+//--------------------------------------------------------
+// Procedure: testMismatch()
+//   Purpose: A delta made against a keyframe the viewer has not seen
+//            is dropped. The next keyframe catches the viewer up.
+
+void testMismatch()
+{
+  Sender      sender;
+  AppCastTree tree;
+
+  vector<string> lines;
+  lines.push_back("Speed: 1.2");
+  sender.setLines(lines);
+
+  bool first = decodeSame(tree, sender, sender.keyframe());
+  sender.keyframe();  // Never received
+  lines[0] = "Speed: 1.3";
+  sender.setLines(lines);
+  AppCast appcast;
+  bool decoded = tree.decodeAppCast(sender.delta(), appcast);
+
+  bool caught_up = decodeSame(tree, sender, sender.keyframe());
+  lines[0] = "Speed: 1.4";
+  sender.setLines(lines);
+  caught_up = caught_up && decodeSame(tree, sender, sender.delta());
+
+  cout << "first=" << boolToString(first);
+  cout << ",decoded=" << boolToString(decoded);
+  cout << ",dropped=" << tree.getDroppedDeltaCount();
+  cout << ",caught_up=" << boolToString(caught_up) << endl;
+}
+
+//--------------------------------------------------------
+// Procedure: testEarly()
+//   Purpose: A delta arriving ahead of any keyframe is dropped.
+
+void testEarly()
+{
+  Sender      sender;
+  AppCastTree tree;
+
+  vector<string> lines;
+  lines.push_back("Speed: 1.2");
+  sender.setLines(lines);
+
+  sender.keyframe();  // Sent before the viewer joined
+  sender.setLines(lines);
+  AppCast appcast;
+  bool decoded = tree.decodeAppCast(sender.delta(), appcast);
+  
+  bool caught_up = decodeSame(tree, sender, sender.keyframe());
+  lines.push_back("Heading: 90");
+  sender.setLines(lines);
+  caught_up = caught_up && decodeSame(tree, sender, sender.delta());
+  
+  cout << "decoded=" << boolToString(decoded);
+  cout << ",dropped=" << tree.getDroppedDeltaCount();
+  cout << ",caught_up=" << boolToString(caught_up) << endl;
+}
+
+int main(int argc, char** argv) 
+{
+  string test_case;
+  unsigned int iters = 500;
+  unsigned int seed  = 1;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "case="))
+      test_case = argi.substr(5);
+    else if(strBegins(argi, "iters="))
+      setUIntOnString(iters, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testAppCastDelta: encode appcasts as keyframes and deltas" << endl;
+      cout << "and decode them with an AppCastTree, checking that each  " << endl;
+      cout << "renders as the appcast sent in full.                     " << endl;
+      cout << "Cases: random, insert, remove, indent, events, warnings, " << endl;
+      cout << "       retract, cleared, mismatch, early                 " << endl;
+      cout << "Example:                                                 " << endl;
+      cout << "$ testAppCastDelta case=random iters=500 seed=3          " << endl;
+      cout << "match=true,deltas=450,dropped=0                          " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(test_case == "") return(cmdLineErr("case is not set. Exiting."));
+  
+  srand(seed);
+
+  if(test_case == "random")
+    testRandom(iters);
+  else if(test_case == "mismatch")
+    testMismatch();
+  else if(test_case == "early")
+    testEarly();
+  else
+    testCase(test_case);
+  return(0);
+}
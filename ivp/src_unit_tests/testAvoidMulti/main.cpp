@@ -0,0 +1,199 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testAvoidMulti)                            */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include "MBUtils.h"
+#include "IvPDomain.h"
+#include "IvPBox.h"
+#include "IvPFunction.h"
+#include "OF_Reflector.h"
+#include "AOF_AvoidCollision.h"
+#include "AOF_AvoidCollisionMulti.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+double randVal(double low, double high)
+{
+  double pct = (double)(rand() % 100000) / 100000.0;
+  return(low + (pct * (high - low)));
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int contacts = 0;  bool contacts_set=false;
+  unsigned int crs_pts = 360;
+  unsigned int spd_pts = 21;
+  unsigned int seed = 1;
+  double max_spd = 5;
+  double tol     = 120;
+  double min_util_cpa_dist = 10;
+  double max_util_cpa_dist = 75;
+  string build_info = "uniform_piece = discrete @ course:3,speed:3";
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "contacts="))
+      contacts_set = setUIntOnString(contacts, argi.substr(9));
+    else if(strBegins(argi, "crss="))
+      setUIntOnString(crs_pts, argi.substr(5));
+    else if(strBegins(argi, "spds="))
+      setUIntOnString(spd_pts, argi.substr(5));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "maxspd="))
+      max_spd = atof(argi.substr(7).c_str());
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testAvoidMulti: test AOF_AvoidCollisionMulti against the  " << endl;
+      cout << "normalized, priority weighted mean of one                  " << endl;
+      cout << "AOF_AvoidCollision per contact, for random contacts.       " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testAvoidMulti contacts=10 crss=360 spds=21 maxspd=5     " << endl;
+      cout << "match=true                                                " << endl;
+      cout << "With the bench arg, the time to build one IvP function   " << endl;
+      cout << "per contact is compared to building one for all contacts." << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!contacts_set) return(cmdLineErr("contacts is not set. Exiting."));
+  if((crs_pts == 0) || (spd_pts < 2))
+    return(cmdLineErr("crss must be > 0 and spds > 1. Exiting."));
+  
+  srand(seed);
+
+  IvPDomain domain;
+  domain.addDomain("course", 0, 360 - (360.0 / crs_pts), crs_pts);
+  domain.addDomain("speed", 0, max_spd, spd_pts);
+
+  double osx = 0;
+  double osy = 0;
+  vector<double> cnx, cny, cnh, cnv, wts;
+  for(unsigned int c=0; c<contacts; c++) {
+    cnx.push_back(randVal(-200, 200));
+    cny.push_back(randVal(-200, 200));
+    cnh.push_back(randVal(0, 360));
+    cnv.push_back(randVal(0, 4));
+    wts.push_back(randVal(0.1, 1));
+  }
+
+  // Part 1: The combined AOF
+  AOF_AvoidCollisionMulti maof(domain);
+  maof.setOwnshipParams(osx, osy);
+  maof.setParam("tol", tol);
+  for(unsigned int c=0; c<contacts; c++)
+    maof.addContact(cnx[c], cny[c], cnh[c], cnv[c], wts[c],
+		    min_util_cpa_dist, max_util_cpa_dist);
+  bool match = maof.initialize();
+
+  // Part 2: One AOF_AvoidCollision per contact, each normalized to
+  // [0,100] and summed with its weight, then divided by total weight.
+  unsigned int total = crs_pts * spd_pts;
+  vector<double> sum(total, 0);
+  double total_wt = 0;
+  vector<AOF_AvoidCollision*> aofs;
+  for(unsigned int c=0; c<contacts; c++) {
+    AOF_AvoidCollision *aof = new AOF_AvoidCollision(domain);
+    aof->setOwnshipParams(osx, osy);
+    aof->setContactParams(cnx[c], cny[c], cnh[c], cnv[c]);
+    aof->setParam("tol", tol);
+    aof->setParam("collision_distance", min_util_cpa_dist);
+    aof->setParam("all_clear_distance", max_util_cpa_dist);
+    if(!aof->initialize())
+      match = false;
+    aofs.push_back(aof);
+
+    vector<double> utils(total, 0);
+    double umin = 100;
+    double umax = 0;
+    IvPBox box(2);
+    for(unsigned int i=0; i<crs_pts; i++) {
+      for(unsigned int j=0; j<spd_pts; j++) {
+	box.setPTS(0, i, i);
+	box.setPTS(1, j, j);
+	double util = aof->evalBox(&box);
+	utils[(i*spd_pts)+j] = util;
+	if(util < umin)
+	  umin = util;
+	if(util > umax)
+	  umax = util;
+      }
+    }
+    for(unsigned int k=0; k<total; k++) {
+      double util = utils[k];
+      if(umax > umin)
+	util = (utils[k] - umin) * (100.0 / (umax - umin));
+      sum[k] += wts[c] * util;
+    }
+    total_wt += wts[c];
+  }
+
+  if(fabs(total_wt - maof.getTotalWeight()) > 1e-9)
+    match = false;
+
+  IvPBox box(2);
+  for(unsigned int i=0; i<crs_pts; i++) {
+    for(unsigned int j=0; j<spd_pts; j++) {
+      box.setPTS(0, i, i);
+      box.setPTS(1, j, j);
+      double expected = sum[(i*spd_pts)+j] / total_wt;
+      if(fabs(maof.evalBox(&box) - expected) > 1e-9)
+	match = false;
+    }
+  }
+
+  cout << "match=" << boolToString(match);
+  if(!bench) {
+    cout << endl;
+    for(unsigned int c=0; c<aofs.size(); c++)
+      delete(aofs[c]);
+    return(0);
+  }
+
+  // Part 3: Timings, one IvP function per contact vs one for all
+  clock_t start = clock();
+  for(unsigned int c=0; c<aofs.size(); c++) {
+    OF_Reflector reflector(aofs[c], 1);
+    reflector.create(build_info);
+    IvPFunction *ipf = reflector.extractIvPFunction();
+    delete(ipf);
+  }
+  double percontact_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  AOF_AvoidCollisionMulti baof(domain);
+  baof.setOwnshipParams(osx, osy);
+  baof.setParam("tol", tol);
+  for(unsigned int c=0; c<contacts; c++)
+    baof.addContact(cnx[c], cny[c], cnh[c], cnv[c], wts[c],
+		    min_util_cpa_dist, max_util_cpa_dist);
+  baof.initialize();
+  OF_Reflector reflector(&baof, 1);
+  reflector.create(build_info);
+  IvPFunction *ipf = reflector.extractIvPFunction();
+  delete(ipf);
+  double multi_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+  
+  cout << ",percontact_secs=" << doubleToStringX(percontact_secs, 6);
+  cout << ",multi_secs=" << doubleToStringX(multi_secs, 6) << endl;
+
+  for(unsigned int c=0; c<aofs.size(); c++)
+    delete(aofs[c]);
+  return(0);
+}
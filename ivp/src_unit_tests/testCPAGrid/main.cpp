@@ -0,0 +1,221 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testCPAGrid)                               */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include "MBUtils.h"
+#include "AngleUtils.h"
+#include "CPAEngine.h"
+#include "CPAEngineThin.h"
+#include "CPAEngineRoot.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+double randVal(double low, double high)
+{
+  double pct = (double)(rand() % 100000) / 100000.0;
+  return(low + (pct * (high - low)));
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int contacts = 0;  bool contacts_set=false;
+  unsigned int hdg_pts = 360;
+  unsigned int spd_pts = 21;
+  unsigned int iters = 1;
+  unsigned int seed = 1;
+  double hdg_low = 0;
+  double max_spd = 5;
+  double ostol   = 60;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "contacts="))
+      contacts_set = setUIntOnString(contacts, argi.substr(9));
+    else if(strBegins(argi, "hdgs="))
+      setUIntOnString(hdg_pts, argi.substr(5));
+    else if(strBegins(argi, "spds="))
+      setUIntOnString(spd_pts, argi.substr(5));
+    else if(strBegins(argi, "iters="))
+      setUIntOnString(iters, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "hdglow="))
+      hdg_low = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "maxspd="))
+      max_spd = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "ostol="))
+      ostol = atof(argi.substr(6).c_str());
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testCPAGrid: test CPAEngine::evalCPAGrid() against the   " << endl;
+      cout << "per-call evalCPA(), evalTimeCPA(), crossesBow() and      " << endl;
+      cout << "crossesStern() over a heading x speed grid, for random   " << endl;
+      cout << "contacts.                                                " << endl;
+      cout << "Example:                                                 " << endl;
+      cout << "$ testCPAGrid contacts=20 hdgs=360 spds=21 maxspd=5       " << endl;
+      cout << "match=true                                               " << endl;
+      cout << "With the bench arg, the time of the grid call is shown   " << endl;
+      cout << "along with the per-call CPAEngine, CPAEngineThin, and    " << endl;
+      cout << "CPAEngineRoot (virtual dispatch) paths.                  " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!contacts_set) return(cmdLineErr("contacts is not set. Exiting."));
+  if((hdg_pts == 0) || (spd_pts < 2))
+    return(cmdLineErr("hdgs must be > 0 and spds > 1. Exiting."));
+  
+  srand(seed);
+
+  vector<double> hdgs, spds;
+  double hdg_delta = 360.0 / (double)(hdg_pts);
+  for(unsigned int i=0; i<hdg_pts; i++)
+    hdgs.push_back(hdg_low + (i * hdg_delta));
+  double spd_delta = max_spd / (double)(spd_pts-1);
+  for(unsigned int j=0; j<spd_pts; j++)
+    spds.push_back(j * spd_delta);
+
+  // Random contacts. Every fourth contact is placed on the ownship
+  // bow-stern line of the contact, to cover the special case.
+  vector<CPAEngine>     engines;
+  vector<CPAEngineThin> thins;
+  for(unsigned int c=0; c<contacts; c++) {
+    double osx = randVal(-500, 500);
+    double osy = randVal(-500, 500);
+    double cnx = randVal(-500, 500);
+    double cny = randVal(-500, 500);
+    double cnh = randVal(0, 360);
+    double cnv = randVal(0, 5);
+    if((c % 4) == 3) {
+      cnx = osx;
+      cnh = 0;
+    }
+    engines.push_back(CPAEngine(cny, cnx, cnh, cnv, osy, osx));
+    thins.push_back(CPAEngineThin(cny, cnx, cnh, cnv, osy, osx));
+  }
+  
+  // Part 1: Per-call CPAEngine
+  bool match = true;
+  vector<double> cpa, tcpa;
+  vector<bool>   xbow, xstern;
+  for(unsigned int c=0; c<engines.size(); c++) {
+    engines[c].evalCPAGrid(hdgs, spds, ostol, cpa, tcpa, xbow, xstern);
+    vector<double> cpa_only;
+    engines[c].evalCPAGrid(hdgs, spds, ostol, cpa_only);
+    if(cpa_only != cpa)
+      match = false;
+    for(unsigned int i=0; i<hdg_pts; i++) {
+      double osh = angle360(hdgs[i]);
+      for(unsigned int j=0; j<spd_pts; j++) {
+	double osv = spds[j];
+	unsigned int ix = (i * spd_pts) + j;
+	if((cpa[ix] != engines[c].evalCPA(osh, osv, ostol)) ||
+	   (tcpa[ix] != engines[c].evalTimeCPA(osh, osv, ostol)) ||
+	   (xbow[ix] != engines[c].crossesBow(osh, osv)) ||
+	   (xstern[ix] != engines[c].crossesStern(osh, osv)))
+	  match = false;
+      }
+    }
+  }
+
+  cout << "match=" << boolToString(match);
+  if(!bench) {
+    cout << endl;
+    return(0);
+  }
+  
+  // Part 2: Timings. Each is summed into total so the compiler
+  // cannot discard the work.
+  double total = 0;
+  clock_t start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    for(unsigned int c=0; c<engines.size(); c++) {
+      for(unsigned int i=0; i<hdg_pts; i++) {
+	for(unsigned int j=0; j<spd_pts; j++)
+	  total += engines[c].evalCPA(hdgs[i], spds[j], ostol);
+      }
+    }
+  }
+  double percall_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    for(unsigned int c=0; c<engines.size(); c++) {
+      for(unsigned int i=0; i<hdg_pts; i++) {
+	double osh = angle360(hdgs[i]);
+	for(unsigned int j=0; j<spd_pts; j++) {
+	  total += engines[c].evalCPA(osh, spds[j], ostol);
+	  total += engines[c].evalTimeCPA(osh, spds[j], ostol);
+	  total += engines[c].crossesBow(osh, spds[j]);
+	  total += engines[c].crossesStern(osh, spds[j]);
+	}
+      }
+    }
+  }
+  double percall_full_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    for(unsigned int c=0; c<thins.size(); c++) {
+      for(unsigned int i=0; i<hdg_pts; i++) {
+	for(unsigned int j=0; j<spd_pts; j++)
+	  total += thins[c].evalCPA(hdgs[i], spds[j], ostol);
+      }
+    }
+  }
+  double thin_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    for(unsigned int c=0; c<engines.size(); c++) {
+      const CPAEngineRoot *root = &engines[c];
+      for(unsigned int i=0; i<hdg_pts; i++) {
+	for(unsigned int j=0; j<spd_pts; j++)
+	  total += root->evalCPA(hdgs[i], spds[j], ostol);
+      }
+    }
+  }
+  double root_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    for(unsigned int c=0; c<engines.size(); c++) {
+      engines[c].evalCPAGrid(hdgs, spds, ostol, cpa);
+      total += cpa[0];
+    }
+  }
+  double grid_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    for(unsigned int c=0; c<engines.size(); c++) {
+      engines[c].evalCPAGrid(hdgs, spds, ostol, cpa, tcpa, xbow, xstern);
+      total += tcpa[0];
+    }
+  }
+  double grid_full_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  cout << ",percall_secs=" << doubleToStringX(percall_secs, 6);
+  cout << ",percall_full_secs=" << doubleToStringX(percall_full_secs, 6);
+  cout << ",thin_secs=" << doubleToStringX(thin_secs, 6);
+  cout << ",root_secs=" << doubleToStringX(root_secs, 6);
+  cout << ",grid_secs=" << doubleToStringX(grid_secs, 6);
+  cout << ",grid_full_secs=" << doubleToStringX(grid_full_secs, 6);
+  cout << ",sum=" << doubleToStringX(total, 2) << endl;
+  return(0);
+}
@@ -0,0 +1,128 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testCPAMonitor)                            */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "CPAMonitor.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//---------------------------------------------------------
+// Procedure: nodeReport()
+
+string nodeReport(string vname, double x, double y, double utc)
+{
+  string rpt = "NAME=" + vname + ",TYPE=kayak,SPD=1,HDG=0";
+  rpt += ",X=" + doubleToStringX(x, 3) + ",Y=" + doubleToStringX(y, 3);
+  rpt += ",TIME=" + doubleToStringX(utc, 2);
+  return(rpt);
+}
+
+int main(int argc, char** argv) 
+{
+  string path;
+  double step = 1;
+  double ignore_range = 100;
+  double report_range = 50;
+  double swing_range  = 1;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "path="))
+      path = argi.substr(5);
+    else if(strBegins(argi, "step="))
+      step = atof(argi.substr(5).c_str());
+    else if(strBegins(argi, "ignore="))
+      ignore_range = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "report="))
+      report_range = atof(argi.substr(7).c_str());
+    else if(strBegins(argi, "swing="))
+      swing_range = atof(argi.substr(6).c_str());
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testCPAMonitor: a contact moves along the given path, at " << endl;
+      cout << "the given step per round, past ownship fixed at 0,0. The  " << endl;
+      cout << "number of CPA events and each CPA distance are reported.  " << endl;
+      cout << "A pair first noted within the ignore range, or on entering" << endl;
+      cout << "it, is taken as opening, so its first approach counts.    " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testCPAMonitor path=50,5:70,5:-90,5                     " << endl;
+      cout << "events=1,cpas=5                                           " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(path == "")
+    return(cmdLineErr("path is not set. Exiting."));
+  if(step <= 0)
+    return(cmdLineErr("step must be positive. Exiting."));
+
+  vector<double> vx, vy;
+  vector<string> pts = parseString(path, ':');
+  for(unsigned int i=0; i<pts.size(); i++) {
+    string ystr = pts[i];
+    string xstr = biteStringX(ystr, ',');
+    if(!isNumber(xstr) || !isNumber(ystr))
+      return(cmdLineErr("bad path point [" + pts[i] + "]. Exiting."));
+    vx.push_back(atof(xstr.c_str()));
+    vy.push_back(atof(ystr.c_str()));
+  }
+  
+  CPAMonitor monitor;
+  monitor.setIgnoreRange(ignore_range);
+  monitor.setReportRange(report_range);
+  monitor.setSwingRange(swing_range);
+
+  // One round per step along each leg of the path, with both vehicles
+  // reporting each round as uFldCollisionDetect would receive them.
+  vector<double> cpas;
+  double utc = 1000;
+  for(unsigned int i=0; i<vx.size(); i++) {
+    unsigned int steps = 1;
+    if(i > 0) {
+      double leg = hypot(vx[i]-vx[i-1], vy[i]-vy[i-1]);
+      steps = (unsigned int)(ceil(leg / step));
+      if(steps == 0)
+	steps = 1;
+    }
+    for(unsigned int j=1; j<=steps; j++) {
+      double cx = vx[i];
+      double cy = vy[i];
+      if(i > 0) {
+	double pct = (double)(j) / (double)(steps);
+	cx = vx[i-1] + pct * (vx[i] - vx[i-1]);
+	cy = vy[i-1] + pct * (vy[i] - vy[i-1]);
+      }
+      utc += 1;
+      monitor.handleNodeReport(nodeReport("ownship", 0, 0, utc));
+      monitor.handleNodeReport(nodeReport("contact", cx, cy, utc));
+      monitor.examineAndReport();
+      for(unsigned int k=0; k<monitor.getEventCount(); k++)
+	cpas.push_back(monitor.getEvent(k).getCPA());
+      monitor.clear();
+    }
+  }
+
+  cout << "events=" << cpas.size();
+  for(unsigned int i=0; i<cpas.size(); i++) {
+    if(i == 0)
+      cout << ",cpas=";
+    else
+      cout << ":";
+    cout << doubleToStringX(cpas[i], 1);
+  }
+  cout << endl;
+  return(0);
+}
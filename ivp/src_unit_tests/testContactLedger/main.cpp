@@ -0,0 +1,224 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testContactLedger)                         */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include "MBUtils.h"
+#include "ContactLedger.h"
+#include "LinearExtrapolator.h"
+#include "CPAEngine.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+double randVal(double low, double high)
+{
+  double pct = (double)(rand() % 100000) / 100000.0;
+  return(low + (pct * (high - low)));
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int contacts = 0;  bool contacts_set=false;
+  unsigned int iters = 1;
+  unsigned int seed = 1;
+  double decay_start = 15;
+  double decay_end   = 30;
+  bool   bench = false;
+  bool   casenames = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "contacts="))
+      contacts_set = setUIntOnString(contacts, argi.substr(9));
+    else if(strBegins(argi, "iters="))
+      setUIntOnString(iters, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "decay=")) {
+      string right = argi.substr(6);
+      string left  = biteStringX(right, ',');
+      decay_start = atof(left.c_str());
+      decay_end   = atof(right.c_str());
+    }
+    else if(argi == "bench")
+      bench = true;
+    else if(strBegins(argi, "casenames="))
+      setBooleanOnString(casenames, argi.substr(10));
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testContactLedger: test the ContactLedger columnar extrap  " << endl;
+      cout << "and ranges against LinearExtrapolator and CPAEngine on    " << endl;
+      cout << "random contacts, as used by pContactMgrV20.               " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testContactLedger contacts=500 decay=15,30               " << endl;
+      cout << "match=true                                                " << endl;
+      cout << "With the bench arg, the time of each approach is shown.   " << endl;
+      cout << "With casenames=true, contacts come in pairs named alike   " << endl;
+      cout << "but for case (v1/V1), and the lower case ones are retired " << endl;
+      cout << "one at a time, checking the other of each pair is intact. " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!contacts_set) return(cmdLineErr("contacts is not set. Exiting."));
+  
+  srand(seed);
+
+  double osx = randVal(-500, 500);
+  double osy = randVal(-500, 500);
+  double osh = randVal(0, 360);
+  double osv = randVal(0, 5);
+  double curr_time = 1000;
+  double cpa_time  = 36000;
+
+  // Random contacts, some on the axes headings and some with report
+  // times at or after the current time, to cover the special cases.
+  ContactLedger ledger;
+  ledger.setDecay(decay_start, decay_end);
+  vector<NodeRecord> records;
+  for(unsigned int i=0; i<contacts; i++) {
+    string vname = "V" + uintToString(i);
+    if(casenames)
+      vname = ((i % 2) ? "v" : "V") + uintToString(i / 2);
+    NodeRecord record(vname);
+    record.setX(randVal(-5000, 5000));
+    record.setY(randVal(-5000, 5000));
+    record.setSpeed(randVal(0, 10));
+    record.setTimeStamp(curr_time - randVal(0, 60));
+    if((i % 5) == 0)
+      record.setHeading(90 * (rand() % 4));
+    else
+      record.setHeading(randVal(-180, 540));
+    if((i % 11) == 0)
+      record.setTimeStamp(curr_time);
+    if((i % 13) == 0)
+      record.setTimeStamp(curr_time + 1);
+    records.push_back(record);
+    ledger.processRecord(record);
+  }
+
+  // Remove and re-add some contacts to exercise row reuse
+  for(unsigned int i=0; i<contacts; i+=7)
+    ledger.removeVName(records[i].getName());
+  for(unsigned int i=0; i<contacts; i+=14)
+    ledger.processRecord(records[i]);
+
+  // Part 1: Per contact extrapolation and ranges, as done before
+  clock_t scalar_start = clock();
+  vector<double> s_range, s_range_ext, s_range_cpa;
+  for(unsigned int k=0; k<iters; k++) {
+    s_range.clear();
+    s_range_ext.clear();
+    s_range_cpa.clear();
+    for(unsigned int i=0; i<records.size(); i++) {
+      if(!ledger.hasVName(records[i].getName()))
+	continue;
+      double cnx = records[i].getX();
+      double cny = records[i].getY();
+      double cnh = records[i].getHeading();
+      double cns = records[i].getSpeed();
+      double cnt = records[i].getTimeStamp();
+      double range_actual = hypot((osx - cnx), (osy - cny));
+      
+      LinearExtrapolator linex;
+      linex.setDecay(decay_start, decay_end);
+      linex.setPosition(cnx, cny, cns, cnh, cnt);
+      double ex = cnx;
+      double ey = cny;
+      double range_extrap = range_actual;
+      if(linex.getPosition(ex, ey, curr_time)) {
+	cnx = ex;
+	cny = ey;
+	range_extrap = hypot((osx - cnx), (osy - cny));
+      }
+      CPAEngine engine(cny, cnx, cnh, cns, osy, osx);
+      s_range.push_back(range_actual);
+      s_range_ext.push_back(range_extrap);
+      s_range_cpa.push_back(engine.evalCPA(osh, osv, cpa_time));
+    }
+  }
+  double scalar_secs = (double)(clock() - scalar_start) / CLOCKS_PER_SEC;
+
+  // Part 2: Columnar extrapolation and ranges
+  clock_t ledger_start = clock();
+  for(unsigned int k=0; k<iters; k++) {
+    ledger.setCurrTimeUTC(curr_time);
+    ledger.extrapolateAll();
+    ledger.updateRanges(osx, osy, osh, osv, cpa_time);
+  }
+  double ledger_secs = (double)(clock() - ledger_start) / CLOCKS_PER_SEC;
+
+  bool match = true;
+  unsigned int j = 0;
+  for(unsigned int i=0; i<records.size(); i++) {
+    string vname = records[i].getName();
+    if(!ledger.hasVName(vname))
+      continue;
+    if((ledger.getRange(vname) != s_range[j]) ||
+       (ledger.getRangeExt(vname) != s_range_ext[j]) ||
+       (ledger.getRangeCPA(vname) != s_range_cpa[j]))
+      match = false;
+    j++;
+  }
+  if(j != ledger.size())
+    match = false;
+
+  // Part 3: Range ordering
+  vector<unsigned int> ids = ledger.getRangeOrderedIDs();
+  if(ids.size() != ledger.size())
+    match = false;
+  for(unsigned int i=1; i<ids.size(); i++) {
+    if(ledger.getRangeByID(ids[i-1]) > ledger.getRangeByID(ids[i]))
+      match = false;
+  }
+  
+  // Part 4: Names differing only in case are distinct contacts, and
+  // retiring one leaves the other as it was
+  if(casenames) {
+    for(unsigned int i=0; i<records.size(); i++) {
+      string vname = records[i].getName();
+      if((vname == toupper(vname)) || !ledger.hasVName(vname))
+	continue;
+      string twin = toupper(vname);
+      bool   twin_known = ledger.hasVName(twin);
+      double twin_range = ledger.getRange(twin);
+      double twin_range_cpa = ledger.getRangeCPA(twin);
+
+      ledger.removeVName(vname);
+      ledger.updateRanges(osx, osy, osh, osv, cpa_time);
+      if(ledger.hasVName(vname) || (ledger.hasVName(twin) != twin_known))
+	match = false;
+      if(twin_known && ((ledger.getRange(twin) != twin_range) ||
+			(ledger.getRangeCPA(twin) != twin_range_cpa)))
+	match = false;
+    }
+    ids = ledger.getRangeOrderedIDs();
+    if(ids.size() != ledger.size())
+      match = false;
+    for(unsigned int i=0; i<ids.size(); i++) {
+      string vname = ledger.getVNameByID(ids[i]);
+      if((vname != toupper(vname)) || (ledger.getRange(vname) == 0))
+	match = false;
+    }
+  }
+  
+  cout << "match=" << boolToString(match);
+  if(bench) {
+    cout << ",scalar_secs=" << doubleToStringX(scalar_secs, 6);
+    cout << ",ledger_secs=" << doubleToStringX(ledger_secs, 6);
+  }
+  cout << endl;
+  return(0);
+}
@@ -0,0 +1,181 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testConvexGrid)                            */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include "MBUtils.h"
+#include "XYConvexGrid.h"
+#include "XYFormatUtilsPoly.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//-----------------------------------------------------------
+// Procedure: bruteCells()
+//   Purpose: Build the grid cells the original way, with a full
+//            polygon intersection test for every bounding cell.
+
+vector<XYSquare> bruteCells(const XYPolygon& poly, double cell)
+{
+  double xlow  = poly.get_min_x();
+  double xhigh = poly.get_max_x();
+  double ylow  = poly.get_min_y();
+  double yhigh = poly.get_max_y();
+
+  double xlen = xhigh - xlow;
+  double ylen = yhigh - ylow;
+  double x_whole = floor(xlen / cell);
+  double y_whole = floor(ylen / cell);
+  int x_count = (int)(x_whole) + (((xlen - (x_whole * cell)) > 0) ? 1 : 0);
+  int y_count = (int)(y_whole) + (((ylen - (y_whole * cell)) > 0) ? 1 : 0);
+
+  vector<XYSquare> cells;
+  for(int i=0; i<x_count; i++) {
+    for(int j=0; j<y_count; j++) {
+      double cxl = (i * cell) + xlow;
+      double cyl = (j * cell) + ylow;
+      XYPolygon spoly;
+      spoly.add_vertex(cxl, cyl);
+      spoly.add_vertex(cxl+cell, cyl);
+      spoly.add_vertex(cxl+cell, cyl+cell);
+      spoly.add_vertex(cxl, cyl+cell);
+      if(spoly.intersects(poly))
+	cells.push_back(XYSquare(cxl, cxl+cell, cyl, cyl+cell));
+    }
+  }
+  return(cells);
+}
+
+double randVal(double low, double high)
+{
+  return(low + ((double)(rand() % 100000) / 100000.0) * (high - low));
+}
+
+int main(int argc, char** argv) 
+{
+  string poly_str;
+  double cell = 10;
+  unsigned int points = 5000;
+  unsigned int segs = 500;
+  unsigned int seed = 1;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "poly="))
+      poly_str = argi.substr(5);
+    else if(strBegins(argi, "cell="))
+      setPosDoubleOnString(cell, argi.substr(5));
+    else if(strBegins(argi, "points="))
+      setUIntOnString(points, argi.substr(7));
+    else if(strBegins(argi, "segs="))
+      setUIntOnString(segs, argi.substr(5));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testConvexGrid: check XYConvexGrid construction, indexed   " << endl;
+      cout << "point lookup, and segment cell walk against brute force.   " << endl;
+      cout << "Example:                                                   " << endl;
+      cout << "$ testConvexGrid poly=pts={0,0:100,0:100,100:0,100} cell=10 " << endl;
+      cout << "match=true                                                 " << endl;
+      cout << "With the bench arg, the time of each approach is shown.    " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+
+  XYPolygon poly = string2Poly(poly_str);
+  if(poly.size() == 0)
+    return(cmdLineErr("poly is not set or invalid. Exiting."));
+
+  srand(seed);
+
+  // Part 1: Same cells, in the same order, as brute construction
+  clock_t brute_start = clock();
+  vector<XYSquare> brute_cells = bruteCells(poly, cell);
+  double brute_secs = (double)(clock() - brute_start) / CLOCKS_PER_SEC;
+
+  clock_t grid_start = clock();
+  XYConvexGrid grid;
+  grid.initialize(poly, cell, 0);
+  double grid_secs = (double)(clock() - grid_start) / CLOCKS_PER_SEC;
+
+  bool match = (grid.size() == brute_cells.size());
+  for(unsigned int i=0; match && (i<grid.size()); i++) {
+    if(grid.getElement(i).get_spec() != brute_cells[i].get_spec())
+      match = false;
+  }
+
+  // Part 2: Indexed point lookup agrees with a scan of all cells.
+  // Every 4th point is snapped to a lattice line, and every 8th to a
+  // lattice corner, where several cells contain the point.
+  double xlow  = poly.get_min_x() - (2 * cell);
+  double xhigh = poly.get_max_x() + (2 * cell);
+  double ylow  = poly.get_min_y() - (2 * cell);
+  double yhigh = poly.get_max_y() + (2 * cell);
+  for(unsigned int k=0; match && (k<points); k++) {
+    double x = randVal(xlow, xhigh);
+    double y = randVal(ylow, yhigh);
+    if((k % 4) == 0)
+      x = poly.get_min_x() + (round((x - poly.get_min_x()) / cell) * cell);
+    if((k % 8) == 0)
+      y = poly.get_min_y() + (round((y - poly.get_min_y()) / cell) * cell);
+
+    vector<unsigned int> scan_cells;
+    for(unsigned int i=0; i<grid.size(); i++)
+      if(grid.ptIntersect(i, x, y))
+	scan_cells.push_back(i);
+
+    int ix = grid.getCellIX(x, y);
+    if((ix >= 0) != (scan_cells.size() > 0))
+      match = false;
+    if((ix >= 0) && !grid.ptIntersect((unsigned int)(ix), x, y))
+      match = false;
+    if(grid.getCellsIX(x, y) != scan_cells)
+      match = false;
+  }
+
+  // Part 3: Segment walk finds every cell the segment passes through
+  // and no cell it misses.
+  for(unsigned int k=0; match && (k<segs); k++) {
+    double x1 = randVal(xlow, xhigh);
+    double y1 = randVal(ylow, yhigh);
+    double x2 = x1 + randVal(-10*cell, 10*cell);
+    double y2 = y1 + randVal(-10*cell, 10*cell);
+
+    vector<unsigned int> walk = grid.getCellsOnSegment(x1, y1, x2, y2);
+    vector<bool> walked(grid.size(), false);
+    for(unsigned int i=0; i<walk.size(); i++)
+      walked[walk[i]] = true;
+
+    for(unsigned int i=0; i<grid.size(); i++) {
+      double len = grid.segIntersect(i, x1, y1, x2, y2);
+      if((len > 1e-6) && !walked[i])
+	match = false;
+      if(walked[i] && (len <= 0))
+	match = false;
+    }
+  }
+
+  cout << "match=" << boolToString(match);
+  if(bench) {
+    cout << ",brute_secs=" << doubleToStringX(brute_secs, 6);
+    cout << ",grid_secs=" << doubleToStringX(grid_secs, 6);
+    cout << ",cells=" << grid.size();
+  }
+  cout << endl;
+  return(0);
+}
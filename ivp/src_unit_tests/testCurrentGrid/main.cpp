@@ -0,0 +1,282 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testCurrentGrid)                           */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <unistd.h>
+#include "MBUtils.h"
+#include "CurrentGrid.h"
+#include "CurrentField.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//-----------------------------------------------------------
+// Procedure: randVal()
+
+double randVal(double low, double high)
+{
+  return(low + ((high - low) * (double)(rand()) / RAND_MAX));
+}
+
+//-----------------------------------------------------------
+// Procedure: linearGrid()
+//   Purpose: A grid whose frame values are a linear function of
+//            position, u = a + b*x + c*y, v = a - c*x + b*y
+
+CurrentGrid linearGrid(double a, double b, double c)
+{
+  CurrentGrid grid;
+  grid.initialize(-100, -50, 10, 5, 21, 21);
+  vector<float> u(21*21), v(21*21);
+  for(unsigned int iy=0; iy<21; iy++) {
+    for(unsigned int ix=0; ix<21; ix++) {
+      double x = -100.0 + (ix * 10);
+      double y = -50.0 + (iy * 5);
+      u[ix + (iy*21)] = a + (b*x) + (c*y);
+      v[ix + (iy*21)] = a - (c*x) + (b*y);
+    }
+  }
+  grid.addFrame(0, u, v);
+  return(grid);
+}
+
+//-----------------------------------------------------------
+// Procedure: testBilinear()
+//   Purpose: Bilinear interpolation reproduces a linear field, and
+//            is zero outside the grid
+
+bool testBilinear()
+{
+  double a = 0.3;
+  double b = 0.004;
+  double c = -0.002;
+  CurrentGrid grid = linearGrid(a, b, c);
+  for(unsigned int i=0; i<2000; i++) {
+    double x = randVal(-100, 100);
+    double y = randVal(-50, 50);
+    double fx, fy;
+    grid.getLocalForce(x, y, fx, fy);
+    if(fabs(fx - (a + (b*x) + (c*y))) > 1e-5)
+      return(false);
+    if(fabs(fy - (a - (c*x) + (b*y))) > 1e-5)
+      return(false);
+  }
+  double fx, fy;
+  grid.getLocalForce(100.5, 0, fx, fy);
+  if((fx != 0) || (fy != 0) || grid.contains(100.5, 0))
+    return(false);
+  grid.getLocalForce(100, 50, fx, fy);
+  return(fabs(fx - (a + (b*100) + (c*50))) < 1e-5);
+}
+
+//-----------------------------------------------------------
+// Procedure: testTime()
+//   Purpose: Linear interpolation between frames, clamped at ends
+
+bool testTime()
+{
+  CurrentGrid grid;
+  grid.initialize(0, 0, 1, 1, 2, 2);
+  grid.addFrame(0, vector<float>(4, 1), vector<float>(4, -1));
+  grid.addFrame(10, vector<float>(4, 3), vector<float>(4, 1));
+  if(grid.addFrame(10, vector<float>(4, 0), vector<float>(4, 0)))
+    return(false);
+
+  double fx, fy;
+  grid.getLocalForce(0.5, 0.5, 2.5, fx, fy);
+  if((fabs(fx - 1.5) > 1e-12) || (fabs(fy + 0.5) > 1e-12))
+    return(false);
+  grid.getLocalForce(0.5, 0.5, -5, fx, fy);
+  if((fx != 1) || (fy != -1))
+    return(false);
+  grid.getLocalForce(0.5, 0.5, 50, fx, fy);
+  return((fx == 3) && (fy == 1));
+}
+
+//-----------------------------------------------------------
+// Procedure: testNaN()
+//   Purpose: Missing nodes are left out and the rest re-weighted
+
+bool testNaN()
+{
+  float nan = NAN;
+  CurrentGrid grid;
+  grid.initialize(0, 0, 1, 1, 3, 2);
+  vector<float> u(6, 2), v(6, 1);
+  u[0] = nan;
+  u[1] = nan;
+  v[3] = nan;
+  u[4] = nan;
+  grid.addFrame(0, u, v);
+
+  // Cell 0 has no valid node, cell 1 has valid nodes only at
+  // (2,0) and (2,1)
+  double fx, fy;
+  grid.getLocalForce(0.3, 0.6, fx, fy);
+  if((fx != 0) || (fy != 0))
+    return(false);
+  grid.getLocalForce(1.5, 0.5, fx, fy);
+  if((fabs(fx - 2) > 1e-12) || (fabs(fy - 1) > 1e-12))
+    return(false);
+
+  // A fully missing cell gives no current
+  u[2] = u[5] = nan;
+  CurrentGrid grid2;
+  grid2.initialize(0, 0, 1, 1, 3, 2);
+  grid2.addFrame(0, u, v);
+  grid2.getLocalForce(1.5, 0.5, fx, fy);
+  return((fx == 0) && (fy == 0));
+}
+
+//-----------------------------------------------------------
+// Procedure: testFile()
+//   Purpose: Binary round trip, and rejection of a truncated file
+
+bool testFile()
+{
+  CurrentGrid grid = linearGrid(0.1, 0.002, 0.003);
+  vector<float> u(21*21), v(21*21);
+  for(unsigned int i=0; i<u.size(); i++) {
+    u[i] = randVal(-1, 1);
+    v[i] = randVal(-1, 1);
+  }
+  grid.addFrame(60, u, v);
+
+  string fname = "testCurrentGrid.cgrid";
+  if(!grid.writeBinary(fname))
+    return(false);
+
+  CurrentGrid copy;
+  bool ok = copy.readBinary(fname);
+  ok = ok && (copy.frames() == 2) && (copy.getFrameTime(1) == 60);
+  for(unsigned int i=0; ok && (i<2000); i++) {
+    double x = randVal(-110, 110);
+    double y = randVal(-60, 60);
+    double t = randVal(-10, 70);
+    double fx1, fy1, fx2, fy2;
+    grid.getLocalForce(x, y, t, fx1, fy1);
+    copy.getLocalForce(x, y, t, fx2, fy2);
+    if((fx1 != fx2) || (fy1 != fy2))
+      ok = false;
+  }
+
+  // A copy taking a new frame must not disturb the mapped original
+  CurrentGrid copy2 = copy;
+  copy2.addFrame(120, u, v);
+  ok = ok && (copy.frames() == 2) && (copy2.frames() == 3);
+
+  FILE *f = fopen(fname.c_str(), "r+b");
+  if(f) {
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fclose(f);
+    if(truncate(fname.c_str(), len - 4) != 0)
+      ok = false;
+    CurrentGrid cut;
+    ok = ok && !cut.readBinary(fname);
+  }
+  remove(fname.c_str());
+  return(ok);
+}
+
+//-----------------------------------------------------------
+// Procedure: testField()
+//   Purpose: The indexed CurrentField lookup must match the full
+//            search exactly. Some vectors sit on cell boundaries,
+//            some share a position, and queries reach past the
+//            field so edge cells are clipped.
+
+bool testField()
+{
+  CurrentField field;
+  field.setRadius(20);
+  for(unsigned int i=0; i<1500; i++) {
+    double x = randVal(-200, 200);
+    double y = randVal(-100, 100);
+    if((i % 10) == 0) {
+      x = -200 + (20 * (rand() % 21));
+      y = -100 + (20 * (rand() % 11));
+    }
+    XYVector vector(x, y, randVal(0, 2), randVal(0, 360));
+    field.addVector(vector);
+    if((i % 50) == 0)
+      field.addVector(vector);
+  }
+  field.buildIndex();
+
+  // Any change to the field drops its index
+  CurrentField linear = field;
+  linear.setRadius(field.getRadius());
+  if(!field.indexed() || linear.indexed())
+    return(false);
+
+  for(unsigned int i=0; i<5000; i++) {
+    double x = randVal(-240, 240);
+    double y = randVal(-140, 140);
+    if((i % 10) == 0) {
+      x = -200 + (20 * (rand() % 21));
+      y = -100 + (20 * (rand() % 11));
+    }
+    double fx1, fy1, fx2, fy2;
+    field.getLocalForce(x, y, fx1, fy1);
+    linear.getLocalForce(x, y, fx2, fy2);
+    if((fx1 != fx2) || (fy1 != fy2))
+      return(false);
+  }
+  return(true);
+}
+
+int main(int argc, char** argv) 
+{
+  string mode;
+  unsigned int seed = 1;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "mode="))
+      mode = argi.substr(5);
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testCurrentGrid: check the CurrentGrid interpolation and   " << endl;
+      cout << "the binary file round trip, and the indexed CurrentField.  " << endl;
+      cout << "Modes: bilinear, time, nan, file, field                    " << endl;
+      cout << "Example:                                                   " << endl;
+      cout << "$ testCurrentGrid mode=bilinear seed=1                     " << endl;
+      cout << "match=true                                                 " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+
+  srand(seed);
+
+  bool match = false;
+  if(mode == "bilinear")
+    match = testBilinear();
+  else if(mode == "time")
+    match = testTime();
+  else if(mode == "nan")
+    match = testNaN();
+  else if(mode == "file")
+    match = testFile();
+  else if(mode == "field")
+    match = testField();
+  else
+    return(cmdLineErr("mode is not set or unknown. Exiting."));
+
+  cout << "match=" << boolToString(match) << endl;
+  return(0);
+}
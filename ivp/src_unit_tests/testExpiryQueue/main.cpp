@@ -0,0 +1,150 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testExpiryQueue)                           */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <map>
+#include <set>
+#include "MBUtils.h"
+#include "ExpiryQueue.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+int main(int argc, char** argv) 
+{
+  unsigned int keys = 0;  bool keys_set=false;
+  unsigned int steps = 100;
+  unsigned int seed = 1;
+  unsigned int cancel_pct = 2;
+  unsigned int update_pct = 5;
+  double max_age = 60;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "keys="))
+      keys_set = setUIntOnString(keys, argi.substr(5));
+    else if(strBegins(argi, "steps="))
+      setUIntOnString(steps, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "cancel_pct="))
+      setUIntOnString(cancel_pct, argi.substr(11));
+    else if(strBegins(argi, "update_pct="))
+      setUIntOnString(update_pct, argi.substr(11));
+    else if(strBegins(argi, "max_age="))
+      max_age = atof(argi.substr(8).c_str());
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testExpiryQueue: test ExpiryQueue against a scan of all   " << endl;
+      cout << "keys for expired deadlines, as pContactMgrV20 did. Each   " << endl;
+      cout << "step, update_pct of the keys get a new report time, and   " << endl;
+      cout << "cancel_pct are cancelled.                                 " << endl;
+      cout << "Example:                                                 " << endl;
+      cout << "$ testExpiryQueue keys=200 steps=2000 max_age=30          " << endl;
+      cout << "match=true                                               " << endl;
+      cout << "With the bench arg, the time of each approach is shown.  " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!keys_set) return(cmdLineErr("keys is not set. Exiting."));
+  
+  srand(seed);
+
+  // Each step is one second. Keys are reported at random times, and
+  // expire when the time since the last report exceeds max_age.
+  ExpiryQueue queue;
+  map<string, double> reports;
+  bool match = true;
+  double scan_secs = 0;
+  double queue_secs = 0;
+  
+  for(unsigned int k=0; k<keys; k++) {
+    string key = "V" + uintToString(k);
+    reports[key] = 0;
+    queue.schedule(key, max_age);
+  }
+  
+  for(unsigned int step=1; step<=steps; step++) {
+    double curr_time = (double)(step);
+
+    // Part 1: New reports and cancellations for a random subset
+    vector<string> updated, cancelled;
+    for(unsigned int k=0; k<keys; k++) {
+      string key = "V" + uintToString(k);
+      unsigned int roll = rand() % 100;
+      if(roll < update_pct) {
+	reports[key] = curr_time;
+	updated.push_back(key);
+      }
+      else if(roll < (update_pct + cancel_pct))
+	cancelled.push_back(key);
+    }
+
+    clock_t start = clock();
+    for(unsigned int i=0; i<updated.size(); i++)
+      queue.schedule(updated[i], curr_time + max_age);
+    vector<bool> cancel_results;
+    for(unsigned int i=0; i<cancelled.size(); i++)
+      cancel_results.push_back(queue.cancel(cancelled[i]));
+    queue_secs += (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    for(unsigned int i=0; i<cancelled.size(); i++) {
+      bool had_key = (reports.erase(cancelled[i]) != 0);
+      if(cancel_results[i] != had_key)
+	match = false;
+    }
+
+    // Part 2: Find expired keys by scanning all reports
+    start = clock();
+    set<string> scan_expired;
+    map<string, double>::iterator p;
+    for(p=reports.begin(); p!=reports.end(); p++) {
+      double age = curr_time - p->second;
+      if(age > max_age)
+	scan_expired.insert(p->first);
+    }
+    scan_secs += (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Part 3: Find expired keys from the queue
+    start = clock();
+    vector<string> expired = queue.popExpired(curr_time);
+    queue_secs += (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    set<string> queue_expired(expired.begin(), expired.end());
+    if((queue_expired != scan_expired) ||
+       (queue_expired.size() != expired.size()))
+      match = false;
+
+    for(unsigned int i=0; i<expired.size(); i++)
+      reports.erase(expired[i]);
+    if(queue.size() != reports.size())
+      match = false;
+  }
+
+  // Stale heap entries are bounded relative to the live keys
+  if(queue.heapSize() > (2 * queue.size()) + 64 + keys)
+    match = false;
+  
+  cout << "match=" << boolToString(match);
+  if(bench) {
+    cout << ",scan_secs=" << doubleToStringX(scan_secs, 6);
+    cout << ",queue_secs=" << doubleToStringX(queue_secs, 6);
+  }
+  cout << endl;
+  return(0);
+}
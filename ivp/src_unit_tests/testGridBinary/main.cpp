@@ -0,0 +1,160 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testGridBinary)                            */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include "MBUtils.h"
+#include "XYConvexGrid.h"
+#include "XYGridUpdate.h"
+#include "XYFormatUtilsConvexGrid.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//-----------------------------------------------------------
+// Procedure: randCellVal()
+//   Purpose: A random cell value: small whole numbers by default,
+//            fractional if real, or beyond 16 bits if big.
+
+double randCellVal(bool real, bool big)
+{
+  double dval = (double)((rand() % 200) - 100);
+  if(real)
+    dval += (double)(rand() % 1000) / 997.0;
+  if(big)
+    dval *= 1000;
+  return(dval);
+}
+
+//-----------------------------------------------------------
+// Procedure: gridsMatch()
+//   Purpose: Compare all cell values of two grids, to within tol.
+
+bool gridsMatch(const XYConvexGrid& grid_a, const XYConvexGrid& grid_b,
+		double tol)
+{
+  if((grid_a.size() != grid_b.size()) ||
+     (grid_a.getCellVarCnt() != grid_b.getCellVarCnt()))
+    return(false);
+  if(grid_a.get_label() != grid_b.get_label())
+    return(false);
+  
+  for(unsigned int ix=0; ix<grid_a.size(); ix++) {
+    for(unsigned int cix=0; cix<grid_a.getCellVarCnt(); cix++) {
+      double diff = grid_a.getVal(ix, cix) - grid_b.getVal(ix, cix);
+      if(fabs(diff) > tol)
+	return(false);
+    }
+  }
+  return(true);
+}
+
+int main(int argc, char** argv) 
+{
+  string grid_str;
+  unsigned int cells = 100;
+  unsigned int seed = 1;
+  double quant = 0;
+  bool   real = false;
+  bool   big = false;
+  bool   verbose = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "grid="))
+      grid_str = argi.substr(5);
+    else if(strBegins(argi, "cells="))
+      setUIntOnString(cells, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "quant="))
+      setNonNegDoubleOnString(quant, argi.substr(6));
+    else if(argi == "real")
+      real = true;
+    else if(argi == "big")
+      big = true;
+    else if(argi == "verbose")
+      verbose = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testGridBinary: check that a convex grid and grid updates " << endl;
+      cout << "survive the round trip through the compact binary form.  " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testGridBinary grid=pts={0,0:100,0:100,100:0,100},      " << endl;
+      cout << "  cell_size=10,cell_vars=x:0 cells=20                     " << endl;
+      cout << "match=true                                                " << endl;
+      cout << "With the verbose arg, text and binary sizes are shown.    " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+
+  XYConvexGrid grid = string2ConvexGrid(grid_str);
+  if(grid.size() == 0)
+    return(cmdLineErr("grid is not set or invalid. Exiting."));
+  grid.set_label("psg");
+
+  srand(seed);
+
+  // Part 1: Set some random cells and build an update of the same
+  XYGridUpdate update("psg");
+  for(unsigned int k=0; k<cells; k++) {
+    unsigned int ix  = rand() % grid.size();
+    unsigned int cix = rand() % grid.getCellVarCnt();
+    double dval = randCellVal(real, big);
+    grid.setVal(ix, dval, cix);
+    update.addUpdate(ix, grid.getVar(cix), dval);
+  }
+
+  // Part 2: Snapshot round trip. With no quantization it must be
+  // exact, including the cell limits.
+  double tol = quant / 2;
+  string bin_grid = convexGrid2Binary(grid, quant);
+  XYConvexGrid bin_copy = string2ConvexGrid(bin_grid);
+  bool match = isBinaryConvexGrid(bin_grid) && gridsMatch(grid, bin_copy, tol);
+  if(quant == 0)
+    match = match && (grid.get_spec() == bin_copy.get_spec());
+
+  // Part 3: Update round trip. Apply the text update and the binary
+  // update to two copies of the grid and compare.
+  if(cells > 0) {
+    string txt_update = update.get_spec();
+    string bin_update = gridUpdate2Binary(update, quant);
+    XYConvexGrid grid_txt = grid;
+    XYConvexGrid grid_bin = grid;
+    match = match && isBinaryGridUpdate(bin_update);
+    match = match && grid_bin.processDelta(bin_update);
+    grid_txt.processDelta(txt_update);
+    if(quant == 0) {
+      // Text update carries only 4 decimal places
+      match = match && gridsMatch(grid_txt, grid_bin, 0.0001 * cells);
+    }
+    else
+      match = match && gridsMatch(grid_txt, grid_bin, cells * (tol+0.0001));
+
+    if(verbose) {
+      cout << "update_txt=" << txt_update.length();
+      cout << ",update_bin=" << bin_update.length() << endl;
+    }
+  }
+  // Part 4: A truncated buffer is rejected, not partially applied
+  string cut_grid = bin_grid.substr(0, bin_grid.length()-1);
+  if((cells > 0) && (string2ConvexGrid(cut_grid).size() != 0))
+    match = false;
+
+  if(verbose) {
+    cout << "grid_txt=" << grid.get_spec().length();
+    cout << ",grid_bin=" << bin_grid.length() << endl;
+  }
+  cout << "match=" << boolToString(match) << endl;
+  return(0);
+}
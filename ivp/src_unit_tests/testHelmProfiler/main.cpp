@@ -0,0 +1,206 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testHelmProfiler)                          */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include "MBUtils.h"
+#include "HelmProfiler.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//-----------------------------------------------------------
+// Procedure: slowPercentile()
+//   Purpose: Nearest-rank percentile by full sort of the last
+//            window samples, for checking HelmProfiler.
+
+double slowPercentile(vector<double> samples, unsigned int window,
+		      double pct)
+{
+  if(samples.size() > window)
+    samples.erase(samples.begin(), samples.end() - window);
+  if(samples.size() == 0)
+    return(0);
+  sort(samples.begin(), samples.end());
+  unsigned int n = samples.size();
+  unsigned int rank = (unsigned int)(ceil((pct / 100.0) * n));
+  if(rank > 0)
+    rank--;
+  if(rank >= n)
+    rank = n-1;
+  return(samples[rank]);
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int iters = 0;  bool iters_set=false;
+  unsigned int window = 100;
+  unsigned int bhvs = 3;
+  unsigned int seed = 1;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "iters="))
+      iters_set = setUIntOnString(iters, argi.substr(6));
+    else if(strBegins(argi, "window="))
+      setUIntOnString(window, argi.substr(7));
+    else if(strBegins(argi, "bhvs="))
+      setUIntOnString(bhvs, argi.substr(5));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testHelmProfiler: feed random stage and behavior times to " << endl;
+      cout << "a HelmProfiler and check its windowed percentiles against " << endl;
+      cout << "a full sort. Behavior 0 stops reporting half way through  " << endl;
+      cout << "and should be dropped once a full window has passed.      " << endl;
+      cout << "Example:                                                 " << endl;
+      cout << "$ testHelmProfiler iters=300 window=7 bhvs=20            " << endl;
+      cout << "match=true                                               " << endl;
+      cout << "With the bench arg, the time to build the spec is shown. " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!iters_set) return(cmdLineErr("iters is not set. Exiting."));
+  
+  srand(seed);
+
+  HelmProfiler profiler;
+  profiler.setEnabled(true);
+  profiler.setWindow(window);
+
+  map<string, vector<double> > stage_hist;
+  map<string, vector<double> > bhv_hist;
+  map<string, unsigned int>    bhv_last;
+  
+  vector<string> stages;
+  stages.push_back("create");
+  stages.push_back("solve");
+
+  for(unsigned int iter=1; iter<=iters; iter++) {
+    profiler.beginIteration(iter);
+    for(unsigned int s=0; s<stages.size(); s++) {
+      // The create stage runs twice some iterations (filter bhvs)
+      double t1 = (double)(rand() % 1000) / 100000.0;
+      profiler.addStageTime(stages[s], t1);
+      double total = t1;
+      if((s == 0) && (rand() % 2)) {
+	double t2 = (double)(rand() % 1000) / 100000.0;
+	profiler.addStageTime(stages[s], t2);
+	total += t2;
+      }
+      stage_hist[stages[s]].push_back(total);
+    }
+    for(unsigned int b=0; b<bhvs; b++) {
+      if((b == 0) && (iter > (iters/2)))
+	continue;
+      string bhv = "bhv_" + uintToString(b);
+      double t = (double)(rand() % 1000) / 100000.0;
+      profiler.addBehaviorTime(bhv, t, b*10);
+      bhv_hist[bhv].push_back(t);
+      bhv_last[bhv] = iter;
+    }
+    profiler.endIteration();
+
+    // The app posts after the engine is done. That time is folded in
+    // with the next iteration, so the last post is never sampled.
+    if(iter < iters) {
+      double t = (double)(rand() % 1000) / 100000.0;
+      profiler.addStageTime("post", t);
+      stage_hist["post"].push_back(t);
+    }
+  }
+
+  bool match = true;
+  double pcts[] = {0, 50, 90, 99, 100};
+
+  map<string, vector<double> >::iterator p;
+  for(p=stage_hist.begin(); p!=stage_hist.end(); p++) {
+    unsigned int expn = p->second.size();
+    if(expn > window)
+      expn = window;
+    if(profiler.getStageSamples(p->first) != expn) {
+      cout << "stage " << p->first << " samples mismatch" << endl;
+      match = false;
+    }
+    for(unsigned int k=0; k<5; k++) {
+      double v1 = profiler.getStagePercentile(p->first, pcts[k]);
+      double v2 = slowPercentile(p->second, window, pcts[k]);
+      if(v1 != v2) {
+	cout << "stage " << p->first << " pct " << pcts[k] << ": ";
+	cout << v1 << " vs " << v2 << endl;
+	match = false;
+      }
+    }
+  }
+
+  for(p=bhv_hist.begin(); p!=bhv_hist.end(); p++) {
+    string bhv = p->first;
+    bool stale = ((iters - bhv_last[bhv]) > window);
+    unsigned int expn = p->second.size();
+    if(expn > window)
+      expn = window;
+    if(stale)
+      expn = 0;
+    if(profiler.getBehaviorSamples(bhv) != expn) {
+      cout << "bhv " << bhv << " samples mismatch" << endl;
+      match = false;
+    }
+    if(stale)
+      continue;
+    for(unsigned int k=0; k<5; k++) {
+      double v1 = profiler.getBehaviorPercentile(bhv, pcts[k]);
+      double v2 = slowPercentile(p->second, window, pcts[k]);
+      if(v1 != v2) {
+	cout << "bhv " << bhv << " pct " << pcts[k] << ": ";
+	cout << v1 << " vs " << v2 << endl;
+	match = false;
+      }
+    }
+    bool in_spec = strContains(profiler.getSpec(), "bhv=" + bhv + ",");
+    if(!in_spec) {
+      cout << "bhv " << bhv << " missing from spec" << endl;
+      match = false;
+    }
+  }
+
+  string spec = profiler.getSpec();
+  if((iters > 1) && !strContains(spec, "stage=post,")) {
+    cout << "post stage missing from spec" << endl;
+    match = false;
+  }
+  if(!strBegins(spec, "iter=" + uintToString(iters) + ",win=")) {
+    cout << "bad spec: " << spec << endl;
+    match = false;
+  }
+
+  if(bench) {
+    unsigned int reps = 1000;
+    double start = HelmProfiler::getWallTime();
+    for(unsigned int i=0; i<reps; i++)
+      spec = profiler.getSpec();
+    double elapsed = HelmProfiler::getWallTime() - start;
+    cout << "spec: " << spec << endl;
+    cout << "getSpec (ms): " << (elapsed * 1000) / reps << endl;
+  }
+
+  cout << "match=" << boolToString(match) << endl;
+  return(0);
+}
@@ -0,0 +1,230 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testInfoBuffer)                            */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "InfoBuffer.h"
+#include "RefInfoBuffer.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: sameAnswers()
+//   Purpose: Compare the answers of the two buffers for the given
+//            variable, asking the InfoBuffer both by name and by
+//            slot. Returns the number of differences.
+
+unsigned int sameAnswers(InfoBuffer& ibuff, const RefInfoBuffer& rbuff,
+			 const string& var)
+{
+  unsigned int diffs = 0;
+  unsigned int slot = ibuff.getSlot(var);
+  if(ibuff.getSlotVar(slot) != var)
+    diffs++;
+
+  bool ok1, ok2, ok3;
+  double d1 = ibuff.dQuery(var, ok1);
+  double d2 = ibuff.dQuery(slot, ok2);
+  double d3 = rbuff.dQuery(var, ok3);
+  if((ok1 != ok3) || (ok2 != ok3) || (d1 != d3) || (d2 != d3))
+    diffs++;
+
+  string s1 = ibuff.sQuery(var, ok1);
+  string s2 = ibuff.sQuery(slot, ok2);
+  string s3 = rbuff.sQuery(var, ok3);
+  if((ok1 != ok3) || (ok2 != ok3) || (s1 != s3) || (s2 != s3))
+    diffs++;
+  
+  if((ibuff.tQuery(var) != rbuff.tQuery(var)) ||
+     (ibuff.tQuery(slot) != rbuff.tQuery(var)) ||
+     (ibuff.tQuery(var, false) != rbuff.tQuery(var, false)) ||
+     (ibuff.mtQuery(var) != rbuff.mtQuery(var)) ||
+     (ibuff.mtQuery(slot, false) != rbuff.mtQuery(var, false)))
+    diffs++;
+
+  if((ibuff.isKnown(var) != rbuff.isKnown(var)) ||
+     (ibuff.isKnown(slot) != rbuff.isKnown(var)))
+    diffs++;
+
+  vector<string> sv1 = ibuff.sQueryDeltas(var, ok1);
+  vector<string> sv2 = ibuff.sQueryDeltas(slot, ok2);
+  vector<string> sv3 = rbuff.sQueryDeltas(var, ok3);
+  if((ok1 != ok3) || (ok2 != ok3) || (sv1 != sv3) || (sv2 != sv3))
+    diffs++;
+
+  vector<double> dv1 = ibuff.dQueryDeltas(var, ok1);
+  vector<double> dv2 = ibuff.dQueryDeltas(slot, ok2);
+  vector<double> dv3 = rbuff.dQueryDeltas(var, ok3);
+  if((ok1 != ok3) || (ok2 != ok3) || (dv1 != dv3) || (dv2 != dv3))
+    diffs++;
+
+  return(diffs);
+}
+
+//--------------------------------------------------------
+// Procedure: noSlotRejected()
+//   Purpose: Check that INFO_BUFFER_NO_SLOT reads and writes nothing.
+
+bool noSlotRejected(InfoBuffer& ibuff)
+{
+  unsigned int slot = INFO_BUFFER_NO_SLOT;
+  unsigned int slots = ibuff.slots();
+  
+  bool ok1 = true;
+  bool ok2 = true;
+  bool ok3 = true;
+  bool ok4 = true;
+  ibuff.sQuery(slot, ok1);
+  ibuff.dQuery(slot, ok2);
+  ibuff.sQueryDeltas(slot, ok3);
+  ibuff.dQueryDeltas(slot, ok4);
+  if(ok1 || ok2 || ok3 || ok4)
+    return(false);
+  if(ibuff.isKnown(slot) || (ibuff.tQuery(slot) != -1) ||
+     (ibuff.mtQuery(slot) != -1) || (ibuff.getSlotVar(slot) != "") ||
+     (ibuff.getSlotWrites(slot) != 0))
+    return(false);
+  if(ibuff.setValue(slot, 1.0) || ibuff.setValue(slot, "true"))
+    return(false);
+  return(ibuff.slots() == slots);
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int ops  = 0;  bool ops_set=false;
+  unsigned int seed = 1;
+  unsigned int vars = 10;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "ops="))
+      ops_set = setUIntOnString(ops, argi.substr(4));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "vars="))
+      setUIntOnString(vars, argi.substr(5));
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testInfoBuffer: apply random writes, delta clears, time  " << endl;
+      cout << "steps and slot lookups to the InfoBuffer and to the      " << endl;
+      cout << "string-keyed reference it replaced, comparing all queries" << endl;
+      cout << "by name and by slot, sizes and reports after each op.    " << endl;
+      cout << "Example:                                                 " << endl;
+      cout << "$ testInfoBuffer ops=200000 seed=5                       " << endl;
+      cout << "match=true                                               " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!ops_set) return(cmdLineErr("ops is not set. Exiting."));
+  if(vars == 0) return(cmdLineErr("vars must be positive. Exiting."));
+  
+  srand(seed);
+
+  // Every fourth variable is a _DELTA name, whose base is also in
+  // the pool. The last is only ever resolved, never written.
+  vector<string> var_pool;
+  for(unsigned int i=0; var_pool.size()<vars; i++) {
+    string var = "VAR_" + uintToString(i);
+    var_pool.push_back(var);
+    if(((i % 4) == 3) && (var_pool.size() < vars))
+      var_pool.push_back(var + "_DELTA");
+  }
+  string never_written = "NEVER_WRITTEN";
+  var_pool.push_back(never_written);
+  
+  InfoBuffer    ibuff;
+  RefInfoBuffer rbuff;
+  ibuff.setStartTime(100);
+  rbuff.setStartTime(100);
+  
+  unsigned int diffs = 0;
+  if(!noSlotRejected(ibuff))
+    diffs++;
+  
+  for(unsigned int i=0; i<ops; i++) {
+    double utc = 100 + (i * 0.1);
+    string var = var_pool[rand() % var_pool.size()];
+    unsigned int op = rand() % 12;
+
+    if((i % 50) == 0) {
+      ibuff.setCurrTime(utc);
+      rbuff.setCurrTime(utc);
+    }
+
+    unsigned int writes = ibuff.getSlotWrites(ibuff.getSlot(var));
+    bool wrote = false;
+    if(var == never_written)
+      ibuff.getSlot(var);
+    else if((op == 0) || (op == 1)) {
+      double dval = rand() % 1000;
+      ibuff.setValue(var, dval, utc/2);
+      rbuff.setValue(var, dval, utc/2);
+      wrote = true;
+    }
+    else if(op == 2) {
+      double dval = rand() % 1000;
+      ibuff.setValue(ibuff.getSlot(var), dval);
+      rbuff.setValue(var, dval);
+      wrote = true;
+    }
+    else if((op == 3) || (op == 4)) {
+      string sval = "val" + uintToString(rand() % 100);
+      if(rand() % 3 == 0)
+	sval = uintToString(rand() % 100);
+      ibuff.setValue(var, sval, utc/2);
+      rbuff.setValue(var, sval, utc/2);
+      wrote = true;
+    }
+    else if(op == 5) {
+      string sval = "true";
+      ibuff.setValue(ibuff.getSlot(var), sval);
+      rbuff.setValue(var, sval);
+      wrote = true;
+    }
+    else if(op == 6) {
+      ibuff.clearDeltaVectors();
+      rbuff.clearDeltaVectors();
+    }
+
+    // Writes are counted per slot, for readers to detect change
+    unsigned int new_writes = ibuff.getSlotWrites(ibuff.getSlot(var));
+    if(wrote != (new_writes == writes+1))
+      diffs++;
+    if(!wrote && (new_writes != writes))
+      diffs++;
+    
+    diffs += sameAnswers(ibuff, rbuff, var);
+    diffs += sameAnswers(ibuff, rbuff, var_pool[rand() % var_pool.size()]);
+
+    if((ibuff.size() != rbuff.size()) || (ibuff.sizeFull() != rbuff.sizeFull()))
+      diffs++;
+    if((i % 100) == 0) {
+      if((ibuff.getReport() != rbuff.getReport()) ||
+	 (ibuff.getReport(true) != rbuff.getReport(true)) ||
+	 (ibuff.getReport(var_pool) != rbuff.getReport(var_pool)))
+	diffs++;
+    }
+  }
+
+  if(!noSlotRejected(ibuff))
+    diffs++;
+  
+  cout << "match=" << boolToString(diffs == 0);
+  if(diffs != 0)
+    cout << ",diffs=" << diffs;
+  cout << endl;
+  return(0);
+}
@@ -0,0 +1,226 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testLockstep)                              */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+#include "MBUtils.h"
+#include "LockstepSim.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Procedure: writeVehicle()
+//   Purpose: Write the .moos and .bhv files for one vehicle. It
+//            transits from (x1,y) to (x2,y) while avoiding the
+//            named contact, known only through node reports.
+
+bool writeVehicle(string vname, string contact, double x1, double x2,
+		  double y)
+{
+  string moos_file = "targ_" + vname + ".moos";
+  string bhv_file  = "targ_" + vname + ".bhv";
+  string heading   = (x2 > x1) ? "90" : "270";
+  
+  FILE *f = fopen(moos_file.c_str(), "w");
+  if(!f)
+    return(false);
+  fprintf(f, "Community  = %s\n", vname.c_str());
+  fprintf(f, "LatOrigin  = 43.825300\n");
+  fprintf(f, "LongOrigin = -70.330400\n\n");
+  fprintf(f, "ProcessConfig = uSimMarineV22\n{\n");
+  fprintf(f, "  start_pos = %s,%s,%s,0\n", doubleToStringX(x1).c_str(),
+	  doubleToStringX(y).c_str(), heading.c_str());
+  fprintf(f, "  prefix    = NAV\n");
+  fprintf(f, "  max_speed = 2\n");
+  fprintf(f, "  turn_rate = 70\n}\n\n");
+  fprintf(f, "ProcessConfig = pHelmIvP\n{\n");
+  fprintf(f, "  behaviors = %s\n", bhv_file.c_str());
+  fprintf(f, "  domain    = course:0:359:360\n");
+  fprintf(f, "  domain    = speed:0:2:21\n}\n\n");
+  fprintf(f, "ProcessConfig = pMarinePIDV22\n{\n");
+  fprintf(f, "  depth_control = false\n");
+  fprintf(f, "  yaw_pid_kp   = 1.2\n");
+  fprintf(f, "  yaw_pid_kd   = 0.0\n");
+  fprintf(f, "  yaw_pid_ki   = 0.3\n");
+  fprintf(f, "  yaw_pid_integral_limit = 0.07\n");
+  fprintf(f, "  speed_pid_kp = 1.0\n");
+  fprintf(f, "  speed_pid_kd = 0.0\n");
+  fprintf(f, "  speed_pid_ki = 0.0\n");
+  fprintf(f, "  speed_pid_integral_limit = 0.07\n");
+  fprintf(f, "  maxrudder    = 100\n");
+  fprintf(f, "  maxthrust    = 100\n");
+  fprintf(f, "  speed_factor = 20\n}\n");
+  fclose(f);
+
+  f = fopen(bhv_file.c_str(), "w");
+  if(!f)
+    return(false);
+  fprintf(f, "initialize DEPLOY = true\n\n");
+  fprintf(f, "Behavior = BHV_Waypoint\n{\n");
+  fprintf(f, "  name      = transit\n");
+  fprintf(f, "  pwt       = 100\n");
+  fprintf(f, "  condition = DEPLOY = true\n");
+  fprintf(f, "  speed     = 1.5\n");
+  fprintf(f, "  radius    = 3\n");
+  fprintf(f, "  points    = %s,%s\n}\n\n", doubleToStringX(x2).c_str(),
+	  doubleToStringX(y).c_str());
+  fprintf(f, "Behavior = BHV_AvoidCollision\n{\n");
+  fprintf(f, "  name      = avd_%s\n", contact.c_str());
+  fprintf(f, "  pwt       = 300\n");
+  fprintf(f, "  condition = DEPLOY = true\n");
+  fprintf(f, "  contact   = %s\n", contact.c_str());
+  fprintf(f, "  pwt_outer_dist    = 50\n");
+  fprintf(f, "  pwt_inner_dist    = 15\n");
+  fprintf(f, "  completed_dist    = 200\n");
+  fprintf(f, "  min_util_cpa_dist = 8\n");
+  fprintf(f, "  max_util_cpa_dist = 20\n}\n");
+  fclose(f);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: runSim()
+//   Purpose: Run the lockstep sim over the test mission and return
+//            its report, less the fields that depend on wall time.
+
+string runSim(unsigned int threads, unsigned int runs, unsigned int seed,
+	      double jitter, double duration)
+{
+  LockstepSim sim;
+  sim.addMissionFile("targ_abe.moos");
+  sim.addMissionFile("targ_ben.moos");
+  sim.setThreads(uintToString(threads));
+  sim.setRuns(uintToString(runs));
+  sim.setSeed(uintToString(seed));
+  sim.setJitter(doubleToStringX(jitter));
+  sim.setDuration(doubleToStringX(duration));
+  sim.setVerbose(true);
+  
+  // The behavior factory also reports on cerr for each vehicle
+  ostringstream captured, muted;
+  streambuf *cout_buf = cout.rdbuf();
+  streambuf *cerr_buf = cerr.rdbuf();
+  cout.rdbuf(captured.rdbuf());
+  cerr.rdbuf(muted.rdbuf());
+  bool ok = sim.run();
+  cout.rdbuf(cout_buf);
+  cerr.rdbuf(cerr_buf);
+  if(!ok)
+    return("");
+
+  // Keep the run and vehicle summary lines
+  string report;
+  vector<string> lines = parseString(captured.str(), '\n');
+  for(unsigned int i=0; i<lines.size(); i++) {
+    string line = stripBlankEnds(lines[i]);
+    if(!strBegins(line, "run=") && !strBegins(line, "vname="))
+      continue;
+    vector<string> fields = parseString(line, ',');
+    for(unsigned int j=0; j<fields.size(); j++) {
+      if(strBegins(fields[j], "wall_time=") || strBegins(fields[j], "warp="))
+	continue;
+      report += fields[j] + ",";
+    }
+    report += "\n";
+  }
+  return(report);
+}
+
+//--------------------------------------------------------
+// Procedure: getField()
+//   Purpose: Get a field from the first report line having it.
+
+string getField(const string& report, const string& field)
+{
+  vector<string> lines = parseString(report, '\n');
+  for(unsigned int i=0; i<lines.size(); i++) {
+    string value = tokStringParse(lines[i], field, ',', '=');
+    if(value != "")
+      return(value);
+  }
+  return("");
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int threads = 1;
+  unsigned int runs = 1;
+  unsigned int seed = 1;
+  double jitter = 0;
+  double duration = 150;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "threads="))
+      setUIntOnString(threads, argi.substr(8));
+    else if(strBegins(argi, "runs="))
+      setUIntOnString(runs, argi.substr(5));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "jitter="))
+      setDoubleOnString(jitter, argi.substr(7));
+    else if(strBegins(argi, "duration="))
+      setDoubleOnString(duration, argi.substr(9));
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testLockstep: run two vehicles on a head-on transit in the " << endl;
+      cout << "lockstep sim, once single-threaded and again on the given " << endl;
+      cout << "number of threads, and check that the runs are identical. " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testLockstep threads=2 runs=3 jitter=5                  " << endl;
+      cout << "match=true,steps=600,pair=abe:ben,avoided=true            " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+  
+  if(threads == 0) return(cmdLineErr("threads must be positive. Exiting."));
+
+  // The mission is written to a scratch dir and removed after
+  char dir_template[] = "/tmp/testLockstepXXXXXX";
+  char* dir = mkdtemp(dir_template);
+  if(!dir || (chdir(dir) != 0))
+    return(cmdLineErr("Unable to make a scratch dir. Exiting."));
+  bool ok = writeVehicle("abe", "ben", 0, 150, 0);
+  ok = ok && writeVehicle("ben", "abe", 150, 0, 2);
+
+  string report1, report2, reportn;
+  if(ok) {
+    report1 = runSim(1, runs, seed, jitter, duration);
+    report2 = runSim(1, runs, seed, jitter, duration);
+    reportn = runSim(threads, runs, seed, jitter, duration);
+  }
+  
+  unlink("targ_abe.moos");
+  unlink("targ_abe.bhv");
+  unlink("targ_ben.moos");
+  unlink("targ_ben.bhv");
+  rmdir(dir);
+
+  if(!ok || (report1 == ""))
+    return(cmdLineErr("Unable to run the test mission. Exiting."));
+
+  // Head-on at a combined 3 m/s with 2m of lateral offset. Without
+  // avoidance, driven by node reports, they pass within a few meters.
+  double min_range = atof(getField(report1, "min_range").c_str());
+  
+  bool match = (report1 == report2) && (report1 == reportn);
+  cout << "match=" << boolToString(match);
+  cout << ",steps=" << getField(report1, "steps");
+  cout << ",pair=" << getField(report1, "pair");
+  cout << ",avoided=" << boolToString(min_range > 5) << endl;
+  return(0);
+}
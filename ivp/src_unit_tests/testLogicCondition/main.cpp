@@ -0,0 +1,214 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testLogicCondition)                        */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include "MBUtils.h"
+#include "LogicCondition.h"
+#include "ParseNode.h"
+#include "InfoBuffer.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//--------------------------------------------------------
+// Class: RefCondition
+//   Purpose: The condition as evaluated before it was compiled, by
+//            walking the parse tree with recursiveEvaluate(), and
+//            updated from a buffer by pushing every var value.
+
+class RefCondition {
+public:
+  RefCondition() {m_node=0;}
+  ~RefCondition() {delete(m_node);}
+
+  bool setCondition(const string& str) {
+    m_node = new ParseNode(str);
+    if(!m_node->recursiveParse(true) || !m_node->recursiveSyntaxCheck()) {
+      delete(m_node);
+      m_node = 0;
+      return(false);
+    }
+    return(true);
+  }
+
+  void clearVarVals()
+    {if(m_node) m_node->recursiveClearVarVal();}
+  void setVarVal(const string& var, const string& val)
+    {if(m_node) m_node->recursiveSetVarVal(var, val);}
+  void setVarVal(const string& var, double val)
+    {if(m_node) m_node->recursiveSetVarVal(var, val);}
+
+  void updateFromBuffer(const InfoBuffer& buffer) {
+    if(!m_node)
+      return;
+    vector<string> vars = m_node->recursiveGetVarNames();
+    for(unsigned int i=0; i<vars.size(); i++) {
+      bool   ok_s, ok_d;
+      string s_result = buffer.sQuery(vars[i], ok_s);
+      double d_result = buffer.dQuery(vars[i], ok_d);
+      if(ok_s)
+	setVarVal(vars[i], s_result);
+      if(ok_d)
+	setVarVal(vars[i], d_result);
+    }
+  }
+
+  bool eval() const
+    {return(m_node && m_node->recursiveEvaluate());}
+
+private:
+  ParseNode *m_node;
+};
+
+//--------------------------------------------------------
+// Random condition and value generation. Values mix numbers,
+// numeric and non-numeric strings, quoted and unquoted.
+
+const char* g_vars[] = {"A", "B", "MODE", "X", "X_DELTA", "C"};
+const unsigned int g_vsize = 6;
+
+const char* g_svals[] = {"a", "\"a\"", "b", "10", "\"10\"", "3.5",
+			 "\"3.5\"", "x,y", "ACTIVE", "\"ACTIVE\"", "a:b",
+			 "\"a b\"", "-2", "$(B)"};
+const unsigned int g_ssize = 14;
+
+const char* g_rels[] = {"=", "!=", "<", "<=", ">", ">=", "=="};
+const unsigned int g_rsize = 7;
+
+string randVar()  {return(g_vars[rand() % g_vsize]);}
+string randSVal() {return(stripQuotes(g_svals[rand() % g_ssize]));}
+double randDVal() {return((double)(rand() % 20) - 5);}
+
+string randRight()
+{
+  unsigned int k = rand() % 4;
+  if(k == 0)
+    return(randVar());
+  if(k == 1)
+    return(intToString((rand() % 20) - 5));
+  return(g_svals[rand() % g_ssize]);
+}
+
+string randLeaf()
+{
+  return(randVar() + " " + g_rels[rand() % g_rsize] + " " + randRight());
+}
+
+string randCondition(unsigned int depth)
+{
+  unsigned int k = rand() % 5;
+  if((depth > 2) || (k < 2))
+    return(randLeaf());
+  if(k == 2)
+    return("!(" + randCondition(depth+1) + ")");
+  string conj = (k == 3) ? " and " : " or ";
+  return("(" + randCondition(depth+1) + ")" + conj +
+	 "(" + randCondition(depth+1) + ")");
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int conds = 0;  bool conds_set=false;
+  unsigned int steps = 30;
+  unsigned int seed  = 1;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "conds="))
+      conds_set = setUIntOnString(conds, argi.substr(6));
+    else if(strBegins(argi, "steps="))
+      setUIntOnString(steps, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testLogicCondition: build random conditions and compare " << endl;
+      cout << "the compiled LogicCondition against recursive evaluation" << endl;
+      cout << "of the parse tree, over random buffer writes, direct    " << endl;
+      cout << "sets, clears and copies.                                " << endl;
+      cout << "Example:                                                " << endl;
+      cout << "$ testLogicCondition conds=20000 seed=7                 " << endl;
+      cout << "match=true                                              " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!conds_set) return(cmdLineErr("conds is not set. Exiting."));
+  
+  srand(seed);
+
+  unsigned int diffs = 0;
+  for(unsigned int i=0; i<conds; i++) {
+    string condition = randCondition(0);
+    
+    LogicCondition logic;
+    RefCondition   ref;
+    bool ok_logic = logic.setCondition(condition);
+    bool ok_ref   = ref.setCondition(condition);
+    if(ok_logic != ok_ref)
+      diffs++;
+    if(!ok_logic || !ok_ref)
+      continue;
+
+    InfoBuffer buffer;
+    buffer.setStartTime(100);
+    for(unsigned int j=0; j<steps; j++) {
+      buffer.setCurrTime(100 + j);
+      string var = randVar();
+      unsigned int k = rand() % 6;
+      if(k == 0)
+	buffer.setValue(var, randSVal(), 1);
+      else if(k == 1)
+	buffer.setValue(var, randDVal(), 1);
+      else if(k == 2) {
+	string sval = randSVal();
+	logic.setVarVal(var, sval);
+	ref.setVarVal(var, sval);
+      }
+      else if(k == 3) {
+	double dval = randDVal();
+	logic.setVarVal(var, dval);
+	ref.setVarVal(var, dval);
+      }
+      else if(k == 4)
+	buffer.clearDeltaVectors();
+      else if((rand() % 10) == 0) {
+	logic.clearVarVals();
+	ref.clearVarVals();
+      }
+
+      if(rand() % 2) {
+	logic.updateFromBuffer(&buffer);
+	ref.updateFromBuffer(buffer);
+      }
+      if(logic.eval() != ref.eval())
+	diffs++;
+
+      // A copy carries the variable values and cached result
+      if((j % 10) == 0) {
+	LogicCondition copy(logic);
+	LogicCondition assigned;
+	assigned = logic;
+	if((copy.eval() != ref.eval()) || (assigned.eval() != ref.eval()))
+	  diffs++;
+      }
+    }
+  }
+
+  cout << "match=" << boolToString(diffs == 0);
+  if(diffs != 0)
+    cout << ",diffs=" << diffs;
+  cout << endl;
+  return(0);
+}
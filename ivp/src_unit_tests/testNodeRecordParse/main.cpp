@@ -0,0 +1,322 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testNodeRecordParse)                       */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "MBUtils.h"
+#include "NodeRecordUtils.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//---------------------------------------------------------
+// Procedure: string2NodeRecordOld()
+//      Note: The original multi-pass parser from lib_contacts, kept
+//            here as the reference for the single-pass
+//            string2NodeRecord(), for checking and benchmarking.
+//   Example: NAME=alpha,TYPE=KAYAK,UTC_TIME=1267294386.51,
+//            X=29.66,Y=-23.49,LAT=43.825089, LON=-70.330030, 
+//            SPD=2.00, HDG=119.06,YAW=119.05677,DEPTH=0.00,     
+//            LENGTH=4.0,MODE=DRIVE,GROUP=A
+
+NodeRecord string2NodeRecordOld(const string& node_rep_string)
+{
+  NodeRecord new_record;
+
+  vector<string> svector = parseStringZ(node_rep_string, ',', "{");
+  unsigned int i, vsize = svector.size();
+  for(i=0; i<vsize; i++) {
+    string param = toupper(biteStringX(svector[i], '='));
+    string value = svector[i];
+
+    if(param == "NAME")
+      new_record.setName(value);
+    else if(param == "TYPE")
+      new_record.setType(value);
+    else if(param == "MODE")
+      new_record.setMode(value);
+    else if(param == "ALLSTOP")
+      new_record.setAllStop(value);
+    else if(param == "INDEX")
+      new_record.setIndex(atof(value.c_str()));
+    else if(isNumber(value)) {
+      if((param == "TIME") || (param == "UTC_TIME"))
+	new_record.setTimeStamp(atof(value.c_str()));
+      else if(param == "X")
+	new_record.setX(atof(value.c_str()));
+      else if(param == "Y")
+	new_record.setY(atof(value.c_str()));
+      else if(param == "LAT")
+	new_record.setLat(atof(value.c_str()));
+      else if(param == "LON")
+	new_record.setLon(atof(value.c_str()));
+
+      else if((param == "SPD") || (param == "SPEED"))
+	new_record.setSpeed(atof(value.c_str()));
+      else if((param == "HDG") || (param == "HEADING"))
+	new_record.setHeading(atof(value.c_str()));
+
+      else if((param == "DEP") || (param == "DEPTH"))
+	new_record.setDepth(atof(value.c_str()));
+      else if((param == "LENGTH") || (param == "LEN"))
+	new_record.setLength(atof(value.c_str()));
+      else if(param == "YAW")
+	new_record.setYaw(atof(value.c_str()));
+      else if((param == "ALT") || (param == "ALTITUDE"))
+	new_record.setAltitude(atof(value.c_str()));
+      else if(param == "HDG_OG")
+	new_record.setHeadingOG(atof(value.c_str()));
+      else if(param == "SPD_OG")
+	new_record.setSpeedOG(atof(value.c_str()));
+      else if(param == "TRANSPARENCY")
+	new_record.setTransparency(atof(value.c_str()));
+    }
+    else if(param == "COLOR")
+      new_record.setColor(value);
+    else if(param == "GROUP")
+      new_record.setGroup(value);
+    else if(param == "LOAD_WARNING")
+      new_record.setLoadWarning(value);
+    else if((param == "THRUST_MODE_REVERSE") && (tolower(value) == "true")) 
+      new_record.setThrustModeReverse(true);
+    else if(param == "TRAJECTORY")
+      new_record.setTrajectory(stripBraces(value));
+
+  }
+
+  return(new_record);
+}
+
+//--------------------------------------------------------
+// Procedure: sameRecord()
+
+bool sameRecord(const NodeRecord& a, const NodeRecord& b)
+{
+  if(a.getSpec() != b.getSpec())
+    return(false);
+  if((a.getIndex() != b.getIndex()) ||
+     (a.getThrustModeReverse() != b.getThrustModeReverse()) ||
+     (a.getTrajectory() != b.getTrajectory()) ||
+     (a.isSetTrajectory() != b.isSetTrajectory()) ||
+     (a.getLoadWarning() != b.getLoadWarning()) ||
+     (a.getAllStop() != b.getAllStop()))
+    return(false);
+  if((a.getX() != b.getX()) || (a.getY() != b.getY()) ||
+     (a.getLat() != b.getLat()) || (a.getLon() != b.getLon()) ||
+     (a.getSpeed() != b.getSpeed()) || (a.getHeading() != b.getHeading()) ||
+     (a.getSpeedOG() != b.getSpeedOG()) ||
+     (a.getHeadingOG() != b.getHeadingOG()) ||
+     (a.getDepth() != b.getDepth()) || (a.getYaw() != b.getYaw()) ||
+     (a.getAltitude() != b.getAltitude()) ||
+     (a.getLength() != b.getLength()) ||
+     (a.getTimeStamp() != b.getTimeStamp()) ||
+     (a.getTransparency() != b.getTransparency()))
+    return(false);
+  if((a.isSetX() != b.isSetX()) || (a.isSetY() != b.isSetY()) ||
+     (a.isSetLatitude() != b.isSetLatitude()) ||
+     (a.isSetLongitude() != b.isSetLongitude()) ||
+     (a.isSetSpeed() != b.isSetSpeed()) ||
+     (a.isSetHeading() != b.isSetHeading()) ||
+     (a.isSetSpeedOG() != b.isSetSpeedOG()) ||
+     (a.isSetHeadingOG() != b.isSetHeadingOG()) ||
+     (a.isSetDepth() != b.isSetDepth()) || (a.isSetYaw() != b.isSetYaw()) ||
+     (a.isSetAltitude() != b.isSetAltitude()) ||
+     (a.isSetLength() != b.isSetLength()) ||
+     (a.isSetTimeStamp() != b.isSetTimeStamp()) ||
+     (a.isSetTransparency() != b.isSetTransparency()))
+    return(false);
+  return(true);
+}
+
+//--------------------------------------------------------
+// Procedure: randomValue()
+//   Purpose: Mostly well formed values, with some strings, blanks,
+//            braces and malformed numbers mixed in.
+
+string randomValue()
+{
+  int pick = rand() % 12;
+  if(pick == 0)
+    return("");
+  if(pick == 1)
+    return(" \t" + doubleToStringX((rand() % 20000) / 7.0, 4) + " ");
+  if(pick == 2)
+    return("-" + uintToString(rand() % 500) + ".5.1");
+  if(pick == 3)
+    return("+" + uintToString(rand() % 500));
+  if(pick == 4)
+    return("{pts={1,2:3,4},label=abc}");
+  if(pick == 5)
+    return("TRUE");
+  if(pick == 6)
+    return("yellow");
+  if(pick == 7)
+    return("--4");
+  if(pick == 8)
+    return("12abc");
+  return(doubleToStringX((rand() % 2000000) / 100.0 - 10000, 6));
+}
+
+//--------------------------------------------------------
+// Procedure: randomReport()
+
+string randomReport(const vector<string>& keys)
+{
+  string report;
+  unsigned int fields = 3 + (rand() % 20);
+  for(unsigned int i=0; i<fields; i++) {
+    string key = keys[rand() % keys.size()];
+    if((rand() % 4) == 0)
+      key = tolower(key);
+    if((rand() % 6) == 0)
+      key = " " + key + "\t";
+    if(i > 0)
+      report += ",";
+    if((rand() % 25) == 0)
+      report += key;
+    else
+      report += key + "=" + randomValue();
+  }
+  return(report);
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int reports = 0;  bool reports_set=false;
+  unsigned int seed = 1;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "reports="))
+      reports_set = setUIntOnString(reports, argi.substr(8));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testNodeRecordParse: compare string2NodeRecord() against  " << endl;
+      cout << "string2NodeRecordOld() on typical and randomly generated  " << endl;
+      cout << "node reports, and check the binary encoding round trip.   " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testNodeRecordParse reports=10000 seed=3                " << endl;
+      cout << "match=true,roundtrip=true                                 " << endl;
+      cout << "With the bench arg, the time of each parser is shown.     " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!reports_set) return(cmdLineErr("reports is not set. Exiting."));
+  srand(seed);
+
+  const char *key_arr[] = {"NAME", "TYPE", "MODE", "ALLSTOP", "INDEX",
+			   "TIME", "UTC_TIME", "X", "Y", "LAT", "LON",
+			   "SPD", "SPEED", "HDG", "HEADING", "DEP", "DEPTH",
+			   "LENGTH", "LEN", "YAW", "ALT", "ALTITUDE",
+			   "HDG_OG", "SPD_OG", "TRANSPARENCY", "COLOR",
+			   "GROUP", "LOAD_WARNING", "THRUST_MODE_REVERSE",
+			   "TRAJECTORY", "MODE_AUX", "PITCH", "Z", ""};
+  vector<string> keys(key_arr, key_arr + sizeof(key_arr)/sizeof(char*));
+
+  // A typical pNodeReporter report is always part of the test set
+  vector<string> svector;
+  svector.push_back("NAME=alpha,X=29.66,Y=-23.49,SPD=2.0,HDG=119.06,"
+		    "DEP=0,LAT=43.825089,LON=-70.330030,TYPE=kayak,"
+		    "COLOR=yellow,MODE=MODE@ACTIVE:LOITERING,ALLSTOP=clear,"
+		    "INDEX=87,YAW=119.05677,TIME=1267294386.51,LENGTH=4,"
+		    "THRUST_MODE_REVERSE=true,GROUP=blue");
+  svector.push_back("name=ben, x=1,,y=2, trajectory={pts={1,2:3,4}},"
+		    "load_warning=heavy,hdg_og=2,spd_og=1,alt=3");
+  for(unsigned int i=0; i<reports; i++)
+    svector.push_back(randomReport(keys));
+
+  bool match = true;
+  bool roundtrip = true;
+  unsigned int text_bytes = 0;
+  unsigned int binary_bytes = 0;
+  vector<string> bvector;
+  for(unsigned int i=0; i<svector.size(); i++) {
+    NodeRecord rec_new = string2NodeRecord(svector[i]);
+    NodeRecord rec_old = string2NodeRecordOld(svector[i]);
+    if(!sameRecord(rec_new, rec_old)) {
+      match = false;
+      cout << "mismatch: " << svector[i] << endl;
+    }
+
+    // The binary form must decode to the same record, either
+    // directly or through string2NodeRecord()
+    string binary;
+    NodeRecord rec_bin;
+    if(!nodeRecord2Binary(rec_new, binary) ||
+       !binary2NodeRecord(binary, rec_bin) ||
+       !sameRecord(rec_new, rec_bin) ||
+       !sameRecord(rec_new, string2NodeRecord(binary))) {
+      roundtrip = false;
+      cout << "roundtrip failed: " << svector[i] << endl;
+    }
+    text_bytes   += rec_new.getSpec().length();
+    binary_bytes += binary.length();
+    bvector.push_back(binary);
+  }
+
+  // A string too long for the binary form must fail to encode, and
+  // a report of an unknown version must fail to decode
+  bool reject = true;
+  NodeRecord rec_long = string2NodeRecord("name=abe,x=1,y=2");
+  rec_long.setLoadWarning(string(0x10000, 'w'));
+  string binary = "unchanged";
+  if(nodeRecord2Binary(rec_long, binary) || (binary != "unchanged"))
+    reject = false;
+  rec_long.setLoadWarning(string(0xFFFF, 'w'));
+  if(!nodeRecord2Binary(rec_long, binary))
+    reject = false;
+  binary[3] = (char)(binary[3] + 1);
+  NodeRecord rec_bin;
+  if(binary2NodeRecord(binary, rec_bin))
+    reject = false;
+
+  cout << "match=" << boolToString(match);
+  cout << ",roundtrip=" << boolToString(roundtrip);
+  cout << ",reject=" << boolToString(reject);
+
+  if(bench) {
+    unsigned int rounds = 20;
+    clock_t start = clock();
+    for(unsigned int r=0; r<rounds; r++)
+      for(unsigned int i=0; i<svector.size(); i++)
+	string2NodeRecordOld(svector[i]);
+    double old_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for(unsigned int r=0; r<rounds; r++)
+      for(unsigned int i=0; i<svector.size(); i++)
+	string2NodeRecord(svector[i]);
+    double new_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for(unsigned int r=0; r<rounds; r++)
+      for(unsigned int i=0; i<bvector.size(); i++)
+	string2NodeRecord(bvector[i]);
+    double bin_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    cout << ",old_secs=" << doubleToStringX(old_secs, 4);
+    cout << ",new_secs=" << doubleToStringX(new_secs, 4);
+    cout << ",bin_secs=" << doubleToStringX(bin_secs, 4);
+    cout << ",text_bytes=" << text_bytes;
+    cout << ",binary_bytes=" << binary_bytes;
+  }
+  cout << endl;
+  return(0);
+}
@@ -0,0 +1,153 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testObShipTable)                           */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include "MBUtils.h"
+#include "XYFormatUtilsPoly.h"
+#include "PMGen_Dubins.h"
+#include "ObShipModelV24.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+double randVal(double low, double high)
+{
+  double pct = (double)(rand() % 100000) / 100000.0;
+  return(low + (pct * (high - low)));
+}
+
+int main(int argc, char** argv) 
+{
+  unsigned int obstacles = 0;  bool obstacles_set=false;
+  double field  = 500;
+  double radius = 30;
+  double delta  = 1;
+  unsigned int speeds = 21;
+  unsigned int seed = 1;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "obstacles="))
+      obstacles_set = setUIntOnString(obstacles, argi.substr(10));
+    else if(strBegins(argi, "field="))
+      setPosDoubleOnString(field, argi.substr(6));
+    else if(strBegins(argi, "radius="))
+      setPosDoubleOnString(radius, argi.substr(7));
+    else if(strBegins(argi, "delta="))
+      setPosDoubleOnString(delta, argi.substr(6));
+    else if(strBegins(argi, "speeds="))
+      setUIntOnString(speeds, argi.substr(7));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testObShipTable: test ObShipModelV24 evaluations using the" << endl;
+      cout << "heading table against direct CPA calculations, for a field" << endl;
+      cout << "of random obstacles around ownship.                      " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testObShipTable obstacles=50 field=500                  " << endl;
+      cout << "match=true                                                " << endl;
+      cout << "With the bench arg, the time of each approach is shown.   " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!obstacles_set) return(cmdLineErr("obstacles is not set. Exiting."));
+  
+  srand(seed);
+
+  double osx = 0;
+  double osy = 0;
+  double osh = randVal(0, 360);
+  double osv = 2;
+
+  PMGen_Dubins pmgen;
+  pmgen.setParam("radius", doubleToString(radius));
+  PlatModel pmodel = pmgen.generate(osx, osy, osh, osv);
+
+  // Build one model per obstacle, each a random convex polygon
+  // not containing ownship, as the helm would with one behavior
+  // per obstacle.
+  vector<ObShipModelV24> models;
+  while(models.size() < obstacles) {
+    double cx = randVal(-field/2, field/2);
+    double cy = randVal(-field/2, field/2);
+    double rad = randVal(5, 30);
+    string spec = "format=radial,x=" + doubleToString(cx) + ",y=";
+    spec += doubleToString(cy) + ",radius=" + doubleToString(rad);
+    spec += ",pts=" + uintToString(3 + (rand() % 6));
+    XYPolygon poly = string2Poly(spec);
+    if(!poly.is_convex() || (poly.dist_to_poly(osx, osy) < 1))
+      continue;
+    
+    ObShipModelV24 model(osx, osy, osh, osv);
+    model.setPlatModel(pmodel);
+    model.setGutPoly(poly);
+    model.setCachedVals(true);
+    models.push_back(model);
+  }
+
+  unsigned int hdg_pts = (unsigned int)(360 / delta);
+
+  // Part 1: Direct evaluation of every course and speed choice
+  clock_t direct_start = clock();
+  vector<double> direct_vals;
+  for(unsigned int m=0; m<models.size(); m++) {
+    for(unsigned int h=0; h<hdg_pts; h++) {
+      for(unsigned int s=0; s<speeds; s++)
+	direct_vals.push_back(models[m].evalHdgSpd(h * delta, s * 0.25));
+    }
+  }
+  double direct_secs = (double)(clock() - direct_start) / CLOCKS_PER_SEC;
+  
+  // Part 2: Evaluation with the heading table, including the
+  //         time to build the table
+  clock_t table_start = clock();
+  vector<double> table_vals;
+  for(unsigned int m=0; m<models.size(); m++) {
+    models[m].buildHdgTable(0, delta, hdg_pts);
+    for(unsigned int h=0; h<hdg_pts; h++) {
+      for(unsigned int s=0; s<speeds; s++)
+	table_vals.push_back(models[m].evalHdgSpd(h * delta, s * 0.25));
+    }
+  }
+  double table_secs = (double)(clock() - table_start) / CLOCKS_PER_SEC;
+
+  // Part 3: Refinery bearing extremes with and without the table
+  bool bnds_match = true;
+  for(unsigned int m=0; m<models.size(); m++) {
+    ObShipModelV24 model_direct = models[m];
+    model_direct.clearHdgTable();
+    model_direct.updateBngExtremes();
+    models[m].updateBngExtremes();
+    if((model_direct.getGutBngMinToPoly() != models[m].getGutBngMinToPoly()) ||
+       (model_direct.getGutBngMaxToPoly() != models[m].getGutBngMaxToPoly()))
+      bnds_match = false;
+  }
+  
+  bool match = bnds_match && (direct_vals == table_vals);
+
+  cout << "match=" << boolToString(match);
+  if(bench) {
+    cout << ",evals=" << direct_vals.size();
+    cout << ",direct_secs=" << doubleToStringX(direct_secs, 6);
+    cout << ",table_secs=" << doubleToStringX(table_secs, 6);
+  }
+  cout << endl;
+  return(0);
+}
@@ -0,0 +1,139 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testObstacleHull)                          */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include "MBUtils.h"
+#include "Obstacle.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+//-----------------------------------------------------------
+// Procedure: randPoint()
+//   Purpose: A new point for the given mode. Grid points repeat
+//            and line up often, line points are all collinear.
+
+XYPoint randPoint(const string& mode)
+{
+  if(mode == "grid")
+    return(XYPoint(10 * (rand() % 5), 10 * (rand() % 5)));
+  if(mode == "line") {
+    double x = rand() % 21;
+    return(XYPoint(x, 3 + (0.5 * x)));
+  }
+  return(XYPoint(100.0 * rand() / RAND_MAX, 100.0 * rand() / RAND_MAX));
+}
+
+//-----------------------------------------------------------
+// Procedure: sameHull()
+//   Purpose: True if the two polygons have the same vertices,
+//            regardless of the starting vertex.
+
+bool sameHull(const XYPolygon& a, const XYPolygon& b)
+{
+  if(a.size() != b.size())
+    return(false);
+  vector<pair<double, double> > avtx, bvtx;
+  for(unsigned int i=0; i<a.size(); i++) {
+    avtx.push_back(make_pair(a.get_vx(i), a.get_vy(i)));
+    bvtx.push_back(make_pair(b.get_vx(i), b.get_vy(i)));
+  }
+  sort(avtx.begin(), avtx.end());
+  sort(bvtx.begin(), bvtx.end());
+  return(avtx == bvtx);
+}
+
+int main(int argc, char** argv) 
+{
+  string mode = "random";
+  unsigned int steps = 1000;
+  unsigned int seed = 1;
+  unsigned int max_pts = 10;
+  unsigned int prune_pct = 30;
+  double max_age = 8;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "mode="))
+      mode = argi.substr(5);
+    else if(strBegins(argi, "steps="))
+      setUIntOnString(steps, argi.substr(6));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(strBegins(argi, "max_pts="))
+      setUIntOnString(max_pts, argi.substr(8));
+    else if(strBegins(argi, "prune_pct="))
+      setUIntOnString(prune_pct, argi.substr(10));
+    else if(strBegins(argi, "max_age="))
+      max_age = atof(argi.substr(8).c_str());
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testObstacleHull: check the incrementally kept hull of an  " << endl;
+      cout << "Obstacle against a full rebuild from its points. Each step " << endl;
+      cout << "adds a point, dropping the oldest past max_pts, and in     " << endl;
+      cout << "prune_pct of steps points older than a random age up to    " << endl;
+      cout << "max_age are pruned.                                        " << endl;
+      cout << "Modes: random, grid (repeated and collinear points), line  " << endl;
+      cout << "(all points collinear).                                    " << endl;
+      cout << "Example:                                                   " << endl;
+      cout << "$ testObstacleHull mode=grid steps=2000 seed=2             " << endl;
+      cout << "match=true,incremental=true                                " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+
+  if((mode != "random") && (mode != "grid") && (mode != "line"))
+    return(cmdLineErr("mode is unknown. Exiting."));
+
+  srand(seed);
+
+  // Each step is one second, the time stamp of the point added
+  Obstacle obstacle;
+  obstacle.setMaxPts(max_pts);
+  bool match = true;
+  for(unsigned int step=1; match && (step<=steps); step++) {
+    XYPoint point = randPoint(mode);
+    point.set_time(step);
+    obstacle.addPoint(point);
+    if((unsigned int)(rand() % 100) < prune_pct) {
+      double age = max_age * rand() / RAND_MAX;
+      obstacle.pruneByAge(age, step);
+    }
+    if(obstacle.size() == 0)
+      continue;
+
+    // A fresh obstacle given the same points builds its hull in full
+    const vector<XYPoint>& points = obstacle.getPoints();
+    Obstacle rebuilt;
+    rebuilt.setMaxPts(max_pts);
+    for(unsigned int i=points.size(); i>0; i--)
+      rebuilt.addPoint(points[i-1]);
+
+    XYPolygon inc_hull  = obstacle.getPointHull();
+    XYPolygon full_hull = rebuilt.getPointHull();
+    if(!sameHull(inc_hull, full_hull)) {
+      match = false;
+      // Shown on stderr so utest sees only the result line
+      cerr << "mismatch at step " << step << ": " << inc_hull.get_spec()
+	   << " vs " << full_hull.get_spec() << endl;
+    }
+  }
+
+  cout << "match=" << boolToString(match);
+  cout << ",incremental=" << boolToString(obstacle.getHullBuildsInc() > 0);
+  cout << endl;
+  return(0);
+}
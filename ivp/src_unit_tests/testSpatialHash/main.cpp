@@ -0,0 +1,124 @@
+/*****************************************************************/
+/*    NAME: Michael Benjamin                                     */
+/*    FILE: main.cpp (testSpatialHash)                           */
+/*    DATE: October 19th, 2026                                   */
+/*****************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include "MBUtils.h"
+#include "XYSpatialHash.h"
+
+using namespace std;
+
+int cmdLineErr(string msg) {cout << msg << endl; return(1);}
+
+int main(int argc, char** argv) 
+{
+  unsigned int vehicles = 0;  bool vehicles_set=false;
+  double range = 0;           bool range_set=false;
+  double field = 1000;
+  double cell  = 0;
+  unsigned int seed = 1;
+  bool   bench = false;
+  
+  for(int i=1; i<argc; i++) {
+    string argi = argv[i];
+    if(strBegins(argi, "vehicles="))
+      vehicles_set = setUIntOnString(vehicles, argi.substr(9));
+    else if(strBegins(argi, "range="))
+      range_set = setNonNegDoubleOnString(range, argi.substr(6));
+    else if(strBegins(argi, "field="))
+      setPosDoubleOnString(field, argi.substr(6));
+    else if(strBegins(argi, "cell="))
+      setPosDoubleOnString(cell, argi.substr(5));
+    else if(strBegins(argi, "seed="))
+      setUIntOnString(seed, argi.substr(5));
+    else if(argi == "bench")
+      bench = true;
+    else if((argi=="-h") || (argi=="--help")) {
+      cout << "testSpatialHash: test XYSpatialHash range queries against" << endl;
+      cout << "a brute force check of all pairs, on random positions.   " << endl;
+      cout << "Example:                                                  " << endl;
+      cout << "$ testSpatialHash vehicles=1000 range=100 field=10000     " << endl;
+      cout << "match=true                                                " << endl;
+      cout << "With the bench arg, the time of each approach is shown.   " << endl;
+      return(0);
+    }
+    else if(strBegins(argi, "id="))
+      argi = "just ignore id fields";
+    else {
+      cout << "Error: arg[" << argi << "] Exiting." << endl;
+      return(1);
+    }  
+  }  
+     
+  if(!vehicles_set) return(cmdLineErr("vehicles is not set. Exiting."));
+  if(!range_set)    return(cmdLineErr("range is not set. Exiting."));
+  if(cell == 0)
+    cell = range;
+  if(cell == 0)
+    cell = 100;
+  
+  srand(seed);
+  vector<string> names;
+  vector<double> xs, ys;
+  XYSpatialHash grid(cell);
+  for(unsigned int i=0; i<vehicles; i++) {
+    string name = "V" + uintToString(i);
+    double x = ((double)(rand() % 100000) / 100000.0) * field;
+    double y = ((double)(rand() % 100000) / 100000.0) * field;
+    names.push_back(name);
+    xs.push_back(x);
+    ys.push_back(y);
+    grid.update(name, x, y);
+  }
+
+  // Exercise incremental maintenance: move every 3rd vehicle and
+  // remove every 7th, as node reports and stale drops would.
+  vector<bool> active(vehicles, true);
+  for(unsigned int i=0; i<vehicles; i++) {
+    if((i % 3) == 0) {
+      xs[i] = ((double)(rand() % 100000) / 100000.0) * field;
+      ys[i] = ((double)(rand() % 100000) / 100000.0) * field;
+      grid.update(names[i], xs[i], ys[i]);
+    }
+    if((i % 7) == 0) {
+      active[i] = false;
+      grid.remove(names[i]);
+    }
+  }
+  
+  // Part 1: Brute force, all pairs
+  clock_t brute_start = clock();
+  vector<unsigned int> brute_counts(vehicles, 0);
+  for(unsigned int i=0; i<vehicles; i++) {
+    for(unsigned int j=0; j<vehicles; j++) {
+      if(active[j] && hypot(xs[i]-xs[j], ys[i]-ys[j]) <= range)
+	brute_counts[i]++;
+    }
+  }
+  double brute_secs = (double)(clock() - brute_start) / CLOCKS_PER_SEC;
+  
+  // Part 2: Spatial hash queries
+  clock_t hash_start = clock();
+  vector<unsigned int> hash_counts(vehicles, 0);
+  for(unsigned int i=0; i<vehicles; i++) {
+    vector<string> keys = grid.getKeysInRange(xs[i], ys[i], range);
+    hash_counts[i] = keys.size();
+  }
+  double hash_secs = (double)(clock() - hash_start) / CLOCKS_PER_SEC;
+
+  bool match = (brute_counts == hash_counts);
+
+  cout << "match=" << boolToString(match);
+  if(bench) {
+    cout << ",brute_secs=" << doubleToStringX(brute_secs, 6);
+    cout << ",hash_secs=" << doubleToStringX(hash_secs, 6);
+    cout << ",cells=" << grid.cells();
+  }
+  cout << endl;
+  return(0);
+}